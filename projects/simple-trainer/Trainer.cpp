@@ -2,49 +2,94 @@
 #include <iostream>
 #include <Windows.h>
 #include <thread>
+#include "../../resources/scan-core/CheatTable.h"
 
-// Function to write to game memory
-template<typename T>
-void WriteMemory(uintptr_t address, T value) {
-    DWORD oldProtect;
-    VirtualProtect((LPVOID)address, sizeof(T), PAGE_EXECUTE_READWRITE, &oldProtect);
-    *(T*)address = value;
-    VirtualProtect((LPVOID)address, sizeof(T), oldProtect, &oldProtect);
+// The trainer runs inside the game process, so memory access goes through the current process handle
+static ScanCore::IProcessMemory& GameMemory() {
+    static ScanCore::Win32ProcessMemory memory(GetCurrentProcess());
+    return memory;
+}
+
+// All frozen values live in one cheat table; its worker thread rewrites them in one batched write per tick.
+// Never destroyed: the destructor joins that thread, which would deadlock under the loader lock at DLL unload
+static ScanCore::CheatTable& Table() {
+    static ScanCore::CheatTable* table = new ScanCore::CheatTable(GameMemory());
+    return *table;
 }
 
+// Entry indices in Table()
+static size_t healthEntry = 0;
+static size_t ammoEntry = 0;
+
 // Function to read from game memory
 template<typename T>
 T ReadMemory(uintptr_t address) {
     return *(T*)address;
 }
 
-// Example: Infinite Health
-void InfiniteHealth() {
-    // This address is just a placeholder. In a real scenario, you'd find this dynamically.
-    uintptr_t healthAddress = 0xDEADBEEF; 
-    int newHealth = 9999;
-    WriteMemory<int>(healthAddress, newHealth);
-    std::cout << "Health set to: " << newHealth << std::endl;
+// Example entries. These addresses are just placeholders. In a real scenario, you'd find them dynamically
+// (a pointer path from the pointer scanner survives restarts; a fixed address does not).
+static void AddEntries() {
+    ScanCore::CheatTable& table = Table();
+
+    ScanCore::CheatEntry health = ScanCore::CheatEntry::Freeze("Infinite Health", 0xDEADBEEF, ScanCore::ValueType::Int32, 9999);
+    health.enabled = false;
+    healthEntry = table.Add(health);
+
+    // game.exe+0x1234 -> player +0x10 -> inventory +0x8, kept between 10 and 999
+    ScanCore::PointerPath ammoPath;
+    ammoPath.module = "game.exe";
+    ammoPath.baseOffset = 0x1234;
+    ammoPath.offsets = {0x10, 0x8};
+    ScanCore::CheatEntry ammo = ScanCore::CheatEntry::Clamp("Ammo", ammoPath, ScanCore::ValueType::Int32, 10, 999);
+    ammo.enabled = false;
+    ammoEntry = table.Add(ammo);
+}
+
+static void Toggle(size_t entry, const char* name) {
+    bool enabled = !Table().IsEnabled(entry);
+    Table().SetEnabled(entry, enabled);
+    std::cout << name << (enabled ? " ON" : " OFF") << std::endl;
+}
+
+static void PrintStats() {
+    ScanCore::CheatTable::Stats stats = Table().GetStats();
+    std::cout << "Ticks: " << stats.ticks << ", writes: " << stats.writes << ", failed: " << stats.failedWrites
+              << ", re-resolved: " << stats.resolves << std::endl;
+    std::cout << "Tick latency p99: " << stats.latency.p99 << " us, wake jitter p99: " << stats.jitter.p99 << " us" << std::endl;
 }
 
 void Trainer::GameLoop() {
     while (true) {
-        // Example: Toggle Infinite Health with F1 key
+        // Example: Toggle Infinite Health with F1 key, Ammo with F2, print table timing with F3
         if (GetAsyncKeyState(VK_F1) & 0x8000) {
-            InfiniteHealth();
+            Toggle(healthEntry, "Infinite Health");
             // Debounce the key press
             Sleep(200);
         }
+        if (GetAsyncKeyState(VK_F2) & 0x8000) {
+            Toggle(ammoEntry, "Ammo");
+            Sleep(200);
+        }
+        if (GetAsyncKeyState(VK_F3) & 0x8000) {
+            PrintStats();
+            Sleep(200);
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 }
 
 void Trainer::Initialize() {
     std::cout << "Trainer Initialized" << std::endl;
+    AddEntries();
+    // Freezes are applied at 100 Hz on the table's own thread
+    Table().Start();
     // Start the game loop in a separate thread
     std::thread(GameLoop).detach();
 }
 
 void Trainer::Shutdown() {
+    // Called from DllMain, so don't join the table's thread (see Table()); just stop it writing
+    for (size_t i = 0; i < Table().Size(); ++i) Table().SetEnabled(i, false);
     std::cout << "Trainer Shutdown" << std::endl;
 }
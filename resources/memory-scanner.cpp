@@ -8,7 +8,13 @@
  * - 이름으로 대상 프로세스에 연결.
  * - 정수, 부동 소수점, 문자열 및 바이트 배열 값 스캔.
  * - 값 변경(예: 증가, 감소, 변경 없음)을 기반으로 스캔 결과 필터링.
- * - 주어진 주소에서 메모리 읽기 및 쓰기.
+ * - 알 수 없는 초기값 스캔 (쓰기 가능한 메모리 스냅샷 후 변경 필터로 좁히기).
+ * - 다음 스캔에서 지난 스캔 이후 쓰이지 않은 페이지는 다시 읽지 않음 (soft-dirty, 안 되면 페이지 해시).
+ * - 값 스캔은 백그라운드 작업으로 실행하고 진행률 표시. ESC로 중단하고 나중에 이어서 스캔.
+ * - 주어진 주소에서 메모리 읽기 및 쓰기. 모든 결과 주소에 한 번에 쓰기 (일괄 쓰기, 필요한 페이지만 보호 변경).
+ * - 행동 전/후 메모리 비교: 바뀐 페이지 → 바뀐 바이트 구간 → 값 분류 (float 변화, 정수 증감, 포인터 교체).
+ * - 프로세스 대신 덤프 파일(.scsd 희소 덤프, .scmd 원본 덤프)을 스캔: memory-scanner.exe before.scsd after.scsd
+ *   덤프를 차례로 바꿔 가며 다음 스캔 (앞 덤프의 값과 다음 덤프의 값을 비교).
  * - 기본 오류 처리 및 프로세스 정보.
  */
 
@@ -20,9 +26,29 @@
 #include <string>
 #include <iomanip>
 #include <algorithm>
-#include <map>
+#include <iterator>
 #include <codecvt>
 #include <locale>
+#include <type_traits>
+#include <memory>
+#include <chrono>
+#include <functional>
+
+#include "scan-core/ScanKernels.h"
+#include "scan-core/FloatScanKernels.h"
+#include "scan-core/CompiledPattern.h"
+#include "scan-core/ScanExecutor.h"
+#include "scan-core/ScanJob.h"
+#include "scan-core/ScanResultStore.h"
+#include "scan-core/SnapshotScanner.h"
+#include "scan-core/WriteTransaction.h"
+#include "scan-core/BatchReader.h"
+#include "scan-core/DirtyPageTracker.h"
+#include "scan-core/MultiTypeScan.h"
+#include "scan-core/StringScan.h"
+#include "scan-core/ProcessMemory.h"
+#include "scan-core/DumpMemory.h"
+#include "scan-core/SnapshotDiff.h"
 
 // Helper function to convert wstring to string
 std::string WStringToString(const std::wstring& wstr) {
@@ -38,20 +64,39 @@ std::wstring StringToWString(const std::string& str) {
 
 class MemoryScanner {
 private:
-    HANDLE processHandle;
+    std::unique_ptr<ScanCore::IProcessMemory> memory; // 영역 열거/읽기/쓰기 백엔드 (Win32, Linux, 덤프)
     DWORD processId;
     std::wstring processName;
-    std::map<uintptr_t, std::vector<uint8_t>> previousScanResults; // 값 변경 필터링용
-
-public:
-    MemoryScanner() : processHandle(nullptr), processId(0) {}
-
-    ~MemoryScanner() {
-        if (processHandle) {
-            CloseHandle(processHandle);
+    ScanCore::ScanExecutor scanExecutor; // 영역 병렬 스캔
+    std::unique_ptr<ScanCore::DirtyPageTracker> dirtyTracker; // 다음 스캔에서 바뀌지 않은 페이지 건너뛰기
+    std::unique_ptr<ScanCore::MemoryDump> diffBaseline; // 행동 전/후 비교의 "행동 전" 복사본
+
+    // ESC로 중단된 첫 스캔: 남은 작업 단위와 그 단위를 같은 조건으로 스캔하는 함수
+    using UnitScan = std::function<ScanCore::PartialScan<ScanCore::ScanResultStore>(const std::vector<ScanCore::ScanExecutor::WorkUnit>&)>;
+    struct InterruptedScan {
+        UnitScan scan;
+        std::vector<ScanCore::ScanExecutor::WorkUnit> pending;
+    } interrupted;
+
+    // 오프라인 모드: 명령줄로 받은 덤프 파일과 지금 스캔 중인 덤프 번호
+    std::vector<std::string> dumpPaths;
+    size_t dumpIndex = 0;
+
+    bool OpenDump(size_t index) {
+        std::unique_ptr<ScanCore::IProcessMemory> dump = ScanCore::OpenDumpMemory(dumpPaths[index]);
+        if (!dump) {
+            std::wcout << L"덤프 파일을 열 수 없습니다: " << StringToWString(dumpPaths[index]) << std::endl;
+            return false;
         }
+        dumpIndex = index;
+        std::wcout << L"덤프 " << (index + 1) << L"/" << dumpPaths.size() << L" 연결: " << StringToWString(dumpPaths[index]) << std::endl;
+        AttachToMemory(std::move(dump), StringToWString(dumpPaths[index]));
+        return true;
     }
 
+public:
+    MemoryScanner() : processId(0) {}
+
     bool AttachToProcess(const std::wstring& targetProcess) {
         processName = targetProcess;
 
@@ -83,64 +128,277 @@ public:
             return false;
         }
 
-        // 필요한 권한으로 프로세스 핸들 열기
-        processHandle = OpenProcess(PROCESS_VM_READ | PROCESS_VM_WRITE | PROCESS_QUERY_INFORMATION | PROCESS_VM_OPERATION, FALSE, processId);
-        if (!processHandle) {
+        // 필요한 권한(읽기/쓰기/보호 변경/조회)으로 프로세스 열기
+        memory = ScanCore::OpenProcessMemory(processId);
+        if (!memory) {
             std::wcout << L"프로세스 핸들 열기 실패. 오류: " << GetLastError() << std::endl;
             return false;
         }
 
         std::wcout << L"프로세스에 성공적으로 연결됨: " << processName
                    << L" (PID: " << processId << L")" << std::endl;
+        StartDirtyTracking();
         return true;
     }
 
+    // 실제 프로세스 대신 다른 백엔드(예: 메모리 덤프)를 대상으로 스캔
+    void AttachToMemory(std::unique_ptr<ScanCore::IProcessMemory> source, const std::wstring& name) {
+        memory = std::move(source);
+        processName = name;
+        processId = 0;
+        StartDirtyTracking();
+    }
+
+    // 덤프 파일 여러 개를 순서대로 스캔 (게임 없이 오프라인 분석). 첫 덤프에 연결
+    bool AttachToDumps(const std::vector<std::string>& paths) {
+        dumpPaths = paths;
+        return !dumpPaths.empty() && OpenDump(0);
+    }
+
+    bool HasNextDump() const { return dumpIndex + 1 < dumpPaths.size(); }
+
+    // 다음 덤프로 전환. 후보와 이전 값은 그대로 두므로 다음 스캔이 앞 덤프와 이번 덤프의 값을 비교
+    bool SwitchToNextDump() {
+        return HasNextDump() && OpenDump(dumpIndex + 1);
+    }
+
+    void StartDirtyTracking() {
+        dirtyTracker = std::make_unique<ScanCore::DirtyPageTracker>(*memory);
+        std::wcout << L"변경 페이지 추적: " << ScanCore::DirtyTrackingModeName(dirtyTracker->Mode()) << std::endl;
+    }
+
+    // 지금부터 읽는 값이 다음 스캔의 이전 값 (변경 추적 기준점)
+    void ArmDirtyTracking() {
+        if (dirtyTracker) dirtyTracker->Arm();
+    }
+
+    // 버퍼 내 모든 (비정렬 포함) 일치 위치 검색
+    // 정수/부동 소수점은 SIMD 커널(AVX2/SSE2)을 사용하고, 그 외 타입은 바이트 단위 루프로 처리
+    template<typename T>
+    static void FindValueInBuffer(const uint8_t* data, size_t size, const T& value, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+        if constexpr (ScanCore::IsKernelType<T>::value) {
+            ScanCore::FindExact<T>(data, size, value, baseAddress, out);
+        } else {
+            for (size_t i = 0; i + sizeof(T) <= size; ++i) {
+                T currentValue;
+                memcpy(&currentValue, data + i, sizeof(T));
+                if (currentValue == value) {
+                    out.push_back(baseAddress + i);
+                }
+            }
+        }
+    }
+
+    // 스캔 실행기 설정 (0 = CPU 코어 수만큼 스레드 사용)
+    void SetScanThreads(size_t threadCount) { scanExecutor.SetThreadCount(threadCount); }
+    void SetScanChunkSize(size_t chunkSize) { scanExecutor.SetChunkSize(chunkSize); }
+
+    // 조건에 맞는 커밋된 메모리 영역 목록 수집
+    template<typename Filter>
+    std::vector<ScanCore::MemoryRange> CollectRegions(Filter accept) {
+        return memory->CollectRanges(accept);
+    }
+
+    // 실행기 워커 스레드에서 호출되는 읽기 함수
+    ScanCore::ScanExecutor::ReadFunction MakeReadFunction() {
+        return memory->MakeReadFunction();
+    }
+
+    // 다음 스캔용 일괄 읽기: 정렬된 후보를 페이지 구간으로 묶어 한 번에 읽음
+    // (Win32는 구간마다 ReadProcessMemory, Linux는 process_vm_readv 한 번에 여러 구간)
+    ScanCore::BatchReader MakeBatchReader() {
+        return ScanCore::BatchReader(memory->MakeBatchReadFunction());
+    }
+
+    static bool IsValueScanRegion(const ScanCore::MemoryRegion& region) {
+        // 읽기 가능한 메모리 영역만 스캔 (가드 페이지, copy-on-write 이미지 영역 제외)
+        return region.IsReadable() && !(region.protection & ScanCore::MemoryCopyOnWrite);
+    }
+
+    static bool IsPatternScanRegion(const ScanCore::MemoryRegion& region) {
+        return region.IsReadable();
+    }
+
     // 일반 스캔 함수
+    // 결과는 찾은 시점의 값과 함께 압축 저장소에 담기며, filter가 주어지면 그 후보와의 교집합만 남김
     template<typename T>
-    std::vector<uintptr_t> ScanMemory(const T& value, const std::vector<uintptr_t>& addressesToFilter = {}) {
-        std::vector<uintptr_t> foundAddresses;
-        
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
+    ScanCore::ScanResultStore ScanMemory(const T& value, const ScanCore::ScanResultStore* filter = nullptr) {
+        std::wcout << L"값 스캔 시작: " << value << L"... (커널: " << ScanCore::SimdLevelName(ScanCore::ActiveSimdLevel()) << L")" << std::endl;
+        return ScanValues<T>([value](const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            FindValueInBuffer(data, size, value, baseAddress, out);
+        }, filter);
+    }
 
-        uintptr_t currentAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMinimumApplicationAddress);
-        uintptr_t maxAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMaximumApplicationAddress);
+    // 실수 근사값/범위/집합 스캔 (float, double)
+    // 정확히 같은 값 대신 condition(오차 허용, 범위, 여러 값 중 하나)에 맞는 주소를 찾음. 비정규 수/NaN은 기본적으로 제외
+    template<typename T>
+    ScanCore::ScanResultStore ScanFloat(const ScanCore::FloatCondition<T>& condition, const ScanCore::ScanResultStore* filter = nullptr) {
+        std::wcout << L"실수 스캔 시작... (커널: " << ScanCore::SimdLevelName(ScanCore::ActiveSimdLevel()) << L")" << std::endl;
+        return ScanValues<T>([condition](const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            ScanCore::FindFloat(data, size, condition, baseAddress, out);
+        }, filter);
+    }
 
-        std::wcout << L"값 스캔 시작: " << value << L"..." << std::endl;
+    // 중단된 첫 스캔이 있는지 (다른 스캔을 하면 후보가 바뀌므로 버림)
+    bool HasInterruptedScan() const { return !interrupted.pending.empty(); }
+    void DiscardInterruptedScan() { interrupted = InterruptedScan(); }
+
+    // 중단된 첫 스캔의 남은 작업 단위를 스캔해 partial과 합침 (다시 중단되면 또 이어서 할 수 있음)
+    // 변경 추적은 처음 스캔을 시작할 때 건 기준점을 그대로 둠: 다시 걸면 이미 읽은 부분에 그 사이 쓴 페이지가
+    // 깨끗한 페이지로 보여 다음 스캔이 옛 값을 그대로 씀. 안 걸면 그 페이지는 변경으로 보고 다시 읽음
+    ScanCore::ScanResultStore ResumeScan(const ScanCore::ScanResultStore& partial) {
+        InterruptedScan resume = std::move(interrupted);
+        interrupted = InterruptedScan();
+        if (resume.pending.empty()) return partial;
+
+        std::wcout << L"중단된 스캔 이어서 하기: 작업 단위 " << resume.pending.size() << L"개 남음" << std::endl;
+        ScanCore::PartialScan<ScanCore::ScanResultStore> rest = resume.scan(resume.pending);
+        ScanCore::ScanResultStore found = Union(partial, rest.value);
+        ReportScan(found, rest, resume.scan, true);
+        return found;
+    }
 
-        while (currentAddress < maxAddress) {
-            MEMORY_BASIC_INFORMATION mbi;
-            if (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(currentAddress), &mbi, sizeof(mbi)) == 0) {
-                break;
-            }
+    // 모든 타입 값 스캔 (int16/32/64, float, double): 타입을 모를 때 타입마다 스캔하지 않고 메모리를 한 번만 읽음
+    // 결과는 타입별 저장소에 담겨 다음 스캔에서 후보마다 자기 타입으로 비교됨
+    ScanCore::TypedResultStore ScanAllTypes(const ScanCore::MultiTypeQuery& query) {
+        std::wcout << L"모든 타입 스캔 시작... (커널: " << ScanCore::SimdLevelName(ScanCore::ActiveSimdLevel()) << L")" << std::endl;
+        ArmDirtyTracking();
 
-            // 커밋되고 읽기 가능한 메모리 영역만 스캔
-            if (mbi.State == MEM_COMMIT && 
-                (mbi.Protect == PAGE_READWRITE || 
-                 mbi.Protect == PAGE_READONLY ||
-                 mbi.Protect == PAGE_EXECUTE_READ ||
-                 mbi.Protect == PAGE_EXECUTE_READWRITE)) {
-                
-                std::vector<uint8_t> buffer(mbi.RegionSize);
-                SIZE_T bytesRead;
-
-                if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(currentAddress), buffer.data(), mbi.RegionSize, &bytesRead)) {
-                    for (SIZE_T i = 0; i <= bytesRead - sizeof(T); ++i) {
-                        T currentValue = *reinterpret_cast<const T*>(&buffer[i]);
-                        if (currentValue == value) {
-                            uintptr_t foundAddr = currentAddress + i;
-                            if (addressesToFilter.empty() || 
-                                std::find(addressesToFilter.begin(), addressesToFilter.end(), foundAddr) != addressesToFilter.end()) {
-                                foundAddresses.push_back(foundAddr);
-                            }
+        ScanCore::TypedResultStore found = ScanCore::ScanAllTypes(scanExecutor, CollectRegions(IsValueScanRegion), MakeReadFunction(), query);
+
+        std::wcout << L"스캔 완료. " << found.Count() << L"개 주소 발견.";
+        for (size_t t = 0; t < ScanCore::ValueTypeCount; ++t) {
+            ScanCore::ValueType type = static_cast<ScanCore::ValueType>(t);
+            if (found.Count(type)) std::wcout << L" " << ScanCore::ValueTypeName(type) << L": " << found.Count(type);
+        }
+        std::wcout << std::endl;
+        return found;
+    }
+
+    // 값 스캔 공통: 작업 단위마다 find로 찾은 주소를 값과 함께 저장소 조각으로 만들어 병합
+    // 스캔은 백그라운드 작업으로 실행하고 진행률을 표시. ESC를 누르면 끝낸 단위까지의 결과를 반환
+    template<typename T, typename Find>
+    ScanCore::ScanResultStore ScanValues(Find find, const ScanCore::ScanResultStore* filter) {
+        ArmDirtyTracking();
+        DiscardInterruptedScan();
+
+        // 작업 단위 경계에 걸친 값도 찾도록 sizeof(T) - 1 바이트 더 읽음
+        scanExecutor.SetOverlap(sizeof(T) - 1);
+        std::vector<ScanCore::ScanExecutor::WorkUnit> units = scanExecutor.SplitIntoUnits(CollectRegions(IsValueScanRegion));
+
+        UnitScan scan = [this, find](const std::vector<ScanCore::ScanExecutor::WorkUnit>& pending) {
+            return RunStoreScan<T>(pending, find);
+        };
+        ScanCore::PartialScan<ScanCore::ScanResultStore> scanned = scan(units);
+        ScanCore::ScanResultStore found = std::move(scanned.value);
+
+        if (filter) {
+            found = Intersect(found, *filter);
+        }
+        // 필터가 있는 스캔은 이미 후보를 줄였으므로 이어서 할 수 없음 (부분 결과만)
+        ReportScan(found, scanned, scan, filter == nullptr);
+        return found;
+    }
+
+    // units를 실행기 복사본으로 스캔하는 백그라운드 작업을 띄우고 끝날 때까지 진행률 표시
+    // 작업 단위마다 저장소 조각을 만들어 전체 주소 목록(결과당 8바이트)을 거치지 않고 병합
+    template<typename T, typename Find>
+    ScanCore::PartialScan<ScanCore::ScanResultStore> RunStoreScan(const std::vector<ScanCore::ScanExecutor::WorkUnit>& units, Find find) {
+        ScanCore::ScanJob<ScanCore::PartialScan<ScanCore::ScanResultStore>> job = ScanCore::StartScanJob(
+            [this, &units, &find](ScanCore::ScanControl& control) {
+                ScanCore::ScanExecutor executor = scanExecutor;
+                executor.SetControl(&control);
+                std::vector<ScanCore::ScanResultStore> fragments = executor.RunUnits<ScanCore::ScanResultStore>(units, MakeReadFunction(),
+                    [&find, &control](const uint8_t* data, size_t size, const ScanCore::ScanExecutor::WorkUnit& unit, ScanCore::ScanResultStore& fragment) {
+                        thread_local std::vector<uintptr_t> hits;
+                        hits.clear();
+                        find(data, size, unit.base, hits);
+
+                        ScanCore::ScanResultStore::Builder builder(sizeof(T));
+                        for (uintptr_t address : hits) {
+                            if (address >= unit.base + unit.size) break;
+                            builder.Append(address, data + (address - unit.base));
                         }
-                    }
+                        fragment = builder.Finish();
+                        control.AddHits(fragment.Count());
+                    });
+
+                ScanCore::ScanResultStore::Builder builder(sizeof(T));
+                for (ScanCore::ScanResultStore& fragment : fragments) {
+                    builder.Append(fragment);
+                    fragment = ScanCore::ScanResultStore();
                 }
+                ScanCore::PartialScan<ScanCore::ScanResultStore> result;
+                result.value = builder.Finish();
+                result.pending = executor.GetPendingUnits();
+                return result;
+            });
+        return WaitWithProgress(job);
+    }
+
+    // 작업이 끝날 때까지 0.2초마다 진행률을 한 줄에 다시 씀. ESC를 누르면 취소 요청
+    template<typename Result>
+    static Result WaitWithProgress(ScanCore::ScanJob<Result>& job) {
+        Result result = ScanCore::WaitScanJob(job, std::chrono::milliseconds(200), [](const ScanCore::ScanControl& progress) {
+            std::wcout << L"\r  진행 " << static_cast<int>(progress.Fraction() * 100) << L"% ("
+                       << progress.BytesDone() / (1024 * 1024) << L"/" << progress.BytesTotal() / (1024 * 1024) << L"MB), "
+                       << progress.Hits() << L"개 발견. ESC: 중단   " << std::flush;
+            return (GetAsyncKeyState(VK_ESCAPE) & 0x8000) == 0;
+        });
+        std::wcout << L"\r" << std::wstring(70, L' ') << L"\r";
+        return result;
+    }
+
+    void ReportScan(const ScanCore::ScanResultStore& found, const ScanCore::PartialScan<ScanCore::ScanResultStore>& scanned,
+                    const UnitScan& scan, bool resumable) {
+        std::wcout << L"스캔 " << (scanned.Complete() ? L"완료. " : L"중단됨. ") << found.Count() << L"개 주소 발견. ("
+                   << scanExecutor.ResolveThreadCount(static_cast<size_t>(-1)) << L"개 스레드, 결과 메모리 "
+                   << found.MemoryUsage() / 1024 << L"KB)" << std::endl;
+        if (scanned.Complete()) return;
+        if (resumable) {
+            interrupted = {scan, scanned.pending};
+            std::wcout << L"남은 작업 단위 " << scanned.pending.size() << L"개. 14번으로 이어서 스캔할 수 있습니다." << std::endl;
+        } else {
+            std::wcout << L"스캔하지 못한 영역이 있어 결과가 일부입니다." << std::endl;
+        }
+    }
+
+    // 두 저장소의 주소를 모두 남김 (주소 구간이 겹치지 않는 부분 결과를 합칠 때). 둘 다 정렬되어 있으므로 선형 병합
+    static ScanCore::ScanResultStore Union(const ScanCore::ScanResultStore& a, const ScanCore::ScanResultStore& b) {
+        ScanCore::ScanResultStore::Builder builder(a.ValueSize());
+        auto itA = a.begin();
+        auto itB = b.begin();
+        while (itA != a.end() || itB != b.end()) {
+            if (itB == b.end() || (itA != a.end() && (*itA).address < (*itB).address)) {
+                builder.Append((*itA).address, (*itA).value);
+                ++itA;
+            } else {
+                builder.Append((*itB).address, (*itB).value);
+                ++itB;
             }
-            currentAddress += mbi.RegionSize;
         }
-        std::wcout << L"스캔 완료. " << foundAddresses.size() << L"개 주소 발견." << std::endl;
-        return foundAddresses;
+        return builder.Finish();
+    }
+
+    // 두 저장소 모두에 있는 주소만 남김 (값은 a의 것을 사용). 둘 다 정렬되어 있으므로 선형 병합
+    static ScanCore::ScanResultStore Intersect(const ScanCore::ScanResultStore& a, const ScanCore::ScanResultStore& b) {
+        ScanCore::ScanResultStore::Builder builder(a.ValueSize());
+        auto itA = a.begin();
+        auto itB = b.begin();
+        while (itA != a.end() && itB != b.end()) {
+            uintptr_t addrA = (*itA).address;
+            uintptr_t addrB = (*itB).address;
+            if (addrA < addrB) {
+                ++itA;
+            } else if (addrB < addrA) {
+                ++itB;
+            } else {
+                builder.Append(addrA, (*itA).value);
+                ++itA;
+                ++itB;
+            }
+        }
+        return builder.Finish();
     }
 
     // 바이트 배열(패턴) 특화 스캔
@@ -152,140 +410,263 @@ public:
             return results;
         }
 
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
-
-        uintptr_t currentAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMinimumApplicationAddress);
-        uintptr_t maxAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMaximumApplicationAddress);
+        // 가장 드문 고정 바이트를 앵커로 두 번 건너뛰고 후보만 마스크 비교
+        ScanCore::CompiledPattern compiled(pattern, mask);
 
         std::wcout << L"패턴 스캔 시작..." << std::endl;
 
-        while (currentAddress < maxAddress) {
-            MEMORY_BASIC_INFORMATION mbi;
-            if (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(currentAddress), &mbi, sizeof(mbi)) == 0) {
-                break;
-            }
-
-            if (mbi.State == MEM_COMMIT && mbi.Protect != PAGE_NOACCESS) {
-                std::vector<uint8_t> buffer(mbi.RegionSize);
-                SIZE_T bytesRead;
-
-                if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(currentAddress), buffer.data(), mbi.RegionSize, &bytesRead)) {
-                    for (SIZE_T i = 0; i <= bytesRead - pattern.size(); ++i) {
-                        bool match = true;
-                        for (SIZE_T j = 0; j < pattern.size(); ++j) {
-                            if (mask[j] && buffer[i + j] != pattern[j]) {
-                                match = false;
-                                break;
-                            }
-                        }
-                        if (match) {
-                            uintptr_t foundAddr = currentAddress + i;
-                            if (addressesToFilter.empty() || 
-                                std::find(addressesToFilter.begin(), addressesToFilter.end(), foundAddr) != addressesToFilter.end()) {
-                                results.push_back(foundAddr);
-                            }
-                        }
-                    }
-                }
-            }
-            currentAddress += mbi.RegionSize;
+        std::vector<ScanCore::MemoryRange> regions = CollectRegions(IsPatternScanRegion);
+
+        scanExecutor.SetOverlap(pattern.size() - 1);
+        std::vector<uintptr_t> hits = scanExecutor.Run(regions, MakeReadFunction(),
+            [&compiled](const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+                compiled.FindAll(data, size, baseAddress, out);
+            });
+
+        if (addressesToFilter.empty()) {
+            results = std::move(hits);
+        } else {
+            // 스캔 결과는 정렬되어 있으므로 필터 목록도 정렬한 뒤 선형 병합
+            std::vector<uintptr_t> filter = addressesToFilter;
+            std::sort(filter.begin(), filter.end());
+            std::set_intersection(hits.begin(), hits.end(), filter.begin(), filter.end(), std::back_inserter(results));
         }
         std::wcout << L"패턴 스캔 완료. " << results.size() << L"개 주소 발견." << std::endl;
         return results;
     }
 
+    // 문자열 스캔: UTF-8과 UTF-16LE(wchar_t)를 한 번에 찾음. 대소문자 무시는 ASCII 글자만
+    std::vector<ScanCore::StringMatch> ScanStrings(const std::string& utf8Text, bool caseInsensitive) {
+        ScanCore::StringSearchOptions options;
+        options.caseInsensitive = caseInsensitive;
+        ScanCore::StringSearcher searcher(utf8Text, options);
+        if (searcher.Empty()) {
+            std::wcout << L"유효하지 않은 문자열." << std::endl;
+            return {};
+        }
+
+        std::wcout << L"문자열 스캔 시작... (커널: " << ScanCore::SimdLevelName(ScanCore::ActiveSimdLevel()) << L")" << std::endl;
+        std::vector<ScanCore::StringMatch> matches = ScanCore::ScanStrings(scanExecutor, CollectRegions(IsPatternScanRegion), MakeReadFunction(), searcher);
+
+        size_t utf16 = static_cast<size_t>(std::count_if(matches.begin(), matches.end(),
+            [](const ScanCore::StringMatch& match) { return match.encoding == ScanCore::StringEncoding::Utf16LE; }));
+        std::wcout << L"문자열 스캔 완료. " << matches.size() << L"개 주소 발견. UTF-8: " << matches.size() - utf16
+                   << L" UTF-16LE: " << utf16 << std::endl;
+        return matches;
+    }
+
     // 특정 주소에서 메모리 읽기
     template<typename T>
     bool ReadMemory(uintptr_t address, T& value) {
-        SIZE_T bytesRead;
-        return ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address), &value, sizeof(T), &bytesRead) && bytesRead == sizeof(T);
+        return memory->ReadValue(address, value);
     }
 
     // 특정 주소에 메모리 쓰기
     template<typename T>
     bool WriteMemory(uintptr_t address, const T& value) {
-        SIZE_T bytesWritten;
-        DWORD oldProtect;
-        // 쓰기 허용을 위해 메모리 보호 임시 변경
-        if (!VirtualProtectEx(processHandle, reinterpret_cast<LPVOID>(address), sizeof(T), PAGE_EXECUTE_READWRITE, &oldProtect)) {
-            std::wcout << L"쓰기 위해 메모리 보호 변경 실패. 오류: " << GetLastError() << std::endl;
-            return false;
-        }
-        BOOL success = WriteProcessMemory(processHandle, reinterpret_cast<LPVOID>(address), &value, sizeof(T), &bytesWritten);
-        // 원래 메모리 보호 복원
-        DWORD tempProtect;
-        VirtualProtectEx(processHandle, reinterpret_cast<LPVOID>(address), sizeof(T), oldProtect, &tempProtect);
-        return success && bytesWritten == sizeof(T);
+        // 먼저 그대로 쓰고, 쓰기 보호된 페이지면 그 페이지만 보호를 바꿔 다시 쓴 뒤 복원
+        ScanCore::WriteTransaction transaction(*memory);
+        transaction.Add(address, value);
+        return transaction.Commit().Ok();
+    }
+
+    // 여러 주소에 같은 값 쓰기: 한 번의 일괄 쓰기 (보호 변경은 실패한 페이지 구간에만). 쓴 주소 수를 반환
+    template<typename T>
+    size_t WriteMemory(const std::vector<uintptr_t>& addresses, const T& value) {
+        ScanCore::WriteTransaction transaction(*memory);
+        for (uintptr_t address : addresses) transaction.Add(address, value);
+        ScanCore::WriteTransaction::Result result = transaction.Commit();
+        return result.writes - result.failed;
     }
 
     // 값 변경에 따라 결과 필터링
+    // 저장소에 담긴 이전 값과 현재 값을 비교하고, 남은 주소는 현재 값과 함께 새 저장소에 담음
     template<typename T>
-    std::vector<uintptr_t> FilterByChange(const std::vector<uintptr_t>& currentAddresses, 
-                                          const std::string& changeType) {
-        std::vector<uintptr_t> filteredAddresses;
+    ScanCore::ScanResultStore FilterByChange(const ScanCore::ScanResultStore& currentResults, 
+                                             const std::string& changeType) {
+        ScanCore::ScanResultStore::Builder builder(sizeof(T));
         
-        if (currentAddresses.empty()) {
+        if (currentResults.Empty()) {
             std::wcout << L"필터링할 주소가 없습니다." << std::endl;
-            return filteredAddresses;
-        }
-
-        std::wcout << L"" << currentAddresses.size() << L"개 주소를 변경 유형: " << StringToWString(changeType) << L"로 필터링 중..." << std::endl;
-
-        for (uintptr_t addr : currentAddresses) {
-            T currentValue;
-            if (ReadMemory(addr, currentValue)) {
-                // 이전 스캔 결과에 이 주소가 있었는지 확인
-                if (previousScanResults.count(addr)) {
-                    T previousValue = *reinterpret_cast<T*>(previousScanResults[addr].data());
-
-                    bool include = false;
-                    if (changeType == "unchanged" && currentValue == previousValue) {
-                        include = true;
-                    } else if (changeType == "increased" && currentValue > previousValue) {
-                        include = true;
-                    } else if (changeType == "decreased" && currentValue < previousValue) {
-                        include = true;
-                    } else if (changeType == "changed" && currentValue != previousValue) {
-                        include = true;
-                    }
-
-                    if (include) {
-                        filteredAddresses.push_back(addr);
-                    }
-                }
-            }
+            return builder.Finish();
         }
 
-        // 다음 필터링 작업을 위해 이전 스캔 결과 업데이트
-        previousScanResults.clear();
-        for (uintptr_t addr : filteredAddresses) {
-            T value;
-            if (ReadMemory(addr, value)) {
-                std::vector<uint8_t> bytes(sizeof(T));
-                memcpy(bytes.data(), &value, sizeof(T));
-                previousScanResults[addr] = bytes;
-            }
+        if (currentResults.ValueSize() != sizeof(T)) {
+            std::wcout << L"이전 스캔 결과의 값 크기가 다릅니다." << std::endl;
+            return builder.Finish();
+        }
+
+        ScanCore::ChangeFilter filter;
+        if (!ScanCore::ParseChangeFilter(changeType, filter)) {
+            std::wcout << L"알 수 없는 변경 유형입니다." << std::endl;
+            return builder.Finish();
+        }
+
+        std::wcout << L"" << currentResults.Count() << L"개 주소를 변경 유형: " << StringToWString(changeType) << L"로 필터링 중..." << std::endl;
+
+        // 후보마다 ReadMemory를 부르지 않고 페이지 구간 단위로 한 번에 읽음
+        // 지난 스캔 이후 쓰이지 않은 페이지의 후보는 읽지 않음 (soft-dirty) / 비교하지 않음 (페이지 해시)
+        ScanCore::BatchReader reader = MakeBatchReader();
+        ScanCore::ScanResultStore filtered = ScanCore::FilterResultStore<T>(currentResults, filter, reader, dirtyTracker.get());
+
+        const ScanCore::BatchReader::Stats& stats = reader.GetLastStats();
+        std::wcout << L"" << filtered.Count() << L"개 주소로 필터링됨. (읽기 구간 " << stats.runs
+                   << L"개, 읽지 않은 주소 " << stats.skipped << L"개, 읽지 못한 주소 " << stats.unreadable << L"개)" << std::endl;
+        return filtered;
+    }
+
+    // 모든 타입 스캔 결과 필터링: 모든 타입의 후보를 한 번에 읽고 후보마다 자기 타입으로 비교
+    ScanCore::TypedResultStore FilterTypedByChange(const ScanCore::TypedResultStore& currentResults, const std::string& changeType) {
+        ScanCore::ChangeFilter filter;
+        if (!ScanCore::ParseChangeFilter(changeType, filter)) {
+            std::wcout << L"알 수 없는 변경 유형입니다." << std::endl;
+            return ScanCore::TypedResultStore();
+        }
+
+        std::wcout << L"" << currentResults.Count() << L"개 주소를 변경 유형: " << StringToWString(changeType) << L"로 필터링 중..." << std::endl;
+        ScanCore::BatchReader reader = MakeBatchReader();
+        ScanCore::TypedResultStore filtered = ScanCore::FilterTypedResultStore(currentResults, filter, reader, dirtyTracker.get());
+
+        const ScanCore::BatchReader::Stats& stats = reader.GetLastStats();
+        std::wcout << L"" << filtered.Count() << L"개 주소로 필터링됨. (읽기 구간 " << stats.runs
+                   << L"개, 읽지 않은 주소 " << stats.skipped << L"개, 읽지 못한 주소 " << stats.unreadable << L"개)" << std::endl;
+        return filtered;
+    }
+
+    static bool IsSnapshotRegion(const ScanCore::MemoryRegion& region) {
+        // 게임 값이 바뀌는 곳은 쓰기 가능한 영역뿐이므로 그 영역만 스냅샷
+        return region.IsWritable();
+    }
+
+    // 알 수 없는 초기값 스캔: 쓰기 가능한 영역 전체를 페이지 단위로 복사 (모든 정렬 위치가 후보)
+    template<typename T>
+    std::unique_ptr<ScanCore::SnapshotScanner<T>> CaptureSnapshot() {
+        std::wcout << L"쓰기 가능한 메모리 스냅샷 생성 중..." << std::endl;
+
+        auto snapshot = std::make_unique<ScanCore::SnapshotScanner<T>>(sizeof(T), scanExecutor.GetConfig());
+        snapshot->Capture(CollectRegions(IsSnapshotRegion), MakeReadFunction(), dirtyTracker.get());
+
+        ShowSnapshot(*snapshot);
+        return snapshot;
+    }
+
+    // 스냅샷 후보를 페이지 대 페이지로 비교하여 필터링
+    template<typename T>
+    void FilterSnapshot(ScanCore::SnapshotScanner<T>& snapshot, const std::string& changeType) {
+        ScanCore::ChangeFilter filter;
+        if (!ScanCore::ParseChangeFilter(changeType, filter)) {
+            std::wcout << L"알 수 없는 변경 유형입니다." << std::endl;
+            return;
         }
 
-        std::wcout << L"" << filteredAddresses.size() << L"개 주소로 필터링됨." << std::endl;
-        return filteredAddresses;
+        std::wcout << L"" << snapshot.CandidateCount() << L"개 후보를 변경 유형: " << StringToWString(changeType) << L"로 필터링 중..." << std::endl;
+        snapshot.Filter(filter, MakeReadFunction(), dirtyTracker.get());
+        ShowSnapshot(snapshot);
     }
 
-    // 필터링을 위해 현재 스캔 결과 저장
     template<typename T>
-    void StoreCurrentResults(const std::vector<uintptr_t>& addresses) {
-        previousScanResults.clear();
-        for (uintptr_t addr : addresses) {
-            T value;
-            if (ReadMemory(addr, value)) {
-                std::vector<uint8_t> bytes(sizeof(T));
-                memcpy(bytes.data(), &value, sizeof(T));
-                previousScanResults[addr] = bytes;
+    void ShowSnapshot(ScanCore::SnapshotScanner<T>& snapshot) {
+        const ScanCore::ScanExecutor::Stats& stats = snapshot.GetExecutor().GetLastStats();
+        std::wcout << L"후보 " << snapshot.CandidateCount() << L"개, 페이지 " << snapshot.PageCount()
+                   << L"개 (스냅샷 메모리 " << snapshot.MemoryUsage() / 1024 << L"KB, "
+                   << stats.threadCount << L"개 스레드, 읽지 않은 페이지 " << snapshot.LastSkippedPages() << L"개)" << std::endl;
+    }
+
+    // 필터링을 위해 주소 목록(예: 패턴 스캔 결과)의 현재 값을 읽어 저장소로 만듦
+    template<typename T>
+    ScanCore::ScanResultStore StoreCurrentResults(std::vector<uintptr_t> addresses) {
+        std::sort(addresses.begin(), addresses.end());
+        addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+
+        ArmDirtyTracking();
+        ScanCore::ScanResultStore::Builder builder(sizeof(T));
+        MakeBatchReader().ForEachAddress(addresses, sizeof(T), [&builder](uintptr_t addr, const uint8_t* current) {
+            builder.Append(addr, current);
+        });
+        return builder.Finish();
+    }
+
+    bool HasDiffBaseline() const { return diffBaseline != nullptr; }
+
+    // 행동 전/후 비교: 처음에는 쓰기 가능한 영역을 복사해 기준으로 두고, 다음 호출에서 지금 메모리와 비교
+    // (덤프 모드에서는 기준을 잡고 16번으로 다음 덤프로 넘어간 뒤 다시 호출하면 두 덤프를 비교)
+    void DiffSnapshot(int limit = 20) {
+        if (!diffBaseline) {
+            std::wcout << L"행동 전 메모리 복사 중..." << std::endl;
+            diffBaseline = std::make_unique<ScanCore::MemoryDump>(ScanCore::MemoryDump::Capture(*memory, IsSnapshotRegion));
+            std::wcout << L"" << diffBaseline->TotalSize() / (1024 * 1024) << L"MB 복사함. 게임에서 행동한 뒤 다시 선택하세요." << std::endl;
+            return;
+        }
+
+        ScanCore::SnapshotDiff diff(ScanCore::SnapshotDiffConfig(), scanExecutor.GetConfig());
+        ScanCore::SnapshotDiffResult result = diff.Run(*diffBaseline, *memory, IsSnapshotRegion);
+        diffBaseline.reset();
+
+        const ScanCore::SnapshotDiffResult::Stats& stats = result.stats;
+        std::wcout << L"바뀐 페이지 " << stats.pagesChanged << L"/" << stats.pagesBefore << L", 바뀐 구간 " << result.ranges.size()
+                   << L" (" << stats.bytesChanged << L"바이트), 해시 " << stats.hashSeconds << L"초, 비교 " << stats.diffSeconds << L"초" << std::endl;
+        std::wcout << L"float 변화 " << stats.ValueCount(ScanCore::ChangeKind::FloatDelta)
+                   << L", 정수 증감 " << stats.ValueCount(ScanCore::ChangeKind::IntIncrement)
+                   << L", 포인터 교체 " << stats.ValueCount(ScanCore::ChangeKind::PointerSwap)
+                   << L", 기타 " << stats.ValueCount(ScanCore::ChangeKind::Other) << std::endl;
+
+        // 종류마다 최대 limit개 (기타는 생략)
+        for (ScanCore::ChangeKind kind : {ScanCore::ChangeKind::FloatDelta, ScanCore::ChangeKind::IntIncrement, ScanCore::ChangeKind::PointerSwap}) {
+            int shown = 0;
+            for (const ScanCore::ValueChange& change : result.values) {
+                if (change.kind != kind) continue;
+                if (shown++ == limit) break;
+                std::wcout << L"  0x" << std::hex << change.address << std::dec << L" (" << ScanCore::ChangeKindName(kind) << L") ";
+                if (kind == ScanCore::ChangeKind::FloatDelta) {
+                    std::wcout << change.BeforeFloat() << L" -> " << change.AfterFloat();
+                } else if (kind == ScanCore::ChangeKind::IntIncrement) {
+                    std::wcout << static_cast<int32_t>(change.before) << L" -> " << static_cast<int32_t>(change.after);
+                } else {
+                    std::wcout << L"0x" << std::hex << change.before << L" -> 0x" << change.after << std::dec;
+                }
+                std::wcout << std::endl;
             }
         }
     }
 
+    void ShowAddresses(const ScanCore::ScanResultStore& results, int limit = 10) {
+        if (results.Empty()) {
+            std::wcout << L"표시할 주소가 없습니다." << std::endl;
+            return;
+        }
+        std::wcout << L"" << results.Count() << L"개 주소 중 최대 " << limit << L"개 표시 (결과 메모리 "
+                   << results.MemoryUsage() / 1024 << L"KB, 비트맵 블록 " << results.BitmapBlockCount()
+                   << L"/" << results.BlockCount() << L"):" << std::endl;
+        for (uintptr_t address : results.ToAddresses(static_cast<size_t>(limit))) {
+            std::wcout << L"  0x" << std::hex << address << std::dec << std::endl;
+        }
+    }
+
+    void ShowAddresses(const ScanCore::TypedResultStore& results, int limit = 10) {
+        if (results.Empty()) {
+            std::wcout << L"표시할 주소가 없습니다." << std::endl;
+            return;
+        }
+        std::wcout << L"" << results.Count() << L"개 주소 중 최대 " << limit << L"개 표시 (결과 메모리 "
+                   << results.MemoryUsage() / 1024 << L"KB):" << std::endl;
+        int shown = 0;
+        for (const ScanCore::TypedResultStore::Entry& entry : results) {
+            if (shown++ == limit) break;
+            std::wcout << L"  0x" << std::hex << entry.address << std::dec << L" (" << ScanCore::ValueTypeName(entry.type) << L")" << std::endl;
+        }
+    }
+
+    void ShowAddresses(const std::vector<ScanCore::StringMatch>& matches, int limit = 10) {
+        if (matches.empty()) {
+            std::wcout << L"표시할 주소가 없습니다." << std::endl;
+            return;
+        }
+        std::wcout << L"" << matches.size() << L"개 주소 중 최대 " << limit << L"개 표시:" << std::endl;
+        for (size_t i = 0; i < std::min((size_t)limit, matches.size()); ++i) {
+            std::wcout << L"  0x" << std::hex << matches[i].address << std::dec << L" (" << ScanCore::StringEncodingName(matches[i].encoding) << L")" << std::endl;
+        }
+    }
+
     void ShowAddresses(const std::vector<uintptr_t>& addresses, int limit = 10) {
         if (addresses.empty()) {
             std::wcout << L"표시할 주소가 없습니다." << std::endl;
@@ -299,16 +680,53 @@ public:
 };
 
 // 메인 애플리케이션 루프
-int main() {
+int main(int argc, char* argv[]) {
     std::wcout << L"=== 범용 메모리 스캐너 ===" << std::endl;
-    std::wcout << L"프로세스에 연결하여 메모리를 스캔합니다." << std::endl;
+    std::wcout << L"프로세스에 연결하여 메모리를 스캔합니다. (덤프 파일을 인자로 주면 덤프를 스캔)" << std::endl;
 
     MemoryScanner scanner;
-    std::vector<uintptr_t> currentAddresses;
+    ScanCore::ScanResultStore currentResults; // 현재 후보 주소 + 이전 값
+    ScanCore::ValueType currentType = ScanCore::ValueType::Int32; // currentResults 값의 타입 (정수 스캔 또는 11번 실수 스캔)
+    ScanCore::TypedResultStore typedResults; // 모든 타입 스캔 중일 때의 후보 (타입별)
+    std::unique_ptr<ScanCore::SnapshotScanner<int>> snapshot; // 알 수 없는 초기값 스캔 중일 때의 후보
+
+    // 스냅샷 후보가 이 수 이하로 줄면 일반 결과 저장소로 넘김 (주소 표시/특정 값 스캔 가능)
+    const size_t SnapshotHandoffCount = 100000;
+
+    auto nextScan = [&](const std::string& changeType) {
+        if (snapshot) {
+            scanner.FilterSnapshot(*snapshot, changeType);
+            if (snapshot->CandidateCount() <= SnapshotHandoffCount) {
+                currentResults = snapshot->ToResultStore();
+                currentType = ScanCore::ValueType::Int32;
+                snapshot.reset();
+                scanner.ShowAddresses(currentResults);
+            }
+            return;
+        }
+        if (!typedResults.Empty()) {
+            typedResults = scanner.FilterTypedByChange(typedResults, changeType);
+            scanner.ShowAddresses(typedResults);
+            return;
+        }
+        // float 비트를 int로 비교하면 음수와 ±0에서 증가/감소가 뒤집힘
+        if (currentType == ScanCore::ValueType::Float) {
+            currentResults = scanner.FilterByChange<float>(currentResults, changeType);
+        } else {
+            currentResults = scanner.FilterByChange<int>(currentResults, changeType);
+        }
+        scanner.ShowAddresses(currentResults);
+    };
+
+    // 오프라인 모드: 인자로 받은 덤프 파일을 순서대로 스캔
+    std::vector<std::string> dumpPaths(argv + 1, argv + argc);
+    if (!dumpPaths.empty()) {
+        if (!scanner.AttachToDumps(dumpPaths)) return 1;
+    }
 
-    // 관리자 권한 확인
+    // 관리자 권한 확인 (프로세스에 연결할 때만)
     HANDLE hToken = nullptr;
-    if (OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &hToken)) {
+    if (dumpPaths.empty() && OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &hToken)) {
         TOKEN_ELEVATION elevation;
         DWORD size;
         if (GetTokenInformation(hToken, TokenElevation, &elevation, sizeof(elevation), &size)) {
@@ -320,11 +738,13 @@ int main() {
     }
 
     // 프로세스 이름 입력
-    std::wcout << L"\n대상 프로세스 이름 (예: notepad.exe): ";
     std::wstring processName;
-    std::wcin >> processName;
+    if (dumpPaths.empty()) {
+        std::wcout << L"\n대상 프로세스 이름 (예: notepad.exe): ";
+        std::wcin >> processName;
+    }
 
-    if (!scanner.AttachToProcess(processName)) {
+    if (dumpPaths.empty() && !scanner.AttachToProcess(processName)) {
         std::wcout << L"프로세스 연결 실패." << std::endl;
         std::wcout << L"계속하려면 아무 키나 누르세요.";
         std::wcin.ignore();
@@ -343,48 +763,67 @@ int main() {
         std::wcout << L"7. 메모리 읽기/쓰기 (정수)" << std::endl;
         std::wcout << L"8. 현재 주소 표시" << std::endl;
         std::wcout << L"9. 종료" << std::endl;
+        std::wcout << L"10. 알 수 없는 초기값 스캔 (정수)" << std::endl;
+        std::wcout << L"11. 실수 값 스캔 (float, 근사값/범위)" << std::endl;
+        std::wcout << L"12. 모든 타입 값 스캔 (int16/32/64, float, double)" << std::endl;
+        std::wcout << L"13. 문자열 스캔 (UTF-8/UTF-16LE, 대소문자 무시 선택)" << std::endl;
+        if (scanner.HasInterruptedScan()) std::wcout << L"14. 중단된 스캔 이어서 하기" << std::endl;
+        std::wcout << L"15. 모든 결과 주소에 값 쓰기 (정수)" << std::endl;
+        if (scanner.HasNextDump()) std::wcout << L"16. 다음 덤프로 전환 (이후 다음 스캔은 두 덤프의 값을 비교)" << std::endl;
+        std::wcout << (scanner.HasDiffBaseline() ? L"17. 행동 후 비교 (바뀐 값 분류)" : L"17. 행동 전/후 비교 - 행동 전 기준 저장") << std::endl;
         std::wcout << L"선택: ";
 
         int choice;
         std::wcin >> choice;
 
+        // 다른 스캔으로 후보가 바뀌면 중단된 스캔의 나머지를 합칠 수 없음 (표시/읽기/쓰기는 그대로 둠)
+        if (choice != 7 && choice != 8 && choice != 14 && choice != 15 && choice != 17) scanner.DiscardInterruptedScan();
+
         switch (choice) {
             case 1: {
                 int value;
                 std::wcout << L"초기 정수 값 입력: ";
                 std::wcin >> value;
-                currentAddresses = scanner.ScanMemory<int>(value);
-                scanner.StoreCurrentResults<int>(currentAddresses);
-                scanner.ShowAddresses(currentAddresses);
+                snapshot.reset();
+                typedResults = ScanCore::TypedResultStore();
+                currentResults = scanner.ScanMemory<int>(value);
+                currentType = ScanCore::ValueType::Int32;
+                scanner.ShowAddresses(currentResults);
                 break;
             }
             case 2: {
-                currentAddresses = scanner.FilterByChange<int>(currentAddresses, "unchanged");
-                scanner.ShowAddresses(currentAddresses);
+                nextScan("unchanged");
                 break;
             }
             case 3: {
-                currentAddresses = scanner.FilterByChange<int>(currentAddresses, "increased");
-                scanner.ShowAddresses(currentAddresses);
+                nextScan("increased");
                 break;
             }
             case 4: {
-                currentAddresses = scanner.FilterByChange<int>(currentAddresses, "decreased");
-                scanner.ShowAddresses(currentAddresses);
+                nextScan("decreased");
                 break;
             }
             case 5: {
-                currentAddresses = scanner.FilterByChange<int>(currentAddresses, "changed");
-                scanner.ShowAddresses(currentAddresses);
+                nextScan("changed");
                 break;
             }
             case 6: {
                 int value;
                 std::wcout << L"스캔할 정수 값 입력: ";
                 std::wcin >> value;
-                currentAddresses = scanner.ScanMemory<int>(value, currentAddresses);
-                scanner.StoreCurrentResults<int>(currentAddresses);
-                scanner.ShowAddresses(currentAddresses);
+                if (!currentResults.Empty() && currentType != ScanCore::ValueType::Int32) {
+                    std::wcout << L"현재 결과는 " << ScanCore::ValueTypeName(currentType) << L" 값이라 정수 스캔과 교집합을 낼 수 없습니다. 1번으로 새로 스캔하세요." << std::endl;
+                    break;
+                }
+                typedResults = ScanCore::TypedResultStore();
+                if (snapshot) {
+                    // 후보가 너무 많으면 저장소로 바꾸지 않고 새로 스캔
+                    currentResults = snapshot->CandidateCount() <= SnapshotHandoffCount * 100 ? snapshot->ToResultStore() : ScanCore::ScanResultStore();
+                    snapshot.reset();
+                }
+                currentResults = scanner.ScanMemory<int>(value, currentResults.Empty() ? nullptr : &currentResults);
+                currentType = ScanCore::ValueType::Int32;
+                scanner.ShowAddresses(currentResults);
                 break;
             }
             case 7: {
@@ -410,12 +849,117 @@ int main() {
                 break;
             }
             case 8: {
-                scanner.ShowAddresses(currentAddresses, 20);
+                if (snapshot) {
+                    scanner.ShowSnapshot(*snapshot);
+                } else if (!typedResults.Empty()) {
+                    scanner.ShowAddresses(typedResults, 20);
+                } else {
+                    scanner.ShowAddresses(currentResults, 20);
+                }
                 break;
             }
             case 9:
                 std::wcout << L"스캐너 종료." << std::endl;
                 return 0;
+            case 10: {
+                currentResults = ScanCore::ScanResultStore();
+                typedResults = ScanCore::TypedResultStore();
+                snapshot = scanner.CaptureSnapshot<int>();
+                std::wcout << L"값을 바꾼 뒤 2~5번 다음 스캔으로 후보를 좁히세요." << std::endl;
+                break;
+            }
+            case 11: {
+                int mode;
+                std::wcout << L"1. 근사값 (값 ± 오차)  2. 범위 (최소 ~ 최대): ";
+                std::wcin >> mode;
+
+                ScanCore::FloatCondition<float> condition;
+                if (mode == 2) {
+                    float low, high;
+                    std::wcout << L"최소값과 최대값 입력: ";
+                    std::wcin >> low >> high;
+                    condition = ScanCore::FloatCondition<float>::Between(low, high);
+                } else {
+                    float value, tolerance;
+                    std::wcout << L"값과 허용 오차 입력 (예: 100 0.5): ";
+                    std::wcin >> value >> tolerance;
+                    condition = ScanCore::FloatCondition<float>::Near(value, tolerance);
+                }
+                typedResults = ScanCore::TypedResultStore();
+
+                // 정수 후보(정수 스캔, 알 수 없는 초기값 스캔)와는 교집합을 내지 않고 새로 스캔
+                snapshot.reset();
+                if (currentType != ScanCore::ValueType::Float) currentResults = ScanCore::ScanResultStore();
+                currentResults = scanner.ScanFloat<float>(condition, currentResults.Empty() ? nullptr : &currentResults);
+                currentType = ScanCore::ValueType::Float;
+                scanner.ShowAddresses(currentResults);
+                std::wcout << L"값을 바꾼 뒤 2~5번 다음 스캔으로 후보를 좁히세요. (float로 비교)" << std::endl;
+                break;
+            }
+            case 12: {
+                std::wstring text;
+                double tolerance;
+                std::wcout << L"값과 실수 허용 오차 입력 (예: 100 0.5, 정확히 같은 값만이면 오차 0): ";
+                std::wcin >> text >> tolerance;
+
+                ScanCore::MultiTypeQuery query;
+                if (!ScanCore::ParseMultiTypeQuery(WStringToString(text), tolerance, query)) {
+                    std::wcout << L"숫자를 입력하세요." << std::endl;
+                    break;
+                }
+                snapshot.reset();
+                currentResults = ScanCore::ScanResultStore();
+                typedResults = scanner.ScanAllTypes(query);
+                scanner.ShowAddresses(typedResults);
+                std::wcout << L"값을 바꾼 뒤 2~5번 다음 스캔으로 후보를 좁히세요. (후보마다 자기 타입으로 비교)" << std::endl;
+                break;
+            }
+            case 13: {
+                std::wstring text;
+                wchar_t answer;
+                std::wcout << L"찾을 문자열 입력: ";
+                std::wcin >> std::ws;
+                std::getline(std::wcin, text);
+                std::wcout << L"대소문자 무시? (y/n): ";
+                std::wcin >> answer;
+
+                // 문자열 결과는 값 후보가 아니므로 현재 후보는 그대로 둠
+                std::vector<ScanCore::StringMatch> matches = scanner.ScanStrings(WStringToString(text), answer == L'y' || answer == L'Y');
+                scanner.ShowAddresses(matches, 20);
+                break;
+            }
+            case 14: {
+                if (!scanner.HasInterruptedScan()) {
+                    std::wcout << L"이어서 할 스캔이 없습니다." << std::endl;
+                    break;
+                }
+                currentResults = scanner.ResumeScan(currentResults);
+                scanner.ShowAddresses(currentResults);
+                break;
+            }
+            case 15: {
+                if (currentResults.Empty() || currentType != ScanCore::ValueType::Int32) {
+                    std::wcout << L"값을 쓸 정수 스캔 결과가 없습니다." << std::endl;
+                    break;
+                }
+                std::wcout << L"" << currentResults.Count() << L"개 주소에 쓸 정수 값 입력: ";
+                int newValue;
+                std::wcin >> newValue;
+                size_t written = scanner.WriteMemory<int>(currentResults.ToAddresses(), newValue);
+                std::wcout << L"" << written << L"/" << currentResults.Count() << L"개 주소에 " << newValue << L" 쓰기 성공." << std::endl;
+                break;
+            }
+            case 16: {
+                if (!scanner.SwitchToNextDump()) {
+                    std::wcout << L"전환할 다음 덤프가 없습니다." << std::endl;
+                }
+                break;
+            }
+            case 17: {
+                // 비교 결과는 후보가 아니므로 현재 후보는 그대로 둠
+                scanner.DiffSnapshot();
+                break;
+            }
             default:
                 std::wcout << L"잘못된 선택입니다. 다시 시도하세요." << std::endl;
                 break;
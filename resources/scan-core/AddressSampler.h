@@ -0,0 +1,373 @@
+#pragma once
+/*
+ * 고속 주소 샘플러 (잠금 없는 링 버퍼 시계열 + O(1) 이동 통계)
+ *
+ * 지켜볼 주소 N개를 주기(최대 10kHz 정도)마다 ReadBatch 한 번으로 읽어 주소별 시계열로 쌓습니다.
+ * - SampleRing: 생산자 하나, 소비자 여럿. 가장 오래된 샘플을 덮어쓰고, 읽는 쪽은 복사하는 동안 덮어쓰인 샘플만 버림
+ *   (잠금 없음, 쓰는 쪽은 기다리지 않음)
+ * - 주소마다 RollingStats(RollingStats.h)로 최근 window개 샘플의 최소/최대/평균/분산을 샘플당 상수 시간에 갱신
+ * - 샘플러 스레드가 틱마다 주소별 통계를 시퀀스 잠금(seqlock)으로 공개 → UI/내보내기/변화 분류는 샘플러를 막지 않고
+ *   GetWindowStats()/Snapshot()으로 읽음 (읽는 쪽만 드물게 다시 시도)
+ * - 샘플 시각은 샘플러를 만든 뒤의 나노초. 한 틱의 샘플은 모두 같은 시각 (한 번에 읽으므로)
+ * - 읽기에 실패한 주소는 그 틱 샘플이 없음. 유한하지 않은 값(NaN, inf)과 (minimumValue, maximumValue) 밖의 값은
+ *   시계열에는 넣고 통계에서는 뺌 (예: FPS는 (0, 1000) → 0, 음수, 옛 주소의 쓰레기 값이 최소/평균을 흐리지 않음)
+ * Watch()/Clear()는 멈춘 상태에서만 (읽는 소비자도 없을 때) 호출합니다.
+ *
+ * 사용 예:
+ *   ScanCore::AddressSampler sampler(*memory, config);        // config.rateHz = 10000
+ *   size_t fps = sampler.Watch(fpsAddress, ScanCore::ValueType::Float);
+ *   sampler.Start();
+ *   ScanCore::WindowStats stats = sampler.GetWindowStats(fps);   // 다른 스레드에서, 막지 않음
+ *   std::vector<ScanCore::Sample> recent;
+ *   sampler.Snapshot(fps, recent, 600);
+ *   sampler.Stop();
+ */
+
+#include "BatchReader.h"
+#include "ProcessMemory.h"
+#include "RollingStats.h"
+#include "TypedResultStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ScanCore {
+
+    struct Sample {
+        uint64_t time = 0;      // 나노초 (샘플러 기준)
+        double value = 0.0;
+    };
+
+    // 최근 window개 샘플의 통계
+    struct WindowStats {
+        uint64_t count = 0;     // 통계에 들어간 샘플 수 (최대 window)
+        double minimum = 0.0;
+        double maximum = 0.0;
+        double mean = 0.0;
+        double variance = 0.0;  // 모분산
+        double last = 0.0;
+        uint64_t time = 0;      // 마지막 샘플 시각
+
+        double StdDev() const { return std::sqrt(variance); }
+    };
+
+    namespace Detail {
+
+        inline uint64_t DoubleBits(double value) {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline double BitsDouble(uint64_t bits) {
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+
+    // 덮어쓰는 고정 크기 링 버퍼 (생산자 하나, 소비자 여럿, 잠금 없음)
+    class SampleRing {
+    public:
+        explicit SampleRing(size_t capacity = 4096) {
+            size_t rounded = 2;
+            while (rounded < capacity) rounded <<= 1;
+            slots.reset(new Slot[rounded]);
+            mask = rounded - 1;
+        }
+
+        size_t Capacity() const { return mask + 1; }
+
+        // 생산자 스레드에서만
+        void Push(uint64_t time, double value) {
+            uint64_t index = head.load(std::memory_order_relaxed);
+            // 덮어쓸 칸을 먼저 알림 → 그 칸을 복사 중이던 소비자는 writing을 보고 버림
+            writing.store(index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            Slot& slot = slots[index & mask];
+            slot.time.store(time, std::memory_order_relaxed);
+            slot.bits.store(Detail::DoubleBits(value), std::memory_order_relaxed);
+            head.store(index + 1, std::memory_order_release);
+        }
+
+        // 지금까지 넣은 샘플 수
+        uint64_t Count() const { return head.load(std::memory_order_acquire); }
+
+        bool Latest(Sample& sample) const {
+            Sample buffer[1];
+            if (Copy(buffer, 1) == 0) return false;
+            sample = buffer[0];
+            return true;
+        }
+
+        // 최근 샘플 최대 maxCount개를 오래된 것부터 out에 (out은 덮어씀). 복사한 수를 반환
+        size_t Snapshot(std::vector<Sample>& out, size_t maxCount = std::numeric_limits<size_t>::max()) const {
+            out.resize(std::min<uint64_t>(std::min<uint64_t>(maxCount, Capacity()), Count()));
+            out.resize(Copy(out.data(), out.size()));
+            return out.size();
+        }
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> time{0};
+            std::atomic<uint64_t> bits{0};
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        size_t mask = 0;
+        std::atomic<uint64_t> head{0};      // 다 쓴 샘플 수
+        std::atomic<uint64_t> writing{0};   // 쓰기 시작한 샘플 수 (head 또는 head + 1)
+
+        size_t Copy(Sample* out, size_t maxCount) const {
+            uint64_t end = head.load(std::memory_order_acquire);
+            uint64_t begin = end - std::min<uint64_t>(std::min<uint64_t>(maxCount, Capacity()), end);
+            for (uint64_t i = begin; i < end; ++i) {
+                const Slot& slot = slots[i & mask];
+                out[i - begin].time = slot.time.load(std::memory_order_relaxed);
+                out[i - begin].value = Detail::BitsDouble(slot.bits.load(std::memory_order_relaxed));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // 복사하는 동안 덮어쓰기 시작한 칸은 앞에서부터 버림
+            uint64_t started = writing.load(std::memory_order_relaxed);
+            uint64_t valid = started > Capacity() ? started - Capacity() : 0;
+            if (valid <= begin) return static_cast<size_t>(end - begin);
+            if (valid >= end) return 0;
+            size_t dropped = static_cast<size_t>(valid - begin);
+            std::memmove(out, out + dropped, static_cast<size_t>(end - valid) * sizeof(Sample));
+            return static_cast<size_t>(end - valid);
+        }
+    };
+
+    struct AddressSamplerConfig {
+        double rateHz = 1000.0;             // Start()의 샘플 주기
+        size_t history = 8192;              // 주소별 링 버퍼 크기 (2의 거듭제곱으로 올림)
+        size_t window = 1000;               // 이동 통계 창 (샘플 수)
+        double spinMicroseconds = 200.0;    // 샘플 시각 직전 바쁜 대기 (0 = 잠들기만)
+        double minimumValue = -std::numeric_limits<double>::infinity();    // 통계에 넣는 값의 범위 (양 끝 제외)
+        double maximumValue = std::numeric_limits<double>::infinity();
+    };
+
+    class AddressSampler {
+    public:
+        struct Stats {
+            uint64_t ticks = 0;
+            uint64_t failedReads = 0;       // 읽지 못한 (주소, 틱) 수
+            uint64_t overruns = 0;          // 주기를 한 번 이상 놓친 틱 수
+            double busySeconds = 0.0;       // Tick() 안에서 보낸 시간
+            double seconds = 0.0;           // Start()부터 (멈췄으면 Stop()까지)
+
+            double Rate() const { return seconds > 0.0 ? ticks / seconds : 0.0; }
+        };
+
+        explicit AddressSampler(IProcessMemory& memory, const AddressSamplerConfig& config = AddressSamplerConfig())
+            : memory(memory), config(config), epoch(std::chrono::steady_clock::now()) {
+            if (this->config.rateHz <= 0.0) this->config.rateHz = 1000.0;
+        }
+
+        ~AddressSampler() { Stop(); }
+
+        AddressSampler(const AddressSampler&) = delete;
+        AddressSampler& operator=(const AddressSampler&) = delete;
+
+        // 주소 추가 (멈춘 상태에서만). 번호를 반환, 돌고 있으면 SIZE_MAX
+        size_t Watch(uintptr_t address, ValueType type) {
+            if (running.load()) return static_cast<size_t>(-1);
+            auto channel = std::make_unique<Channel>(config);
+            channel->address = address;
+            channel->type = type;
+            channel->offset = buffer.size();
+            buffer.resize(buffer.size() + ValueTypeSize(type));
+            channels.push_back(std::move(channel));
+            requests.resize(channels.size());
+            for (size_t i = 0; i < channels.size(); ++i) {
+                requests[i].address = channels[i]->address;
+                requests[i].size = ValueTypeSize(channels[i]->type);
+                requests[i].buffer = buffer.data() + channels[i]->offset;
+            }
+            return channels.size() - 1;
+        }
+
+        void Clear() {
+            if (running.load()) return;
+            channels.clear();
+            requests.clear();
+            buffer.clear();
+        }
+
+        size_t Size() const { return channels.size(); }
+        uintptr_t Address(size_t index) const { return channels[index]->address; }
+        ValueType Type(size_t index) const { return channels[index]->type; }
+
+        // 샘플 한 번: 모든 주소를 ReadBatch 한 번으로 읽어 링 버퍼와 통계에 넣음 (생산자 스레드 하나에서만)
+        void Tick() {
+            uint64_t time = Now();
+            if (!requests.empty()) memory.ReadBatch(requests.data(), requests.size());
+            uint64_t failed = 0;
+            for (size_t i = 0; i < channels.size(); ++i) {
+                Channel& channel = *channels[i];
+                const ReadRequest& request = requests[i];
+                if (!request.ok || request.bytesRead != request.size) {
+                    ++failed;
+                    continue;
+                }
+                double value = DecodeValue(channel.type, request.buffer);
+                channel.ring.Push(time, value);
+                if (std::isfinite(value) && value > config.minimumValue && value < config.maximumValue) channel.rolling.Add(value);
+                channel.Publish(value, time);
+            }
+            ticks.fetch_add(1, std::memory_order_relaxed);
+            if (failed) failedReads.fetch_add(failed, std::memory_order_relaxed);
+            busyNanoseconds.fetch_add(Now() - time, std::memory_order_relaxed);
+        }
+
+        // rateHz 주기로 Tick()을 도는 스레드 시작
+        void Start() {
+            if (running.exchange(true)) return;
+            started.store(Now(), std::memory_order_relaxed);
+            worker = std::thread([this]() { Loop(); });
+        }
+
+        void Stop() {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                if (!running.exchange(false)) return;
+            }
+            wake.notify_all();
+            if (worker.joinable()) worker.join();
+            stopped.store(Now(), std::memory_order_relaxed);
+        }
+
+        bool Running() const { return running.load(); }
+
+        // 이하 소비자용: 어느 스레드에서든, 샘플러를 막지 않음
+        bool Latest(size_t index, Sample& sample) const { return channels[index]->ring.Latest(sample); }
+
+        size_t Snapshot(size_t index, std::vector<Sample>& out, size_t maxCount = std::numeric_limits<size_t>::max()) const {
+            return channels[index]->ring.Snapshot(out, maxCount);
+        }
+
+        uint64_t SampleCount(size_t index) const { return channels[index]->ring.Count(); }
+
+        WindowStats GetWindowStats(size_t index) const { return channels[index]->Read(); }
+
+        Stats GetStats() const {
+            Stats result;
+            result.ticks = ticks.load(std::memory_order_relaxed);
+            result.failedReads = failedReads.load(std::memory_order_relaxed);
+            result.overruns = overruns.load(std::memory_order_relaxed);
+            result.busySeconds = busyNanoseconds.load(std::memory_order_relaxed) / 1e9;
+            uint64_t begin = started.load(std::memory_order_relaxed);
+            if (begin) result.seconds = ((running.load() ? Now() : stopped.load(std::memory_order_relaxed)) - begin) / 1e9;
+            return result;
+        }
+
+    private:
+        // 주소 하나: 링 버퍼, 생산자 쪽 이동 통계, 소비자에게 공개하는 통계 (seqlock)
+        struct Channel {
+            uintptr_t address = 0;
+            ValueType type = ValueType::Float;
+            size_t offset = 0;                  // buffer 안 위치
+            SampleRing ring;
+            RollingStats rolling;
+            std::atomic<uint64_t> sequence{0};  // 홀수 = 쓰는 중
+            std::atomic<uint64_t> fields[7];
+
+            explicit Channel(const AddressSamplerConfig& config) : ring(config.history), rolling(config.window) {
+                for (auto& field : fields) field.store(0, std::memory_order_relaxed);
+            }
+
+            void Publish(double last, uint64_t time) {
+                uint64_t current = sequence.load(std::memory_order_relaxed);
+                sequence.store(current + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                fields[0].store(rolling.Count(), std::memory_order_relaxed);
+                fields[1].store(Detail::DoubleBits(rolling.Minimum()), std::memory_order_relaxed);
+                fields[2].store(Detail::DoubleBits(rolling.Maximum()), std::memory_order_relaxed);
+                fields[3].store(Detail::DoubleBits(rolling.Mean()), std::memory_order_relaxed);
+                fields[4].store(Detail::DoubleBits(rolling.Variance()), std::memory_order_relaxed);
+                fields[5].store(Detail::DoubleBits(last), std::memory_order_relaxed);
+                fields[6].store(time, std::memory_order_relaxed);
+                sequence.store(current + 2, std::memory_order_release);
+            }
+
+            WindowStats Read() const {
+                WindowStats stats;
+                while (true) {
+                    uint64_t before = sequence.load(std::memory_order_acquire);
+                    if (before & 1) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    stats.count = fields[0].load(std::memory_order_relaxed);
+                    stats.minimum = Detail::BitsDouble(fields[1].load(std::memory_order_relaxed));
+                    stats.maximum = Detail::BitsDouble(fields[2].load(std::memory_order_relaxed));
+                    stats.mean = Detail::BitsDouble(fields[3].load(std::memory_order_relaxed));
+                    stats.variance = Detail::BitsDouble(fields[4].load(std::memory_order_relaxed));
+                    stats.last = Detail::BitsDouble(fields[5].load(std::memory_order_relaxed));
+                    stats.time = fields[6].load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before) return stats;
+                }
+            }
+        };
+
+        IProcessMemory& memory;
+        AddressSamplerConfig config;
+        std::chrono::steady_clock::time_point epoch;
+        std::vector<std::unique_ptr<Channel>> channels;
+        std::vector<ReadRequest> requests;
+        std::vector<uint8_t> buffer;
+
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> failedReads{0};
+        std::atomic<uint64_t> overruns{0};
+        std::atomic<uint64_t> busyNanoseconds{0};
+
+        std::atomic<bool> running{false};
+        std::thread worker;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::atomic<uint64_t> started{0};       // Now() 기준
+        std::atomic<uint64_t> stopped{0};
+
+        // 샘플러를 만든 뒤의 나노초 (샘플 시각과 같은 기준)
+        uint64_t Now() const {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+        }
+
+        void Loop() {
+            using Clock = std::chrono::steady_clock;
+            const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.rateHz));
+            const Clock::duration spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(config.spinMicroseconds));
+            Clock::time_point next = Clock::now();
+            while (running.load()) {
+                Clock::time_point now = Clock::now();
+                if (now < next) {
+                    if (next - now > spin) {
+                        std::unique_lock<std::mutex> lock(wakeMutex);
+                        if (wake.wait_until(lock, next - spin, [this]() { return !running.load(); })) break;
+                    }
+                    while (Clock::now() < next) std::this_thread::yield();
+                }
+                Tick();
+                next += period;
+                // 한 주기 이상 밀렸으면 밀린 틱을 몰아서 돌지 않고 지금부터 다시 셈
+                Clock::time_point after = Clock::now();
+                if (after - next >= period) {
+                    overruns.fetch_add(1, std::memory_order_relaxed);
+                    next = after;
+                }
+            }
+        }
+    };
+}
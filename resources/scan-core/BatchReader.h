@@ -0,0 +1,298 @@
+#pragma once
+/*
+ * 후보 주소 일괄 읽기 (다음 스캔용)
+ *
+ * 다음 스캔에서 후보마다 ReadProcessMemory/ReadMemory를 부르면 후보 수만큼 시스템 호출이 발생합니다.
+ * 여기서는 정렬된 후보 주소를 페이지 구간(run)으로 묶고, 구간 여러 개를 한 번의 일괄 읽기로 가져온 뒤
+ * 후보마다 버퍼 안의 현재 값을 넘겨 줍니다.
+ *
+ * - 구간: 후보가 걸친 4KB 페이지들을 이어 붙임 (떨어진 페이지는 maxGapPages까지 함께 읽음, 최대 maxRunSize)
+ * - 일괄 읽기: 구간 목록을 BatchReadFunction 한 번으로 처리
+ *   Windows는 구간마다 ReadProcessMemory, Linux는 process_vm_readv의 iovec 배열(최대 IOV_MAX개)로 읽음
+ * - 구간 읽기가 실패하면(중간에 해제된 페이지 등) 페이지 단위로 다시 읽어 나머지 후보는 살림
+ * - SetSkippedPages로 지정한 페이지(변경 추적 결과 깨끗한 페이지 등)에만 걸친 후보는 읽지 않음
+ *
+ * 사용 예:
+ *   ScanCore::BatchReader reader(ScanCore::MakeBatchRead(readFn));
+ *   reader.ForEach(store.begin(), store.end(), sizeof(int),
+ *       [](const ScanCore::ScanResultStore::Entry& entry) { return entry.address; },
+ *       [&](const ScanCore::ScanResultStore::Entry& entry, const uint8_t* current) { ... });
+ */
+
+#include "ScanExecutor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <climits>
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+
+namespace ScanCore {
+
+    // 일괄 읽기 요청 하나 (결과는 bytesRead/ok에 기록)
+    struct ReadRequest {
+        uintptr_t address = 0;
+        uint8_t* buffer = nullptr;
+        size_t size = 0;
+        size_t bytesRead = 0;
+        bool ok = false;
+    };
+
+    // requests[0..count)를 모두 읽음. 각 요청의 성공 여부는 요청마다 기록
+    using BatchReadFunction = std::function<void(ReadRequest* requests, size_t count)>;
+
+    // 단일 읽기 함수(ReadProcessMemory 등)로 요청을 하나씩 처리
+    inline BatchReadFunction MakeBatchRead(ScanExecutor::ReadFunction read) {
+        return [read](ReadRequest* requests, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                ReadRequest& request = requests[i];
+                request.bytesRead = 0;
+                request.ok = read(request.address, request.buffer, request.size, request.bytesRead) &&
+                             request.bytesRead == request.size;
+            }
+        };
+    }
+
+#if defined(__linux__)
+    // process_vm_readv 한 번에 여러 구간을 읽음. 실패한 iovec에서 멈추므로 그 다음부터 이어서 호출
+    inline BatchReadFunction MakeProcessVmBatchRead(pid_t pid) {
+        return [pid](ReadRequest* requests, size_t count) {
+#ifdef IOV_MAX
+            const size_t maxIov = IOV_MAX;
+#else
+            const size_t maxIov = 1024;
+#endif
+            std::vector<struct iovec> local;
+            std::vector<struct iovec> remote;
+            size_t next = 0;
+            while (next < count) {
+                size_t batch = std::min(maxIov, count - next);
+                local.resize(batch);
+                remote.resize(batch);
+                for (size_t i = 0; i < batch; ++i) {
+                    ReadRequest& request = requests[next + i];
+                    request.bytesRead = 0;
+                    request.ok = false;
+                    local[i].iov_base = request.buffer;
+                    local[i].iov_len = request.size;
+                    remote[i].iov_base = reinterpret_cast<void*>(request.address);
+                    remote[i].iov_len = request.size;
+                }
+
+                ssize_t result = process_vm_readv(pid, local.data(), batch, remote.data(), batch, 0);
+                size_t transferred = result > 0 ? static_cast<size_t>(result) : 0;
+
+                // 앞에서부터 다 읽힌 요청을 성공 처리하고, 처음으로 덜 읽힌 요청은 실패로 남김
+                size_t i = 0;
+                for (; i < batch && transferred >= requests[next + i].size; ++i) {
+                    requests[next + i].bytesRead = requests[next + i].size;
+                    requests[next + i].ok = true;
+                    transferred -= requests[next + i].size;
+                }
+                if (i < batch) {
+                    requests[next + i].bytesRead = transferred;
+                    ++i;
+                }
+                next += i;
+            }
+        };
+    }
+#endif
+
+    struct BatchReaderConfig {
+        size_t maxGapPages = 0;                 // 이 페이지 수 이하로 떨어진 구간은 합쳐서 읽음
+        size_t maxRunSize = 1024 * 1024;        // 구간 하나의 최대 크기
+        size_t batchBytes = 8 * 1024 * 1024;    // 일괄 읽기 한 번의 버퍼 크기
+        size_t maxRunsPerBatch = 1024;          // 일괄 읽기 한 번의 최대 구간 수
+    };
+
+    class BatchReader {
+    public:
+        static constexpr size_t PageSize = 4096;
+
+        struct Stats {
+            size_t candidates = 0;
+            size_t runs = 0;
+            size_t batches = 0;
+            size_t bytesRead = 0;
+            size_t failedRuns = 0;
+            size_t unreadable = 0;      // 읽지 못해 건너뛴 후보 수
+            size_t skipped = 0;         // 건너뛸 페이지에 있어 읽지 않은 후보 수
+        };
+
+        explicit BatchReader(BatchReadFunction read, const BatchReaderConfig& config = BatchReaderConfig())
+            : read(std::move(read)), config(config) {}
+
+        const Stats& GetLastStats() const { return lastStats; }
+
+        // 읽지 않을 페이지 (페이지 주소 오름차순). 값이 모두 이 페이지들에 있는 후보는 visit(후보, nullptr)로 넘김
+        void SetSkippedPages(std::vector<uintptr_t> sortedPages) { skippedPages = std::move(sortedPages); }
+
+        /**
+         * [begin, end)의 후보(주소 오름차순)마다 visit(후보, 현재 값 포인터)를 호출합니다.
+         * addressOf(후보)는 후보의 주소를 반환합니다. 읽지 못한 후보는 visit 없이 건너뜁니다.
+         * 반복자는 구간을 만들 때와 방문할 때 두 번 지나가므로 전진 반복자여야 합니다.
+         * SetSkippedPages를 썼다면 visit의 현재 값 포인터가 nullptr일 수 있습니다.
+         */
+        template<typename Iterator, typename AddressOf, typename Visit>
+        void ForEach(Iterator begin, Iterator end, size_t valueSize, AddressOf addressOf, Visit visit) {
+            if (valueSize == 0) {
+                lastStats = Stats();
+                return;
+            }
+            ForEachSized(begin, end, [valueSize](const auto&) { return valueSize; }, addressOf, visit);
+        }
+
+        // 후보마다 값 크기가 다를 때 (타입이 섞인 결과 등). sizeOf(후보)는 1 이상이어야 함
+        template<typename Iterator, typename SizeOf, typename AddressOf, typename Visit>
+        void ForEachSized(Iterator begin, Iterator end, SizeOf sizeOf, AddressOf addressOf, Visit visit) {
+            lastStats = Stats();
+
+            std::vector<ReadRequest> requests;
+            std::vector<size_t> offsets;    // 요청별 버퍼 내 위치
+
+            Iterator batchBegin = begin;
+            while (batchBegin != end) {
+                // 1) 배치 버퍼가 찰 때까지 후보를 페이지 구간으로 묶음
+                requests.clear();
+                offsets.clear();
+                size_t batchSize = 0;
+                Iterator batchEnd = batchBegin;
+                while (batchEnd != end) {
+                    uintptr_t address = addressOf(*batchEnd);
+                    size_t valueSize = sizeOf(*batchEnd);
+                    if (!skippedPages.empty() && IsSkipped(address, valueSize)) {
+                        ++batchEnd;
+                        continue;
+                    }
+                    uintptr_t firstPage = address & ~static_cast<uintptr_t>(PageSize - 1);
+                    uintptr_t lastPageEnd = ((address + valueSize - 1) & ~static_cast<uintptr_t>(PageSize - 1)) + PageSize;
+
+                    if (!requests.empty()) {
+                        ReadRequest& run = requests.back();
+                        uintptr_t runEnd = run.address + run.size;
+                        if (firstPage <= runEnd + config.maxGapPages * PageSize && run.size < config.maxRunSize) {
+                            if (lastPageEnd > runEnd) {
+                                run.size += lastPageEnd - runEnd;
+                                batchSize += lastPageEnd - runEnd;
+                            }
+                            ++batchEnd;
+                            continue;
+                        }
+                        if (batchSize >= config.batchBytes || requests.size() >= config.maxRunsPerBatch) break;
+                    }
+
+                    ReadRequest run;
+                    run.address = firstPage;
+                    run.size = lastPageEnd - firstPage;
+                    requests.push_back(run);
+                    offsets.push_back(batchSize);
+                    batchSize += run.size;
+                    ++batchEnd;
+                }
+
+                // 2) 한 번에 읽기
+                buffer.resize(std::max(buffer.size(), batchSize));
+                for (size_t i = 0; i < requests.size(); ++i) {
+                    requests[i].buffer = buffer.data() + offsets[i];
+                }
+                if (!requests.empty()) {
+                    read(requests.data(), requests.size());
+                    ++lastStats.batches;
+                }
+                lastStats.runs += requests.size();
+
+                // 실패한 구간은 페이지 단위로 다시 읽고, 그래도 안 되는 페이지는 기록
+                failedPages.clear();
+                for (ReadRequest& run : requests) {
+                    if (run.ok) {
+                        lastStats.bytesRead += run.size;
+                    } else {
+                        ++lastStats.failedRuns;
+                        RetryByPage(run);
+                    }
+                }
+
+                // 3) 후보 방문
+                size_t runIndex = 0;
+                for (Iterator it = batchBegin; it != batchEnd; ++it) {
+                    uintptr_t address = addressOf(*it);
+                    size_t valueSize = sizeOf(*it);
+                    ++lastStats.candidates;
+                    if (!skippedPages.empty() && IsSkipped(address, valueSize)) {
+                        ++lastStats.skipped;
+                        visit(*it, nullptr);
+                        continue;
+                    }
+                    while (runIndex + 1 < requests.size() && address >= requests[runIndex + 1].address) ++runIndex;
+                    const ReadRequest& run = requests[runIndex];
+                    if (!run.ok && !IsReadable(address, valueSize)) {
+                        ++lastStats.unreadable;
+                        continue;
+                    }
+                    visit(*it, run.buffer + (address - run.address));
+                }
+
+                batchBegin = batchEnd;
+            }
+        }
+
+        // 정렬된 주소 목록용 간편 함수
+        template<typename Visit>
+        void ForEachAddress(const std::vector<uintptr_t>& sortedAddresses, size_t valueSize, Visit visit) {
+            ForEach(sortedAddresses.begin(), sortedAddresses.end(), valueSize,
+                    [](uintptr_t address) { return address; },
+                    [&visit](uintptr_t address, const uint8_t* current) { visit(address, current); });
+        }
+
+    private:
+        BatchReadFunction read;
+        BatchReaderConfig config;
+        Stats lastStats;
+        std::vector<uint8_t> buffer;
+        std::vector<uintptr_t> failedPages;     // 현재 배치에서 다시 읽어도 실패한 페이지 (오름차순)
+        std::vector<uintptr_t> skippedPages;    // SetSkippedPages (오름차순)
+
+        void RetryByPage(ReadRequest& run) {
+            std::vector<ReadRequest> pages(run.size / PageSize);
+            for (size_t i = 0; i < pages.size(); ++i) {
+                pages[i].address = run.address + i * PageSize;
+                pages[i].buffer = run.buffer + i * PageSize;
+                pages[i].size = PageSize;
+            }
+            read(pages.data(), pages.size());
+            for (const ReadRequest& page : pages) {
+                if (page.ok) {
+                    lastStats.bytesRead += PageSize;
+                } else {
+                    failedPages.push_back(page.address);
+                }
+            }
+        }
+
+        bool IsSkipped(uintptr_t address, size_t valueSize) const {
+            uintptr_t first = address & ~static_cast<uintptr_t>(PageSize - 1);
+            uintptr_t last = (address + valueSize - 1) & ~static_cast<uintptr_t>(PageSize - 1);
+            for (uintptr_t page = first; page <= last; page += PageSize) {
+                if (!std::binary_search(skippedPages.begin(), skippedPages.end(), page)) return false;
+            }
+            return true;
+        }
+
+        bool IsReadable(uintptr_t address, size_t valueSize) const {
+            uintptr_t first = address & ~static_cast<uintptr_t>(PageSize - 1);
+            uintptr_t last = (address + valueSize - 1) & ~static_cast<uintptr_t>(PageSize - 1);
+            for (uintptr_t page = first; page <= last; page += PageSize) {
+                if (std::binary_search(failedPages.begin(), failedPages.end(), page)) return false;
+            }
+            return true;
+        }
+    };
+}
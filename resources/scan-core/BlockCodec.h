@@ -0,0 +1,156 @@
+#pragma once
+/*
+ * 빠른 블록 압축 (LZ77 계열, 외부 라이브러리 없음)
+ *
+ * 덤프처럼 블록 하나(수십 KB)를 따로 풀어야 하는 데이터를 위한 단순한 바이트 지향 압축입니다.
+ * 압축률보다 속도가 우선이며, 각 블록은 독립적이라 어느 블록이든 앞 블록 없이 풀 수 있습니다.
+ * - 4바이트 해시 표(4096칸)로 최근 위치를 찾아 64KB 안의 4바이트 이상 일치를 (거리, 길이)로 저장
+ * - 시퀀스: 토큰(상위 4비트 리터럴 길이, 하위 4비트 일치 길이 - 4, 15면 255 단위 확장 바이트),
+ *           리터럴, u16 거리, 일치 길이 확장. 마지막 시퀀스는 리터럴만
+ * - 압축 결과가 capacity를 넘으면 0을 반환 → 호출하는 쪽이 원본을 그대로 저장
+ * - 풀기는 모든 길이와 거리를 검사하므로 손상된 입력에도 버퍼 밖을 건드리지 않음
+ *
+ * 사용 예:
+ *   std::vector<uint8_t> packed(raw.size());
+ *   size_t packedSize = ScanCore::BlockCompress(raw.data(), raw.size(), packed.data(), raw.size() - 1);
+ *   if (packedSize == 0) { ... 원본 저장 ... }
+ *   ScanCore::BlockDecompress(packed.data(), packedSize, out.data(), raw.size());
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace ScanCore {
+
+    namespace Detail {
+        constexpr size_t CodecHashBits = 12;
+        constexpr size_t CodecMinMatch = 4;
+        constexpr size_t CodecMaxDistance = 65535;
+
+        inline uint32_t Load32(const uint8_t* p) {
+            uint32_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline uint32_t CodecHash(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - CodecHashBits);
+        }
+
+        // 길이 확장 바이트 (15 이상일 때 나머지를 255 단위로)
+        inline bool PutLength(uint8_t*& out, const uint8_t* outEnd, size_t length) {
+            while (length >= 255) {
+                if (out == outEnd) return false;
+                *out++ = 255;
+                length -= 255;
+            }
+            if (out == outEnd) return false;
+            *out++ = static_cast<uint8_t>(length);
+            return true;
+        }
+
+        inline bool GetLength(const uint8_t*& in, const uint8_t* inEnd, size_t& length) {
+            uint8_t byte;
+            do {
+                if (in == inEnd) return false;
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        // 리터럴 [literals, literals + literalLength)와 일치(matchLength == 0이면 마지막 시퀀스) 하나를 씀
+        inline bool PutSequence(uint8_t*& out, const uint8_t* outEnd, const uint8_t* literals, size_t literalLength,
+                                size_t distance, size_t matchLength) {
+            if (out == outEnd) return false;
+            uint8_t* token = out++;
+            size_t matchCode = matchLength ? matchLength - CodecMinMatch : 0;
+            *token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+            if (literalLength >= 15 && !PutLength(out, outEnd, literalLength - 15)) return false;
+            if (static_cast<size_t>(outEnd - out) < literalLength) return false;
+            memcpy(out, literals, literalLength);
+            out += literalLength;
+            if (matchLength == 0) return true;
+
+            if (outEnd - out < 2) return false;
+            *out++ = static_cast<uint8_t>(distance);
+            *out++ = static_cast<uint8_t>(distance >> 8);
+            return matchCode < 15 || PutLength(out, outEnd, matchCode - 15);
+        }
+    }
+
+    /**
+     * source[0..size)를 압축해 dest에 씁니다. 압축한 크기, 결과가 capacity를 넘으면 0.
+     * (capacity를 size - 1로 주면 "줄어들 때만 압축"이 됨)
+     */
+    inline size_t BlockCompress(const uint8_t* source, size_t size, uint8_t* dest, size_t capacity) {
+        uint8_t* out = dest;
+        const uint8_t* outEnd = dest + capacity;
+        uint32_t table[size_t(1) << Detail::CodecHashBits] = {};     // 위치 + 1 (0 = 비어 있음)
+
+        size_t position = 0;
+        size_t anchor = 0;
+        while (position + Detail::CodecMinMatch <= size) {
+            uint32_t sequence = Detail::Load32(source + position);
+            uint32_t& slot = table[Detail::CodecHash(sequence)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > Detail::CodecMaxDistance ||
+                Detail::Load32(source + candidate - 1) != sequence) {
+                // 일치가 없는 구간이 길어지면 건너뛰는 폭을 늘림 (압축되지 않는 데이터에서 빨리 포기)
+                position += 1 + ((position - anchor) >> 6);
+                continue;
+            }
+
+            size_t match = candidate - 1;
+            size_t length = Detail::CodecMinMatch;
+            while (position + length < size && source[match + length] == source[position + length]) ++length;
+
+            if (!Detail::PutSequence(out, outEnd, source + anchor, position - anchor, position - match, length)) return 0;
+            position += length;
+            anchor = position;
+        }
+
+        if (!Detail::PutSequence(out, outEnd, source + anchor, size - anchor, 0, 0)) return 0;
+        return static_cast<size_t>(out - dest);
+    }
+
+    // BlockCompress() 결과를 풉니다. 정확히 size 바이트로 풀렸을 때만 true
+    inline bool BlockDecompress(const uint8_t* source, size_t sourceSize, uint8_t* dest, size_t size) {
+        const uint8_t* in = source;
+        const uint8_t* inEnd = source + sourceSize;
+        size_t written = 0;
+
+        while (in < inEnd) {
+            uint8_t token = *in++;
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !Detail::GetLength(in, inEnd, literalLength)) return false;
+            if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > size - written) return false;
+            memcpy(dest + written, in, literalLength);
+            in += literalLength;
+            written += literalLength;
+            if (in == inEnd) break;     // 마지막 시퀀스
+
+            if (inEnd - in < 2) return false;
+            size_t distance = in[0] | (static_cast<size_t>(in[1]) << 8);
+            in += 2;
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !Detail::GetLength(in, inEnd, matchLength)) return false;
+            matchLength += Detail::CodecMinMatch;
+            if (distance == 0 || distance > written || matchLength > size - written) return false;
+
+            uint8_t* target = dest + written;
+            const uint8_t* match = target - distance;
+            if (distance >= matchLength) {
+                memcpy(target, match, matchLength);
+            } else {
+                // 겹치는 복사 (반복 패턴)
+                for (size_t i = 0; i < matchLength; ++i) target[i] = match[i];
+            }
+            written += matchLength;
+        }
+        return written == size;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+/*
+ * 다음 스캔 변경 필터 (변경됨 / 변경 없음 / 증가 / 감소)
+ *
+ * SnapshotScanner(알 수 없는 초기값)와 결과 저장소 다음 스캔(FilterResultStore)이 함께 사용합니다.
+ */
+
+#include <string>
+
+namespace ScanCore {
+
+    enum class ChangeFilter {
+        Changed,
+        Unchanged,
+        Increased,
+        Decreased
+    };
+
+    // MemoryScanner 메뉴에서 쓰는 문자열("changed" 등)을 필터로 변환
+    inline bool ParseChangeFilter(const std::string& name, ChangeFilter& filter) {
+        if (name == "changed") { filter = ChangeFilter::Changed; return true; }
+        if (name == "unchanged") { filter = ChangeFilter::Unchanged; return true; }
+        if (name == "increased") { filter = ChangeFilter::Increased; return true; }
+        if (name == "decreased") { filter = ChangeFilter::Decreased; return true; }
+        return false;
+    }
+
+    template<typename T>
+    inline bool PassesChangeFilter(ChangeFilter filter, const T& current, const T& previous) {
+        switch (filter) {
+            case ChangeFilter::Changed: return current != previous;
+            case ChangeFilter::Unchanged: return current == previous;
+            case ChangeFilter::Increased: return current > previous;
+            case ChangeFilter::Decreased: return current < previous;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,479 @@
+#pragma once
+/*
+ * 치트 테이블 고정(freeze) 엔진
+ *
+ * 항목(고정 주소 또는 포인터 경로, 타입, 고정 값 또는 허용 범위)을 들고 일정한 주기로 모두 다시 씁니다.
+ * - 포인터 경로는 한 번 따라가 최종 주소와 경로 위 포인터 값을 기억해 둠. 틱마다 경로 전체를 다시 따라가지 않고
+ *   기억한 포인터 칸들을 ReadBatch 한 번으로 다시 읽어 값이 같은지만 확인(검증)하고, 다르면 그 항목만 다시 따라감
+ * - 범위 고정(Clamp) 항목의 현재 값도 같은 ReadBatch에서 읽음 → 틱마다 읽기 1번
+ * - 모든 쓰기는 WriteTransaction 하나로 합쳐 씀 (보호 변경은 실패한 페이지 구간만, RegionMap 사용) → 틱마다 쓰기 1번
+ * - 쓰기가 실패한 경로 항목은 다시 따라감. 따라가지 못한 항목은 resolveRetryTicks 틱마다 다시 시도
+ * - Start()는 rateHz 주기로 도는 스레드를 띄움. 다음 틱 시각까지 잠들고 마지막 spinMicroseconds만 바쁜 대기
+ *   (Windows는 timeBeginPeriod(1) 없이는 잠드는 단위가 15.6ms)
+ * - 틱마다 작업 시간(지연)과 예정 시각 대비 깨어난 시각 차이(지터)를 재고, 평균/최대/p99(최근 1024틱)를 보고
+ * 항목 추가/변경은 다른 스레드(UI)에서 해도 됩니다 (틱과 같은 잠금 사용).
+ *
+ * 사용 예:
+ *   ScanCore::CheatTable table(*memory, config);
+ *   size_t health = table.Add(ScanCore::CheatEntry::Freeze("health", address, ScanCore::ValueType::Int32, 9999));
+ *   table.Add(ScanCore::CheatEntry::Clamp("ammo", ammoPath, ScanCore::ValueType::Int32, 10, 999));
+ *   table.Start();
+ *   ... table.SetEnabled(health, false); table.GetStats().latency.p99 ...
+ *   table.Stop();
+ */
+
+#include "BatchReader.h"
+#include "PointerScanner.h"
+#include "ProcessMemory.h"
+#include "RegionMap.h"
+#include "TypedResultStore.h"
+#include "WriteTransaction.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ScanCore {
+
+    enum class CheatMode : uint8_t {
+        Freeze,     // 항상 value로
+        Clamp       // [minimum, maximum] 밖으로 나가면 가까운 끝으로
+    };
+
+    struct CheatEntry {
+        std::string name;
+        uintptr_t address = 0;          // usePath가 false일 때의 고정 주소
+        PointerPath path;               // usePath가 true일 때 (path.module의 현재 기준 주소부터)
+        bool usePath = false;
+        ValueType type = ValueType::Int32;
+        CheatMode mode = CheatMode::Freeze;
+        double value = 0.0;
+        double minimum = 0.0;
+        double maximum = 0.0;
+        bool enabled = true;
+
+        static CheatEntry Freeze(const std::string& name, uintptr_t address, ValueType type, double value) {
+            CheatEntry entry;
+            entry.name = name;
+            entry.address = address;
+            entry.type = type;
+            entry.value = value;
+            return entry;
+        }
+
+        static CheatEntry Freeze(const std::string& name, const PointerPath& path, ValueType type, double value) {
+            CheatEntry entry = Freeze(name, 0, type, value);
+            entry.path = path;
+            entry.usePath = true;
+            return entry;
+        }
+
+        static CheatEntry Clamp(const std::string& name, uintptr_t address, ValueType type, double minimum, double maximum) {
+            CheatEntry entry = Freeze(name, address, type, minimum);
+            entry.mode = CheatMode::Clamp;
+            entry.minimum = minimum;
+            entry.maximum = maximum;
+            return entry;
+        }
+
+        static CheatEntry Clamp(const std::string& name, const PointerPath& path, ValueType type, double minimum, double maximum) {
+            CheatEntry entry = Clamp(name, 0, type, minimum, maximum);
+            entry.path = path;
+            entry.usePath = true;
+            return entry;
+        }
+    };
+
+    struct CheatTableConfig {
+        double rateHz = 100.0;              // Start()의 틱 주기
+        size_t validateEvery = 1;           // 경로 검증 간격 (틱, 0 = 검증하지 않음: 쓰기 실패 때만 다시 따라감)
+        size_t resolveRetryTicks = 10;      // 따라가지 못한 경로를 다시 시도할 간격 (틱)
+        double spinMicroseconds = 200.0;    // 틱 시각 직전 바쁜 대기 (0 = 잠들기만)
+        ProtectMode protect = ProtectMode::OnFailure;
+        size_t pointerSize = sizeof(uintptr_t);
+    };
+
+    class CheatTable {
+    public:
+        // 마이크로초 단위 분포 (p99는 최근 SampleCount틱)
+        struct Timing {
+            double last = 0.0;
+            double mean = 0.0;
+            double max = 0.0;
+            double p99 = 0.0;
+        };
+
+        struct Stats {
+            uint64_t ticks = 0;
+            uint64_t overruns = 0;          // 틱 작업이 주기보다 길어 다음 틱 시각을 놓친 수
+            uint64_t writes = 0;            // 쓴 값 수
+            uint64_t failedWrites = 0;
+            uint64_t resolves = 0;          // 경로를 처음부터 따라간 수
+            uint64_t invalidations = 0;     // 검증에서 포인터 값이 바뀐 것을 발견한 수
+            uint64_t clamped = 0;           // 범위를 벗어나 고친 수
+            uint64_t readCalls = 0;         // 백엔드 읽기 호출 (ReadBatch, 경로 따라가기)
+            uint64_t writeCalls = 0;        // 백엔드 쓰기 호출 (WriteBatch, 보호 변경 후 다시 쓰기 포함)
+            Timing latency;                 // 틱 작업 시간
+            Timing jitter;                  // 예정 시각 대비 늦게 깨어난 시간 (Start()로 돌 때만)
+        };
+
+        static constexpr size_t SampleCount = 1024;
+
+        explicit CheatTable(IProcessMemory& memory, const CheatTableConfig& config = CheatTableConfig())
+            : memory(memory), config(config), regions(memory) {
+            if (this->config.rateHz <= 0.0) this->config.rateHz = 100.0;
+            if (this->config.pointerSize != 4) this->config.pointerSize = 8;
+        }
+
+        ~CheatTable() { Stop(); }
+
+        CheatTable(const CheatTable&) = delete;
+        CheatTable& operator=(const CheatTable&) = delete;
+
+        // 항목 번호를 반환
+        size_t Add(const CheatEntry& entry) {
+            std::lock_guard<std::mutex> lock(mutex);
+            Slot slot;
+            slot.entry = entry;
+            Encode(slot);
+            slots.push_back(std::move(slot));
+            return slots.size() - 1;
+        }
+
+        size_t Size() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return slots.size();
+        }
+
+        void SetEnabled(size_t index, bool enabled) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (index < slots.size()) slots[index].entry.enabled = enabled;
+        }
+
+        bool IsEnabled(size_t index) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return index < slots.size() && slots[index].entry.enabled;
+        }
+
+        // Freeze 값 변경
+        void SetValue(size_t index, double value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (index >= slots.size()) return;
+            slots[index].entry.value = value;
+            Encode(slots[index]);
+        }
+
+        // 항목의 현재 주소 (경로 항목은 마지막으로 따라간 주소). 아직 모르면 false
+        bool ResolvedAddress(size_t index, uintptr_t& address) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (index >= slots.size() || !slots[index].resolved) return false;
+            address = slots[index].address;
+            return true;
+        }
+
+        // 틱 한 번: 검증 + 범위 항목 읽기(ReadBatch 1번) → 필요한 항목만 다시 따라가기 → 쓰기(WriteTransaction 1번)
+        void Tick() {
+            auto start = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> lock(mutex);
+            ++tickNumber;
+            TickCounters counters;
+
+            // 1. 모르는 경로 다시 시도 (resolveRetryTicks마다)
+            for (Slot& slot : slots) {
+                if (slot.entry.enabled && !slot.resolved && tickNumber >= slot.nextRetry) Resolve(slot, counters);
+            }
+
+            // 2. 기억한 포인터 칸 + 범위 항목 현재 값을 한 번에 읽음
+            bool validate = config.validateEvery > 0 && tickNumber % config.validateEvery == 0;
+            requests.clear();
+            readBuffer.clear();
+            for (Slot& slot : slots) {
+                if (!slot.entry.enabled || !slot.resolved) continue;
+                slot.firstRequest = requests.size();
+                if (validate) {
+                    for (size_t level = 0; level < slot.links.size(); ++level) AddRead(slot.links[level], config.pointerSize);
+                }
+                if (slot.entry.mode == CheatMode::Clamp) AddRead(slot.address, ValueTypeSize(slot.entry.type));
+            }
+            if (!requests.empty()) {
+                for (size_t i = 0, offset = 0; i < requests.size(); offset += requests[i].size, ++i) requests[i].buffer = readBuffer.data() + offset;
+                memory.ReadBatch(requests.data(), requests.size());
+                ++counters.readCalls;
+            }
+
+            // 3. 쓰기 모으기
+            transaction.Clear();
+            writeSlots.clear();
+            uint8_t clampedValue[8];
+            for (size_t s = 0; s < slots.size(); ++s) {
+                Slot& slot = slots[s];
+                if (!slot.entry.enabled || !slot.resolved) continue;
+                size_t request = slot.firstRequest;
+                bool fresh = false;
+                if (validate && !slot.links.empty()) {
+                    bool same = true;
+                    for (size_t level = 0; level < slot.links.size(); ++level, ++request) {
+                        same &= requests[request].ok && LoadPointer(requests[request].buffer) == slot.pointers[level];
+                    }
+                    if (!same) {
+                        ++counters.invalidations;
+                        if (!Resolve(slot, counters)) continue;
+                        fresh = true;
+                    }
+                }
+                size_t size = ValueTypeSize(slot.entry.type);
+                if (slot.entry.mode == CheatMode::Freeze) {
+                    transaction.Add(slot.address, slot.encoded, size);
+                    writeSlots.push_back(s);
+                    continue;
+                }
+                // 다시 따라간 항목은 읽은 값이 옛 주소의 값이므로 이번 틱은 건너뜀
+                if (fresh || !requests[request].ok) continue;
+                double current = DecodeValue(slot.entry.type, requests[request].buffer);
+                if (current >= slot.entry.minimum && current <= slot.entry.maximum) continue;
+                EncodeValue(slot.entry.type, current < slot.entry.minimum ? slot.entry.minimum : slot.entry.maximum, clampedValue);
+                transaction.Add(slot.address, clampedValue, size);
+                writeSlots.push_back(s);
+                ++counters.clamped;
+            }
+
+            // 4. 한 번에 쓰기. 실패한 경로 항목은 다음 틱에 다시 따라감
+            if (transaction.Size() > 0) {
+                WriteTransaction::Result result = transaction.Commit(&regions);
+                counters.writeCalls += result.writeCalls;
+                counters.writes += result.writes - result.failed;
+                counters.failedWrites += result.failed;
+                for (size_t i = 0; i < writeSlots.size(); ++i) {
+                    Slot& slot = slots[writeSlots[i]];
+                    if (transaction.Failed(i) && slot.entry.usePath) slot.resolved = false;
+                }
+            }
+
+            double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            RecordTick(counters, microseconds);
+        }
+
+        // rateHz 주기로 Tick()을 도는 스레드 시작
+        void Start() {
+            if (running.exchange(true)) return;
+            worker = std::thread([this]() { Loop(); });
+        }
+
+        void Stop() {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                if (!running.exchange(false)) return;
+            }
+            wake.notify_all();
+            if (worker.joinable()) worker.join();
+        }
+
+        bool Running() const { return running.load(); }
+
+        Stats GetStats() const {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            Stats result = stats;
+            result.latency.p99 = Percentile99(latencySamples);
+            result.jitter.p99 = Percentile99(jitterSamples);
+            return result;
+        }
+
+        void ResetStats() {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats = Stats();
+            latencySamples.clear();
+            jitterSamples.clear();
+            latencySum = 0.0;
+            jitterSum = 0.0;
+            jitterCount = 0;
+        }
+
+    private:
+        struct Slot {
+            CheatEntry entry;
+            uint8_t encoded[8] = {};            // Freeze 값 (타입 크기만큼)
+            bool resolved = false;
+            uintptr_t address = 0;
+            std::vector<uintptr_t> links;       // 경로에서 읽은 포인터 칸 주소
+            std::vector<uint64_t> pointers;     // 그 칸에서 읽은 값
+            uint64_t nextRetry = 0;
+            size_t firstRequest = 0;            // 이번 틱 requests 안의 위치
+        };
+
+        struct TickCounters {
+            uint64_t writes = 0;
+            uint64_t failedWrites = 0;
+            uint64_t resolves = 0;
+            uint64_t invalidations = 0;
+            uint64_t clamped = 0;
+            uint64_t readCalls = 0;
+            uint64_t writeCalls = 0;
+        };
+
+        IProcessMemory& memory;
+        CheatTableConfig config;
+        RegionMap regions;
+        WriteTransaction transaction{memory};
+        mutable std::mutex mutex;               // slots, 틱 상태
+        std::vector<Slot> slots;
+        uint64_t tickNumber = 0;
+        std::vector<ReadRequest> requests;
+        std::vector<uint8_t> readBuffer;
+        std::vector<size_t> writeSlots;         // transaction 항목 i → slots 번호
+        std::unordered_map<std::string, uintptr_t> moduleBases;
+
+        std::atomic<bool> running{false};
+        std::thread worker;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+
+        mutable std::mutex statsMutex;
+        Stats stats;
+        std::vector<double> latencySamples;     // 고리 버퍼 (SampleCount)
+        std::vector<double> jitterSamples;
+        double latencySum = 0.0;
+        double jitterSum = 0.0;
+        uint64_t jitterCount = 0;
+
+        void Encode(Slot& slot) {
+            EncodeValue(slot.entry.type, slot.entry.value, slot.encoded);
+        }
+
+        void AddRead(uintptr_t address, size_t size) {
+            ReadRequest request;
+            request.address = address;
+            request.size = size;
+            requests.push_back(request);
+            readBuffer.resize(readBuffer.size() + size);
+        }
+
+        uint64_t LoadPointer(const uint8_t* data) const {
+            if (config.pointerSize == 4) {
+                uint32_t value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            uint64_t value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        bool ModuleBase(const std::string& name, uintptr_t& base, TickCounters& counters) {
+            auto it = moduleBases.find(name);
+            if (it == moduleBases.end()) {
+                // 모르는 모듈이면 목록을 새로 받음 (모듈이 늦게 로드되는 경우)
+                moduleBases.clear();
+                for (const ModuleRange& module : memory.EnumerateModules()) moduleBases.emplace(module.name, module.base);
+                ++counters.readCalls;
+                it = moduleBases.find(name);
+                if (it == moduleBases.end()) return false;
+            }
+            base = it->second;
+            return true;
+        }
+
+        // 경로를 처음부터 따라가 주소와 포인터 칸을 기억 (고정 주소 항목은 그대로)
+        bool Resolve(Slot& slot, TickCounters& counters) {
+            slot.resolved = false;
+            slot.links.clear();
+            slot.pointers.clear();
+            if (!slot.entry.usePath) {
+                slot.address = slot.entry.address;
+                slot.resolved = true;
+                return true;
+            }
+            ++counters.resolves;
+            slot.nextRetry = tickNumber + std::max<size_t>(1, config.resolveRetryTicks);
+            uintptr_t address = 0;
+            if (!ModuleBase(slot.entry.path.module, address, counters)) return false;
+            address += slot.entry.path.baseOffset;
+            for (uintptr_t offset : slot.entry.path.offsets) {
+                uint8_t buffer[8] = {};
+                size_t bytesRead = 0;
+                ++counters.readCalls;
+                if (!memory.ReadBytes(address, buffer, config.pointerSize, bytesRead) || bytesRead != config.pointerSize) return false;
+                uint64_t next = LoadPointer(buffer);
+                if (next == 0) return false;
+                slot.links.push_back(address);
+                slot.pointers.push_back(next);
+                address = static_cast<uintptr_t>(next) + offset;
+            }
+            slot.address = address;
+            slot.resolved = true;
+            return true;
+        }
+
+        static double Percentile99(const std::vector<double>& samples) {
+            if (samples.empty()) return 0.0;
+            std::vector<double> sorted = samples;
+            size_t index = std::min(sorted.size() - 1, sorted.size() * 99 / 100);
+            std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+            return sorted[index];
+        }
+
+        static void Sample(std::vector<double>& samples, uint64_t count, double value) {
+            if (samples.size() < SampleCount) samples.push_back(value);
+            else samples[count % SampleCount] = value;
+        }
+
+        void RecordTick(const TickCounters& counters, double microseconds) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.writes += counters.writes;
+            stats.failedWrites += counters.failedWrites;
+            stats.resolves += counters.resolves;
+            stats.invalidations += counters.invalidations;
+            stats.clamped += counters.clamped;
+            stats.readCalls += counters.readCalls;
+            stats.writeCalls += counters.writeCalls;
+            Sample(latencySamples, stats.ticks, microseconds);
+            ++stats.ticks;
+            latencySum += microseconds;
+            stats.latency.last = microseconds;
+            stats.latency.mean = latencySum / stats.ticks;
+            stats.latency.max = std::max(stats.latency.max, microseconds);
+        }
+
+        void RecordJitter(double microseconds, bool overrun) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            Sample(jitterSamples, jitterCount, microseconds);
+            ++jitterCount;
+            jitterSum += microseconds;
+            stats.jitter.last = microseconds;
+            stats.jitter.mean = jitterSum / jitterCount;
+            stats.jitter.max = std::max(stats.jitter.max, microseconds);
+            stats.overruns += overrun;
+        }
+
+        void Loop() {
+            using Clock = std::chrono::steady_clock;
+            const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.rateHz));
+            const Clock::duration spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(config.spinMicroseconds));
+            Clock::time_point next = Clock::now();
+            while (running.load()) {
+                Clock::time_point now = Clock::now();
+                if (now < next) {
+                    {
+                        std::unique_lock<std::mutex> lock(wakeMutex);
+                        if (wake.wait_until(lock, next - spin, [this]() { return !running.load(); })) break;
+                    }
+                    while (Clock::now() < next) std::this_thread::yield();
+                    now = Clock::now();
+                }
+                bool overrun = now - next >= period;
+                RecordJitter(std::chrono::duration<double, std::micro>(now - next).count(), overrun);
+                Tick();
+                next += period;
+                // 한 주기 이상 밀렸으면 밀린 틱을 몰아서 돌지 않고 지금부터 다시 셈
+                if (Clock::now() - next >= period) next = Clock::now();
+            }
+        }
+    };
+}
@@ -0,0 +1,367 @@
+#pragma once
+/*
+ * 컴파일된 와일드카드 시그니처 (바이트 패턴 + 마스크)
+ *
+ * 기존 스캐너들은 모든 위치 i에서 패턴 전체를 마스크와 함께 바이트 단위로 비교했습니다 (O(n·m)).
+ * CompiledPattern은 패턴을 한 번 분석해 두고 다음과 같이 검색합니다.
+ * - 고정 바이트 중 메모리에서 가장 드문 바이트(앵커)를 고르고, 다른 위치의 두 번째 앵커도 고름
+ *   (한 비트만 무시하는 바이트, 예: 대소문자 무시 0xDF도 앵커가 될 수 있음)
+ * - SIMD: 블록마다 두 앵커 위치를 동시에 비교해 후보 비트만 남김 (대부분의 블록은 비교 2번으로 탈락)
+ * - Scalar: memchr로 첫 앵커 사이를 건너뜀
+ * - 후보는 16바이트 단위 마스크 비교 ((data ^ bytes) & mask == 0)로 나머지를 확인
+ *
+ * 패턴 문자열 (IDA 스타일): "48 8B 05 ?? ?? ?? ?? 48 85 C0"
+ * - "?" 또는 "??"는 임의의 바이트, "4?"/"?8"은 한 니블만 고정
+ *
+ * 사용 예:
+ *   ScanCore::CompiledPattern pattern = ScanCore::CompiledPattern::Parse("48 8B 05 ?? ?? ?? ?? 48 85 C0");
+ *   if (pattern.Empty()) { 잘못된 패턴 }
+ *   pattern.FindAll(data, size, baseAddress, results);
+ */
+
+#include "ScanKernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    class CompiledPattern {
+    public:
+        CompiledPattern() = default;
+
+        // mask[j]가 false인 바이트는 와일드카드. mask가 비어 있으면 모든 바이트 고정. 크기가 다르면 빈 패턴
+        CompiledPattern(const std::vector<uint8_t>& pattern, const std::vector<bool>& mask = {}) {
+            if (!mask.empty() && mask.size() != pattern.size()) return;
+            std::vector<uint8_t> byteMask(pattern.size());
+            for (size_t j = 0; j < pattern.size(); ++j) {
+                byteMask[j] = mask.empty() || mask[j] ? 0xFF : 0x00;
+            }
+            Compile(pattern, byteMask);
+        }
+
+        // 바이트마다 임의의 마스크 (0xFF 고정, 0x00 와일드카드, 0xDF ASCII 대소문자 무시 등). 크기가 다르면 빈 패턴
+        static CompiledPattern FromByteMask(const std::vector<uint8_t>& pattern, const std::vector<uint8_t>& byteMask) {
+            CompiledPattern result;
+            if (byteMask.size() == pattern.size()) result.Compile(pattern, byteMask);
+            return result;
+        }
+
+        /**
+         * 앵커 위치를 직접 지정합니다 (문자열처럼 코드용 바이트 빈도표가 맞지 않을 때. 예: 첫 글자와 마지막 글자).
+         * 앵커 위치는 고정 바이트이거나 한 비트만 무시하는 바이트여야 하며, 아니면 자동 선택을 그대로 둡니다.
+         * 지정한 앵커는 memchr 대신 항상 SIMD 두 위치 비교로 찾습니다.
+         */
+        CompiledPattern& WithAnchors(size_t first, size_t second) {
+            if (first >= length || second >= length || AnchorCost(first) < 0 || AnchorCost(second) < 0) return *this;
+            anchorOffset[0] = first;
+            anchorByte[0] = bytes[first];
+            anchorMask[0] = masks[first];
+            anchorCount = 1;
+            if (second != first) {
+                anchorOffset[1] = second;
+                anchorByte[1] = bytes[second];
+                anchorMask[1] = masks[second];
+                anchorCount = 2;
+            }
+            rareAnchor = false;
+            return *this;
+        }
+
+        // "48 8B ?? 89" 형식. 형식이 잘못되면 빈 패턴
+        static CompiledPattern Parse(const std::string& text) {
+            std::vector<uint8_t> bytes;
+            std::vector<uint8_t> mask;
+            size_t i = 0;
+            while (i < text.size()) {
+                if (std::isspace(static_cast<unsigned char>(text[i]))) {
+                    ++i;
+                    continue;
+                }
+                size_t end = i;
+                while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end]))) ++end;
+                size_t length = end - i;
+                if (length == 1 && text[i] == '?') {
+                    bytes.push_back(0);
+                    mask.push_back(0);
+                } else if (length == 2) {
+                    uint8_t value = 0, valueMask = 0;
+                    for (size_t n = 0; n < 2; ++n) {
+                        int nibble = HexNibble(text[i + n]);
+                        if (nibble == -2) return CompiledPattern();
+                        value = static_cast<uint8_t>(value << 4);
+                        valueMask = static_cast<uint8_t>(valueMask << 4);
+                        if (nibble >= 0) {
+                            value |= static_cast<uint8_t>(nibble);
+                            valueMask |= 0x0F;
+                        }
+                    }
+                    bytes.push_back(value);
+                    mask.push_back(valueMask);
+                } else {
+                    return CompiledPattern();
+                }
+                i = end;
+            }
+
+            CompiledPattern result;
+            result.Compile(bytes, mask);
+            return result;
+        }
+
+        bool Empty() const { return length == 0; }
+        size_t Size() const { return length; }
+
+        // j번째 바이트의 값(마스크 적용)과 마스크 (0xFF 고정, 0x00 와일드카드, 그 외 일부 비트만 고정)
+        uint8_t Byte(size_t j) const { return bytes[j]; }
+        uint8_t Mask(size_t j) const { return masks[j]; }
+
+        /*
+         * 프로세스 메모리(코드 + 데이터)에서 흔한 바이트일수록 큰 값.
+         * 0x00/0xFF 채움, x64 REX/MOV/CALL 접두사, int3 패딩 등은 앵커로 쓰면 후보가 너무 많아짐
+         */
+        static int ByteFrequency(uint8_t value) {
+            static const uint8_t common[] = {
+                0x00, 0xFF, 0xCC, 0x48, 0x8B, 0x89, 0x0F, 0x01, 0x24, 0x4C, 0x44, 0x8D, 0xE8, 0x85, 0xC0, 0x83,
+                0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x03, 0x74, 0x75, 0xC3, 0x90, 0x41, 0x49, 0x45, 0x4D,
+                0x05, 0x0D, 0x15, 0x5C, 0x18, 0x28, 0x30, 0x38, 0x50, 0x3F, 0xFE, 0x7F, 0x66, 0xF3, 0x0B, 0xEB,
+                0x33, 0xC7
+            };
+            const size_t count = sizeof(common) / sizeof(common[0]);
+            for (size_t n = 0; n < count; ++n) {
+                if (common[n] == value) return static_cast<int>(count - n);
+            }
+            return 0;
+        }
+
+        // 검색에 쓰는 앵커 (고정 바이트가 없으면 anchorCount == 0)
+        size_t AnchorCount() const { return anchorCount; }
+        size_t AnchorOffset(size_t n) const { return anchorOffset[n]; }
+
+        // p에서 패턴 전체가 일치하는지 (p[0..Size()) 읽기 가능해야 함)
+        bool MatchesAt(const uint8_t* p) const {
+            return Verify(p, false);
+        }
+
+        /**
+         * 버퍼에서 패턴이 시작하는 모든 오프셋을 찾아 (baseAddress + 오프셋)을 out에 추가합니다.
+         * 결과는 오름차순이며 기존 바이트/마스크 중첩 루프와 같습니다. 추가된 개수를 반환합니다.
+         */
+        size_t FindAll(const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out,
+                       SimdLevel level = ActiveSimdLevel()) const {
+            size_t before = out.size();
+            Search(data, size, level, [&](size_t offset) {
+                out.push_back(baseAddress + offset);
+                return true;
+            });
+            return out.size() - before;
+        }
+
+        // 첫 번째 일치 위치. 없으면 false
+        bool FindFirst(const uint8_t* data, size_t size, size_t& offset, SimdLevel level = ActiveSimdLevel()) const {
+            bool found = false;
+            Search(data, size, level, [&](size_t position) {
+                offset = position;
+                found = true;
+                return false;
+            });
+            return found;
+        }
+
+        bool Contains(const uint8_t* data, size_t size, SimdLevel level = ActiveSimdLevel()) const {
+            size_t offset = 0;
+            return FindFirst(data, size, offset, level);
+        }
+
+    private:
+        static constexpr size_t VerifyBlock = 16;
+
+        size_t length = 0;
+        size_t paddedLength = 0;            // VerifyBlock의 배수
+        std::vector<uint8_t> bytes;         // (값 & 마스크), paddedLength까지 0으로 채움
+        std::vector<uint8_t> masks;         // 0xFF 고정, 0x00 와일드카드, 0x0F/0xF0 니블
+        size_t anchorCount = 0;
+        size_t anchorOffset[2] = {};
+        uint8_t anchorByte[2] = {};
+        uint8_t anchorMask[2] = {};         // 0xFF 또는 한 비트만 무시하는 마스크
+        bool rareAnchor = false;            // 첫 앵커가 흔한 바이트 목록에 없는 고정 바이트 -> memchr가 더 빠름
+
+        // 0~15: 니블, -1: 와일드카드 '?', -2: 잘못된 문자
+        static int HexNibble(char c) {
+            if (c == '?') return -1;
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -2;
+        }
+
+        void Compile(const std::vector<uint8_t>& pattern, const std::vector<uint8_t>& mask) {
+            length = pattern.size();
+            paddedLength = (length + VerifyBlock - 1) / VerifyBlock * VerifyBlock;
+            bytes.assign(paddedLength, 0);
+            masks.assign(paddedLength, 0);
+            for (size_t j = 0; j < length; ++j) {
+                masks[j] = mask[j];
+                bytes[j] = static_cast<uint8_t>(pattern[j] & mask[j]);
+            }
+
+            // 가장 드문 고정 바이트 두 개 (앞쪽 위치 우선). 같은 바이트라도 위치가 다르면 함께 걸러짐
+            anchorCount = 0;
+            for (size_t n = 0; n < 2; ++n) {
+                int best = -1;
+                for (size_t j = 0; j < length; ++j) {
+                    if (AnchorCost(j) < 0 || (n == 1 && j == anchorOffset[0])) continue;
+                    if (best < 0 || AnchorCost(j) < AnchorCost(static_cast<size_t>(best))) best = static_cast<int>(j);
+                }
+                if (best < 0) break;
+                anchorOffset[n] = static_cast<size_t>(best);
+                anchorByte[n] = bytes[best];
+                anchorMask[n] = masks[best];
+                ++anchorCount;
+            }
+            rareAnchor = anchorCount > 0 && anchorMask[0] == 0xFF && ByteFrequency(anchorByte[0]) == 0;
+        }
+
+        // 앵커로 쓸 때의 비용 (작을수록 드묾). 고정 바이트는 빈도, 한 비트만 무시하는 바이트는 두 값 중 흔한 쪽의
+        // 빈도 + 1 (일치 값이 두 개이므로). 그 외 마스크는 앵커로 쓰지 않음(-1)
+        int AnchorCost(size_t j) const {
+            if (masks[j] == 0xFF) return ByteFrequency(bytes[j]);
+            uint8_t ignored = static_cast<uint8_t>(~masks[j]);
+            if (ignored == 0 || (ignored & (ignored - 1)) != 0) return -1;
+            return std::max(ByteFrequency(bytes[j]), ByteFrequency(static_cast<uint8_t>(bytes[j] | ignored))) + 1;
+        }
+
+        // wide가 true이면 p[0..paddedLength) 전체를 읽어도 됨 (16바이트 단위 비교)
+        bool Verify(const uint8_t* p, bool wide) const {
+#if defined(SCANCORE_X86)
+            if (wide) {
+                for (size_t j = 0; j < paddedLength; j += VerifyBlock) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + j));
+                    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes.data() + j));
+                    __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.data() + j));
+                    __m128i diff = _mm_and_si128(_mm_xor_si128(block, value), mask);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF) return false;
+                }
+                return true;
+            }
+#else
+            (void)wide;
+#endif
+            for (size_t j = 0; j < length; ++j) {
+                if ((p[j] & masks[j]) != bytes[j]) return false;
+            }
+            return true;
+        }
+
+        // 일치할 때마다 found(오프셋) 호출. found가 false를 반환하면 중단
+        template<typename Found>
+        void Search(const uint8_t* data, size_t size, SimdLevel level, Found found) const {
+            if (length == 0 || size < length) return;
+            const size_t last = size - length;    // 마지막 후보 위치
+            size_t i = 0;
+
+            if (anchorCount == 0) {
+                // 고정 바이트가 없는 패턴 (모두 와일드카드/니블)
+                for (; i <= last; ++i) {
+                    if (Verify(data + i, i + paddedLength <= size) && !found(i)) return;
+                }
+                return;
+            }
+
+#if defined(SCANCORE_X86)
+            // 드문 앵커는 memchr(자체 SIMD)로 건너뛰는 편이 두 위치를 매번 비교하는 것보다 빠름
+            if (!rareAnchor && level == SimdLevel::AVX2) {
+                i = SearchAVX2(data, size, found);
+            } else if (!rareAnchor && level == SimdLevel::SSE2) {
+                i = SearchSSE2(data, size, found);
+            }
+            if (i == size) return;
+#else
+            (void)level;
+#endif
+
+            // Scalar (및 SIMD 꼬리): 첫 앵커 사이를 memchr로 건너뜀 (마스크 앵커는 한 바이트씩)
+            const size_t offset0 = anchorOffset[0];
+            if (anchorMask[0] != 0xFF) {
+                for (; i <= last; ++i) {
+                    if ((data[i + offset0] & anchorMask[0]) != anchorByte[0]) continue;
+                    if ((anchorCount < 2 || (data[i + anchorOffset[1]] & anchorMask[1]) == anchorByte[1]) &&
+                        Verify(data + i, i + paddedLength <= size) && !found(i)) {
+                        return;
+                    }
+                }
+                return;
+            }
+            while (i <= last) {
+                const void* hit = memchr(data + i + offset0, anchorByte[0], last - i + 1);
+                if (!hit) return;
+                size_t candidate = static_cast<size_t>(static_cast<const uint8_t*>(hit) - data) - offset0;
+                if ((anchorCount < 2 || (data[candidate + anchorOffset[1]] & anchorMask[1]) == anchorByte[1]) &&
+                    Verify(data + candidate, candidate + paddedLength <= size) && !found(candidate)) {
+                    return;
+                }
+                i = candidate + 1;
+            }
+        }
+
+#if defined(SCANCORE_X86)
+        // 처리를 마친 다음 위치를 반환 (중단했으면 size)
+        template<typename Found>
+        size_t SearchSSE2(const uint8_t* data, size_t size, Found& found) const {
+            constexpr size_t Block = 16;
+            const size_t tailReach = Block + length - 1;
+            const size_t offset0 = anchorOffset[0];
+            const size_t offset1 = anchorOffset[anchorCount - 1];
+            const __m128i first = _mm_set1_epi8(static_cast<char>(anchorByte[0]));
+            const __m128i second = _mm_set1_epi8(static_cast<char>(anchorByte[anchorCount - 1]));
+            const __m128i firstMask = _mm_set1_epi8(static_cast<char>(anchorMask[0]));
+            const __m128i secondMask = _mm_set1_epi8(static_cast<char>(anchorMask[anchorCount - 1]));
+
+            size_t i = 0;
+            for (; i + tailReach <= size; i += Block) {
+                const uint8_t* p = data + i;
+                __m128i eq = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + offset0)), firstMask), first);
+                eq = _mm_and_si128(eq, _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + offset1)), secondMask), second));
+                uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+                while (hits) {
+                    size_t candidate = i + Detail::CountTrailingZeros(hits);
+                    if (Verify(data + candidate, candidate + paddedLength <= size) && !found(candidate)) return size;
+                    hits &= hits - 1;
+                }
+            }
+            return i;
+        }
+
+        template<typename Found>
+        SCANCORE_TARGET_AVX2 size_t SearchAVX2(const uint8_t* data, size_t size, Found& found) const {
+            constexpr size_t Block = 32;
+            const size_t tailReach = Block + length - 1;
+            const size_t offset0 = anchorOffset[0];
+            const size_t offset1 = anchorOffset[anchorCount - 1];
+            const __m256i first = _mm256_set1_epi8(static_cast<char>(anchorByte[0]));
+            const __m256i second = _mm256_set1_epi8(static_cast<char>(anchorByte[anchorCount - 1]));
+            const __m256i firstMask = _mm256_set1_epi8(static_cast<char>(anchorMask[0]));
+            const __m256i secondMask = _mm256_set1_epi8(static_cast<char>(anchorMask[anchorCount - 1]));
+
+            size_t i = 0;
+            for (; i + tailReach <= size; i += Block) {
+                const uint8_t* p = data + i;
+                __m256i eq = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + offset0)), firstMask), first);
+                eq = _mm256_and_si256(eq, _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + offset1)), secondMask), second));
+                uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+                while (hits) {
+                    size_t candidate = i + Detail::CountTrailingZeros(hits);
+                    if (Verify(data + candidate, candidate + paddedLength <= size) && !found(candidate)) return size;
+                    hits &= hits - 1;
+                }
+            }
+            return i;
+        }
+#endif
+    };
+}
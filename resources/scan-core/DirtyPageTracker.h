@@ -0,0 +1,314 @@
+#pragma once
+/*
+ * 다음 스캔용 변경 페이지 추적 (soft-dirty / 페이지 해시)
+ *
+ * 다음 스캔을 반복하면 대부분의 페이지가 그대로인데도 후보 페이지를 매번 모두 다시 읽습니다.
+ * 여기서는 지난 읽기 이후 쓰인 페이지만 골라냅니다.
+ *
+ * - SoftDirty (Linux): /proc/<pid>/clear_refs에 "4"를 써서 soft-dirty 비트를 지우고(Arm),
+ *   다음 스캔 때 /proc/<pid>/pagemap의 비트 55로 그 뒤에 쓰인 페이지를 확인합니다. 깨끗한 페이지는 읽지 않음
+ * - PageHash (그 외): 읽은 페이지의 해시를 기억해 두고, 다음 스캔에서 같으면 후보별 비교를 건너뜀
+ *   (페이지는 읽어야 하므로 읽기 양은 줄지 않음)
+ *
+ * 순서: 기준 값을 읽기 전에 Arm → 다음 스캔에서 CleanPages 조회 → Arm → 깨끗하지 않은 페이지만 읽기
+ * 조회와 Arm 사이(보통 1ms 미만)에 쓰인 페이지는 구분할 수 없으므로 두 호출은 바로 이어서 부르세요.
+ *
+ * clear_refs는 대상 프로세스 전체의 soft-dirty 비트를 지우므로 같은 프로세스에 CRIU 같은 도구를 함께 쓰면 안 됩니다.
+ * 커널이 CONFIG_MEM_SOFT_DIRTY 없이 빌드되었거나 clear_refs/pagemap 권한이 없으면 PageHash로 동작합니다.
+ *
+ * 사용 예:
+ *   ScanCore::DirtyPageTracker tracker(*memory);
+ *   tracker.Arm();
+ *   auto results = ...;    // 첫 스캔
+ *   results = ScanCore::FilterResultStore<int>(results, ScanCore::ChangeFilter::Unchanged, reader, &tracker);
+ */
+
+#include "BatchReader.h"
+#include "ChangeFilter.h"
+#include "Hash.h"
+#include "ProcessMemory.h"
+#include "ScanResultStore.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ScanCore {
+
+    enum class DirtyTrackingMode {
+        SoftDirty,
+        PageHash
+    };
+
+    inline const char* DirtyTrackingModeName(DirtyTrackingMode mode) {
+        return mode == DirtyTrackingMode::SoftDirty ? "soft-dirty" : "page hash";
+    }
+
+    class DirtyPageTracker {
+    public:
+        static constexpr size_t PageSize = 4096;
+        static constexpr size_t MinHashCandidates = 256;   // PageHash: 페이지당 후보가 이보다 적으면 해시하지 않고 바로 비교
+
+        struct Stats {
+            size_t arms = 0;
+            size_t queriedPages = 0;    // CleanPages로 조회한 페이지
+            size_t cleanPages = 0;      // 그중 읽지 않아도 되는 페이지
+            size_t hashedPages = 0;     // PageUnchanged로 비교한 페이지
+            size_t unchangedPages = 0;  // 그중 해시가 같은 페이지
+        };
+
+        // preferred가 SoftDirty여도 Linux 프로세스 백엔드가 아니거나 커널이 지원하지 않으면 PageHash
+        explicit DirtyPageTracker(IProcessMemory& memory, DirtyTrackingMode preferred = DirtyTrackingMode::SoftDirty) {
+#if defined(__linux__)
+            LinuxProcessMemory* process = dynamic_cast<LinuxProcessMemory*>(&memory);
+            if (preferred == DirtyTrackingMode::SoftDirty && process && KernelSupportsSoftDirty()) {
+                std::string prefix = "/proc/" + std::to_string(process->GetPid());
+                clearRefsFd = open((prefix + "/clear_refs").c_str(), O_WRONLY | O_CLOEXEC);
+                pagemapFd = open((prefix + "/pagemap").c_str(), O_RDONLY | O_CLOEXEC);
+                if (clearRefsFd >= 0 && pagemapFd >= 0) {
+                    mode = DirtyTrackingMode::SoftDirty;
+                } else {
+                    CloseFiles();
+                }
+            }
+#else
+            (void)memory;
+            (void)preferred;
+#endif
+        }
+
+        ~DirtyPageTracker() {
+            CloseFiles();
+        }
+
+        DirtyPageTracker(const DirtyPageTracker&) = delete;
+        DirtyPageTracker& operator=(const DirtyPageTracker&) = delete;
+
+        DirtyTrackingMode Mode() const { return mode; }
+
+        // 깨끗한 페이지를 읽지 않고 건너뛸 수 있는지 (SoftDirty)
+        bool CanSkipReads() const { return mode == DirtyTrackingMode::SoftDirty; }
+
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = Stats(); }
+
+        /**
+         * 지금부터 읽는 값이 다음 비교의 기준이 됩니다.
+         * SoftDirty: soft-dirty 비트를 지움. PageHash: 기억한 해시를 버림 (다른 시점에 읽은 값과 섞이지 않도록)
+         */
+        bool Arm() {
+            ++stats.arms;
+            pageHashes.clear();
+#if defined(__linux__)
+            if (mode == DirtyTrackingMode::SoftDirty) {
+                if (pwrite(clearRefsFd, "4", 1, 0) == 1) return true;
+                // 프로세스가 끝났거나 권한을 잃음: 이후로는 해시로 동작
+                CloseFiles();
+                mode = DirtyTrackingMode::PageHash;
+                return false;
+            }
+#endif
+            return true;
+        }
+
+        /**
+         * sortedPages(페이지 주소 오름차순) 중 마지막 Arm 이후 쓰이지 않은 페이지를 clean에 담습니다 (오름차순).
+         * 메모리에 없는 페이지(스왑 제외)는 해제 후 다시 매핑되었을 수 있으므로 깨끗하다고 보지 않습니다.
+         * SoftDirty가 아니거나 pagemap을 읽지 못하면 false (모든 페이지를 읽어야 함)
+         */
+        bool CleanPages(const std::vector<uintptr_t>& sortedPages, std::vector<uintptr_t>& clean) {
+            clean.clear();
+            if (mode != DirtyTrackingMode::SoftDirty) return false;
+#if defined(__linux__)
+            const uint64_t Present = 1ULL << 63, Swapped = 1ULL << 62, SoftDirtyBit = 1ULL << 55;
+            const size_t MaxEntries = 64 * 1024;
+
+            // 연속 페이지는 pagemap 한 번의 pread로 (항목당 8바이트)
+            std::vector<uint64_t> entries;
+            size_t i = 0;
+            while (i < sortedPages.size()) {
+                size_t count = 1;
+                while (i + count < sortedPages.size() && count < MaxEntries &&
+                       sortedPages[i + count] == sortedPages[i] + count * PageSize) {
+                    ++count;
+                }
+                entries.resize(count);
+                off_t offset = static_cast<off_t>(sortedPages[i] / PageSize * sizeof(uint64_t));
+                ssize_t bytes = pread(pagemapFd, entries.data(), count * sizeof(uint64_t), offset);
+                if (bytes != static_cast<ssize_t>(count * sizeof(uint64_t))) {
+                    clean.clear();
+                    return false;
+                }
+                for (size_t n = 0; n < count; ++n) {
+                    if ((entries[n] & (Present | Swapped)) && !(entries[n] & SoftDirtyBit)) {
+                        clean.push_back(sortedPages[i + n]);
+                    }
+                }
+                i += count;
+            }
+            stats.queriedPages += sortedPages.size();
+            stats.cleanPages += clean.size();
+            return true;
+#else
+            (void)sortedPages;
+            return false;
+#endif
+        }
+
+        /**
+         * PageHash: page(PageSize 바이트, data)가 이 추적기가 지난번에 본 내용과 같은지 반환하고 해시를 갱신합니다.
+         * 처음 보는 페이지는 false. 한 스레드에서만 호출하세요.
+         */
+        bool PageUnchanged(uintptr_t page, const uint8_t* data) {
+            uint64_t hash = HashBytes(data, PageSize);
+            ++stats.hashedPages;
+            auto result = pageHashes.emplace(page, hash);
+            if (result.second) return false;
+            if (result.first->second == hash) {
+                ++stats.unchangedPages;
+                return true;
+            }
+            result.first->second = hash;
+            return false;
+        }
+
+        /**
+         * 커널의 soft-dirty 지원 여부. 자기 프로세스의 페이지 하나를 지우고/써서 비트 55가 바뀌는지 확인합니다.
+         * (지원하지 않는 커널도 clear_refs 쓰기는 성공하고 비트만 항상 0)
+         */
+        static bool KernelSupportsSoftDirty() {
+#if defined(__linux__)
+            static const bool supported = [] {
+                int clearRefs = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+                int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+                void* page = mmap(nullptr, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                bool ok = false;
+                if (clearRefs >= 0 && pagemap >= 0 && page != MAP_FAILED) {
+                    volatile uint8_t* bytes = static_cast<volatile uint8_t*>(page);
+                    off_t offset = static_cast<off_t>(reinterpret_cast<uintptr_t>(page) / PageSize * sizeof(uint64_t));
+                    uint64_t afterClear = 0, afterWrite = 0;
+                    bytes[0] = 1;
+                    if (pwrite(clearRefs, "4", 1, 0) == 1 &&
+                        pread(pagemap, &afterClear, sizeof(afterClear), offset) == sizeof(afterClear)) {
+                        bytes[0] = 2;
+                        ok = pread(pagemap, &afterWrite, sizeof(afterWrite), offset) == sizeof(afterWrite) &&
+                             !(afterClear >> 55 & 1) && (afterWrite >> 55 & 1);
+                    }
+                }
+                if (page != MAP_FAILED) munmap(page, PageSize);
+                if (clearRefs >= 0) close(clearRefs);
+                if (pagemap >= 0) close(pagemap);
+                return ok;
+            }();
+            return supported;
+#else
+            return false;
+#endif
+        }
+
+    private:
+        DirtyTrackingMode mode = DirtyTrackingMode::PageHash;
+        int clearRefsFd = -1;
+        int pagemapFd = -1;
+        std::unordered_map<uintptr_t, uint64_t> pageHashes;
+        Stats stats;
+
+        void CloseFiles() {
+#if defined(__linux__)
+            if (clearRefsFd >= 0) close(clearRefsFd);
+            if (pagemapFd >= 0) close(pagemapFd);
+#endif
+            clearRefsFd = -1;
+            pagemapFd = -1;
+        }
+    };
+
+    /**
+     * 다음 스캔 준비: tracker가 SoftDirty면 후보(주소 오름차순)가 걸친 페이지 중 깨끗한 페이지를 조회해
+     * reader가 읽지 않도록 지정하고 다시 Arm합니다. 조회 → Arm → 읽기 순서여야 Arm 뒤에 쓰인 페이지를
+     * 다음 번에 놓치지 않습니다. 필터가 끝나면 reader.SetSkippedPages({})로 되돌리세요.
+     */
+    template<typename Iterator, typename AddressOf, typename SizeOf>
+    void SkipCleanPages(DirtyPageTracker* tracker, BatchReader& reader, Iterator begin, Iterator end,
+                        AddressOf addressOf, SizeOf sizeOf) {
+        const size_t PageSize = DirtyPageTracker::PageSize;
+        if (!tracker || !tracker->CanSkipReads()) return;
+        std::vector<uintptr_t> candidatePages;
+        for (Iterator it = begin; it != end; ++it) {
+            uintptr_t address = addressOf(*it);
+            uintptr_t first = address & ~static_cast<uintptr_t>(PageSize - 1);
+            uintptr_t last = (address + sizeOf(*it) - 1) & ~static_cast<uintptr_t>(PageSize - 1);
+            for (uintptr_t page = first; page <= last; page += PageSize) {
+                if (candidatePages.empty() || candidatePages.back() < page) candidatePages.push_back(page);
+            }
+        }
+        std::vector<uintptr_t> clean;
+        tracker->CleanPages(candidatePages, clean);
+        tracker->Arm();
+        reader.SetSkippedPages(std::move(clean));
+    }
+
+    /**
+     * 결과 저장소 다음 스캔: 후보마다 현재 값을 읽어 이전 값과 filter로 비교하고, 남은 후보를 현재 값과 함께 반환합니다.
+     * tracker가 SoftDirty면 깨끗한 페이지의 후보는 읽지 않고 저장된 값 그대로 판정하고 (변경 없음만 통과),
+     * PageHash면 해시가 같은 페이지의 후보는 값 비교 없이 판정합니다. 읽기 통계는 reader.GetLastStats()
+     */
+    template<typename T>
+    ScanResultStore FilterResultStore(const ScanResultStore& store, ChangeFilter filter, BatchReader& reader,
+                                      DirtyPageTracker* tracker = nullptr) {
+        const size_t PageSize = DirtyPageTracker::PageSize;
+        ScanResultStore::Builder builder(sizeof(T));
+        if (store.Empty() || store.ValueSize() != sizeof(T)) return builder.Finish();
+
+        SkipCleanPages(tracker, reader, store.begin(), store.end(),
+                       [](const ScanResultStore::Entry& entry) { return entry.address; },
+                       [](const ScanResultStore::Entry&) { return sizeof(T); });
+        bool hashPages = tracker && tracker->Mode() == DirtyTrackingMode::PageHash;
+
+        // 해시(페이지당 4KB)가 후보별 비교보다 싼 빽빽한 블록의 페이지만 해시
+        const size_t MinHashHits = DirtyPageTracker::MinHashCandidates * (ScanResultStore::BlockSize / PageSize);
+        uintptr_t hashedPage = 0;
+        bool pageUnchanged = false;
+        bool anyHashed = false;
+        reader.ForEach(store.begin(), store.end(), sizeof(T),
+            [](const ScanResultStore::Entry& entry) { return entry.address; },
+            [&](const ScanResultStore::Entry& entry, const uint8_t* current) {
+                bool same = current == nullptr;     // 읽지 않은 후보 = 깨끗한 페이지
+                if (!same && hashPages) {
+                    size_t offset = entry.address & (PageSize - 1);
+                    if (offset + sizeof(T) <= PageSize) {
+                        uintptr_t page = entry.address - offset;
+                        if (!anyHashed || page != hashedPage) {
+                            hashedPage = page;
+                            anyHashed = true;
+                            pageUnchanged = store.BlockHitCount(page) >= MinHashHits && tracker->PageUnchanged(page, current - offset);
+                        }
+                        same = pageUnchanged;
+                    }
+                }
+                if (same) {
+                    if (filter == ChangeFilter::Unchanged) builder.Append(entry.address, entry.value);
+                    return;
+                }
+
+                T currentValue;
+                T previousValue;
+                memcpy(&currentValue, current, sizeof(T));
+                memcpy(&previousValue, entry.value, sizeof(T));
+                if (PassesChangeFilter(filter, currentValue, previousValue)) {
+                    builder.Append(entry.address, &currentValue);
+                }
+            });
+        reader.SetSkippedPages({});
+        return builder.Finish();
+    }
+}
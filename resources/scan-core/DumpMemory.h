@@ -0,0 +1,319 @@
+#pragma once
+/*
+ * 덤프 파일 백엔드 (IProcessMemory): 실행 중인 게임 없이 덤프 파일에서 바로 스캔
+ *
+ * OpenDumpMemory(path)는 OpenProcessMemory(pid)처럼 IProcessMemory를 돌려주므로 첫 스캔, 다음 스캔,
+ * 시그니처 스캔, 포인터 스캔 코드를 바꾸지 않고 덤프 파일에 그대로 돌릴 수 있습니다.
+ * - 희소 덤프(SparseDump.h, "SCSD"): SparseDumpMemory. 파일을 매핑만 하고, 읽기가 닿은 블록만 풀어서
+ *   블록 캐시(LRU, 잠금을 나눈 16개 조각)에 둠. 여러 스캔 스레드가 동시에 읽어도 됨
+ *   0 페이지만 있는 블록은 풀지 않고 캐시에도 넣지 않음
+ * - 원본 덤프(MemoryDump.h, "SCMD"): 전체를 불러온 MemoryDump
+ * - 쓰기는 파일을 바꾸지 않고 복사본에만 (MemoryDump와 같음): 쓴 블록은 풀린 사본을 따로 들고 있음
+ *   읽기는 여러 스레드에서 동시에 해도 되지만, 쓰기/보호 변경과 동시에 하면 안 됩니다.
+ * - ForEachDump(): 덤프 여러 개를 스레드마다 하나씩 열어 같은 작업을 병렬로 실행 (빌드 서버에서 대량 분석)
+ *
+ * 사용 예:
+ *   std::unique_ptr<ScanCore::IProcessMemory> memory = ScanCore::OpenDumpMemory("before.scsd");
+ *   auto hits = executor.Run(memory->CollectRanges(filter), memory->MakeReadFunction(), scanFn);
+ *   ScanCore::ForEachDump(paths, [&](size_t index, ScanCore::IProcessMemory& dump) { ... });
+ */
+
+#include "MemoryDump.h"
+#include "SparseDump.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ScanCore {
+
+    struct DumpMemoryConfig {
+        size_t cacheBlocks = 256;          // 풀린 블록 캐시 크기 (블록 64KB, 기본 16MB)
+    };
+
+    class SparseDumpMemory : public IProcessMemory {
+    public:
+        struct Stats {
+            uint64_t hits = 0;              // 캐시에 있던 블록
+            uint64_t misses = 0;            // 새로 푼 블록
+            uint64_t zeroBlocks = 0;        // 풀 필요가 없던 0 블록
+            uint64_t decodedBytes = 0;      // 풀어낸 바이트 수
+        };
+
+        explicit SparseDumpMemory(const DumpMemoryConfig& config = DumpMemoryConfig())
+            : config(config), shards(new Shard[ShardCount]) {}
+
+        bool Open(const std::string& path) {
+            Clear();
+            if (!dump.Open(path)) return false;
+            regions = dump.Regions();
+            return true;
+        }
+
+        bool IsOpen() const { return dump.IsOpen(); }
+        const MappedSparseDump& File() const { return dump; }
+
+        std::vector<MemoryRegion> EnumerateRegions() override { return regions; }
+
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override {
+            ptrdiff_t region = dump.FindRegion(address);
+            if (region < 0) return false;
+            result = regions[static_cast<size_t>(region)];
+            return true;
+        }
+
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            std::shared_ptr<const Block> holder;
+            return dump.ReadBlocks(address, buffer, size, bytesRead,
+                [&](size_t region, uint64_t block, const uint8_t*& data, uint16_t& missingMask) {
+                    return FetchBlock(region, block, data, missingMask, holder);
+                });
+        }
+
+        // 파일은 그대로 두고 쓴 블록의 사본만 바꿈. 빠진 페이지에는 쓸 수 없음
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            bytesWritten = 0;
+            const uint8_t* source = static_cast<const uint8_t*>(data);
+            while (bytesWritten < size) {
+                uintptr_t current = address + bytesWritten;
+                ptrdiff_t region = dump.FindRegion(current);
+                if (region < 0) return false;
+                uint64_t offset = current - regions[static_cast<size_t>(region)].base;
+                uint64_t block = offset / SparseDumpFile::BlockSize;
+                size_t inBlock = static_cast<size_t>(offset % SparseDumpFile::BlockSize);
+                size_t length = std::min(size - bytesWritten, static_cast<size_t>(std::min<uint64_t>(
+                    SparseDumpFile::BlockSize - inBlock, regions[static_cast<size_t>(region)].size - offset)));
+
+                uint64_t index = dump.BlockIndex(static_cast<size_t>(region), block);
+                auto found = written.find(index);
+                if (found == written.end()) {
+                    const uint8_t* original = nullptr;
+                    uint16_t missingMask = 0;
+                    std::shared_ptr<const Block> holder;
+                    if (!FetchBlock(static_cast<size_t>(region), block, original, missingMask, holder)) return false;
+                    auto fresh = std::make_shared<Block>();
+                    fresh->data.assign(original, original + SparseDumpFile::BlockSize);
+                    fresh->missingMask = missingMask;
+                    found = written.emplace(index, std::move(fresh)).first;
+                }
+                Block* copy = found->second.get();
+                for (size_t page = inBlock / SparseDumpFile::PageSize; page * SparseDumpFile::PageSize < inBlock + length; ++page) {
+                    if (copy->missingMask & (1u << page)) return false;
+                }
+                memcpy(copy->data.data() + inBlock, source + bytesWritten, length);
+                bytesWritten += length;
+            }
+            return true;
+        }
+
+        // 영역 단위로만 기록 (덤프에는 페이지 단위 보호가 없음)
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            ptrdiff_t index = dump.FindRegion(address);
+            if (index < 0) return false;
+            MemoryRegion& region = regions[static_cast<size_t>(index)];
+            if (!region.Contains(address, size == 0 ? 1 : size)) return false;
+            oldProtection = region.protection;
+            region.protection = protection;
+            return true;
+        }
+
+        Stats GetStats() const {
+            Stats stats;
+            stats.hits = hits.load(std::memory_order_relaxed);
+            stats.misses = misses.load(std::memory_order_relaxed);
+            stats.zeroBlocks = zeroBlocks.load(std::memory_order_relaxed);
+            stats.decodedBytes = decodedBytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void ResetStats() {
+            hits = 0;
+            misses = 0;
+            zeroBlocks = 0;
+            decodedBytes = 0;
+        }
+
+        // 캐시한 블록을 모두 버림 (쓴 사본은 남김)
+        void DropCache() {
+            for (size_t s = 0; s < ShardCount; ++s) {
+                std::lock_guard<std::mutex> lock(shards[s].mutex);
+                shards[s].lru.clear();
+                shards[s].index.clear();
+            }
+        }
+
+    private:
+        static constexpr size_t ShardCount = 16;
+
+        struct Block {
+            std::vector<uint8_t> data;      // BlockSize 바이트, 0 페이지와 빠진 페이지는 0
+            uint16_t missingMask = 0;
+        };
+
+        using BlockList = std::list<std::pair<uint64_t, std::shared_ptr<const Block>>>;
+
+        // 블록 번호 % ShardCount로 나눈 LRU 조각 (조각마다 잠금 하나)
+        struct Shard {
+            std::mutex mutex;
+            BlockList lru;                  // 앞쪽이 최근
+            std::unordered_map<uint64_t, BlockList::iterator> index;
+        };
+
+        DumpMemoryConfig config;
+        MappedSparseDump dump;
+        std::vector<MemoryRegion> regions;
+        std::unique_ptr<Shard[]> shards;
+        std::unordered_map<uint64_t, std::shared_ptr<Block>> written;
+
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> zeroBlocks{0};
+        std::atomic<uint64_t> decodedBytes{0};
+
+        static const uint8_t* ZeroBlock() {
+            static const std::vector<uint8_t> zeros(SparseDumpFile::BlockSize, 0);
+            return zeros.data();
+        }
+
+        void Clear() {
+            DropCache();
+            written.clear();
+            regions.clear();
+            dump.Close();
+            ResetStats();
+        }
+
+        // 풀린 블록 (쓴 사본 → 0 블록 → 캐시 → 새로 풀기 순). holder가 data를 살려 둠
+        bool FetchBlock(size_t region, uint64_t block, const uint8_t*& data, uint16_t& missingMask,
+                        std::shared_ptr<const Block>& holder) {
+            uint64_t index = dump.BlockIndex(region, block);
+            if (!written.empty()) {
+                auto copy = written.find(index);
+                if (copy != written.end()) {
+                    holder = copy->second;
+                    data = copy->second->data.data();
+                    missingMask = copy->second->missingMask;
+                    return true;
+                }
+            }
+
+            const SparseDumpFile::BlockRecord& record = dump.Block(region, block);
+            if (record.presentMask == 0) {
+                zeroBlocks.fetch_add(1, std::memory_order_relaxed);
+                data = ZeroBlock();
+                missingMask = record.missingMask;
+                return true;
+            }
+
+            Shard& shard = shards[index % ShardCount];
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto found = shard.index.find(index);
+                if (found != shard.index.end()) {
+                    shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+                    holder = found->second->second;
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                    data = holder->data.data();
+                    missingMask = holder->missingMask;
+                    return true;
+                }
+            }
+
+            // 잠금 밖에서 풂 (다른 블록을 읽는 스레드를 막지 않음). 같은 블록을 동시에 풀면 먼저 넣은 쪽을 씀
+            auto fresh = std::make_shared<Block>();
+            fresh->data.resize(SparseDumpFile::BlockSize);
+            if (!dump.DecodeBlock(region, block, fresh->data.data(), fresh->missingMask)) return false;
+            misses.fetch_add(1, std::memory_order_relaxed);
+            decodedBytes.fetch_add(SparseDumpFile::BlockSize, std::memory_order_relaxed);
+
+            size_t capacity = std::max<size_t>(1, config.cacheBlocks / ShardCount);
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto found = shard.index.find(index);
+                if (found != shard.index.end()) {
+                    holder = found->second->second;
+                } else {
+                    shard.lru.emplace_front(index, fresh);
+                    shard.index[index] = shard.lru.begin();
+                    while (shard.lru.size() > capacity) {
+                        shard.index.erase(shard.lru.back().first);
+                        shard.lru.pop_back();
+                    }
+                    holder = std::move(fresh);
+                }
+            }
+            data = holder->data.data();
+            missingMask = holder->missingMask;
+            return true;
+        }
+    };
+
+    /**
+     * 덤프 파일을 형식에 맞는 백엔드로 엽니다 (파일 앞 4바이트로 구분). 열 수 없으면 nullptr.
+     * - "SCSD": SparseDumpMemory (매핑 + 블록 캐시)
+     * - "SCMD": MemoryDump (전체 불러오기)
+     */
+    inline std::unique_ptr<IProcessMemory> OpenDumpMemory(const std::string& path, const DumpMemoryConfig& config = DumpMemoryConfig()) {
+        char magic[4] = {};
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.read(magic, sizeof(magic))) return nullptr;
+        }
+        if (memcmp(magic, "SCSD", 4) == 0) {
+            auto sparse = std::make_unique<SparseDumpMemory>(config);
+            if (!sparse->Open(path)) return nullptr;
+            return sparse;
+        }
+        if (memcmp(magic, "SCMD", 4) == 0) {
+            auto dump = std::make_unique<MemoryDump>();
+            if (!dump->Load(path)) return nullptr;
+            return dump;
+        }
+        return nullptr;
+    }
+
+    /**
+     * paths의 덤프마다 visit(번호, IProcessMemory&)를 실행합니다. 덤프는 스레드마다 하나씩 열고 작업이 끝나면 닫으므로
+     * 동시에 열린 덤프는 threadCount개 이하입니다. 열지 못한 덤프는 건너뛰고, 연 덤프 수를 반환
+     * (visit 안에서 ScanExecutor를 쓰면 덤프 사이 병렬과 덤프 안 병렬이 겹치므로 threadCount를 줄이는 것이 좋음)
+     */
+    template<typename Visit>
+    size_t ForEachDump(const std::vector<std::string>& paths, Visit visit, size_t threadCount = 0,
+                       const DumpMemoryConfig& config = DumpMemoryConfig()) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 1;
+        }
+        threadCount = std::max<size_t>(1, std::min(threadCount, paths.size()));
+
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> opened{0};
+        auto worker = [&]() {
+            for (size_t index = next++; index < paths.size(); index = next++) {
+                std::unique_ptr<IProcessMemory> memory = OpenDumpMemory(paths[index], config);
+                if (!memory) continue;
+                ++opened;
+                visit(index, *memory);
+            }
+        };
+
+        if (threadCount == 1) {
+            worker();
+        } else {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < threadCount; ++t) threads.emplace_back(worker);
+            for (std::thread& thread : threads) thread.join();
+        }
+        return opened.load();
+    }
+}
@@ -0,0 +1,315 @@
+#pragma once
+/*
+ * 스캔 커널 (SIMD 근사값/범위/집합 검색, float/double)
+ *
+ * 실수 값은 정확히 같은 비트로 저장되지 않는 경우가 많아 스캐너들이 `abs(x - value) < 0.001f` 같은
+ * 스칼라 비교를 바이트/4바이트마다 반복했습니다. 여기서는 다음 조건을 한 번의 SIMD 패스로 검사합니다.
+ * - 근사값: |x - value| <= tolerance                  (FloatCondition::Near)
+ * - 범위: low <= x <= high                            (FloatCondition::Between)
+ * - 집합: 최대 16개 값 중 하나와 |x - v| <= tolerance   (FloatCondition::AnyOf)
+ *
+ * NaN은 어떤 조건에도 일치하지 않으며, rejectDenormal이면 비정규 수(0이 아닌 매우 작은 값)도 제외합니다.
+ * 쓰레기 메모리를 실수로 해석하면 비정규 수가 많이 나오므로 기본값은 제외입니다.
+ *
+ * stride는 검사할 주소 간격입니다. 기본값 sizeof(T)는 정렬된 위치만, 1은 모든 바이트 위치를 검사합니다.
+ * 주소(baseAddress + 오프셋)가 stride의 배수인 위치만 보므로 버퍼를 어디서 잘라 넘겨도 결과가 같습니다.
+ * stride가 sizeof(T)보다 작으면 위상(phase)마다 벡터를 한 번씩 더 로드해 블록 안의 모든 위치를 검사합니다.
+ *
+ * 결과는 오름차순이며 FloatCondition::Matches()를 위치마다 호출하는 스칼라 루프와 같습니다.
+ */
+
+#include "ScanKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace ScanCore {
+
+    enum class FloatMatchMode {
+        Range,      // low <= x <= high
+        AnyOf       // values 중 하나와 |x - v| <= tolerance
+    };
+
+    template<typename T>
+    struct FloatCondition {
+        static_assert(std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), "FloatCondition supports float and double");
+        static constexpr size_t MaxValues = 16;
+
+        FloatMatchMode mode = FloatMatchMode::Range;
+        T low = 0;
+        T high = 0;
+        T values[MaxValues] = {};
+        size_t valueCount = 0;
+        T tolerance = 0;
+        bool rejectDenormal = true;
+        size_t stride = sizeof(T);
+
+        static FloatCondition Between(T low, T high) {
+            FloatCondition condition;
+            condition.mode = FloatMatchMode::Range;
+            condition.low = low;
+            condition.high = high;
+            return condition;
+        }
+
+        static FloatCondition Near(T value, T tolerance) {
+            return AnyOf({value}, tolerance);
+        }
+
+        // MaxValues개를 넘는 값은 무시
+        static FloatCondition AnyOf(std::initializer_list<T> targets, T tolerance) {
+            return AnyOf(targets.begin(), targets.end(), tolerance);
+        }
+
+        template<typename Iterator>
+        static FloatCondition AnyOf(Iterator begin, Iterator end, T tolerance) {
+            FloatCondition condition;
+            condition.mode = FloatMatchMode::AnyOf;
+            condition.tolerance = tolerance;
+            for (; begin != end && condition.valueCount < MaxValues; ++begin) {
+                condition.values[condition.valueCount++] = static_cast<T>(*begin);
+            }
+            return condition;
+        }
+
+        FloatCondition& WithStride(size_t bytes) {
+            stride = bytes ? bytes : 1;
+            return *this;
+        }
+
+        FloatCondition& AllowDenormal(bool allow = true) {
+            rejectDenormal = !allow;
+            return *this;
+        }
+
+        // 기준 구현 (SIMD 커널과 결과가 같아야 함)
+        bool Matches(T x) const {
+            if (rejectDenormal && std::fpclassify(x) == FP_SUBNORMAL) return false;
+            if (mode == FloatMatchMode::Range) {
+                return low <= x && x <= high;
+            }
+            for (size_t n = 0; n < valueCount; ++n) {
+                if (std::fabs(x - values[n]) <= tolerance) return true;
+            }
+            return false;
+        }
+    };
+
+    namespace Detail {
+
+        template<typename T>
+        inline void ScanFloatScalar(const uint8_t* data, size_t begin, size_t size, const FloatCondition<T>& condition,
+                                    uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            for (size_t i = begin; i + sizeof(T) <= size; i += condition.stride) {
+                if (condition.Matches(LoadUnaligned<T>(data + i))) {
+                    out.push_back(baseAddress + i);
+                }
+            }
+        }
+
+        // 주소가 stride의 배수인 첫 오프셋
+        inline size_t FirstStrideOffset(uintptr_t baseAddress, size_t stride) {
+            return stride > 1 ? (stride - baseAddress % stride) % stride : 0;
+        }
+
+        // 블록(block 바이트)을 SIMD로 처리할 수 있는 stride: 2의 거듭제곱이고 블록 크기 이하
+        inline bool IsVectorStride(size_t stride, size_t block) {
+            return stride != 0 && (stride & (stride - 1)) == 0 && stride <= block;
+        }
+
+        // 위상 p의 레인 일치 비트를 블록 내 바이트 위치 비트로 펼침
+        inline uint32_t SpreadLanes(unsigned lanes, size_t laneBytes, size_t phaseOffset) {
+            uint32_t bits = 0;
+            while (lanes) {
+                unsigned lane = CountTrailingZeros(lanes);
+                bits |= 1u << (lane * laneBytes + phaseOffset);
+                lanes &= lanes - 1;
+            }
+            return bits;
+        }
+
+        // stride가 sizeof(T)보다 크면 블록 안에서 stride 배수 위치의 레인만 남김
+        inline unsigned StrideLaneMask(size_t lanes, size_t laneBytes, size_t stride) {
+            unsigned mask = 0;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                if ((lane * laneBytes) % stride == 0) mask |= 1u << lane;
+            }
+            return mask;
+        }
+
+#if defined(SCANCORE_X86)
+        // SSE2 연산 (float: __m128, double: __m128d)
+        inline __m128 Sse2Load(const uint8_t* p, float) { return _mm_loadu_ps(reinterpret_cast<const float*>(p)); }
+        inline __m128d Sse2Load(const uint8_t* p, double) { return _mm_loadu_pd(reinterpret_cast<const double*>(p)); }
+        inline __m128 Sse2Set(float v) { return _mm_set1_ps(v); }
+        inline __m128d Sse2Set(double v) { return _mm_set1_pd(v); }
+        inline __m128 Sse2Abs(__m128 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+        inline __m128d Sse2Abs(__m128d v) { return _mm_andnot_pd(_mm_set1_pd(-0.0), v); }
+        inline __m128 Sse2Ge(__m128 a, __m128 b) { return _mm_cmpge_ps(a, b); }
+        inline __m128d Sse2Ge(__m128d a, __m128d b) { return _mm_cmpge_pd(a, b); }
+        inline __m128 Sse2Le(__m128 a, __m128 b) { return _mm_cmple_ps(a, b); }
+        inline __m128d Sse2Le(__m128d a, __m128d b) { return _mm_cmple_pd(a, b); }
+        inline __m128 Sse2Eq(__m128 a, __m128 b) { return _mm_cmpeq_ps(a, b); }
+        inline __m128d Sse2Eq(__m128d a, __m128d b) { return _mm_cmpeq_pd(a, b); }
+        inline __m128 Sse2Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+        inline __m128d Sse2Sub(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+        inline __m128 Sse2And(__m128 a, __m128 b) { return _mm_and_ps(a, b); }
+        inline __m128d Sse2And(__m128d a, __m128d b) { return _mm_and_pd(a, b); }
+        inline __m128 Sse2Or(__m128 a, __m128 b) { return _mm_or_ps(a, b); }
+        inline __m128d Sse2Or(__m128d a, __m128d b) { return _mm_or_pd(a, b); }
+        inline unsigned Sse2MoveMask(__m128 v) { return static_cast<unsigned>(_mm_movemask_ps(v)); }
+        inline unsigned Sse2MoveMask(__m128d v) { return static_cast<unsigned>(_mm_movemask_pd(v)); }
+
+        template<typename T>
+        inline void ScanFloatSSE2(const uint8_t* data, size_t size, const FloatCondition<T>& condition,
+                                  uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            using Vec = decltype(Sse2Set(T()));
+            constexpr size_t Block = 16;
+            constexpr size_t Lanes = Block / sizeof(T);
+            const size_t stride = condition.stride;
+            size_t i = FirstStrideOffset(baseAddress, stride);
+            if (!IsVectorStride(stride, Block)) {
+                ScanFloatScalar(data, i, size, condition, baseAddress, out);
+                return;
+            }
+
+            const size_t phases = stride < sizeof(T) ? sizeof(T) / stride : 1;
+            const size_t reach = Block + (phases - 1) * stride;
+            const unsigned laneMask = StrideLaneMask(Lanes, sizeof(T), std::max(stride, sizeof(T)));
+            const Vec low = Sse2Set(condition.low);
+            const Vec high = Sse2Set(condition.high);
+            const Vec tolerance = Sse2Set(condition.tolerance);
+            const Vec minNormal = Sse2Set(std::numeric_limits<T>::min());
+            const Vec zero = Sse2Set(T(0));
+            Vec targets[FloatCondition<T>::MaxValues];
+            for (size_t n = 0; n < condition.valueCount; ++n) targets[n] = Sse2Set(condition.values[n]);
+
+            for (; i + reach <= size; i += Block) {
+                uint32_t hits = 0;
+                for (size_t p = 0; p < phases; ++p) {
+                    Vec x = Sse2Load(data + i + p * stride, T());
+                    Vec match;
+                    if (condition.mode == FloatMatchMode::Range) {
+                        match = Sse2And(Sse2Ge(x, low), Sse2Le(x, high));
+                    } else {
+                        match = Sse2Le(Sse2Abs(Sse2Sub(x, targets[0])), tolerance);
+                        for (size_t n = 1; n < condition.valueCount; ++n) {
+                            match = Sse2Or(match, Sse2Le(Sse2Abs(Sse2Sub(x, targets[n])), tolerance));
+                        }
+                    }
+                    unsigned lanes = Sse2MoveMask(match) & laneMask;
+                    if (lanes && condition.rejectDenormal) {
+                        lanes &= Sse2MoveMask(Sse2Or(Sse2Ge(Sse2Abs(x), minNormal), Sse2Eq(x, zero)));
+                    }
+                    if (lanes) hits |= SpreadLanes(lanes, sizeof(T), p * stride);
+                }
+                EmitHits(hits, baseAddress + i, out);
+            }
+            ScanFloatScalar(data, i, size, condition, baseAddress, out);
+        }
+
+        // AVX 연산 (float: __m256, double: __m256d)
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Load(const uint8_t* p, float) { return _mm256_loadu_ps(reinterpret_cast<const float*>(p)); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Load(const uint8_t* p, double) { return _mm256_loadu_pd(reinterpret_cast<const double*>(p)); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Set(float v) { return _mm256_set1_ps(v); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Set(double v) { return _mm256_set1_pd(v); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Abs(__m256 v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Abs(__m256d v) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Ge(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Ge(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Le(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Le(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Eq(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Eq(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2And(__m256 a, __m256 b) { return _mm256_and_ps(a, b); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2And(__m256d a, __m256d b) { return _mm256_and_pd(a, b); }
+        SCANCORE_TARGET_AVX2 inline __m256 Avx2Or(__m256 a, __m256 b) { return _mm256_or_ps(a, b); }
+        SCANCORE_TARGET_AVX2 inline __m256d Avx2Or(__m256d a, __m256d b) { return _mm256_or_pd(a, b); }
+        SCANCORE_TARGET_AVX2 inline unsigned Avx2MoveMask(__m256 v) { return static_cast<unsigned>(_mm256_movemask_ps(v)); }
+        SCANCORE_TARGET_AVX2 inline unsigned Avx2MoveMask(__m256d v) { return static_cast<unsigned>(_mm256_movemask_pd(v)); }
+
+        template<typename T>
+        SCANCORE_TARGET_AVX2 inline void ScanFloatAVX2(const uint8_t* data, size_t size, const FloatCondition<T>& condition,
+                                                       uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            using Vec = decltype(Avx2Set(T()));
+            constexpr size_t Block = 32;
+            constexpr size_t Lanes = Block / sizeof(T);
+            const size_t stride = condition.stride;
+            size_t i = FirstStrideOffset(baseAddress, stride);
+            if (!IsVectorStride(stride, Block)) {
+                ScanFloatScalar(data, i, size, condition, baseAddress, out);
+                return;
+            }
+
+            const size_t phases = stride < sizeof(T) ? sizeof(T) / stride : 1;
+            const size_t reach = Block + (phases - 1) * stride;
+            const unsigned laneMask = StrideLaneMask(Lanes, sizeof(T), std::max(stride, sizeof(T)));
+            const Vec low = Avx2Set(condition.low);
+            const Vec high = Avx2Set(condition.high);
+            const Vec tolerance = Avx2Set(condition.tolerance);
+            const Vec minNormal = Avx2Set(std::numeric_limits<T>::min());
+            const Vec zero = Avx2Set(T(0));
+            Vec targets[FloatCondition<T>::MaxValues];
+            for (size_t n = 0; n < condition.valueCount; ++n) targets[n] = Avx2Set(condition.values[n]);
+
+            for (; i + reach <= size; i += Block) {
+                uint32_t hits = 0;
+                for (size_t p = 0; p < phases; ++p) {
+                    Vec x = Avx2Load(data + i + p * stride, T());
+                    Vec match;
+                    if (condition.mode == FloatMatchMode::Range) {
+                        match = Avx2And(Avx2Ge(x, low), Avx2Le(x, high));
+                    } else {
+                        match = Avx2Le(Avx2Abs(Avx2Sub(x, targets[0])), tolerance);
+                        for (size_t n = 1; n < condition.valueCount; ++n) {
+                            match = Avx2Or(match, Avx2Le(Avx2Abs(Avx2Sub(x, targets[n])), tolerance));
+                        }
+                    }
+                    unsigned lanes = Avx2MoveMask(match) & laneMask;
+                    if (lanes && condition.rejectDenormal) {
+                        lanes &= Avx2MoveMask(Avx2Or(Avx2Ge(Avx2Abs(x), minNormal), Avx2Eq(x, zero)));
+                    }
+                    if (lanes) hits |= SpreadLanes(lanes, sizeof(T), p * stride);
+                }
+                EmitHits(hits, baseAddress + i, out);
+            }
+            ScanFloatScalar(data, i, size, condition, baseAddress, out);
+        }
+#endif
+    }
+
+    /**
+     * 버퍼에서 condition을 만족하는 float/double 위치를 찾아 (baseAddress + 오프셋)을 out에 추가합니다.
+     * 결과는 오름차순이며 추가된 개수를 반환합니다. AnyOf 조건에 값이 없으면 아무것도 찾지 않습니다.
+     */
+    template<typename T>
+    size_t FindFloat(const uint8_t* data, size_t size, const FloatCondition<T>& condition, uintptr_t baseAddress,
+                     std::vector<uintptr_t>& out, SimdLevel level = ActiveSimdLevel()) {
+        if (condition.mode == FloatMatchMode::AnyOf && condition.valueCount == 0) return 0;
+        if (condition.stride == 0) return 0;
+        size_t before = out.size();
+#if defined(SCANCORE_X86)
+        if (level == SimdLevel::AVX2) {
+            Detail::ScanFloatAVX2(data, size, condition, baseAddress, out);
+            return out.size() - before;
+        }
+        if (level == SimdLevel::SSE2) {
+            Detail::ScanFloatSSE2(data, size, condition, baseAddress, out);
+            return out.size() - before;
+        }
+#else
+        (void)level;
+#endif
+        Detail::ScanFloatScalar(data, Detail::FirstStrideOffset(baseAddress, condition.stride), size, condition, baseAddress, out);
+        return out.size() - before;
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+/*
+ * 프레임 시간 통계 (이동 창 평균/분산/최소/최대 + 스트리밍 백분위: 1% / 0.1% low, p99)
+ *
+ * 프레임마다 Add(프레임 시간 ms) 한 번. 창(기본 1000프레임) 안의 통계를 창 크기와 무관한 시간에 답합니다.
+ * - 평균/분산/최소/최대: RollingStats (추가 분할 상환 O(1), 조회 O(1))
+ * - 백분위: 로그 간격 버킷 히스토그램 스케치(상대 오차 relativeAccuracy, 기본 0.5%) + 펜윅 트리
+ *   추가/창에서 빠짐은 버킷 하나 ±1 (O(log B)), 백분위 조회는 누적 개수 이진 탐색 (O(log B)), B = 버킷 수 (기본 약 2800)
+ *   창에서 빠지는 값의 버킷은 고정 크기 링 버퍼에 기억해 둠
+ * - 1% low FPS = 1000 / 프레임 시간 p99, 0.1% low = 1000 / p99.9 (벤치마크 도구들의 "가장 느린 1% 프레임" 정의)
+ * 한 스레드에서만 씁니다 (렌더 스레드의 Present 훅 등).
+ *
+ * 사용 예:
+ *   ScanCore::FrameStats frames(1000);
+ *   frames.Add(frameMilliseconds);
+ *   frames.AverageFPS(); frames.LowFPS(0.01); frames.Percentile(0.99);
+ */
+
+#include "RollingStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ScanCore {
+
+    struct FrameStatsConfig {
+        double relativeAccuracy = 0.005;    // 백분위 상대 오차 (버킷 폭)
+        double minimumMilliseconds = 0.01;  // 이보다 짧은 프레임은 첫 버킷
+        double maximumMilliseconds = 10000.0; // 이보다 긴 프레임은 마지막 버킷
+    };
+
+    class FrameStats {
+    public:
+        explicit FrameStats(size_t window = 1000, const FrameStatsConfig& config = FrameStatsConfig())
+            : rolling(window), config(config), buckets(std::max<size_t>(1, window)) {
+            double accuracy = std::min(std::max(config.relativeAccuracy, 1e-4), 0.5);
+            gamma = (1.0 + accuracy) / (1.0 - accuracy);
+            logGamma = std::log(gamma);
+            bucketCount = static_cast<size_t>(std::ceil(std::log(config.maximumMilliseconds / config.minimumMilliseconds) / logGamma)) + 1;
+            tree.assign(bucketCount + 1, 0);
+            // 버킷 [min γ^i, min γ^(i+1))의 대표값: 기하 중간 (양쪽 끝까지 상대 오차 relativeAccuracy 이하)
+            representative.resize(bucketCount);
+            for (size_t i = 0; i < bucketCount; ++i) representative[i] = config.minimumMilliseconds * std::pow(gamma, i + 0.5);
+            top = 1;
+            while (top * 2 <= bucketCount) top *= 2;
+        }
+
+        size_t Window() const { return rolling.Window(); }
+        size_t Count() const { return rolling.Count(); }
+
+        // 프레임 시간 하나 (ms). 0 이하나 유한하지 않은 값은 무시
+        void Add(double milliseconds) {
+            if (!(milliseconds > 0.0) || !std::isfinite(milliseconds)) return;
+            size_t slot = static_cast<size_t>(added % buckets.size());
+            if (added >= buckets.size()) Update(buckets[slot], -1);
+            uint32_t bucket = BucketOf(milliseconds);
+            buckets[slot] = bucket;
+            Update(bucket, +1);
+            rolling.Add(milliseconds);
+            last = milliseconds;
+            ++added;
+        }
+
+        void Reset() {
+            rolling.Reset();
+            std::fill(tree.begin(), tree.end(), 0);
+            added = 0;
+            last = 0.0;
+        }
+
+        // 프레임 시간 (ms), O(1)
+        double Last() const { return last; }
+        double Mean() const { return rolling.Mean(); }
+        double Variance() const { return rolling.Variance(); }
+        double StdDev() const { return std::sqrt(rolling.Variance()); }
+        double Minimum() const { return rolling.Minimum(); }
+        double Maximum() const { return rolling.Maximum(); }
+
+        // 창 안 프레임 시간의 q 분위수 (0~1, ms), O(log B). 상대 오차 relativeAccuracy, 최소/최대를 넘지 않음
+        double Percentile(double q) const {
+            size_t count = Count();
+            if (count == 0) return 0.0;
+            q = std::min(std::max(q, 0.0), 1.0);
+            uint32_t rank = static_cast<uint32_t>(std::max<double>(1.0, std::ceil(q * count)));
+            return std::min(std::max(representative[FindRank(rank)], Minimum()), Maximum());
+        }
+
+        // FPS (창 평균 프레임 시간 기준), O(1)
+        double AverageFPS() const { return Mean() > 0.0 ? 1000.0 / Mean() : 0.0; }
+        double MinimumFPS() const { return Maximum() > 0.0 ? 1000.0 / Maximum() : 0.0; }
+        double MaximumFPS() const { return Minimum() > 0.0 ? 1000.0 / Minimum() : 0.0; }
+
+        // 가장 느린 fraction(0.01 = 1% low, 0.001 = 0.1% low) 프레임 경계의 FPS, O(log B)
+        double LowFPS(double fraction) const {
+            double milliseconds = Percentile(1.0 - fraction);
+            return milliseconds > 0.0 ? 1000.0 / milliseconds : 0.0;
+        }
+
+    private:
+        RollingStats rolling;
+        FrameStatsConfig config;
+        std::vector<uint32_t> buckets;      // 창 안 프레임의 버킷 (added % window)
+        std::vector<uint32_t> tree;         // 버킷별 개수의 펜윅 트리 (1부터)
+        std::vector<double> representative; // 버킷 대표값 (ms)
+        size_t bucketCount = 0;
+        size_t top = 1;                     // bucketCount 이하의 가장 큰 2의 거듭제곱
+        double gamma = 1.0;
+        double logGamma = 0.0;
+        uint64_t added = 0;
+        double last = 0.0;
+
+        uint32_t BucketOf(double milliseconds) const {
+            if (milliseconds <= config.minimumMilliseconds) return 0;
+            double index = std::floor(std::log(milliseconds / config.minimumMilliseconds) / logGamma);
+            return static_cast<uint32_t>(std::min<double>(index, static_cast<double>(bucketCount - 1)));
+        }
+
+        void Update(uint32_t bucket, int delta) {
+            for (size_t i = bucket + 1; i <= bucketCount; i += i & (~i + 1)) tree[i] += delta;
+        }
+
+        // 누적 개수가 rank 이상이 되는 첫 버킷 (펜윅 트리 이진 내려가기)
+        size_t FindRank(uint32_t rank) const {
+            size_t position = 0;
+            for (size_t step = top; step > 0; step >>= 1) {
+                if (position + step <= bucketCount && tree[position + step] < rank) {
+                    position += step;
+                    rank -= tree[position];
+                }
+            }
+            return std::min(position, bucketCount - 1);
+        }
+    };
+}
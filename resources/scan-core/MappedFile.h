@@ -0,0 +1,107 @@
+#pragma once
+/*
+ * 읽기 전용 메모리 매핑 파일
+ *
+ * 포인터 맵처럼 큰 인덱스 파일을 통째로 읽지 않고 주소 공간에 매핑해, 실제로 접근한 페이지만
+ * 운영체제가 올리도록 합니다. 여러 파일을 동시에 열어도 상주 메모리는 접근한 만큼만 늘어납니다.
+ * - Windows: CreateFileMapping / MapViewOfFile
+ * - POSIX: mmap (PROT_READ, MAP_PRIVATE)
+ *
+ * 사용 예:
+ *   ScanCore::MappedFile file;
+ *   if (file.Open("session1.scpm")) parse(file.Data(), file.Size());
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ScanCore {
+
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                Close();
+                data = std::exchange(other.data, nullptr);
+                size = std::exchange(other.size, 0);
+#if defined(_WIN32)
+                mapping = std::exchange(other.mapping, nullptr);
+#endif
+            }
+            return *this;
+        }
+
+        // 빈 파일은 실패로 처리
+        bool Open(const std::string& path) {
+            Close();
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER fileSize;
+            if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping) {
+                    data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                    size = data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+                }
+            }
+            CloseHandle(file);
+            if (!data) Close();
+#else
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat info;
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED) {
+                    data = static_cast<const uint8_t*>(view);
+                    size = static_cast<size_t>(info.st_size);
+                }
+            }
+            close(fd);
+#endif
+            return data != nullptr;
+        }
+
+        void Close() {
+#if defined(_WIN32)
+            if (data) UnmapViewOfFile(data);
+            if (mapping) CloseHandle(mapping);
+            mapping = nullptr;
+#else
+            if (data) munmap(const_cast<uint8_t*>(data), size);
+#endif
+            data = nullptr;
+            size = 0;
+        }
+
+        bool IsOpen() const { return data != nullptr; }
+        const uint8_t* Data() const { return data; }
+        size_t Size() const { return size; }
+
+    private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+#if defined(_WIN32)
+        HANDLE mapping = nullptr;
+#endif
+    };
+}
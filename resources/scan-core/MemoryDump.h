@@ -0,0 +1,232 @@
+#pragma once
+/*
+ * 메모리 덤프 백엔드 (IProcessMemory)
+ *
+ * 영역과 내용을 이 프로세스의 메모리에 들고 있는 IProcessMemory 구현입니다.
+ * - Capture(): 실제 프로세스(IProcessMemory)에서 조건에 맞는 영역을 복사
+ * - Save()/Load(): 단순 덤프 파일로 저장/불러오기
+ * - AddRegion(): 합성 데이터로 직접 구성 (벤치마크, 오프라인 예제)
+ *
+ * 스캐너는 실제 프로세스와 똑같이 영역을 열거하고 읽고 쓸 수 있으므로, 게임 없이도
+ * 같은 스캔 코드를 돌려 결과와 처리량을 확인할 수 있습니다. 쓰기는 복사본만 바꿉니다.
+ * 읽기는 여러 스레드에서 동시에 해도 되지만, 쓰기/보호 변경과 동시에 하면 안 됩니다.
+ *
+ * 파일 형식 (리틀 엔디언):
+ *   "SCMD" u32 버전(1) u64 영역 수
+ *   영역마다: u64 base, u64 size, u32 protection, u32 nativeProtection, u32 type, u32 경로 길이, 경로, 내용(size 바이트)
+ */
+
+#include "ProcessMemory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    class MemoryDump : public IProcessMemory {
+    public:
+        static constexpr uint32_t FileVersion = 1;
+
+        // 영역 추가 (기존 영역과 겹치면 실패). data.size()가 영역 크기
+        bool AddRegion(MemoryRegion region, std::vector<uint8_t> data) {
+            region.size = data.size();
+            if (region.size == 0) return false;
+
+            auto it = std::lower_bound(regions.begin(), regions.end(), region.base,
+                                       [](const StoredRegion& stored, uintptr_t base) { return stored.info.base < base; });
+            if (it != regions.end() && it->info.base < region.base + region.size) return false;
+            if (it != regions.begin() && std::prev(it)->info.base + std::prev(it)->info.size > region.base) return false;
+
+            regions.insert(it, StoredRegion{region, std::move(data)});
+            return true;
+        }
+
+        // source에서 accept(영역)이 true인 영역을 복사. 읽을 수 없는 부분은 영역을 나누어 건너뜀
+        template<typename Filter>
+        static MemoryDump Capture(IProcessMemory& source, Filter accept, size_t chunkSize = 1024 * 1024) {
+            MemoryDump dump;
+            std::vector<uint8_t> chunk(chunkSize);
+            for (const MemoryRegion& region : source.EnumerateRegions()) {
+                if (!accept(region)) continue;
+
+                MemoryRegion piece = region;
+                std::vector<uint8_t> data;
+                for (size_t offset = 0; offset < region.size; offset += chunkSize) {
+                    size_t size = std::min(chunkSize, region.size - offset);
+                    size_t bytesRead = 0;
+                    bool ok = source.ReadBytes(region.base + offset, chunk.data(), size, bytesRead) && bytesRead == size;
+                    if (ok) {
+                        if (data.empty()) piece.base = region.base + offset;
+                        data.insert(data.end(), chunk.begin(), chunk.begin() + size);
+                    } else if (!data.empty()) {
+                        dump.AddRegion(piece, std::move(data));
+                        data.clear();
+                    }
+                }
+                if (!data.empty()) dump.AddRegion(piece, std::move(data));
+            }
+            return dump;
+        }
+
+        size_t RegionCount() const { return regions.size(); }
+
+        size_t TotalSize() const {
+            size_t total = 0;
+            for (const StoredRegion& region : regions) total += region.data.size();
+            return total;
+        }
+
+        void Clear() { regions.clear(); }
+
+        bool Save(const std::string& path) const {
+            std::ofstream file(path, std::ios::binary);
+            if (!file) return false;
+
+            file.write("SCMD", 4);
+            WritePod(file, FileVersion);
+            WritePod(file, static_cast<uint64_t>(regions.size()));
+            for (const StoredRegion& region : regions) {
+                WritePod(file, static_cast<uint64_t>(region.info.base));
+                WritePod(file, static_cast<uint64_t>(region.data.size()));
+                WritePod(file, region.info.protection);
+                WritePod(file, region.info.nativeProtection);
+                WritePod(file, static_cast<uint32_t>(region.info.type));
+                WritePod(file, static_cast<uint32_t>(region.info.path.size()));
+                file.write(region.info.path.data(), static_cast<std::streamsize>(region.info.path.size()));
+                file.write(reinterpret_cast<const char*>(region.data.data()), static_cast<std::streamsize>(region.data.size()));
+            }
+            return static_cast<bool>(file);
+        }
+
+        bool Load(const std::string& path) {
+            regions.clear();
+            std::ifstream file(path, std::ios::binary);
+            if (!file) return false;
+
+            char magic[4] = {};
+            uint32_t version = 0;
+            uint64_t count = 0;
+            file.read(magic, 4);
+            if (!file || memcmp(magic, "SCMD", 4) != 0 || !ReadPod(file, version) || version != FileVersion || !ReadPod(file, count)) {
+                return false;
+            }
+
+            for (uint64_t i = 0; i < count; ++i) {
+                uint64_t base = 0, size = 0;
+                uint32_t type = 0, pathLength = 0;
+                MemoryRegion region;
+                if (!ReadPod(file, base) || !ReadPod(file, size) || !ReadPod(file, region.protection) ||
+                    !ReadPod(file, region.nativeProtection) || !ReadPod(file, type) || !ReadPod(file, pathLength)) {
+                    regions.clear();
+                    return false;
+                }
+                region.base = static_cast<uintptr_t>(base);
+                region.type = static_cast<MemoryRegionType>(type);
+                region.path.resize(pathLength);
+                file.read(&region.path[0], pathLength);
+
+                std::vector<uint8_t> data(static_cast<size_t>(size));
+                file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size));
+                if (!file || !AddRegion(region, std::move(data))) {
+                    regions.clear();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::vector<MemoryRegion> EnumerateRegions() override {
+            std::vector<MemoryRegion> result;
+            result.reserve(regions.size());
+            for (const StoredRegion& region : regions) result.push_back(region.info);
+            return result;
+        }
+
+        // 붙어 있는 영역에 걸친 읽기도 이어서 처리. 영역 밖에 닿으면 거기까지 읽고 실패
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            bytesRead = 0;
+            return Access(address, size, [&](StoredRegion& region, size_t offset, size_t length) {
+                memcpy(static_cast<uint8_t*>(buffer) + bytesRead, region.data.data() + offset, length);
+                bytesRead += length;
+            });
+        }
+
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            bytesWritten = 0;
+            return Access(address, size, [&](StoredRegion& region, size_t offset, size_t length) {
+                memcpy(region.data.data() + offset, static_cast<const uint8_t*>(data) + bytesWritten, length);
+                bytesWritten += length;
+            });
+        }
+
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override {
+            StoredRegion* region = FindStored(address);
+            if (!region) return false;
+            result = region->info;
+            return true;
+        }
+
+        // 영역 단위로만 기록 (덤프에는 페이지 단위 보호가 없음)
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            StoredRegion* region = FindStored(address);
+            if (!region || !region->info.Contains(address, size == 0 ? 1 : size)) return false;
+            oldProtection = region->info.protection;
+            region->info.protection = protection;
+            return true;
+        }
+
+        // 영역 내용에 직접 접근 (없으면 nullptr)
+        const uint8_t* RegionData(uintptr_t base) const {
+            for (const StoredRegion& region : regions) {
+                if (region.info.base == base) return region.data.data();
+            }
+            return nullptr;
+        }
+
+    private:
+        struct StoredRegion {
+            MemoryRegion info;
+            std::vector<uint8_t> data;
+        };
+
+        std::vector<StoredRegion> regions;  // base 오름차순, 겹치지 않음
+
+        StoredRegion* FindStored(uintptr_t address) {
+            auto it = std::upper_bound(regions.begin(), regions.end(), address,
+                                       [](uintptr_t value, const StoredRegion& stored) { return value < stored.info.base; });
+            if (it == regions.begin()) return nullptr;
+            --it;
+            return it->info.Contains(address) ? &*it : nullptr;
+        }
+
+        template<typename Visit>
+        bool Access(uintptr_t address, size_t size, Visit visit) {
+            size_t done = 0;
+            while (done < size) {
+                StoredRegion* region = FindStored(address + done);
+                if (!region) return false;
+                size_t offset = address + done - region->info.base;
+                size_t length = std::min(size - done, region->data.size() - offset);
+                visit(*region, offset, length);
+                done += length;
+            }
+            return true;
+        }
+
+        template<typename T>
+        static void WritePod(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        static bool ReadPod(std::ifstream& file, T& value) {
+            file.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return static_cast<bool>(file);
+        }
+    };
+}
@@ -0,0 +1,387 @@
+#pragma once
+/*
+ * 모든 타입 값 스캔 (int8/16/32/64, float, double을 한 번에)
+ *
+ * 값이 어떤 타입으로 저장됐는지 모를 때 타입마다 ScanMemory<T>를 돌리면 메모리를 타입 수만큼 다시 읽습니다.
+ * 여기서는 청크를 한 번 읽고, 블록마다 (i + j) 위치의 로드 8개(j = 0..7)를 모든 타입이 함께 씁니다.
+ * - 정수: 리틀 엔디언에서는 좁은 타입의 바이트열이 넓은 타입의 앞부분입니다 (100 = 64 / 64 00 / 64 00 00 00 / ...).
+ *   int8 → int16 → int32 → int64 순서로 바이트 비교를 이어서 AND 하고, 중간 결과가 0이면 넓은 타입을 건너뜁니다.
+ * - float/double: 로드 j를 실수 레인으로 보고 |x - value| <= tolerance 비교 (float는 위상 4개, double은 8개)
+ * 값이 타입 범위를 벗어나면 그 타입은 검사하지 않습니다. 정수는 부호 있는/없는 범위 중 하나에 들면 검사합니다.
+ * 기본적으로 모든 바이트 위치를 보고하며, aligned면 주소가 타입 크기의 배수인 위치만 봅니다.
+ *
+ * 타입별 결과는 ScanKernels::FindExact(정수) / FindFloat(Near, stride 1)와 같습니다.
+ * 결과는 TypedResultStore에 담기고, 다음 스캔은 후보마다 자기 타입으로 비교합니다.
+ *
+ * 사용 예:
+ *   ScanCore::MultiTypeQuery query;
+ *   if (ScanCore::ParseMultiTypeQuery("100", 0.01, query)) {
+ *       ScanCore::TypedResultStore results = ScanCore::ScanAllTypes(executor, ranges, readFn, query);
+ *   }
+ */
+
+#include "FloatScanKernels.h"
+#include "ScanExecutor.h"
+#include "TypedResultStore.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    constexpr ValueTypeMask IntegerValueTypes = ValueTypeBit(ValueType::Int8) | ValueTypeBit(ValueType::Int16) |
+                                                ValueTypeBit(ValueType::Int32) | ValueTypeBit(ValueType::Int64);
+
+    // int8은 작은 값이면 후보가 너무 많아 기본적으로 제외
+    constexpr ValueTypeMask DefaultMultiTypes = AllValueTypes & ~ValueTypeBit(ValueType::Int8);
+
+    struct MultiTypeQuery {
+        ValueTypeMask types = DefaultMultiTypes;
+        bool hasInteger = false;    // 값이 정수로 표현되면 정수 타입도 검사
+        int64_t integer = 0;
+        double real = 0;
+        double tolerance = 0;       // float/double: |x - real| <= tolerance
+        bool aligned = false;       // 주소가 타입 크기의 배수인 위치만
+        bool rejectDenormal = true;
+
+        static MultiTypeQuery FromInteger(int64_t value) {
+            MultiTypeQuery query;
+            query.hasInteger = true;
+            query.integer = value;
+            query.real = static_cast<double>(value);
+            return query;
+        }
+
+        // 정수로 정확히 표현되는 실수(100.0 등)는 정수 타입도 검사
+        static MultiTypeQuery FromReal(double value, double tolerance = 0) {
+            MultiTypeQuery query;
+            query.real = value;
+            query.tolerance = tolerance;
+            if (std::isfinite(value) && std::trunc(value) == value && value >= -9223372036854775808.0 &&
+                value < 9223372036854775808.0) {
+                query.hasInteger = true;
+                query.integer = static_cast<int64_t>(value);
+            }
+            return query;
+        }
+
+        // 실제로 검사할 타입: types 중 값이 범위에 드는 타입
+        ValueTypeMask ActiveTypes() const {
+            ValueTypeMask active = 0;
+            if (hasInteger) {
+                if (integer >= -128 && integer <= 255) active |= ValueTypeBit(ValueType::Int8);
+                if (integer >= -32768 && integer <= 65535) active |= ValueTypeBit(ValueType::Int16);
+                if (integer >= -2147483648LL && integer <= 4294967295LL) active |= ValueTypeBit(ValueType::Int32);
+                active |= ValueTypeBit(ValueType::Int64);
+            }
+            if (std::isfinite(real) && !std::isnan(tolerance) && tolerance >= 0) {
+                if (std::fabs(real) <= std::numeric_limits<float>::max()) active |= ValueTypeBit(ValueType::Float);
+                active |= ValueTypeBit(ValueType::Double);
+            }
+            return active & types;
+        }
+
+        // 정수 값의 리틀 엔디언 바이트 (좁은 타입은 앞부분)
+        void IntegerBytes(uint8_t bytes[8]) const {
+            uint64_t bits = static_cast<uint64_t>(integer);
+            for (size_t j = 0; j < 8; ++j) bytes[j] = static_cast<uint8_t>(bits >> (8 * j));
+        }
+
+        // 기준 구현 (SIMD 커널과 결과가 같아야 함). p에서 ValueTypeSize(type) 바이트를 읽음
+        bool Matches(ValueType type, const uint8_t* p) const {
+            switch (type) {
+                case ValueType::Float: {
+                    float x = Detail::LoadUnaligned<float>(p);
+                    if (rejectDenormal && std::fpclassify(x) == FP_SUBNORMAL) return false;
+                    return std::fabs(x - static_cast<float>(real)) <= static_cast<float>(tolerance);
+                }
+                case ValueType::Double: {
+                    double x = Detail::LoadUnaligned<double>(p);
+                    if (rejectDenormal && std::fpclassify(x) == FP_SUBNORMAL) return false;
+                    return std::fabs(x - real) <= tolerance;
+                }
+                default: {
+                    uint8_t bytes[8];
+                    IntegerBytes(bytes);
+                    return memcmp(p, bytes, ValueTypeSize(type)) == 0;
+                }
+            }
+        }
+    };
+
+    /**
+     * 사용자 입력을 검색 조건으로 변환합니다. "100", "-5", "0x64"는 정수(와 같은 실수), "1.5", "1e3"은 실수.
+     * tolerance는 float/double 비교에만 쓰입니다. 숫자가 아니면 false
+     */
+    inline bool ParseMultiTypeQuery(const std::string& text, double tolerance, MultiTypeQuery& query) {
+        if (text.empty()) return false;
+        const char* begin = text.c_str();
+        char* end = nullptr;
+        errno = 0;
+        long long integer = std::strtoll(begin, &end, 0);
+        if (errno == 0 && end != begin && *end == '\0') {
+            query = MultiTypeQuery::FromInteger(integer);
+            query.tolerance = tolerance;
+            return true;
+        }
+        errno = 0;
+        double real = std::strtod(begin, &end);
+        if (errno != 0 || end == begin || *end != '\0' || !std::isfinite(real)) return false;
+        query = MultiTypeQuery::FromReal(real, tolerance);
+        return true;
+    }
+
+    // 타입별 일치 주소 (타입마다 오름차순)
+    struct TypedHits {
+        std::vector<uintptr_t> byType[ValueTypeCount];
+
+        void Clear() {
+            for (std::vector<uintptr_t>& hits : byType) hits.clear();
+        }
+
+        size_t Count() const {
+            size_t total = 0;
+            for (const std::vector<uintptr_t>& hits : byType) total += hits.size();
+            return total;
+        }
+    };
+
+    namespace Detail {
+
+        inline void ScanAllTypesScalar(const uint8_t* data, size_t begin, size_t size, const MultiTypeQuery& query,
+                                       ValueTypeMask active, uintptr_t baseAddress, TypedHits& out) {
+            for (size_t i = begin; i < size; ++i) {
+                for (size_t t = 0; t < ValueTypeCount; ++t) {
+                    ValueType type = static_cast<ValueType>(t);
+                    size_t width = ValueTypeSize(type);
+                    if (!(active & ValueTypeBit(type)) || i + width > size) continue;
+                    if (query.aligned && (baseAddress + i) % width != 0) continue;
+                    if (query.Matches(type, data + i)) out.byType[t].push_back(baseAddress + i);
+                }
+            }
+        }
+
+        // 블록(block 바이트, 8의 배수) 안에서 주소가 width의 배수인 바이트 위치 비트.
+        // 블록 시작 오프셋이 block의 배수이므로 모든 블록에 같은 마스크를 씀
+        inline uint32_t AlignedPositionMask(uintptr_t baseAddress, size_t width, size_t block, bool aligned) {
+            uint32_t mask = 0;
+            for (size_t b = 0; b < block; ++b) {
+                if (!aligned || (baseAddress + b) % width == 0) mask |= 1u << b;
+            }
+            return mask;
+        }
+
+        // 정수 체인의 너비별 타입 (1, 2, 4, 8바이트)
+        inline size_t IntegerTypeIndex(size_t width) {
+            return static_cast<size_t>(width == 1 ? ValueType::Int8 : width == 2 ? ValueType::Int16 :
+                                       width == 4 ? ValueType::Int32 : ValueType::Int64);
+        }
+
+#if defined(SCANCORE_X86)
+        inline void ScanAllTypesSSE2(const uint8_t* data, size_t size, const MultiTypeQuery& query, ValueTypeMask active,
+                                     uintptr_t baseAddress, TypedHits& out) {
+            constexpr size_t Block = 16;
+            uint8_t bytes[8];
+            query.IntegerBytes(bytes);
+            __m128i needle[8];
+            for (size_t j = 0; j < 8; ++j) needle[j] = _mm_set1_epi8(static_cast<char>(bytes[j]));
+
+            uint32_t positions[ValueTypeCount];
+            for (size_t t = 0; t < ValueTypeCount; ++t) {
+                ValueType type = static_cast<ValueType>(t);
+                positions[t] = (active & ValueTypeBit(type)) ? AlignedPositionMask(baseAddress, ValueTypeSize(type), Block, query.aligned) : 0;
+            }
+            const bool anyInteger = (active & IntegerValueTypes) != 0;
+            const __m128 floatTarget = _mm_set1_ps(static_cast<float>(query.real));
+            const __m128 floatTolerance = _mm_set1_ps(static_cast<float>(query.tolerance));
+            const __m128 floatMinNormal = _mm_set1_ps(std::numeric_limits<float>::min());
+            const __m128d doubleTarget = _mm_set1_pd(query.real);
+            const __m128d doubleTolerance = _mm_set1_pd(query.tolerance);
+            const __m128d doubleMinNormal = _mm_set1_pd(std::numeric_limits<double>::min());
+
+            size_t i = 0;
+            for (; i + Block + 7 <= size; i += Block) {
+                const uint8_t* p = data + i;
+                __m128i loads[8];
+                for (size_t j = 0; j < 8; ++j) loads[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + j));
+                uint32_t hits[ValueTypeCount] = {};
+
+                if (anyInteger) {
+                    __m128i equal = _mm_cmpeq_epi8(loads[0], needle[0]);
+                    uint32_t match = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+                    hits[IntegerTypeIndex(1)] = match;
+                    for (size_t width = 2; match && width <= 8; width *= 2) {
+                        for (size_t j = width / 2; j < width; ++j) equal = _mm_and_si128(equal, _mm_cmpeq_epi8(loads[j], needle[j]));
+                        match = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+                        hits[IntegerTypeIndex(width)] = match;
+                    }
+                }
+                if (positions[static_cast<size_t>(ValueType::Float)]) {
+                    uint32_t& floatHits = hits[static_cast<size_t>(ValueType::Float)];
+                    for (size_t j = 0; j < 4; ++j) {
+                        __m128 x = _mm_castsi128_ps(loads[j]);
+                        unsigned lanes = Sse2MoveMask(Sse2Le(Sse2Abs(Sse2Sub(x, floatTarget)), floatTolerance));
+                        if (lanes && query.rejectDenormal) {
+                            lanes &= Sse2MoveMask(Sse2Or(Sse2Ge(Sse2Abs(x), floatMinNormal), Sse2Eq(x, _mm_setzero_ps())));
+                        }
+                        if (lanes) floatHits |= SpreadLanes(lanes, 4, j);
+                    }
+                }
+                if (positions[static_cast<size_t>(ValueType::Double)]) {
+                    uint32_t& doubleHits = hits[static_cast<size_t>(ValueType::Double)];
+                    for (size_t j = 0; j < 8; ++j) {
+                        __m128d x = _mm_castsi128_pd(loads[j]);
+                        unsigned lanes = Sse2MoveMask(Sse2Le(Sse2Abs(Sse2Sub(x, doubleTarget)), doubleTolerance));
+                        if (lanes && query.rejectDenormal) {
+                            lanes &= Sse2MoveMask(Sse2Or(Sse2Ge(Sse2Abs(x), doubleMinNormal), Sse2Eq(x, _mm_setzero_pd())));
+                        }
+                        if (lanes) doubleHits |= SpreadLanes(lanes, 8, j);
+                    }
+                }
+
+                for (size_t t = 0; t < ValueTypeCount; ++t) {
+                    uint32_t bits = hits[t] & positions[t];
+                    if (bits) EmitHits(bits, baseAddress + i, out.byType[t]);
+                }
+            }
+            ScanAllTypesScalar(data, i, size, query, active, baseAddress, out);
+        }
+
+        SCANCORE_TARGET_AVX2 inline void ScanAllTypesAVX2(const uint8_t* data, size_t size, const MultiTypeQuery& query,
+                                                          ValueTypeMask active, uintptr_t baseAddress, TypedHits& out) {
+            constexpr size_t Block = 32;
+            uint8_t bytes[8];
+            query.IntegerBytes(bytes);
+            __m256i needle[8];
+            for (size_t j = 0; j < 8; ++j) needle[j] = _mm256_set1_epi8(static_cast<char>(bytes[j]));
+
+            uint32_t positions[ValueTypeCount];
+            for (size_t t = 0; t < ValueTypeCount; ++t) {
+                ValueType type = static_cast<ValueType>(t);
+                positions[t] = (active & ValueTypeBit(type)) ? AlignedPositionMask(baseAddress, ValueTypeSize(type), Block, query.aligned) : 0;
+            }
+            const bool anyInteger = (active & IntegerValueTypes) != 0;
+            const __m256 floatTarget = _mm256_set1_ps(static_cast<float>(query.real));
+            const __m256 floatTolerance = _mm256_set1_ps(static_cast<float>(query.tolerance));
+            const __m256 floatMinNormal = _mm256_set1_ps(std::numeric_limits<float>::min());
+            const __m256d doubleTarget = _mm256_set1_pd(query.real);
+            const __m256d doubleTolerance = _mm256_set1_pd(query.tolerance);
+            const __m256d doubleMinNormal = _mm256_set1_pd(std::numeric_limits<double>::min());
+
+            size_t i = 0;
+            for (; i + Block + 7 <= size; i += Block) {
+                const uint8_t* p = data + i;
+                __m256i loads[8];
+                for (size_t j = 0; j < 8; ++j) loads[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + j));
+                uint32_t hits[ValueTypeCount] = {};
+
+                if (anyInteger) {
+                    __m256i equal = _mm256_cmpeq_epi8(loads[0], needle[0]);
+                    uint32_t match = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+                    hits[IntegerTypeIndex(1)] = match;
+                    for (size_t width = 2; match && width <= 8; width *= 2) {
+                        for (size_t j = width / 2; j < width; ++j) equal = _mm256_and_si256(equal, _mm256_cmpeq_epi8(loads[j], needle[j]));
+                        match = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+                        hits[IntegerTypeIndex(width)] = match;
+                    }
+                }
+                if (positions[static_cast<size_t>(ValueType::Float)]) {
+                    uint32_t& floatHits = hits[static_cast<size_t>(ValueType::Float)];
+                    for (size_t j = 0; j < 4; ++j) {
+                        __m256 x = _mm256_castsi256_ps(loads[j]);
+                        unsigned lanes = Avx2MoveMask(Avx2Le(Avx2Abs(Avx2Sub(x, floatTarget)), floatTolerance));
+                        if (lanes && query.rejectDenormal) {
+                            lanes &= Avx2MoveMask(Avx2Or(Avx2Ge(Avx2Abs(x), floatMinNormal), Avx2Eq(x, _mm256_setzero_ps())));
+                        }
+                        if (lanes) floatHits |= SpreadLanes(lanes, 4, j);
+                    }
+                }
+                if (positions[static_cast<size_t>(ValueType::Double)]) {
+                    uint32_t& doubleHits = hits[static_cast<size_t>(ValueType::Double)];
+                    for (size_t j = 0; j < 8; ++j) {
+                        __m256d x = _mm256_castsi256_pd(loads[j]);
+                        unsigned lanes = Avx2MoveMask(Avx2Le(Avx2Abs(Avx2Sub(x, doubleTarget)), doubleTolerance));
+                        if (lanes && query.rejectDenormal) {
+                            lanes &= Avx2MoveMask(Avx2Or(Avx2Ge(Avx2Abs(x), doubleMinNormal), Avx2Eq(x, _mm256_setzero_pd())));
+                        }
+                        if (lanes) doubleHits |= SpreadLanes(lanes, 8, j);
+                    }
+                }
+
+                for (size_t t = 0; t < ValueTypeCount; ++t) {
+                    uint32_t bits = hits[t] & positions[t];
+                    if (bits) EmitHits(bits, baseAddress + i, out.byType[t]);
+                }
+            }
+            ScanAllTypesScalar(data, i, size, query, active, baseAddress, out);
+        }
+#endif
+    }
+
+    /**
+     * 버퍼에서 query의 모든 활성 타입을 한 번에 찾아 (baseAddress + 오프셋)을 타입별로 out에 추가합니다.
+     * 타입별 결과는 오름차순이며 추가된 전체 개수를 반환합니다.
+     */
+    inline size_t FindAllTypes(const uint8_t* data, size_t size, const MultiTypeQuery& query, uintptr_t baseAddress,
+                               TypedHits& out, SimdLevel level = ActiveSimdLevel()) {
+        ValueTypeMask active = query.ActiveTypes();
+        if (active == 0) return 0;
+        size_t before = out.Count();
+#if defined(SCANCORE_X86)
+        if (level == SimdLevel::AVX2) {
+            Detail::ScanAllTypesAVX2(data, size, query, active, baseAddress, out);
+            return out.Count() - before;
+        }
+        if (level == SimdLevel::SSE2) {
+            Detail::ScanAllTypesSSE2(data, size, query, active, baseAddress, out);
+            return out.Count() - before;
+        }
+#else
+        (void)level;
+#endif
+        Detail::ScanAllTypesScalar(data, 0, size, query, active, baseAddress, out);
+        return out.Count() - before;
+    }
+
+    /**
+     * ranges 전체를 executor로 한 번 읽으며 모든 활성 타입을 찾아 타입별 저장소에 담습니다 (찾은 시점의 값 포함).
+     * 작업 단위 경계에 걸친 값도 찾도록 executor의 overlap을 7바이트(가장 넓은 타입 - 1)로 설정합니다.
+     */
+    inline TypedResultStore ScanAllTypes(ScanExecutor& executor, const std::vector<MemoryRange>& ranges,
+                                         const ScanExecutor::ReadFunction& read, const MultiTypeQuery& query) {
+        executor.SetOverlap(sizeof(uint64_t) - 1);
+        std::vector<TypedResultStore> fragments = executor.RunUnits<TypedResultStore>(ranges, read,
+            [&query](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, TypedResultStore& fragment) {
+                thread_local TypedHits hits;
+                hits.Clear();
+                FindAllTypes(data, size, query, unit.base, hits);
+
+                for (size_t t = 0; t < ValueTypeCount; ++t) {
+                    ValueType type = static_cast<ValueType>(t);
+                    if (hits.byType[t].empty()) continue;
+                    ScanResultStore::Builder builder(ValueTypeSize(type));
+                    for (uintptr_t address : hits.byType[t]) {
+                        if (address >= unit.base + unit.size) break;
+                        builder.Append(address, data + (address - unit.base));
+                    }
+                    fragment.SetStore(type, builder.Finish());
+                }
+            });
+
+        TypedResultStore merged;
+        for (size_t t = 0; t < ValueTypeCount; ++t) {
+            ValueType type = static_cast<ValueType>(t);
+            ScanResultStore::Builder builder(ValueTypeSize(type));
+            for (const TypedResultStore& fragment : fragments) builder.Append(fragment.Store(type));
+            merged.SetStore(type, builder.Finish());
+        }
+        return merged;
+    }
+}
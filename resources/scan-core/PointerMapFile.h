@@ -0,0 +1,531 @@
+#pragma once
+/*
+ * 포인터 맵 파일과 세션 간 포인터 경로 교차 검증
+ *
+ * 포인터 스캔 결과는 게임을 여러 번 다시 시작하며 얻은 결과를 교차해야 믿을 수 있습니다.
+ * - PointerMapFile::Write(): PointerMap을 목표 주소, 모듈 표와 함께 파일로 저장
+ * - MappedPointerMap: 파일을 메모리 매핑해 PointerMap과 같은 ForEachPointerTo()로 조회
+ *   (BasicPointerScanner<MappedPointerMap>으로 저장된 맵에서 다시 경로 생성 가능)
+ * - WritePointerPathList() / PointerPathListReader: 정렬된 텍스트 경로 목록
+ * - PointerPathIntersector: N개의 맵과 M개의 경로 목록을 교차. 목록은 한 줄씩 병합하고 맵은 매핑만 하므로
+ *   전체를 RAM에 올리지 않음. M개 목록에 모두 있고 N개 맵 모두에서 각 맵의 목표로 이어지는 경로만 남김
+ *
+ * 파일 형식 (리틀 엔디언, 모든 표는 8바이트 정렬):
+ *   헤더 64바이트: "SCPM" u32 버전(1) u32 포인터 크기 u32 모듈 수 u64 목표 주소 u64 항목 수
+ *                 u64 영역 수 u64 버킷 수 u64 블록 수 u64 압축 데이터 크기
+ *   모듈 표: u64 base, u64 size, u32 이름 위치, u32 이름 길이
+ *   영역 표: u64 오프셋, u64 크기, u64 첫 슬롯 번호, u32 모듈 번호(없으면 0xFFFFFFFF), u32 예약
+ *            (모듈 안 영역은 모듈 기준 오프셋, 아니면 절대 주소)
+ *   버킷 표 (버킷 수 + 1): u32 값 상위 32비트, u32 예약, u64 첫 블록 번호
+ *   블록 표: u32 첫 항목 값 하위 32비트, u32 항목 수(최대 128), u64 압축 데이터 안 위치
+ *   압축 데이터: 블록마다 항목별 varint(값 하위 32비트 증가분), varint(슬롯 번호 또는 값이 같으면 슬롯 증가분)
+ *   모듈 이름 문자열
+ *
+ * 경로 목록 형식: 한 줄에 "모듈<TAB>baseOffset<TAB>오프셋,오프셋,..." (16진수), 문자열 오름차순. '#' 줄은 주석
+ *
+ * 사용 예:
+ *   ScanCore::PointerMapFile::Write("session1.scpm", map, modules, fpsAddress);
+ *   ScanCore::WritePointerPathList("session1.txt", scanner.FindPaths(fpsAddress));
+ *   ...
+ *   ScanCore::PointerPathIntersector intersector;
+ *   intersector.AddMap("session1.scpm");
+ *   intersector.AddMap("session2.scpm");
+ *   intersector.Intersect({"session1.txt"}, "stable.txt");
+ */
+
+#include "MappedFile.h"
+#include "PointerScanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    class PointerMapFile {
+    public:
+        static constexpr uint32_t FileVersion = 1;
+        static constexpr uint32_t NoModule = 0xFFFFFFFF;
+        static constexpr size_t BlockEntries = 128;
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t pointerSize;
+            uint32_t moduleCount;
+            uint64_t target;
+            uint64_t entryCount;
+            uint64_t rangeCount;
+            uint64_t bucketCount;
+            uint64_t blockCount;
+            uint64_t payloadSize;
+        };
+
+        struct ModuleRecord {
+            uint64_t base;
+            uint64_t size;
+            uint32_t nameOffset;
+            uint32_t nameLength;
+        };
+
+        struct RangeRecord {
+            uint64_t offset;
+            uint64_t size;
+            uint64_t slotStart;
+            uint32_t module;
+            uint32_t reserved;
+        };
+
+        struct BucketRecord {
+            uint32_t high;
+            uint32_t reserved;
+            uint64_t firstBlock;
+        };
+
+        struct BlockRecord {
+            uint32_t firstLow;
+            uint32_t count;
+            uint64_t offset;
+        };
+
+        // map을 파일로 저장. target은 이 세션에서 찾은 목표 주소 (교차 검증 기준)
+        static bool Write(const std::string& path, const PointerMap& map, const std::vector<PointerModule>& modules,
+                          uintptr_t target) {
+            const std::vector<MemoryRange>& ranges = map.ScannedRanges();
+            std::vector<PointerModule> sortedModules = modules;
+            std::sort(sortedModules.begin(), sortedModules.end(),
+                      [](const PointerModule& a, const PointerModule& b) { return a.base < b.base; });
+
+            std::vector<ModuleRecord> moduleRecords;
+            std::string names;
+            for (const PointerModule& module : sortedModules) {
+                moduleRecords.push_back({module.base, module.size, static_cast<uint32_t>(names.size()),
+                                         static_cast<uint32_t>(module.name.size())});
+                names += module.name;
+            }
+
+            std::vector<RangeRecord> rangeRecords;
+            uint64_t slot = 0;
+            for (const MemoryRange& range : ranges) {
+                RangeRecord record{range.base, range.size, slot, NoModule, 0};
+                for (uint32_t m = 0; m < sortedModules.size(); ++m) {
+                    if (sortedModules[m].Contains(range.base)) {
+                        record.module = m;
+                        record.offset = range.base - sortedModules[m].base;
+                        break;
+                    }
+                }
+                rangeRecords.push_back(record);
+                slot += range.size / map.PointerSize();
+            }
+
+            // 값 순서로 항목을 꺼내 버킷/블록 단위로 압축
+            std::vector<BucketRecord> buckets;
+            std::vector<BlockRecord> blocks;
+            std::vector<uint8_t> payload;
+            uint32_t previousLow = 0;
+            uint64_t previousSlot = 0;
+            map.ForEachPointerTo(0, UINTPTR_MAX, [&](uintptr_t value, uintptr_t location) {
+                uint32_t high = static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32);
+                uint32_t low = static_cast<uint32_t>(value);
+                if (buckets.empty() || buckets.back().high != high) {
+                    buckets.push_back({high, 0, blocks.size()});
+                    blocks.push_back({low, 0, payload.size()});
+                } else if (blocks.back().count == BlockEntries) {
+                    blocks.push_back({low, 0, payload.size()});
+                }
+                if (blocks.back().count == 0) {
+                    previousLow = low;
+                    previousSlot = 0;
+                }
+
+                auto range = std::upper_bound(ranges.begin(), ranges.end(), location,
+                                              [](uintptr_t a, const MemoryRange& r) { return a < r.base; }) - 1;
+                uint64_t entrySlot = rangeRecords[static_cast<size_t>(range - ranges.begin())].slotStart +
+                                     (location - range->base) / map.PointerSize();
+                uint32_t delta = low - previousLow;
+                PutVarint(payload, delta);
+                PutVarint(payload, delta == 0 ? entrySlot - previousSlot : entrySlot);
+                previousLow = low;
+                previousSlot = entrySlot;
+                ++blocks.back().count;
+                return true;
+            });
+            buckets.push_back({0, 0, blocks.size()});
+
+            Header header = {};
+            memcpy(header.magic, "SCPM", 4);
+            header.version = FileVersion;
+            header.pointerSize = static_cast<uint32_t>(map.PointerSize());
+            header.moduleCount = static_cast<uint32_t>(moduleRecords.size());
+            header.target = target;
+            header.entryCount = map.EntryCount();
+            header.rangeCount = rangeRecords.size();
+            header.bucketCount = buckets.size() - 1;
+            header.blockCount = blocks.size();
+            header.payloadSize = payload.size();
+
+            std::ofstream file(path, std::ios::binary);
+            if (!file) return false;
+            WriteArray(file, &header, 1);
+            WriteArray(file, moduleRecords.data(), moduleRecords.size());
+            WriteArray(file, rangeRecords.data(), rangeRecords.size());
+            WriteArray(file, buckets.data(), buckets.size());
+            WriteArray(file, blocks.data(), blocks.size());
+            WriteArray(file, payload.data(), payload.size());
+            file.write(names.data(), static_cast<std::streamsize>(names.size()));
+            return static_cast<bool>(file);
+        }
+
+        static void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        static uint64_t GetVarint(const uint8_t*& p) {
+            uint64_t value = 0;
+            for (int shift = 0;; shift += 7) {
+                uint8_t byte = *p++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+        }
+
+    private:
+        template<typename T>
+        static void WriteArray(std::ofstream& file, const T* data, size_t count) {
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+    };
+
+    // 메모리 매핑한 포인터 맵 파일 (읽기 전용). 조회할 때 필요한 블록만 풀어서 읽음
+    class MappedPointerMap {
+    public:
+        bool Open(const std::string& path) {
+            modules.clear();
+            if (!file.Open(path) || file.Size() < sizeof(PointerMapFile::Header)) return false;
+
+            memcpy(&header, file.Data(), sizeof(header));
+            if (memcmp(header.magic, "SCPM", 4) != 0 || header.version != PointerMapFile::FileVersion ||
+                (header.pointerSize != 4 && header.pointerSize != 8)) {
+                file.Close();
+                return false;
+            }
+
+            // 표 위치 계산과 크기 검증 (잘린 파일은 거부)
+            size_t offset = sizeof(header);
+            moduleTable = Table<PointerMapFile::ModuleRecord>(offset, header.moduleCount);
+            rangeTable = Table<PointerMapFile::RangeRecord>(offset, header.rangeCount);
+            bucketTable = Table<PointerMapFile::BucketRecord>(offset, header.bucketCount + 1);
+            blockTable = Table<PointerMapFile::BlockRecord>(offset, header.blockCount);
+            payload = offset + header.payloadSize <= file.Size() ? file.Data() + offset : nullptr;
+            offset += header.payloadSize;
+            if (!moduleTable || !rangeTable || !bucketTable || !blockTable || !payload) {
+                file.Close();
+                return false;
+            }
+
+            for (uint32_t m = 0; m < header.moduleCount; ++m) {
+                const PointerMapFile::ModuleRecord& record = moduleTable[m];
+                if (offset + record.nameOffset + record.nameLength > file.Size()) {
+                    file.Close();
+                    return false;
+                }
+                modules.push_back({std::string(reinterpret_cast<const char*>(file.Data() + offset + record.nameOffset), record.nameLength),
+                                   static_cast<uintptr_t>(record.base), static_cast<size_t>(record.size)});
+            }
+            return true;
+        }
+
+        bool IsOpen() const { return file.IsOpen(); }
+        uintptr_t Target() const { return static_cast<uintptr_t>(header.target); }
+        size_t PointerSize() const { return header.pointerSize; }
+        size_t EntryCount() const { return static_cast<size_t>(header.entryCount); }
+        size_t FileSize() const { return file.Size(); }
+        const std::vector<PointerModule>& Modules() const { return modules; }
+
+        // 이 세션에서 name 모듈의 기준 주소
+        bool FindModuleBase(const std::string& name, uintptr_t& base) const {
+            for (const PointerModule& module : modules) {
+                if (module.name == name) {
+                    base = module.base;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // PointerMap::ForEachPointerTo와 같음
+        template<typename Visitor>
+        void ForEachPointerTo(uintptr_t low, uintptr_t high, Visitor visit) const {
+            if (!IsOpen() || low > high) return;
+            const uint32_t lowBucket = static_cast<uint32_t>(static_cast<uint64_t>(low) >> 32);
+            const uint32_t highBucket = static_cast<uint32_t>(static_cast<uint64_t>(high) >> 32);
+
+            const PointerMapFile::BucketRecord* bucketEnd = bucketTable + header.bucketCount;
+            const PointerMapFile::BucketRecord* bucket = std::lower_bound(bucketTable, bucketEnd, lowBucket,
+                [](const PointerMapFile::BucketRecord& b, uint32_t h) { return b.high < h; });
+            for (; bucket != bucketEnd && bucket->high <= highBucket; ++bucket) {
+                uint32_t from = bucket->high == lowBucket ? static_cast<uint32_t>(low) : 0;
+                uint32_t to = bucket->high == highBucket ? static_cast<uint32_t>(high) : UINT32_MAX;
+
+                // from 이상인 첫 항목이 들어 있을 수 있는 블록부터 (첫 값이 from보다 작은 마지막 블록)
+                const PointerMapFile::BlockRecord* first = blockTable + bucket->firstBlock;
+                const PointerMapFile::BlockRecord* last = blockTable + (bucket + 1)->firstBlock;
+                const PointerMapFile::BlockRecord* block = std::lower_bound(first, last, from,
+                    [](const PointerMapFile::BlockRecord& b, uint32_t v) { return b.firstLow < v; });
+                if (block != first) --block;
+
+                for (; block != last && block->firstLow <= to; ++block) {
+                    const uint8_t* p = payload + block->offset;
+                    uint32_t value = block->firstLow;
+                    uint64_t slot = 0;
+                    for (uint32_t n = 0; n < block->count; ++n) {
+                        uint32_t delta = static_cast<uint32_t>(PointerMapFile::GetVarint(p));
+                        uint64_t slotField = PointerMapFile::GetVarint(p);
+                        value += delta;
+                        slot = delta == 0 ? slot + slotField : slotField;
+                        if (value < from) continue;
+                        if (value > to) break;
+                        uintptr_t full = static_cast<uintptr_t>((static_cast<uint64_t>(bucket->high) << 32) | value);
+                        if (!visit(full, LocationOf(slot))) return;
+                    }
+                }
+            }
+        }
+
+    private:
+        MappedFile file;
+        PointerMapFile::Header header = {};
+        const PointerMapFile::ModuleRecord* moduleTable = nullptr;
+        const PointerMapFile::RangeRecord* rangeTable = nullptr;
+        const PointerMapFile::BucketRecord* bucketTable = nullptr;
+        const PointerMapFile::BlockRecord* blockTable = nullptr;
+        const uint8_t* payload = nullptr;
+        std::vector<PointerModule> modules;
+
+        template<typename T>
+        const T* Table(size_t& offset, uint64_t count) {
+            if (count > (file.Size() - offset) / sizeof(T)) return nullptr;
+            const T* table = reinterpret_cast<const T*>(file.Data() + offset);
+            offset += static_cast<size_t>(count) * sizeof(T);
+            return table;
+        }
+
+        uintptr_t LocationOf(uint64_t slot) const {
+            const PointerMapFile::RangeRecord* end = rangeTable + header.rangeCount;
+            const PointerMapFile::RangeRecord* range = std::upper_bound(rangeTable, end, slot,
+                [](uint64_t s, const PointerMapFile::RangeRecord& r) { return s < r.slotStart; }) - 1;
+            uint64_t base = range->module == PointerMapFile::NoModule ? range->offset : moduleTable[range->module].base + range->offset;
+            return static_cast<uintptr_t>(base + (slot - range->slotStart) * header.pointerSize);
+        }
+    };
+
+    // "모듈<TAB>baseOffset<TAB>o1,o2,..." (16진수)
+    inline std::string FormatPointerPath(const PointerPath& path) {
+        char number[24];
+        snprintf(number, sizeof(number), "%llx", static_cast<unsigned long long>(path.baseOffset));
+        std::string line = path.module + "\t" + number + "\t";
+        for (size_t i = 0; i < path.offsets.size(); ++i) {
+            snprintf(number, sizeof(number), i == 0 ? "%llx" : ",%llx", static_cast<unsigned long long>(path.offsets[i]));
+            line += number;
+        }
+        return line;
+    }
+
+    inline bool ParsePointerPath(const std::string& line, PointerPath& path) {
+        size_t tab = line.find('\t');
+        size_t secondTab = tab == std::string::npos ? tab : line.find('\t', tab + 1);
+        if (secondTab == std::string::npos || secondTab + 1 >= line.size()) return false;
+
+        path = PointerPath();
+        path.module = line.substr(0, tab);
+        path.baseOffset = static_cast<uintptr_t>(std::strtoull(line.c_str() + tab + 1, nullptr, 16));
+        const char* p = line.c_str() + secondTab + 1;
+        while (*p) {
+            char* end = nullptr;
+            path.offsets.push_back(static_cast<uintptr_t>(std::strtoull(p, &end, 16)));
+            if (end == p) return false;
+            p = *end == ',' ? end + 1 : end;
+        }
+        return !path.module.empty() && !path.offsets.empty();
+    }
+
+    // 경로 목록 저장 (형식 문자열 오름차순, 중복 제거)
+    inline bool WritePointerPathList(const std::string& path, const std::vector<PointerPath>& paths) {
+        std::vector<std::string> lines;
+        lines.reserve(paths.size());
+        for (const PointerPath& pointerPath : paths) lines.push_back(FormatPointerPath(pointerPath));
+        std::sort(lines.begin(), lines.end());
+        lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+
+        std::ofstream file(path);
+        if (!file) return false;
+        file << "# scan-core pointer paths v1\n";
+        for (const std::string& line : lines) file << line << '\n';
+        return static_cast<bool>(file);
+    }
+
+    // 경로 목록을 한 줄씩 읽음 (주석/빈 줄 건너뜀)
+    class PointerPathListReader {
+    public:
+        explicit PointerPathListReader(const std::string& path) : file(path) {}
+
+        bool IsOpen() const { return file.is_open(); }
+
+        bool Next(std::string& line) {
+            while (std::getline(file, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty() && line[0] != '#') return true;
+            }
+            return false;
+        }
+
+    private:
+        std::ifstream file;
+    };
+
+    /**
+     * map에서 path가 목표(target)로 이어지는지 확인합니다. 역방향 맵만 있으므로 목표에서 거꾸로
+     * "값 = 다음 주소 - 오프셋"인 위치를 따라가 마지막에 모듈 + baseOffset에 도달하는지 봅니다.
+     * 같은 값을 가진 위치가 maxBranch개를 넘으면 나머지는 보지 않습니다.
+     */
+    template<typename Map>
+    bool PathReachesTarget(const Map& map, uintptr_t moduleBase, const PointerPath& path, uintptr_t target,
+                           size_t maxBranch = 64) {
+        std::vector<uintptr_t> current{target}, previous;
+        for (size_t i = path.offsets.size(); i-- > 0;) {
+            previous.clear();
+            for (uintptr_t address : current) {
+                if (address < path.offsets[i]) continue;
+                uintptr_t value = address - path.offsets[i];
+                map.ForEachPointerTo(value, value, [&](uintptr_t, uintptr_t location) {
+                    previous.push_back(location);
+                    return previous.size() < maxBranch;
+                });
+            }
+            if (previous.empty()) return false;
+            current.swap(previous);
+        }
+        return std::find(current.begin(), current.end(), moduleBase + path.baseOffset) != current.end();
+    }
+
+    class PointerPathIntersector {
+    public:
+        struct Stats {
+            size_t candidates = 0;      // 모든 목록에 있던 (또는 생성한) 경로 수
+            size_t kept = 0;            // 모든 맵에서 목표로 이어진 경로 수
+            double seconds = 0;
+
+            double PathsPerSecond() const { return seconds > 0 ? candidates / seconds : 0; }
+        };
+
+        bool AddMap(const std::string& path) {
+            auto map = std::make_unique<MappedPointerMap>();
+            if (!map->Open(path)) return false;
+            maps.push_back(std::move(map));
+            return true;
+        }
+
+        size_t MapCount() const { return maps.size(); }
+        const MappedPointerMap& Map(size_t index) const { return *maps[index]; }
+        const Stats& GetLastStats() const { return lastStats; }
+
+        /**
+         * lists의 경로 목록(정렬된 파일)을 한 줄씩 병합해 모두에 있는 경로만 고르고, 추가한 모든 맵에서
+         * 목표로 이어지는 것만 outputPath에 씁니다 (정렬 유지). lists가 비어 있으면 첫 맵에서
+         * generateConfig로 경로를 생성해 후보로 씁니다. 남은 경로 수를 반환합니다.
+         */
+        size_t Intersect(const std::vector<std::string>& lists, const std::string& outputPath,
+                         const PointerScanConfig& generateConfig = PointerScanConfig()) {
+            auto start = std::chrono::steady_clock::now();
+            lastStats = Stats();
+            std::ofstream output(outputPath);
+            if (!output || maps.empty()) return 0;
+            output << "# scan-core pointer paths v1\n";
+
+            auto consider = [&](const std::string& line) {
+                PointerPath path;
+                ++lastStats.candidates;
+                if (ParsePointerPath(line, path) && ValidInAllMaps(path)) {
+                    output << line << '\n';
+                    ++lastStats.kept;
+                }
+            };
+
+            if (lists.empty()) {
+                BasicPointerScanner<MappedPointerMap> scanner(*maps[0], maps[0]->Modules());
+                std::vector<std::string> lines;
+                for (const PointerPath& path : scanner.FindPaths(maps[0]->Target(), generateConfig)) {
+                    lines.push_back(FormatPointerPath(path));
+                }
+                std::sort(lines.begin(), lines.end());
+                lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+                for (const std::string& line : lines) consider(line);
+            } else {
+                // M개 정렬 목록의 교집합: 모두 같은 줄이면 후보, 아니면 가장 작은 줄을 가진 목록만 전진
+                std::vector<std::unique_ptr<PointerPathListReader>> readers;
+                std::vector<std::string> heads(lists.size());
+                bool more = true;
+                for (size_t i = 0; i < lists.size(); ++i) {
+                    readers.push_back(std::make_unique<PointerPathListReader>(lists[i]));
+                    more = more && readers[i]->Next(heads[i]);
+                }
+                while (more) {
+                    size_t smallest = 0;
+                    bool same = true;
+                    for (size_t i = 1; i < heads.size(); ++i) {
+                        if (heads[i] != heads[0]) same = false;
+                        if (heads[i] < heads[smallest]) smallest = i;
+                    }
+                    if (same) {
+                        consider(heads[0]);
+                        for (size_t i = 0; i < readers.size() && more; ++i) more = NextDistinct(*readers[i], heads[i]);
+                    } else {
+                        more = NextDistinct(*readers[smallest], heads[smallest]);
+                    }
+                }
+            }
+
+            lastStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return lastStats.kept;
+        }
+
+    private:
+        std::vector<std::unique_ptr<MappedPointerMap>> maps;
+        Stats lastStats;
+
+        bool ValidInAllMaps(const PointerPath& path) const {
+            for (const auto& map : maps) {
+                uintptr_t moduleBase = 0;
+                if (!map->FindModuleBase(path.module, moduleBase) || !PathReachesTarget(*map, moduleBase, path, map->Target())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // 목록 안의 중복 줄은 건너뜀
+        static bool NextDistinct(PointerPathListReader& reader, std::string& head) {
+            std::string line;
+            while (reader.Next(line)) {
+                if (line != head) {
+                    head.swap(line);
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+}
@@ -0,0 +1,410 @@
+#pragma once
+/*
+ * 역방향 포인터 맵 기반 포인터 경로 자동 생성
+ *
+ * 손으로 찾은 포인터 경로는 게임 업데이트마다 다시 찾아야 합니다. PointerScanner는
+ * 목표 주소를 가리키는 정적(모듈 기준) 포인터 경로 후보를 자동으로 만듭니다.
+ *
+ * 1. PointerMap::Build(): 쓰기 가능/이미지 데이터 영역을 병렬로 한 번 훑어, 커밋된 영역 안을 가리키는
+ *    정렬된 슬롯 값을 "값 → 그 값이 저장된 위치" 역방향 맵으로 만듭니다.
+ *    - 값의 상위 32비트로 버킷을 나누고, 항목은 (값 하위 32비트 << 32 | 슬롯 번호) 8바이트로 저장해 정렬
+ *    - 슬롯 번호는 스캔한 영역 목록의 누적 슬롯 수로 위치를 복원 (항목당 위치 8바이트를 아낌)
+ *    - maxEntries로 항목 수 상한을 두어 16GB 주소 공간에서도 메모리를 제한 (넘으면 IsTruncated())
+ * 2. PointerScanner::FindPaths(): 목표에서 거꾸로 너비 우선 탐색.
+ *    주소 A를 처리할 때 값이 [A - maxOffset, A]인 항목(= A 근처 구조체를 가리키는 포인터)을 찾고,
+ *    그 위치가 모듈 안이면 경로를 내보내고, 아니면 다음 깊이에서 다시 역추적합니다.
+ *
+ * 경로 의미 (Cheat Engine 방식): address = 모듈 + baseOffset; 각 offset마다 address = *address + offset
+ *
+ * 메모리: 맵은 항목당 8바이트, 생성 중에는 작업 단위별 임시 결과(항목당 12바이트)가 더해집니다.
+ *
+ * 사용 예:
+ *   ScanCore::PointerMap map;
+ *   map.Build(*memory);
+ *   ScanCore::PointerScanner scanner(map, ScanCore::PointerScanner::ModulesFromRegions(memory->EnumerateRegions()));
+ *   for (const ScanCore::PointerPath& path : scanner.FindPaths(fpsAddress)) { ... }
+ *   printf("%.0f paths/s\n", scanner.GetLastStats().PathsPerSecond());
+ */
+
+#include "ProcessMemory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ScanCore {
+
+    struct PointerMapConfig {
+        size_t pointerSize = sizeof(uintptr_t);     // 대상 프로세스 포인터 크기 (4 또는 8)
+        size_t maxEntries = 64 * 1024 * 1024;       // 항목 수 상한 (8바이트 × 64M = 512MB)
+        size_t threadCount = 0;                     // 0 = 하드웨어 스레드 수
+        size_t chunkSize = 1024 * 1024;
+    };
+
+    // 경로의 시작점이 되는 모듈 (정적 주소)
+    using PointerModule = ModuleRange;
+
+    // 자동 생성된 포인터 경로 후보
+    struct PointerPath {
+        std::string module;
+        uintptr_t moduleBase = 0;       // 생성할 때의 모듈 기준 주소 (다시 쓸 때는 현재 모듈 기준 주소 사용)
+        uintptr_t baseOffset = 0;
+        std::vector<uintptr_t> offsets; // 역참조할 때마다 더할 값, 마지막 값은 목표 주소까지의 오프셋
+    };
+
+    class PointerMap {
+    public:
+        /**
+         * memory의 포인터 후보를 모아 역방향 맵을 만듭니다. 이전 내용은 지워집니다.
+         * 스캔 대상: 쓰기 가능한 영역 + 실행 불가능한 이미지 영역(.data/.rdata)
+         * 값이 읽을 수 있는 커밋된 영역 안을 가리키는 정렬된 슬롯만 항목이 됩니다.
+         */
+        bool Build(IProcessMemory& memory, const PointerMapConfig& mapConfig = PointerMapConfig()) {
+            auto start = std::chrono::steady_clock::now();
+            config = mapConfig;
+            if (config.pointerSize != 4 && config.pointerSize != 8) config.pointerSize = sizeof(uintptr_t);
+            Clear();
+
+            std::vector<MemoryRegion> regions = memory.EnumerateRegions();
+            for (const MemoryRegion& region : regions) {
+                if (!region.IsReadable()) continue;
+                if (!targets.empty() && targets.back().base + targets.back().size == region.base) {
+                    targets.back().size += region.size;
+                } else {
+                    targets.push_back({region.base, region.size});
+                }
+
+                bool writable = (region.protection & MemoryWrite) != 0;
+                bool staticData = region.type == MemoryRegionType::Image && !region.IsExecutable();
+                uint64_t slots = region.size / config.pointerSize;
+                if ((!writable && !staticData) || slots == 0) continue;
+                if (totalSlots + slots > UINT32_MAX) {
+                    truncated = true;   // 슬롯 번호가 32비트를 넘는 나머지 영역은 건너뜀
+                    continue;
+                }
+                ranges.push_back({region.base, static_cast<size_t>(slots * config.pointerSize)});
+                slotStart.push_back(totalSlots);
+                totalSlots += slots;
+            }
+            if (ranges.empty() || targets.empty()) return false;
+
+            // 1. 작업 단위별로 (값, 슬롯 번호) 수집. 상한을 넘으면 남은 단위는 건너뜀
+            struct UnitEntries {
+                std::vector<uint64_t> values;
+                std::vector<uint32_t> slots;
+            };
+            std::atomic<size_t> collected{0};
+            std::atomic<bool> overflow{false};
+            ScanExecutor executor({config.threadCount, config.chunkSize, 0});
+            std::vector<UnitEntries> units = executor.RunUnits<UnitEntries>(
+                ranges, memory.MakeReadFunction(),
+                [&](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, UnitEntries& out) {
+                    if (collected.load(std::memory_order_relaxed) >= config.maxEntries) {
+                        overflow.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                    uint32_t firstSlot = SlotOf(unit.base);
+                    size_t count = std::min(size, unit.size) / config.pointerSize;
+                    for (size_t i = 0; i < count; ++i) {
+                        uint64_t value = ReadSlot(data + i * config.pointerSize);
+                        if (IsTarget(value)) {
+                            out.values.push_back(value);
+                            out.slots.push_back(firstSlot + static_cast<uint32_t>(i));
+                        }
+                    }
+                    collected.fetch_add(out.values.size(), std::memory_order_relaxed);
+                });
+            scannedBytes = executor.GetLastStats().bytesScanned;
+
+            // 2. 버킷(값 상위 32비트)별 개수 → 위치 → 흩어 넣기. 단위 결과는 옮기는 즉시 해제
+            std::unordered_map<uint32_t, size_t> counts;
+            size_t total = 0;
+            for (const UnitEntries& unit : units) {
+                for (uint64_t value : unit.values) {
+                    if (total == config.maxEntries) break;
+                    ++counts[static_cast<uint32_t>(value >> 32)];
+                    ++total;
+                }
+            }
+            truncated = truncated || overflow.load() || collected.load() > total;
+
+            bucketHigh.reserve(counts.size());
+            for (const auto& bucket : counts) bucketHigh.push_back(bucket.first);
+            std::sort(bucketHigh.begin(), bucketHigh.end());
+            bucketBegin.assign(bucketHigh.size() + 1, 0);
+            for (size_t b = 0; b < bucketHigh.size(); ++b) {
+                bucketBegin[b + 1] = bucketBegin[b] + counts[bucketHigh[b]];
+            }
+
+            entries.resize(total);
+            std::vector<size_t> cursor(bucketBegin.begin(), bucketBegin.end() - 1);
+            size_t placed = 0;
+            for (UnitEntries& unit : units) {
+                for (size_t i = 0; i < unit.values.size() && placed < total; ++i, ++placed) {
+                    size_t b = BucketIndex(static_cast<uint32_t>(unit.values[i] >> 32));
+                    entries[cursor[b]++] = (unit.values[i] << 32) | unit.slots[i];
+                }
+                std::vector<uint64_t>().swap(unit.values);
+                std::vector<uint32_t>().swap(unit.slots);
+            }
+
+            // 3. 버킷 안을 (값 하위 32비트, 슬롯) 순으로 정렬
+            for (size_t b = 0; b < bucketHigh.size(); ++b) {
+                std::sort(entries.begin() + static_cast<std::ptrdiff_t>(bucketBegin[b]),
+                          entries.begin() + static_cast<std::ptrdiff_t>(bucketBegin[b + 1]));
+            }
+
+            buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return true;
+        }
+
+        void Clear() {
+            ranges.clear();
+            slotStart.clear();
+            targets.clear();
+            bucketHigh.clear();
+            bucketBegin.clear();
+            std::vector<uint64_t>().swap(entries);
+            totalSlots = 0;
+            scannedBytes = 0;
+            buildSeconds = 0;
+            truncated = false;
+        }
+
+        /**
+         * 값이 [low, high]인 모든 항목에 대해 visit(값, 그 값이 저장된 위치)를 호출합니다.
+         * 같은 버킷 안에서는 값 오름차순입니다. visit가 false를 반환하면 중단합니다.
+         */
+        template<typename Visitor>
+        void ForEachPointerTo(uintptr_t low, uintptr_t high, Visitor visit) const {
+            if (low > high) return;
+            const uint32_t lowBucket = static_cast<uint32_t>(static_cast<uint64_t>(low) >> 32);
+            const uint32_t highBucket = static_cast<uint32_t>(static_cast<uint64_t>(high) >> 32);
+
+            for (auto it = std::lower_bound(bucketHigh.begin(), bucketHigh.end(), lowBucket);
+                 it != bucketHigh.end() && *it <= highBucket; ++it) {
+                size_t b = static_cast<size_t>(it - bucketHigh.begin());
+                uint64_t from = *it == lowBucket ? static_cast<uint64_t>(static_cast<uint32_t>(low)) << 32 : 0;
+                uint64_t to = *it == highBucket ? static_cast<uint32_t>(high) : UINT32_MAX;
+
+                const uint64_t* end = entries.data() + bucketBegin[b + 1];
+                for (const uint64_t* entry = std::lower_bound(entries.data() + bucketBegin[b], end, from);
+                     entry != end && (*entry >> 32) <= to; ++entry) {
+                    uintptr_t value = static_cast<uintptr_t>((static_cast<uint64_t>(*it) << 32) | (*entry >> 32));
+                    if (!visit(value, LocationOf(static_cast<uint32_t>(*entry)))) return;
+                }
+            }
+        }
+
+        size_t EntryCount() const { return entries.size(); }
+        size_t MemoryBytes() const {
+            return entries.capacity() * sizeof(uint64_t) + bucketHigh.capacity() * sizeof(uint32_t) +
+                   bucketBegin.capacity() * sizeof(size_t) + (ranges.capacity() + targets.capacity()) * sizeof(MemoryRange) +
+                   slotStart.capacity() * sizeof(uint64_t);
+        }
+        size_t ScannedBytes() const { return scannedBytes; }
+        // 스캔한 영역 (슬롯 번호 순서 = 주소 오름차순)
+        const std::vector<MemoryRange>& ScannedRanges() const { return ranges; }
+        size_t PointerSize() const { return config.pointerSize; }
+        double BuildSeconds() const { return buildSeconds; }
+        // maxEntries 또는 슬롯 번호 범위를 넘어 일부 포인터가 빠졌으면 true
+        bool IsTruncated() const { return truncated; }
+
+    private:
+        PointerMapConfig config;
+        std::vector<MemoryRange> ranges;        // 스캔한 영역 (주소 오름차순)
+        std::vector<uint64_t> slotStart;        // ranges[i]의 첫 슬롯 번호
+        std::vector<MemoryRange> targets;       // 포인터가 가리킬 수 있는 영역 (인접 영역 병합)
+        std::vector<uint32_t> bucketHigh;       // 버킷의 값 상위 32비트 (오름차순)
+        std::vector<size_t> bucketBegin;        // 버킷별 entries 구간
+        std::vector<uint64_t> entries;          // (값 하위 32비트 << 32) | 슬롯 번호
+        uint64_t totalSlots = 0;
+        size_t scannedBytes = 0;
+        double buildSeconds = 0;
+        bool truncated = false;
+
+        uint64_t ReadSlot(const uint8_t* p) const {
+            if (config.pointerSize == 4) {
+                uint32_t value;
+                memcpy(&value, p, sizeof(value));
+                return value;
+            }
+            uint64_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        bool IsTarget(uint64_t value) const {
+            // 대부분의 값(작은 정수, float 쌍)은 전체 범위 비교 한 번으로 걸러짐
+            if (value < targets.front().base || value >= targets.back().base + targets.back().size) return false;
+            auto it = std::upper_bound(targets.begin(), targets.end(), value,
+                                       [](uint64_t v, const MemoryRange& range) { return v < range.base; });
+            return value - std::prev(it)->base < std::prev(it)->size;
+        }
+
+        size_t RangeIndexOfAddress(uintptr_t address) const {
+            auto it = std::upper_bound(ranges.begin(), ranges.end(), address,
+                                       [](uintptr_t a, const MemoryRange& range) { return a < range.base; });
+            return static_cast<size_t>(it - ranges.begin()) - 1;
+        }
+
+        uint32_t SlotOf(uintptr_t address) const {
+            size_t index = RangeIndexOfAddress(address);
+            return static_cast<uint32_t>(slotStart[index] + (address - ranges[index].base) / config.pointerSize);
+        }
+
+        uintptr_t LocationOf(uint32_t slot) const {
+            size_t index = static_cast<size_t>(std::upper_bound(slotStart.begin(), slotStart.end(), slot) - slotStart.begin()) - 1;
+            return ranges[index].base + static_cast<uintptr_t>(slot - slotStart[index]) * config.pointerSize;
+        }
+
+        size_t BucketIndex(uint32_t high) const {
+            return static_cast<size_t>(std::lower_bound(bucketHigh.begin(), bucketHigh.end(), high) - bucketHigh.begin());
+        }
+    };
+
+    struct PointerScanConfig {
+        size_t maxDepth = 5;                    // 경로의 최대 역참조 횟수
+        size_t maxOffset = 0x1000;              // 역참조 후 더할 수 있는 최대 오프셋
+        size_t maxResults = 10000;
+        size_t maxNodesPerLevel = 1 << 20;      // 깊이마다 다음 단계로 넘길 힙 주소 수 상한 (메모리 제한)
+    };
+
+    // Map: ForEachPointerTo(low, high, visit)를 제공하는 역방향 맵 (PointerMap, MappedPointerMap)
+    template<typename Map>
+    class BasicPointerScanner {
+    public:
+        struct Stats {
+            size_t pathsFound = 0;
+            size_t nodesExpanded = 0;           // 역추적한 주소 수
+            size_t entriesVisited = 0;          // 맵에서 꺼낸 항목 수
+            double seconds = 0;
+            bool truncated = false;             // maxResults/maxNodesPerLevel에 걸려 탐색을 줄였으면 true
+
+            double PathsPerSecond() const { return seconds > 0 ? pathsFound / seconds : 0; }
+        };
+
+        BasicPointerScanner(const Map& pointerMap, std::vector<PointerModule> moduleList)
+            : map(pointerMap), modules(std::move(moduleList)) {
+            std::sort(modules.begin(), modules.end(),
+                      [](const PointerModule& a, const PointerModule& b) { return a.base < b.base; });
+        }
+
+        const Stats& GetLastStats() const { return lastStats; }
+
+        // target에 도달하는 모듈 기준 경로들 (짧은 경로부터)
+        std::vector<PointerPath> FindPaths(uintptr_t target, const PointerScanConfig& config = PointerScanConfig()) {
+            auto start = std::chrono::steady_clock::now();
+            lastStats = Stats();
+            std::vector<PointerPath> results;
+
+            // 노드 0 = 목표. 나머지는 "*address + offset = parent의 주소"인 힙 위치
+            std::vector<Node> nodes{Node{target, 0, 0}};
+            std::unordered_set<uintptr_t> visited{target};
+            size_t levelBegin = 0, levelEnd = 1;
+
+            for (size_t depth = 1; depth <= config.maxDepth && levelBegin < levelEnd && results.size() < config.maxResults; ++depth) {
+                for (size_t n = levelBegin; n < levelEnd && results.size() < config.maxResults; ++n) {
+                    const Node current = nodes[n];
+                    ++lastStats.nodesExpanded;
+                    uintptr_t low = current.address >= config.maxOffset ? current.address - config.maxOffset : 0;
+
+                    map.ForEachPointerTo(low, current.address, [&](uintptr_t value, uintptr_t location) {
+                        ++lastStats.entriesVisited;
+                        uint32_t offset = static_cast<uint32_t>(current.address - value);
+
+                        if (const PointerModule* module = FindModule(location)) {
+                            results.push_back(MakePath(*module, location, offset, nodes, n));
+                            if (results.size() >= config.maxResults) {
+                                lastStats.truncated = true;
+                                return false;
+                            }
+                        } else if (depth < config.maxDepth && visited.insert(location).second) {
+                            if (nodes.size() - levelEnd >= config.maxNodesPerLevel) {
+                                lastStats.truncated = true;
+                            } else {
+                                nodes.push_back(Node{location, static_cast<uint32_t>(n), offset});
+                            }
+                        }
+                        return true;
+                    });
+                }
+                levelBegin = levelEnd;
+                levelEnd = nodes.size();
+            }
+
+            lastStats.pathsFound = results.size();
+            lastStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return results;
+        }
+
+        /**
+         * 경로를 따라가 최종 주소를 address에 기록합니다. moduleBase는 현재 모듈 기준 주소입니다.
+         * 중간 포인터를 읽을 수 없으면 false.
+         */
+        static bool Resolve(IProcessMemory& memory, uintptr_t moduleBase, const PointerPath& path, uintptr_t& address,
+                            size_t pointerSize = sizeof(uintptr_t)) {
+            address = moduleBase + path.baseOffset;
+            for (uintptr_t offset : path.offsets) {
+                uint64_t next = 0;
+                if (pointerSize == 4) {
+                    uint32_t value = 0;
+                    if (!memory.ReadValue(address, value)) return false;
+                    next = value;
+                } else if (!memory.ReadValue(address, next)) {
+                    return false;
+                }
+                if (next == 0) return false;
+                address = static_cast<uintptr_t>(next) + offset;
+            }
+            return true;
+        }
+
+        // 이미지 영역을 모듈별로 묶은 목록 (GroupImageModules)
+        static std::vector<PointerModule> ModulesFromRegions(const std::vector<MemoryRegion>& regions) {
+            return GroupImageModules(regions);
+        }
+
+    private:
+        struct Node {
+            uintptr_t address;
+            uint32_t parent;        // nodes 번호
+            uint32_t offset;        // *address + offset = parent의 주소
+        };
+
+        const Map& map;
+        std::vector<PointerModule> modules;     // 기준 주소 오름차순
+        Stats lastStats;
+
+        const PointerModule* FindModule(uintptr_t address) const {
+            auto it = std::upper_bound(modules.begin(), modules.end(), address,
+                                       [](uintptr_t a, const PointerModule& module) { return a < module.base; });
+            if (it == modules.begin()) return nullptr;
+            --it;
+            return it->Contains(address) ? &*it : nullptr;
+        }
+
+        // 모듈 안 위치 → 노드 n → ... → 목표 순서로 오프셋을 모음
+        static PointerPath MakePath(const PointerModule& module, uintptr_t location, uint32_t offset,
+                                    const std::vector<Node>& nodes, size_t n) {
+            PointerPath path;
+            path.module = module.name;
+            path.moduleBase = module.base;
+            path.baseOffset = location - module.base;
+            path.offsets.push_back(offset);
+            for (size_t index = n; index != 0; index = nodes[index].parent) {
+                path.offsets.push_back(nodes[index].offset);
+            }
+            return path;
+        }
+    };
+
+    using PointerScanner = BasicPointerScanner<PointerMap>;
+}
@@ -0,0 +1,573 @@
+#pragma once
+/*
+ * 프로세스 메모리 접근 추상화
+ *
+ * 스캐너들이 OpenProcess/VirtualQueryEx/ReadProcessMemory를 직접 부르지 않고
+ * IProcessMemory 하나로 영역 열거, 읽기/쓰기(일괄 포함), 보호 속성 변경을 하도록 합니다.
+ *
+ * 백엔드:
+ * - Win32ProcessMemory: VirtualQueryEx / ReadProcessMemory / WriteProcessMemory / VirtualProtectEx
+ * - LinuxProcessMemory: /proc/<pid>/maps / process_vm_readv / process_vm_writev (일괄 읽기/쓰기는 iovec 배열 한 번)
+ *   (읽기 전용 페이지 쓰기는 /proc/<pid>/mem으로 대신하며, 다른 프로세스의 보호 속성 변경은 지원하지 않음)
+ * - MemoryDump (MemoryDump.h): 메모리에 올린 영역 또는 덤프 파일 (오프라인 분석/벤치마크용)
+ *
+ * 같은 스캐너 코드를 Linux 빌드 서버에서 로컬 테스트 프로세스나 덤프를 대상으로 돌려 처리량을 잴 수 있습니다.
+ *
+ * 사용 예:
+ *   auto memory = ScanCore::OpenProcessMemory(pid);
+ *   auto ranges = memory->CollectRanges([](const ScanCore::MemoryRegion& r) { return r.IsReadable(); });
+ *   auto hits = executor.Run(ranges, memory->MakeReadFunction(), scanFn);
+ */
+
+#include "ScanExecutor.h"
+#include "BatchReader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <Psapi.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ScanCore {
+
+    // 플랫폼 공통 보호 속성 (비트 조합)
+    enum MemoryProtectionFlags : uint32_t {
+        MemoryNoAccess = 0,
+        MemoryRead = 1 << 0,
+        MemoryWrite = 1 << 1,
+        MemoryExecute = 1 << 2,
+        MemoryCopyOnWrite = 1 << 3,     // PAGE_WRITECOPY (아직 쓰지 않은 이미지 페이지, Win32만)
+        MemoryGuard = 1 << 4            // PAGE_GUARD (접근하면 예외)
+    };
+
+    enum class MemoryRegionType {
+        Private,    // 힙, 스택, 익명 매핑
+        Image,      // 실행 파일/DLL 이미지 (MEM_IMAGE)
+        Mapped      // 파일 매핑
+    };
+
+    // 커밋된 메모리 영역 하나
+    struct MemoryRegion {
+        uintptr_t base = 0;
+        size_t size = 0;
+        uint32_t protection = MemoryNoAccess;
+        uint32_t nativeProtection = 0;      // PAGE_* (Windows) 또는 PROT_* (Linux) 원래 값
+        MemoryRegionType type = MemoryRegionType::Private;
+        std::string path;                   // 매핑된 파일 경로 (Linux maps, 덤프), 없으면 빈 문자열
+
+        bool IsReadable() const { return (protection & MemoryRead) && !(protection & MemoryGuard); }
+        // 값이 실제로 바뀌는(쓰기 가능한, copy-on-write가 아닌) 영역
+        bool IsWritable() const { return IsReadable() && (protection & MemoryWrite) && !(protection & MemoryCopyOnWrite); }
+        bool IsExecutable() const { return IsReadable() && (protection & MemoryExecute); }
+        bool Contains(uintptr_t address, size_t length = 1) const {
+            return address >= base && length <= size && address - base <= size - length;
+        }
+    };
+
+    // 로드된 모듈(실행 파일, DLL, 공유 라이브러리) 이미지 범위
+    struct ModuleRange {
+        std::string name;       // 파일 이름 (경로 제외)
+        uintptr_t base = 0;
+        size_t size = 0;
+
+        bool Contains(uintptr_t address) const { return address >= base && address - base < size; }
+    };
+
+    /**
+     * 이미지 영역을 경로(파일)별로 묶어 모듈 목록을 만듭니다 (Linux maps, 덤프).
+     * 경로가 없는 이미지 영역(Windows VirtualQueryEx)은 연속된 영역끼리 묶고 이름은 기준 주소로 붙입니다.
+     */
+    inline std::vector<ModuleRange> GroupImageModules(const std::vector<MemoryRegion>& regions) {
+        std::vector<ModuleRange> result;
+        std::unordered_map<std::string, size_t> byPath;
+        size_t anonymous = SIZE_MAX;    // 경로 없는 마지막 묶음
+        for (const MemoryRegion& region : regions) {
+            if (region.type != MemoryRegionType::Image) continue;
+
+            size_t index;
+            if (!region.path.empty()) {
+                auto found = byPath.find(region.path);
+                if (found == byPath.end()) {
+                    size_t slash = region.path.find_last_of("/\\");
+                    result.push_back({region.path.substr(slash == std::string::npos ? 0 : slash + 1), region.base, 0});
+                    found = byPath.emplace(region.path, result.size() - 1).first;
+                }
+                index = found->second;
+                anonymous = SIZE_MAX;
+            } else if (anonymous != SIZE_MAX && result[anonymous].base + result[anonymous].size == region.base) {
+                index = anonymous;
+            } else {
+                char name[32];
+                snprintf(name, sizeof(name), "image_%llx", static_cast<unsigned long long>(region.base));
+                result.push_back({name, region.base, 0});
+                index = anonymous = result.size() - 1;
+            }
+
+            ModuleRange& module = result[index];
+            uintptr_t end = std::max(module.base + module.size, region.base + region.size);
+            module.base = std::min(module.base, region.base);
+            module.size = end - module.base;
+        }
+        return result;
+    }
+
+    // 일괄 쓰기 요청 하나 (결과는 bytesWritten/ok에 기록)
+    struct WriteRequest {
+        uintptr_t address = 0;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t bytesWritten = 0;
+        bool ok = false;
+    };
+
+    class IProcessMemory {
+    public:
+        virtual ~IProcessMemory() = default;
+
+        // 커밋된 영역 목록 (주소 오름차순)
+        virtual std::vector<MemoryRegion> EnumerateRegions() = 0;
+
+        // 여러 스레드에서 동시에 호출될 수 있어야 함 (스캔 실행기 워커)
+        virtual bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) = 0;
+        virtual bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) = 0;
+
+        // protection으로 바꾸고 이전 값을 oldProtection에 기록 (MemoryProtectionFlags 조합)
+        virtual bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) = 0;
+
+        // 기본 구현은 요청마다 ReadBytes/WriteBytes. 백엔드가 시스템 호출 한 번으로 묶을 수 있으면 재정의
+        virtual void ReadBatch(ReadRequest* requests, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                ReadRequest& request = requests[i];
+                request.bytesRead = 0;
+                request.ok = ReadBytes(request.address, request.buffer, request.size, request.bytesRead) &&
+                             request.bytesRead == request.size;
+            }
+        }
+
+        virtual void WriteBatch(WriteRequest* requests, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                WriteRequest& request = requests[i];
+                request.bytesWritten = 0;
+                request.ok = WriteBytes(request.address, request.data, request.size, request.bytesWritten) &&
+                             request.bytesWritten == request.size;
+            }
+        }
+
+        template<typename T>
+        bool ReadValue(uintptr_t address, T& value) {
+            size_t bytesRead = 0;
+            return ReadBytes(address, &value, sizeof(T), bytesRead) && bytesRead == sizeof(T);
+        }
+
+        template<typename T>
+        bool WriteValue(uintptr_t address, const T& value) {
+            size_t bytesWritten = 0;
+            return WriteBytes(address, &value, sizeof(T), bytesWritten) && bytesWritten == sizeof(T);
+        }
+
+        // 보호 속성을 잠시 읽기/쓰기/실행으로 바꿔 쓰고 원래대로 되돌림 (코드 패치 등)
+        bool WriteProtected(uintptr_t address, const void* data, size_t size) {
+            uint32_t oldProtection = 0;
+            bool changed = Protect(address, size, MemoryRead | MemoryWrite | MemoryExecute, oldProtection);
+            size_t bytesWritten = 0;
+            bool ok = WriteBytes(address, data, size, bytesWritten) && bytesWritten == size;
+            if (changed) {
+                uint32_t ignored = 0;
+                Protect(address, size, oldProtection, ignored);
+            }
+            return ok;
+        }
+
+        // 조건에 맞는 영역을 스캔 실행기 입력으로 수집
+        template<typename Filter>
+        std::vector<MemoryRange> CollectRanges(Filter accept) {
+            std::vector<MemoryRange> ranges;
+            for (const MemoryRegion& region : EnumerateRegions()) {
+                if (accept(region)) {
+                    ranges.push_back({region.base, region.size});
+                }
+            }
+            return ranges;
+        }
+
+        // 로드된 모듈 목록. 기본 구현은 이미지 영역을 묶음 (GroupImageModules)
+        virtual std::vector<ModuleRange> EnumerateModules() {
+            return GroupImageModules(EnumerateRegions());
+        }
+
+        // address를 포함하는 커밋된 영역 (없으면 false). 기본 구현은 전체 열거
+        virtual bool QueryRegion(uintptr_t address, MemoryRegion& result) {
+            for (const MemoryRegion& region : EnumerateRegions()) {
+                if (region.Contains(address)) {
+                    result = region;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        ScanExecutor::ReadFunction MakeReadFunction() {
+            return [this](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+                return ReadBytes(address, buffer, size, bytesRead);
+            };
+        }
+
+        BatchReadFunction MakeBatchReadFunction() {
+            return [this](ReadRequest* requests, size_t count) { ReadBatch(requests, count); };
+        }
+    };
+
+#if defined(_WIN32)
+    class Win32ProcessMemory : public IProcessMemory {
+    public:
+        static constexpr DWORD DefaultAccess = PROCESS_VM_READ | PROCESS_VM_WRITE | PROCESS_VM_OPERATION | PROCESS_QUERY_INFORMATION;
+
+        explicit Win32ProcessMemory(DWORD processId, DWORD access = DefaultAccess)
+            : handle(OpenProcess(access, FALSE, processId)), ownsHandle(true) {}
+
+        // 이미 열린 핸들 사용 (닫지 않음)
+        explicit Win32ProcessMemory(HANDLE processHandle) : handle(processHandle), ownsHandle(false) {}
+
+        ~Win32ProcessMemory() override {
+            if (ownsHandle && handle) CloseHandle(handle);
+        }
+
+        Win32ProcessMemory(const Win32ProcessMemory&) = delete;
+        Win32ProcessMemory& operator=(const Win32ProcessMemory&) = delete;
+
+        bool IsOpen() const { return handle != nullptr; }
+        HANDLE GetHandle() const { return handle; }
+
+        std::vector<MemoryRegion> EnumerateRegions() override {
+            std::vector<MemoryRegion> regions;
+
+            SYSTEM_INFO sysInfo;
+            GetSystemInfo(&sysInfo);
+            uintptr_t address = reinterpret_cast<uintptr_t>(sysInfo.lpMinimumApplicationAddress);
+            uintptr_t maxAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMaximumApplicationAddress);
+
+            MEMORY_BASIC_INFORMATION mbi;
+            while (address < maxAddress &&
+                   VirtualQueryEx(handle, reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) != 0) {
+                if (mbi.State == MEM_COMMIT) {
+                    regions.push_back(FromBasicInformation(mbi));
+                }
+                address = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
+            }
+            return regions;
+        }
+
+        // EnumProcessModulesEx로 실제 모듈 이름과 이미지 크기
+        std::vector<ModuleRange> EnumerateModules() override {
+            std::vector<ModuleRange> result;
+            HMODULE handles[1024];
+            DWORD needed = 0;
+            if (!EnumProcessModulesEx(handle, handles, sizeof(handles), &needed, LIST_MODULES_ALL)) {
+                return IProcessMemory::EnumerateModules();
+            }
+            DWORD count = std::min<DWORD>(needed / sizeof(HMODULE), static_cast<DWORD>(sizeof(handles) / sizeof(HMODULE)));
+            for (DWORD i = 0; i < count; ++i) {
+                MODULEINFO info;
+                char name[MAX_PATH];
+                if (GetModuleInformation(handle, handles[i], &info, sizeof(info)) &&
+                    GetModuleBaseNameA(handle, handles[i], name, sizeof(name))) {
+                    result.push_back({name, reinterpret_cast<uintptr_t>(info.lpBaseOfDll), info.SizeOfImage});
+                }
+            }
+            return result;
+        }
+
+        // VirtualQueryEx 한 번으로 조회
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override {
+            MEMORY_BASIC_INFORMATION mbi;
+            if (VirtualQueryEx(handle, reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) == 0 || mbi.State != MEM_COMMIT) {
+                return false;
+            }
+            result = FromBasicInformation(mbi);
+            return true;
+        }
+
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            SIZE_T read = 0;
+            BOOL ok = ReadProcessMemory(handle, reinterpret_cast<LPCVOID>(address), buffer, size, &read);
+            bytesRead = read;
+            return ok != FALSE;
+        }
+
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            SIZE_T written = 0;
+            BOOL ok = WriteProcessMemory(handle, reinterpret_cast<LPVOID>(address), data, size, &written);
+            bytesWritten = written;
+            return ok != FALSE;
+        }
+
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            DWORD oldNative = 0;
+            if (!VirtualProtectEx(handle, reinterpret_cast<LPVOID>(address), size, ToNative(protection), &oldNative)) {
+                return false;
+            }
+            oldProtection = FromNative(oldNative);
+            return true;
+        }
+
+        static MemoryRegion FromBasicInformation(const MEMORY_BASIC_INFORMATION& mbi) {
+            MemoryRegion region;
+            region.base = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            region.size = mbi.RegionSize;
+            region.nativeProtection = mbi.Protect;
+            region.protection = FromNative(mbi.Protect);
+            region.type = mbi.Type == MEM_IMAGE ? MemoryRegionType::Image
+                        : mbi.Type == MEM_MAPPED ? MemoryRegionType::Mapped
+                        : MemoryRegionType::Private;
+            return region;
+        }
+
+        static uint32_t FromNative(DWORD protect) {
+            uint32_t flags = (protect & PAGE_GUARD) ? MemoryGuard : MemoryNoAccess;
+            switch (protect & 0xFF) {
+                case PAGE_READONLY: return flags | MemoryRead;
+                case PAGE_READWRITE: return flags | MemoryRead | MemoryWrite;
+                case PAGE_WRITECOPY: return flags | MemoryRead | MemoryWrite | MemoryCopyOnWrite;
+                case PAGE_EXECUTE: return flags | MemoryExecute;
+                case PAGE_EXECUTE_READ: return flags | MemoryRead | MemoryExecute;
+                case PAGE_EXECUTE_READWRITE: return flags | MemoryRead | MemoryWrite | MemoryExecute;
+                case PAGE_EXECUTE_WRITECOPY: return flags | MemoryRead | MemoryWrite | MemoryExecute | MemoryCopyOnWrite;
+                default: return flags;
+            }
+        }
+
+        static DWORD ToNative(uint32_t protection) {
+            bool read = (protection & MemoryRead) != 0;
+            bool write = (protection & MemoryWrite) != 0;
+            bool execute = (protection & MemoryExecute) != 0;
+            bool copy = (protection & MemoryCopyOnWrite) != 0;
+            DWORD native = PAGE_NOACCESS;
+            if (execute) {
+                native = write ? (copy ? PAGE_EXECUTE_WRITECOPY : PAGE_EXECUTE_READWRITE)
+                       : read ? PAGE_EXECUTE_READ : PAGE_EXECUTE;
+            } else if (write) {
+                native = copy ? PAGE_WRITECOPY : PAGE_READWRITE;
+            } else if (read) {
+                native = PAGE_READONLY;
+            }
+            if (protection & MemoryGuard) native |= PAGE_GUARD;
+            return native;
+        }
+
+    private:
+        HANDLE handle;
+        bool ownsHandle;
+    };
+#endif
+
+#if defined(__linux__)
+    class LinuxProcessMemory : public IProcessMemory {
+    public:
+        explicit LinuxProcessMemory(pid_t processId) : pid(processId), batchRead(MakeProcessVmBatchRead(processId)) {}
+
+        ~LinuxProcessMemory() override {
+            if (memFd >= 0) close(memFd);
+        }
+
+        LinuxProcessMemory(const LinuxProcessMemory&) = delete;
+        LinuxProcessMemory& operator=(const LinuxProcessMemory&) = delete;
+
+        pid_t GetPid() const { return pid; }
+
+        // 프로세스가 존재하고 maps를 읽을 수 있는지
+        bool IsOpen() const {
+            std::string path = "/proc/" + std::to_string(pid) + "/maps";
+            FILE* file = fopen(path.c_str(), "r");
+            if (!file) return false;
+            fclose(file);
+            return true;
+        }
+
+        // /proc/<pid>/maps 한 줄: "start-end perms offset dev inode path"
+        std::vector<MemoryRegion> EnumerateRegions() override {
+            std::vector<MemoryRegion> regions;
+            std::string path = "/proc/" + std::to_string(pid) + "/maps";
+            FILE* file = fopen(path.c_str(), "r");
+            if (!file) return regions;
+
+            char line[4096];
+            while (fgets(line, sizeof(line), file)) {
+                unsigned long long start = 0, end = 0, offset = 0, inode = 0;
+                char perms[8] = {};
+                char device[32] = {};
+                int pathStart = 0;
+                if (sscanf(line, "%llx-%llx %7s %llx %31s %llu %n", &start, &end, perms, &offset, device, &inode, &pathStart) < 6) {
+                    continue;
+                }
+
+                MemoryRegion region;
+                region.base = static_cast<uintptr_t>(start);
+                region.size = static_cast<size_t>(end - start);
+                if (pathStart > 0) {
+                    region.path = line + pathStart;
+                    while (!region.path.empty() && (region.path.back() == '\n' || region.path.back() == ' ')) region.path.pop_back();
+                }
+
+                if (perms[0] == 'r') { region.protection |= MemoryRead; region.nativeProtection |= PROT_READ; }
+                if (perms[1] == 'w') { region.protection |= MemoryWrite; region.nativeProtection |= PROT_WRITE; }
+                if (perms[2] == 'x') { region.protection |= MemoryExecute; region.nativeProtection |= PROT_EXEC; }
+                // 파일을 private로 매핑한 쓰기 가능 영역(실행 파일/라이브러리의 .data)은 일반 쓰기 가능 메모리로 취급.
+                // maps로는 아직 쓰지 않은 페이지(PAGE_WRITECOPY에 해당)를 가릴 수 없고, 정적 전역 변수가 여기 있음
+
+                // 커널 영역은 maps에 읽기 가능으로 나와도 process_vm_readv로 읽을 수 없음
+                if (region.path == "[vvar]" || region.path == "[vvar_vclock]" || region.path == "[vsyscall]") {
+                    region.protection = MemoryNoAccess;
+                }
+
+                // 파일 매핑은 대부분 실행 파일/공유 라이브러리 (장치/memfd는 일반 파일 매핑으로 취급)
+                region.type = inode == 0 ? MemoryRegionType::Private
+                            : (region.path.compare(0, 5, "/dev/") == 0 || region.path.compare(0, 7, "/memfd:") == 0) ? MemoryRegionType::Mapped
+                            : MemoryRegionType::Image;
+                regions.push_back(region);
+            }
+            fclose(file);
+            return regions;
+        }
+
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            struct iovec local = {buffer, size};
+            struct iovec remote = {reinterpret_cast<void*>(address), size};
+            ssize_t result = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+            bytesRead = result > 0 ? static_cast<size_t>(result) : 0;
+            return result >= 0;
+        }
+
+        // process_vm_writev는 읽기 전용 페이지에 쓸 수 없으므로 실패하면 /proc/<pid>/mem으로 다시 시도
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            struct iovec local = {const_cast<void*>(data), size};
+            struct iovec remote = {reinterpret_cast<void*>(address), size};
+            ssize_t result = process_vm_writev(pid, &local, 1, &remote, 1, 0);
+            if (result == static_cast<ssize_t>(size)) {
+                bytesWritten = size;
+                return true;
+            }
+
+            int fd = MemFd();
+            if (fd >= 0) {
+                result = pwrite(fd, data, size, static_cast<off_t>(address));
+            }
+            bytesWritten = result > 0 ? static_cast<size_t>(result) : 0;
+            return result >= 0;
+        }
+
+        void ReadBatch(ReadRequest* requests, size_t count) override {
+            batchRead(requests, count);
+        }
+
+        // process_vm_writev 한 번에 여러 구간을 씀. 실패한 요청은 WriteBytes(/proc/<pid>/mem 대체 포함)로 다시 쓰고 그 다음부터 이어서 호출
+        void WriteBatch(WriteRequest* requests, size_t count) override {
+#ifdef IOV_MAX
+            const size_t maxIov = IOV_MAX;
+#else
+            const size_t maxIov = 1024;
+#endif
+            std::vector<struct iovec> local;
+            std::vector<struct iovec> remote;
+            size_t next = 0;
+            while (next < count) {
+                size_t batch = std::min(maxIov, count - next);
+                local.resize(batch);
+                remote.resize(batch);
+                for (size_t i = 0; i < batch; ++i) {
+                    WriteRequest& request = requests[next + i];
+                    request.bytesWritten = 0;
+                    request.ok = false;
+                    local[i].iov_base = const_cast<uint8_t*>(request.data);
+                    local[i].iov_len = request.size;
+                    remote[i].iov_base = reinterpret_cast<void*>(request.address);
+                    remote[i].iov_len = request.size;
+                }
+
+                ssize_t result = process_vm_writev(pid, local.data(), batch, remote.data(), batch, 0);
+                size_t transferred = result > 0 ? static_cast<size_t>(result) : 0;
+
+                size_t i = 0;
+                for (; i < batch && transferred >= requests[next + i].size; ++i) {
+                    requests[next + i].bytesWritten = requests[next + i].size;
+                    requests[next + i].ok = true;
+                    transferred -= requests[next + i].size;
+                }
+                if (i < batch) {
+                    WriteRequest& request = requests[next + i];
+                    request.ok = WriteBytes(request.address, request.data, request.size, request.bytesWritten) &&
+                                 request.bytesWritten == request.size;
+                    ++i;
+                }
+                next += i;
+            }
+        }
+
+        // 자기 자신만 mprotect로 변경 가능. 다른 프로세스는 대상 안에서 mprotect를 실행해야 하므로 지원하지 않음
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            if (pid != getpid()) return false;
+
+            MemoryRegion region;
+            if (!QueryRegion(address, region)) return false;
+
+            int native = PROT_NONE;
+            if (protection & MemoryRead) native |= PROT_READ;
+            if (protection & MemoryWrite) native |= PROT_WRITE;
+            if (protection & MemoryExecute) native |= PROT_EXEC;
+
+            uintptr_t pageMask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+            uintptr_t begin = address & ~pageMask;
+            uintptr_t end = (address + size + pageMask) & ~pageMask;
+            if (mprotect(reinterpret_cast<void*>(begin), end - begin, native) != 0) return false;
+            oldProtection = region.protection & (MemoryRead | MemoryWrite | MemoryExecute);
+            return true;
+        }
+
+    private:
+        pid_t pid;
+        BatchReadFunction batchRead;
+        int memFd = -1;
+        std::mutex memFdLock;
+
+        int MemFd() {
+            std::lock_guard<std::mutex> guard(memFdLock);
+            if (memFd < 0) {
+                std::string path = "/proc/" + std::to_string(pid) + "/mem";
+                memFd = open(path.c_str(), O_RDWR);
+            }
+            return memFd;
+        }
+    };
+#endif
+
+    // 현재 플랫폼의 기본 백엔드로 프로세스 열기 (실패하면 nullptr)
+    inline std::unique_ptr<IProcessMemory> OpenProcessMemory(uint32_t processId) {
+#if defined(_WIN32)
+        auto memory = std::make_unique<Win32ProcessMemory>(static_cast<DWORD>(processId));
+        if (!memory->IsOpen()) return nullptr;
+        return memory;
+#elif defined(__linux__)
+        auto memory = std::make_unique<LinuxProcessMemory>(static_cast<pid_t>(processId));
+        if (!memory->IsOpen()) return nullptr;
+        return memory;
+#else
+        (void)processId;
+        return nullptr;
+#endif
+    }
+}
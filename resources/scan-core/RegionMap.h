@@ -0,0 +1,224 @@
+#pragma once
+/*
+ * 주소 → 영역 조회 맵 (한 번 열거, 시스템 호출 없는 조회, 타이머/접근 실패 시 갱신)
+ *
+ * 읽기/쓰기 전에 주소가 유효한지, 보호 속성이 맞는지 확인할 때마다 VirtualQueryEx(Linux는 /proc/<pid>/maps)를
+ * 부르면 값 하나 읽는 것보다 확인이 더 비쌉니다. 주소 자체를 키로 캐시하면 같은 영역 안의 다른 주소는 모두 miss입니다.
+ * RegionMap은 EnumerateRegions()로 한 번에 받은 영역 목록을 기준 주소 순으로 들고 있다가
+ * "이 주소를 포함하는 영역"을 이진 탐색(O(log n))으로 찾습니다. 커밋된 영역은 서로 겹치지 않으므로
+ * 정렬된 배열 하나가 구간 트리와 같은 역할을 합니다.
+ *
+ * 갱신:
+ * - RefreshIfStale(): 마지막 전체 열거 후 refreshInterval이 지났으면 다시 열거 (타이머, 조회 miss 때)
+ * - RefreshAround(address): 읽기/쓰기가 실패한 주소의 영역 하나만 QueryRegion으로 다시 확인해 교체/삭제
+ *   (해제된 영역, 보호 속성이 바뀐 영역을 다음 타이머까지 기다리지 않고 반영)
+ * - Invalidate(): 다음 조회 때 전체 열거
+ *
+ * 조회와 갱신은 같은 스레드에서 해야 합니다 (영역 포인터는 다음 갱신까지만 유효).
+ *
+ * 사용 예:
+ *   ScanCore::RegionMap regions(*memory);
+ *   if (regions.Covers(address, sizeof(float), [](const ScanCore::MemoryRegion& r) { return r.IsWritable(); })) {
+ *       if (!memory->WriteValue(address, value)) regions.RefreshAround(address);
+ *   }
+ *   const ScanCore::MemoryRegion* region = regions.Find(address);   // 없으면 nullptr
+ */
+
+#include "ProcessMemory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ScanCore {
+
+    struct RegionMapConfig {
+        std::chrono::milliseconds refreshInterval{2000};   // 0 = 타이머 갱신 없음 (RefreshAround/Invalidate만)
+    };
+
+    class RegionMap {
+    public:
+        struct Stats {
+            size_t lookups = 0;
+            size_t misses = 0;              // 포함하는 영역이 없던 조회
+            size_t fullRefreshes = 0;       // EnumerateRegions 호출 수
+            size_t regionQueries = 0;       // QueryRegion 호출 수 (RefreshAround)
+            size_t changedRegions = 0;      // 갱신으로 추가/삭제/변경된 영역 수 (누적)
+        };
+
+        explicit RegionMap(IProcessMemory& memory, const RegionMapConfig& config = RegionMapConfig())
+            : memory(memory), config(config) {}
+
+        // address를 포함하는 영역 (없으면 nullptr). 처음 조회하거나 Invalidate() 후면 먼저 전체 열거
+        const MemoryRegion* Find(uintptr_t address) {
+            if (stale) Refresh();
+            ++stats.lookups;
+            const MemoryRegion* region = Lookup(address);
+            if (!region) {
+                // 마지막 열거 이후 새로 할당된 영역일 수 있으므로 타이머가 지났으면 다시 열거
+                if (RefreshIfStale()) region = Lookup(address);
+                if (!region) ++stats.misses;
+            }
+            return region;
+        }
+
+        /**
+         * [address, address + size)가 빈틈 없이 이어진 영역들 안에 있고 모든 영역이 accept를 만족하면 true.
+         * 영역 경계에 걸친 읽기/쓰기도 확인합니다.
+         */
+        template<typename Accept>
+        bool Covers(uintptr_t address, size_t size, Accept accept) {
+            if (size == 0 || address + size < address) return false;
+            if (CoversNow(address, size, accept)) return true;
+            // 거부된 주소도 마지막 열거 이후 보호 속성이 바뀌었을 수 있으므로 타이머가 지났으면 다시 확인
+            return RefreshIfStale() && CoversNow(address, size, accept);
+        }
+
+        bool IsReadable(uintptr_t address, size_t size = 1) {
+            return Covers(address, size, [](const MemoryRegion& region) { return region.IsReadable(); });
+        }
+
+        bool IsWritable(uintptr_t address, size_t size = 1) {
+            return Covers(address, size, [](const MemoryRegion& region) { return region.IsWritable(); });
+        }
+
+        // 전체 다시 열거. 바뀐 영역 수를 반환
+        size_t Refresh() {
+            std::vector<MemoryRegion> fresh = memory.EnumerateRegions();
+            std::sort(fresh.begin(), fresh.end(), [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+            size_t changed = CountChanges(regions, fresh);
+            regions = std::move(fresh);
+            lastRefresh = std::chrono::steady_clock::now();
+            stale = false;
+            ++stats.fullRefreshes;
+            stats.changedRegions += changed;
+            return changed;
+        }
+
+        // refreshInterval이 지났으면 전체 다시 열거하고 true
+        bool RefreshIfStale() {
+            if (config.refreshInterval.count() <= 0 && !stale) return false;
+            if (!stale && std::chrono::steady_clock::now() - lastRefresh < config.refreshInterval) return false;
+            Refresh();
+            return true;
+        }
+
+        /**
+         * address의 영역 하나만 다시 확인합니다 (읽기/쓰기 실패, 접근 위반 후).
+         * 커밋된 영역이면 그 구간과 겹치는 기존 영역을 새 정보로 바꾸고, 아니면 address를 포함하던 영역을 지웁니다.
+         * 영역이 바뀌었으면 true
+         */
+        bool RefreshAround(uintptr_t address) {
+            if (stale) {
+                Refresh();
+                return true;
+            }
+            ++stats.regionQueries;
+            MemoryRegion fresh;
+            if (!memory.QueryRegion(address, fresh)) {
+                const MemoryRegion* old = Lookup(address);
+                if (!old) return false;
+                regions.erase(regions.begin() + (old - regions.data()));
+                ++stats.changedRegions;
+                return true;
+            }
+
+            // fresh와 겹치는 영역 [first, last)
+            auto first = std::lower_bound(regions.begin(), regions.end(), fresh.base,
+                                          [](const MemoryRegion& region, uintptr_t base) { return region.base + region.size <= base; });
+            auto last = first;
+            while (last != regions.end() && last->base < fresh.base + fresh.size) ++last;
+            if (last - first == 1 && SameRegion(*first, fresh)) return false;
+
+            // 일부만 겹치던 앞뒤 영역은 겹치지 않는 부분을 남김
+            std::vector<MemoryRegion> replacement;
+            if (first != last && first->base < fresh.base) {
+                MemoryRegion head = *first;
+                head.size = fresh.base - head.base;
+                replacement.push_back(head);
+            }
+            replacement.push_back(fresh);
+            if (first != last) {
+                const MemoryRegion& back = *(last - 1);
+                uintptr_t freshEnd = fresh.base + fresh.size;
+                if (back.base + back.size > freshEnd) {
+                    MemoryRegion tail = back;
+                    tail.base = freshEnd;
+                    tail.size = back.base + back.size - freshEnd;
+                    replacement.push_back(tail);
+                }
+            }
+            stats.changedRegions += std::max<size_t>(1, static_cast<size_t>(last - first));
+            size_t at = static_cast<size_t>(first - regions.begin());
+            regions.erase(first, last);
+            regions.insert(regions.begin() + at, replacement.begin(), replacement.end());
+            return true;
+        }
+
+        // 다음 조회 때 전체 다시 열거
+        void Invalidate() { stale = true; }
+
+        const std::vector<MemoryRegion>& Regions() const { return regions; }
+        size_t Size() const { return regions.size(); }
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = Stats(); }
+
+    private:
+        IProcessMemory& memory;
+        RegionMapConfig config;
+        std::vector<MemoryRegion> regions;      // 기준 주소 오름차순, 서로 겹치지 않음
+        std::chrono::steady_clock::time_point lastRefresh;
+        bool stale = true;
+        Stats stats;
+
+        const MemoryRegion* Lookup(uintptr_t address) const {
+            auto it = std::upper_bound(regions.begin(), regions.end(), address,
+                                       [](uintptr_t value, const MemoryRegion& region) { return value < region.base; });
+            if (it == regions.begin()) return nullptr;
+            --it;
+            return it->Contains(address) ? &*it : nullptr;
+        }
+
+        template<typename Accept>
+        bool CoversNow(uintptr_t address, size_t size, Accept& accept) {
+            const MemoryRegion* region = Find(address);
+            if (!region) return false;
+
+            uintptr_t end = address + size;
+            size_t index = static_cast<size_t>(region - regions.data());
+            while (true) {
+                const MemoryRegion& current = regions[index];
+                if (!accept(current)) return false;
+                uintptr_t currentEnd = current.base + current.size;
+                if (currentEnd >= end) return true;
+                if (++index == regions.size() || regions[index].base != currentEnd) return false;
+            }
+        }
+
+        static bool SameRegion(const MemoryRegion& a, const MemoryRegion& b) {
+            return a.base == b.base && a.size == b.size && a.protection == b.protection && a.type == b.type;
+        }
+
+        // 두 정렬된 목록에서 한쪽에만 있거나 속성이 다른 영역 수
+        static size_t CountChanges(const std::vector<MemoryRegion>& before, const std::vector<MemoryRegion>& after) {
+            size_t changed = 0;
+            size_t i = 0, j = 0;
+            while (i < before.size() || j < after.size()) {
+                if (j == after.size() || (i < before.size() && before[i].base < after[j].base)) {
+                    ++changed;
+                    ++i;
+                } else if (i == before.size() || after[j].base < before[i].base) {
+                    ++changed;
+                    ++j;
+                } else {
+                    changed += !SameRegion(before[i], after[j]);
+                    ++i;
+                    ++j;
+                }
+            }
+            return changed;
+        }
+    };
+}
@@ -0,0 +1,229 @@
+#pragma once
+/*
+ * 스트리밍 영역 읽기 (더블 버퍼)
+ *
+ * 영역마다 std::vector<uint8_t> buffer(region.size)를 만들면 큰 영역에서 메모리 사용량이 급증하고,
+ * 읽는 동안에는 비교를 하지 못합니다. RegionStream은 영역을 고정 크기 청크로 나누어 재사용 버퍼 2~3개에 번갈아 읽습니다.
+ * - 읽기 스레드가 다음 청크를 읽는 동안 호출한 스레드는 현재 청크를 비교
+ * - 앞 청크의 마지막 overlap 바이트를 다음 청크 앞에 붙여 넘기므로 경계에 걸친 패턴도 찾음 (다시 읽지 않음)
+ * - 최대 메모리 = bufferCount × (chunkSize + overlap). 영역이 아무리 커도 일정
+ *
+ * overlap은 "패턴 길이 - 1"로 둡니다. 그러면 붙여 넘긴 바이트 안에서 끝나는 위치는 앞 청크에서 이미 확인했으므로
+ * 같은 결과가 두 번 나오지 않습니다. 정렬된 값 스캔(청크 크기가 값 크기의 배수)은 경계에 걸칠 일이 없으므로 0입니다.
+ *
+ * 사용 예:
+ *   ScanCore::RegionStream stream(memory->MakeReadFunction(), { 1024 * 1024, pattern.size() - 1 });
+ *   stream.ForEach(ranges, [&](const uint8_t* data, size_t size, uintptr_t base) {
+ *       // data[0..size)를 비교. data[i]의 주소는 base + i
+ *       return true;    // false를 반환하면 중단
+ *   });
+ */
+
+#include "ScanExecutor.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ScanCore {
+
+    struct RegionStreamConfig {
+        size_t chunkSize = 1024 * 1024;     // 한 번에 읽을 크기
+        size_t overlap = 0;                 // 다음 청크 앞에 붙여 넘길 바이트 (보통 패턴 길이 - 1)
+        size_t bufferCount = 2;             // 2 = 더블 버퍼, 3 = 트리플 버퍼
+        bool prefetch = true;               // false면 읽기 스레드 없이 호출한 스레드에서 읽음
+    };
+
+    class RegionStream {
+    public:
+        struct Stats {
+            size_t chunks = 0;
+            size_t bytesRead = 0;
+            size_t failedReads = 0;         // 한 바이트도 읽지 못한 청크 수
+            size_t bufferBytes = 0;         // 할당한 버퍼 전체 크기 (최대 메모리)
+        };
+
+        explicit RegionStream(ScanExecutor::ReadFunction read, const RegionStreamConfig& config = RegionStreamConfig())
+            : read(std::move(read)), config(config) {
+            if (this->config.chunkSize == 0) this->config.chunkSize = 1024 * 1024;
+            if (this->config.bufferCount < 2) this->config.bufferCount = 2;
+        }
+
+        const RegionStreamConfig& GetConfig() const { return config; }
+        const Stats& GetLastStats() const { return lastStats; }
+
+        // data[0]의 주소가 base일 때, 주소가 alignment의 배수인 첫 오프셋 (정렬된 값/구조체 스캔용)
+        static size_t AlignedOffset(uintptr_t base, size_t alignment) {
+            return alignment > 1 ? (alignment - base % alignment) % alignment : 0;
+        }
+
+        /**
+         * ranges를 순서대로 청크 단위로 읽어 visit(data, size, base)를 호출합니다.
+         * data는 앞 청크에서 넘어온 overlap 바이트를 포함하며, 다음 호출 전까지만 유효합니다.
+         * 읽지 못한 청크는 건너뛰고, 그 다음 청크에는 overlap을 붙이지 않습니다.
+         * visit이 false를 반환해 중단했으면 false를 반환합니다.
+         */
+        template<typename Visit>
+        bool ForEach(const std::vector<MemoryRange>& ranges, Visit visit) {
+            lastStats = Stats();
+            BuildChunks(ranges);
+            AllocateSlots();
+            if (chunks.empty()) return true;
+
+            if (!config.prefetch) {
+                for (size_t n = 0; n < chunks.size(); ++n) {
+                    Fill(n);
+                    if (!Consume(n, visit)) return false;
+                }
+                return true;
+            }
+
+            filled = 0;
+            released = 0;
+            stopped = false;
+            std::thread reader([this]() { ReadAhead(); });
+            ReaderGuard guard{this, reader};
+
+            for (size_t n = 0; n < chunks.size(); ++n) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]() { return filled > n; });
+                }
+                if (!Consume(n, visit)) return false;
+            }
+            return true;
+        }
+
+        // 영역 하나만 읽을 때
+        template<typename Visit>
+        bool ForEach(uintptr_t base, size_t size, Visit visit) {
+            return ForEach(std::vector<MemoryRange>{MemoryRange{base, size}}, visit);
+        }
+
+    private:
+        struct Chunk {
+            uintptr_t base = 0;
+            size_t size = 0;
+            size_t rangeIndex = 0;
+        };
+
+        struct Slot {
+            std::vector<uint8_t> data;      // [overlap 자리][청크]
+            size_t bytesRead = 0;
+            size_t carry = 0;               // 앞에 붙인 바이트 수
+        };
+
+        // 예외로 빠져나가도 읽기 스레드를 멈추고 기다림
+        struct ReaderGuard {
+            RegionStream* stream;
+            std::thread& thread;
+            ~ReaderGuard() {
+                {
+                    std::lock_guard<std::mutex> lock(stream->mutex);
+                    stream->stopped = true;
+                }
+                stream->changed.notify_all();
+                thread.join();
+            }
+        };
+
+        ScanExecutor::ReadFunction read;
+        RegionStreamConfig config;
+        Stats lastStats;
+        std::vector<Chunk> chunks;
+        std::vector<Slot> slots;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t filled = 0;          // 읽기를 마친 청크 수
+        size_t released = 0;        // 비교를 마치고 버퍼를 돌려준 청크 수
+        bool stopped = false;
+
+        void BuildChunks(const std::vector<MemoryRange>& ranges) {
+            chunks.clear();
+            for (size_t i = 0; i < ranges.size(); ++i) {
+                for (size_t offset = 0; offset < ranges[i].size; offset += config.chunkSize) {
+                    chunks.push_back(Chunk{ranges[i].base + offset, std::min(config.chunkSize, ranges[i].size - offset), i});
+                }
+            }
+        }
+
+        void AllocateSlots() {
+            slots.resize(config.bufferCount);
+            for (Slot& slot : slots) {
+                slot.data.resize(config.overlap + config.chunkSize);
+                lastStats.bufferBytes += slot.data.size();
+            }
+        }
+
+        void Fill(size_t n) {
+            const Chunk& chunk = chunks[n];
+            Slot& slot = slots[n % slots.size()];
+            slot.bytesRead = 0;
+            slot.carry = 0;
+            // 실패해도 앞부분을 읽었으면(부분 읽기) 그만큼은 비교
+            read(chunk.base, slot.data.data() + config.overlap, chunk.size, slot.bytesRead);
+            slot.bytesRead = std::min(slot.bytesRead, chunk.size);
+        }
+
+        void ReadAhead() {
+            for (size_t n = 0; n < chunks.size(); ++n) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]() { return stopped || n < released + slots.size(); });
+                    if (stopped) return;
+                }
+                Fill(n);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    filled = n + 1;
+                }
+                changed.notify_all();
+            }
+        }
+
+        // 앞 청크의 꼬리를 붙이고, 앞 청크 버퍼를 돌려준 뒤 방문
+        template<typename Visit>
+        bool Consume(size_t n, Visit& visit) {
+            const Chunk& chunk = chunks[n];
+            Slot& slot = slots[n % slots.size()];
+            ++lastStats.chunks;
+
+            if (n > 0 && config.overlap > 0) {
+                const Chunk& previous = chunks[n - 1];
+                const Slot& previousSlot = slots[(n - 1) % slots.size()];
+                if (previous.rangeIndex == chunk.rangeIndex && previousSlot.bytesRead == previous.size) {
+                    size_t carry = std::min(config.overlap, previousSlot.carry + previousSlot.bytesRead);
+                    memcpy(slot.data.data() + config.overlap - carry,
+                           previousSlot.data.data() + config.overlap + previousSlot.bytesRead - carry, carry);
+                    slot.carry = carry;
+                }
+            }
+            Release(n);
+
+            if (slot.bytesRead == 0) {
+                ++lastStats.failedReads;
+                return true;
+            }
+            lastStats.bytesRead += slot.bytesRead;
+            return visit(static_cast<const uint8_t*>(slot.data.data() + config.overlap - slot.carry),
+                         slot.carry + slot.bytesRead, chunk.base - slot.carry);
+        }
+
+        // 청크 n-1의 버퍼를 읽기 스레드에 돌려줌 (청크 n은 아직 사용 중)
+        void Release(size_t n) {
+            if (!config.prefetch) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                released = n;
+            }
+            changed.notify_all();
+        }
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+/*
+ * 이동 창 통계 (최근 window개 값의 최소/최대/평균/분산)
+ *
+ * 값을 하나 넣을 때마다 창 전체를 다시 훑지 않고 분할 상환 상수 시간에 갱신하고, 조회는 모두 상수 시간입니다.
+ * - 최소/최대: 단조 큐 (창 안에서 더 나중에 들어온 더 작은/큰 값이 있으면 그 값은 다시 답이 될 수 없으므로 버림)
+ * - 평균/분산: 이동 Welford (들어오는 값과 빠지는 값으로 갱신). 누적 오차는 window개마다 창 전체로 다시 계산해 없앰
+ * 한 스레드에서만 씁니다 (다른 스레드에 보이려면 AddressSampler처럼 따로 공개).
+ *
+ * 사용 예:
+ *   ScanCore::RollingStats stats(600);
+ *   stats.Add(value);
+ *   stats.Minimum(); stats.Maximum(); stats.Mean(); stats.Variance();
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ScanCore {
+
+    // 최근 window개 값의 최소/최대/평균/분산 (Add는 분할 상환 상수 시간, 한 스레드에서만)
+    class RollingStats {
+    public:
+        explicit RollingStats(size_t window = 1000)
+            : window(std::max<size_t>(1, window)), values(this->window), minQueue(this->window), maxQueue(this->window) {}
+
+        size_t Window() const { return window; }
+        size_t Count() const { return static_cast<size_t>(std::min<uint64_t>(added, window)); }
+
+        void Add(double value) {
+            uint64_t index = added++;
+            size_t slot = static_cast<size_t>(index % window);
+            if (index < window) {
+                double delta = value - mean;
+                mean += delta / static_cast<double>(index + 1);
+                m2 += delta * (value - mean);
+            } else {
+                // 이동 Welford: 빠지는 값 old, 들어오는 값 value
+                double old = values[slot];
+                double previousMean = mean;
+                mean += (value - old) / static_cast<double>(window);
+                m2 += (value - old) * (value - mean + old - previousMean);
+                if (m2 < 0.0) m2 = 0.0;
+            }
+            values[slot] = value;
+            if (index >= window && slot == window - 1) Recompute();
+
+            PushMonotonic(minQueue, minHead, minTail, index, [&](double back) { return back >= value; });
+            PushMonotonic(maxQueue, maxHead, maxTail, index, [&](double back) { return back <= value; });
+        }
+
+        double Minimum() const { return added ? values[static_cast<size_t>(minQueue[minHead % window] % window)] : 0.0; }
+        double Maximum() const { return added ? values[static_cast<size_t>(maxQueue[maxHead % window] % window)] : 0.0; }
+        double Mean() const { return mean; }
+        double Variance() const { return Count() ? m2 / static_cast<double>(Count()) : 0.0; }
+
+        void Reset() {
+            added = 0;
+            mean = 0.0;
+            m2 = 0.0;
+            minHead = minTail = maxHead = maxTail = 0;
+        }
+
+    private:
+        size_t window;
+        std::vector<double> values;             // 최근 window개 (index % window)
+        std::vector<uint64_t> minQueue;         // 값이 오름차순인 샘플 번호 (고리, [head, tail))
+        std::vector<uint64_t> maxQueue;         // 값이 내림차순인 샘플 번호
+        uint64_t minHead = 0, minTail = 0;
+        uint64_t maxHead = 0, maxTail = 0;
+        uint64_t added = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        template<typename Dominated>
+        void PushMonotonic(std::vector<uint64_t>& queue, uint64_t& head, uint64_t& tail, uint64_t index, Dominated dominated) {
+            // 창에서 빠진 앞쪽 번호 제거, 새 값보다 나쁜 뒤쪽 번호 제거
+            while (head < tail && queue[head % window] + window <= index) ++head;
+            while (head < tail && dominated(values[static_cast<size_t>(queue[(tail - 1) % window] % window)])) --tail;
+            queue[tail % window] = index;
+            ++tail;
+        }
+
+        // 누적 오차를 없애려고 window개마다 창 전체로 평균/분산을 다시 계산 (분할 상환 상수 시간)
+        void Recompute() {
+            double sum = 0.0;
+            for (double value : values) sum += value;
+            mean = sum / static_cast<double>(window);
+            double squares = 0.0;
+            for (double value : values) squares += (value - mean) * (value - mean);
+            m2 = squares;
+        }
+    };
+}
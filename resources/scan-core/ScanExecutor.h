@@ -0,0 +1,376 @@
+#pragma once
+/*
+ * 영역 병렬 스캔 실행기 (work-stealing)
+ *
+ * 커밋된 메모리 영역들을 고정 크기 작업 단위(기본 1MB)로 나누고, 여러 워커 스레드가 나누어 스캔합니다.
+ * - 각 워커는 자기 큐의 앞에서 작업을 꺼내고, 비면 다른 워커 큐의 뒤에서 훔쳐옵니다.
+ * - 작업 단위 사이에 걸친 값/패턴을 놓치지 않도록 overlap 바이트만큼 더 읽고,
+ *   단위 끝을 넘어가는 위치에서 시작하는 결과는 다음 단위의 몫으로 버립니다.
+ * - 워커별 결과 목록은 작업 단위 순서로 이어 붙여 전체 결과가 주소 오름차순이 되도록 합니다.
+ *
+ * ScanControl을 연결하면 다른 스레드에서 진행률(처리한 바이트, 찾은 수)을 읽고, 취소하거나 시간 예산을 걸 수 있습니다.
+ * 중단은 작업 단위 사이에서만 일어나며, 끝내지 못한 단위는 GetPendingUnits()로 받아 나중에 이어서 스캔합니다.
+ *
+ * 실행기는 메모리를 어떻게 읽고 무엇을 찾는지 모릅니다. 읽기 함수와 스캔 함수를 받아서 사용하므로
+ * 값 스캔, 패턴 스캔, FPS/카메라 스캐너 모두 같은 실행기를 사용할 수 있습니다.
+ *
+ * 사용 예:
+ *   ScanCore::ScanExecutor executor({ 0, 1024 * 1024, sizeof(int) - 1 });
+ *   auto hits = executor.Run(regions, readFn, [&](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+ *       ScanCore::FindExact<int>(data, size, 100, base, out);
+ *   });
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ScanCore {
+
+    // 스캔 대상 메모리 영역 (대상 프로세스 주소 기준)
+    struct MemoryRange {
+        uintptr_t base = 0;
+        size_t size = 0;
+    };
+
+    struct ScanExecutorConfig {
+        size_t threadCount = 0;            // 0 = std::thread::hardware_concurrency()
+        size_t chunkSize = 1024 * 1024;    // 작업 단위 크기
+        size_t overlap = 0;                // 단위 경계에 걸친 결과를 찾기 위해 더 읽을 바이트 (보통 패턴 길이 - 1)
+    };
+
+    /**
+     * 스캔 진행률과 중단 요청. 스캔하는 스레드가 갱신하고 다른 스레드(UI, 오버레이)가 읽습니다.
+     * 취소와 시간 예산은 협력적입니다: 실행기는 작업 단위를 시작하기 전에만 확인합니다.
+     */
+    class ScanControl {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        ScanControl() = default;
+        ScanControl(const ScanControl&) = delete;
+        ScanControl& operator=(const ScanControl&) = delete;
+
+        void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+        bool Cancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+        // 지금부터 budget이 지나면 만료. 0이면 제한 없음
+        void SetBudget(std::chrono::milliseconds budget) {
+            deadline.store(budget.count() > 0 ? (Clock::now() + budget).time_since_epoch().count() : 0, std::memory_order_relaxed);
+        }
+
+        bool Expired() const {
+            Clock::rep limit = deadline.load(std::memory_order_relaxed);
+            return limit != 0 && Clock::now().time_since_epoch().count() >= limit;
+        }
+
+        bool ShouldStop() const { return Cancelled() || Expired(); }
+
+        // 스캔 쪽에서 호출
+        void AddTotal(size_t bytes) { bytesTotal.fetch_add(bytes, std::memory_order_relaxed); }
+        void AddDone(size_t bytes) { bytesDone.fetch_add(bytes, std::memory_order_relaxed); }
+        void AddHits(size_t count) { hits.fetch_add(count, std::memory_order_relaxed); }
+        void MarkStopped() { stopped.store(true, std::memory_order_relaxed); }
+
+        size_t BytesTotal() const { return bytesTotal.load(std::memory_order_relaxed); }
+        size_t BytesDone() const { return bytesDone.load(std::memory_order_relaxed); }
+        size_t Hits() const { return hits.load(std::memory_order_relaxed); }
+
+        // 끝내지 못한 작업을 남기고 멈췄는지 (취소 또는 시간 초과)
+        bool Stopped() const { return stopped.load(std::memory_order_relaxed); }
+
+        // 0.0 ~ 1.0 (전체 크기를 모르면 0)
+        double Fraction() const {
+            size_t total = BytesTotal();
+            return total ? std::min(1.0, static_cast<double>(BytesDone()) / static_cast<double>(total)) : 0.0;
+        }
+
+    private:
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> stopped{false};
+        std::atomic<Clock::rep> deadline{0};
+        std::atomic<size_t> bytesTotal{0};
+        std::atomic<size_t> bytesDone{0};
+        std::atomic<size_t> hits{0};
+    };
+
+    class ScanExecutor {
+    public:
+        // address에서 size 바이트를 buffer로 읽고, 실제로 읽은 바이트 수를 bytesRead에 기록
+        using ReadFunction = std::function<bool(uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead)>;
+        // data[0..size)를 스캔하여 찾은 주소(baseAddress + 오프셋)를 오름차순으로 out에 추가
+        using ChunkScanFunction = std::function<void(const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out)>;
+
+        struct WorkUnit {
+            uintptr_t base = 0;
+            size_t size = 0;        // 이 단위가 "소유"하는 바이트 수
+            size_t readSize = 0;    // overlap을 포함해 실제로 읽을 바이트 수 (영역 끝을 넘지 않음)
+        };
+
+        struct Stats {
+            size_t unitCount = 0;
+            size_t stolenUnits = 0;
+            size_t failedReads = 0;
+            size_t bytesScanned = 0;
+            size_t threadCount = 0;
+            size_t pendingUnits = 0;    // 중단되어 스캔하지 못한 단위 수
+        };
+
+        explicit ScanExecutor(const ScanExecutorConfig& config = ScanExecutorConfig()) : config(config) {
+            if (this->config.chunkSize == 0) this->config.chunkSize = 1024 * 1024;
+        }
+
+        const ScanExecutorConfig& GetConfig() const { return config; }
+        void SetThreadCount(size_t count) { config.threadCount = count; }
+        void SetChunkSize(size_t size) { config.chunkSize = size ? size : config.chunkSize; }
+        void SetOverlap(size_t bytes) { config.overlap = bytes; }
+        const Stats& GetLastStats() const { return lastStats; }
+
+        // 진행률/취소/시간 예산 연결 (nullptr = 없음). control은 실행이 끝날 때까지 살아 있어야 함
+        void SetControl(ScanControl* scanControl) { control = scanControl; }
+        ScanControl* GetControl() const { return control; }
+
+        // 마지막 실행에서 중단되어 스캔하지 못한 작업 단위 (주소 순서). Run/RunUnits에 그대로 넘기면 이어서 스캔
+        const std::vector<WorkUnit>& GetPendingUnits() const { return pendingUnits; }
+
+        size_t ResolveThreadCount(size_t unitCount) const {
+            size_t threads = config.threadCount;
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+                if (threads == 0) threads = 1;
+            }
+            return std::max<size_t>(1, std::min(threads, unitCount));
+        }
+
+        // 영역들을 작업 단위로 분할 (영역 순서 = 주소 순서 유지)
+        std::vector<WorkUnit> SplitIntoUnits(const std::vector<MemoryRange>& ranges) const {
+            std::vector<WorkUnit> units;
+            for (const MemoryRange& range : ranges) {
+                for (size_t offset = 0; offset < range.size; offset += config.chunkSize) {
+                    WorkUnit unit;
+                    unit.base = range.base + offset;
+                    unit.size = std::min(config.chunkSize, range.size - offset);
+                    unit.readSize = std::min(unit.size + config.overlap, range.size - offset);
+                    units.push_back(unit);
+                }
+            }
+            return units;
+        }
+
+        // 모든 영역을 스캔하고 주소 오름차순으로 정렬된 결과를 반환
+        std::vector<uintptr_t> Run(std::vector<MemoryRange> ranges, const ReadFunction& read, const ChunkScanFunction& scan) {
+            return Run(PrepareUnits(ranges), read, scan);
+        }
+
+        // 작업 단위를 직접 넘기는 실행 (이어서 스캔할 때 GetPendingUnits()의 결과. overlap은 단위에 이미 들어 있음)
+        std::vector<uintptr_t> Run(const std::vector<WorkUnit>& units, const ReadFunction& read, const ChunkScanFunction& scan) {
+            ResetStats(units.size());
+            if (units.empty()) return {};
+
+            std::vector<WorkerResult> results(ResolveThreadCount(units.size()));
+            Execute(units, read, [&](size_t self, size_t unitIndex, const uint8_t* data, size_t size) {
+                const WorkUnit& unit = units[unitIndex];
+                WorkerResult& result = results[self];
+                size_t begin = result.hits.size();
+                scan(data, size, unit.base, result.hits);
+
+                // overlap 구간에서 시작하는 결과는 다음 단위가 보고하므로 제거
+                uintptr_t unitEnd = unit.base + unit.size;
+                auto ownedEnd = std::remove_if(result.hits.begin() + begin, result.hits.end(),
+                                               [unitEnd](uintptr_t address) { return address >= unitEnd; });
+                result.hits.erase(ownedEnd, result.hits.end());
+                if (control) control->AddHits(result.hits.size() - begin);
+
+                result.spans.push_back({unitIndex, begin, result.hits.size()});
+            });
+            return MergeResults(results, units.size());
+        }
+
+        /**
+         * 작업 단위마다 사용자 정의 결과(UnitResult)를 만드는 실행.
+         * scan(data, size, unit, result)는 data[0..size)를 보고 unit이 소유한 [unit.base, unit.base + unit.size)
+         * 범위의 결과만 result에 기록해야 합니다. 반환 값은 주소 순서(작업 단위 순서)로 정렬되어 있으며,
+         * 읽기에 실패했거나 중단되어 스캔하지 못한 단위는 기본 생성된 UnitResult로 남습니다.
+         * 결과를 압축 저장소 조각으로 만들 때처럼 중간 주소 목록 없이 병합하고 싶을 때 사용합니다.
+         */
+        template<typename UnitResult, typename UnitScanFunction>
+        std::vector<UnitResult> RunUnits(std::vector<MemoryRange> ranges, const ReadFunction& read, UnitScanFunction scan) {
+            return RunUnits<UnitResult>(PrepareUnits(ranges), read, scan);
+        }
+
+        // 작업 단위를 직접 넘기는 실행. 반환 값은 units와 같은 순서
+        template<typename UnitResult, typename UnitScanFunction>
+        std::vector<UnitResult> RunUnits(const std::vector<WorkUnit>& units, const ReadFunction& read, UnitScanFunction scan) {
+            ResetStats(units.size());
+            std::vector<UnitResult> results(units.size());
+            if (units.empty()) return results;
+
+            Execute(units, read, [&](size_t, size_t unitIndex, const uint8_t* data, size_t size) {
+                scan(data, size, units[unitIndex], results[unitIndex]);
+            });
+            return results;
+        }
+
+    private:
+        struct WorkerQueue {
+            std::mutex lock;
+            std::deque<size_t> units;
+        };
+
+        // 한 작업 단위의 결과가 워커 결과 목록의 어디에 있는지
+        struct HitSpan {
+            size_t unitIndex;
+            size_t begin;
+            size_t end;
+        };
+
+        struct WorkerResult {
+            std::vector<uintptr_t> hits;
+            std::vector<HitSpan> spans;
+        };
+
+        ScanExecutorConfig config;
+        Stats lastStats;
+        ScanControl* control = nullptr;
+        std::vector<WorkUnit> pendingUnits;
+
+        std::vector<WorkUnit> PrepareUnits(std::vector<MemoryRange>& ranges) {
+            std::sort(ranges.begin(), ranges.end(), [](const MemoryRange& a, const MemoryRange& b) { return a.base < b.base; });
+            return SplitIntoUnits(ranges);
+        }
+
+        void ResetStats(size_t unitCount) {
+            lastStats = Stats();
+            lastStats.unitCount = unitCount;
+            pendingUnits.clear();
+        }
+
+        // 워커 스레드를 띄워 모든 작업 단위를 읽고 body(워커 번호, 단위 번호, 데이터, 크기)를 호출
+        template<typename Body>
+        void Execute(const std::vector<WorkUnit>& units, const ReadFunction& read, Body body) {
+            size_t threadCount = ResolveThreadCount(units.size());
+            lastStats.threadCount = threadCount;
+
+            // 워커별 큐: 연속된 단위 묶음을 나눠 주어 초기에는 지역성이 좋게 시작
+            std::vector<WorkerQueue> queues(threadCount);
+            for (size_t i = 0; i < units.size(); ++i) {
+                queues[i * threadCount / units.size()].units.push_back(i);
+            }
+
+            std::atomic<size_t> stolen{0};
+            std::atomic<size_t> failed{0};
+            std::atomic<size_t> scanned{0};
+
+            // 단위마다 한 워커만 기록하므로 원자 변수가 아니어도 됨 (join 뒤에 읽음)
+            std::vector<uint8_t> finished(control ? units.size() : 0, 0);
+            if (control) {
+                size_t total = 0;
+                for (const WorkUnit& unit : units) total += unit.size;
+                control->AddTotal(total);
+            }
+
+            auto worker = [&](size_t self) {
+                std::vector<uint8_t> buffer(MaxReadSize(units));
+                size_t unitIndex;
+                while (!(control && control->ShouldStop()) && TakeWork(queues, self, unitIndex, stolen)) {
+                    const WorkUnit& unit = units[unitIndex];
+                    size_t bytesRead = 0;
+                    if (!read(unit.base, buffer.data(), unit.readSize, bytesRead) || bytesRead == 0) {
+                        failed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        body(self, unitIndex, buffer.data(), std::min(bytesRead, unit.readSize));
+                        scanned.fetch_add(std::min(bytesRead, unit.size), std::memory_order_relaxed);
+                    }
+                    if (control) {
+                        finished[unitIndex] = 1;
+                        control->AddDone(unit.size);
+                    }
+                }
+            };
+
+            if (threadCount == 1) {
+                worker(0);
+            } else {
+                std::vector<std::thread> threads;
+                threads.reserve(threadCount);
+                for (size_t t = 0; t < threadCount; ++t) {
+                    threads.emplace_back(worker, t);
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            lastStats.stolenUnits = stolen.load();
+            lastStats.failedReads = failed.load();
+            lastStats.bytesScanned = scanned.load();
+
+            for (size_t i = 0; i < finished.size(); ++i) {
+                if (!finished[i]) pendingUnits.push_back(units[i]);
+            }
+            lastStats.pendingUnits = pendingUnits.size();
+            if (!pendingUnits.empty()) control->MarkStopped();
+        }
+
+        static size_t MaxReadSize(const std::vector<WorkUnit>& units) {
+            size_t maxSize = 0;
+            for (const WorkUnit& unit : units) maxSize = std::max(maxSize, unit.readSize);
+            return maxSize;
+        }
+
+        static bool TakeWork(std::vector<WorkerQueue>& queues, size_t self, size_t& unitIndex, std::atomic<size_t>& stolen) {
+            {
+                std::lock_guard<std::mutex> guard(queues[self].lock);
+                if (!queues[self].units.empty()) {
+                    unitIndex = queues[self].units.front();
+                    queues[self].units.pop_front();
+                    return true;
+                }
+            }
+            // 자기 큐가 비었으면 다른 워커의 뒤쪽(가장 나중에 처리될 작업)을 훔침
+            for (size_t n = 1; n < queues.size(); ++n) {
+                WorkerQueue& victim = queues[(self + n) % queues.size()];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (!victim.units.empty()) {
+                    unitIndex = victim.units.back();
+                    victim.units.pop_back();
+                    stolen.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // 작업 단위는 주소 순서로 번호가 매겨져 있으므로 단위 순서대로 이어 붙이면 정렬된 결과가 됨
+        static std::vector<uintptr_t> MergeResults(std::vector<WorkerResult>& results, size_t unitCount) {
+            struct SpanRef {
+                const std::vector<uintptr_t>* hits = nullptr;
+                size_t begin = 0;
+                size_t end = 0;
+            };
+            std::vector<SpanRef> byUnit(unitCount);
+            size_t total = 0;
+            for (const WorkerResult& result : results) {
+                for (const HitSpan& span : result.spans) {
+                    byUnit[span.unitIndex] = {&result.hits, span.begin, span.end};
+                    total += span.end - span.begin;
+                }
+            }
+
+            std::vector<uintptr_t> merged;
+            merged.reserve(total);
+            for (const SpanRef& span : byUnit) {
+                if (!span.hits) continue;
+                merged.insert(merged.end(), span.hits->begin() + span.begin, span.hits->begin() + span.end);
+            }
+            return merged;
+        }
+    };
+}
@@ -0,0 +1,122 @@
+#pragma once
+/*
+ * 비동기 스캔 작업 (진행률, 취소, 시간 예산)
+ *
+ * 스캔 함수를 백그라운드 스레드에서 실행하고 바로 작업 핸들(ScanJob)을 돌려줍니다.
+ * 오버레이나 트레이너는 프레임마다 Progress()로 진행률을 읽고, 필요하면 Cancel()로 멈추며,
+ * 끝났는지는 Ready()/WaitFor()로 확인합니다. 호출한 스레드는 스캔 동안 멈추지 않습니다.
+ *
+ * 스캔 함수는 ScanControl&를 받습니다. ScanExecutor에 SetControl()로 연결하면 진행률/취소/시간 예산이
+ * 자동으로 적용되고, RegionStream 같은 직접 만든 루프에서는 청크마다 AddDone()과 ShouldStop()을 호출합니다.
+ * 중단되면 끝낸 작업 단위까지의 결과가 그대로 반환되고, 남은 단위(GetPendingUnits)로 나중에 이어서 스캔합니다.
+ *
+ * 사용 예:
+ *   auto job = ScanCore::StartScanJob([&](ScanCore::ScanControl& control) {
+ *       ScanCore::ScanExecutor executor = prototype;     // 작업마다 실행기 복사본 사용
+ *       executor.SetControl(&control);
+ *       ScanCore::PartialScan<std::vector<uintptr_t>> result;
+ *       result.value = executor.Run(ranges, readFn, scanFn);
+ *       result.pending = executor.GetPendingUnits();
+ *       return result;
+ *   }, std::chrono::milliseconds(500));                   // 0.5초 안에 끝내지 못하면 부분 결과
+ *
+ *   while (!job.Ready()) DrawProgress(job.Progress().Fraction(), job.Progress().Hits());
+ *   auto partial = job.Get();
+ *   if (!partial.Complete()) { ... executor.Run(partial.pending, readFn, scanFn) 로 이어서 ... }
+ */
+
+#include "ScanExecutor.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ScanCore {
+
+    // 부분 결과 + 이어서 스캔할 작업 단위
+    template<typename Value>
+    struct PartialScan {
+        Value value{};
+        std::vector<ScanExecutor::WorkUnit> pending;
+
+        bool Complete() const { return pending.empty(); }
+    };
+
+    template<typename Result>
+    class ScanJob {
+    public:
+        ScanJob() = default;
+        ScanJob(std::shared_ptr<ScanControl> control, std::future<Result> future)
+            : control(std::move(control)), future(std::move(future)) {}
+        ScanJob(ScanJob&&) = default;
+        ScanJob& operator=(ScanJob&& other) {
+            Abandon();
+            control = std::move(other.control);
+            future = std::move(other.future);
+            return *this;
+        }
+
+        // 끝나지 않은 작업을 버리면 취소하고 멈출 때까지 기다림 (스캔 함수가 참조하는 객체보다 먼저 끝나도록)
+        ~ScanJob() { Abandon(); }
+
+        bool Valid() const { return future.valid(); }
+
+        bool Ready() const {
+            return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        // timeout 동안 기다려 끝났으면 true
+        bool WaitFor(std::chrono::milliseconds timeout) const {
+            return future.valid() && future.wait_for(timeout) == std::future_status::ready;
+        }
+
+        // 끝날 때까지 기다려 결과를 받음 (한 번만 호출 가능. 스캔 함수의 예외는 여기서 다시 던져짐)
+        Result Get() { return future.get(); }
+
+        void Cancel() {
+            if (control) control->Cancel();
+        }
+
+        const ScanControl& Progress() const { return *control; }
+
+    private:
+        std::shared_ptr<ScanControl> control;
+        std::future<Result> future;
+
+        void Abandon() {
+            if (!future.valid()) return;
+            Cancel();
+            future.wait();
+        }
+    };
+
+    /**
+     * body(ScanControl&)를 새 스레드에서 실행하고 작업 핸들을 반환합니다.
+     * budget > 0이면 시작부터 budget이 지나면 ShouldStop()이 true가 되어 부분 결과를 반환합니다.
+     * body가 참조하는 객체(실행기, 읽기 함수의 대상)는 작업이 끝날 때까지 살아 있어야 합니다.
+     */
+    template<typename Body>
+    ScanJob<std::invoke_result_t<Body&, ScanControl&>> StartScanJob(Body body, std::chrono::milliseconds budget = std::chrono::milliseconds(0)) {
+        using Result = std::invoke_result_t<Body&, ScanControl&>;
+        std::shared_ptr<ScanControl> control = std::make_shared<ScanControl>();
+        control->SetBudget(budget);
+        std::future<Result> future = std::async(std::launch::async,
+            [control, body = std::move(body)]() mutable { return body(*control); });
+        return ScanJob<Result>(std::move(control), std::move(future));
+    }
+
+    /**
+     * 작업이 끝날 때까지 interval마다 tick(progress)을 호출하고 결과를 반환합니다.
+     * tick이 false를 반환하면 취소를 요청합니다 (콘솔에서 ESC로 중단할 때 등).
+     */
+    template<typename Result, typename Tick>
+    Result WaitScanJob(ScanJob<Result>& job, std::chrono::milliseconds interval, Tick tick) {
+        while (!job.WaitFor(interval)) {
+            if (!tick(job.Progress())) job.Cancel();
+        }
+        return job.Get();
+    }
+}
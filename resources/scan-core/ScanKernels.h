@@ -0,0 +1,296 @@
+#pragma once
+/*
+ * 스캔 커널 (SIMD 정확 일치 검색)
+ *
+ * 메모리 버퍼에서 특정 값(int8/16/32/64, float, double)이 나타나는 모든 바이트 오프셋을 찾습니다.
+ * 기존 스칼라 루프처럼 정렬되지 않은 위치의 값까지 모두 보고하며, 결과는 항상 오름차순입니다.
+ *
+ * 커널 선택:
+ * - AVX2: 32바이트 블록 단위 (런타임에 CPU/OS 지원 확인)
+ * - SSE2: 16바이트 블록 단위 (x86/x64 기본)
+ * - Scalar: 그 외 아키텍처 또는 강제 지정 시
+ *
+ * 원리:
+ * 값을 바이트 배열 v[0..S) 로 보고, 블록 시작 i에 대해 (i + j)에서 로드한 벡터를 v[j]와 바이트 비교합니다.
+ * j = 0..S-1 의 비교 결과를 AND 하면 비트 b가 "오프셋 i + b에서 값 전체가 일치"를 뜻하게 됩니다.
+ * 가장 드문 바이트부터 비교하고, 중간 결과가 0이면 블록을 바로 건너뜁니다.
+ *
+ * float/double은 스칼라 == 와 같은 의미를 유지합니다:
+ * NaN은 어디에도 일치하지 않고, 0.0 검색은 +0.0과 -0.0을 모두 찾습니다(부호 비트 마스킹).
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define SCANCORE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(SCANCORE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SCANCORE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SCANCORE_TARGET_AVX2
+#endif
+
+namespace ScanCore {
+
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    inline const char* SimdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::SSE2: return "SSE2";
+            default: return "Scalar";
+        }
+    }
+
+    // 커널이 지원하는 값 타입
+    template<typename T>
+    struct IsKernelType : std::integral_constant<bool,
+        (std::is_integral<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+        std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+    // CPU와 OS가 지원하는 최고 수준의 SIMD 확인
+    inline SimdLevel DetectSimdLevel() {
+#if defined(SCANCORE_X86)
+#if defined(_MSC_VER)
+        int info[4] = {};
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx) {
+            // OS가 YMM 레지스터 상태를 저장하는지 확인 (XCR0 비트 1, 2)
+            if ((_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+        }
+        if (avx2) return SimdLevel::AVX2;
+        if (sse2) return SimdLevel::SSE2;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    // 프로세스 전체에서 한 번만 감지
+    inline SimdLevel ActiveSimdLevel() {
+        static const SimdLevel level = DetectSimdLevel();
+        return level;
+    }
+
+    namespace Detail {
+
+        template<typename T>
+        inline T LoadUnaligned(const uint8_t* p) {
+            T value;
+            memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        inline unsigned CountTrailingZeros(uint32_t bits) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+        }
+
+        // 블록 내 일치 비트를 오름차순 주소로 출력
+        inline void EmitHits(uint32_t hits, uintptr_t blockAddress, std::vector<uintptr_t>& out) {
+            while (hits) {
+                out.push_back(blockAddress + CountTrailingZeros(hits));
+                hits &= hits - 1;
+            }
+        }
+
+        // 바이트 단위 검색 조건: (data[i + offset[n]] & mask[n]) == bytes[n]
+        // 드문 바이트가 앞에 오도록 정렬되어 있어 조기 탈출이 잘 됩니다.
+        struct ByteNeedle {
+            size_t length = 0;
+            size_t count = 0;
+            uint8_t offset[8] = {};
+            uint8_t bytes[8] = {};
+            uint8_t mask[8] = {};
+        };
+
+        // 메모리에서 흔한 바이트(0x00, 0xFF)일수록 뒤로 보냄
+        inline int ByteRarityRank(uint8_t value, uint8_t mask) {
+            if (mask != 0xFF) return 3;
+            if (value == 0x00) return 2;
+            if (value == 0xFF) return 1;
+            return 0;
+        }
+
+        template<typename T>
+        inline ByteNeedle MakeNeedle(T value) {
+            ByteNeedle needle;
+            uint8_t raw[sizeof(T)];
+            memcpy(raw, &value, sizeof(T));
+            uint8_t rawMask[sizeof(T)];
+            memset(rawMask, 0xFF, sizeof(T));
+
+            if constexpr (std::is_floating_point<T>::value) {
+                // -0.0 == +0.0: 부호 비트(최상위 바이트의 0x80)를 무시
+                if (value == T(0)) {
+                    memset(raw, 0, sizeof(T));
+                    rawMask[sizeof(T) - 1] = 0x7F;
+                }
+            }
+
+            needle.length = sizeof(T);
+            needle.count = sizeof(T);
+            for (int rank = 0, n = 0; rank <= 3; ++rank) {
+                for (size_t j = 0; j < sizeof(T); ++j) {
+                    if (ByteRarityRank(raw[j], rawMask[j]) != rank) continue;
+                    needle.offset[n] = static_cast<uint8_t>(j);
+                    needle.bytes[n] = raw[j];
+                    needle.mask[n] = rawMask[j];
+                    ++n;
+                }
+            }
+            return needle;
+        }
+
+        inline bool MatchesNeedleAt(const uint8_t* p, const ByteNeedle& needle) {
+            for (size_t n = 0; n < needle.count; ++n) {
+                if ((p[needle.offset[n]] & needle.mask[n]) != needle.bytes[n]) return false;
+            }
+            return true;
+        }
+
+        // 기준 구현: 기존 스캐너의 바이트 단위 루프와 동일
+        template<typename T>
+        inline void ScanScalarValue(const uint8_t* data, size_t size, T value,
+                                    uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            for (size_t i = 0; i + sizeof(T) <= size; ++i) {
+                if (LoadUnaligned<T>(data + i) == value) {
+                    out.push_back(baseAddress + i);
+                }
+            }
+        }
+
+        inline void ScanScalarRange(const uint8_t* data, size_t begin, size_t size, const ByteNeedle& needle,
+                                    uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            if (size < needle.length) return;
+            for (size_t i = begin; i + needle.length <= size; ++i) {
+                if (MatchesNeedleAt(data + i, needle)) {
+                    out.push_back(baseAddress + i);
+                }
+            }
+        }
+
+#if defined(SCANCORE_X86)
+        inline void ScanSSE2(const uint8_t* data, size_t size, const ByteNeedle& needle,
+                             uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            constexpr size_t Block = 16;
+            const size_t tailReach = Block + needle.length - 1;
+            __m128i value[8] = {};
+            __m128i mask[8] = {};
+            for (size_t n = 0; n < needle.count; ++n) {
+                value[n] = _mm_set1_epi8(static_cast<char>(needle.bytes[n]));
+                mask[n] = _mm_set1_epi8(static_cast<char>(needle.mask[n]));
+            }
+
+            size_t i = 0;
+            for (; i + tailReach <= size; i += Block) {
+                const uint8_t* p = data + i;
+                __m128i eq = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + needle.offset[0])), mask[0]), value[0]);
+                if (_mm_movemask_epi8(eq) == 0) continue;
+                for (size_t n = 1; n < needle.count; ++n) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + needle.offset[n]));
+                    eq = _mm_and_si128(eq, _mm_cmpeq_epi8(_mm_and_si128(block, mask[n]), value[n]));
+                    // 두 번째 바이트 이후에는 대부분의 블록이 여기서 탈락
+                    if (n == 1 && _mm_movemask_epi8(eq) == 0) break;
+                }
+                EmitHits(static_cast<uint32_t>(_mm_movemask_epi8(eq)), baseAddress + i, out);
+            }
+            ScanScalarRange(data, i, size, needle, baseAddress, out);
+        }
+
+        SCANCORE_TARGET_AVX2 inline void ScanAVX2(const uint8_t* data, size_t size, const ByteNeedle& needle,
+                                                  uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            constexpr size_t Block = 32;
+            const size_t tailReach = Block + needle.length - 1;
+            __m256i value[8] = {};
+            __m256i mask[8] = {};
+            for (size_t n = 0; n < needle.count; ++n) {
+                value[n] = _mm256_set1_epi8(static_cast<char>(needle.bytes[n]));
+                mask[n] = _mm256_set1_epi8(static_cast<char>(needle.mask[n]));
+            }
+
+            size_t i = 0;
+            for (; i + tailReach <= size; i += Block) {
+                const uint8_t* p = data + i;
+                __m256i eq = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + needle.offset[0])), mask[0]), value[0]);
+                if (_mm256_movemask_epi8(eq) == 0) continue;
+                for (size_t n = 1; n < needle.count; ++n) {
+                    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + needle.offset[n]));
+                    eq = _mm256_and_si256(eq, _mm256_cmpeq_epi8(_mm256_and_si256(block, mask[n]), value[n]));
+                    if (n == 1 && _mm256_movemask_epi8(eq) == 0) break;
+                }
+                EmitHits(static_cast<uint32_t>(_mm256_movemask_epi8(eq)), baseAddress + i, out);
+            }
+            ScanScalarRange(data, i, size, needle, baseAddress, out);
+        }
+#endif
+
+        inline void ScanNeedle(const uint8_t* data, size_t size, const ByteNeedle& needle,
+                               uintptr_t baseAddress, std::vector<uintptr_t>& out, SimdLevel level) {
+#if defined(SCANCORE_X86)
+            if (level == SimdLevel::AVX2) {
+                ScanAVX2(data, size, needle, baseAddress, out);
+                return;
+            }
+            if (level == SimdLevel::SSE2) {
+                ScanSSE2(data, size, needle, baseAddress, out);
+                return;
+            }
+#else
+            (void)level;
+#endif
+            ScanScalarRange(data, 0, size, needle, baseAddress, out);
+        }
+    }
+
+    /**
+     * 버퍼에서 value와 정확히 일치하는 모든 오프셋을 찾아 (baseAddress + 오프셋)을 out에 추가합니다.
+     * 결과는 오름차순이며 `*(T*)&data[i] == value` 스칼라 루프와 동일합니다. 추가된 개수를 반환합니다.
+     */
+    template<typename T>
+    size_t FindExact(const uint8_t* data, size_t size, T value, uintptr_t baseAddress,
+                     std::vector<uintptr_t>& out, SimdLevel level = ActiveSimdLevel()) {
+        static_assert(IsKernelType<T>::value, "FindExact supports int8/16/32/64, float and double");
+        if constexpr (std::is_floating_point<T>::value) {
+            if (std::isnan(value)) return 0;
+        }
+        size_t before = out.size();
+        if (level == SimdLevel::Scalar) {
+            Detail::ScanScalarValue<T>(data, size, value, baseAddress, out);
+            return out.size() - before;
+        }
+        Detail::ScanNeedle(data, size, Detail::MakeNeedle(value), baseAddress, out, level);
+        return out.size() - before;
+    }
+}
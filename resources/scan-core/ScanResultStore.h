@@ -0,0 +1,392 @@
+#pragma once
+/*
+ * 압축 스캔 결과 저장소
+ *
+ * 0이나 1 같은 흔한 값을 첫 스캔하면 수억 개의 주소가 나옵니다.
+ * std::vector<uintptr_t> + std::map<uintptr_t, std::vector<uint8_t>> 조합은 결과 하나당 100바이트 이상을 쓰므로,
+ * 이 저장소는 주소 공간을 64KB 블록(region)으로 나누고 블록마다 더 작은 인코딩을 고릅니다.
+ *
+ * - 비트맵: 블록 내 바이트 오프셋마다 1비트 (결과가 빽빽할 때, 블록당 8KB 고정)
+ * - 델타 목록: 이전 결과와의 오프셋 차이를 varint로 기록 (결과가 드물 때, 결과당 1~3바이트)
+ * - 이전 값: 결과 순서대로 valueSize 바이트씩 붙여 둔 packed 배열
+ *
+ * 저장소는 불변이며 Builder로 주소 오름차순으로 추가해서 만듭니다.
+ *
+ * 사용 예:
+ *   ScanCore::ScanResultStore::Builder builder(sizeof(int));
+ *   builder.Append(address, &value);
+ *   ScanCore::ScanResultStore store = builder.Finish();
+ *   for (const auto& entry : store) { entry.address; entry.value; }
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ScanCore {
+
+    class ScanResultStore {
+    public:
+        static constexpr unsigned BlockShift = 16;
+        static constexpr size_t BlockSize = static_cast<size_t>(1) << BlockShift;
+        static constexpr size_t BitmapBytes = BlockSize / 8;
+
+        enum class Encoding : uint8_t {
+            Bitmap,
+            DeltaList
+        };
+
+        // 블록 하나의 헤더
+        struct RegionBlock {
+            uintptr_t base = 0;           // BlockSize 정렬된 블록 시작 주소
+            uint64_t encodedOffset = 0;   // encoded 배열 내 위치
+            uint64_t firstIndex = 0;      // 이 블록 첫 결과의 전체 순번 (values 배열 인덱스)
+            uint32_t encodedSize = 0;
+            uint32_t hitCount = 0;
+            Encoding encoding = Encoding::DeltaList;
+        };
+
+        struct Entry {
+            uintptr_t address;
+            const uint8_t* value;   // valueSize == 0이면 nullptr
+            size_t index;
+        };
+
+        class Builder;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Entry;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Entry*;
+            using reference = Entry;
+
+            const_iterator() = default;
+
+            Entry operator*() const {
+                const RegionBlock& block = store->blocks[blockIndex];
+                const uint8_t* value = store->valueSize ? store->values.data() + index * store->valueSize : nullptr;
+                return {block.base + offset, value, index};
+            }
+
+            const_iterator& operator++() {
+                Advance();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator copy = *this;
+                Advance();
+                return copy;
+            }
+
+            bool operator==(const const_iterator& other) const { return blockIndex == other.blockIndex && index == other.index; }
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+        private:
+            friend class ScanResultStore;
+            friend class Builder;
+
+            const ScanResultStore* store = nullptr;
+            size_t blockIndex = 0;
+            size_t index = 0;
+            size_t cursor = 0;      // 델타 목록의 다음 읽기 위치
+            uint32_t offset = 0;    // 현재 결과의 블록 내 오프셋
+
+            const_iterator(const ScanResultStore* owner, size_t block) : store(owner), blockIndex(block) {
+                if (blockIndex < store->blocks.size()) {
+                    index = static_cast<size_t>(store->blocks[blockIndex].firstIndex);
+                    LoadFirstInBlock();
+                } else {
+                    index = store->count;
+                }
+            }
+
+            void LoadFirstInBlock() {
+                const RegionBlock& block = store->blocks[blockIndex];
+                const uint8_t* data = store->encoded.data() + block.encodedOffset;
+                if (block.encoding == Encoding::Bitmap) {
+                    offset = NextSetBit(data, 0);
+                } else {
+                    cursor = 0;
+                    offset = ReadVarint(data, cursor);
+                }
+            }
+
+            void Advance() {
+                const RegionBlock& block = store->blocks[blockIndex];
+                ++index;
+                if (index == block.firstIndex + block.hitCount) {
+                    ++blockIndex;
+                    if (blockIndex < store->blocks.size()) LoadFirstInBlock();
+                    return;
+                }
+                const uint8_t* data = store->encoded.data() + block.encodedOffset;
+                if (block.encoding == Encoding::Bitmap) {
+                    offset = NextSetBit(data, offset + 1);
+                } else {
+                    offset += ReadVarint(data, cursor);
+                }
+            }
+        };
+
+        explicit ScanResultStore(size_t valueSize = 0) : valueSize(valueSize) {}
+
+        size_t Count() const { return count; }
+        bool Empty() const { return count == 0; }
+        size_t ValueSize() const { return valueSize; }
+        size_t BlockCount() const { return blocks.size(); }
+
+        // 저장소가 실제로 차지하는 힙 메모리 (바이트)
+        size_t MemoryUsage() const {
+            return blocks.capacity() * sizeof(RegionBlock) + encoded.capacity() + values.capacity();
+        }
+
+        // address가 속한 64KB 블록의 결과 수 (결과 밀도 추정용, 블록이 없으면 0)
+        size_t BlockHitCount(uintptr_t address) const {
+            uintptr_t base = address & ~static_cast<uintptr_t>(BlockSize - 1);
+            size_t low = 0, high = blocks.size();
+            while (low < high) {
+                size_t middle = (low + high) / 2;
+                if (blocks[middle].base < base) low = middle + 1; else high = middle;
+            }
+            return low < blocks.size() && blocks[low].base == base ? blocks[low].hitCount : 0;
+        }
+
+        size_t BitmapBlockCount() const {
+            size_t bitmaps = 0;
+            for (const RegionBlock& block : blocks) {
+                if (block.encoding == Encoding::Bitmap) ++bitmaps;
+            }
+            return bitmaps;
+        }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, blocks.size()); }
+
+        void Clear() {
+            blocks.clear();
+            encoded.clear();
+            values.clear();
+            count = 0;
+        }
+
+        // 처음 limit개 주소를 vector로 (표시/호환용)
+        std::vector<uintptr_t> ToAddresses(size_t limit = std::numeric_limits<size_t>::max()) const {
+            std::vector<uintptr_t> addresses;
+            addresses.reserve(count < limit ? count : limit);
+            for (const_iterator it = begin(); it != end() && addresses.size() < limit; ++it) {
+                addresses.push_back((*it).address);
+            }
+            return addresses;
+        }
+
+        // 주소 목록과 (선택적으로) 같은 순서의 packed 값 배열로 저장소 생성
+        static ScanResultStore FromAddresses(const std::vector<uintptr_t>& sortedAddresses, size_t valueSize = 0,
+                                             const uint8_t* packedValues = nullptr);
+
+    private:
+        std::vector<RegionBlock> blocks;
+        std::vector<uint8_t> encoded;
+        std::vector<uint8_t> values;
+        size_t valueSize = 0;
+        size_t count = 0;
+
+        static size_t VarintSize(uint32_t value) {
+            size_t size = 1;
+            while (value >= 0x80) {
+                value >>= 7;
+                ++size;
+            }
+            return size;
+        }
+
+        static void WriteVarint(std::vector<uint8_t>& out, uint32_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        static uint32_t ReadVarint(const uint8_t* data, size_t& cursor) {
+            uint32_t value = 0;
+            unsigned shift = 0;
+            while (true) {
+                uint8_t byte = data[cursor++];
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return value;
+                shift += 7;
+            }
+        }
+
+        // from 이상에서 처음 설정된 비트 (항상 존재한다고 가정 - hitCount로 범위를 관리)
+        static uint32_t NextSetBit(const uint8_t* bitmap, uint32_t from) {
+            size_t word = from >> 6;
+            uint64_t bits;
+            memcpy(&bits, bitmap + word * 8, 8);
+            bits &= ~static_cast<uint64_t>(0) << (from & 63);
+            while (bits == 0) {
+                ++word;
+                memcpy(&bits, bitmap + word * 8, 8);
+            }
+#if defined(_MSC_VER)
+            unsigned long bit;
+            _BitScanForward64(&bit, bits);
+            return static_cast<uint32_t>(word * 64 + bit);
+#else
+            return static_cast<uint32_t>(word * 64 + static_cast<unsigned>(__builtin_ctzll(bits)));
+#endif
+        }
+    };
+
+    /**
+     * 결과를 주소 오름차순으로 추가하여 저장소를 만듭니다.
+     * 블록이 바뀔 때마다 이전 블록을 비트맵/델타 중 작은 쪽으로 인코딩합니다.
+     */
+    class ScanResultStore::Builder {
+    public:
+        explicit Builder(size_t valueSize = 0) { store.valueSize = valueSize; }
+
+        size_t Count() const { return store.count + pendingOffsets.size(); }
+
+        // address는 이전에 추가한 주소보다 커야 함
+        void Append(uintptr_t address, const void* value = nullptr) {
+            uintptr_t blockBase = address & ~static_cast<uintptr_t>(BlockSize - 1);
+            if (!pendingOffsets.empty() && blockBase != pendingBase) {
+                FlushPending();
+            }
+            if (pendingOffsets.empty() && ContinuesLastBlock(blockBase)) ReopenLastBlock();
+            pendingBase = blockBase;
+            pendingOffsets.push_back(static_cast<uint32_t>(address - blockBase));
+            if (store.valueSize) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(value);
+                if (bytes) {
+                    store.values.insert(store.values.end(), bytes, bytes + store.valueSize);
+                } else {
+                    store.values.resize(store.values.size() + store.valueSize, 0);
+                }
+            }
+        }
+
+        // 다른 저장소(예: 작업 단위별 조각)의 결과를 이어 붙임
+        // fragment의 valueSize가 같아야 하고, 주소는 모두 지금까지의 주소 뒤여야 함
+        void Append(const ScanResultStore& fragment) {
+            for (size_t b = 0; b < fragment.blocks.size(); ++b) {
+                const RegionBlock& block = fragment.blocks[b];
+                // 앞 조각에서 통째로 복사한 블록에 이어지면 다시 열어 합침 (블록 시작 주소는 하나씩만)
+                if (pendingOffsets.empty() && ContinuesLastBlock(block.base)) ReopenLastBlock();
+                bool sharesPendingBlock = !pendingOffsets.empty() && block.base == pendingBase;
+                if (sharesPendingBlock) {
+                    // 블록이 두 조각에 걸쳐 있으면 결과 단위로 다시 인코딩
+                    const_iterator it(&fragment, b);
+                    for (uint32_t n = 0; n < block.hitCount; ++n, ++it) {
+                        Entry entry = *it;
+                        Append(entry.address, entry.value);
+                    }
+                    continue;
+                }
+                if (!pendingOffsets.empty()) FlushPending();
+
+                RegionBlock copy = block;
+                copy.encodedOffset = store.encoded.size();
+                copy.firstIndex = store.count;
+                const uint8_t* src = fragment.encoded.data() + block.encodedOffset;
+                store.encoded.insert(store.encoded.end(), src, src + block.encodedSize);
+                if (store.valueSize) {
+                    const uint8_t* values = fragment.values.data() + block.firstIndex * store.valueSize;
+                    store.values.insert(store.values.end(), values, values + static_cast<size_t>(block.hitCount) * store.valueSize);
+                }
+                store.blocks.push_back(copy);
+                store.count += block.hitCount;
+            }
+        }
+
+        ScanResultStore Finish() {
+            if (!pendingOffsets.empty()) FlushPending();
+            store.blocks.shrink_to_fit();
+            store.encoded.shrink_to_fit();
+            store.values.shrink_to_fit();
+            ScanResultStore result = std::move(store);
+            store = ScanResultStore(result.valueSize);
+            return result;
+        }
+
+    private:
+        ScanResultStore store;
+        uintptr_t pendingBase = 0;
+        std::vector<uint32_t> pendingOffsets;
+
+        bool ContinuesLastBlock(uintptr_t blockBase) const {
+            return !store.blocks.empty() && store.blocks.back().base == blockBase;
+        }
+
+        // 마지막으로 인코딩한 블록을 오프셋 목록으로 되돌림 (값은 이미 values 끝에 있음)
+        void ReopenLastBlock() {
+            RegionBlock block = store.blocks.back();
+            const_iterator it(&store, store.blocks.size() - 1);
+            for (uint32_t n = 0; n < block.hitCount; ++n, ++it) {
+                pendingOffsets.push_back(static_cast<uint32_t>((*it).address - block.base));
+            }
+            store.blocks.pop_back();
+            store.encoded.resize(static_cast<size_t>(block.encodedOffset));
+            store.count -= block.hitCount;
+            pendingBase = block.base;
+        }
+
+        void FlushPending() {
+            RegionBlock block;
+            block.base = pendingBase;
+            block.encodedOffset = store.encoded.size();
+            block.firstIndex = store.count;
+            block.hitCount = static_cast<uint32_t>(pendingOffsets.size());
+
+            size_t deltaBytes = 0;
+            uint32_t previous = 0;
+            for (size_t n = 0; n < pendingOffsets.size(); ++n) {
+                deltaBytes += VarintSize(n == 0 ? pendingOffsets[n] : pendingOffsets[n] - previous);
+                previous = pendingOffsets[n];
+            }
+
+            if (deltaBytes > BitmapBytes) {
+                block.encoding = Encoding::Bitmap;
+                size_t start = store.encoded.size();
+                store.encoded.resize(start + BitmapBytes, 0);
+                uint8_t* bitmap = store.encoded.data() + start;
+                for (uint32_t offset : pendingOffsets) {
+                    bitmap[offset >> 3] |= static_cast<uint8_t>(1u << (offset & 7));
+                }
+                block.encodedSize = static_cast<uint32_t>(BitmapBytes);
+            } else {
+                block.encoding = Encoding::DeltaList;
+                previous = 0;
+                for (size_t n = 0; n < pendingOffsets.size(); ++n) {
+                    WriteVarint(store.encoded, n == 0 ? pendingOffsets[n] : pendingOffsets[n] - previous);
+                    previous = pendingOffsets[n];
+                }
+                block.encodedSize = static_cast<uint32_t>(deltaBytes);
+            }
+
+            store.blocks.push_back(block);
+            store.count += pendingOffsets.size();
+            pendingOffsets.clear();
+        }
+    };
+
+    inline ScanResultStore ScanResultStore::FromAddresses(const std::vector<uintptr_t>& sortedAddresses, size_t valueSize,
+                                                          const uint8_t* packedValues) {
+        Builder builder(valueSize);
+        for (size_t i = 0; i < sortedAddresses.size(); ++i) {
+            builder.Append(sortedAddresses[i], packedValues ? packedValues + i * valueSize : nullptr);
+        }
+        return builder.Finish();
+    }
+}
@@ -0,0 +1,342 @@
+#pragma once
+/*
+ * 모듈 지문 기반 시그니처 해석 결과 캐시 (즉시 재연결)
+ *
+ * 도구를 붙일 때마다 시그니처/값 스캔을 처음부터 다시 하면 게임 실행마다 수 초가 걸립니다.
+ * SignatureCache는 "시그니처 이름 → 모듈 기준 RVA + 검증 바이트"를 모듈 지문과 함께 저장해 두고,
+ * 다음 연결 때 같은 빌드면 항목마다 검증 바이트를 한 번 읽어 확인만 합니다. 실패한 항목만 다시 스캔합니다.
+ *
+ * 모듈 지문 (빌드 식별):
+ * - PE: COFF 파일 헤더(TimeDateStamp 포함), 진입점, SizeOfImage, CheckSum, 섹션 표
+ *   (ImageBase처럼 로드 위치에 따라 바뀌는 값은 제외)
+ * - ELF: ELF 헤더와 프로그램 헤더
+ * - 그 외: 첫 페이지 전체
+ * - 여기에 쓰기 불가능한 실행 페이지 몇 개(samplePages)를 고르게 뽑아 함께 해시 (핫픽스 감지)
+ *
+ * 검증 바이트가 다르면(같은 빌드인데 코드가 패치됨) 항목을 지우고 miss로 처리합니다.
+ * 값 스캔으로 찾은 정적 변수처럼 바뀌지 않는 바이트가 없으면 검증 바이트 없이(길이 0) 지문만으로 저장하고,
+ * 쓰는 쪽이 hit 뒤에 직접 확인합니다.
+ *
+ * 사용 예:
+ *   ScanCore::SignatureCache cache;
+ *   cache.Load("signatures.cache");
+ *   auto modules = memory->EnumerateModules();
+ *   uintptr_t address;
+ *   if (!cache.Lookup(*memory, modules, "camera_base", address)) {
+ *       address = ScanForCamera();
+ *       cache.Store(*memory, modules, "camera_base", address, matchAddress, patternLength);
+ *   }
+ *   cache.Save("signatures.cache");
+ */
+
+#include "Hash.h"
+#include "ProcessMemory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ScanCore {
+
+    struct ModuleFingerprint {
+        uint64_t hash = 0;
+        uint64_t size = 0;
+
+        bool operator==(const ModuleFingerprint& other) const { return hash == other.hash && size == other.size; }
+        bool operator!=(const ModuleFingerprint& other) const { return !(*this == other); }
+    };
+
+    class SignatureCache {
+    public:
+        static constexpr uint32_t FileVersion = 1;
+        static constexpr size_t PageSize = 4096;
+        static constexpr size_t DefaultSamplePages = 4;
+        static constexpr size_t MaxValidationLength = 256;
+
+        struct Stats {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t invalidated = 0;     // 같은 빌드인데 검증 바이트가 달라 지운 항목
+            size_t stored = 0;
+
+            double HitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0; }
+        };
+
+        explicit SignatureCache(size_t samplePages = DefaultSamplePages) : samplePages(samplePages) {}
+
+        // 모듈 지문 (헤더 한 페이지 + samplePages개 페이지 읽기)
+        static ModuleFingerprint Fingerprint(IProcessMemory& memory, const ModuleRange& module,
+                                             size_t samplePages = DefaultSamplePages) {
+            ModuleFingerprint fingerprint;
+            fingerprint.size = module.size;
+
+            uint8_t page[PageSize];
+            size_t headerSize = std::min(PageSize, module.size);
+            size_t bytesRead = 0;
+            if (headerSize == 0 || !memory.ReadBytes(module.base, page, headerSize, bytesRead) || bytesRead != headerSize) {
+                return fingerprint;
+            }
+            uint64_t hash = HashHeaders(page, headerSize);
+
+            // 쓰기 불가능한 실행 영역에서 페이지를 고르게 뽑음
+            std::vector<MemoryRange> code;
+            size_t codeSize = 0;
+            for (uintptr_t address = module.base; address < module.base + module.size;) {
+                MemoryRegion region;
+                if (!memory.QueryRegion(address, region) || region.base + region.size <= address) {
+                    address += PageSize;
+                    continue;
+                }
+                uintptr_t begin = std::max(address, region.base);
+                uintptr_t end = std::min(region.base + region.size, module.base + module.size);
+                if (region.IsExecutable() && !(region.protection & MemoryWrite) && end - begin >= PageSize) {
+                    code.push_back({begin, end - begin});
+                    codeSize += end - begin;
+                }
+                address = end;
+            }
+            for (size_t n = 0; n < samplePages && codeSize >= PageSize; ++n) {
+                size_t offset = (codeSize - PageSize) / std::max<size_t>(1, samplePages - 1) * n / PageSize * PageSize;
+                for (const MemoryRange& range : code) {
+                    if (offset + PageSize <= range.size) {
+                        if (memory.ReadBytes(range.base + offset, page, PageSize, bytesRead) && bytesRead == PageSize) {
+                            hash = HashCombine(hash, HashBytes(page, PageSize));
+                        }
+                        break;
+                    }
+                    offset -= std::min(offset, range.size);
+                }
+            }
+
+            fingerprint.hash = hash ? hash : 1;
+            return fingerprint;
+        }
+
+        // 파일이 없거나 형식이 다르면 빈 캐시로 시작하고 false
+        bool Load(const std::string& path) {
+            Clear();
+            std::ifstream file(path, std::ios::binary);
+            char magic[4] = {};
+            uint32_t version = 0;
+            uint64_t count = 0;
+            file.read(magic, 4);
+            if (!file || memcmp(magic, "SCSC", 4) != 0 || !ReadPod(file, version) || version != FileVersion || !ReadPod(file, count)) {
+                return false;
+            }
+            for (uint64_t i = 0; i < count; ++i) {
+                std::string name;
+                Entry entry;
+                uint32_t validationLength = 0;
+                if (!ReadString(file, name) || !ReadString(file, entry.module) || !ReadPod(file, entry.fingerprint.hash) ||
+                    !ReadPod(file, entry.fingerprint.size) || !ReadPod(file, entry.rva) || !ReadPod(file, entry.validationRva) ||
+                    !ReadPod(file, validationLength) || validationLength > MaxValidationLength) {
+                    Clear();
+                    return false;
+                }
+                entry.validation.resize(validationLength);
+                file.read(reinterpret_cast<char*>(entry.validation.data()), validationLength);
+                if (!file) {
+                    Clear();
+                    return false;
+                }
+                entries[name] = std::move(entry);
+            }
+            return true;
+        }
+
+        bool Save(const std::string& path) const {
+            std::ofstream file(path, std::ios::binary);
+            if (!file) return false;
+            file.write("SCSC", 4);
+            WritePod(file, FileVersion);
+            WritePod(file, static_cast<uint64_t>(entries.size()));
+            for (const auto& item : entries) {
+                const Entry& entry = item.second;
+                WriteString(file, item.first);
+                WriteString(file, entry.module);
+                WritePod(file, entry.fingerprint.hash);
+                WritePod(file, entry.fingerprint.size);
+                WritePod(file, entry.rva);
+                WritePod(file, entry.validationRva);
+                WritePod(file, static_cast<uint32_t>(entry.validation.size()));
+                file.write(reinterpret_cast<const char*>(entry.validation.data()), static_cast<std::streamsize>(entry.validation.size()));
+            }
+            return static_cast<bool>(file);
+        }
+
+        // 항목과 지문 기억을 모두 지움. 다른 프로세스에 다시 붙을 때는 Load()나 Clear()부터
+        void Clear() {
+            entries.clear();
+            fingerprints.clear();
+        }
+
+        /**
+         * 캐시된 name의 주소를 address에 기록합니다. 크기가 같은 모듈 중 지문이 같은 모듈을 찾고,
+         * 검증 바이트를 한 번 읽어 같으면 hit (검증 바이트가 없는 항목은 지문만). 지문이 같은데 검증 바이트가 다르면 항목을 지웁니다.
+         */
+        bool Lookup(IProcessMemory& memory, const std::vector<ModuleRange>& modules, const std::string& name, uintptr_t& address) {
+            auto it = entries.find(name);
+            if (it == entries.end()) {
+                ++stats.misses;
+                return false;
+            }
+            const Entry& entry = it->second;
+
+            for (const ModuleRange& module : modules) {
+                if (module.size != entry.fingerprint.size || FingerprintOf(memory, module) != entry.fingerprint) continue;
+
+                uint8_t current[MaxValidationLength];
+                size_t bytesRead = 0;
+                bool same = entry.validation.empty() ||
+                            (memory.ReadBytes(module.base + entry.validationRva, current, entry.validation.size(), bytesRead) &&
+                             bytesRead == entry.validation.size() &&
+                             memcmp(current, entry.validation.data(), entry.validation.size()) == 0);
+                if (!same) {
+                    entries.erase(it);
+                    ++stats.invalidated;
+                    break;
+                }
+                address = module.base + static_cast<uintptr_t>(entry.rva);
+                ++stats.hits;
+                return true;
+            }
+            ++stats.misses;
+            return false;
+        }
+
+        /**
+         * 스캔으로 찾은 결과를 저장합니다. address와 validationAddress는 같은 모듈 안이어야 하고
+         * (힙 주소는 캐시할 수 없음), validationAddress에서 validationLength 바이트를 읽어 검증 바이트로 씁니다.
+         * validationLength가 0이면 검증 바이트 없이 지문만으로 저장합니다 (바뀌는 값을 검증 바이트로 쓰면 다음 연결에서 miss).
+         */
+        bool Store(IProcessMemory& memory, const std::vector<ModuleRange>& modules, const std::string& name,
+                   uintptr_t address, uintptr_t validationAddress, size_t validationLength) {
+            if (validationLength > MaxValidationLength) return false;
+            for (const ModuleRange& module : modules) {
+                if (!module.Contains(address) || !module.Contains(validationAddress) ||
+                    validationAddress - module.base + validationLength > module.size) {
+                    continue;
+                }
+                Entry entry;
+                entry.module = module.name;
+                entry.fingerprint = FingerprintOf(memory, module);
+                entry.rva = address - module.base;
+                entry.validationRva = validationAddress - module.base;
+                entry.validation.resize(validationLength);
+                size_t bytesRead = 0;
+                if (entry.fingerprint.hash == 0 ||
+                    (validationLength && (!memory.ReadBytes(validationAddress, entry.validation.data(), validationLength, bytesRead) ||
+                                          bytesRead != validationLength))) {
+                    return false;
+                }
+                entries[name] = std::move(entry);
+                ++stats.stored;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Lookup이 실패하면 scan(address, validationAddress, validationLength)으로 찾고 저장합니다.
+         * scan이 false를 반환하면 false.
+         */
+        template<typename ScanFunction>
+        bool Resolve(IProcessMemory& memory, const std::vector<ModuleRange>& modules, const std::string& name,
+                     uintptr_t& address, ScanFunction scan) {
+            if (Lookup(memory, modules, name, address)) return true;
+            uintptr_t validationAddress = 0;
+            size_t validationLength = 0;
+            if (!scan(address, validationAddress, validationLength)) return false;
+            Store(memory, modules, name, address, validationAddress, validationLength);
+            return true;
+        }
+
+        void Invalidate(const std::string& name) { entries.erase(name); }
+        bool Contains(const std::string& name) const { return entries.count(name) != 0; }
+        size_t EntryCount() const { return entries.size(); }
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = Stats(); }
+
+    private:
+        struct Entry {
+            std::string module;
+            ModuleFingerprint fingerprint;
+            uint64_t rva = 0;
+            uint64_t validationRva = 0;
+            std::vector<uint8_t> validation;
+        };
+
+        size_t samplePages;
+        std::map<std::string, Entry> entries;                       // 시그니처 이름 → 항목
+        std::unordered_map<uintptr_t, ModuleFingerprint> fingerprints;   // 이번 연결에서 계산한 지문 (모듈 기준 주소별)
+        Stats stats;
+
+        const ModuleFingerprint& FingerprintOf(IProcessMemory& memory, const ModuleRange& module) {
+            auto it = fingerprints.find(module.base);
+            if (it == fingerprints.end() || it->second.size != module.size) {
+                it = fingerprints.insert_or_assign(module.base, Fingerprint(memory, module, samplePages)).first;
+            }
+            return it->second;
+        }
+
+        // 로드 위치와 무관한 빌드 식별 헤더 필드만 해시
+        static uint64_t HashHeaders(const uint8_t* page, size_t size) {
+            auto read16 = [&](size_t offset) { uint16_t v = 0; if (offset + 2 <= size) memcpy(&v, page + offset, 2); return v; };
+            auto read32 = [&](size_t offset) { uint32_t v = 0; if (offset + 4 <= size) memcpy(&v, page + offset, 4); return v; };
+
+            if (size >= 0x40 && page[0] == 'M' && page[1] == 'Z') {
+                size_t pe = read32(0x3C);
+                if (pe + 24 <= size && memcmp(page + pe, "PE\0\0", 4) == 0) {
+                    size_t fileHeader = pe + 4;
+                    size_t optional = fileHeader + 20;
+                    size_t sections = optional + read16(fileHeader + 16);
+                    size_t sectionBytes = std::min<size_t>(read16(fileHeader + 2) * 40u, size - std::min(size, sections));
+
+                    uint64_t hash = HashBytes(page + fileHeader, 20);
+                    hash = HashCombine(hash, read32(optional + 16));     // AddressOfEntryPoint
+                    hash = HashCombine(hash, read32(optional + 56));     // SizeOfImage
+                    hash = HashCombine(hash, read32(optional + 64));     // CheckSum
+                    return HashCombine(hash, HashBytes(page + std::min(size, sections), sectionBytes));
+                }
+            }
+            if (size >= 64 && memcmp(page, "\x7F" "ELF", 4) == 0 && page[4] == 2) {
+                uint64_t phoff = 0;
+                memcpy(&phoff, page + 0x20, sizeof(phoff));
+                size_t phdrs = std::min<size_t>(static_cast<size_t>(read16(0x36)) * read16(0x38),
+                                                phoff < size ? size - static_cast<size_t>(phoff) : 0);
+                return HashCombine(HashBytes(page, 64), HashBytes(page + std::min<uint64_t>(phoff, size), phdrs));
+            }
+            return HashBytes(page, size);
+        }
+
+        template<typename T>
+        static void WritePod(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        static bool ReadPod(std::ifstream& file, T& value) {
+            file.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return static_cast<bool>(file);
+        }
+
+        static void WriteString(std::ofstream& file, const std::string& text) {
+            WritePod(file, static_cast<uint32_t>(text.size()));
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+
+        static bool ReadString(std::ifstream& file, std::string& text) {
+            uint32_t length = 0;
+            if (!ReadPod(file, length) || length > 4096) return false;
+            text.resize(length);
+            file.read(&text[0], length);
+            return static_cast<bool>(file);
+        }
+    };
+}
@@ -0,0 +1,235 @@
+#pragma once
+/*
+ * 다중 시그니처 단일 패스 검색 (와일드카드 Aho-Corasick)
+ *
+ * 시그니처마다 모듈 전체를 다시 스캔하면 시작 시간이 시그니처 수에 비례해 늘어납니다.
+ * SignatureSet은 모든 시그니처를 오토마톤 하나로 합쳐 메모리를 한 번만 훑습니다.
+ * - 시그니처마다 와일드카드가 없는 구간 중 가장 긴(같으면 가장 드문) 최대 4바이트를 키로 고름
+ * - 모든 키로 Aho-Corasick DFA(상태 × 256 전이 표)를 만들어 바이트당 표 조회 한 번으로 진행
+ * - 키가 끝나는 위치에서 해당 시그니처 전체를 CompiledPattern으로 확인
+ * 스캔 시간은 시그니처 수와 거의 무관합니다 (10개 → 1000개). 표 크기는 상태 수 × 1KB입니다.
+ *
+ * 사용 예:
+ *   ScanCore::SignatureSet signatures;
+ *   uint32_t fps = signatures.Add("F3 0F 11 05 ?? ?? ?? ?? 8B 0D");
+ *   signatures.Build();
+ *   std::vector<ScanCore::SignatureMatch> matches;
+ *   signatures.FindAll(data, size, baseAddress, matches);     // (id, 주소) 쌍
+ */
+
+#include "CompiledPattern.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    struct SignatureMatch {
+        uint32_t id = 0;            // Add()가 반환한 번호 (추가한 순서)
+        uintptr_t address = 0;      // 시그니처 시작 주소
+    };
+
+    class SignatureSet {
+    public:
+        static constexpr size_t MaxKeyLength = 4;
+        static constexpr size_t Lanes = 8;
+
+        // 추가한 순서대로 0, 1, 2... 번호를 반환. 비어 있거나 고정 바이트가 없는 시그니처는 찾지 않음
+        uint32_t Add(const CompiledPattern& pattern) {
+            patterns.push_back(pattern);
+            built = false;
+            return static_cast<uint32_t>(patterns.size() - 1);
+        }
+
+        uint32_t Add(const std::vector<uint8_t>& pattern, const std::vector<bool>& mask = {}) {
+            return Add(CompiledPattern(pattern, mask));
+        }
+
+        // "48 8B ?? 89" 형식
+        uint32_t Add(const std::string& text) {
+            return Add(CompiledPattern::Parse(text));
+        }
+
+        size_t Count() const { return patterns.size(); }
+        const CompiledPattern& Pattern(uint32_t id) const { return patterns[id]; }
+
+        // 가장 긴 시그니처 길이 (청크 overlap은 이 값 - 1)
+        size_t MaxLength() const {
+            size_t longest = 0;
+            for (const CompiledPattern& pattern : patterns) longest = std::max(longest, pattern.Size());
+            return longest;
+        }
+
+        size_t StateCount() const { return table.size() / 256; }
+        size_t TableBytes() const { return table.size() * sizeof(uint32_t); }
+        bool IsBuilt() const { return built; }
+
+        // 오토마톤 생성. Add() 후 FindAll() 전에 호출
+        void Build() {
+            keys.clear();
+            std::vector<std::vector<uint32_t>> outputs(1);
+            std::vector<uint32_t> trie(256, 0);
+
+            // 1. 키로 트라이 구성 (상태 0 = 루트, 전이 0 = 없음)
+            for (uint32_t id = 0; id < patterns.size(); ++id) {
+                size_t offset = 0, length = 0;
+                if (!SelectKey(patterns[id], offset, length)) continue;
+
+                uint32_t state = 0;
+                for (size_t j = offset; j < offset + length; ++j) {
+                    uint32_t& next = trie[state * 256 + patterns[id].Byte(j)];
+                    if (next == 0) {
+                        next = static_cast<uint32_t>(outputs.size());
+                        outputs.emplace_back();
+                        trie.resize(trie.size() + 256, 0);
+                    }
+                    state = trie[state * 256 + patterns[id].Byte(j)];
+                }
+                outputs[state].push_back(static_cast<uint32_t>(keys.size()));
+                keys.push_back(Key{id, static_cast<uint32_t>(offset + length - 1)});
+            }
+
+            // 2. BFS로 실패 링크를 따라 빠진 전이를 채워 DFA로 만들고, 출력도 실패 링크 쪽 것을 합침
+            const size_t stateCount = outputs.size();
+            std::vector<uint32_t> dfa = trie;
+            std::vector<uint32_t> fail(stateCount, 0);
+            std::deque<uint32_t> queue;
+            for (uint32_t b = 0; b < 256; ++b) {
+                if (trie[b] != 0) queue.push_back(trie[b]);
+            }
+            while (!queue.empty()) {
+                uint32_t state = queue.front();
+                queue.pop_front();
+                const std::vector<uint32_t>& inherited = outputs[fail[state]];
+                outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+                for (uint32_t b = 0; b < 256; ++b) {
+                    uint32_t child = trie[state * 256 + b];
+                    uint32_t fallback = dfa[fail[state] * 256 + b];
+                    if (child != 0) {
+                        fail[child] = fallback;
+                        queue.push_back(child);
+                    } else {
+                        dfa[state * 256 + b] = fallback;
+                    }
+                }
+            }
+
+            // 3. 전이 = (다음 상태 × 256) | 출력 있음 비트. 스캔 루프에서 곱셈 없이 다음 행으로 이동
+            table.resize(dfa.size());
+            for (size_t n = 0; n < dfa.size(); ++n) {
+                uint32_t next = dfa[n];
+                table[n] = next * 256 | (outputs[next].empty() ? 0u : 1u);
+            }
+            outputBegin.assign(stateCount + 1, 0);
+            outputKeys.clear();
+            for (size_t state = 0; state < stateCount; ++state) {
+                outputBegin[state] = static_cast<uint32_t>(outputKeys.size());
+                outputKeys.insert(outputKeys.end(), outputs[state].begin(), outputs[state].end());
+            }
+            outputBegin[stateCount] = static_cast<uint32_t>(outputKeys.size());
+            built = true;
+        }
+
+        /**
+         * 버퍼를 한 번 훑어 모든 시그니처의 일치 위치를 (id, 시작 주소)로 out에 추가합니다.
+         * 추가된 결과는 (주소, id) 오름차순입니다. 추가된 개수를 반환합니다. Build() 전에는 0입니다.
+         *
+         * reportFrom: 끝 주소(시작 + 길이)가 이 값 이하인 일치는 보고하지 않음.
+         * 겹치게 읽은 연속 청크에서 앞 청크의 끝 주소를 넘기면 길이가 다른 시그니처도 중복 없이 찾습니다.
+         */
+        size_t FindAll(const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<SignatureMatch>& out,
+                       uintptr_t reportFrom = 0) const {
+            if (!built || keys.empty() || size == 0) return 0;
+            size_t before = out.size();
+
+            /*
+             * 상태는 마지막 MaxKeyLength - 1 바이트로만 정해지므로(트라이 깊이 <= MaxKeyLength),
+             * 버퍼를 Lanes개 구간으로 나누고 각 구간 앞 MaxKeyLength - 1 바이트로 상태를 맞춘 뒤 동시에 진행.
+             * 표 조회 지연이 구간끼리 겹쳐 바이트당 한 번 조회하는 단일 루프보다 빠름
+             */
+            const size_t laneSize = size >= Lanes * 64 ? size / Lanes : 0;
+            size_t begin[Lanes] = {};
+            uint32_t row[Lanes] = {};
+            for (size_t lane = 0; lane < Lanes; ++lane) {
+                begin[lane] = laneSize * lane;
+                for (size_t i = begin[lane] - std::min(begin[lane], MaxKeyLength - 1); i < begin[lane]; ++i) {
+                    row[lane] = table[row[lane] + data[i]] & ~0xFFu;
+                }
+            }
+
+            const uint32_t* transitions = table.data();
+            for (size_t i = 0; i < laneSize; ++i) {
+                for (size_t lane = 0; lane < Lanes; ++lane) {
+                    uint32_t next = transitions[row[lane] + data[begin[lane] + i]];
+                    row[lane] = next & ~0xFFu;
+                    if (next & 1) Report(row[lane] / 256, data, size, begin[lane] + i, baseAddress, reportFrom, out);
+                }
+            }
+            // 나머지는 마지막 구간에 이어서
+            uint32_t last = row[Lanes - 1];
+            for (size_t i = begin[Lanes - 1] + laneSize; i < size; ++i) {
+                uint32_t next = transitions[last + data[i]];
+                last = next & ~0xFFu;
+                if (next & 1) Report(last / 256, data, size, i, baseAddress, reportFrom, out);
+            }
+
+            std::sort(out.begin() + static_cast<std::ptrdiff_t>(before), out.end(),
+                      [](const SignatureMatch& a, const SignatureMatch& b) {
+                          return a.address != b.address ? a.address < b.address : a.id < b.id;
+                      });
+            return out.size() - before;
+        }
+
+    private:
+        struct Key {
+            uint32_t id;            // 시그니처 번호
+            uint32_t end;           // 시그니처 안에서 키의 마지막 바이트 위치
+        };
+
+        std::vector<CompiledPattern> patterns;
+        std::vector<Key> keys;
+        std::vector<uint32_t> table;        // 상태 × 256
+        std::vector<uint32_t> outputBegin;  // 상태별 outputKeys 구간
+        std::vector<uint32_t> outputKeys;   // 그 상태에서 끝나는 키 번호들 (실패 링크 쪽 포함)
+        bool built = false;
+
+        // 완전 고정 바이트 구간 중 가장 긴 창(최대 MaxKeyLength), 같으면 드문 바이트가 많은 창
+        static bool SelectKey(const CompiledPattern& pattern, size_t& bestOffset, size_t& bestLength) {
+            bestLength = 0;
+            int bestScore = 0;
+            for (size_t start = 0; start < pattern.Size(); ++start) {
+                size_t length = 0;
+                int score = 0;
+                while (length < MaxKeyLength && start + length < pattern.Size() && pattern.Mask(start + length) == 0xFF) {
+                    score += CompiledPattern::ByteFrequency(pattern.Byte(start + length));
+                    ++length;
+                }
+                if (length > bestLength || (length == bestLength && length > 0 && score < bestScore)) {
+                    bestOffset = start;
+                    bestLength = length;
+                    bestScore = score;
+                }
+            }
+            return bestLength > 0;
+        }
+
+        void Report(uint32_t state, const uint8_t* data, size_t size, size_t position, uintptr_t baseAddress,
+                    uintptr_t reportFrom, std::vector<SignatureMatch>& out) const {
+            for (uint32_t n = outputBegin[state]; n < outputBegin[state + 1]; ++n) {
+                const Key& key = keys[outputKeys[n]];
+                const CompiledPattern& pattern = patterns[key.id];
+                if (position < key.end) continue;
+                size_t start = position - key.end;
+                if (start + pattern.Size() > size || baseAddress + start + pattern.Size() <= reportFrom) continue;
+                if (pattern.MatchesAt(data + start)) {
+                    out.push_back(SignatureMatch{key.id, baseAddress + start});
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,406 @@
+#pragma once
+/*
+ * 두 스냅샷 사이 변경 찾기 (페이지 해시 diff)
+ *
+ * "행동 전"과 "행동 후" 메모리에서 무엇이 바뀌었는지를 값 하나씩 다음 스캔하지 않고 한 번에 찾습니다.
+ * 1. HashPages(): 영역을 페이지(4KB)마다 HashBytes로 해시. ScanExecutor 작업 단위별 병렬, 페이지당 8바이트
+ *    (8GB → 16MB). 행동 전 해시만 들고 있어도 어느 페이지가 바뀌었는지는 알 수 있음
+ * 2. ChangedPages(): 두 해시 표를 주소 순서로 병합해 해시가 다른 페이지 (한쪽에만 있는 페이지는 수만 셈)
+ * 3. DiffPages(): 바뀐 페이지만 양쪽에서 다시 읽어 바뀐 바이트 구간을 만들고 (mergeGap 바이트 이하 틈은 합침)
+ *    구간 안의 정렬된 값을 종류별로 분류 (바뀐 바이트 구간은 양쪽 내용이 있어야 하므로 before는 덤프나 MemoryDump)
+ *    - PointerSwap:  8바이트 정렬, 전/후 값이 모두 읽을 수 있는 영역 안 주소 (한쪽이 null이어도 포함)
+ *    - FloatDelta:   4바이트 정렬, 전/후 값이 모두 그럴듯한 float (|x| 약 1e-6 ~ 1.6e7 또는 0)
+ *    - IntIncrement: 4바이트 정렬, 전/후 값이 모두 |x| < 2^24인 정수이고 차이가 maxIntDelta 이하
+ *    - Other:        그 밖의 바뀐 값
+ * Run()은 세 단계를 이어서 실행합니다. 모든 단계가 페이지 배수 작업 단위로 병렬 처리되고 IProcessMemory만 사용하므로
+ * 두 덤프 파일(OpenDumpMemory), MemoryDump와 실행 중인 프로세스 어느 조합이든 비교할 수 있습니다.
+ *
+ * 사용 예:
+ *   ScanCore::SnapshotDiff diff;
+ *   ScanCore::SnapshotDiffResult result = diff.Run(*before, *after, [](const ScanCore::MemoryRegion& r) { return r.IsWritable(); });
+ *   for (const ScanCore::ValueChange& change : result.values) {
+ *       if (change.kind == ScanCore::ChangeKind::FloatDelta) printf("%llx %f -> %f\n", change.address, change.BeforeFloat(), change.AfterFloat());
+ *   }
+ */
+
+#include "Hash.h"
+#include "ProcessMemory.h"
+#include "ScanExecutor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ScanCore {
+
+    enum class ChangeKind : uint8_t {
+        Other,
+        FloatDelta,
+        IntIncrement,
+        PointerSwap
+    };
+
+    inline const char* ChangeKindName(ChangeKind kind) {
+        switch (kind) {
+        case ChangeKind::FloatDelta: return "float delta";
+        case ChangeKind::IntIncrement: return "int increment";
+        case ChangeKind::PointerSwap: return "pointer swap";
+        default: return "other";
+        }
+    }
+
+    // 분류한 값 하나 (size는 4 또는 8, 값은 리틀 엔디언 그대로)
+    struct ValueChange {
+        uintptr_t address = 0;
+        uint64_t before = 0;
+        uint64_t after = 0;
+        uint8_t size = 0;
+        ChangeKind kind = ChangeKind::Other;
+
+        float BeforeFloat() const { return BitsToFloat(static_cast<uint32_t>(before)); }
+        float AfterFloat() const { return BitsToFloat(static_cast<uint32_t>(after)); }
+        int64_t IntDelta() const { return static_cast<int64_t>(static_cast<int32_t>(after)) - static_cast<int32_t>(before); }
+
+    private:
+        static float BitsToFloat(uint32_t bits) {
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+
+    // 바뀐 바이트 구간 [address, address + size)
+    struct ChangedRange {
+        uintptr_t address = 0;
+        size_t size = 0;
+    };
+
+    struct SnapshotDiffConfig {
+        size_t mergeGap = 8;                    // 이 바이트 수 이하로 떨어진 바뀐 구간은 하나로 (8 미만이면 8)
+        size_t maxValueChanges = 1 << 20;       // values에 남길 최대 수 (분류 수는 모두 셈)
+        int64_t maxIntDelta = 1 << 16;          // IntIncrement로 볼 최대 차이
+    };
+
+    struct SnapshotDiffResult {
+        struct Stats {
+            size_t pagesBefore = 0;             // 해시한 페이지 수
+            size_t pagesAfter = 0;
+            size_t pagesOnlyBefore = 0;         // 행동 후에 없어진 페이지 (해제, 읽을 수 없음)
+            size_t pagesOnlyAfter = 0;          // 새로 생긴 페이지
+            size_t pagesChanged = 0;
+            size_t bytesHashed = 0;
+            size_t bytesChanged = 0;
+            size_t valueCounts[4] = {};         // ChangeKind별 분류 수
+            size_t droppedValues = 0;           // maxValueChanges를 넘어 values에 넣지 못한 수
+            double hashSeconds = 0.0;
+            double diffSeconds = 0.0;
+
+            size_t ValueCount(ChangeKind kind) const { return valueCounts[static_cast<size_t>(kind)]; }
+        };
+
+        std::vector<uintptr_t> changedPages;    // 주소 오름차순
+        std::vector<ChangedRange> ranges;       // 주소 오름차순
+        std::vector<ValueChange> values;        // 주소 오름차순
+        Stats stats;
+    };
+
+    /**
+     * 페이지 해시 표. 연속 페이지 구간(Run)마다 해시를 이어 붙여 두므로 페이지당 8바이트만 씁니다.
+     * 읽지 못한 작업 단위의 페이지는 빠집니다.
+     */
+    class PageHashSet {
+    public:
+        static constexpr size_t PageSize = 4096;
+
+        struct Run {
+            uintptr_t base = 0;
+            size_t first = 0;       // hashes 안의 첫 페이지 번호
+            size_t count = 0;
+        };
+
+        size_t PageCount() const { return hashes.size(); }
+        bool Empty() const { return hashes.empty(); }
+        const std::vector<Run>& Runs() const { return runs; }
+        const std::vector<uint64_t>& Hashes() const { return hashes; }
+        size_t MemoryUsage() const { return runs.capacity() * sizeof(Run) + hashes.capacity() * sizeof(uint64_t); }
+
+        // 페이지 주소 순서로 (주소, 해시)를 방문
+        template<typename Visit>
+        void ForEach(Visit visit) const {
+            for (const Run& run : runs) {
+                for (size_t i = 0; i < run.count; ++i) visit(run.base + i * PageSize, hashes[run.first + i]);
+            }
+        }
+
+        // 작업 단위 결과를 주소 순서로 덧붙임 (앞 구간과 이어지면 합침)
+        void Append(uintptr_t base, const uint64_t* pageHashes, size_t count) {
+            if (count == 0) return;
+            if (!runs.empty() && runs.back().base + runs.back().count * PageSize == base) {
+                runs.back().count += count;
+            } else {
+                Run run;
+                run.base = base;
+                run.first = hashes.size();
+                run.count = count;
+                runs.push_back(run);
+            }
+            hashes.insert(hashes.end(), pageHashes, pageHashes + count);
+        }
+
+    private:
+        std::vector<Run> runs;
+        std::vector<uint64_t> hashes;
+    };
+
+    class SnapshotDiff {
+    public:
+        static constexpr size_t PageSize = PageHashSet::PageSize;
+
+        explicit SnapshotDiff(const SnapshotDiffConfig& config = SnapshotDiffConfig(),
+                              const ScanExecutorConfig& executorConfig = ScanExecutorConfig())
+            : config(config), executor(executorConfig) {
+            // 작업 단위가 페이지 경계에서 나뉘도록 페이지 배수로 맞춤
+            size_t chunk = (executor.GetConfig().chunkSize + PageSize - 1) / PageSize * PageSize;
+            executor.SetChunkSize(chunk);
+            executor.SetOverlap(0);
+            this->config.mergeGap = std::max<size_t>(8, this->config.mergeGap);
+        }
+
+        ScanExecutor& GetExecutor() { return executor; }
+
+        // accept를 통과한 영역의 모든 페이지 해시 (병렬)
+        template<typename Filter>
+        PageHashSet HashPages(IProcessMemory& memory, Filter accept) {
+            struct UnitHashes {
+                uintptr_t base = 0;
+                std::vector<uint64_t> hashes;
+            };
+            std::vector<UnitHashes> units = executor.RunUnits<UnitHashes>(memory.CollectRanges(accept), memory.MakeReadFunction(),
+                [](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, UnitHashes& result) {
+                    result.base = unit.base;
+                    result.hashes.resize(std::min(size, unit.size) / PageSize);
+                    for (size_t page = 0; page < result.hashes.size(); ++page) {
+                        result.hashes[page] = HashBytes(data + page * PageSize, PageSize);
+                    }
+                });
+            PageHashSet set;
+            for (const UnitHashes& unit : units) set.Append(unit.base, unit.hashes.data(), unit.hashes.size());
+            return set;
+        }
+
+        // 두 해시 표 모두에 있고 해시가 다른 페이지 (주소 오름차순). 한쪽에만 있는 페이지 수는 onlyBefore/onlyAfter
+        static std::vector<uintptr_t> ChangedPages(const PageHashSet& before, const PageHashSet& after,
+                                                   size_t* onlyBefore = nullptr, size_t* onlyAfter = nullptr) {
+            std::vector<uintptr_t> changed;
+            size_t missingAfter = 0, missingBefore = 0;
+            const auto& runsA = before.Runs();
+            const auto& runsB = after.Runs();
+            size_t a = 0, b = 0, offsetA = 0, offsetB = 0;
+            while (a < runsA.size() && b < runsB.size()) {
+                uintptr_t pageA = runsA[a].base + offsetA * PageSize;
+                uintptr_t pageB = runsB[b].base + offsetB * PageSize;
+                if (pageA == pageB) {
+                    // 같은 주소부터 두 구간이 겹치는 만큼 한 번에 비교
+                    size_t count = std::min(runsA[a].count - offsetA, runsB[b].count - offsetB);
+                    const uint64_t* hashA = before.Hashes().data() + runsA[a].first + offsetA;
+                    const uint64_t* hashB = after.Hashes().data() + runsB[b].first + offsetB;
+                    for (size_t i = 0; i < count; ++i) {
+                        if (hashA[i] != hashB[i]) changed.push_back(pageA + i * PageSize);
+                    }
+                    offsetA += count;
+                    offsetB += count;
+                } else if (pageA < pageB) {
+                    size_t count = std::min<size_t>(runsA[a].count - offsetA, std::max<size_t>(1, (pageB - pageA) / PageSize));
+                    missingAfter += count;
+                    offsetA += count;
+                } else {
+                    size_t count = std::min<size_t>(runsB[b].count - offsetB, std::max<size_t>(1, (pageA - pageB) / PageSize));
+                    missingBefore += count;
+                    offsetB += count;
+                }
+                if (offsetA == runsA[a].count) {
+                    ++a;
+                    offsetA = 0;
+                }
+                if (offsetB == runsB[b].count) {
+                    ++b;
+                    offsetB = 0;
+                }
+            }
+            if (a < runsA.size()) missingAfter += runsA[a].count - offsetA;
+            for (++a; a < runsA.size(); ++a) missingAfter += runsA[a].count;
+            if (b < runsB.size()) missingBefore += runsB[b].count - offsetB;
+            for (++b; b < runsB.size(); ++b) missingBefore += runsB[b].count;
+            if (onlyBefore) *onlyBefore = missingAfter;
+            if (onlyAfter) *onlyAfter = missingBefore;
+            return changed;
+        }
+
+        // pages(정렬된 페이지 주소)만 양쪽에서 읽어 바뀐 바이트 구간과 값 분류 (병렬)
+        SnapshotDiffResult DiffPages(IProcessMemory& before, IProcessMemory& after, const std::vector<uintptr_t>& pages) {
+            auto start = std::chrono::steady_clock::now();
+            SnapshotDiffResult result;
+            result.changedPages = pages;
+
+            // 포인터 판정용 읽을 수 있는 영역 (행동 후 기준, 정렬됨)
+            std::vector<MemoryRange> readable = after.CollectRanges([](const MemoryRegion& region) { return region.IsReadable(); });
+            std::sort(readable.begin(), readable.end(), [](const MemoryRange& x, const MemoryRange& y) { return x.base < y.base; });
+
+            std::vector<MemoryRange> ranges;
+            for (uintptr_t page : pages) {
+                if (!ranges.empty() && ranges.back().base + ranges.back().size == page) ranges.back().size += PageSize;
+                else ranges.push_back({page, PageSize});
+            }
+
+            struct UnitDiff {
+                std::vector<ChangedRange> ranges;
+                std::vector<ValueChange> values;
+                size_t counts[4] = {};
+            };
+            const SnapshotDiffConfig& settings = config;
+            std::vector<UnitDiff> units = executor.RunUnits<UnitDiff>(ranges, before.MakeReadFunction(),
+                [&](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, UnitDiff& out) {
+                    thread_local std::vector<uint8_t> current;
+                    size = std::min(size, unit.size);
+                    current.resize(size);
+                    size_t bytesRead = 0;
+                    if (!after.ReadBytes(unit.base, current.data(), size, bytesRead) && bytesRead == 0) return;
+                    size = std::min(size, bytesRead);
+                    CompareBuffers(data, current.data(), size, unit.base, readable, settings, out.ranges, out.values, out.counts);
+                });
+
+            for (UnitDiff& unit : units) {
+                for (size_t k = 0; k < 4; ++k) result.stats.valueCounts[k] += unit.counts[k];
+                for (const ChangedRange& range : unit.ranges) {
+                    result.stats.bytesChanged += range.size;
+                    // 작업 단위 경계에서 나뉜 구간은 다시 합침
+                    ChangedRange* last = result.ranges.empty() ? nullptr : &result.ranges.back();
+                    if (last && range.address - (last->address + last->size) <= config.mergeGap) {
+                        last->size = range.address + range.size - last->address;
+                    } else {
+                        result.ranges.push_back(range);
+                    }
+                }
+                size_t room = config.maxValueChanges - std::min(config.maxValueChanges, result.values.size());
+                size_t take = std::min(room, unit.values.size());
+                result.values.insert(result.values.end(), unit.values.begin(), unit.values.begin() + take);
+                result.stats.droppedValues += unit.values.size() - take;
+            }
+            result.stats.pagesChanged = pages.size();
+            result.stats.diffSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+        // 해시 → 바뀐 페이지 → 바뀐 바이트 구간/값 분류
+        template<typename Filter>
+        SnapshotDiffResult Run(IProcessMemory& before, IProcessMemory& after, Filter accept) {
+            auto start = std::chrono::steady_clock::now();
+            PageHashSet hashesBefore = HashPages(before, accept);
+            PageHashSet hashesAfter = HashPages(after, accept);
+            double hashSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            SnapshotDiffResult::Stats stats;
+            std::vector<uintptr_t> pages = ChangedPages(hashesBefore, hashesAfter, &stats.pagesOnlyBefore, &stats.pagesOnlyAfter);
+            SnapshotDiffResult result = DiffPages(before, after, pages);
+            result.stats.pagesBefore = hashesBefore.PageCount();
+            result.stats.pagesAfter = hashesAfter.PageCount();
+            result.stats.pagesOnlyBefore = stats.pagesOnlyBefore;
+            result.stats.pagesOnlyAfter = stats.pagesOnlyAfter;
+            result.stats.bytesHashed = (hashesBefore.PageCount() + hashesAfter.PageCount()) * PageSize;
+            result.stats.hashSeconds = hashSeconds;
+            return result;
+        }
+
+    private:
+        SnapshotDiffConfig config;
+        ScanExecutor executor;
+
+        static bool IsPointer(uint64_t value, const std::vector<MemoryRange>& readable) {
+            auto it = std::upper_bound(readable.begin(), readable.end(), value,
+                                       [](uint64_t address, const MemoryRange& range) { return address < range.base; });
+            if (it == readable.begin()) return false;
+            --it;
+            return value - it->base < it->size;
+        }
+
+        static bool IsPlausibleFloat(uint32_t bits) {
+            if ((bits & 0x7FFFFFFF) == 0) return true;
+            uint32_t exponent = (bits >> 23) & 0xFF;
+            return exponent >= 127 - 20 && exponent <= 127 + 23;
+        }
+
+        static bool IsPlausibleInt(uint32_t bits) {
+            int32_t value = static_cast<int32_t>(bits);
+            return value > -(1 << 24) && value < (1 << 24);
+        }
+
+        static ChangeKind Classify32(uint32_t before, uint32_t after, const SnapshotDiffConfig& config) {
+            if (IsPlausibleFloat(before) && IsPlausibleFloat(after) && (before | after) & 0x7F800000) return ChangeKind::FloatDelta;
+            if (IsPlausibleInt(before) && IsPlausibleInt(after)) {
+                int64_t delta = static_cast<int64_t>(static_cast<int32_t>(after)) - static_cast<int32_t>(before);
+                if (delta <= config.maxIntDelta && -delta <= config.maxIntDelta) return ChangeKind::IntIncrement;
+            }
+            return ChangeKind::Other;
+        }
+
+        static void AddValue(uintptr_t address, uint64_t before, uint64_t after, uint8_t size, ChangeKind kind, size_t maxValues,
+                             std::vector<ValueChange>& values, size_t* counts) {
+            ++counts[static_cast<size_t>(kind)];
+            if (values.size() >= maxValues) return;
+            ValueChange change;
+            change.address = address;
+            change.before = before;
+            change.after = after;
+            change.size = size;
+            change.kind = kind;
+            values.push_back(change);
+        }
+
+        // 8바이트 단위로 같은 부분을 건너뛰며 바뀐 바이트 구간을 찾고, 구간이 닿는 정렬된 값을 분류
+        static void CompareBuffers(const uint8_t* old, const uint8_t* now, size_t size, uintptr_t base,
+                                   const std::vector<MemoryRange>& readable, const SnapshotDiffConfig& config,
+                                   std::vector<ChangedRange>& ranges, std::vector<ValueChange>& values, size_t* counts) {
+            size_t offset = 0;
+            while (offset < size) {
+                // 다음 바뀐 바이트
+                while (offset + 8 <= size && memcmp(old + offset, now + offset, 8) == 0) offset += 8;
+                while (offset < size && old[offset] == now[offset]) ++offset;
+                if (offset >= size) break;
+                size_t first = offset;
+                size_t last = offset;
+                // mergeGap 이하의 같은 바이트를 사이에 둔 바뀐 바이트는 같은 구간
+                for (size_t gap = 0; ++offset < size && gap <= config.mergeGap;) {
+                    if (old[offset] != now[offset]) {
+                        last = offset;
+                        gap = 0;
+                    } else {
+                        ++gap;
+                    }
+                }
+                offset = last + 1;
+                ranges.push_back({base + first, last + 1 - first});
+
+                // 구간이 닿는 8바이트 슬롯마다: 포인터 → 4바이트 두 개
+                for (size_t slot = first & ~size_t(7); slot <= last && slot + 8 <= size; slot += 8) {
+                    uint64_t before, after;
+                    memcpy(&before, old + slot, sizeof(before));
+                    memcpy(&after, now + slot, sizeof(after));
+                    if (before == after) continue;
+                    if ((before == 0 || IsPointer(before, readable)) && (after == 0 || IsPointer(after, readable))) {
+                        AddValue(base + slot, before, after, 8, ChangeKind::PointerSwap, config.maxValueChanges, values, counts);
+                        continue;
+                    }
+                    for (size_t half = 0; half < 8; half += 4) {
+                        uint32_t before32 = static_cast<uint32_t>(before >> (half * 8));
+                        uint32_t after32 = static_cast<uint32_t>(after >> (half * 8));
+                        if (before32 == after32) continue;
+                        AddValue(base + slot + half, before32, after32, 4, Classify32(before32, after32, config),
+                                 config.maxValueChanges, values, counts);
+                    }
+                }
+            }
+        }
+    };
+}
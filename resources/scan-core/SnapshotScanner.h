@@ -0,0 +1,328 @@
+#pragma once
+/*
+ * 알 수 없는 초기값 스캔 (페이지 스냅샷)
+ *
+ * Cheat Engine의 "Unknown initial value" 검색처럼, 값은 모르지만 "증가/감소/변경/변경 없음"으로
+ * 후보를 좁혀 가는 검색을 합니다. 처음에 쓰기 가능한 영역 전체를 페이지(4KB) 단위로 한 번 복사하고,
+ * 이후 필터는 페이지 대 페이지로 비교합니다.
+ *
+ * - 모든 바이트가 0인 페이지는 데이터 없이 플래그만 저장
+ * - 후보가 적게 남은 페이지는 4KB 전체 대신 후보 위치의 값만 모아서 저장
+ * - 페이지마다 후보 비트맵(정렬 간격 alignment마다 1비트)을 두고, 후보가 남지 않은 페이지는 버림
+ * - 필터 시 페이지가 통째로 같으면(memcmp) 값 비교 없이 처리 (copy-on-diff: 바뀐 페이지만 새로 복사)
+ * - 읽기는 ScanExecutor로 연속 페이지 묶음 단위 병렬 처리
+ * - DirtyPageTracker(soft-dirty)를 넘기면 지난 필터 이후 쓰이지 않은 페이지는 읽지 않음
+ *
+ * alignment가 sizeof(T)보다 작으면 페이지 경계에 걸친 값은 후보에서 제외됩니다.
+ * 후보가 충분히 줄면 ToResultStore()로 ScanResultStore로 바꿔 일반 다음 스캔으로 이어갈 수 있습니다.
+ */
+
+#include "ChangeFilter.h"
+#include "DirtyPageTracker.h"
+#include "ScanExecutor.h"
+#include "ScanResultStore.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    template<typename T>
+    class SnapshotScanner {
+    public:
+        static constexpr size_t PageSize = 4096;
+
+        explicit SnapshotScanner(size_t alignment = sizeof(T), const ScanExecutorConfig& config = ScanExecutorConfig())
+            : alignment(alignment == 0 ? 1 : alignment), executor(config) {
+            // 작업 단위가 페이지 경계에서 나뉘도록 페이지 배수로 맞춤
+            size_t chunk = (executor.GetConfig().chunkSize + PageSize - 1) / PageSize * PageSize;
+            executor.SetChunkSize(chunk);
+            executor.SetOverlap(0);
+            slotsPerPage = (PageSize - sizeof(T)) / this->alignment + 1;
+            wordsPerPage = (slotsPerPage + 63) / 64;
+        }
+
+        size_t Alignment() const { return alignment; }
+        size_t PageCount() const { return pages.size(); }
+        size_t CandidateCount() const { return candidateCount; }
+        ScanExecutor& GetExecutor() { return executor; }
+        size_t LastSkippedPages() const { return lastSkippedPages; }   // 마지막 필터에서 읽지 않은 페이지 수
+
+        // 스냅샷이 차지하는 메모리 (페이지 데이터 + 후보 비트맵 + 페이지 목록)
+        size_t MemoryUsage() const {
+            return pages.capacity() * sizeof(PageRecord) + pageData.capacity() + candidateBits.capacity() * sizeof(uint64_t);
+        }
+
+        /**
+         * 쓰기 가능한 영역 전체를 페이지 단위로 복사합니다. 모든 정렬 위치가 후보가 됩니다.
+         * 읽을 수 없는 페이지는 건너뜁니다. 후보 수를 반환합니다.
+         * tracker를 넘기면 읽기 전에 Arm하여, 이후 Filter에서 같은 tracker로 깨끗한 페이지를 건너뛸 수 있습니다.
+         */
+        size_t Capture(const std::vector<MemoryRange>& ranges, const ScanExecutor::ReadFunction& read,
+                       DirtyPageTracker* tracker = nullptr) {
+            if (tracker) tracker->Arm();
+            lastSkippedPages = 0;
+
+            std::vector<MemoryRange> pageRanges;
+            for (const MemoryRange& range : ranges) {
+                uintptr_t begin = range.base & ~static_cast<uintptr_t>(PageSize - 1);
+                uintptr_t end = (range.base + range.size + PageSize - 1) & ~static_cast<uintptr_t>(PageSize - 1);
+                if (end > begin) pageRanges.push_back({begin, end - begin});
+            }
+
+            std::vector<PassResult> results = executor.RunUnits<PassResult>(pageRanges, read,
+                [this](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, PassResult& result) {
+                    for (size_t offset = 0; offset + PageSize <= size && offset < unit.size; offset += PageSize) {
+                        StorePage(result, unit.base + offset, data + offset, nullptr);
+                    }
+                });
+            Adopt(results);
+            return candidateCount;
+        }
+
+        /**
+         * 저장된 페이지들을 현재 메모리와 비교하여 후보를 좁힙니다.
+         * 현재 값은 다음 필터의 이전 값으로 저장되며, 후보가 없는 페이지는 버립니다. 남은 후보 수를 반환합니다.
+         * tracker가 soft-dirty를 쓸 수 있으면 마지막 Arm 이후 쓰이지 않은 페이지는 읽지 않고
+         * 변경 없음이면 그대로 남기고, 그 외 필터면 버립니다.
+         */
+        size_t Filter(ChangeFilter filter, const ScanExecutor::ReadFunction& read, DirtyPageTracker* tracker = nullptr) {
+            lastSkippedPages = 0;
+            if (pages.empty()) return 0;
+
+            // 조회 → Arm → 읽기 순서 (Arm 뒤에 쓰인 페이지는 다음 필터에서 깨끗하지 않은 것으로 보임)
+            std::vector<uintptr_t> clean;
+            if (tracker && tracker->CanSkipReads()) {
+                std::vector<uintptr_t> addresses;
+                addresses.reserve(pages.size());
+                for (const PageRecord& page : pages) addresses.push_back(page.address);
+                tracker->CleanPages(addresses, clean);
+                tracker->Arm();
+            }
+            lastSkippedPages = clean.size();
+
+            // 깨끗한 페이지는 그대로 옮기고, 나머지 페이지들을 연속 구간으로 묶어 한 번에 읽음
+            PassResult kept;
+            std::vector<MemoryRange> runs;
+            size_t cleanIndex = 0;
+            for (const PageRecord& page : pages) {
+                while (cleanIndex < clean.size() && clean[cleanIndex] < page.address) ++cleanIndex;
+                if (cleanIndex < clean.size() && clean[cleanIndex] == page.address) {
+                    if (filter == ChangeFilter::Unchanged) KeepPage(kept, page);
+                    continue;
+                }
+                if (!runs.empty() && runs.back().base + runs.back().size == page.address) {
+                    runs.back().size += PageSize;
+                } else {
+                    runs.push_back({page.address, PageSize});
+                }
+            }
+
+            std::vector<PassResult> results = executor.RunUnits<PassResult>(runs, read,
+                [this, filter](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, PassResult& result) {
+                    auto it = std::lower_bound(pages.begin(), pages.end(), unit.base,
+                                               [](const PageRecord& page, uintptr_t address) { return page.address < address; });
+                    for (; it != pages.end() && it->address < unit.base + unit.size; ++it) {
+                        size_t offset = it->address - unit.base;
+                        if (offset + PageSize > size) break; // 일부만 읽힌 경우 나머지 페이지는 버림
+                        FilterPage(result, *it, data + offset, filter);
+                    }
+                });
+            results.push_back(std::move(kept));
+            Adopt(results);
+            return candidateCount;
+        }
+
+        // 남은 후보를 (주소, 현재 값) 저장소로 변환
+        ScanResultStore ToResultStore() const {
+            ScanResultStore::Builder builder(sizeof(T));
+            static const uint8_t zeroPage[PageSize] = {};
+            for (const PageRecord& page : pages) {
+                const uint8_t* data = page.isZero ? zeroPage : pageData.data() + page.dataOffset;
+                const uint64_t* bits = candidateBits.data() + page.bitsOffset;
+                size_t index = 0;
+                ForEachCandidate(bits, [&](size_t slot) {
+                    size_t offset = slot * alignment;
+                    builder.Append(page.address + offset, page.isPacked ? data + index++ * sizeof(T) : data + offset);
+                });
+            }
+            return builder.Finish();
+        }
+
+    private:
+        struct PageRecord {
+            uintptr_t address = 0;
+            size_t dataOffset = 0;      // pageData 내 위치 (isZero면 사용 안 함)
+            size_t bitsOffset = 0;      // candidateBits 내 위치 (wordsPerPage 워드)
+            uint32_t candidates = 0;
+            bool isZero = false;
+            bool isPacked = false;      // true면 데이터는 페이지 전체가 아니라 후보 값들(후보 순서, candidates * sizeof(T))
+        };
+
+        // 작업 단위 하나가 만든 페이지들 (나중에 주소 순서로 이어 붙임)
+        struct PassResult {
+            std::vector<PageRecord> pages;
+            std::vector<uint8_t> data;
+            std::vector<uint64_t> bits;
+            size_t candidates = 0;
+        };
+
+        size_t alignment;
+        size_t slotsPerPage = 0;
+        size_t wordsPerPage = 0;
+        ScanExecutor executor;
+
+        std::vector<PageRecord> pages;
+        std::vector<uint8_t> pageData;
+        std::vector<uint64_t> candidateBits;
+        size_t candidateCount = 0;
+        size_t lastSkippedPages = 0;
+
+        static bool IsZeroPage(const uint8_t* data) {
+            static const uint8_t zeroPage[PageSize] = {};
+            return memcmp(data, zeroPage, PageSize) == 0;
+        }
+
+        template<typename Callback>
+        void ForEachCandidate(const uint64_t* bits, Callback callback) const {
+            for (size_t word = 0; word < wordsPerPage; ++word) {
+                uint64_t value = bits[word];
+                while (value) {
+#if defined(_MSC_VER)
+                    unsigned long bit;
+                    _BitScanForward64(&bit, value);
+#else
+                    unsigned bit = static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+                    callback(word * 64 + bit);
+                    value &= value - 1;
+                }
+            }
+        }
+
+        // bits가 nullptr이면 모든 슬롯을 후보로 저장
+        void StorePage(PassResult& result, uintptr_t address, const uint8_t* data, const uint64_t* bits, size_t candidates = 0) {
+            PageRecord page;
+            page.address = address;
+            page.dataOffset = result.data.size();
+            if (bits && candidates * sizeof(T) <= PageSize / 4) {
+                // 후보가 적으면 값만 모아서 저장
+                page.isPacked = true;
+                ForEachCandidate(bits, [&](size_t slot) {
+                    const uint8_t* value = data + slot * alignment;
+                    result.data.insert(result.data.end(), value, value + sizeof(T));
+                });
+            } else {
+                page.isZero = IsZeroPage(data);
+                if (!page.isZero) {
+                    result.data.insert(result.data.end(), data, data + PageSize);
+                }
+            }
+            page.bitsOffset = result.bits.size();
+            if (bits) {
+                result.bits.insert(result.bits.end(), bits, bits + wordsPerPage);
+                page.candidates = static_cast<uint32_t>(candidates);
+            } else {
+                result.bits.resize(result.bits.size() + wordsPerPage, ~static_cast<uint64_t>(0));
+                if (slotsPerPage % 64) {
+                    result.bits.back() = (static_cast<uint64_t>(1) << (slotsPerPage % 64)) - 1;
+                }
+                page.candidates = static_cast<uint32_t>(slotsPerPage);
+            }
+            result.candidates += page.candidates;
+            result.pages.push_back(page);
+        }
+
+        // 읽지 않은 페이지를 데이터/비트맵 그대로 옮김
+        void KeepPage(PassResult& result, const PageRecord& page) const {
+            PageRecord copy = page;
+            copy.dataOffset = result.data.size();
+            copy.bitsOffset = result.bits.size();
+            size_t dataSize = page.isZero ? 0 : page.isPacked ? page.candidates * sizeof(T) : PageSize;
+            const uint8_t* data = pageData.data() + page.dataOffset;
+            result.data.insert(result.data.end(), data, data + dataSize);
+            const uint64_t* bits = candidateBits.data() + page.bitsOffset;
+            result.bits.insert(result.bits.end(), bits, bits + wordsPerPage);
+            result.candidates += page.candidates;
+            result.pages.push_back(copy);
+        }
+
+        void FilterPage(PassResult& result, const PageRecord& page, const uint8_t* current, ChangeFilter filter) {
+            static const uint8_t zeroPage[PageSize] = {};
+            const uint8_t* previous = page.isZero ? zeroPage : pageData.data() + page.dataOffset;
+            const uint64_t* oldBits = candidateBits.data() + page.bitsOffset;
+
+            // 페이지가 그대로면 값 비교가 필요 없음
+            if (!page.isPacked && memcmp(previous, current, PageSize) == 0) {
+                if (filter == ChangeFilter::Unchanged) {
+                    StorePage(result, page.address, current, oldBits, page.candidates);
+                }
+                return;
+            }
+
+            std::vector<uint64_t> newBits(wordsPerPage, 0);
+            size_t survivors = 0;
+            size_t index = 0;
+            ForEachCandidate(oldBits, [&](size_t slot) {
+                size_t offset = slot * alignment;
+                T before;
+                T after;
+                memcpy(&before, page.isPacked ? previous + index++ * sizeof(T) : previous + offset, sizeof(T));
+                memcpy(&after, current + offset, sizeof(T));
+                if (PassesChangeFilter(filter, after, before)) {
+                    newBits[slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+                    ++survivors;
+                }
+            });
+
+            if (survivors) {
+                StorePage(result, page.address, current, newBits.data(), survivors);
+            }
+        }
+
+        // 작업 단위별 결과를 주소 순서로 이어 붙여 새 스냅샷으로 교체
+        void Adopt(std::vector<PassResult>& results) {
+            size_t pageCount = 0;
+            size_t dataSize = 0;
+            size_t bitCount = 0;
+            for (const PassResult& result : results) {
+                pageCount += result.pages.size();
+                dataSize += result.data.size();
+                bitCount += result.bits.size();
+            }
+
+            std::vector<PageRecord> newPages;
+            std::vector<uint8_t> newData;
+            std::vector<uint64_t> newBits;
+            newPages.reserve(pageCount);
+            newData.reserve(dataSize);
+            newBits.reserve(bitCount);
+            candidateCount = 0;
+
+            for (PassResult& result : results) {
+                for (PageRecord page : result.pages) {
+                    page.dataOffset += newData.size();
+                    page.bitsOffset += newBits.size();
+                    newPages.push_back(page);
+                }
+                newData.insert(newData.end(), result.data.begin(), result.data.end());
+                newBits.insert(newBits.end(), result.bits.begin(), result.bits.end());
+                candidateCount += result.candidates;
+                result = PassResult();
+            }
+
+            // 읽지 않고 옮긴 페이지(마지막 결과)가 섞여 있으면 주소 순서로 정렬
+            auto byAddress = [](const PageRecord& a, const PageRecord& b) { return a.address < b.address; };
+            if (!std::is_sorted(newPages.begin(), newPages.end(), byAddress)) {
+                std::sort(newPages.begin(), newPages.end(), byAddress);
+            }
+
+            pages.swap(newPages);
+            pageData.swap(newData);
+            candidateBits.swap(newBits);
+        }
+    };
+}
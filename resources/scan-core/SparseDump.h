@@ -0,0 +1,503 @@
+#pragma once
+/*
+ * 희소 압축 프로세스 덤프 (0 페이지 생략, 독립 블록 압축, 메모리 매핑 색인)
+ *
+ * MemoryDump::Save()처럼 영역 내용을 그대로 쓰면 12GB 프로세스는 12GB 파일과 몇 분의 쓰기 시간이 듭니다.
+ * 게임 메모리의 상당 부분은 아직 건드리지 않은 0 페이지이고, 나머지도 잘 압축됩니다.
+ * - 영역을 64KB 블록(4KB 페이지 16개)으로 나누고, 0으로만 된 페이지는 저장하지 않음 (블록 표의 비트로만 표시)
+ * - 나머지 페이지는 블록마다 BlockCompress()로 따로 압축 (줄지 않으면 원본 저장)
+ * - 읽을 수 없는 페이지는 빠진 페이지로 표시하고 영역은 그대로 둠
+ * - 색인(영역 표, 블록 표)은 파일 끝에 두고 메모리 매핑해서 씀. 주소 → 영역은 이진 탐색,
+ *   영역 → 블록은 (주소 - base) / 64KB로 바로 찾으므로 어떤 주소든 그 블록 하나만 풀면 됨
+ *
+ * SparseDumpFile::Write()는 (영역, 블록) 작업을 여러 스레드가 나누어 읽고 압축한 뒤 파일 끝에 이어 씁니다.
+ * 스레드마다 블록 버퍼 두 개만 쓰므로 프로세스 크기와 상관없이 메모리 사용량이 일정합니다.
+ *
+ * 파일 형식 (리틀 엔디언):
+ *   헤더 64바이트: "SCSD" u32 버전(1) u32 페이지 크기 u32 블록당 페이지 수 u64 영역 수 u64 블록 수
+ *                 u64 색인 위치 u64 문자열 크기 u64 원본 바이트 수 u64 예약
+ *   블록 데이터 (쓰기 순서, 주소 순서가 아님)
+ *   색인 (8바이트 정렬):
+ *     영역 표: u64 base, u64 size, u32 protection, u32 nativeProtection, u32 type, u32 경로 길이,
+ *              u64 경로 위치, u64 첫 블록 번호
+ *     블록 표: u64 데이터 위치, u32 저장 크기, u16 저장된 페이지 비트, u16 빠진 페이지 비트
+ *              (저장 크기 == 저장된 페이지 크기 합이면 압축하지 않은 원본)
+ *     경로 문자열
+ *
+ * 사용 예:
+ *   ScanCore::SparseDumpStats stats;
+ *   ScanCore::SparseDumpFile::Write("game.scsd", *memory, [](const ScanCore::MemoryRegion& r) { return r.IsReadable(); },
+ *                                   ScanCore::SparseDumpConfig(), &stats);
+ *   ScanCore::MappedSparseDump dump;
+ *   if (dump.Open("game.scsd")) dump.ReadValue(address, value);
+ */
+
+#include "BlockCodec.h"
+#include "MappedFile.h"
+#include "ProcessMemory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ScanCore {
+
+    struct SparseDumpConfig {
+        size_t threadCount = 0;            // 0 = std::thread::hardware_concurrency()
+    };
+
+    struct SparseDumpStats {
+        size_t regions = 0;
+        size_t blocks = 0;
+        size_t pages = 0;
+        size_t zeroPages = 0;           // 0으로만 되어 있어 저장하지 않은 페이지
+        size_t missingPages = 0;        // 읽지 못한 페이지
+        uint64_t rawBytes = 0;          // 읽은 영역 크기 합 (빠진 페이지 제외)
+        uint64_t fileBytes = 0;
+        double seconds = 0.0;
+    };
+
+    class SparseDumpFile {
+    public:
+        static constexpr uint32_t FileVersion = 1;
+        static constexpr uint32_t PageSize = 4096;
+        static constexpr uint32_t BlockPages = 16;
+        static constexpr size_t BlockSize = size_t(PageSize) * BlockPages;
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t pageSize;
+            uint32_t blockPages;
+            uint64_t regionCount;
+            uint64_t blockCount;
+            uint64_t indexOffset;
+            uint64_t stringsSize;
+            uint64_t rawBytes;
+            uint64_t reserved;
+        };
+
+        struct RegionRecord {
+            uint64_t base;
+            uint64_t size;
+            uint32_t protection;
+            uint32_t nativeProtection;
+            uint32_t type;
+            uint32_t pathLength;
+            uint64_t pathOffset;
+            uint64_t firstBlock;
+        };
+
+        struct BlockRecord {
+            uint64_t offset;
+            uint32_t storedSize;
+            uint16_t presentMask;
+            uint16_t missingMask;
+        };
+
+        // 영역 크기 → 블록 수
+        static uint64_t BlockCountOf(uint64_t regionSize) { return (regionSize + BlockSize - 1) / BlockSize; }
+
+        // 영역의 block번째 블록 안 page번째 페이지 크기 (영역 끝의 마지막 페이지는 짧을 수 있음, 없으면 0)
+        static size_t PageLength(uint64_t regionSize, uint64_t block, uint32_t page) {
+            uint64_t offset = block * BlockSize + uint64_t(page) * PageSize;
+            return offset >= regionSize ? 0 : static_cast<size_t>(std::min<uint64_t>(PageSize, regionSize - offset));
+        }
+
+        /**
+         * source에서 accept(영역)이 true인 영역을 path에 덤프합니다.
+         * 영역 목록은 시작할 때 한 번 열거하고, 블록마다 읽기 → 0 페이지 검사 → 압축을 스레드들이 나누어 합니다.
+         */
+        template<typename Filter>
+        static bool Write(const std::string& path, IProcessMemory& source, Filter accept,
+                          const SparseDumpConfig& config = SparseDumpConfig(), SparseDumpStats* stats = nullptr) {
+            auto start = std::chrono::steady_clock::now();
+
+            std::vector<MemoryRegion> regions;
+            for (const MemoryRegion& region : source.EnumerateRegions()) {
+                if (region.size > 0 && accept(region)) regions.push_back(region);
+            }
+            std::sort(regions.begin(), regions.end(), [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+
+            std::vector<RegionRecord> regionRecords;
+            std::string strings;
+            uint64_t blockCount = 0;
+            for (const MemoryRegion& region : regions) {
+                regionRecords.push_back({region.base, region.size, region.protection, region.nativeProtection,
+                                         static_cast<uint32_t>(region.type), static_cast<uint32_t>(region.path.size()),
+                                         strings.size(), blockCount});
+                strings += region.path;
+                blockCount += BlockCountOf(region.size);
+            }
+            std::vector<BlockRecord> blockRecords(static_cast<size_t>(blockCount));
+
+            std::ofstream file(path, std::ios::binary);
+            if (!file) return false;
+            Header header = {};
+            WriteArray(file, &header, 1);       // 끝에서 다시 씀
+
+            std::mutex fileMutex;
+            uint64_t fileOffset = sizeof(Header);
+            bool fileOk = true;
+            std::atomic<uint64_t> nextBlock{0};
+            std::atomic<size_t> zeroPages{0};
+            std::atomic<size_t> missingPages{0};
+            std::atomic<uint64_t> rawBytes{0};
+
+            auto worker = [&]() {
+                std::vector<uint8_t> raw(BlockSize);
+                std::vector<uint8_t> packed(BlockSize);
+                size_t region = 0;
+                for (;;) {
+                    uint64_t index = nextBlock.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= blockCount) break;
+                    while (index >= regionRecords[region].firstBlock + BlockCountOf(regionRecords[region].size)) ++region;
+
+                    const RegionRecord& record = regionRecords[region];
+                    uint64_t block = index - record.firstBlock;
+                    BlockRecord& out = blockRecords[static_cast<size_t>(index)];
+                    size_t storedRaw = ReadBlock(source, record, block, raw.data(), out, zeroPages, missingPages, rawBytes);
+                    if (storedRaw == 0) continue;
+
+                    // 줄어들 때만 압축본 저장 (저장 크기 == 원본 크기면 원본)
+                    size_t packedSize = BlockCompress(raw.data(), storedRaw, packed.data(), storedRaw - 1);
+                    const uint8_t* stored = packedSize ? packed.data() : raw.data();
+                    out.storedSize = static_cast<uint32_t>(packedSize ? packedSize : storedRaw);
+
+                    std::lock_guard<std::mutex> lock(fileMutex);
+                    out.offset = fileOffset;
+                    file.write(reinterpret_cast<const char*>(stored), out.storedSize);
+                    fileOffset += out.storedSize;
+                    fileOk &= static_cast<bool>(file);
+                }
+            };
+
+            size_t threads = config.threadCount;
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+                if (threads == 0) threads = 1;
+            }
+            threads = std::max<size_t>(1, std::min<size_t>(threads, static_cast<size_t>(std::min<uint64_t>(blockCount, 64))));
+            if (threads == 1) {
+                worker();
+            } else {
+                std::vector<std::thread> pool;
+                for (size_t t = 0; t < threads; ++t) pool.emplace_back(worker);
+                for (std::thread& thread : pool) thread.join();
+            }
+
+            // 색인 (8바이트 정렬)
+            static const char padding[8] = {};
+            uint64_t indexOffset = (fileOffset + 7) & ~uint64_t(7);
+            file.write(padding, static_cast<std::streamsize>(indexOffset - fileOffset));
+            WriteArray(file, regionRecords.data(), regionRecords.size());
+            WriteArray(file, blockRecords.data(), blockRecords.size());
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+            uint64_t fileBytes = indexOffset + regionRecords.size() * sizeof(RegionRecord) +
+                                 blockRecords.size() * sizeof(BlockRecord) + strings.size();
+
+            memcpy(header.magic, "SCSD", 4);
+            header.version = FileVersion;
+            header.pageSize = PageSize;
+            header.blockPages = BlockPages;
+            header.regionCount = regionRecords.size();
+            header.blockCount = blockCount;
+            header.indexOffset = indexOffset;
+            header.stringsSize = strings.size();
+            header.rawBytes = rawBytes.load();
+            file.seekp(0);
+            WriteArray(file, &header, 1);
+            file.close();
+
+            if (stats) {
+                stats->regions = regionRecords.size();
+                stats->blocks = static_cast<size_t>(blockCount);
+                stats->pages = 0;
+                for (const RegionRecord& record : regionRecords) stats->pages += static_cast<size_t>((record.size + PageSize - 1) / PageSize);
+                stats->zeroPages = zeroPages.load();
+                stats->missingPages = missingPages.load();
+                stats->rawBytes = header.rawBytes;
+                stats->fileBytes = fileBytes;
+                stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            return fileOk && !file.fail();
+        }
+
+    private:
+        template<typename T>
+        static void WriteArray(std::ofstream& file, const T* data, size_t count) {
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        static bool IsZero(const uint8_t* data, size_t size) {
+            uint64_t accumulated = 0;
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                uint64_t word;
+                memcpy(&word, data + i, sizeof(word));
+                accumulated |= word;
+            }
+            for (; i < size; ++i) accumulated |= data[i];
+            return accumulated == 0;
+        }
+
+        /**
+         * 블록을 읽어 저장할 페이지만 raw 앞쪽으로 모으고 out의 페이지 비트를 채웁니다. 모은 바이트 수를 반환.
+         * 한 번에 읽지 못하면 페이지마다 다시 읽어 읽을 수 없는 페이지만 빠진 페이지로 표시
+         */
+        static size_t ReadBlock(IProcessMemory& source, const RegionRecord& record, uint64_t block, uint8_t* raw, BlockRecord& out,
+                                std::atomic<size_t>& zeroPages, std::atomic<size_t>& missingPages, std::atomic<uint64_t>& rawBytes) {
+            uintptr_t address = static_cast<uintptr_t>(record.base + block * BlockSize);
+            size_t blockLength = static_cast<size_t>(std::min<uint64_t>(BlockSize, record.size - block * BlockSize));
+            size_t bytesRead = 0;
+            bool whole = source.ReadBytes(address, raw, blockLength, bytesRead) && bytesRead == blockLength;
+
+            size_t stored = 0;
+            size_t zeros = 0, missing = 0;
+            uint64_t read = 0;
+            for (uint32_t page = 0; page < BlockPages; ++page) {
+                size_t length = PageLength(record.size, block, page);
+                if (length == 0) break;
+                uint8_t* data = raw + size_t(page) * PageSize;
+                if (!whole) {
+                    size_t pageRead = 0;
+                    if (!source.ReadBytes(address + size_t(page) * PageSize, data, length, pageRead) || pageRead != length) {
+                        out.missingMask |= static_cast<uint16_t>(1u << page);
+                        ++missing;
+                        continue;
+                    }
+                }
+                read += length;
+                if (IsZero(data, length)) {
+                    ++zeros;
+                    continue;
+                }
+                out.presentMask |= static_cast<uint16_t>(1u << page);
+                if (raw + stored != data) memmove(raw + stored, data, length);
+                stored += length;
+            }
+            zeroPages += zeros;
+            missingPages += missing;
+            rawBytes += read;
+            return stored;
+        }
+    };
+
+    /**
+     * 메모리 매핑한 희소 덤프 (읽기 전용). 주소가 든 블록 하나만 풀어서 읽습니다.
+     * ReadBytes()는 마지막으로 푼 블록 하나를 들고 있으므로 한 스레드에서 써야 합니다.
+     * DecodeBlock()/ReadBlocks()는 상태가 없어 여러 스레드에서 불러도 됩니다
+     * (여러 스레드 스캔은 DumpMemory.h의 SparseDumpMemory가 블록 캐시와 함께 사용).
+     */
+    class MappedSparseDump {
+    public:
+        bool Open(const std::string& path) {
+            regions.clear();
+            cachedBlock = NoBlock;
+            if (!file.Open(path) || file.Size() < sizeof(SparseDumpFile::Header)) return false;
+
+            memcpy(&header, file.Data(), sizeof(header));
+            if (memcmp(header.magic, "SCSD", 4) != 0 || header.version != SparseDumpFile::FileVersion ||
+                header.pageSize != SparseDumpFile::PageSize || header.blockPages != SparseDumpFile::BlockPages ||
+                header.indexOffset < sizeof(header) || header.indexOffset > file.Size()) {
+                file.Close();
+                return false;
+            }
+
+            // 표 위치 계산과 크기 검증 (잘린 파일, 범위를 벗어난 레코드는 거부)
+            size_t offset = static_cast<size_t>(header.indexOffset);
+            regionTable = Table<SparseDumpFile::RegionRecord>(offset, header.regionCount);
+            blockTable = Table<SparseDumpFile::BlockRecord>(offset, header.blockCount);
+            strings = header.stringsSize <= file.Size() - offset ? file.Data() + offset : nullptr;
+            if (!regionTable || !blockTable || !strings || !Validate()) {
+                file.Close();
+                return false;
+            }
+
+            for (uint64_t r = 0; r < header.regionCount; ++r) {
+                const SparseDumpFile::RegionRecord& record = regionTable[r];
+                MemoryRegion region;
+                region.base = static_cast<uintptr_t>(record.base);
+                region.size = static_cast<size_t>(record.size);
+                region.protection = record.protection;
+                region.nativeProtection = record.nativeProtection;
+                region.type = static_cast<MemoryRegionType>(record.type);
+                region.path.assign(reinterpret_cast<const char*>(strings + record.pathOffset), record.pathLength);
+                regions.push_back(std::move(region));
+            }
+            return true;
+        }
+
+        void Close() {
+            file.Close();
+            regions.clear();
+            cachedBlock = NoBlock;
+        }
+
+        bool IsOpen() const { return file.IsOpen(); }
+        const std::vector<MemoryRegion>& Regions() const { return regions; }
+        uint64_t BlockCount() const { return header.blockCount; }
+        uint64_t RawBytes() const { return header.rawBytes; }
+
+        // address를 포함하는 영역 번호 (없으면 -1)
+        ptrdiff_t FindRegion(uintptr_t address) const {
+            auto it = std::upper_bound(regions.begin(), regions.end(), address,
+                                       [](uintptr_t value, const MemoryRegion& region) { return value < region.base; });
+            if (it == regions.begin() || !std::prev(it)->Contains(address)) return -1;
+            return std::prev(it) - regions.begin();
+        }
+
+        /**
+         * region번째 영역의 block번째 블록을 out(BlockSize 바이트)에 풉니다. 0 페이지는 0으로 채움.
+         * 빠진 페이지 비트를 missingMask에 돌려줌 (그 페이지 내용은 0). 손상된 블록이면 false
+         */
+        bool DecodeBlock(size_t region, uint64_t block, uint8_t* out, uint16_t& missingMask) const {
+            const SparseDumpFile::RegionRecord& record = regionTable[region];
+            const SparseDumpFile::BlockRecord& entry = blockTable[record.firstBlock + block];
+            missingMask = entry.missingMask;
+
+            size_t storedRaw = 0;
+            for (uint32_t page = 0; page < SparseDumpFile::BlockPages; ++page) {
+                if (entry.presentMask & (1u << page)) storedRaw += SparseDumpFile::PageLength(record.size, block, page);
+            }
+            // 저장된 페이지를 앞쪽에 풀고 뒤에서부터 제자리로 옮김
+            const uint8_t* stored = file.Data() + entry.offset;
+            if (storedRaw > 0) {
+                if (entry.storedSize == storedRaw) memcpy(out, stored, storedRaw);
+                else if (!BlockDecompress(stored, entry.storedSize, out, storedRaw)) return false;
+            }
+            size_t cursor = storedRaw;
+            for (uint32_t page = SparseDumpFile::BlockPages; page-- > 0;) {
+                size_t length = SparseDumpFile::PageLength(record.size, block, page);
+                uint8_t* target = out + size_t(page) * SparseDumpFile::PageSize;
+                if (entry.presentMask & (1u << page)) {
+                    cursor -= length;
+                    if (out + cursor != target) memmove(target, out + cursor, length);
+                } else if (length > 0) {
+                    memset(target, 0, length);
+                }
+            }
+            return true;
+        }
+
+        // 영역에 걸친 읽기도 이어서 처리. 영역 밖이나 빠진 페이지에 닿으면 거기까지 읽고 실패
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) {
+            return ReadBlocks(address, buffer, size, bytesRead,
+                [this](size_t region, uint64_t block, const uint8_t*& data, uint16_t& missingMask) {
+                    uint64_t index = regionTable[region].firstBlock + block;
+                    if (index != cachedBlock) {
+                        cache.resize(SparseDumpFile::BlockSize);
+                        cachedBlock = NoBlock;
+                        if (!DecodeBlock(region, block, cache.data(), cachedMissing)) return false;
+                        cachedBlock = index;
+                    }
+                    data = cache.data();
+                    missingMask = cachedMissing;
+                    return true;
+                });
+        }
+
+        /**
+         * [address, address + size)를 블록 단위로 나누어 fetch(영역 번호, 블록 번호, data&, missingMask&)로 받은
+         * 풀린 블록에서 복사합니다. 블록을 어떻게 풀고 들고 있을지(캐시)는 fetch가 정함
+         */
+        template<typename Fetch>
+        bool ReadBlocks(uintptr_t address, void* buffer, size_t size, size_t& bytesRead, Fetch fetch) const {
+            bytesRead = 0;
+            uint8_t* dest = static_cast<uint8_t*>(buffer);
+            while (bytesRead < size) {
+                uintptr_t current = address + bytesRead;
+                ptrdiff_t region = FindRegion(current);
+                if (region < 0) return false;
+                uint64_t offset = current - regions[static_cast<size_t>(region)].base;
+                uint64_t block = offset / SparseDumpFile::BlockSize;
+                const uint8_t* data = nullptr;
+                uint16_t missingMask = 0;
+                if (!fetch(static_cast<size_t>(region), block, data, missingMask)) return false;
+
+                size_t inBlock = static_cast<size_t>(offset % SparseDumpFile::BlockSize);
+                size_t length = std::min(size - bytesRead, static_cast<size_t>(std::min<uint64_t>(
+                    SparseDumpFile::BlockSize - inBlock, regions[static_cast<size_t>(region)].size - offset)));
+                // 빠진 페이지 앞까지만
+                for (size_t page = inBlock / SparseDumpFile::PageSize; missingMask && page * SparseDumpFile::PageSize < inBlock + length; ++page) {
+                    if (missingMask & (1u << page)) {
+                        size_t available = page * SparseDumpFile::PageSize > inBlock ? page * SparseDumpFile::PageSize - inBlock : 0;
+                        memcpy(dest + bytesRead, data + inBlock, available);
+                        bytesRead += available;
+                        return false;
+                    }
+                }
+                memcpy(dest + bytesRead, data + inBlock, length);
+                bytesRead += length;
+            }
+            return true;
+        }
+
+        // region번째 영역의 block번째 블록 표 항목 (파일 전체에서 고유한 블록 번호는 BlockIndex)
+        const SparseDumpFile::BlockRecord& Block(size_t region, uint64_t block) const {
+            return blockTable[regionTable[region].firstBlock + block];
+        }
+
+        uint64_t BlockIndex(size_t region, uint64_t block) const { return regionTable[region].firstBlock + block; }
+
+        template<typename T>
+        bool ReadValue(uintptr_t address, T& value) {
+            size_t bytesRead = 0;
+            return ReadBytes(address, &value, sizeof(T), bytesRead) && bytesRead == sizeof(T);
+        }
+
+    private:
+        static constexpr uint64_t NoBlock = ~uint64_t(0);
+
+        MappedFile file;
+        SparseDumpFile::Header header = {};
+        const SparseDumpFile::RegionRecord* regionTable = nullptr;
+        const SparseDumpFile::BlockRecord* blockTable = nullptr;
+        const uint8_t* strings = nullptr;
+        std::vector<MemoryRegion> regions;
+
+        std::vector<uint8_t> cache;
+        uint64_t cachedBlock = NoBlock;
+        uint16_t cachedMissing = 0;
+
+        template<typename T>
+        const T* Table(size_t& offset, uint64_t count) {
+            if (count > (file.Size() - offset) / sizeof(T)) return nullptr;
+            const T* table = reinterpret_cast<const T*>(file.Data() + offset);
+            offset += static_cast<size_t>(count) * sizeof(T);
+            return table;
+        }
+
+        // 영역이 정렬되어 겹치지 않고, 블록 번호와 데이터 위치가 파일 안에 있는지
+        bool Validate() const {
+            uint64_t previousEnd = 0;
+            for (uint64_t r = 0; r < header.regionCount; ++r) {
+                const SparseDumpFile::RegionRecord& record = regionTable[r];
+                uint64_t blocks = SparseDumpFile::BlockCountOf(record.size);
+                if (record.size == 0 || record.base < previousEnd || record.base + record.size < record.base ||
+                    record.firstBlock > header.blockCount || blocks > header.blockCount - record.firstBlock ||
+                    record.pathOffset > header.stringsSize || record.pathLength > header.stringsSize - record.pathOffset) {
+                    return false;
+                }
+                previousEnd = record.base + record.size;
+            }
+            for (uint64_t b = 0; b < header.blockCount; ++b) {
+                const SparseDumpFile::BlockRecord& entry = blockTable[b];
+                if (entry.storedSize == 0) continue;        // 0/빠진 페이지만 있는 블록
+                if (entry.storedSize > SparseDumpFile::BlockSize || entry.offset < sizeof(SparseDumpFile::Header) ||
+                    entry.offset > header.indexOffset || entry.storedSize > header.indexOffset - entry.offset) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
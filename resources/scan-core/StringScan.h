@@ -0,0 +1,200 @@
+#pragma once
+/*
+ * 문자열 스캔 (ASCII/UTF-8, UTF-16LE, 대소문자 무시)
+ *
+ * 게임은 이름, 아이템 ID, 설정 키 같은 문자열을 UTF-8(ASCII)과 UTF-16LE(Windows wchar_t) 양쪽으로 씁니다.
+ * 검색어(UTF-8)를 인코딩마다 바이트열로 바꾸고 CompiledPattern으로 컴파일해 찾습니다.
+ * - 대소문자 무시: ASCII 글자 바이트의 마스크를 0xDF로 두어 'a'와 'A'를 함께 찾음 (한글 등 그 외 문자는 정확히 비교)
+ * - 블록마다 첫 글자와 마지막 글자 위치(UTF-16은 각 글자의 아래 바이트, 0x00인 위 바이트는 피함)만 SIMD로
+ *   비교하고, 후보는 16바이트 단위 마스크 비교로 확인. 텍스트에서는 글자 하나의 빈도가 높아 memchr로 건너뛰면 느림
+ * - 두 인코딩 모두 같은 버퍼(청크)에서 이어서 찾으므로 메모리는 한 번만 읽음
+ *
+ * 결과는 주소 오름차순이며 어느 인코딩으로 찾았는지 함께 기록합니다.
+ *
+ * 사용 예:
+ *   ScanCore::StringSearchOptions options;
+ *   options.caseInsensitive = true;
+ *   ScanCore::StringSearcher searcher("PlayerName", options);
+ *   std::vector<ScanCore::StringMatch> matches = ScanCore::ScanStrings(executor, ranges, readFn, searcher);
+ *   for (const auto& match : matches) { match.address; ScanCore::StringEncodingName(match.encoding); }
+ */
+
+#include "CompiledPattern.h"
+#include "ScanExecutor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ScanCore {
+
+    enum class StringEncoding : uint8_t {
+        Utf8,
+        Utf16LE
+    };
+
+    inline const char* StringEncodingName(StringEncoding encoding) {
+        return encoding == StringEncoding::Utf16LE ? "UTF-16LE" : "UTF-8";
+    }
+
+    struct StringMatch {
+        uintptr_t address;
+        StringEncoding encoding;
+    };
+
+    struct StringSearchOptions {
+        bool utf8 = true;
+        bool utf16 = true;
+        bool caseInsensitive = false;   // ASCII A-Z / a-z만
+        bool alignedUtf16 = false;      // UTF-16LE는 짝수 주소만
+    };
+
+    /**
+     * UTF-8을 UTF-16 코드 단위로 변환합니다 (BMP 밖 문자는 서로게이트 쌍).
+     * 잘못된 UTF-8(잘린 시퀀스, 과잉 길이, 서로게이트 범위)이면 false
+     */
+    inline bool Utf8ToUtf16(const std::string& text, std::u16string& out) {
+        out.clear();
+        size_t i = 0;
+        while (i < text.size()) {
+            uint8_t lead = static_cast<uint8_t>(text[i]);
+            size_t extra;
+            uint32_t codePoint;
+            if (lead < 0x80) { extra = 0; codePoint = lead; }
+            else if ((lead & 0xE0) == 0xC0) { extra = 1; codePoint = lead & 0x1F; }
+            else if ((lead & 0xF0) == 0xE0) { extra = 2; codePoint = lead & 0x0F; }
+            else if ((lead & 0xF8) == 0xF0) { extra = 3; codePoint = lead & 0x07; }
+            else return false;
+            if (i + extra >= text.size()) return false;     // 잘린 시퀀스
+            for (size_t n = 1; n <= extra; ++n) {
+                uint8_t next = static_cast<uint8_t>(text[i + n]);
+                if ((next & 0xC0) != 0x80) return false;
+                codePoint = (codePoint << 6) | (next & 0x3F);
+            }
+            static const uint32_t minimum[4] = {0, 0x80, 0x800, 0x10000};
+            if (codePoint < minimum[extra] || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return false;
+
+            if (codePoint >= 0x10000) {
+                codePoint -= 0x10000;
+                out.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+                out.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+            } else {
+                out.push_back(static_cast<char16_t>(codePoint));
+            }
+            i += extra + 1;
+        }
+        return true;
+    }
+
+    class StringSearcher {
+    public:
+        StringSearcher() = default;
+
+        // utf8Text: 검색어 (UTF-8). 비었거나 잘못된 UTF-8이면 Empty()
+        explicit StringSearcher(const std::string& utf8Text, const StringSearchOptions& options = StringSearchOptions())
+            : options(options) {
+            std::u16string units;
+            if (utf8Text.empty() || !Utf8ToUtf16(utf8Text, units)) return;
+
+            if (options.utf8) {
+                std::vector<uint8_t> bytes(utf8Text.begin(), utf8Text.end());
+                std::vector<uint8_t> masks(bytes.size(), 0xFF);
+                for (size_t j = 0; j < bytes.size(); ++j) masks[j] = FoldMask(bytes[j]);
+                utf8 = CompiledPattern::FromByteMask(bytes, masks).WithAnchors(0, bytes.size() - 1);
+            }
+            if (options.utf16) {
+                std::vector<uint8_t> bytes;
+                std::vector<uint8_t> masks;
+                for (char16_t unit : units) {
+                    uint8_t low = static_cast<uint8_t>(unit & 0xFF);
+                    uint8_t high = static_cast<uint8_t>(unit >> 8);
+                    bytes.push_back(low);
+                    bytes.push_back(high);
+                    masks.push_back(high == 0 ? FoldMask(low) : 0xFF);
+                    masks.push_back(0xFF);
+                }
+                utf16 = CompiledPattern::FromByteMask(bytes, masks).WithAnchors(0, bytes.size() - 2);
+            }
+        }
+
+        bool Empty() const { return utf8.Empty() && utf16.Empty(); }
+
+        // 가장 긴 인코딩의 바이트 수 (실행기 overlap = MaxSize() - 1)
+        size_t MaxSize() const { return std::max(utf8.Size(), utf16.Size()); }
+
+        const CompiledPattern& Pattern(StringEncoding encoding) const {
+            return encoding == StringEncoding::Utf16LE ? utf16 : utf8;
+        }
+
+        const StringSearchOptions& Options() const { return options; }
+
+        /**
+         * 버퍼에서 문자열이 시작하는 모든 위치를 찾아 out에 추가합니다 (주소 오름차순, 같은 주소면 UTF-8 먼저).
+         * 추가된 개수를 반환합니다.
+         */
+        size_t FindAll(const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<StringMatch>& out,
+                       SimdLevel level = ActiveSimdLevel()) const {
+            thread_local std::vector<uintptr_t> utf8Hits;
+            thread_local std::vector<uintptr_t> utf16Hits;
+            utf8Hits.clear();
+            utf16Hits.clear();
+            if (!utf8.Empty()) utf8.FindAll(data, size, baseAddress, utf8Hits, level);
+            if (!utf16.Empty()) {
+                utf16.FindAll(data, size, baseAddress, utf16Hits, level);
+                if (options.alignedUtf16) {
+                    utf16Hits.erase(std::remove_if(utf16Hits.begin(), utf16Hits.end(), [](uintptr_t address) { return (address & 1) != 0; }),
+                                    utf16Hits.end());
+                }
+            }
+
+            size_t before = out.size();
+            size_t a = 0, b = 0;
+            while (a < utf8Hits.size() || b < utf16Hits.size()) {
+                if (b == utf16Hits.size() || (a < utf8Hits.size() && utf8Hits[a] <= utf16Hits[b])) {
+                    out.push_back({utf8Hits[a++], StringEncoding::Utf8});
+                } else {
+                    out.push_back({utf16Hits[b++], StringEncoding::Utf16LE});
+                }
+            }
+            return out.size() - before;
+        }
+
+    private:
+        StringSearchOptions options;
+        CompiledPattern utf8;
+        CompiledPattern utf16;
+
+        // ASCII 글자는 0x20 비트(대/소문자)를 무시
+        uint8_t FoldMask(uint8_t byte) const {
+            bool letter = (byte >= 'A' && byte <= 'Z') || (byte >= 'a' && byte <= 'z');
+            return options.caseInsensitive && letter ? 0xDF : 0xFF;
+        }
+    };
+
+    /**
+     * ranges 전체를 executor로 한 번 읽으며 모든 인코딩의 문자열 위치를 찾습니다 (주소 오름차순).
+     * 작업 단위 경계에 걸친 문자열도 찾도록 executor의 overlap을 searcher.MaxSize() - 1로 설정합니다.
+     */
+    inline std::vector<StringMatch> ScanStrings(ScanExecutor& executor, const std::vector<MemoryRange>& ranges,
+                                                const ScanExecutor::ReadFunction& read, const StringSearcher& searcher) {
+        std::vector<StringMatch> matches;
+        if (searcher.Empty()) return matches;
+
+        executor.SetOverlap(searcher.MaxSize() - 1);
+        std::vector<std::vector<StringMatch>> units = executor.RunUnits<std::vector<StringMatch>>(ranges, read,
+            [&searcher](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, std::vector<StringMatch>& found) {
+                searcher.FindAll(data, size, unit.base, found);
+                uintptr_t unitEnd = unit.base + unit.size;
+                found.erase(std::remove_if(found.begin(), found.end(), [unitEnd](const StringMatch& match) { return match.address >= unitEnd; }),
+                            found.end());
+            });
+
+        size_t total = 0;
+        for (const std::vector<StringMatch>& found : units) total += found.size();
+        matches.reserve(total);
+        for (const std::vector<StringMatch>& found : units) matches.insert(matches.end(), found.begin(), found.end());
+        return matches;
+    }
+}
@@ -0,0 +1,255 @@
+#pragma once
+/*
+ * 타입별 스캔 결과 저장소 (모든 타입 스캔용)
+ *
+ * 값의 타입을 모르고 스캔하면 같은 주소가 int32로도, float로도 후보가 될 수 있습니다.
+ * 이 저장소는 타입마다 ScanResultStore(압축 저장소, 값 크기 = 타입 크기)를 하나씩 두고,
+ * 순회할 때는 타입별 저장소를 (주소, 타입) 순으로 병합해 하나의 오름차순 목록처럼 보여 줍니다.
+ *
+ * 다음 스캔(FilterTypedResultStore)은 병합 순서대로 BatchReader 한 번에 모든 타입의 후보를 읽고,
+ * 후보마다 자기 타입으로 이전 값과 비교합니다. 같은 페이지를 타입 수만큼 다시 읽지 않습니다.
+ *
+ * 사용 예:
+ *   ScanCore::TypedResultStore results = ScanCore::ScanAllTypes(executor, ranges, readFn, query);
+ *   for (const auto& entry : results) { entry.address; entry.type; entry.value; }
+ *   results = ScanCore::FilterTypedResultStore(results, ScanCore::ChangeFilter::Decreased, reader, &tracker);
+ */
+
+#include "DirtyPageTracker.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace ScanCore {
+
+    enum class ValueType : uint8_t {
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        Float,
+        Double
+    };
+
+    constexpr size_t ValueTypeCount = 6;
+
+    // 타입 집합 (비트 1 << ValueType)
+    using ValueTypeMask = uint32_t;
+
+    constexpr ValueTypeMask ValueTypeBit(ValueType type) { return 1u << static_cast<unsigned>(type); }
+
+    constexpr ValueTypeMask AllValueTypes = (1u << ValueTypeCount) - 1;
+
+    inline size_t ValueTypeSize(ValueType type) {
+        static const size_t sizes[ValueTypeCount] = {1, 2, 4, 8, 4, 8};
+        return sizes[static_cast<size_t>(type)];
+    }
+
+    inline const char* ValueTypeName(ValueType type) {
+        static const char* const names[ValueTypeCount] = {"int8", "int16", "int32", "int64", "float", "double"};
+        return names[static_cast<size_t>(type)];
+    }
+
+    // 타입에 맞춰 double ↔ 메모리 바이트
+    inline void EncodeValue(ValueType type, double value, uint8_t* out) {
+        switch (type) {
+        case ValueType::Int8: { int8_t v = static_cast<int8_t>(value); memcpy(out, &v, sizeof(v)); break; }
+        case ValueType::Int16: { int16_t v = static_cast<int16_t>(value); memcpy(out, &v, sizeof(v)); break; }
+        case ValueType::Int32: { int32_t v = static_cast<int32_t>(value); memcpy(out, &v, sizeof(v)); break; }
+        case ValueType::Int64: { int64_t v = static_cast<int64_t>(value); memcpy(out, &v, sizeof(v)); break; }
+        case ValueType::Float: { float v = static_cast<float>(value); memcpy(out, &v, sizeof(v)); break; }
+        case ValueType::Double: memcpy(out, &value, sizeof(value)); break;
+        }
+    }
+
+    inline double DecodeValue(ValueType type, const uint8_t* data) {
+        switch (type) {
+        case ValueType::Int8: { int8_t v; memcpy(&v, data, sizeof(v)); return v; }
+        case ValueType::Int16: { int16_t v; memcpy(&v, data, sizeof(v)); return v; }
+        case ValueType::Int32: { int32_t v; memcpy(&v, data, sizeof(v)); return v; }
+        case ValueType::Int64: { int64_t v; memcpy(&v, data, sizeof(v)); return static_cast<double>(v); }
+        case ValueType::Float: { float v; memcpy(&v, data, sizeof(v)); return v; }
+        case ValueType::Double: { double v; memcpy(&v, data, sizeof(v)); return v; }
+        }
+        return 0.0;
+    }
+
+    class TypedResultStore {
+    public:
+        struct Entry {
+            uintptr_t address;
+            ValueType type;
+            const uint8_t* value;   // ValueTypeSize(type) 바이트
+        };
+
+        // 타입별 저장소를 (주소, 타입) 오름차순으로 병합하는 전진 반복자
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Entry;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Entry*;
+            using reference = Entry;
+
+            const_iterator() = default;
+
+            Entry operator*() const {
+                ScanResultStore::Entry entry = *positions[current];
+                return {entry.address, static_cast<ValueType>(current), entry.value};
+            }
+
+            const_iterator& operator++() {
+                ++positions[current];
+                Load(current);
+                SelectCurrent();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                return current == other.current && (current == ValueTypeCount || positions[current] == other.positions[current]);
+            }
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+        private:
+            friend class TypedResultStore;
+
+            static constexpr uintptr_t Exhausted = std::numeric_limits<uintptr_t>::max();
+
+            const TypedResultStore* owner = nullptr;
+            ScanResultStore::const_iterator positions[ValueTypeCount];
+            uintptr_t heads[ValueTypeCount] = {};     // 타입별 현재 주소 (끝이면 Exhausted)
+            size_t current = ValueTypeCount;          // 가장 작은 (주소, 타입). 모두 끝이면 ValueTypeCount
+
+            explicit const_iterator(const TypedResultStore* store, bool atEnd) : owner(store) {
+                for (size_t t = 0; t < ValueTypeCount; ++t) {
+                    positions[t] = atEnd ? store->stores[t].end() : store->stores[t].begin();
+                    Load(t);
+                }
+                SelectCurrent();
+            }
+
+            void Load(size_t type) {
+                heads[type] = positions[type] != owner->stores[type].end() ? (*positions[type]).address : Exhausted;
+            }
+
+            void SelectCurrent() {
+                current = ValueTypeCount;
+                uintptr_t lowest = Exhausted;
+                for (size_t t = 0; t < ValueTypeCount; ++t) {
+                    if (heads[t] < lowest) {     // 같은 주소면 앞 타입 먼저
+                        lowest = heads[t];
+                        current = t;
+                    }
+                }
+            }
+        };
+
+        TypedResultStore() {
+            for (size_t t = 0; t < ValueTypeCount; ++t) {
+                stores[t] = ScanResultStore::Builder(ValueTypeSize(static_cast<ValueType>(t))).Finish();
+            }
+        }
+
+        const ScanResultStore& Store(ValueType type) const { return stores[static_cast<size_t>(type)]; }
+
+        // 타입의 저장소를 교체 (store의 값 크기는 ValueTypeSize(type)이어야 함)
+        void SetStore(ValueType type, ScanResultStore store) { stores[static_cast<size_t>(type)] = std::move(store); }
+
+        size_t Count() const {
+            size_t total = 0;
+            for (const ScanResultStore& store : stores) total += store.Count();
+            return total;
+        }
+
+        size_t Count(ValueType type) const { return Store(type).Count(); }
+        bool Empty() const { return Count() == 0; }
+
+        size_t MemoryUsage() const {
+            size_t total = 0;
+            for (const ScanResultStore& store : stores) total += store.MemoryUsage();
+            return total;
+        }
+
+        // 후보가 있는 타입의 집합
+        ValueTypeMask Types() const {
+            ValueTypeMask mask = 0;
+            for (size_t t = 0; t < ValueTypeCount; ++t) {
+                if (!stores[t].Empty()) mask |= ValueTypeBit(static_cast<ValueType>(t));
+            }
+            return mask;
+        }
+
+        const_iterator begin() const { return const_iterator(this, false); }
+        const_iterator end() const { return const_iterator(this, true); }
+
+    private:
+        ScanResultStore stores[ValueTypeCount];
+    };
+
+    namespace Detail {
+
+        template<typename T>
+        inline bool PassesTypedFilter(ChangeFilter filter, const uint8_t* current, const uint8_t* previous) {
+            T currentValue;
+            T previousValue;
+            memcpy(&currentValue, current, sizeof(T));
+            memcpy(&previousValue, previous, sizeof(T));
+            return PassesChangeFilter(filter, currentValue, previousValue);
+        }
+
+        inline bool PassesTypedFilter(ValueType type, ChangeFilter filter, const uint8_t* current, const uint8_t* previous) {
+            switch (type) {
+                case ValueType::Int8: return PassesTypedFilter<int8_t>(filter, current, previous);
+                case ValueType::Int16: return PassesTypedFilter<int16_t>(filter, current, previous);
+                case ValueType::Int32: return PassesTypedFilter<int32_t>(filter, current, previous);
+                case ValueType::Int64: return PassesTypedFilter<int64_t>(filter, current, previous);
+                case ValueType::Float: return PassesTypedFilter<float>(filter, current, previous);
+                case ValueType::Double: return PassesTypedFilter<double>(filter, current, previous);
+            }
+            return false;
+        }
+    }
+
+    /**
+     * 타입별 결과 다음 스캔: 모든 타입의 후보를 주소 순으로 한 번에 읽고, 후보마다 자기 타입으로
+     * 이전 값과 filter를 비교합니다. 정수는 부호 있는 값으로 비교합니다.
+     * tracker가 SoftDirty면 깨끗한 페이지의 후보는 읽지 않습니다 (변경 없음만 통과).
+     * 페이지 해시(PageHash)는 타입 하나짜리 FilterResultStore에서만 사용합니다.
+     */
+    inline TypedResultStore FilterTypedResultStore(const TypedResultStore& store, ChangeFilter filter, BatchReader& reader,
+                                                   DirtyPageTracker* tracker = nullptr) {
+        ScanResultStore::Builder builders[ValueTypeCount] = {
+            ScanResultStore::Builder(1), ScanResultStore::Builder(2), ScanResultStore::Builder(4),
+            ScanResultStore::Builder(8), ScanResultStore::Builder(4), ScanResultStore::Builder(8)};
+        auto addressOf = [](const TypedResultStore::Entry& entry) { return entry.address; };
+        auto sizeOf = [](const TypedResultStore::Entry& entry) { return ValueTypeSize(entry.type); };
+
+        SkipCleanPages(tracker, reader, store.begin(), store.end(), addressOf, sizeOf);
+        reader.ForEachSized(store.begin(), store.end(), sizeOf, addressOf,
+            [&](const TypedResultStore::Entry& entry, const uint8_t* current) {
+                ScanResultStore::Builder& builder = builders[static_cast<size_t>(entry.type)];
+                if (current == nullptr) {   // 깨끗한 페이지 = 값이 그대로
+                    if (filter == ChangeFilter::Unchanged) builder.Append(entry.address, entry.value);
+                    return;
+                }
+                if (Detail::PassesTypedFilter(entry.type, filter, current, entry.value)) {
+                    builder.Append(entry.address, current);
+                }
+            });
+        reader.SetSkippedPages({});
+
+        TypedResultStore result;
+        for (size_t t = 0; t < ValueTypeCount; ++t) result.SetStore(static_cast<ValueType>(t), builders[t].Finish());
+        return result;
+    }
+}
@@ -0,0 +1,294 @@
+#pragma once
+/*
+ * 일괄 메모리 쓰기 (페이지 구간별 보호 변경, 벡터 쓰기, 보호 복원 보장, 다시 읽어 검증)
+ *
+ * 값마다 보호 변경 → 쓰기 → 보호 복원을 하면 쓰기 하나에 시스템 호출 3번이고,
+ * 항목 200개짜리 치트 테이블은 틱마다 600번입니다. WriteTransaction은 (주소, 바이트)를 모았다가 한 번에 씁니다.
+ * - 주소순으로 정렬해 겹치거나 맞닿은 쓰기를 하나로 합침 (같은 바이트는 나중에 추가한 값이 이김)
+ * - 합친 쓰기를 IProcessMemory::WriteBatch 한 번으로 보냄 (Linux는 process_vm_writev iovec 배열)
+ * - 보호 변경:
+ *   OnFailure(기본): 먼저 그대로 쓰고, 실패한 쓰기가 걸친 페이지 구간만 보호를 바꿔 다시 씀
+ *                    (힙 같은 쓰기 가능 메모리는 보호 변경 없이 시스템 호출 1번)
+ *   Always: 모든 쓰기의 페이지 구간을 먼저 쓰기 가능으로 바꾸고 씀 (코드 패치)
+ *   보호를 바꿀 구간은 RegionMap이 있으면 영역 경계에서, 없으면 페이지마다 나눔
+ *   (VirtualProtectEx는 구간 첫 페이지의 이전 보호만 알려 주므로 보호가 다른 페이지를 한 번에 바꾸면 복원할 수 없음)
+ * - 바꾼 보호는 Commit()이 끝날 때(예외가 나도) 바꾼 역순으로 모두 되돌림
+ * - verify: 쓴 뒤 ReadBatch로 다시 읽어 비교
+ *
+ * 사용 예:
+ *   ScanCore::WriteTransaction transaction(*memory);
+ *   for (const CheatEntry& entry : table) transaction.Add(entry.address, entry.value);
+ *   ScanCore::WriteTransaction::Result result = transaction.Commit(&regions);   // regions: RegionMap (선택)
+ *   if (!result.Ok()) { ... transaction.Failed(i) ... }
+ */
+
+#include "ProcessMemory.h"
+#include "RegionMap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace ScanCore {
+
+    enum class ProtectMode {
+        OnFailure,      // 쓰기가 실패한 페이지 구간만 보호 변경
+        Always,         // 모든 페이지 구간을 쓰기 전에 보호 변경
+        Never           // 보호를 바꾸지 않음
+    };
+
+    struct WriteTransactionConfig {
+        ProtectMode protect = ProtectMode::OnFailure;
+        bool verify = false;                // 쓴 뒤 다시 읽어 비교
+        size_t pageSize = 4096;
+    };
+
+    class WriteTransaction {
+    public:
+        struct Result {
+            size_t writes = 0;              // Add()한 쓰기 수
+            size_t failed = 0;              // 끝까지 쓰지 못했거나 검증에 실패한 쓰기 수
+            size_t spans = 0;               // 합친 뒤의 연속 쓰기 수
+            size_t writeCalls = 0;          // WriteBatch/WriteBytes 호출 수
+            size_t protectCalls = 0;        // Protect 호출 수 (변경 + 복원)
+            size_t verifyMismatches = 0;    // 다시 읽은 값이 다른 연속 쓰기 수
+
+            bool Ok() const { return failed == 0; }
+        };
+
+        explicit WriteTransaction(IProcessMemory& memory, const WriteTransactionConfig& config = WriteTransactionConfig())
+            : memory(memory), config(config) {}
+
+        // data[0..size)를 address에 쓰도록 추가 (바이트는 복사해 둠)
+        void Add(uintptr_t address, const void* data, size_t size) {
+            if (size == 0) return;
+            entries.push_back({address, size, bytes.size()});
+            const uint8_t* source = static_cast<const uint8_t*>(data);
+            bytes.insert(bytes.end(), source, source + size);
+        }
+
+        template<typename T>
+        void Add(uintptr_t address, const T& value) {
+            Add(address, &value, sizeof(T));
+        }
+
+        size_t Size() const { return entries.size(); }
+        bool Empty() const { return entries.empty(); }
+
+        void Clear() {
+            entries.clear();
+            bytes.clear();
+            failed.clear();
+        }
+
+        // 마지막 Commit()에서 index번째로 Add()한 쓰기가 실패했으면 true
+        bool Failed(size_t index) const { return index < failed.size() && failed[index]; }
+
+        /**
+         * 모은 쓰기를 모두 씁니다. regions가 있으면 보호를 바꿀 구간을 영역 경계에서 나눕니다 (없으면 페이지마다).
+         * 쓰기 목록은 그대로 남으므로 같은 값을 다시 쓸 때(값 고정) 다시 Commit()하면 됩니다.
+         */
+        Result Commit(RegionMap* regions = nullptr) {
+            Result result;
+            result.writes = entries.size();
+            failed.assign(entries.size(), false);
+            if (entries.empty()) return result;
+
+            BuildSpans();
+            result.spans = spans.size();
+
+            ProtectionGuard guard(memory, result);
+            std::vector<bool> spanFailed(spans.size(), false);
+
+            if (config.protect == ProtectMode::Always) {
+                // 페이지가 이어지거나 겹치는 쓰기들을 한 구간으로 묶어 보호 변경
+                uintptr_t pageMask = static_cast<uintptr_t>(config.pageSize) - 1;
+                size_t first = 0;
+                while (first < spans.size()) {
+                    uintptr_t begin = spans[first].address & ~pageMask;
+                    uintptr_t end = (spans[first].address + spans[first].size + pageMask) & ~pageMask;
+                    size_t next = first + 1;
+                    while (next < spans.size() && (spans[next].address & ~pageMask) <= end) {
+                        end = std::max(end, (spans[next].address + spans[next].size + pageMask) & ~pageMask);
+                        ++next;
+                    }
+                    ProtectPages(begin, end, regions, guard);
+                    first = next;
+                }
+            }
+
+            std::vector<WriteRequest> requests(spans.size());
+            for (size_t s = 0; s < spans.size(); ++s) {
+                requests[s].address = spans[s].address;
+                requests[s].data = spanBytes.data() + spans[s].offset;
+                requests[s].size = spans[s].size;
+            }
+            memory.WriteBatch(requests.data(), requests.size());
+            ++result.writeCalls;
+
+            for (size_t s = 0; s < spans.size(); ++s) {
+                if (requests[s].ok) continue;
+                if (config.protect == ProtectMode::OnFailure) {
+                    uintptr_t pageMask = static_cast<uintptr_t>(config.pageSize) - 1;
+                    ProtectPages(spans[s].address & ~pageMask, (spans[s].address + spans[s].size + pageMask) & ~pageMask, regions, guard);
+                    size_t written = 0;
+                    ++result.writeCalls;
+                    if (memory.WriteBytes(spans[s].address, spanBytes.data() + spans[s].offset, spans[s].size, written) &&
+                        written == spans[s].size) {
+                        continue;
+                    }
+                }
+                spanFailed[s] = true;
+                if (regions) regions->RefreshAround(spans[s].address);
+            }
+
+            // 다시 읽기 전에 보호를 되돌림 (읽기는 보호와 무관, 복원이 늦어지지 않도록)
+            guard.Restore();
+
+            if (config.verify) Verify(spanFailed, result);
+
+            for (size_t e = 0; e < entries.size(); ++e) {
+                if (spanFailed[entrySpan[e]]) {
+                    failed[e] = true;
+                    ++result.failed;
+                }
+            }
+            return result;
+        }
+
+    private:
+        struct Entry {
+            uintptr_t address;
+            size_t size;
+            size_t offset;          // bytes 안 위치
+        };
+
+        struct Span {
+            uintptr_t address;
+            size_t size;
+            size_t offset;          // spanBytes 안 위치
+        };
+
+        // 바꾼 보호를 기록했다가 역순으로 되돌림 (소멸자에서도)
+        class ProtectionGuard {
+        public:
+            ProtectionGuard(IProcessMemory& memory, Result& result) : memory(memory), result(result) {}
+            ~ProtectionGuard() { Restore(); }
+
+            ProtectionGuard(const ProtectionGuard&) = delete;
+            ProtectionGuard& operator=(const ProtectionGuard&) = delete;
+
+            // [address, address + size)를 쓰기 가능으로. 바로 전에 바꾼 구간 안이면 건너뜀 (구간은 주소순으로 들어옴)
+            void MakeWritable(uintptr_t address, size_t size) {
+                if (!changes.empty() && address >= changes.back().address &&
+                    address + size <= changes.back().address + changes.back().size) {
+                    return;
+                }
+                uint32_t old = 0;
+                ++result.protectCalls;
+                if (memory.Protect(address, size, MemoryRead | MemoryWrite | MemoryExecute, old)) {
+                    changes.push_back({address, size, old});
+                }
+            }
+
+            void Restore() {
+                for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+                    uint32_t ignored = 0;
+                    ++result.protectCalls;
+                    memory.Protect(it->address, it->size, it->protection, ignored);
+                }
+                changes.clear();
+            }
+
+        private:
+            struct Changed {
+                uintptr_t address;
+                size_t size;
+                uint32_t protection;
+            };
+
+            IProcessMemory& memory;
+            Result& result;
+            std::vector<Changed> changes;
+        };
+
+        IProcessMemory& memory;
+        WriteTransactionConfig config;
+        std::vector<Entry> entries;
+        std::vector<uint8_t> bytes;
+        std::vector<bool> failed;
+
+        std::vector<Span> spans;
+        std::vector<uint8_t> spanBytes;
+        std::vector<size_t> entrySpan;      // Add() 순서 → spans 번호
+
+        // 주소순으로 정렬해 겹치거나 맞닿은 쓰기를 합침. 같은 주소는 Add() 순서대로 덮어씀
+        void BuildSpans() {
+            std::vector<size_t> order(entries.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(),
+                             [this](size_t a, size_t b) { return entries[a].address < entries[b].address; });
+
+            spans.clear();
+            spanBytes.clear();
+            entrySpan.assign(entries.size(), 0);
+            size_t start = 0;
+            while (start < order.size()) {
+                uintptr_t begin = entries[order[start]].address;
+                uintptr_t end = begin + entries[order[start]].size;
+                size_t stop = start + 1;
+                while (stop < order.size() && entries[order[stop]].address <= end) {
+                    end = std::max(end, entries[order[stop]].address + entries[order[stop]].size);
+                    ++stop;
+                }
+
+                // 구간 안의 쓰기를 Add() 순서대로 적용
+                Span span{begin, static_cast<size_t>(end - begin), spanBytes.size()};
+                spanBytes.resize(spanBytes.size() + span.size);
+                std::vector<size_t> members(order.begin() + start, order.begin() + stop);
+                std::sort(members.begin(), members.end());
+                for (size_t e : members) {
+                    memcpy(spanBytes.data() + span.offset + (entries[e].address - begin), bytes.data() + entries[e].offset, entries[e].size);
+                    entrySpan[e] = spans.size();
+                }
+                spans.push_back(span);
+                start = stop;
+            }
+        }
+
+        // 페이지 구간 [begin, end)를 보호가 같은 조각(영역 또는 페이지)마다 쓰기 가능으로 바꿈
+        void ProtectPages(uintptr_t begin, uintptr_t end, RegionMap* regions, ProtectionGuard& guard) {
+            while (begin < end) {
+                uintptr_t pieceEnd = begin + config.pageSize;
+                if (regions) {
+                    const MemoryRegion* region = regions->Find(begin);
+                    if (region) pieceEnd = std::max(pieceEnd, std::min<uintptr_t>(end, region->base + region->size));
+                }
+                pieceEnd = std::min(pieceEnd, end);
+                guard.MakeWritable(begin, static_cast<size_t>(pieceEnd - begin));
+                begin = pieceEnd;
+            }
+        }
+
+        void Verify(std::vector<bool>& spanFailed, Result& result) {
+            std::vector<uint8_t> readBack(spanBytes.size());
+            std::vector<ReadRequest> requests(spans.size());
+            for (size_t s = 0; s < spans.size(); ++s) {
+                requests[s].address = spans[s].address;
+                requests[s].buffer = readBack.data() + spans[s].offset;
+                requests[s].size = spans[s].size;
+            }
+            memory.ReadBatch(requests.data(), requests.size());
+            for (size_t s = 0; s < spans.size(); ++s) {
+                if (spanFailed[s]) continue;
+                if (!requests[s].ok || memcmp(readBack.data() + spans[s].offset, spanBytes.data() + spans[s].offset, spans[s].size) != 0) {
+                    spanFailed[s] = true;
+                    ++result.verifyMismatches;
+                }
+            }
+        }
+    };
+}
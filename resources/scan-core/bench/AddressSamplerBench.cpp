@@ -0,0 +1,264 @@
+/*
+ * 고속 주소 샘플러 벤치마크 (주소마다 읽기 + deque + 복사 통계 대비 AddressSampler)
+ *
+ * 1. 이동 통계: 무작위 값 열을 넣으며 RollingStats의 최소/최대/평균/분산을 창 전체를 다시 계산한 값과 비교하고,
+ *    지금의 FPSMonitor 방식(deque → vector 복사 → 최소/최대/평균/분산)과 통계 한 번당 시간을 비교합니다.
+ * 2. 링 버퍼: 생산자 스레드가 쉬지 않고 넣는 동안 소비자가 Snapshot()을 반복해, 찢어진/순서가 어긋난 샘플이 없는지 검증합니다.
+ * 3. 샘플러: 주소 N개(기본 64)를 주소마다 ReadValue로 읽는 틱과 ReadBatch 한 번인 Tick()의 최대 틱 속도를 비교하고,
+ *    통계 범위(minimumValue/maximumValue) 밖의 값이 시계열에만 들어가고 통계에서 빠지는지 확인한 뒤,
+ *    Start()로 지정한 주기(기본 10kHz)로 돌리면서 소비자 스레드가 통계/스냅샷을 계속 읽어도 주기를 지키는지 봅니다.
+ *
+ * Linux는 이 프로세스(LinuxProcessMemory), 그 외에는 MemoryDump를 대상으로 합니다.
+ *
+ * 사용법: AddressSamplerBench [주소 수, 기본 64] [주기(Hz), 기본 10000]
+ */
+
+#include "../AddressSampler.h"
+#include "../MemoryDump.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Exact {
+        double minimum, maximum, mean, variance;
+    };
+
+    // 지금의 FPSMonitor::CalculateStatistics 방식: 창 전체를 vector로 복사해 한 번씩 훑음
+    Exact CopyStatistics(const std::deque<double>& readings) {
+        std::vector<double> values(readings.begin(), readings.end());
+        Exact exact;
+        exact.minimum = *std::min_element(values.begin(), values.end());
+        exact.maximum = *std::max_element(values.begin(), values.end());
+        double sum = 0.0;
+        for (double value : values) sum += value;
+        exact.mean = sum / values.size();
+        double squares = 0.0;
+        for (double value : values) squares += (value - exact.mean) * (value - exact.mean);
+        exact.variance = squares / values.size();
+        return exact;
+    }
+
+    bool Close(double a, double b) { return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b)); }
+
+    bool CheckRollingStats(size_t window, size_t count) {
+        std::mt19937_64 rng(24);
+        std::normal_distribution<double> noise(60.0, 8.0);
+        std::vector<double> values(count);
+        for (size_t i = 0; i < count; ++i) {
+            // 가끔 큰 값 변화 (프레임 드롭, 로딩)
+            values[i] = i % 5000 < 100 ? noise(rng) * 0.3 : noise(rng) + (i / 20000) * 100.0;
+        }
+
+        // 샘플마다 통계까지 읽는 시간
+        RollingStats timed(window);
+        volatile double sink = 0.0;     // 통계 읽기가 최적화로 사라지지 않도록
+        auto start = std::chrono::steady_clock::now();
+        for (double value : values) {
+            timed.Add(value);
+            sink = sink + timed.Minimum() + timed.Maximum() + timed.Mean() + timed.Variance();
+        }
+        double rollingSeconds = Seconds(start);
+
+        RollingStats rolling(window);
+        std::deque<double> readings;
+        size_t wrong = 0, checks = 0;
+        double copySeconds = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            rolling.Add(values[i]);
+            readings.push_back(values[i]);
+            if (readings.size() > window) readings.pop_front();
+            if (i % 7 != 0) continue;
+            start = std::chrono::steady_clock::now();
+            Exact exact = CopyStatistics(readings);
+            copySeconds += Seconds(start);
+            ++checks;
+            wrong += rolling.Minimum() != exact.minimum || rolling.Maximum() != exact.maximum || !Close(rolling.Mean(), exact.mean) ||
+                     !Close(rolling.Variance(), exact.variance);
+        }
+        printf("  %-22s window %zu: rolling %.0f ns/sample (add + stats), deque copy %.0f ns/stats, wrong=%zu/%zu\n", "rolling stats",
+               window, rollingSeconds / count * 1e9, copySeconds / checks * 1e9, wrong, checks);
+        return wrong == 0;
+    }
+
+    bool CheckRing() {
+        SampleRing ring(1024);
+        std::atomic<bool> done{false};
+        const uint64_t total = 2000000;
+        std::thread producer([&]() {
+            for (uint64_t i = 0; i < total; ++i) ring.Push(i, static_cast<double>(i) * 0.5);
+            done = true;
+        });
+        std::vector<Sample> snapshot;
+        size_t snapshots = 0, samples = 0, wrong = 0;
+        while (!done.load()) {
+            ring.Snapshot(snapshot, 512);
+            ++snapshots;
+            samples += snapshot.size();
+            for (size_t i = 0; i < snapshot.size(); ++i) {
+                wrong += snapshot[i].value != snapshot[i].time * 0.5;
+                if (i) wrong += snapshot[i].time != snapshot[i - 1].time + 1;
+            }
+        }
+        producer.join();
+        ring.Snapshot(snapshot);
+        wrong += snapshot.size() != ring.Capacity() || snapshot.back().time != total - 1;
+        printf("  %-22s %llu pushes, %zu snapshots while pushing (%zu samples), torn/out of order=%zu\n", "ring buffer",
+               (unsigned long long)total, snapshots, samples, wrong);
+        return wrong == 0;
+    }
+
+    struct Target {
+        std::unique_ptr<IProcessMemory> memory;
+        std::vector<uintptr_t> addresses;
+        std::vector<float> values;      // Linux: 이 프로세스 안의 값
+    };
+
+    std::unique_ptr<Target> MakeTarget(size_t count) {
+        auto target = std::make_unique<Target>();
+        // 서로 다른 캐시 줄/페이지에 흩어진 float
+        const size_t stride = 1024 + 16;
+#if defined(__linux__)
+        target->values.resize(count * stride / sizeof(float) + 1);
+        for (size_t i = 0; i < count; ++i) {
+            float* slot = target->values.data() + i * stride / sizeof(float);
+            *slot = 30.0f + i;
+            target->addresses.push_back(reinterpret_cast<uintptr_t>(slot));
+        }
+        target->memory = std::make_unique<LinuxProcessMemory>(getpid());
+#else
+        auto dump = std::make_unique<MemoryDump>();
+        MemoryRegion region;
+        region.base = 0x10000000;
+        region.protection = MemoryRead | MemoryWrite;
+        std::vector<uint8_t> data(count * stride + 16);
+        for (size_t i = 0; i < count; ++i) {
+            float value = 30.0f + i;
+            memcpy(data.data() + i * stride, &value, sizeof(value));
+            target->addresses.push_back(region.base + i * stride);
+        }
+        dump->AddRegion(region, std::move(data));
+        target->memory = std::move(dump);
+#endif
+        return target;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t addressCount = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 64;
+    double rateHz = argc > 2 ? std::strtod(argv[2], nullptr) : 10000.0;
+    bool ok = true;
+
+    printf("AddressSamplerBench: %zu addresses, %.0f Hz\n", addressCount, rateHz);
+    ok &= CheckRollingStats(600, 200000);
+    ok &= CheckRollingStats(10000, 200000);
+    ok &= CheckRing();
+
+    std::unique_ptr<Target> target = MakeTarget(addressCount);
+    const double measureSeconds = 0.3;
+
+    // 기존 방식: 주소마다 값 하나 읽기 + deque에 넣기
+    {
+        std::vector<std::deque<double>> history(addressCount);
+        size_t ticks = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (Seconds(start) < measureSeconds) {
+            for (size_t i = 0; i < addressCount; ++i) {
+                float value = 0.0f;
+                if (!target->memory->ReadValue(target->addresses[i], value)) continue;
+                history[i].push_back(value);
+                if (history[i].size() > 1000) history[i].pop_front();
+            }
+            ++ticks;
+        }
+        printf("  %-22s %.0f ticks/s max\n", "ReadValue per address", ticks / Seconds(start));
+    }
+
+    AddressSamplerConfig config;
+    config.rateHz = rateHz;
+    AddressSampler sampler(*target->memory, config);
+    for (uintptr_t address : target->addresses) sampler.Watch(address, ValueType::Float);
+    {
+        size_t ticks = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (Seconds(start) < measureSeconds) {
+            sampler.Tick();
+            ++ticks;
+        }
+        printf("  %-22s %.0f ticks/s max (one ReadBatch per tick)\n", "AddressSampler::Tick", ticks / Seconds(start));
+    }
+
+    // 통계 범위 밖의 값: 시계열에는 있고 통계에는 없음 (주소 i의 값은 30 + i)
+    {
+        AddressSamplerConfig ranged = config;
+        ranged.minimumValue = 30.5;
+        ranged.maximumValue = 30.0 + addressCount - 1;
+        AddressSampler filtered(*target->memory, ranged);
+        for (uintptr_t address : target->addresses) filtered.Watch(address, ValueType::Float);
+        for (int n = 0; n < 10; ++n) filtered.Tick();
+        size_t wrong = 0;
+        for (size_t i = 0; i < filtered.Size(); ++i) {
+            bool inRange = 30.0 + i > ranged.minimumValue && 30.0 + i < ranged.maximumValue;
+            WindowStats stats = filtered.GetWindowStats(i);
+            wrong += filtered.SampleCount(i) != 10 || stats.count != (inRange ? 10u : 0u) || (inRange && stats.minimum != 30.0 + i);
+        }
+        printf("  %-22s out-of-range values kept out of window stats, wrong=%zu\n", "value range", wrong);
+        ok &= wrong == 0;
+    }
+
+    // 지정한 주기로 돌리면서 소비자가 계속 읽음
+    {
+        AddressSampler timed(*target->memory, config);
+        for (uintptr_t address : target->addresses) timed.Watch(address, ValueType::Float);
+        timed.Start();
+        std::atomic<bool> done{false};
+        size_t consumerReads = 0, wrong = 0;
+        std::thread consumer([&]() {
+            std::vector<Sample> recent;
+            while (!done.load()) {
+                for (size_t i = 0; i < timed.Size(); ++i) {
+                    WindowStats stats = timed.GetWindowStats(i);
+                    wrong += stats.count && (stats.minimum != 30.0 + i || stats.maximum != 30.0 + i || stats.variance != 0.0);
+                    timed.Snapshot(i, recent, 600);
+                    for (size_t s = 1; s < recent.size(); ++s) wrong += recent[s].time <= recent[s - 1].time;
+                    ++consumerReads;
+                }
+                std::this_thread::yield();
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        timed.Stop();
+        done = true;
+        consumer.join();
+        AddressSampler::Stats stats = timed.GetStats();
+        printf("  %-22s %.0f samples/s per address over %.2fs (target %.0f), %llu overruns, busy %.0f%%, failed reads %llu\n", "Start()",
+               stats.Rate(), stats.seconds, rateHz, (unsigned long long)stats.overruns, stats.busySeconds / stats.seconds * 100.0,
+               (unsigned long long)stats.failedReads);
+        printf("  %-22s %zu stats + snapshot reads while sampling, wrong=%zu\n", "consumer", consumerReads, wrong);
+        ok &= wrong == 0 && stats.failedReads == 0 && stats.ticks > 0 && timed.SampleCount(0) == stats.ticks;
+    }
+
+    if (!ok) {
+        printf("ERROR: sampler statistics or snapshots were wrong\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * 후보 일괄 읽기 벤치마크
+ *
+ * 이 프로세스 안의 합성 힙에서 정렬된 후보 주소(기본 1000만 개)를 골라 다음 스캔처럼 현재 값을 읽습니다.
+ * - 후보마다 읽기 한 번 (기존 ReadMemory 방식, 일부 후보로 측정 후 전체 시간 추정)
+ * - BatchReader + process_vm_readv iovec 배치 (Linux)
+ * - BatchReader + 단일 읽기 함수 (구간마다 한 번)
+ * 읽은 값이 실제 메모리와 같은지, 읽을 수 없는 페이지의 후보만 건너뛰는지 검증합니다.
+ *
+ * 사용법: BatchReaderBench [후보 수(백만), 기본 10] [힙 크기(MB), 기본 256]
+ */
+
+#include "../BatchReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 모든 후보를 읽고 읽은 값의 합계로 검증
+    bool RunBatch(const char* name, BatchReader& reader, const std::vector<uintptr_t>& candidates, uint64_t expectedSum) {
+        uint64_t sum = 0;
+        size_t visited = 0;
+        auto start = std::chrono::steady_clock::now();
+        reader.ForEachAddress(candidates, sizeof(int), [&](uintptr_t, const uint8_t* current) {
+            int value;
+            memcpy(&value, current, sizeof(int));
+            sum += static_cast<uint32_t>(value);
+            ++visited;
+        });
+        double seconds = Seconds(start);
+
+        const BatchReader::Stats& stats = reader.GetLastStats();
+        bool ok = sum == expectedSum && visited == candidates.size();
+        printf("%-22s %8.3fs  %7.1f M/s  runs=%-8zu batches=%-6zu read=%7.1f MB%s\n", name, seconds,
+               candidates.size() / seconds / 1e6, stats.runs, stats.batches, stats.bytesRead / (1024.0 * 1024.0),
+               ok ? "" : "  MISMATCH");
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 10;
+    size_t megabytes = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 256;
+    if (millions == 0) millions = 1;
+    if (megabytes == 0) megabytes = 1;
+
+    std::mt19937_64 rng(5);
+    std::vector<int> heap(megabytes * 1024 * 1024 / sizeof(int));
+    for (int& value : heap) value = static_cast<int>(rng() % 1000);
+
+    // 정렬된 후보 (정렬된 int 위치 중 무작위 선택)
+    size_t count = std::min(millions * 1000000, heap.size());
+    std::vector<uintptr_t> candidates;
+    candidates.reserve(count);
+    uint64_t expectedSum = 0;
+    for (size_t i = 0, remaining = count; i < heap.size() && remaining > 0; ++i) {
+        if (rng() % (heap.size() - i) < remaining) {
+            candidates.push_back(reinterpret_cast<uintptr_t>(&heap[i]));
+            expectedSum += static_cast<uint32_t>(heap[i]);
+            --remaining;
+        }
+    }
+    printf("BatchReaderBench: %zu candidates in %zu MB\n", candidates.size(), megabytes);
+
+    auto memcpyRead = [](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+        memcpy(buffer, reinterpret_cast<const void*>(address), size);
+        bytesRead = size;
+        return true;
+    };
+    bool ok = true;
+
+#if defined(__linux__)
+    // 기존 방식: 후보마다 시스템 호출 한 번
+    {
+        pid_t pid = getpid();
+        size_t sample = std::min<size_t>(candidates.size(), 500000);
+        uint64_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < sample; ++i) {
+            int value = 0;
+            struct iovec local = {&value, sizeof(int)};
+            struct iovec remote = {reinterpret_cast<void*>(candidates[i]), sizeof(int)};
+            if (process_vm_readv(pid, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(sizeof(int))) {
+                sum += static_cast<uint32_t>(value);
+            }
+        }
+        double seconds = Seconds(start);
+        printf("%-22s %8.3fs  %7.1f M/s  (%zu sampled, ~%.1fs for all)\n", "per-address syscall", seconds,
+               sample / seconds / 1e6, sample, seconds * candidates.size() / sample);
+    }
+
+    BatchReader vmReader(MakeProcessVmBatchRead(getpid()));
+    ok &= RunBatch("batched process_vm_readv", vmReader, candidates, expectedSum);
+#endif
+
+    BatchReader runReader(MakeBatchRead(memcpyRead));
+    ok &= RunBatch("batched per-run read", runReader, candidates, expectedSum);
+
+#if defined(__linux__)
+    // 읽을 수 없는 페이지가 섞인 경우: 가운데 페이지 후보만 빠져야 함
+    {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        uint8_t* pages = static_cast<uint8_t*>(mmap(nullptr, pageSize * 3, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (pages != MAP_FAILED) {
+            memset(pages, 1, pageSize * 3);
+            mprotect(pages + pageSize, pageSize, PROT_NONE);
+            std::vector<uintptr_t> mixed;
+            for (long offset = 0; offset < pageSize * 3; offset += 256) mixed.push_back(reinterpret_cast<uintptr_t>(pages + offset));
+
+            size_t visited = 0;
+            bool valuesOk = true;
+            vmReader.ForEachAddress(mixed, sizeof(int), [&](uintptr_t address, const uint8_t* current) {
+                valuesOk &= address < reinterpret_cast<uintptr_t>(pages + pageSize) ||
+                            address >= reinterpret_cast<uintptr_t>(pages + pageSize * 2);
+                valuesOk &= current[0] == 1;
+                ++visited;
+            });
+            bool mixedOk = valuesOk && visited == mixed.size() * 2 / 3 && vmReader.GetLastStats().unreadable == mixed.size() / 3;
+            printf("%-22s visited=%zu unreadable=%zu%s\n", "unreadable page", visited, vmReader.GetLastStats().unreadable,
+                   mixedOk ? "" : "  MISMATCH");
+            ok &= mixedOk;
+            munmap(pages, pageSize * 3);
+        }
+    }
+#endif
+
+    if (!ok) {
+        printf("ERROR: batched reads differ from memory contents\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,337 @@
+/*
+ * 치트 테이블 고정 엔진 벤치마크 (항목마다 경로 따라가기 + 쓰기 대비 CheatTable)
+ *
+ * 합성 게임 메모리(MemoryDump + 가짜 모듈 game.exe)에 플레이어 객체 여러 개를 두고, 항목(기본 400개)의 절반은 고정 주소,
+ * 절반은 모듈 정적 포인터에서 시작하는 2~3단 포인터 경로로 만듭니다. 틱마다 게임이 값을 바꾸고(체력 감소, 탄약 소모),
+ * 가끔 플레이어를 "리스폰"(객체를 새 위치로 옮기고 정적 포인터 갱신)합니다.
+ * - 기존 방식: 틱마다 항목마다 PointerScanner::Resolve + WriteValue (지금의 Trainer::GameLoop를 항목 수만큼)
+ * - CheatTable::Tick: 기억한 포인터 칸 검증 + 범위 항목 읽기(ReadBatch 1번) → 쓰기(WriteTransaction 1번)
+ * 틱당 시간과 백엔드 호출 수를 비교하고, 리스폰 뒤에도 모든 값이 새 위치에서 고정/범위 안인지 검증합니다.
+ * 백엔드 호출마다 다른 프로세스 메모리 시스템 호출 비용(기본 1us, ReadProcessMemory/process_vm_readv 정도)을 바쁜 대기로 더합니다.
+ * 마지막으로 Start()로 지정한 주기(기본 200Hz)로 돌려 틱 지연과 지터(평균/최대/p99)를 출력합니다.
+ *
+ * 사용법: CheatTableBench [항목 수, 기본 400] [주기(Hz), 기본 200] [호출 비용(us), 기본 1]
+ */
+
+#include "../CheatTable.h"
+#include "../MemoryDump.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t ModuleBase = 0x140000000;
+    const size_t ModuleSize = 64 * 1024;
+    const uintptr_t HeapBase = 0x200000000;
+    const size_t HeapSize = 4 * 1024 * 1024;
+    const size_t PlayerSize = 256;          // 0x00 체력 float, 0x04 방어 int, 0x10 인벤토리 포인터, 0x40.. 고정 주소 항목용
+    const size_t InventorySize = 256;       // 0x00.. 탄약 int 칸
+    const size_t PlayerCount = 32;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // MemoryDump에 모듈 목록을 붙이고 백엔드 호출 수를 세며 호출마다 callCost만큼 기다리는 래퍼
+    class GameMemory : public IProcessMemory {
+    public:
+        explicit GameMemory(MemoryDump& inner) : inner(inner) {}
+
+        size_t calls = 0;
+        std::chrono::nanoseconds callCost{0};
+
+        std::vector<MemoryRegion> EnumerateRegions() override {
+            Pay();
+            return inner.EnumerateRegions();
+        }
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override {
+            Pay();
+            return inner.QueryRegion(address, result);
+        }
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            Pay();
+            return inner.ReadBytes(address, buffer, size, bytesRead);
+        }
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            Pay();
+            return inner.WriteBytes(address, data, size, bytesWritten);
+        }
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            Pay();
+            return inner.Protect(address, size, protection, oldProtection);
+        }
+        void ReadBatch(ReadRequest* requests, size_t count) override {
+            Pay();
+            inner.ReadBatch(requests, count);
+        }
+        void WriteBatch(WriteRequest* requests, size_t count) override {
+            Pay();
+            inner.WriteBatch(requests, count);
+        }
+        std::vector<ModuleRange> EnumerateModules() override {
+            Pay();
+            ModuleRange module;
+            module.name = "game.exe";
+            module.base = ModuleBase;
+            module.size = ModuleSize;
+            return {module};
+        }
+
+    private:
+        MemoryDump& inner;
+
+        void Pay() {
+            ++calls;
+            if (callCost.count() == 0) return;
+            auto until = std::chrono::steady_clock::now() + callCost;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+        }
+    };
+
+    // 플레이어 객체와 인벤토리를 힙에 놓고 모듈 정적 포인터(game.exe+0x1000 + 8*i)로 가리키는 게임
+    class Game {
+    public:
+        MemoryDump dump;
+
+        Game() {
+            MemoryRegion module;
+            module.base = ModuleBase;
+            module.protection = MemoryRead | MemoryWrite;
+            dump.AddRegion(module, std::vector<uint8_t>(ModuleSize));
+            MemoryRegion heap;
+            heap.base = HeapBase;
+            heap.protection = MemoryRead | MemoryWrite;
+            dump.AddRegion(heap, std::vector<uint8_t>(HeapSize));
+            for (size_t i = 0; i < PlayerCount; ++i) Spawn(i);
+        }
+
+        static uintptr_t StaticSlot(size_t player) { return ModuleBase + 0x1000 + 8 * player; }
+
+        uintptr_t Player(size_t player) {
+            uint64_t address = 0;
+            dump.ReadValue(StaticSlot(player), address);
+            return static_cast<uintptr_t>(address);
+        }
+
+        uintptr_t Inventory(size_t player) {
+            uint64_t address = 0;
+            dump.ReadValue(Player(player) + 0x10, address);
+            return static_cast<uintptr_t>(address);
+        }
+
+        // 새 위치에 플레이어 + 인벤토리를 만들고 정적 포인터 갱신 (옛 객체는 0으로 지움)
+        void Spawn(size_t player) {
+            uintptr_t old = Player(player);
+            if (old) {
+                std::vector<uint8_t> zero(PlayerSize);
+                dump.WriteBytes(Inventory(player), zero.data(), InventorySize, ignored);
+                dump.WriteBytes(old, zero.data(), PlayerSize, ignored);
+            }
+            uintptr_t object = Allocate(PlayerSize);
+            uintptr_t inventory = Allocate(InventorySize);
+            dump.WriteValue(object, 100.0f);
+            dump.WriteValue(object + 0x04, int32_t(50));
+            dump.WriteValue(object + 0x10, static_cast<uint64_t>(inventory));
+            for (size_t slot = 0; slot < InventorySize; slot += 4) dump.WriteValue(inventory + slot, int32_t(30));
+            dump.WriteValue(StaticSlot(player), static_cast<uint64_t>(object));
+        }
+
+        // 게임 한 프레임: 체력/탄약/방어/고정 칸 값이 바뀜
+        void Frame(std::mt19937_64& rng) {
+            for (size_t i = 0; i < PlayerCount; ++i) {
+                uintptr_t object = Player(i);
+                float health = 0.0f;
+                dump.ReadValue(object, health);
+                dump.WriteValue(object, health - 7.0f);
+                dump.WriteValue(object + 0x04, static_cast<int32_t>(rng() % 1000) - 200);
+                uintptr_t inventory = Inventory(i);
+                for (size_t slot = 0; slot < InventorySize; slot += 4 * (1 + rng() % 4)) dump.WriteValue(inventory + slot, int32_t(0));
+            }
+            for (uintptr_t slot = HeapBase; slot < HeapBase + 64 * 1024; slot += 4 * (1 + rng() % 16)) dump.WriteValue(slot, uint32_t(rng()));
+        }
+
+    private:
+        uintptr_t next = HeapBase + 64 * 1024;     // 앞 64KB는 고정 주소 항목용
+        size_t ignored = 0;
+
+        uintptr_t Allocate(size_t size) {
+            if (next + size > HeapBase + HeapSize) next = HeapBase + 64 * 1024;
+            uintptr_t result = next;
+            next += size;
+            return result;
+        }
+    };
+
+    PointerPath PathTo(size_t player, const std::vector<uintptr_t>& offsets) {
+        PointerPath path;
+        path.module = "game.exe";
+        path.moduleBase = ModuleBase;
+        path.baseOffset = Game::StaticSlot(player) - ModuleBase;
+        path.offsets = offsets;
+        return path;
+    }
+
+    // 모든 항목이 기대한 값/범위인지 (경로 항목은 지금의 경로로 직접 따라가 확인)
+    size_t CountWrong(Game& game, const std::vector<CheatEntry>& entries) {
+        size_t wrong = 0;
+        for (const CheatEntry& entry : entries) {
+            if (!entry.enabled) continue;
+            uintptr_t address = entry.address;
+            if (entry.usePath && !PointerScanner::Resolve(game.dump, ModuleBase, entry.path, address)) {
+                ++wrong;
+                continue;
+            }
+            uint8_t buffer[8] = {};
+            size_t bytesRead = 0;
+            game.dump.ReadBytes(address, buffer, ValueTypeSize(entry.type), bytesRead);
+            double value = DecodeValue(entry.type, buffer);
+            if (entry.mode == CheatMode::Freeze) wrong += value != entry.value;
+            else wrong += value < entry.minimum || value > entry.maximum;
+        }
+        return wrong;
+    }
+
+    void PrintTiming(const char* name, const CheatTable::Timing& timing) {
+        printf("  %-18s mean %.1fus  max %.1fus  p99 %.1fus\n", name, timing.mean, timing.max, timing.p99);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t entryCount = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 400;
+    double rateHz = argc > 2 ? std::strtod(argv[2], nullptr) : 200.0;
+    double callMicroseconds = argc > 3 ? std::strtod(argv[3], nullptr) : 1.0;
+    auto callCost = std::chrono::nanoseconds(static_cast<long long>(callMicroseconds * 1000));
+    const size_t ticks = 200;
+    const size_t respawnEvery = 25;
+
+    Game game;
+    GameMemory memory(game.dump);
+    memory.callCost = callCost;
+
+    // 항목: 짝수 번째는 고정 주소(힙 앞 64KB의 4바이트 칸), 홀수 번째는 경로
+    // (체력 float 고정 1단, 방어 int 범위 1단, 인벤토리 탄약 int 고정 2단)
+    std::vector<CheatEntry> entries;
+    std::mt19937_64 rng(23);
+    for (size_t i = 0; i < entryCount; ++i) {
+        size_t player = (i / 2) % PlayerCount;
+        if (i % 2 == 0) {
+            entries.push_back(CheatEntry::Freeze("fixed", HeapBase + 4 * (i / 2), ValueType::Int32, double(i)));
+        } else if (i % 6 == 1) {
+            entries.push_back(CheatEntry::Freeze("health", PathTo(player, {0x00}), ValueType::Float, 100.0));
+        } else if (i % 6 == 3) {
+            entries.push_back(CheatEntry::Clamp("armor", PathTo(player, {0x04}), ValueType::Int32, 0, 500));
+        } else {
+            entries.push_back(CheatEntry::Freeze("ammo", PathTo(player, {0x10, (i / 6) * 4 % InventorySize}), ValueType::Int32, 99));
+        }
+    }
+    printf("CheatTableBench: %zu entries (%zu pointer paths) on %zu players, %zu ticks, respawn every %zu ticks, %.1f us per backend call\n",
+           entries.size(), entries.size() / 2, PlayerCount, ticks, respawnEvery, callMicroseconds);
+    bool ok = true;
+
+    // 기존 방식: 틱마다 항목마다 경로 따라가기 + 값 하나 쓰기
+    {
+        std::mt19937_64 frameRng(24);
+        size_t wrong = 0;
+        memory.calls = 0;
+        double tickSeconds = 0.0;
+        uint8_t buffer[8];
+        for (size_t tick = 0; tick < ticks; ++tick) {
+            game.Frame(frameRng);
+            if (tick % respawnEvery == respawnEvery - 1) game.Spawn(tick % PlayerCount);
+            auto start = std::chrono::steady_clock::now();
+            for (const CheatEntry& entry : entries) {
+                uintptr_t address = entry.address;
+                if (entry.usePath) {
+                    uintptr_t base = 0;
+                    for (const ModuleRange& module : memory.EnumerateModules()) {
+                        if (module.name == entry.path.module) base = module.base;
+                    }
+                    if (!PointerScanner::Resolve(memory, base, entry.path, address)) continue;
+                }
+                double value = entry.value;
+                if (entry.mode == CheatMode::Clamp) {
+                    size_t bytesRead = 0;
+                    memory.ReadBytes(address, buffer, ValueTypeSize(entry.type), bytesRead);
+                    value = DecodeValue(entry.type, buffer);
+                    if (value >= entry.minimum && value <= entry.maximum) continue;
+                    value = value < entry.minimum ? entry.minimum : entry.maximum;
+                }
+                size_t bytesWritten = 0;
+                EncodeValue(entry.type, value, buffer);
+                memory.WriteBytes(address, buffer, ValueTypeSize(entry.type), bytesWritten);
+            }
+            tickSeconds += Seconds(start);
+            wrong += CountWrong(game, entries);
+        }
+        printf("  %-18s %.1f us/tick  %.1f backend calls/tick  wrong=%zu\n", "resolve + write", tickSeconds / ticks * 1e6,
+               double(memory.calls) / ticks, wrong);
+        ok &= wrong == 0;
+    }
+
+    // CheatTable::Tick
+    {
+        Game fresh;
+        GameMemory freshMemory(fresh.dump);
+        freshMemory.callCost = callCost;
+        CheatTable table(freshMemory);
+        for (const CheatEntry& entry : entries) table.Add(entry);
+        std::mt19937_64 frameRng(24);
+        size_t wrong = 0;
+        freshMemory.calls = 0;
+        double tickSeconds = 0.0;
+        for (size_t tick = 0; tick < ticks; ++tick) {
+            fresh.Frame(frameRng);
+            if (tick % respawnEvery == respawnEvery - 1) fresh.Spawn(tick % PlayerCount);
+            auto start = std::chrono::steady_clock::now();
+            table.Tick();
+            tickSeconds += Seconds(start);
+            wrong += CountWrong(fresh, entries);
+        }
+        CheatTable::Stats stats = table.GetStats();
+        printf("  %-18s %.1f us/tick  %.1f backend calls/tick  wrong=%zu\n", "CheatTable", tickSeconds / ticks * 1e6,
+               double(freshMemory.calls) / ticks, wrong);
+        printf("  %-18s resolves %llu  invalidations %llu  clamped %llu  failed writes %llu\n", "", (unsigned long long)stats.resolves,
+               (unsigned long long)stats.invalidations, (unsigned long long)stats.clamped, (unsigned long long)stats.failedWrites);
+        ok &= wrong == 0 && stats.failedWrites == 0 && stats.invalidations > 0;
+
+        // 끈 항목은 쓰지 않음
+        table.SetEnabled(0, false);
+        fresh.dump.WriteValue(entries[0].address, int32_t(-1));
+        table.Tick();
+        int32_t disabled = 0;
+        fresh.dump.ReadValue(entries[0].address, disabled);
+        ok &= disabled == -1 && !table.IsEnabled(0);
+        table.SetEnabled(0, true);
+
+        // 지정한 주기로 돌리기 (게임 쪽 변경 없이 타이밍만)
+        CheatTableConfig config;
+        config.rateHz = rateHz;
+        CheatTable timed(freshMemory, config);
+        for (const CheatEntry& entry : entries) timed.Add(entry);
+        timed.Start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        timed.Stop();
+        CheatTable::Stats timing = timed.GetStats();
+        printf("  %-18s %llu ticks in 0.5s at %.0f Hz, %llu overruns\n", "Start()", (unsigned long long)timing.ticks, rateHz,
+               (unsigned long long)timing.overruns);
+        PrintTiming("tick latency", timing.latency);
+        PrintTiming("wake jitter", timing.jitter);
+        ok &= timing.ticks > 0 && !timed.Running();
+    }
+
+    if (!ok) {
+        printf("ERROR: cheat table did not keep every entry frozen\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * 컴파일된 와일드카드 시그니처 검색 벤치마크
+ *
+ * x64 코드와 비슷한 바이트 분포(흔한 opcode/REX 바이트, 0 채움)의 합성 버퍼에 시그니처를 심고 처리량(GB/s)을 측정합니다.
+ * - 기존 방식: 모든 위치에서 패턴 전체를 vector<bool> 마스크와 함께 바이트 단위로 비교
+ * - CompiledPattern 커널별 (Scalar memchr / SSE2 / AVX2)
+ * 각 커널의 결과가 위치마다 MatchesAt을 호출한 기준 결과와 같은지 검증합니다.
+ *
+ * 사용법: CompiledPatternBench [버퍼 크기(MB), 기본 1024] [반복 횟수, 기본 2]
+ */
+
+#include "../CompiledPattern.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 기존 예제들의 바이트/마스크 중첩 루프
+    void LegacyScan(const uint8_t* data, size_t size, const std::vector<uint8_t>& pattern, const std::vector<bool>& mask,
+                    std::vector<uintptr_t>& out) {
+        for (size_t i = 0; i + pattern.size() <= size; ++i) {
+            bool match = true;
+            for (size_t j = 0; j < pattern.size(); ++j) {
+                if (mask[j] && data[i + j] != pattern[j]) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) out.push_back(i);
+        }
+    }
+
+    // "48 8B ?? 89" -> 바이트 + bool 마스크 (니블 와일드카드는 표현할 수 없으므로 false)
+    bool ToLegacy(const std::string& text, std::vector<uint8_t>& pattern, std::vector<bool>& mask) {
+        pattern.clear();
+        mask.clear();
+        size_t i = 0;
+        while (i < text.size()) {
+            if (text[i] == ' ') {
+                ++i;
+                continue;
+            }
+            std::string token = text.substr(i, text.find(' ', i) - i);
+            i += token.size();
+            if (token == "?" || token == "??") {
+                pattern.push_back(0);
+                mask.push_back(false);
+            } else if (token.find('?') != std::string::npos) {
+                return false;
+            } else {
+                pattern.push_back(static_cast<uint8_t>(std::strtoul(token.c_str(), nullptr, 16)));
+                mask.push_back(true);
+            }
+        }
+        return true;
+    }
+
+    // 패턴의 고정 니블만 덮어씀 (와일드카드 자리는 주변 바이트 그대로). 토큰은 모두 두 글자
+    void Plant(uint8_t* p, const std::string& text) {
+        for (size_t i = 0; i + 1 < text.size(); i += 3, ++p) {
+            for (size_t n = 0; n < 2; ++n) {
+                if (text[i + n] == '?') continue;
+                unsigned nibble = static_cast<unsigned>(std::strtoul(std::string(1, text[i + n]).c_str(), nullptr, 16));
+                unsigned shift = n == 0 ? 4 : 0;
+                *p = static_cast<uint8_t>((*p & ~(0x0F << shift)) | (nibble << shift));
+            }
+        }
+    }
+
+    bool BenchPattern(const std::string& text, const std::vector<uint8_t>& buffer, int iterations) {
+        CompiledPattern compiled = CompiledPattern::Parse(text);
+        printf("\n\"%s\" (%zu bytes, anchors at", text.c_str(), compiled.Size());
+        for (size_t n = 0; n < compiled.AnchorCount(); ++n) printf(" +%zu", compiled.AnchorOffset(n));
+        printf(")\n");
+
+        // 기준: 모든 위치에서 MatchesAt
+        std::vector<uintptr_t> reference;
+        for (size_t i = 0; i + compiled.Size() <= buffer.size(); ++i) {
+            if (compiled.MatchesAt(buffer.data() + i)) reference.push_back(i);
+        }
+
+        std::vector<uint8_t> pattern;
+        std::vector<bool> mask;
+        if (ToLegacy(text, pattern, mask)) {
+            std::vector<uintptr_t> hits;
+            double bestSeconds = 1e30;
+            for (int it = 0; it < iterations; ++it) {
+                hits.clear();
+                auto start = std::chrono::steady_clock::now();
+                LegacyScan(buffer.data(), buffer.size(), pattern, mask, hits);
+                bestSeconds = std::min(bestSeconds, Seconds(start));
+            }
+            printf("  %-8s %8.2f GB/s  hits=%zu%s\n", "legacy", buffer.size() / 1e9 / bestSeconds, hits.size(),
+                   hits == reference ? "" : "  MISMATCH");
+        }
+
+        std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+        SimdLevel best = ActiveSimdLevel();
+        if (best == SimdLevel::SSE2 || best == SimdLevel::AVX2) levels.push_back(SimdLevel::SSE2);
+        if (best == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+        bool ok = true;
+        for (SimdLevel level : levels) {
+            std::vector<uintptr_t> hits;
+            double bestSeconds = 1e30;
+            for (int it = 0; it < iterations; ++it) {
+                hits.clear();
+                auto start = std::chrono::steady_clock::now();
+                compiled.FindAll(buffer.data(), buffer.size(), 0, hits, level);
+                bestSeconds = std::min(bestSeconds, Seconds(start));
+            }
+            bool match = hits == reference;
+            ok &= match;
+            printf("  %-8s %8.2f GB/s  hits=%zu%s\n", SimdLevelName(level), buffer.size() / 1e9 / bestSeconds, hits.size(),
+                   match ? "" : "  MISMATCH");
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1024;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 2;
+    if (megabytes == 0) megabytes = 1;
+    if (iterations <= 0) iterations = 1;
+
+    printf("CompiledPatternBench: %zu MB, %d iterations, detected %s\n", megabytes, iterations, SimdLevelName(ActiveSimdLevel()));
+
+    const std::vector<std::string> patterns = {
+        "48 8B 05 ?? ?? ?? ?? 48 85 C0",
+        "F3 0F 10 05 ?? ?? ?? ?? 0F 2F C1",
+        "?? ?? ?? 89 05 ?? ?? ?? ?? E8",
+        "40 53 48 83 EC 20 48 8B D9 E8 ?? ?? ?? ?? 48 8B 0D ?? ?? ?? ?? 48 85 C9 74 ?? 48 8B 01",
+        "4? 8B ?5 ?? ?? ?? ?? 0F 28"
+    };
+
+    // 흔한 opcode/REX 바이트 50%, 무작위 바이트 40%, 0 채움 10% (64바이트 단위) + 시그니처 심기
+    const uint8_t common[] = {0x48, 0x8B, 0x89, 0x0F, 0x01, 0x24, 0x4C, 0x44, 0x8D, 0xE8, 0x85, 0xC0, 0x83, 0xCC, 0xFF, 0x05};
+    std::mt19937_64 rng(99);
+    std::vector<uint8_t> buffer(megabytes * 1024 * 1024);
+    for (size_t i = 0; i < buffer.size(); i += 64) {
+        size_t length = std::min<size_t>(64, buffer.size() - i);
+        uint64_t kind = rng() % 10;
+        if (kind == 0) continue;    // 0 채움
+        for (size_t j = 0; j < length; j += 8) {
+            uint64_t r = rng();
+            for (size_t k = 0; k < 8 && j + k < length; ++k, r >>= 8) {
+                buffer[i + j + k] = kind <= 5 ? common[r % sizeof(common)] : static_cast<uint8_t>(r);
+            }
+        }
+    }
+    for (size_t n = 0; n < patterns.size(); ++n) {
+        for (size_t offset = 4096 * (n + 1) + n * 7; offset + 64 < buffer.size(); offset += 64 * 1024 + 13) {
+            Plant(&buffer[offset], patterns[n]);
+        }
+    }
+
+    bool ok = true;
+    for (const std::string& pattern : patterns) {
+        ok &= BenchPattern(pattern, buffer, iterations);
+    }
+
+    // 문자열 파싱과 bool 마스크 생성자가 같은 패턴을 만드는지, 잘못된 패턴은 비어 있는지
+    CompiledPattern fromMask({0x48, 0x8B, 0x05, 0x00, 0x89}, {true, true, true, false, true});
+    std::vector<uintptr_t> a, b;
+    fromMask.FindAll(buffer.data(), buffer.size(), 0, a);
+    CompiledPattern::Parse("48 8B 05 ?? 89").FindAll(buffer.data(), buffer.size(), 0, b);
+    ok &= a == b && !a.empty();
+    ok &= CompiledPattern::Parse("48 8G").Empty() && CompiledPattern::Parse("488B").Empty();
+
+    if (!ok) {
+        printf("ERROR: compiled pattern results differ from reference\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * 변경 페이지 추적 벤치마크 (다음 스캔 "변경 없음" 반복)
+ *
+ * 힙 하나(Linux는 이 프로세스 자신, 그 외는 MemoryDump)에 int 후보를 일정 간격(기본 64바이트)마다 두고,
+ * 라운드마다 페이지 일부(기본 1%)에 값을 쓴 뒤 "변경 없음" 다음 스캔을 합니다.
+ * - 결과 저장소: 추적 없이 모두 읽기 대비 DirtyPageTracker 사용 (시간, 읽은 바이트, 읽지 않은 후보)
+ * - 스냅샷: 추적 없는 스냅샷 대비 추적 스냅샷의 필터 시간과 읽지 않은 페이지
+ * 두 방식의 결과(주소, 후보 수)가 같은지 검증합니다. soft-dirty를 쓸 수 없으면 페이지 해시로 동작합니다.
+ * 끝으로 작업 단위 조각을 합친 저장소(ScanExecutor, 단위 경계가 64KB 블록 중간)로 페이지 해시 경로를 돌려
+ * 빽빽한 블록의 페이지가 모두 해시되는지, 결과가 모두 읽은 경우와 같은지 검증합니다.
+ *
+ * 사용법: DirtyPageBench [힙 크기(MB), 기본 128] [라운드마다 바꿀 페이지 비율(%), 기본 1] [후보 간격(바이트), 기본 64] [hash: 해시 강제]
+ */
+
+#include "../DirtyPageTracker.h"
+#include "../ScanExecutor.h"
+#include "../ScanKernels.h"
+#include "../SnapshotScanner.h"
+#include "../MemoryDump.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    const size_t PageSize = DirtyPageTracker::PageSize;
+    size_t CandidateStride = 64;
+    const int Rounds = 3;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 스캔 대상: 이 프로세스의 힙(Linux) 또는 같은 내용의 덤프
+    struct Target {
+        std::unique_ptr<IProcessMemory> memory;
+        MemoryDump* dump = nullptr;
+        std::vector<uint8_t> heap;      // Linux: 실제 대상 메모리
+        uintptr_t base = 0;
+        size_t size = 0;
+
+        void Write(size_t offset, int value) {
+            if (dump) {
+                dump->WriteValue(base + offset, value);
+            } else {
+                memcpy(heap.data() + offset, &value, sizeof(value));
+            }
+        }
+    };
+
+    Target MakeTarget(size_t size) {
+        Target target;
+        target.size = size;
+        std::vector<uint8_t> data(size);
+        std::mt19937_64 rng(3);
+        for (size_t i = 0; i < size; i += 8) {
+            uint64_t value = rng();
+            memcpy(&data[i], &value, sizeof(value));
+        }
+#if defined(__linux__)
+        target.heap = std::move(data);
+        target.base = reinterpret_cast<uintptr_t>(target.heap.data());
+        target.memory = std::make_unique<LinuxProcessMemory>(getpid());
+#else
+        auto dump = std::make_unique<MemoryDump>();
+        MemoryRegion region;
+        region.base = 0x10000000;
+        region.protection = MemoryRead | MemoryWrite;
+        dump->AddRegion(region, std::move(data));
+        target.base = region.base;
+        target.dump = dump.get();
+        target.memory = std::move(dump);
+#endif
+        return target;
+    }
+
+    // 페이지 percent%를 골라 후보 위치 하나씩 값을 바꿈
+    void TouchPages(Target& target, std::mt19937_64& rng, double percent) {
+        size_t pages = target.size / PageSize;
+        size_t count = static_cast<size_t>(pages * percent / 100.0);
+        for (size_t n = 0; n < count; ++n) {
+            size_t page = rng() % pages;
+            size_t slot = rng() % (PageSize / CandidateStride);
+            target.Write(page * PageSize + slot * CandidateStride, static_cast<int>(rng()));
+        }
+    }
+
+    bool SameStore(const ScanResultStore& a, const ScanResultStore& b) {
+        if (a.Count() != b.Count()) return false;
+        auto itA = a.begin();
+        auto itB = b.begin();
+        for (; itA != a.end(); ++itA, ++itB) {
+            if ((*itA).address != (*itB).address || memcmp((*itA).value, (*itB).value, sizeof(int)) != 0) return false;
+        }
+        return true;
+    }
+
+    // 덤프(16바이트마다 7, 64KB 정렬이 아닌 시작 주소)에서 7을 executor로 스캔해 합친 저장소로 페이지 해시 다음 스캔.
+    // 블록마다 후보가 해시 기준과 같은 4096개라, 단위 경계에 걸친 블록을 조각별로 세면 기준 아래로 떨어짐
+    bool CheckMergedStore() {
+        const uintptr_t base = 0x10003000;
+        const size_t size = 8 * 1024 * 1024;
+        MemoryDump dump;
+        MemoryRegion region;
+        region.base = base;
+        region.protection = MemoryRead | MemoryWrite;
+        std::vector<uint8_t> data(size, 0xAB);
+        for (size_t offset = 0; offset < size; offset += 16) {
+            int value = 7;
+            memcpy(&data[offset], &value, sizeof(value));
+        }
+        dump.AddRegion(region, std::move(data));
+        std::vector<MemoryRange> ranges = {{base, size}};
+
+        DirtyPageTracker tracker(dump, DirtyTrackingMode::PageHash);
+        tracker.Arm();
+        ScanExecutor executor;
+        executor.SetOverlap(sizeof(int) - 1);
+        std::vector<ScanResultStore> fragments = executor.RunUnits<ScanResultStore>(ranges, dump.MakeReadFunction(),
+            [](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, ScanResultStore& fragment) {
+                std::vector<uintptr_t> hits;
+                FindExact<int>(data, size, 7, unit.base, hits);
+                ScanResultStore::Builder builder(sizeof(int));
+                for (uintptr_t address : hits) {
+                    if (address >= unit.base + unit.size) break;
+                    builder.Append(address, data + (address - unit.base));
+                }
+                fragment = builder.Finish();
+            });
+        ScanResultStore::Builder merged(sizeof(int));
+        for (const ScanResultStore& fragment : fragments) merged.Append(fragment);
+        ScanResultStore results = merged.Finish();
+
+        // 해시되어야 할 페이지: 주소 목록에서 센 블록 결과 수가 기준 이상인 블록의 후보 페이지
+        const size_t MinHashHits = DirtyPageTracker::MinHashCandidates * (ScanResultStore::BlockSize / PageSize);
+        auto expectHashed = [&](const ScanResultStore& store, size_t& blocks) {
+            std::unordered_map<uintptr_t, size_t> blockHits;
+            std::vector<uintptr_t> pages;
+            for (uintptr_t address : store.ToAddresses()) {
+                ++blockHits[address & ~static_cast<uintptr_t>(ScanResultStore::BlockSize - 1)];
+                uintptr_t page = address & ~static_cast<uintptr_t>(PageSize - 1);
+                if (pages.empty() || pages.back() != page) pages.push_back(page);
+            }
+            blocks = blockHits.size();
+            size_t hashed = 0;
+            for (uintptr_t page : pages) hashed += blockHits[page & ~static_cast<uintptr_t>(ScanResultStore::BlockSize - 1)] >= MinHashHits;
+            return hashed;
+        };
+
+        BatchReader reader(dump.MakeBatchReadFunction());
+        std::mt19937_64 rng(29);
+        bool ok = true;
+        for (int round = 1; round <= 2; ++round) {
+            size_t blocks = 0;
+            size_t expectedPages = expectHashed(results, blocks);
+            ok &= results.BlockCount() == blocks;
+            for (int n = 0; n < 64; ++n) dump.WriteValue(base + rng() % (size / sizeof(int)) * sizeof(int), round);
+            ScanResultStore full = FilterResultStore<int>(results, ChangeFilter::Unchanged, reader);
+            tracker.ResetStats();
+            ScanResultStore tracked = FilterResultStore<int>(results, ChangeFilter::Unchanged, reader, &tracker);
+            size_t hashedPages = tracker.GetStats().hashedPages;
+            bool same = SameStore(full, tracked) && hashedPages == expectedPages;
+            ok &= same;
+            printf("%-6d %10zu fragments %8zu blocks %10zu/%zu pages hashed %10zu survivors%s\n", round, fragments.size(),
+                   results.BlockCount(), hashedPages, expectedPages, tracked.Count(), same ? "" : "  MISMATCH");
+            results = std::move(tracked);
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 128;
+    double percent = argc > 2 ? std::strtod(argv[2], nullptr) : 1.0;
+    size_t stride = argc > 3 ? static_cast<size_t>(std::strtoull(argv[3], nullptr, 10)) : 64;
+    bool forceHash = argc > 4 && std::string(argv[4]) == "hash";
+    if (megabytes == 0) megabytes = 1;
+    if (stride >= sizeof(int) && stride <= PageSize) CandidateStride = stride / sizeof(int) * sizeof(int);
+
+    Target target = MakeTarget(megabytes * 1024 * 1024);
+    DirtyPageTracker tracker(*target.memory, forceHash ? DirtyTrackingMode::PageHash : DirtyTrackingMode::SoftDirty);
+    printf("DirtyPageBench: %zu MB, %zu candidates, %.1f%% pages written per round, mode=%s (kernel soft-dirty %s)\n",
+           megabytes, target.size / CandidateStride, percent, DirtyTrackingModeName(tracker.Mode()),
+           DirtyPageTracker::KernelSupportsSoftDirty() ? "yes" : "no");
+
+    // 첫 스캔 대신: CandidateStride마다 후보 하나, 현재 값으로 저장 (읽기 전에 Arm)
+    std::vector<uintptr_t> addresses;
+    for (size_t offset = 0; offset < target.size; offset += CandidateStride) addresses.push_back(target.base + offset);
+    BatchReader reader(target.memory->MakeBatchReadFunction());
+    tracker.Arm();
+    ScanResultStore::Builder initial(sizeof(int));
+    reader.ForEachAddress(addresses, sizeof(int), [&](uintptr_t address, const uint8_t* current) { initial.Append(address, current); });
+    ScanResultStore results = initial.Finish();
+    addresses = std::vector<uintptr_t>();
+
+    bool ok = true;
+    std::mt19937_64 rng(17);
+    printf("\n[result store] unchanged filter\n");
+    printf("%-6s %10s %10s %9s %12s %12s %10s %10s\n", "round", "full", "tracked", "speedup", "full MB", "tracked MB", "skipped", "survivors");
+    for (int round = 1; round <= Rounds; ++round) {
+        TouchPages(target, rng, percent);
+
+        auto start = std::chrono::steady_clock::now();
+        ScanResultStore full = FilterResultStore<int>(results, ChangeFilter::Unchanged, reader);
+        double fullSeconds = Seconds(start);
+        size_t fullBytes = reader.GetLastStats().bytesRead;
+
+        start = std::chrono::steady_clock::now();
+        ScanResultStore tracked = FilterResultStore<int>(results, ChangeFilter::Unchanged, reader, &tracker);
+        double trackedSeconds = Seconds(start);
+        BatchReader::Stats stats = reader.GetLastStats();
+
+        bool same = SameStore(full, tracked);
+        ok &= same;
+        printf("%-6d %9.4fs %9.4fs %8.1fx %12.1f %12.1f %10zu %10zu%s\n", round, fullSeconds, trackedSeconds,
+               fullSeconds / trackedSeconds, fullBytes / 1048576.0, stats.bytesRead / 1048576.0, stats.skipped, tracked.Count(),
+               same ? "" : "  MISMATCH");
+        results = std::move(tracked);
+    }
+    const DirtyPageTracker::Stats& trackerStats = tracker.GetStats();
+    printf("tracker: clean %zu/%zu queried pages, unchanged %zu/%zu hashed pages\n", trackerStats.cleanPages,
+           trackerStats.queriedPages, trackerStats.unchangedPages, trackerStats.hashedPages);
+
+    // 스냅샷: 같은 영역을 추적 없이/추적하며 두 번 캡처하고 같은 변경 뒤 필터
+    results = ScanResultStore();
+    std::vector<MemoryRange> ranges = {{target.base, target.size}};
+    SnapshotScanner<int> plain, trackedSnapshot;
+    plain.Capture(ranges, target.memory->MakeReadFunction());
+    trackedSnapshot.Capture(ranges, target.memory->MakeReadFunction(), &tracker);
+
+    printf("\n[snapshot] unchanged filter (%zu pages)\n", plain.PageCount());
+    printf("%-6s %10s %10s %9s %14s %12s\n", "round", "full", "tracked", "speedup", "skipped pages", "candidates");
+    for (int round = 1; round <= Rounds; ++round) {
+        TouchPages(target, rng, percent);
+
+        auto start = std::chrono::steady_clock::now();
+        plain.Filter(ChangeFilter::Unchanged, target.memory->MakeReadFunction());
+        double fullSeconds = Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        trackedSnapshot.Filter(ChangeFilter::Unchanged, target.memory->MakeReadFunction(), &tracker);
+        double trackedSeconds = Seconds(start);
+
+        bool same = plain.CandidateCount() == trackedSnapshot.CandidateCount() &&
+                    plain.ToResultStore().Count() == trackedSnapshot.ToResultStore().Count();
+        ok &= same;
+        printf("%-6d %9.4fs %9.4fs %8.1fx %14zu %12zu%s\n", round, fullSeconds, trackedSeconds, fullSeconds / trackedSeconds,
+               trackedSnapshot.LastSkippedPages(), trackedSnapshot.CandidateCount(), same ? "" : "  MISMATCH");
+    }
+
+    printf("\n[executor-merged store] page hash, unchanged filter\n");
+    ok &= CheckMergedStore();
+
+    if (!ok) {
+        printf("ERROR: tracked results differ from full reads\n");
+        return 1;
+    }
+    return 0;
+}
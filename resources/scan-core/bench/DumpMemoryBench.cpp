@@ -0,0 +1,309 @@
+/*
+ * 덤프 파일 오프라인 스캔 벤치마크 (MemoryDump 전체 불러오기 대비 SparseDumpMemory)
+ *
+ * 게임 프로세스를 흉내 낸 합성 이미지(고정 시드)를 "이전"과 "이후"(심은 정수의 절반을 1 줄임) 두 덤프로 저장하고,
+ * 같은 스캔 코드를 두 백엔드에 돌려 결과가 같은지와 걸린 시간을 비교합니다.
+ * - first-scan:   "이전" 덤프에서 int32 정확 값 스캔 → 결과 저장소
+ * - next-scan:    결과 저장소를 "이후" 덤프에서 다시 읽어 "감소" 필터 (덤프 사이 다음 스캔)
+ * - pattern:      실행 영역에서 시그니처 검색
+ * - pointer-scan: 역방향 포인터 맵 생성 + 심은 목표까지의 경로 탐색
+ * 희소 덤프는 작업마다 캐시를 비우고 시작하며 블록 캐시 적중/풀기 수를 함께 출력합니다.
+ * 마지막으로 덤프 여러 개에 같은 첫 스캔을 ForEachDump로 스레드 1개 / 전체에서 돌립니다.
+ *
+ * 사용법: DumpMemoryBench [이미지 크기(MB), 기본 128] [덤프 수, 기본 4]
+ */
+
+#include "../ChangeFilter.h"
+#include "../CompiledPattern.h"
+#include "../DirtyPageTracker.h"
+#include "../DumpMemory.h"
+#include "../PointerScanner.h"
+#include "../ScanExecutor.h"
+#include "../ScanKernels.h"
+#include "../ScanResultStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t ModuleBase = 0x140000000;
+    const uintptr_t HeapBase = 0x200000000;
+    const size_t CodeSize = 1024 * 1024;
+    const size_t DataSize = 64 * 1024;
+    const size_t HeapRegionSize = 8 * 1024 * 1024;
+    const size_t PlantStride = 64 * 1024;
+    const int32_t PlantedInt = 1234567;
+    const char* const Signature = "48 8B 05 ?? ?? ?? ?? 48 85 C0";
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double MB(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+    struct Image {
+        MemoryDump dump;
+        std::vector<uintptr_t> intAddresses;
+        uintptr_t pointerTarget = 0;
+    };
+
+    // 코드(시그니처 64개), 모듈 .data(포인터 체인 시작), 힙 (짝수 영역은 대부분 0, 홀수 영역은 작은 정수/포인터)
+    Image MakeImage(size_t megabytes) {
+        Image image;
+        std::mt19937_64 rng(21);
+        size_t heapRegions = std::max<size_t>(2, megabytes * 1024 * 1024 / HeapRegionSize);
+        size_t heapSize = heapRegions * HeapRegionSize;
+        std::vector<std::vector<uint8_t>> heap(heapRegions, std::vector<uint8_t>(HeapRegionSize, 0));
+        for (size_t r = 1; r < heapRegions; r += 2) {
+            for (size_t i = 0; i < HeapRegionSize; i += 8) {
+                uint64_t roll = rng() % 10;
+                uint64_t value = roll < 5 ? rng() % 1000 : (roll < 7 ? HeapBase + (rng() % heapSize & ~uint64_t(7)) : 0);
+                memcpy(&heap[r][i], &value, sizeof(value));
+            }
+        }
+        auto heapAt = [&](uintptr_t address) { return &heap[(address - HeapBase) / HeapRegionSize][(address - HeapBase) % HeapRegionSize]; };
+
+        for (uintptr_t slot = HeapBase + 4096; slot + 64 <= HeapBase + heapSize; slot += PlantStride) {
+            memcpy(heapAt(slot), &PlantedInt, sizeof(PlantedInt));
+            image.intAddresses.push_back(slot);
+        }
+
+        std::vector<uint8_t> code(CodeSize);
+        for (size_t i = 0; i < code.size(); i += 8) {
+            uint64_t value = rng() % 4 ? 0x9090909090909090ull : rng();
+            memcpy(&code[i], &value, sizeof(value));
+        }
+        const uint8_t signatureBytes[] = {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0};
+        for (size_t n = 0; n < 64; ++n) memcpy(&code[(n + 1) * (CodeSize / 66)], signatureBytes, sizeof(signatureBytes));
+
+        // .data+0x100 → 힙 노드(+0x18) → 목표(+0x40)
+        std::vector<uint8_t> data(DataSize, 0);
+        image.pointerTarget = image.intAddresses[image.intAddresses.size() / 2];
+        uintptr_t node = HeapBase + 4096 + 32;
+        uint64_t pointer = node - 0x18;
+        memcpy(&data[0x100], &pointer, sizeof(pointer));
+        pointer = image.pointerTarget - 0x40;
+        memcpy(heapAt(node), &pointer, sizeof(pointer));
+
+        MemoryRegion codeRegion;
+        codeRegion.base = ModuleBase;
+        codeRegion.protection = MemoryRead | MemoryExecute;
+        codeRegion.type = MemoryRegionType::Image;
+        codeRegion.path = "C:\\Games\\game.exe";
+        image.dump.AddRegion(codeRegion, std::move(code));
+        MemoryRegion dataRegion = codeRegion;
+        dataRegion.base = ModuleBase + CodeSize;
+        dataRegion.protection = MemoryRead | MemoryWrite;
+        image.dump.AddRegion(dataRegion, std::move(data));
+        for (size_t r = 0; r < heapRegions; ++r) {
+            MemoryRegion region;
+            region.base = HeapBase + r * HeapRegionSize;
+            region.protection = MemoryRead | MemoryWrite;
+            image.dump.AddRegion(region, std::move(heap[r]));
+        }
+        return image;
+    }
+
+    ScanResultStore FirstScan(IProcessMemory& memory, ScanExecutor& executor) {
+        executor.SetOverlap(sizeof(int32_t) - 1);
+        std::vector<ScanResultStore> fragments = executor.RunUnits<ScanResultStore>(
+            memory.CollectRanges([](const MemoryRegion& region) { return region.IsReadable(); }), memory.MakeReadFunction(),
+            [](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, ScanResultStore& fragment) {
+                thread_local std::vector<uintptr_t> hits;
+                hits.clear();
+                FindExact<int32_t>(data, size, PlantedInt, unit.base, hits);
+                ScanResultStore::Builder builder(sizeof(int32_t));
+                for (uintptr_t address : hits) {
+                    if (address >= unit.base + unit.size) break;
+                    builder.Append(address, data + (address - unit.base));
+                }
+                fragment = builder.Finish();
+            });
+        ScanResultStore::Builder builder(sizeof(int32_t));
+        for (const ScanResultStore& fragment : fragments) builder.Append(fragment);
+        return builder.Finish();
+    }
+
+    struct Results {
+        std::vector<uintptr_t> first;
+        std::vector<uintptr_t> next;
+        std::vector<uintptr_t> pattern;
+        std::vector<PointerPath> paths;
+        double seconds[4] = {};
+        SparseDumpMemory::Stats cache[4];
+    };
+
+    bool SamePaths(const std::vector<PointerPath>& a, const std::vector<PointerPath>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].module != b[i].module || a[i].baseOffset != b[i].baseOffset || a[i].offsets != b[i].offsets) return false;
+        }
+        return true;
+    }
+
+    // before에서 첫 스캔, after에서 다음 스캔, before에서 시그니처/포인터 스캔
+    Results RunScans(IProcessMemory& before, IProcessMemory& after, uintptr_t target) {
+        Results results;
+        ScanExecutor executor;
+        SparseDumpMemory* sparseBefore = dynamic_cast<SparseDumpMemory*>(&before);
+        SparseDumpMemory* sparseAfter = dynamic_cast<SparseDumpMemory*>(&after);
+        auto coldStart = [&]() {
+            for (SparseDumpMemory* sparse : {sparseBefore, sparseAfter}) {
+                if (!sparse) continue;
+                sparse->DropCache();
+                sparse->ResetStats();
+            }
+        };
+        auto finish = [&](size_t step, std::chrono::steady_clock::time_point start) {
+            results.seconds[step] = Seconds(start);
+            SparseDumpMemory* sparse = step == 1 ? sparseAfter : sparseBefore;
+            if (sparse) results.cache[step] = sparse->GetStats();
+        };
+
+        coldStart();
+        auto start = std::chrono::steady_clock::now();
+        ScanResultStore store = FirstScan(before, executor);
+        results.first = store.ToAddresses();
+        finish(0, start);
+
+        coldStart();
+        start = std::chrono::steady_clock::now();
+        BatchReader reader(after.MakeBatchReadFunction());
+        results.next = FilterResultStore<int32_t>(store, ChangeFilter::Decreased, reader).ToAddresses();
+        finish(1, start);
+
+        coldStart();
+        start = std::chrono::steady_clock::now();
+        CompiledPattern pattern = CompiledPattern::Parse(Signature);
+        executor.SetOverlap(pattern.Size() - 1);
+        results.pattern = executor.Run(before.CollectRanges([](const MemoryRegion& region) { return region.IsExecutable(); }),
+            before.MakeReadFunction(), [&pattern](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+                pattern.FindAll(data, size, base, out);
+            });
+        finish(2, start);
+
+        coldStart();
+        start = std::chrono::steady_clock::now();
+        PointerMap map;
+        map.Build(before);
+        PointerScanner scanner(map, PointerScanner::ModulesFromRegions(before.EnumerateRegions()));
+        PointerScanConfig config;
+        config.maxDepth = 3;
+        config.maxOffset = 0x100;
+        results.paths = scanner.FindPaths(target, config);
+        finish(3, start);
+        return results;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 128;
+    size_t dumpCount = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 4;
+    if (megabytes == 0) megabytes = 128;
+    if (dumpCount < 2) dumpCount = 2;
+    bool ok = true;
+
+    auto start = std::chrono::steady_clock::now();
+    Image image = MakeImage(megabytes);
+    printf("DumpMemoryBench: %zu regions, %.0f MB, %zu planted ints (built in %.2fs)\n", image.dump.RegionCount(),
+           MB(image.dump.TotalSize()), image.intAddresses.size(), Seconds(start));
+
+    // 덤프 0 = 이전, 덤프 n = 심은 정수를 (n + 1)개마다 하나씩 1 줄인 이후 (n = 1이면 절반, 2면 1/3 ...)
+    auto accept = [](const MemoryRegion&) { return true; };
+    std::vector<std::string> sparsePaths;
+    std::vector<size_t> decreasedCounts;
+    for (size_t n = 0; n < dumpCount; ++n) {
+        size_t decreased = 0;
+        for (size_t i = 0; n > 0 && i < image.intAddresses.size(); i += n + 1) {
+            image.dump.WriteValue<int32_t>(image.intAddresses[i], PlantedInt - 1);
+            ++decreased;
+        }
+        sparsePaths.push_back("DumpMemoryBench." + std::to_string(n) + ".scsd");
+        decreasedCounts.push_back(decreased);
+        ok &= SparseDumpFile::Write(sparsePaths.back(), image.dump, accept);
+        if (n == 0) ok &= image.dump.Save("DumpMemoryBench.0.scmd");
+        if (n == 1) ok &= image.dump.Save("DumpMemoryBench.1.scmd");
+        for (size_t i = 0; n > 0 && i < image.intAddresses.size(); i += n + 1) image.dump.WriteValue<int32_t>(image.intAddresses[i], PlantedInt);
+    }
+
+    // 같은 작업을 두 백엔드로 (이전 = 덤프 0, 이후 = 덤프 1: 심은 정수 중 짝수 번째가 감소)
+    const char* names[4] = {"first-scan", "next-scan", "pattern", "pointer-scan"};
+    Results raw, sparse;
+    {
+        start = std::chrono::steady_clock::now();
+        std::unique_ptr<IProcessMemory> before = OpenDumpMemory("DumpMemoryBench.0.scmd");
+        std::unique_ptr<IProcessMemory> after = OpenDumpMemory("DumpMemoryBench.1.scmd");
+        double openSeconds = Seconds(start);
+        ok &= before && after;
+        if (before && after) raw = RunScans(*before, *after, image.pointerTarget);
+        printf("  %-24s open %.3fs (Load)\n", "MemoryDump (SCMD)", openSeconds);
+    }
+    {
+        start = std::chrono::steady_clock::now();
+        std::unique_ptr<IProcessMemory> before = OpenDumpMemory(sparsePaths[0]);
+        std::unique_ptr<IProcessMemory> after = OpenDumpMemory(sparsePaths[1]);
+        double openSeconds = Seconds(start);
+        ok &= before && after;
+        if (before && after) sparse = RunScans(*before, *after, image.pointerTarget);
+        printf("  %-24s open %.3fs (map + index), cache %zu blocks\n", "SparseDumpMemory (SCSD)", openSeconds,
+               DumpMemoryConfig().cacheBlocks);
+    }
+
+    bool same[4] = {raw.first == sparse.first, raw.next == sparse.next, raw.pattern == sparse.pattern, SamePaths(raw.paths, sparse.paths)};
+    size_t hits[4] = {sparse.first.size(), sparse.next.size(), sparse.pattern.size(), sparse.paths.size()};
+    for (size_t step = 0; step < 4; ++step) {
+        const SparseDumpMemory::Stats& cache = sparse.cache[step];
+        printf("  %-12s raw %8.4fs  sparse %8.4fs  hits=%-6zu cache hits=%llu decoded=%llu zero=%llu  %s\n", names[step],
+               raw.seconds[step], sparse.seconds[step], hits[step], static_cast<unsigned long long>(cache.hits),
+               static_cast<unsigned long long>(cache.misses), static_cast<unsigned long long>(cache.zeroBlocks),
+               same[step] ? "same" : "DIFFERENT");
+        ok &= same[step];
+    }
+    bool found = sparse.first == image.intAddresses && sparse.next.size() == decreasedCounts[1] && sparse.pattern.size() == 64 &&
+                 !sparse.paths.empty();
+    printf("  %-12s planted values, signatures and pointer chain %s\n", "verify", found ? "found" : "NOT FOUND");
+    ok &= found;
+
+    // 덤프 여러 개에 같은 첫 스캔 → 감소하지 않은 심은 정수 수가 맞는지
+    size_t hardware = std::max<unsigned>(1, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts = {1};
+    if (hardware > 1) threadCounts.push_back(hardware);
+    for (size_t threads : threadCounts) {
+        std::vector<size_t> counts(sparsePaths.size(), 0);
+        start = std::chrono::steady_clock::now();
+        size_t opened = ForEachDump(sparsePaths, [&](size_t index, IProcessMemory& memory) {
+            ScanExecutorConfig config;
+            config.threadCount = 1;     // 병렬은 덤프 단위로
+            ScanExecutor executor(config);
+            counts[index] = FirstScan(memory, executor).Count();
+        }, threads);
+        double seconds = Seconds(start);
+        size_t wrong = 0;
+        for (size_t n = 0; n < counts.size(); ++n) wrong += counts[n] != image.intAddresses.size() - decreasedCounts[n];
+        printf("  %-12s %zu dumps, %zu threads, %.3fs (%.0f MB/s), wrong counts=%zu\n", "ForEachDump", opened, threads, seconds,
+               MB(image.dump.TotalSize()) * opened / seconds, wrong);
+        ok &= opened == sparsePaths.size() && wrong == 0;
+    }
+
+    for (const std::string& path : sparsePaths) std::remove(path.c_str());
+    std::remove("DumpMemoryBench.0.scmd");
+    std::remove("DumpMemoryBench.1.scmd");
+
+    if (!ok) {
+        printf("ERROR: dump scans differ between backends or missed planted data\n");
+        return 1;
+    }
+    return 0;
+}
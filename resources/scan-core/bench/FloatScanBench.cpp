@@ -0,0 +1,154 @@
+/*
+ * 실수 근사값/범위/집합 스캔 벤치마크
+ *
+ * 무작위 바이트, 그럴듯한 실수 값, 비정규 수, NaN이 섞인 합성 버퍼에서 FindFloat 처리량(GB/s)을 측정합니다.
+ * - 기존 스칼라 루프 (FPSUnlocker의 abs(x - value) < tolerance, CameraScanner의 FOV 값 11개 중첩 루프)
+ * - FindFloat 커널별 (Scalar / SSE2 / AVX2)
+ * 각 SIMD 커널의 결과가 스칼라 커널과 같은지 검증합니다.
+ *
+ * 사용법: FloatScanBench [버퍼 크기(MB), 기본 256] [반복 횟수, 기본 3]
+ */
+
+#include "../FloatScanKernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template<typename T>
+    bool BenchCondition(const char* name, const FloatCondition<T>& condition, const std::vector<uint8_t>& buffer,
+                        uintptr_t baseAddress, int iterations) {
+        std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+        SimdLevel best = ActiveSimdLevel();
+        if (best == SimdLevel::SSE2 || best == SimdLevel::AVX2) levels.push_back(SimdLevel::SSE2);
+        if (best == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+        std::vector<uintptr_t> reference;
+        bool ok = true;
+        for (SimdLevel level : levels) {
+            std::vector<uintptr_t> hits;
+            double bestSeconds = 1e30;
+            for (int it = 0; it < iterations; ++it) {
+                hits.clear();
+                auto start = std::chrono::steady_clock::now();
+                FindFloat<T>(buffer.data(), buffer.size(), condition, baseAddress, hits, level);
+                bestSeconds = std::min(bestSeconds, Seconds(start));
+            }
+
+            bool match = true;
+            if (level == SimdLevel::Scalar) {
+                reference = hits;
+            } else {
+                match = hits == reference;
+                ok &= match;
+            }
+            printf("%-26s %-7s %8.2f GB/s  hits=%zu%s\n", name, SimdLevelName(level), buffer.size() / 1e9 / bestSeconds,
+                   hits.size(), match ? "" : "  MISMATCH");
+        }
+        return ok;
+    }
+
+    // 기존 예제의 스칼라 루프 (비교 기준)
+    template<typename Match>
+    void BenchLegacy(const char* name, const std::vector<uint8_t>& buffer, int iterations, Match match) {
+        std::vector<uintptr_t> hits;
+        double bestSeconds = 1e30;
+        for (int it = 0; it < iterations; ++it) {
+            hits.clear();
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i + sizeof(float) <= buffer.size(); i += sizeof(float)) {
+                float value;
+                memcpy(&value, buffer.data() + i, sizeof(float));
+                if (match(value)) hits.push_back(0x10000 + i);
+            }
+            bestSeconds = std::min(bestSeconds, Seconds(start));
+        }
+        printf("%-26s %-7s %8.2f GB/s  hits=%zu\n", name, "legacy", buffer.size() / 1e9 / bestSeconds, hits.size());
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (megabytes == 0) megabytes = 1;
+    if (iterations <= 0) iterations = 1;
+
+    printf("FloatScanBench: %zu MB, %d iterations, detected %s\n", megabytes, iterations, SimdLevelName(ActiveSimdLevel()));
+
+    // 무작위 바이트와 그럴듯한 실수 [0, 200)가 반씩, 목표값(FOV, 60 근처, 1/3 double)/비정규 수/NaN은 드물게
+    std::mt19937_64 rng(2024);
+    std::vector<uint8_t> buffer(megabytes * 1024 * 1024);
+    std::uniform_real_distribution<float> plausible(0.0f, 200.0f);
+    const float fovDegrees[] = {60, 70, 75, 80, 85, 90, 95, 100, 105, 110, 120};
+    for (size_t i = 0; i + 8 <= buffer.size(); i += 8) {
+        uint64_t r = rng();
+        if (r % 512 == 0) {
+            switch ((r >> 9) % 4) {
+                case 0: {
+                    float pair[2] = {fovDegrees[(r >> 12) % 11] * 3.14159265f / 180.0f, 60.0f + (r >> 40) % 3 * 0.0005f};
+                    memcpy(&buffer[i], pair, 8);
+                    break;
+                }
+                case 1: {
+                    double value = 1.0 / 3.0 + ((r >> 20) % 3) * 1e-10;
+                    memcpy(&buffer[i], &value, 8);
+                    break;
+                }
+                default: {
+                    float pair[2] = {std::numeric_limits<float>::denorm_min() * static_cast<float>(r >> 40), std::nanf("")};
+                    memcpy(&buffer[i], pair, 8);
+                    break;
+                }
+            }
+        } else if (r & 1) {
+            memcpy(&buffer[i], &r, 8);
+        } else {
+            float pair[2] = {plausible(rng), plausible(rng)};
+            memcpy(&buffer[i], pair, 8);
+        }
+    }
+
+    std::vector<float> fovRadians;
+    for (float degrees : fovDegrees) fovRadians.push_back(degrees * 3.14159265f / 180.0f);
+
+    bool ok = true;
+    const uintptr_t base = 0x10000;
+
+    BenchLegacy("near 60 (+-0.001)", buffer, iterations, [](float x) { return std::abs(x - 60.0f) < 0.001f; });
+    ok &= BenchCondition("near 60 (+-0.001)", FloatCondition<float>::Near(60.0f, 0.001f), buffer, base, iterations);
+
+    BenchLegacy("any of 11 FOVs (+-0.01)", buffer, iterations, [&](float x) {
+        for (float fov : fovRadians) {
+            if (std::abs(x - fov) < 0.01f) return true;
+        }
+        return false;
+    });
+    ok &= BenchCondition("any of 11 FOVs (+-0.01)", FloatCondition<float>::AnyOf(fovRadians.begin(), fovRadians.end(), 0.01f),
+                         buffer, base, iterations);
+
+    ok &= BenchCondition("range [0.5, 2] stride 1", FloatCondition<float>::Between(0.5f, 2.0f).WithStride(1), buffer, base, iterations);
+    ok &= BenchCondition("range stride 2 (odd base)", FloatCondition<float>::Between(0.5f, 2.0f).WithStride(2), buffer, base + 3, iterations);
+    ok &= BenchCondition("range stride 16", FloatCondition<float>::Between(0.5f, 2.0f).WithStride(16), buffer, base, iterations);
+    ok &= BenchCondition("range +denormal", FloatCondition<float>::Between(0.0f, 1e-37f).AllowDenormal(), buffer, base, iterations);
+    ok &= BenchCondition("range -denormal", FloatCondition<float>::Between(0.0f, 1e-37f), buffer, base, iterations);
+    ok &= BenchCondition("double near 1/3 (+-1e-9)", FloatCondition<double>::Near(1.0 / 3.0, 1e-9), buffer, base, iterations);
+    ok &= BenchCondition("double range stride 4", FloatCondition<double>::Between(0.25, 0.5).WithStride(4), buffer, base, iterations);
+
+    if (!ok) {
+        printf("ERROR: SIMD results differ from scalar reference\n");
+        return 1;
+    }
+    return 0;
+}
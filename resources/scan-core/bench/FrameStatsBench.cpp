@@ -0,0 +1,147 @@
+/*
+ * 프레임 시간 통계 마이크로 벤치마크 (vector erase + 전체 재계산 대비 FrameStats)
+ *
+ * 60FPS 근처의 합성 프레임 시간 열(고정 시드, 가끔 끊김과 로딩 구간)을 창 크기 120 / 1000 / 10000으로 넣습니다.
+ * - 기존 방식: FPSUtils::FPSMonitor / EffectProfiler처럼 vector에 넣고 넘치면 erase(begin()),
+ *   평균/최소/최대 FPS를 조회할 때마다 전체를 훑고, 백분위는 복사 + nth_element
+ * - FrameStats: Add 한 번 + 평균/최소/최대(O(1)) + p99 / 1% low / 0.1% low(O(log B))
+ * 프레임마다 기록 + 전체 조회에 걸린 시간을 비교하고, 정확한 값(창 전체 재계산)과 비교해 평균/최소/최대는 같고
+ * 백분위는 상대 오차 안인지 검증합니다.
+ *
+ * 사용법: FrameStatsBench [프레임 수, 기본 200000]
+ */
+
+#include "../FrameStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::vector<double> MakeFrames(size_t count) {
+        std::mt19937_64 rng(25);
+        std::normal_distribution<double> jitter(16.7, 0.8);
+        std::uniform_real_distribution<double> stutter(30.0, 90.0);
+        std::vector<double> frames(count);
+        for (size_t i = 0; i < count; ++i) {
+            double frame = std::max(1.0, jitter(rng));
+            if (rng() % 200 == 0) frame = stutter(rng);         // 끊김
+            if (i % 50000 < 600) frame = 33.3 + (rng() % 100) * 0.1;  // 로딩 구간 (30FPS 근처)
+            frames[i] = frame;
+        }
+        return frames;
+    }
+
+    // 창 안 값의 nearest-rank 분위수 (FrameStats::Percentile과 같은 정의)
+    double ExactPercentile(std::vector<double> window, double q) {
+        size_t rank = static_cast<size_t>(std::max<double>(1.0, std::ceil(q * window.size())));
+        std::nth_element(window.begin(), window.begin() + (rank - 1), window.end());
+        return window[rank - 1];
+    }
+
+    // 기존 FPSMonitor 방식 (초 대신 ms)
+    struct VectorMonitor {
+        std::vector<float> frameTimes;
+        size_t maxSamples;
+
+        explicit VectorMonitor(size_t maxSamples) : maxSamples(maxSamples) { frameTimes.reserve(maxSamples + 1); }
+
+        void Record(float frameTime) {
+            frameTimes.push_back(frameTime);
+            if (frameTimes.size() > maxSamples) frameTimes.erase(frameTimes.begin());
+        }
+
+        float Average() const {
+            float total = 0.0f;
+            for (float time : frameTimes) total += time;
+            return frameTimes.size() * 1000.0f / total;
+        }
+
+        float Min() const { return 1000.0f / *std::max_element(frameTimes.begin(), frameTimes.end()); }
+        float Max() const { return 1000.0f / *std::min_element(frameTimes.begin(), frameTimes.end()); }
+
+        float Low(double fraction) const {
+            std::vector<double> copy(frameTimes.begin(), frameTimes.end());
+            return static_cast<float>(1000.0 / ExactPercentile(copy, 1.0 - fraction));
+        }
+    };
+
+    bool Run(const std::vector<double>& frames, size_t window) {
+        volatile double sink = 0.0;     // 조회가 최적화로 사라지지 않도록
+
+        // 기존 방식: 평균/최소/최대는 매 프레임, 백분위(복사 + nth_element)는 창 크기에 비례해 너무 느리므로 60프레임마다
+        VectorMonitor vectorMonitor(window);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames.size(); ++i) {
+            vectorMonitor.Record(static_cast<float>(frames[i]));
+            sink = sink + vectorMonitor.Average() + vectorMonitor.Min() + vectorMonitor.Max();
+            if (i % 60 == 0) sink = sink + vectorMonitor.Low(0.01) + vectorMonitor.Low(0.001);
+        }
+        double vectorSeconds = Seconds(start);
+
+        FrameStats stats(window);
+        start = std::chrono::steady_clock::now();
+        for (double frame : frames) {
+            stats.Add(frame);
+            sink = sink + stats.AverageFPS() + stats.MinimumFPS() + stats.MaximumFPS() + stats.LowFPS(0.01) + stats.LowFPS(0.001) +
+                   stats.Percentile(0.99);
+        }
+        double statsSeconds = Seconds(start);
+
+        // 정확도: 창 전체 재계산과 비교
+        FrameStats checked(window);
+        const double tolerance = FrameStatsConfig().relativeAccuracy * 1.01 + 1e-12;
+        size_t wrong = 0, checks = 0;
+        double worstError = 0.0;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            checked.Add(frames[i]);
+            if (i % 997 != 0 && i + 1 != frames.size()) continue;
+            size_t begin = i + 1 > window ? i + 1 - window : 0;
+            std::vector<double> current(frames.begin() + begin, frames.begin() + i + 1);
+            double sum = 0.0;
+            for (double frame : current) sum += frame;
+            double mean = sum / current.size();
+            double minimum = *std::min_element(current.begin(), current.end());
+            double maximum = *std::max_element(current.begin(), current.end());
+            ++checks;
+            wrong += checked.Minimum() != minimum || checked.Maximum() != maximum || std::fabs(checked.Mean() - mean) > 1e-9 * mean;
+            for (double q : {0.5, 0.99, 0.999}) {
+                double exact = ExactPercentile(current, q);
+                double error = std::fabs(checked.Percentile(q) - exact) / exact;
+                worstError = std::max(worstError, error);
+                wrong += error > tolerance;
+            }
+        }
+
+        printf("  window %5zu: vector %8.0f ns/frame  FrameStats %4.0f ns/frame (%6.1fx)  percentile error max %.3f%%  wrong=%zu/%zu\n",
+               window, vectorSeconds / frames.size() * 1e9, statsSeconds / frames.size() * 1e9, vectorSeconds / statsSeconds,
+               worstError * 100.0, wrong, checks);
+        printf("  %12s avg %.1f FPS, min %.1f, max %.1f, 1%% low %.1f, 0.1%% low %.1f, p99 %.2f ms\n", "", stats.AverageFPS(),
+               stats.MinimumFPS(), stats.MaximumFPS(), stats.LowFPS(0.01), stats.LowFPS(0.001), stats.Percentile(0.99));
+        return wrong == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t frameCount = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 200000;
+    std::vector<double> frames = MakeFrames(frameCount);
+    printf("FrameStatsBench: %zu frames (every frame: record + avg/min/max FPS + 1%%/0.1%% low + p99)\n", frames.size());
+    bool ok = true;
+    for (size_t window : {120, 1000, 10000}) ok &= Run(frames, window);
+    if (!ok) {
+        printf("ERROR: rolling frame statistics differ from the exact values\n");
+        return 1;
+    }
+    return 0;
+}
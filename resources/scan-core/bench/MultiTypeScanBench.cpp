@@ -0,0 +1,279 @@
+/*
+ * 모든 타입 값 스캔 벤치마크 (타입별 5번 스캔 대비 한 번)
+ *
+ * 무작위 바이트로 채운 MemoryDump에 같은 값을 int16/int32/int64/float/double로 (정렬/비정렬 위치에) 심고,
+ * - 타입별 스캔: ScanExecutor로 FindExact<int16/32/64>와 FindFloat<float/double>(Near, stride 1)을 5번
+ * - 모든 타입 스캔: ScanAllTypes 한 번
+ * 의 시간과 읽은 바이트를 비교하고, 타입별 결과가 같은지 검증합니다.
+ * 작업 단위 조각을 합친 저장소의 블록이 64KB 블록마다 하나이고 블록별 결과 수가 맞는지도 검증합니다.
+ * 커널별(Scalar / SSE2 / AVX2) FindAllTypes 결과가 같은지, 심은 값을 줄인 뒤 FilterTypedResultStore(감소)가
+ * 타입별 FilterResultStore<T> 5번과 같은 후보를 남기는지도 확인합니다.
+ *
+ * 사용법: MultiTypeScanBench [버퍼 크기(MB), 기본 256] [값, 기본 1000] [실수 허용 오차, 기본 0]
+ */
+
+#include "../MultiTypeScan.h"
+#include "../MemoryDump.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    // 페이지 정렬이지만 64KB 정렬은 아님 → 1MB 작업 단위 경계가 블록 중간에 걸림
+    const uintptr_t Base = 0x10003000;
+    const size_t PlantedPerType = 200;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Planted {
+        uintptr_t address;
+        ValueType type;
+    };
+
+    // 심을 위치: 서로 겹치지 않도록 버퍼를 칸으로 나누고 칸 안에서 무작위 (절반은 정렬된 위치)
+    template<typename T>
+    void Plant(std::vector<uint8_t>& data, std::mt19937_64& rng, ValueType type, T value, size_t slotSize, std::vector<Planted>& planted) {
+        for (size_t n = 0; n < PlantedPerType; ++n) {
+            size_t offset = planted.size() * slotSize + rng() % (slotSize - sizeof(T));
+            if (n % 2 == 0) offset &= ~(sizeof(T) - 1);
+            memcpy(&data[offset], &value, sizeof(T));
+            planted.push_back({Base + offset, type});
+        }
+    }
+
+    // 타입 하나를 executor로 스캔해 저장소로 (memory-scanner의 ScanMemory/ScanFloat와 같은 방식)
+    template<typename Find>
+    ScanResultStore ScanOneType(ScanExecutor& executor, const std::vector<MemoryRange>& ranges, const ScanExecutor::ReadFunction& read,
+                                size_t valueSize, Find find) {
+        executor.SetOverlap(valueSize - 1);
+        std::vector<ScanResultStore> fragments = executor.RunUnits<ScanResultStore>(ranges, read,
+            [&](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, ScanResultStore& fragment) {
+                thread_local std::vector<uintptr_t> hits;
+                hits.clear();
+                find(data, size, unit.base, hits);
+                ScanResultStore::Builder builder(valueSize);
+                for (uintptr_t address : hits) {
+                    if (address >= unit.base + unit.size) break;
+                    builder.Append(address, data + (address - unit.base));
+                }
+                fragment = builder.Finish();
+            });
+        ScanResultStore::Builder builder(valueSize);
+        for (const ScanResultStore& fragment : fragments) builder.Append(fragment);
+        return builder.Finish();
+    }
+
+    bool SameStore(const ScanResultStore& a, const ScanResultStore& b) {
+        if (a.Count() != b.Count() || a.ValueSize() != b.ValueSize()) return false;
+        auto itA = a.begin();
+        auto itB = b.begin();
+        for (; itA != a.end(); ++itA, ++itB) {
+            if ((*itA).address != (*itB).address || memcmp((*itA).value, (*itB).value, a.ValueSize()) != 0) return false;
+        }
+        return true;
+    }
+
+    // 블록 시작 주소가 64KB 블록마다 하나씩이고, 블록별 결과 수가 주소 목록에서 센 값과 같은지
+    bool ValidBlocks(const ScanResultStore& store) {
+        std::vector<uintptr_t> addresses = store.ToAddresses();
+        size_t blocks = 0;
+        for (size_t first = 0; first < addresses.size();) {
+            uintptr_t base = addresses[first] & ~static_cast<uintptr_t>(ScanResultStore::BlockSize - 1);
+            size_t last = first;
+            while (last < addresses.size() && (addresses[last] & ~static_cast<uintptr_t>(ScanResultStore::BlockSize - 1)) == base) ++last;
+            if (store.BlockHitCount(base) != last - first) return false;
+            ++blocks;
+            first = last;
+        }
+        return store.BlockCount() == blocks;
+    }
+
+    TypedResultStore ScanEachType(ScanExecutor& executor, const std::vector<MemoryRange>& ranges, const ScanExecutor::ReadFunction& read,
+                                  const MultiTypeQuery& query) {
+        ValueTypeMask active = query.ActiveTypes();
+        TypedResultStore result;
+        auto exact = [&](ValueType type, auto value) {
+            using T = decltype(value);
+            if (!(active & ValueTypeBit(type))) return;
+            result.SetStore(type, ScanOneType(executor, ranges, read, sizeof(T),
+                [value](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+                    FindExact<T>(data, size, value, base, out);
+                }));
+        };
+        exact(ValueType::Int16, static_cast<int16_t>(query.integer));
+        exact(ValueType::Int32, static_cast<int32_t>(query.integer));
+        exact(ValueType::Int64, static_cast<int64_t>(query.integer));
+
+        auto near = [&](ValueType type, auto value) {
+            using T = decltype(value);
+            if (!(active & ValueTypeBit(type))) return;
+            FloatCondition<T> condition = FloatCondition<T>::Near(value, static_cast<T>(query.tolerance)).WithStride(1);
+            result.SetStore(type, ScanOneType(executor, ranges, read, sizeof(T),
+                [condition](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+                    FindFloat<T>(data, size, condition, base, out);
+                }));
+        };
+        near(ValueType::Float, static_cast<float>(query.real));
+        near(ValueType::Double, query.real);
+        return result;
+    }
+
+    template<typename T>
+    void FilterOneType(TypedResultStore& result, const TypedResultStore& store, ValueType type, BatchReader& reader) {
+        result.SetStore(type, FilterResultStore<T>(store.Store(type), ChangeFilter::Decreased, reader));
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    std::string valueText = argc > 2 ? argv[2] : "1000";
+    double tolerance = argc > 3 ? std::strtod(argv[3], nullptr) : 0.0;
+    if (megabytes == 0) megabytes = 1;
+
+    MultiTypeQuery query;
+    if (!ParseMultiTypeQuery(valueText, tolerance, query)) {
+        printf("invalid value: %s\n", valueText.c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> data(megabytes * 1024 * 1024);
+    std::mt19937_64 rng(5);
+    for (size_t i = 0; i + 8 <= data.size(); i += 8) {
+        uint64_t value = rng();
+        memcpy(&data[i], &value, sizeof(value));
+    }
+    std::vector<Planted> planted;
+    ValueTypeMask active = query.ActiveTypes();
+    size_t slotSize = data.size() / (ValueTypeCount * PlantedPerType);
+    if (slotSize < 16) {
+        printf("buffer too small\n");
+        return 1;
+    }
+    if (active & ValueTypeBit(ValueType::Int16)) Plant(data, rng, ValueType::Int16, static_cast<int16_t>(query.integer), slotSize, planted);
+    if (active & ValueTypeBit(ValueType::Int32)) Plant(data, rng, ValueType::Int32, static_cast<int32_t>(query.integer), slotSize, planted);
+    if (active & ValueTypeBit(ValueType::Int64)) Plant(data, rng, ValueType::Int64, static_cast<int64_t>(query.integer), slotSize, planted);
+    if (active & ValueTypeBit(ValueType::Float)) Plant(data, rng, ValueType::Float, static_cast<float>(query.real), slotSize, planted);
+    if (active & ValueTypeBit(ValueType::Double)) Plant(data, rng, ValueType::Double, query.real, slotSize, planted);
+
+    // 커널별 결과 비교 (앞 16MB)
+    bool ok = true;
+    {
+        size_t size = std::min<size_t>(data.size(), 16 * 1024 * 1024);
+        TypedHits reference;
+        FindAllTypes(data.data(), size, query, Base, reference, SimdLevel::Scalar);
+        std::vector<SimdLevel> levels;
+        SimdLevel best = ActiveSimdLevel();
+        if (best == SimdLevel::SSE2 || best == SimdLevel::AVX2) levels.push_back(SimdLevel::SSE2);
+        if (best == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+        for (SimdLevel level : levels) {
+            TypedHits hits;
+            FindAllTypes(data.data(), size, query, Base, hits, level);
+            for (size_t t = 0; t < ValueTypeCount; ++t) {
+                if (hits.byType[t] != reference.byType[t]) {
+                    printf("kernel %s: %s MISMATCH (%zu vs %zu)\n", SimdLevelName(level), ValueTypeName(static_cast<ValueType>(t)),
+                           hits.byType[t].size(), reference.byType[t].size());
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    MemoryDump dump;
+    MemoryRegion region;
+    region.base = Base;
+    region.protection = MemoryRead | MemoryWrite;
+    dump.AddRegion(region, data);
+    data = std::vector<uint8_t>();
+    std::vector<MemoryRange> ranges = {{Base, megabytes * 1024 * 1024}};
+    ScanExecutor executor;
+
+    printf("MultiTypeScanBench: %zu MB, value %s (tolerance %g), kernel %s, %zu planted\n", megabytes, valueText.c_str(), tolerance,
+           SimdLevelName(ActiveSimdLevel()), planted.size());
+
+    auto start = std::chrono::steady_clock::now();
+    TypedResultStore separate = ScanEachType(executor, ranges, dump.MakeReadFunction(), query);
+    double separateSeconds = Seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    TypedResultStore combined = ScanAllTypes(executor, ranges, dump.MakeReadFunction(), query);
+    double combinedSeconds = Seconds(start);
+    size_t combinedBytes = executor.GetLastStats().bytesScanned;
+
+    size_t passes = 0;
+    for (size_t t = 0; t < ValueTypeCount; ++t) passes += (active & ValueTypeBit(static_cast<ValueType>(t))) != 0;
+    printf("%-18s %9.3f s %10.1f MB read\n", "per-type passes", separateSeconds, passes * combinedBytes / 1048576.0);
+    printf("%-18s %9.3f s %10.1f MB read  (%.1fx)\n", "all types at once", combinedSeconds, combinedBytes / 1048576.0,
+           separateSeconds / combinedSeconds);
+
+    for (size_t t = 0; t < ValueTypeCount; ++t) {
+        ValueType type = static_cast<ValueType>(t);
+        if (!(active & ValueTypeBit(type))) continue;
+        bool same = SameStore(separate.Store(type), combined.Store(type));
+        bool blocks = ValidBlocks(combined.Store(type)) && ValidBlocks(separate.Store(type));
+        ok &= same && blocks;
+        printf("  %-7s %10zu hits %8zu blocks%s%s\n", ValueTypeName(type), combined.Count(type), combined.Store(type).BlockCount(),
+               same ? "" : "  MISMATCH", blocks ? "" : "  BAD BLOCKS");
+    }
+    std::vector<uintptr_t> addresses[ValueTypeCount];
+    for (size_t t = 0; t < ValueTypeCount; ++t) addresses[t] = combined.Store(static_cast<ValueType>(t)).ToAddresses();
+    size_t missing = 0;
+    for (const Planted& plant : planted) {
+        const std::vector<uintptr_t>& found = addresses[static_cast<size_t>(plant.type)];
+        missing += !std::binary_search(found.begin(), found.end(), plant.address);
+    }
+    ok &= missing == 0;
+    printf("  planted values missing: %zu\n", missing);
+
+    // 다음 스캔: 심은 값의 절반을 자기 타입 기준으로 1 줄이고 "감소"로 필터
+    for (size_t n = 0; n < planted.size(); n += 2) {
+        uintptr_t address = planted[n].address;
+        switch (planted[n].type) {
+            case ValueType::Int16: dump.WriteValue(address, static_cast<int16_t>(query.integer - 1)); break;
+            case ValueType::Int32: dump.WriteValue(address, static_cast<int32_t>(query.integer - 1)); break;
+            case ValueType::Int64: dump.WriteValue(address, static_cast<int64_t>(query.integer - 1)); break;
+            case ValueType::Float: dump.WriteValue(address, static_cast<float>(query.real) - 1.0f); break;
+            default: dump.WriteValue(address, query.real - 1.0); break;
+        }
+    }
+
+    BatchReader reader(dump.MakeBatchReadFunction());
+    start = std::chrono::steady_clock::now();
+    TypedResultStore filteredSeparate;
+    FilterOneType<int8_t>(filteredSeparate, combined, ValueType::Int8, reader);
+    FilterOneType<int16_t>(filteredSeparate, combined, ValueType::Int16, reader);
+    FilterOneType<int32_t>(filteredSeparate, combined, ValueType::Int32, reader);
+    FilterOneType<int64_t>(filteredSeparate, combined, ValueType::Int64, reader);
+    FilterOneType<float>(filteredSeparate, combined, ValueType::Float, reader);
+    FilterOneType<double>(filteredSeparate, combined, ValueType::Double, reader);
+    double separateFilterSeconds = Seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    TypedResultStore filtered = FilterTypedResultStore(combined, ChangeFilter::Decreased, reader);
+    double filterSeconds = Seconds(start);
+
+    bool sameFilter = true;
+    for (size_t t = 0; t < ValueTypeCount; ++t) {
+        ValueType type = static_cast<ValueType>(t);
+        sameFilter &= SameStore(filteredSeparate.Store(type), filtered.Store(type));
+    }
+    ok &= sameFilter;
+    printf("\n[next scan: decreased] %zu -> %zu candidates, per-type %.4f s, merged %.4f s, %zu runs%s\n", combined.Count(),
+           filtered.Count(), separateFilterSeconds, filterSeconds, reader.GetLastStats().runs, sameFilter ? "" : "  MISMATCH");
+
+    if (!ok) {
+        printf("ERROR: combined scan differs from per-type scans\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * 포인터 맵 파일 / 세션 간 경로 교차 벤치마크
+ *
+ * 게임을 세 번 다시 시작한 상황을 합성합니다. 세션마다 모듈/힙 기준 주소(ASLR)와 힙 배치가 다르지만
+ * 같은 모듈 기준 체인(깊이 1~4)이 목표까지 이어집니다. 무작위 힙 포인터가 세션마다 다른 거짓 경로를 만듭니다.
+ * - 맵 파일 쓰기: 시간, 파일 크기, 항목당 바이트 (메모리 맵 8바이트 대비)
+ * - 매핑한 파일 조회가 메모리 맵 조회와 같은지 검증
+ * - 경로 목록 3개 × 맵 3개 교차, 목록 없이 첫 맵에서 생성해 교차: 후보 수, 남은 수, paths/s
+ * 교차 결과에 심은 체인이 모두 남는지 확인합니다.
+ *
+ * 사용법: PointerMapFileBench [힙 크기(MB), 기본 128] [출력 디렉터리, 기본 .]
+ */
+
+#include "../PointerMapFile.h"
+#include "../MemoryDump.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const size_t HeapRegionSize = 16 * 1024 * 1024;
+    const size_t ModuleSize = 64 * 1024;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Chain {
+        uintptr_t baseOffset;
+        std::vector<uintptr_t> offsets;
+    };
+
+    struct Session {
+        MemoryDump dump;
+        uintptr_t moduleBase;
+        uintptr_t target;
+    };
+
+    // 같은 체인(모듈 기준 오프셋)을 다른 기준 주소/힙 배치로 심은 세션
+    Session MakeSession(uint64_t seed, size_t heapSize, const std::vector<Chain>& chains) {
+        std::mt19937_64 rng(seed);
+        Session session;
+        session.moduleBase = 0x140000000 + (rng() % 256) * 0x10000;
+        const uintptr_t heapBase = 0x200000000 + (rng() % 256) * 0x1000000;
+        session.target = heapBase + (rng() % (heapSize - 0x1000) & ~uint64_t(7));
+
+        std::vector<uint8_t> heap(heapSize), module(ModuleSize);
+        auto fill = [&](std::vector<uint8_t>& data, size_t percent) {
+            for (size_t i = 0; i < data.size(); i += 8) {
+                uint64_t random = rng();
+                uint64_t value = random % 100 < percent ? heapBase + ((random >> 8) % heapSize & ~uint64_t(7)) : (random >> 40);
+                memcpy(&data[i], &value, sizeof(value));
+            }
+        };
+        fill(heap, 5);
+        fill(module, 20);
+
+        auto store = [&](uintptr_t address, uint64_t value) {
+            if (address >= heapBase) {
+                memcpy(&heap[address - heapBase], &value, sizeof(value));
+            } else {
+                memcpy(&module[address - session.moduleBase], &value, sizeof(value));
+            }
+        };
+        for (const Chain& chain : chains) {
+            uintptr_t previous = session.moduleBase + chain.baseOffset;
+            for (size_t level = 0; level < chain.offsets.size(); ++level) {
+                uintptr_t node = level + 1 == chain.offsets.size() ? session.target
+                                                                    : heapBase + (rng() % (heapSize - 0x1000) & ~uint64_t(7));
+                store(previous, node - chain.offsets[level]);
+                previous = node;
+            }
+        }
+
+        MemoryRegion moduleRegion;
+        moduleRegion.base = session.moduleBase;
+        moduleRegion.protection = MemoryRead | MemoryWrite;
+        moduleRegion.type = MemoryRegionType::Image;
+        moduleRegion.path = "/games/game.exe";
+        session.dump.AddRegion(moduleRegion, std::move(module));
+        for (size_t offset = 0; offset < heapSize; offset += HeapRegionSize) {
+            MemoryRegion region;
+            region.base = heapBase + offset;
+            region.protection = MemoryRead | MemoryWrite;
+            session.dump.AddRegion(region, std::vector<uint8_t>(heap.begin() + offset, heap.begin() + offset + HeapRegionSize));
+        }
+        return session;
+    }
+
+    bool HasChain(const std::string& listPath, const Chain& chain) {
+        PointerPathListReader reader(listPath);
+        std::string line;
+        PointerPath path;
+        while (reader.Next(line)) {
+            if (ParsePointerPath(line, path) && path.baseOffset == chain.baseOffset && path.offsets == chain.offsets) return true;
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t heapMegabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 128;
+    std::string directory = argc > 2 ? argv[2] : ".";
+    if (heapMegabytes < 16) heapMegabytes = 16;
+    size_t heapSize = heapMegabytes / 16 * HeapRegionSize;
+
+    printf("PointerMapFileBench: 3 sessions, heap %zu MB each\n", heapSize >> 20);
+
+    std::mt19937_64 rng(5);
+    std::vector<Chain> chains;
+    for (size_t depth = 1; depth <= 4; ++depth) {
+        Chain chain{0x2000 + depth * 0x80, {}};
+        for (size_t level = 0; level < depth; ++level) chain.offsets.push_back((rng() % 0x80) * 8);
+        chains.push_back(chain);
+    }
+
+    PointerScanConfig config;
+    config.maxDepth = 4;
+    config.maxOffset = 0x400;
+
+    bool ok = true;
+    std::vector<std::string> mapFiles, listFiles;
+    for (uint64_t s = 0; s < 3; ++s) {
+        Session session = MakeSession(100 + s, heapSize, chains);
+        PointerMap map;
+        map.Build(session.dump);
+        std::vector<PointerModule> modules = PointerScanner::ModulesFromRegions(session.dump.EnumerateRegions());
+
+        std::string mapFile = directory + "/session" + std::to_string(s + 1) + ".scpm";
+        std::string listFile = directory + "/session" + std::to_string(s + 1) + ".txt";
+        auto start = std::chrono::steady_clock::now();
+        ok &= PointerMapFile::Write(mapFile, map, modules, session.target);
+        double writeSeconds = Seconds(start);
+
+        PointerScanner scanner(map, modules);
+        std::vector<PointerPath> paths = scanner.FindPaths(session.target, config);
+        ok &= WritePointerPathList(listFile, paths);
+
+        // 매핑한 파일 조회 = 메모리 맵 조회 (무작위 구간)
+        MappedPointerMap mapped;
+        ok &= mapped.Open(mapFile);
+        size_t compared = 0, mismatched = 0;
+        for (int q = 0; q < 2000; ++q) {
+            uintptr_t low = session.target - heapSize / 2 + rng() % heapSize;
+            uintptr_t high = low + rng() % 0x2000;
+            std::vector<std::pair<uintptr_t, uintptr_t>> a, b;
+            map.ForEachPointerTo(low, high, [&](uintptr_t v, uintptr_t l) { a.emplace_back(v, l); return true; });
+            mapped.ForEachPointerTo(low, high, [&](uintptr_t v, uintptr_t l) { b.emplace_back(v, l); return true; });
+            compared += a.size();
+            mismatched += a != b;
+        }
+        ok &= mismatched == 0 && mapped.EntryCount() == map.EntryCount();
+
+        printf("session %llu: entries=%zu  memory %.1f MB  file %.1f MB (%.2f B/entry)  write %.3f s  paths=%zu  lookups %zu%s\n",
+               static_cast<unsigned long long>(s + 1), map.EntryCount(), map.MemoryBytes() / 1048576.0, mapped.FileSize() / 1048576.0,
+               static_cast<double>(mapped.FileSize()) / map.EntryCount(), writeSeconds, paths.size(), compared,
+               mismatched ? "  MISMATCH" : "");
+        mapFiles.push_back(mapFile);
+        listFiles.push_back(listFile);
+    }
+
+    PointerPathIntersector intersector;
+    for (const std::string& file : mapFiles) ok &= intersector.AddMap(file);
+
+    std::string stableList = directory + "/stable.txt";
+    intersector.Intersect(listFiles, stableList);
+    const PointerPathIntersector::Stats& listed = intersector.GetLastStats();
+    printf("intersect 3 lists x 3 maps: candidates=%zu kept=%zu  %.3f s (%.0f paths/s)\n", listed.candidates, listed.kept,
+           listed.seconds, listed.PathsPerSecond());
+    for (const Chain& chain : chains) {
+        bool found = HasChain(stableList, chain);
+        printf("  depth %zu chain %s\n", chain.offsets.size(), found ? "kept" : "MISSING");
+        ok &= found;
+    }
+
+    std::string generatedList = directory + "/stable_generated.txt";
+    intersector.Intersect({}, generatedList, config);
+    const PointerPathIntersector::Stats& generated = intersector.GetLastStats();
+    printf("generate from map 1 x 3 maps:  candidates=%zu kept=%zu  %.3f s (%.0f paths/s)\n", generated.candidates, generated.kept,
+           generated.seconds, generated.PathsPerSecond());
+    for (const Chain& chain : chains) ok &= HasChain(generatedList, chain);
+
+    for (const std::string& file : mapFiles) std::remove(file.c_str());
+    for (const std::string& file : listFiles) std::remove(file.c_str());
+    std::remove(stableList.c_str());
+    std::remove(generatedList.c_str());
+
+    if (!ok) {
+        printf("ERROR: pointer map file results are wrong\n");
+        return 1;
+    }
+    return 0;
+}
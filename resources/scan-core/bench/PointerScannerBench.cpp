@@ -0,0 +1,148 @@
+/*
+ * 역방향 포인터 맵 / 포인터 경로 생성 벤치마크
+ *
+ * 합성 MemoryDump (모듈 .data 64KB + 힙 영역들)를 만들고 목표 주소까지 깊이 1~4의 체인을 심습니다.
+ * 힙 슬롯의 일부는 다른 힙 주소를 가리키는 무작위 포인터로 채워 실제 프로세스처럼 거짓 후보가 많게 합니다.
+ * - 맵 생성: 처리량(GB/s), 항목 수, 항목당 바이트
+ * - 경로 탐색: 찾은 경로 수, paths/s, 역추적한 노드 수
+ * 심은 체인이 모두 찾아지는지, 찾은 경로가 모두 목표로 해석되는지 검증합니다.
+ *
+ * 사용 예: PointerScannerBench [힙 크기(MB), 기본 256] [포인터 비율(%), 기본 5]
+ */
+
+#include "../PointerScanner.h"
+#include "../MemoryDump.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t ModuleBase = 0x140000000;
+    const uintptr_t HeapBase = 0x200000000;
+    const size_t HeapRegionSize = 16 * 1024 * 1024;
+
+    void Store(std::vector<std::vector<uint8_t>>& heap, uintptr_t address, uint64_t value) {
+        uintptr_t offset = address - HeapBase;
+        memcpy(&heap[offset / HeapRegionSize][offset % HeapRegionSize], &value, sizeof(value));
+    }
+
+    struct PlantedChain {
+        uintptr_t baseOffset;
+        std::vector<uintptr_t> offsets;
+    };
+}
+
+int main(int argc, char** argv) {
+    size_t heapMegabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    size_t pointerPercent = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 5;
+    if (heapMegabytes < 16) heapMegabytes = 16;
+
+    size_t heapRegions = heapMegabytes / 16;
+    size_t heapSize = heapRegions * HeapRegionSize;
+    printf("PointerScannerBench: heap %zu MB, %zu%% pointer slots\n", heapSize >> 20, pointerPercent);
+
+    // 힙: 작은 정수/float 값 + 일정 비율의 힙 내부 포인터
+    std::mt19937_64 rng(77);
+    std::vector<std::vector<uint8_t>> heap(heapRegions, std::vector<uint8_t>(HeapRegionSize));
+    for (size_t r = 0; r < heapRegions; ++r) {
+        for (size_t i = 0; i < HeapRegionSize; i += 8) {
+            uint64_t random = rng();
+            uint64_t value = random % 100 < pointerPercent ? HeapBase + ((random >> 8) % heapSize & ~uint64_t(7))
+                                                            : (random >> 40);
+            memcpy(&heap[r][i], &value, sizeof(value));
+        }
+    }
+    std::vector<uint8_t> moduleData(64 * 1024);
+    for (size_t i = 0; i < moduleData.size(); i += 8) {
+        uint64_t random = rng();
+        uint64_t value = random % 100 < 20 ? HeapBase + ((random >> 8) % heapSize & ~uint64_t(7)) : (random >> 48);
+        memcpy(&moduleData[i], &value, sizeof(value));
+    }
+
+    // 목표까지 깊이 1~4 체인 심기: module+base → node1 (+o1) → node2 ... (+on) = target
+    const uintptr_t target = HeapBase + heapSize / 2 + 0x128;
+    std::vector<PlantedChain> planted;
+    for (size_t depth = 1; depth <= 4; ++depth) {
+        PlantedChain chain;
+        chain.baseOffset = 0x1000 + depth * 0x100;
+        std::vector<uintptr_t> nodes;
+        for (size_t level = 1; level < depth; ++level) nodes.push_back(HeapBase + (rng() % (heapSize - 0x1000) & ~uint64_t(7)));
+        nodes.push_back(target);
+
+        // 노드마다 해당 구조체 시작(노드 - 오프셋)을 가리키는 포인터를 이전 노드에 저장
+        uintptr_t previous = ModuleBase + chain.baseOffset;
+        for (uintptr_t node : nodes) {
+            uintptr_t offset = (rng() % 0x80) * 8;
+            uint64_t pointer = node - offset;
+            if (previous >= HeapBase) {
+                Store(heap, previous, pointer);
+            } else {
+                memcpy(&moduleData[previous - ModuleBase], &pointer, sizeof(pointer));
+            }
+            chain.offsets.push_back(offset);
+            previous = node;
+        }
+        planted.push_back(chain);
+    }
+
+    MemoryDump dump;
+    MemoryRegion module;
+    module.base = ModuleBase;
+    module.protection = MemoryRead | MemoryWrite;
+    module.type = MemoryRegionType::Image;
+    module.path = "C:\\Games\\game.exe";
+    dump.AddRegion(module, std::move(moduleData));
+    for (size_t r = 0; r < heapRegions; ++r) {
+        MemoryRegion region;
+        region.base = HeapBase + r * HeapRegionSize;
+        region.protection = MemoryRead | MemoryWrite;
+        dump.AddRegion(region, std::move(heap[r]));
+    }
+
+    PointerMap map;
+    map.Build(dump);
+    printf("map:    %.3f s  %.2f GB/s  entries=%zu  %.1f MB (%.1f B/entry)%s\n", map.BuildSeconds(),
+           map.ScannedBytes() / 1e9 / map.BuildSeconds(), map.EntryCount(), map.MemoryBytes() / 1048576.0,
+           map.EntryCount() ? static_cast<double>(map.MemoryBytes()) / map.EntryCount() : 0.0,
+           map.IsTruncated() ? "  TRUNCATED" : "");
+
+    PointerScanner scanner(map, PointerScanner::ModulesFromRegions(dump.EnumerateRegions()));
+    PointerScanConfig config;
+    config.maxDepth = 4;
+    config.maxOffset = 0x400;
+    std::vector<PointerPath> paths = scanner.FindPaths(target, config);
+    const PointerScanner::Stats& stats = scanner.GetLastStats();
+    printf("search: %.3f s  paths=%zu  %.0f paths/s  nodes=%zu  entries visited=%zu%s\n", stats.seconds, stats.pathsFound,
+           stats.PathsPerSecond(), stats.nodesExpanded, stats.entriesVisited, stats.truncated ? "  (truncated)" : "");
+
+    // 모든 경로가 목표로 해석되어야 하고, 심은 체인은 모두 있어야 함
+    bool ok = !paths.empty();
+    size_t wrong = 0;
+    for (const PointerPath& path : paths) {
+        uintptr_t resolved = 0;
+        if (!PointerScanner::Resolve(dump, path.moduleBase, path, resolved) || resolved != target) ++wrong;
+    }
+    for (const PlantedChain& chain : planted) {
+        bool found = false;
+        for (const PointerPath& path : paths) {
+            found |= path.module == "game.exe" && path.baseOffset == chain.baseOffset && path.offsets == chain.offsets;
+        }
+        printf("  depth %zu chain %s\n", chain.offsets.size(), found ? "found" : "MISSING");
+        ok &= found;
+    }
+    if (wrong != 0) printf("  %zu paths do not resolve to the target\n", wrong);
+    ok &= wrong == 0;
+
+    if (!ok) {
+        printf("ERROR: pointer scan results are wrong\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * 프로세스 메모리 백엔드 벤치마크
+ *
+ * 값을 심은 힙을 가진 자식 프로세스를 만들고, IProcessMemory로 연결하여 int32 첫 스캔 처리량을 잽니다.
+ * - LinuxProcessMemory: /proc/<pid>/maps + process_vm_readv
+ * - MemoryDump: 같은 프로세스에서 복사한 덤프 (파일 저장/불러오기 포함)
+ * 두 백엔드에서 찾은 결과가 같은지, 심은 값을 모두 찾는지, 쓰기/일괄 읽기가 동작하는지 검증합니다.
+ *
+ * 사용법: ProcessMemoryBench [힙 크기(MB), 기본 256]
+ */
+
+#include "../ProcessMemory.h"
+#include "../MemoryDump.h"
+#include "../ScanKernels.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    const int PlantedValue = 0x13572468;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::vector<uintptr_t> ScanInts(const char* name, IProcessMemory& memory, size_t& hitsInHeap, uintptr_t heapBase, size_t heapSize) {
+        std::vector<MemoryRange> ranges = memory.CollectRanges([](const MemoryRegion& region) { return region.IsWritable(); });
+
+        ScanExecutor executor({0, 1024 * 1024, sizeof(int) - 1});
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uintptr_t> hits = executor.Run(ranges, memory.MakeReadFunction(),
+            [](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+                FindExact<int>(data, size, PlantedValue, base, out);
+            });
+        double seconds = Seconds(start);
+
+        hitsInHeap = 0;
+        for (uintptr_t address : hits) {
+            if (address >= heapBase && address < heapBase + heapSize) ++hitsInHeap;
+        }
+        printf("%-8s regions=%-5zu scanned=%8.1f MB  %8.3fs  %6.2f GB/s  hits=%zu (heap %zu)  failedReads=%zu\n", name,
+               ranges.size(), executor.GetLastStats().bytesScanned / (1024.0 * 1024.0), seconds,
+               executor.GetLastStats().bytesScanned / seconds / 1e9, hits.size(), hitsInHeap, executor.GetLastStats().failedReads);
+        return hits;
+    }
+}
+
+int main(int argc, char** argv) {
+#if defined(__linux__)
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    if (megabytes == 0) megabytes = 1;
+    const size_t heapSize = megabytes * 1024 * 1024;
+    const size_t planted = heapSize / 65536;
+
+    // 자식: 힙을 만들고 주소를 파이프로 알린 뒤 대기
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) return 1;
+    pid_t child = fork();
+    if (child == 0) {
+        close(pipeFds[0]);
+        std::vector<uint8_t> heap(heapSize);
+        std::mt19937_64 rng(11);
+        for (size_t i = 0; i < heap.size(); ++i) heap[i] = static_cast<uint8_t>(rng());
+        for (size_t n = 0; n < planted; ++n) {
+            memcpy(heap.data() + n * 65536 + rng() % (65536 - sizeof(int)), &PlantedValue, sizeof(int));
+        }
+        uintptr_t base = reinterpret_cast<uintptr_t>(heap.data());
+        if (write(pipeFds[1], &base, sizeof(base)) != sizeof(base)) _exit(1);
+        pause();
+        _exit(0);
+    }
+    close(pipeFds[1]);
+    uintptr_t heapBase = 0;
+    if (read(pipeFds[0], &heapBase, sizeof(heapBase)) != sizeof(heapBase)) return 1;
+    close(pipeFds[0]);
+
+    printf("ProcessMemoryBench: child pid %d, %zu MB heap, %zu planted values\n", static_cast<int>(child), megabytes, planted);
+
+    bool ok = true;
+    std::unique_ptr<IProcessMemory> memory = OpenProcessMemory(static_cast<uint32_t>(child));
+    if (!memory) {
+        printf("ERROR: cannot open child process\n");
+        kill(child, SIGKILL);
+        return 1;
+    }
+
+    size_t liveHeapHits = 0;
+    std::vector<uintptr_t> liveHits = ScanInts("live", *memory, liveHeapHits, heapBase, heapSize);
+    ok &= liveHeapHits >= planted;
+
+    // 덤프: 캡처 → 파일 저장 → 불러오기 → 같은 스캔
+    auto start = std::chrono::steady_clock::now();
+    MemoryDump captured = MemoryDump::Capture(*memory, [](const MemoryRegion& region) { return region.IsWritable(); });
+    printf("%-8s captured %zu regions, %.1f MB in %.3fs\n", "dump", captured.RegionCount(),
+           captured.TotalSize() / (1024.0 * 1024.0), Seconds(start));
+    const char* dumpPath = "ProcessMemoryBench.dump";
+    MemoryDump dump;
+    ok &= captured.Save(dumpPath) && dump.Load(dumpPath);
+    std::remove(dumpPath);
+
+    size_t dumpHeapHits = 0;
+    std::vector<uintptr_t> dumpHits = ScanInts("dump", dump, dumpHeapHits, heapBase, heapSize);
+    ok &= dumpHeapHits == liveHeapHits;
+
+    // 쓰기 후 일괄 읽기로 확인
+    int newValue = 7;
+    if (liveHits.empty()) liveHits.push_back(heapBase);
+    ok &= memory->WriteValue(liveHits.front(), newValue);
+    BatchReader reader(memory->MakeBatchReadFunction());
+    size_t changed = 0;
+    reader.ForEachAddress(std::vector<uintptr_t>(liveHits.begin(), liveHits.begin() + 1), sizeof(int),
+        [&](uintptr_t, const uint8_t* current) {
+            int value;
+            memcpy(&value, current, sizeof(int));
+            changed += value == newValue;
+        });
+    ok &= changed == 1;
+    printf("%-8s write + batched read back %s\n", "write", changed == 1 ? "ok" : "FAILED");
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+
+    if (!ok) {
+        printf("ERROR: backends disagree or planted values missing\n");
+        return 1;
+    }
+    return 0;
+#else
+    (void)argc;
+    (void)argv;
+    printf("ProcessMemoryBench: Linux only (uses fork and process_vm_readv)\n");
+    return 0;
+#endif
+}
@@ -0,0 +1,249 @@
+/*
+ * 주소 → 영역 조회 벤치마크 (주소 키 캐시 + QueryRegion 대비 RegionMap)
+ *
+ * 영역 수천 개(보호 속성을 번갈아 두어 합쳐지지 않게)를 만들고, 그 안의 무작위 주소마다 "포함하는 영역"을 찾습니다.
+ * - 기존 방식: 조회한 주소 자체를 키로 하는 std::map 캐시, miss면 QueryRegion (Linux: /proc/self/maps 읽기)
+ * - RegionMap: 전체 열거 한 번 + 이진 탐색
+ * 조회당 시간과 백엔드 호출 수(QueryRegion, EnumerateRegions)를 비교하고,
+ * 영역 해제/보호 변경 후 RefreshAround()가 접근 실패 주소의 영역만 고쳐 QueryRegion과 같은 답을 내는지 검증합니다.
+ *
+ * Linux는 이 프로세스(LinuxProcessMemory)에 mmap한 영역, 그 외에는 MemoryDump 영역을 대상으로 합니다.
+ *
+ * 사용법: RegionMapBench [영역 수, 기본 2000] [조회 수, 기본 200000]
+ */
+
+#include "../MemoryDump.h"
+#include "../RegionMap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    const size_t RegionPages = 4;
+    const size_t PageSize = 4096;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 백엔드 호출 수를 세는 래퍼
+    class CountingMemory : public IProcessMemory {
+    public:
+        explicit CountingMemory(IProcessMemory& inner) : inner(inner) {}
+
+        size_t enumerations = 0;
+        size_t queries = 0;
+
+        std::vector<MemoryRegion> EnumerateRegions() override {
+            ++enumerations;
+            return inner.EnumerateRegions();
+        }
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override {
+            ++queries;
+            return inner.QueryRegion(address, result);
+        }
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            return inner.ReadBytes(address, buffer, size, bytesRead);
+        }
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            return inner.WriteBytes(address, data, size, bytesWritten);
+        }
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            return inner.Protect(address, size, protection, oldProtection);
+        }
+
+    private:
+        IProcessMemory& inner;
+    };
+
+    // 대상 영역들: 같은 크기, 읽기 전용 / 읽기-쓰기를 번갈아 둠
+    struct Target {
+        std::unique_ptr<IProcessMemory> memory;
+        std::vector<uintptr_t> bases;
+#if defined(__linux__)
+        uint8_t* block = nullptr;
+        size_t blockSize = 0;
+
+        ~Target() {
+            if (block) munmap(block, blockSize);
+        }
+#endif
+
+        void Unmap(size_t index) {
+#if defined(__linux__)
+            munmap(reinterpret_cast<void*>(bases[index]), RegionPages * PageSize);
+#else
+            // 덤프는 영역을 지울 수 없으므로 접근 불가로 바꿈 (Find는 영역을 돌려주지만 읽을 수 없음)
+            uint32_t old = 0;
+            memory->Protect(bases[index], RegionPages * PageSize, MemoryNoAccess, old);
+#endif
+        }
+
+        void MakeReadOnly(size_t index) {
+            uint32_t old = 0;
+#if defined(__linux__)
+            mprotect(reinterpret_cast<void*>(bases[index]), RegionPages * PageSize, PROT_READ);
+            (void)old;
+#else
+            memory->Protect(bases[index], RegionPages * PageSize, MemoryRead, old);
+#endif
+        }
+    };
+
+    std::unique_ptr<Target> MakeTarget(size_t count) {
+        auto target = std::make_unique<Target>();
+#if defined(__linux__)
+        // 영역 사이에 접근 불가 페이지를 두어 주소 공간을 한 번에 잡고 나눔
+        target->blockSize = count * (RegionPages + 1) * PageSize;
+        void* block = mmap(nullptr, target->blockSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED) return nullptr;
+        target->block = static_cast<uint8_t*>(block);
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t* base = target->block + i * (RegionPages + 1) * PageSize;
+            mprotect(base, RegionPages * PageSize, i % 2 ? PROT_READ : PROT_READ | PROT_WRITE);
+            target->bases.push_back(reinterpret_cast<uintptr_t>(base));
+        }
+        target->memory = std::make_unique<LinuxProcessMemory>(getpid());
+#else
+        auto dump = std::make_unique<MemoryDump>();
+        for (size_t i = 0; i < count; ++i) {
+            MemoryRegion region;
+            region.base = 0x10000000 + i * (RegionPages + 1) * PageSize;
+            region.protection = i % 2 ? MemoryRead : MemoryRead | MemoryWrite;
+            dump->AddRegion(region, std::vector<uint8_t>(RegionPages * PageSize));
+            target->bases.push_back(region.base);
+        }
+        target->memory = std::move(dump);
+#endif
+        return target;
+    }
+
+    bool SameAnswer(const MemoryRegion* found, bool queried, const MemoryRegion& expected) {
+        if (!queried || !expected.IsReadable()) return !found || !found->IsReadable();
+        return found && found->base == expected.base && found->size == expected.size && found->protection == expected.protection;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t regionCount = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 2000;
+    size_t lookupCount = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 200000;
+    if (regionCount < 4) regionCount = 4;
+    if (lookupCount == 0) lookupCount = 1;
+
+    std::unique_ptr<Target> target = MakeTarget(regionCount);
+    if (!target) {
+        printf("failed to map target regions\n");
+        return 1;
+    }
+    CountingMemory counting(*target->memory);
+
+    std::mt19937_64 rng(19);
+    std::vector<uintptr_t> addresses(lookupCount);
+    for (uintptr_t& address : addresses) {
+        address = target->bases[rng() % regionCount] + (rng() % (RegionPages * PageSize / 4)) * 4;
+    }
+
+    printf("RegionMapBench: %zu regions of %zu KB, %zu lookups, %zu regions in the process\n", regionCount,
+           RegionPages * PageSize / 1024, lookupCount, target->memory->EnumerateRegions().size());
+
+    // 기존 방식: 주소 키 캐시. 느리면 조회 수를 줄여 측정하고 조회당 시간으로 비교
+    size_t legacyLookups = std::min<size_t>(lookupCount, 2000);
+    std::map<uintptr_t, MemoryRegion> legacyCache;
+    size_t legacyWritable = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < legacyLookups; ++i) {
+        auto it = legacyCache.find(addresses[i]);
+        if (it == legacyCache.end()) {
+            MemoryRegion region;
+            if (counting.QueryRegion(addresses[i], region)) it = legacyCache.emplace(addresses[i], region).first;
+        }
+        legacyWritable += it != legacyCache.end() && it->second.IsWritable();
+    }
+    double legacyNs = Seconds(start) * 1e9 / legacyLookups;
+    size_t legacyQueries = counting.queries;
+    printf("  %-10s %10.1f ns/lookup  backend calls=%zu for %zu lookups\n", "legacy", legacyNs, legacyQueries, legacyLookups);
+
+    // RegionMap
+    counting.queries = 0;
+    RegionMap regions(counting);
+    size_t mapWritable = 0;
+    start = std::chrono::steady_clock::now();
+    for (uintptr_t address : addresses) mapWritable += regions.IsWritable(address, sizeof(int));
+    double mapNs = Seconds(start) * 1e9 / lookupCount;
+    printf("  %-10s %10.1f ns/lookup  backend calls=%zu (enumerations %zu, queries %zu)  speedup %.0fx\n", "RegionMap", mapNs,
+           counting.enumerations + counting.queries, counting.enumerations, counting.queries, legacyNs / mapNs);
+
+    bool ok = true;
+    size_t referenceWritable = 0;
+    for (size_t i = 0; i < legacyLookups; ++i) referenceWritable += regions.IsWritable(addresses[i], sizeof(int));
+    if (referenceWritable != legacyWritable) {
+        printf("  ERROR: writable answers differ (legacy %zu, RegionMap %zu)\n", legacyWritable, referenceWritable);
+        ok = false;
+    }
+    (void)mapWritable;
+
+    // 영역 해제 / 보호 변경 후 접근 실패 주소만 다시 확인
+    size_t changedCount = std::min<size_t>(32, regionCount / 2);
+    std::vector<size_t> changed;
+    for (size_t n = 0; n < changedCount; ++n) {
+        size_t index = (n * 2 + 2) % regionCount;      // 읽기-쓰기 영역
+        changed.push_back(index);
+        if (n % 2) target->Unmap(index);
+        else target->MakeReadOnly(index);
+    }
+    size_t enumerationsBefore = counting.enumerations;
+    counting.queries = 0;
+    size_t mismatches = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t index : changed) {
+        uintptr_t address = target->bases[index] + PageSize;
+        regions.RefreshAround(address);
+        MemoryRegion expected;
+        bool queried = target->memory->QueryRegion(address, expected);
+        mismatches += !SameAnswer(regions.Find(address), queried, expected);
+        mismatches += regions.IsWritable(address, sizeof(int));
+    }
+    double refreshMs = Seconds(start) * 1e3;
+    printf("  %-10s %zu changed regions fixed with %zu queries, %zu full enumerations, %.2f ms, mismatches=%zu\n", "refresh",
+           changed.size(), counting.queries, counting.enumerations - enumerationsBefore, refreshMs, mismatches);
+    ok &= mismatches == 0 && counting.enumerations == enumerationsBefore;
+
+    // 대상 구간에서 RefreshAround로 고친 목록이 새로 열거한 목록과 같아야 함 (구간 밖의 힙 등은 실행 중에 바뀔 수 있음)
+    uintptr_t low = target->bases.front();
+    uintptr_t high = target->bases.back() + RegionPages * PageSize;
+    auto inTarget = [&](const std::vector<MemoryRegion>& list) {
+        std::vector<MemoryRegion> result;
+        for (const MemoryRegion& region : list) {
+            if (region.base >= low && region.base + region.size <= high) result.push_back(region);
+        }
+        return result;
+    };
+    std::vector<MemoryRegion> fixed = inTarget(regions.Regions());
+    std::vector<MemoryRegion> fresh = inTarget(target->memory->EnumerateRegions());
+    size_t drift = fixed.size() == fresh.size() ? 0 : std::max(fixed.size(), fresh.size()) - std::min(fixed.size(), fresh.size());
+    for (size_t i = 0; i < std::min(fixed.size(), fresh.size()); ++i) {
+        drift += fixed[i].base != fresh[i].base || fixed[i].size != fresh[i].size || fixed[i].protection != fresh[i].protection;
+    }
+    printf("  %-10s %zu regions in the target range, %zu differ from a fresh enumeration\n", "verify", fresh.size(), drift);
+    ok &= drift == 0;
+
+    if (!ok) {
+        printf("ERROR: RegionMap answers differ from QueryRegion\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * 스트리밍 영역 읽기 벤치마크
+ *
+ * 큰 합성 영역 하나에서 마스크 패턴을 찾습니다. 패턴 일부는 일부러 청크 경계에 걸치게 심습니다.
+ * - 기존 방식: 영역 크기만큼 버퍼를 할당해 한 번에 읽고 비교
+ * - RegionStream (읽기 스레드 없음 / 더블 버퍼 / 트리플 버퍼)
+ * 결과가 모두 같은지, 버퍼 메모리가 영역 크기와 무관한지 검증합니다.
+ *
+ * 사용법: RegionStreamBench [영역 크기(MB), 기본 512] [청크 크기(KB), 기본 1024]
+ */
+
+#include "../RegionStream.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uint8_t Pattern[] = {0x48, 0x8B, 0x05, 0x00, 0x00, 0x00, 0x00, 0xF3, 0x0F, 0x10};
+    const bool Mask[] = {true, true, true, false, false, false, false, true, true, true};
+    const size_t PatternSize = sizeof(Pattern);
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 기존 예제들의 바이트 단위 비교
+    void MatchPattern(const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+        if (size < PatternSize) return;
+        for (size_t i = 0; i + PatternSize <= size; ++i) {
+            if (data[i] != Pattern[0]) continue;
+            bool match = true;
+            for (size_t j = 1; j < PatternSize; ++j) {
+                if (Mask[j] && data[i + j] != Pattern[j]) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) out.push_back(base + i);
+        }
+    }
+
+    bool RunStream(const char* name, const RegionStreamConfig& config, ScanExecutor::ReadFunction read, uintptr_t base,
+                   size_t size, const std::vector<uintptr_t>& expected) {
+        RegionStream stream(read, config);
+        std::vector<uintptr_t> hits;
+        auto start = std::chrono::steady_clock::now();
+        stream.ForEach(base, size, [&](const uint8_t* data, size_t length, uintptr_t chunkBase) {
+            MatchPattern(data, length, chunkBase, hits);
+            return true;
+        });
+        double seconds = Seconds(start);
+
+        bool ok = hits == expected;
+        printf("%-18s %8.3fs  %6.2f GB/s  buffers=%8.1f KB  chunks=%-6zu hits=%zu%s\n", name, seconds, size / seconds / 1e9,
+               stream.GetLastStats().bufferBytes / 1024.0, stream.GetLastStats().chunks, hits.size(), ok ? "" : "  MISMATCH");
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 512;
+    size_t chunkKb = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 1024;
+    if (megabytes == 0) megabytes = 1;
+    if (chunkKb == 0) chunkKb = 1;
+    const size_t size = megabytes * 1024 * 1024;
+    const size_t chunkSize = chunkKb * 1024;
+
+    // "대상 프로세스" 영역: 무작위 바이트 + 청크 경계에 걸친 패턴과 청크 안쪽 패턴
+    std::vector<uint8_t> region(size);
+    std::mt19937_64 rng(7);
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t value = rng();
+        memcpy(&region[i], &value, std::min<size_t>(8, size - i));
+    }
+    size_t planted = 0;
+    for (size_t boundary = chunkSize; boundary + PatternSize < size; boundary += chunkSize) {
+        memcpy(&region[boundary - PatternSize / 2], Pattern, PatternSize);
+        memcpy(&region[boundary - chunkSize / 2], Pattern, PatternSize);
+        planted += 2;
+    }
+    uintptr_t base = reinterpret_cast<uintptr_t>(region.data());
+    ScanExecutor::ReadFunction read = [](uintptr_t address, uint8_t* buffer, size_t length, size_t& bytesRead) {
+        memcpy(buffer, reinterpret_cast<const void*>(address), length);
+        bytesRead = length;
+        return true;
+    };
+    printf("RegionStreamBench: %zu MB region, %zu KB chunks, %zu planted patterns (half across chunk boundaries)\n",
+           megabytes, chunkKb, planted);
+
+    // 기존 방식: 영역 전체 버퍼
+    std::vector<uintptr_t> expected;
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint8_t> buffer(size);
+        size_t bytesRead = 0;
+        read(base, buffer.data(), size, bytesRead);
+        MatchPattern(buffer.data(), bytesRead, base, expected);
+        double seconds = Seconds(start);
+        printf("%-18s %8.3fs  %6.2f GB/s  buffers=%8.1f KB  chunks=%-6d hits=%zu\n", "whole region", seconds,
+               size / seconds / 1e9, size / 1024.0, 1, expected.size());
+    }
+
+    bool ok = expected.size() >= planted;
+    RegionStreamConfig config;
+    config.chunkSize = chunkSize;
+    config.overlap = PatternSize - 1;
+
+    config.prefetch = false;
+    ok &= RunStream("stream (inline)", config, read, base, size, expected);
+    config.prefetch = true;
+    ok &= RunStream("stream (2 buffers)", config, read, base, size, expected);
+    config.bufferCount = 3;
+    ok &= RunStream("stream (3 buffers)", config, read, base, size, expected);
+
+    // 중간 청크를 읽지 못하는 경우: 그 청크와 그 경계에 걸친 결과만 빠져야 함
+    {
+        uintptr_t failBegin = base + chunkSize * 2;
+        uintptr_t failEnd = failBegin + chunkSize;
+        ScanExecutor::ReadFunction failing = [&](uintptr_t address, uint8_t* buffer, size_t length, size_t& bytesRead) {
+            if (address >= failBegin && address < failEnd) {
+                bytesRead = 0;
+                return false;
+            }
+            return read(address, buffer, length, bytesRead);
+        };
+        std::vector<uintptr_t> expectedFailing;
+        for (uintptr_t hit : expected) {
+            if (hit + PatternSize <= failBegin || hit >= failEnd) expectedFailing.push_back(hit);
+        }
+        config.bufferCount = 2;
+        ok &= size > chunkSize * 3 ? RunStream("unreadable chunk", config, failing, base, size, expectedFailing) : true;
+    }
+
+    if (!ok) {
+        printf("ERROR: streamed results differ from whole-region scan\n");
+        return 1;
+    }
+    return 0;
+}
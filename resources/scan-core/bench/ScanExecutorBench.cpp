@@ -0,0 +1,95 @@
+/*
+ * 스캔 실행기 스레드 확장성 벤치마크
+ *
+ * 크기가 다른 합성 영역들을 로컬 메모리에 만들고, 스레드 수를 바꿔 가며 int32 첫 스캔을 실행합니다.
+ * 모든 스레드 수에서 결과가 영역별 단일 스레드 스캔과 같은지(작업 단위 경계 포함) 검증합니다.
+ *
+ * 사용법: ScanExecutorBench [총 크기(MB), 기본 512] [작업 단위(KB), 기본 1024]
+ */
+
+#include "../ScanKernels.h"
+#include "../ScanExecutor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+int main(int argc, char** argv) {
+    size_t totalMB = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 512;
+    size_t chunkKB = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 1024;
+    if (totalMB == 0) totalMB = 1;
+    if (chunkKB == 0) chunkKB = 1024;
+
+    // 4KB ~ 64MB 사이의 다양한 영역 크기
+    std::mt19937_64 rng(777);
+    std::vector<std::vector<uint8_t>> storage;
+    std::vector<MemoryRange> regions;
+    size_t remaining = totalMB * 1024 * 1024;
+    while (remaining > 0) {
+        size_t pages = static_cast<size_t>(1) << (rng() % 15);
+        size_t size = std::min(remaining, pages * 4096);
+        storage.emplace_back(size);
+        std::vector<uint8_t>& region = storage.back();
+        for (size_t i = 0; i < size; ++i) region[i] = static_cast<uint8_t>(rng() % 4); // 0~3: 값 1000 주변 바이트가 자주 등장
+        for (size_t n = 0; n < size / 4096; ++n) {
+            int value = 1000;
+            memcpy(region.data() + rng() % (size - sizeof(int) + 1), &value, sizeof(int));
+        }
+        regions.push_back({reinterpret_cast<uintptr_t>(region.data()), size});
+        remaining -= size;
+    }
+
+    // 기준 결과: 영역별 단일 스캔
+    std::vector<uintptr_t> reference;
+    std::vector<MemoryRange> sorted = regions;
+    std::sort(sorted.begin(), sorted.end(), [](const MemoryRange& a, const MemoryRange& b) { return a.base < b.base; });
+    for (const MemoryRange& range : sorted) {
+        FindExact<int>(reinterpret_cast<const uint8_t*>(range.base), range.size, 1000, range.base, reference);
+    }
+
+    auto read = [](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+        memcpy(buffer, reinterpret_cast<const void*>(address), size);
+        bytesRead = size;
+        return true;
+    };
+    auto scan = [](const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+        FindExact<int>(data, size, 1000, baseAddress, out);
+    };
+
+    size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    printf("ScanExecutorBench: %zu MB in %zu regions, chunk %zu KB, %zu hardware threads\n",
+           totalMB, regions.size(), chunkKB, hardwareThreads);
+
+    bool ok = true;
+    double singleThreadSeconds = 0.0;
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(hardwareThreads);
+
+    for (size_t threads : threadCounts) {
+        ScanExecutor executor({threads, chunkKB * 1024, sizeof(int) - 1});
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uintptr_t> hits = executor.Run(regions, read, scan);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) singleThreadSeconds = seconds;
+
+        bool match = (hits == reference);
+        ok = ok && match;
+        const ScanExecutor::Stats& stats = executor.GetLastStats();
+        printf("threads=%-3zu %8.2f GB/s  speedup=%.2fx  units=%zu stolen=%zu hits=%zu%s\n",
+               threads, (totalMB / 1024.0) / seconds, singleThreadSeconds / seconds,
+               stats.unitCount, stats.stolenUnits, hits.size(), match ? "" : "  MISMATCH");
+    }
+
+    if (!ok) {
+        printf("ERROR: executor results differ from per-region scan\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * 비동기 스캔 작업 벤치마크 (진행률, 취소, 시간 예산, 이어서 스캔)
+ *
+ * 합성 영역들에서 int32 첫 스캔을 다음 방식으로 실행합니다.
+ * - 동기: ScanExecutor::Run (호출한 스레드가 끝날 때까지 멈춤)
+ * - 작업: StartScanJob + ScanControl. 호출한 스레드는 1ms마다 진행률을 읽으며 가장 길게 멈춘 시간을 잼
+ * - 취소: 진행률 30%에서 Cancel(), 취소부터 결과를 받기까지의 시간
+ * - 시간 예산: 동기 스캔 시간의 25%를 예산으로 주고 실제로 멈춘 시간
+ * 중단된 두 경우 모두 부분 결과 + 남은 작업 단위를 이어서 스캔한 결과가 동기 스캔과 같은지 검증합니다.
+ *
+ * 사용법: ScanJobBench [총 크기(MB), 기본 512] [스레드 수, 기본 0 = 하드웨어]
+ */
+
+#include "../ScanKernels.h"
+#include "../ScanJob.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Observed {
+        double seconds = 0.0;
+        double longestStall = 0.0;      // 호출한 스레드가 진행률을 읽지 못한 가장 긴 시간
+        size_t polls = 0;
+    };
+
+    // 1ms마다 진행률을 읽음. cancelAt(0~1)을 넘으면 취소하고 그 시각을 cancelTime에 기록
+    template<typename Result>
+    Result Poll(ScanJob<Result>& job, Observed& observed, double cancelAt = 2.0,
+                std::chrono::steady_clock::time_point* cancelTime = nullptr) {
+        auto start = std::chrono::steady_clock::now();
+        auto last = start;
+        Result result = WaitScanJob(job, std::chrono::milliseconds(1), [&](const ScanControl& progress) {
+            auto now = std::chrono::steady_clock::now();
+            observed.longestStall = std::max(observed.longestStall, std::chrono::duration<double>(now - last).count());
+            last = now;
+            ++observed.polls;
+            if (progress.Fraction() >= cancelAt && !progress.Cancelled()) {
+                if (cancelTime) *cancelTime = now;
+                return false;
+            }
+            return true;
+        });
+        observed.seconds = Seconds(start);
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t totalMB = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 512;
+    size_t threads = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 0;
+    if (totalMB == 0) totalMB = 1;
+
+    // 4KB ~ 64MB 사이의 다양한 영역 크기
+    std::mt19937_64 rng(777);
+    std::vector<std::vector<uint8_t>> storage;
+    std::vector<MemoryRange> regions;
+    size_t remaining = totalMB * 1024 * 1024;
+    while (remaining > 0) {
+        size_t pages = static_cast<size_t>(1) << (rng() % 15);
+        size_t size = std::min(remaining, pages * 4096);
+        storage.emplace_back(size);
+        std::vector<uint8_t>& region = storage.back();
+        for (size_t i = 0; i < size; ++i) region[i] = static_cast<uint8_t>(rng() % 4);
+        for (size_t n = 0; n < size / 4096; ++n) {
+            int value = 1000;
+            memcpy(region.data() + rng() % (size - sizeof(int) + 1), &value, sizeof(int));
+        }
+        regions.push_back({reinterpret_cast<uintptr_t>(region.data()), size});
+        remaining -= size;
+    }
+
+    auto read = [](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+        memcpy(buffer, reinterpret_cast<const void*>(address), size);
+        bytesRead = size;
+        return true;
+    };
+    auto scan = [](const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+        FindExact<int>(data, size, 1000, baseAddress, out);
+    };
+
+    ScanExecutor prototype({threads, 1024 * 1024, sizeof(int) - 1});
+    auto startJob = [&](std::chrono::milliseconds budget) {
+        return StartScanJob([&](ScanControl& control) {
+            ScanExecutor executor = prototype;
+            executor.SetControl(&control);
+            PartialScan<std::vector<uintptr_t>> result;
+            result.value = executor.Run(regions, read, scan);
+            result.pending = executor.GetPendingUnits();
+            return result;
+        }, budget);
+    };
+
+    // 부분 결과 + 남은 단위를 이어서 스캔한 결과 (둘 다 정렬되어 있고 주소 구간이 겹치지 않음)
+    auto resume = [&](const PartialScan<std::vector<uintptr_t>>& partial) {
+        ScanExecutor executor = prototype;
+        std::vector<uintptr_t> rest = executor.Run(partial.pending, read, scan);
+        std::vector<uintptr_t> merged;
+        std::merge(partial.value.begin(), partial.value.end(), rest.begin(), rest.end(), std::back_inserter(merged));
+        return merged;
+    };
+
+    printf("ScanJobBench: %zu MB in %zu regions, %zu threads\n", totalMB, regions.size(),
+           prototype.ResolveThreadCount(static_cast<size_t>(-1)));
+
+    // 동기 기준
+    ScanExecutor syncExecutor = prototype;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uintptr_t> reference = syncExecutor.Run(regions, read, scan);
+    double syncSeconds = Seconds(start);
+    printf("  %-10s %8.3f s  %8.2f GB/s  hits=%zu  (caller blocked for the whole scan)\n", "sync", syncSeconds,
+           totalMB / 1024.0 / syncSeconds, reference.size());
+
+    bool ok = true;
+
+    // 작업 (끝까지)
+    {
+        ScanJob<PartialScan<std::vector<uintptr_t>>> job = startJob(std::chrono::milliseconds(0));
+        Observed observed;
+        PartialScan<std::vector<uintptr_t>> result = Poll(job, observed);
+        bool same = result.Complete() && result.value == reference;
+        ok &= same;
+        printf("  %-10s %8.3f s  overhead %+.1f%%  polls=%zu  longest caller stall %.2f ms  hits=%zu%s\n", "job",
+               observed.seconds, (observed.seconds / syncSeconds - 1.0) * 100.0, observed.polls, observed.longestStall * 1e3,
+               result.value.size(), same ? "" : "  MISMATCH");
+    }
+
+    // 취소
+    {
+        ScanJob<PartialScan<std::vector<uintptr_t>>> job = startJob(std::chrono::milliseconds(0));
+        Observed observed;
+        auto cancelTime = std::chrono::steady_clock::now();
+        PartialScan<std::vector<uintptr_t>> partial = Poll(job, observed, 0.3, &cancelTime);
+        double latency = Seconds(cancelTime);
+        bool same = resume(partial) == reference;
+        ok &= same && !partial.Complete();
+        printf("  %-10s cancel latency %.2f ms  partial hits=%zu  pending units=%zu  resumed == sync: %s\n", "cancel",
+               latency * 1e3, partial.value.size(), partial.pending.size(), same ? "yes" : "NO");
+    }
+
+    // 시간 예산
+    {
+        auto budget = std::chrono::milliseconds(std::max<long long>(1, static_cast<long long>(syncSeconds * 250)));
+        ScanJob<PartialScan<std::vector<uintptr_t>>> job = startJob(budget);
+        Observed observed;
+        PartialScan<std::vector<uintptr_t>> partial = Poll(job, observed);
+        bool same = resume(partial) == reference;
+        ok &= same;
+        printf("  %-10s budget %lld ms -> stopped after %.1f ms  partial hits=%zu  pending units=%zu  resumed == sync: %s\n",
+               "budget", static_cast<long long>(budget.count()), observed.seconds * 1e3, partial.value.size(),
+               partial.pending.size(), same ? "yes" : "NO");
+    }
+
+    if (!ok) {
+        printf("ERROR: job results differ from the synchronous scan\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * 스캔 커널 마이크로 벤치마크
+ *
+ * 합성 버퍼(랜덤 바이트 + 심어 둔 값)에서 타입별/커널별 FindExact 처리량(GB/s)을 측정합니다.
+ * 각 SIMD 커널의 결과가 스칼라 커널과 동일한지도 함께 검증합니다.
+ *
+ * 사용법: ScanKernelBench [버퍼 크기(MB), 기본 256] [반복 횟수, 기본 3]
+ */
+
+#include "../ScanKernels.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    template<typename T>
+    void PlantValues(std::vector<uint8_t>& buffer, T value, size_t count, std::mt19937_64& rng) {
+        // 정렬/비정렬 위치 모두에 값을 심음
+        std::uniform_int_distribution<size_t> pos(0, buffer.size() - sizeof(T));
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(buffer.data() + pos(rng), &value, sizeof(T));
+        }
+    }
+
+    template<typename T>
+    bool BenchType(const char* typeName, T value, const std::vector<uint8_t>& buffer, int iterations) {
+        std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+        SimdLevel best = ActiveSimdLevel();
+        if (best == SimdLevel::SSE2 || best == SimdLevel::AVX2) levels.push_back(SimdLevel::SSE2);
+        if (best == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+        std::vector<uintptr_t> reference;
+        bool ok = true;
+
+        for (SimdLevel level : levels) {
+            std::vector<uintptr_t> hits;
+            hits.reserve(1 << 16);
+            double bestSeconds = 1e30;
+
+            for (int it = 0; it < iterations; ++it) {
+                hits.clear();
+                auto start = std::chrono::steady_clock::now();
+                FindExact<T>(buffer.data(), buffer.size(), value, 0x10000, hits, level);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (seconds < bestSeconds) bestSeconds = seconds;
+            }
+
+            bool match = true;
+            if (level == SimdLevel::Scalar) {
+                reference = hits;
+            } else {
+                match = (hits == reference);
+                ok = ok && match;
+            }
+
+            double gbPerSec = (buffer.size() / 1e9) / bestSeconds;
+            printf("%-8s %-7s %8.2f GB/s  hits=%zu%s\n", typeName, SimdLevelName(level), gbPerSec, hits.size(),
+                   match ? "" : "  MISMATCH");
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (megabytes == 0) megabytes = 1;
+    if (iterations <= 0) iterations = 1;
+
+    printf("ScanKernelBench: %zu MB, %d iterations, detected %s\n", megabytes, iterations, SimdLevelName(ActiveSimdLevel()));
+
+    std::mt19937_64 rng(12345);
+    std::vector<uint8_t> buffer(megabytes * 1024 * 1024);
+    for (size_t i = 0; i + 8 <= buffer.size(); i += 8) {
+        uint64_t r = rng();
+        memcpy(buffer.data() + i, &r, 8);
+    }
+
+    const size_t planted = 4096;
+    PlantValues<int8_t>(buffer, 0x5A, planted, rng);
+    PlantValues<int16_t>(buffer, 0x1234, planted, rng);
+    PlantValues<int32_t>(buffer, 1000, planted, rng);
+    PlantValues<int64_t>(buffer, 0x0123456789ABCDEFll, planted, rng);
+    PlantValues<float>(buffer, 60.0f, planted, rng);
+    PlantValues<double>(buffer, 144.0, planted, rng);
+    PlantValues<float>(buffer, -0.0f, planted, rng);
+
+    bool ok = true;
+    ok &= BenchType<int8_t>("int8", 0x5A, buffer, iterations);
+    ok &= BenchType<int16_t>("int16", 0x1234, buffer, iterations);
+    ok &= BenchType<int32_t>("int32", 1000, buffer, iterations);
+    ok &= BenchType<int64_t>("int64", 0x0123456789ABCDEFll, buffer, iterations);
+    ok &= BenchType<float>("float", 60.0f, buffer, iterations);
+    ok &= BenchType<double>("double", 144.0, buffer, iterations);
+    ok &= BenchType<float>("float0", 0.0f, buffer, iterations);
+
+    if (!ok) {
+        printf("ERROR: SIMD kernel results differ from scalar kernel\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * 압축 스캔 결과 저장소 벤치마크
+ *
+ * 빽빽한 결과(0으로 채운 힙에서 0 검색)와 드문 결과(랜덤 데이터)로 저장소를 만들어
+ * 결과당 메모리 사용량, 생성/순회 시간을 측정하고 vector<uintptr_t> + map 방식의 추정치와 비교합니다.
+ * 작업 단위 조각을 이어 붙인 결과가 한 번에 만든 결과와 같은지(블록 수, 블록별 결과 수 포함)도 검증합니다.
+ *
+ * 사용법: ScanResultStoreBench [버퍼 크기(MB), 기본 256]
+ */
+
+#include "../ScanKernels.h"
+#include "../ScanResultStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool BenchCase(const char* name, const std::vector<uint8_t>& buffer, int value) {
+        const uintptr_t base = 0x10000000;
+        std::vector<uintptr_t> hits;
+        FindExact<int>(buffer.data(), buffer.size(), value, base, hits);
+
+        auto start = std::chrono::steady_clock::now();
+        ScanResultStore::Builder builder(sizeof(int));
+        for (uintptr_t address : hits) {
+            builder.Append(address, buffer.data() + (address - base));
+        }
+        ScanResultStore store = builder.Finish();
+        double buildSeconds = Seconds(start);
+
+        // 1MB 작업 단위 조각으로 나누어 만든 뒤 이어 붙이기
+        ScanResultStore::Builder merged(sizeof(int));
+        size_t next = 0;
+        for (uintptr_t unit = base; unit < base + buffer.size(); unit += 1024 * 1024 + 4096) {
+            ScanResultStore::Builder fragment(sizeof(int));
+            while (next < hits.size() && hits[next] < unit + 1024 * 1024 + 4096) {
+                fragment.Append(hits[next], buffer.data() + (hits[next] - base));
+                ++next;
+            }
+            merged.Append(fragment.Finish());
+        }
+        ScanResultStore mergedStore = merged.Finish();
+
+        start = std::chrono::steady_clock::now();
+        size_t index = 0;
+        bool ok = store.Count() == hits.size() && mergedStore.Count() == hits.size();
+        for (const ScanResultStore::Entry& entry : store) {
+            if (index >= hits.size() || entry.address != hits[index] || memcmp(entry.value, &value, sizeof(int)) != 0) {
+                ok = false;
+                break;
+            }
+            ++index;
+        }
+        double iterateSeconds = Seconds(start);
+
+        index = 0;
+        for (const ScanResultStore::Entry& entry : mergedStore) {
+            if (index >= hits.size() || entry.address != hits[index]) {
+                ok = false;
+                break;
+            }
+            ++index;
+        }
+        // 조각 경계에 걸친 블록도 하나로 합쳐져야 함
+        ok &= mergedStore.BlockCount() == store.BlockCount();
+        for (uintptr_t block = base; block < base + buffer.size(); block += ScanResultStore::BlockSize) {
+            ok &= mergedStore.BlockHitCount(block) == store.BlockHitCount(block);
+        }
+
+        // vector<uintptr_t>(8) + map 노드(키 8 + vector 헤더 24 + 값 힙 할당 ~16 + 노드 오버헤드 ~32)
+        double legacyBytesPerHit = 8.0 + 8.0 + 24.0 + 16.0 + 32.0;
+        double bytesPerHit = hits.empty() ? 0.0 : static_cast<double>(store.MemoryUsage()) / hits.size();
+        printf("%-8s hits=%-10zu store=%8.2f MB  %.2f B/hit (legacy ~%.0f B/hit)  bitmap=%zu/%zu  build=%.3fs iterate=%.3fs%s\n",
+               name, hits.size(), store.MemoryUsage() / (1024.0 * 1024.0), bytesPerHit, legacyBytesPerHit,
+               store.BitmapBlockCount(), store.BlockCount(), buildSeconds, iterateSeconds, ok ? "" : "  MISMATCH");
+        return ok;
+    }
+
+    // 블록 하나를 반씩 채운 두 조각 (+ 같은 블록에 주소 하나 더)을 이어 붙이면 블록 하나여야 함
+    bool CheckSplitBlock() {
+        const uintptr_t base = 0x20000000;
+        const size_t half = ScanResultStore::BlockSize / 2;
+        ScanResultStore::Builder first(sizeof(int)), second(sizeof(int)), merged(sizeof(int));
+        for (uint32_t offset = 0; offset < half; offset += 4) first.Append(base + offset, &offset);
+        for (uint32_t offset = half; offset < ScanResultStore::BlockSize - 4; offset += 4) second.Append(base + offset, &offset);
+        merged.Append(first.Finish());
+        merged.Append(second.Finish());
+        uint32_t lastOffset = ScanResultStore::BlockSize - 4;
+        merged.Append(base + lastOffset, &lastOffset);
+        ScanResultStore store = merged.Finish();
+
+        const size_t expected = ScanResultStore::BlockSize / 4;
+        bool ok = store.Count() == expected && store.BlockCount() == 1 && store.BlockHitCount(base) == expected;
+        size_t index = 0;
+        for (const ScanResultStore::Entry& entry : store) {
+            int value;
+            memcpy(&value, entry.value, sizeof(int));
+            ok &= entry.address == base + index * 4 && static_cast<size_t>(value) == index * 4;
+            ++index;
+        }
+        printf("%-8s count=%zu blocks=%zu hits in block=%zu%s\n", "split", store.Count(), store.BlockCount(),
+               store.BlockHitCount(base), ok ? "" : "  MISMATCH");
+        return ok && index == expected;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    if (megabytes == 0) megabytes = 1;
+    printf("ScanResultStoreBench: %zu MB\n", megabytes);
+
+    std::mt19937_64 rng(42);
+    std::vector<uint8_t> buffer(megabytes * 1024 * 1024, 0);
+
+    // 빽빽한 경우: 대부분 0인 힙, 일부 구간만 랜덤
+    for (size_t i = 0; i < buffer.size(); i += 4096) {
+        if (rng() % 4 == 0) {
+            for (size_t j = 0; j < 4096 && i + j < buffer.size(); ++j) buffer[i + j] = static_cast<uint8_t>(rng());
+        }
+    }
+    bool ok = CheckSplitBlock();
+    ok &= BenchCase("dense", buffer, 0);
+
+    // 드문 경우: 랜덤 데이터에 값을 심음
+    for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = static_cast<uint8_t>(rng());
+    for (size_t n = 0; n < buffer.size() / 1024; ++n) {
+        int value = 100;
+        memcpy(buffer.data() + rng() % (buffer.size() - sizeof(int)), &value, sizeof(int));
+    }
+    ok &= BenchCase("sparse", buffer, 100);
+
+    if (!ok) {
+        printf("ERROR: store contents differ from scan results\n");
+        return 1;
+    }
+    return 0;
+}
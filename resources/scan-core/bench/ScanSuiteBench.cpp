@@ -0,0 +1,486 @@
+/*
+ * 스캐너 벤치마크 모음 (합성 메모리 이미지 + 녹화한 덤프, JSON 출력)
+ *
+ * 게임 없이 같은 스캔 코드의 성능을 재고 회귀를 추적하기 위한 벤치마크입니다.
+ * 이미지마다 다음 작업을 실제 스캔 코드(ScanExecutor, ScanResultStore, BatchReader, CompiledPattern,
+ * FindFloat, PointerMap/PointerScanner)로 실행합니다.
+ * - first-scan: int32 정확 값 스캔 → 압축 결과 저장소
+ * - next-scan:  후보 일괄 다시 읽기 + 변경 필터 (합성 이미지는 심은 값의 절반을 줄이고 "감소")
+ * - pattern:    실행 영역에서 "48 8B 05 ?? ?? ?? ?? 48 85 C0" 시그니처 검색
+ * - float-range: 쓰기 가능 영역에서 float 범위 스캔
+ * - pointer-scan: 역방향 포인터 맵 생성 + 목표까지의 경로 탐색
+ *
+ * 합성 이미지 (고정 시드, 항상 같은 내용):
+ * - zeros:  힙 전체가 0 (거의 비어 있는 커밋 메모리)
+ * - random: 균일한 무작위 바이트
+ * - floats: 위치/비율/체력 같은 float, 작은 정수, 힙 포인터가 섞인 게임 힙
+ * 모든 합성 이미지에 정수 값, float 값, 시그니처, 포인터 체인을 심고 모두 찾았는지 검증합니다 ("verified").
+ * 녹화한 덤프(MemoryDump::Save 형식 또는 SparseDump 형식, OpenDumpMemory로 엶)는 흔한 게임 값(int 100, float 100.0~101.0)으로
+ * 같은 작업을 실행하며 검증은 null, pointer-scan 목표는 첫 스캔의 첫 결과입니다.
+ *
+ * 결과는 표준 출력에 JSON 하나로, 사람이 읽을 요약은 표준 에러로 출력합니다.
+ * 작업마다 seconds(반복 중 최소), bytes(읽은 양), gbps, hits, peakRssBytes(작업 중 최대 RSS)를 기록합니다.
+ * Linux는 작업마다 최대 RSS를 초기화하고(/proc/self/clear_refs), 그 외에는 프로세스 전체 최대값입니다.
+ *
+ * 사용법: ScanSuiteBench [이미지 크기(MB), 기본 256, 0 = 합성 이미지 생략] [덤프 파일 ...] > results.json
+ */
+
+#include "../CompiledPattern.h"
+#include "../DirtyPageTracker.h"
+#include "../FloatScanKernels.h"
+#include "../DumpMemory.h"
+#include "../MemoryDump.h"
+#include "../PointerScanner.h"
+#include "../ScanExecutor.h"
+#include "../ScanKernels.h"
+#include "../ScanResultStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "Psapi.lib")
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t ModuleBase = 0x140000000;
+    const uintptr_t HeapBase = 0x200000000;
+    const size_t CodeSize = 1024 * 1024;
+    const size_t DataSize = 64 * 1024;
+    const size_t HeapRegionSize = 16 * 1024 * 1024;
+    const size_t PlantStride = 64 * 1024;      // 심는 값 하나당 힙 간격
+    const int Repeats = 3;
+
+    // 합성 이미지에 심는 값과 탐색 범위
+    const int32_t PlantedInt = 1234567;
+    const float PlantedFloat = 123.25f;
+    const float FloatLow = 123.0f;
+    const float FloatHigh = 123.5f;
+
+    // 녹화한 덤프 탐색 값 (체력/탄약 100, 100.0~101.0 같은 흔한 게임 값)
+    const int32_t DumpProbeInt = 100;
+    const float DumpProbeLow = 100.0f;
+    const float DumpProbeHigh = 101.0f;
+    const char* const Signature = "48 8B 05 ?? ?? ?? ?? 48 85 C0";
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 최대 RSS (바이트). 알 수 없으면 0
+    size_t PeakRss() {
+#if defined(__linux__)
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) return static_cast<size_t>(std::strtoull(line.c_str() + 6, nullptr, 10)) * 1024;
+        }
+        return 0;
+#elif defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters = {};
+        return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize : 0;
+#else
+        return 0;
+#endif
+    }
+
+    // 최대 RSS를 현재 RSS로 초기화 (Linux 4.0+). 안 되면 false
+    bool ResetPeakRss() {
+#if defined(__linux__)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+        return static_cast<bool>(clearRefs.flush());
+#else
+        return false;
+#endif
+    }
+
+    std::string JsonString(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+        return out + "\"";
+    }
+
+    struct Workload {
+        std::string name;
+        double seconds = 0.0;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t peakRss = 0;
+        int verified = -1;                                  // -1 = 검증 없음 (녹화한 덤프)
+        std::vector<std::pair<std::string, double>> extra;  // 작업별 추가 수치
+    };
+
+    struct Image {
+        std::string name;
+        std::string source;                 // "synthetic" 또는 덤프 경로
+        std::unique_ptr<IProcessMemory> memory;     // 합성 이미지는 MemoryDump, 덤프는 OpenDumpMemory()
+        size_t totalBytes = 0;
+        size_t regionCount = 0;
+        bool synthetic = false;
+        int32_t probeInt = DumpProbeInt;
+        float probeLow = DumpProbeLow;
+        float probeHigh = DumpProbeHigh;
+
+        // 합성 이미지에 심은 것 (검증용)
+        std::vector<uintptr_t> intAddresses;
+        std::vector<uintptr_t> floatAddresses;
+        std::vector<uintptr_t> signatureAddresses;
+        uintptr_t pointerTarget = 0;
+        size_t plantedChains = 0;
+    };
+
+    void FillHeap(const std::string& kind, std::vector<uint8_t>& data, uintptr_t base, size_t heapSize, std::mt19937_64& rng) {
+        if (kind == "zeros") return;
+        if (kind == "random") {
+            for (size_t i = 0; i < data.size(); i += 8) {
+                uint64_t value = rng();
+                memcpy(&data[i], &value, sizeof(value));
+            }
+            return;
+        }
+        // floats: 8바이트마다 float 두 개 / 작은 정수 / 힙 포인터 / 0
+        std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (size_t i = 0; i < data.size(); i += 8) {
+            uint64_t kindRoll = rng() % 100;
+            if (kindRoll < 40) {
+                float pair[2] = {position(rng), kindRoll < 20 ? unit(rng) : position(rng)};
+                memcpy(&data[i], pair, sizeof(pair));
+            } else if (kindRoll < 60) {
+                uint32_t pair[2] = {static_cast<uint32_t>(rng() % 1000), static_cast<uint32_t>(rng() % 100)};
+                memcpy(&data[i], pair, sizeof(pair));
+            } else if (kindRoll < 70) {
+                uint64_t pointer = HeapBase + (rng() % heapSize & ~uint64_t(7));
+                memcpy(&data[i], &pointer, sizeof(pointer));
+            }
+        }
+        (void)base;
+    }
+
+    Image BuildSyntheticImage(const std::string& kind, size_t megabytes, uint64_t seed) {
+        Image image;
+        image.name = kind;
+        image.source = "synthetic";
+        image.synthetic = true;
+        image.probeInt = PlantedInt;
+        image.probeLow = FloatLow;
+        image.probeHigh = FloatHigh;
+
+        std::mt19937_64 rng(seed);
+        size_t heapRegions = std::max<size_t>(1, megabytes * 1024 * 1024 / HeapRegionSize);
+        size_t heapSize = heapRegions * HeapRegionSize;
+        std::vector<std::vector<uint8_t>> heap(heapRegions, std::vector<uint8_t>(HeapRegionSize));
+        for (size_t r = 0; r < heapRegions; ++r) FillHeap(kind, heap[r], HeapBase + r * HeapRegionSize, heapSize, rng);
+
+        std::vector<uint8_t> code(CodeSize);
+        for (size_t i = 0; i < code.size(); i += 8) {
+            uint64_t value = rng();
+            memcpy(&code[i], &value, sizeof(value));
+        }
+        std::vector<uint8_t> data(DataSize);
+
+        auto heapAt = [&](uintptr_t address) { return &heap[(address - HeapBase) / HeapRegionSize][(address - HeapBase) % HeapRegionSize]; };
+
+        // 힙 슬롯마다 +0 정수, +16 float 심기
+        for (uintptr_t slot = HeapBase + 4096; slot + 64 <= HeapBase + heapSize; slot += PlantStride) {
+            memcpy(heapAt(slot), &PlantedInt, sizeof(PlantedInt));
+            memcpy(heapAt(slot + 16), &PlantedFloat, sizeof(PlantedFloat));
+            image.intAddresses.push_back(slot);
+            image.floatAddresses.push_back(slot + 16);
+        }
+
+        // 코드에 시그니처 64개
+        const uint8_t signatureBytes[] = {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0};
+        for (size_t n = 0; n < 64; ++n) {
+            size_t offset = (n + 1) * (CodeSize / 66);
+            memcpy(&code[offset], signatureBytes, sizeof(signatureBytes));
+            image.signatureAddresses.push_back(ModuleBase + offset);
+        }
+
+        // 모듈 .data → (힙 노드) → 목표 체인 깊이 1~3. 노드는 심은 값 슬롯 사이 (+32 이후)에 둠
+        image.pointerTarget = image.intAddresses[image.intAddresses.size() / 2];
+        for (size_t depth = 1; depth <= 3; ++depth) {
+            uintptr_t previous = ModuleBase + CodeSize + 0x100 * depth;
+            for (size_t level = 1; level <= depth; ++level) {
+                uintptr_t node = level == depth ? image.pointerTarget
+                                                : HeapBase + 4096 + (rng() % (heapSize / PlantStride - 1)) * PlantStride + 32 + 8 * level;
+                uint64_t offset = level == depth ? 0x40 : 0x18;
+                uint64_t pointer = node - offset;
+                if (previous >= HeapBase) memcpy(heapAt(previous), &pointer, sizeof(pointer));
+                else memcpy(&data[previous - ModuleBase - CodeSize], &pointer, sizeof(pointer));
+                previous = node;
+            }
+            ++image.plantedChains;
+        }
+
+        MemoryRegion codeRegion;
+        codeRegion.base = ModuleBase;
+        codeRegion.protection = MemoryRead | MemoryExecute;
+        codeRegion.type = MemoryRegionType::Image;
+        codeRegion.path = "C:\\Games\\game.exe";
+        auto dump = std::make_unique<MemoryDump>();
+        dump->AddRegion(codeRegion, std::move(code));
+
+        MemoryRegion dataRegion = codeRegion;
+        dataRegion.base = ModuleBase + CodeSize;
+        dataRegion.protection = MemoryRead | MemoryWrite;
+        dump->AddRegion(dataRegion, std::move(data));
+
+        for (size_t r = 0; r < heapRegions; ++r) {
+            MemoryRegion region;
+            region.base = HeapBase + r * HeapRegionSize;
+            region.protection = MemoryRead | MemoryWrite;
+            dump->AddRegion(region, std::move(heap[r]));
+        }
+        image.memory = std::move(dump);
+        return image;
+    }
+
+    bool ContainsAll(const std::vector<uintptr_t>& found, const std::vector<uintptr_t>& planted) {
+        for (uintptr_t address : planted) {
+            if (!std::binary_search(found.begin(), found.end(), address)) return false;
+        }
+        return true;
+    }
+
+    // 작업을 Repeats번 실행해 가장 짧은 시간을 기록하고, 실행 중 최대 RSS를 잼
+    template<typename Run>
+    Workload Measure(const std::string& name, Run run) {
+        Workload best;
+        bool reset = ResetPeakRss();
+        for (int repeat = 0; repeat < Repeats; ++repeat) {
+            Workload result;
+            result.name = name;
+            auto start = std::chrono::steady_clock::now();
+            run(result);
+            double seconds = Seconds(start);
+            if (repeat == 0 || seconds < best.seconds) {
+                best = result;
+                best.seconds = seconds;
+            }
+        }
+        best.peakRss = PeakRss();
+        (void)reset;
+        return best;
+    }
+
+    std::vector<Workload> RunWorkloads(Image& image) {
+        std::vector<Workload> workloads;
+        ScanExecutor executor;
+        auto readable = [](const MemoryRegion& region) { return region.IsReadable(); };
+        auto writable = [](const MemoryRegion& region) { return region.IsWritable(); };
+        auto executable = [](const MemoryRegion& region) { return region.IsExecutable(); };
+
+        // first-scan: 작업 단위마다 저장소 조각을 만들어 병합 (memory-scanner와 같은 경로)
+        ScanResultStore store;
+        int32_t probe = image.probeInt;
+        workloads.push_back(Measure("first-scan", [&](Workload& result) {
+            executor.SetOverlap(sizeof(int32_t) - 1);
+            std::vector<ScanResultStore> fragments = executor.RunUnits<ScanResultStore>(image.memory->CollectRanges(readable),
+                image.memory->MakeReadFunction(),
+                [probe](const uint8_t* data, size_t size, const ScanExecutor::WorkUnit& unit, ScanResultStore& fragment) {
+                    thread_local std::vector<uintptr_t> hits;
+                    hits.clear();
+                    FindExact<int32_t>(data, size, probe, unit.base, hits);
+                    ScanResultStore::Builder builder(sizeof(int32_t));
+                    for (uintptr_t address : hits) {
+                        if (address >= unit.base + unit.size) break;
+                        builder.Append(address, data + (address - unit.base));
+                    }
+                    fragment = builder.Finish();
+                });
+            ScanResultStore::Builder builder(sizeof(int32_t));
+            for (const ScanResultStore& fragment : fragments) builder.Append(fragment);
+            store = builder.Finish();
+            result.bytes = executor.GetLastStats().bytesScanned;
+            result.hits = store.Count();
+            result.extra = {{"resultBytes", static_cast<double>(store.MemoryUsage())}};
+        }));
+        if (image.synthetic) workloads.back().verified = ContainsAll(store.ToAddresses(), image.intAddresses);
+
+        // next-scan: 합성 이미지는 심은 값의 절반을 1 줄이고 "감소", 덤프는 그대로 "변경 없음"
+        std::vector<uintptr_t> decreased;
+        if (image.synthetic) {
+            for (size_t i = 0; i < image.intAddresses.size(); i += 2) {
+                image.memory->WriteValue<int32_t>(image.intAddresses[i], PlantedInt - 1);
+                decreased.push_back(image.intAddresses[i]);
+            }
+        }
+        ChangeFilter filter = image.synthetic ? ChangeFilter::Decreased : ChangeFilter::Unchanged;
+        ScanResultStore filtered;
+        workloads.push_back(Measure("next-scan", [&](Workload& result) {
+            BatchReader reader(image.memory->MakeBatchReadFunction());
+            filtered = FilterResultStore<int32_t>(store, filter, reader);
+            result.bytes = reader.GetLastStats().bytesRead;
+            result.hits = filtered.Count();
+            result.extra = {{"candidates", static_cast<double>(store.Count())}, {"runs", static_cast<double>(reader.GetLastStats().runs)}};
+        }));
+        if (image.synthetic) workloads.back().verified = filtered.ToAddresses() == decreased;
+        for (uintptr_t address : decreased) image.memory->WriteValue<int32_t>(address, PlantedInt);
+
+        // pattern
+        CompiledPattern pattern = CompiledPattern::Parse(Signature);
+        std::vector<uintptr_t> patternHits;
+        workloads.push_back(Measure("pattern", [&](Workload& result) {
+            executor.SetOverlap(pattern.Size() - 1);
+            patternHits = executor.Run(image.memory->CollectRanges(executable), image.memory->MakeReadFunction(),
+                [&pattern](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+                    pattern.FindAll(data, size, base, out);
+                });
+            result.bytes = executor.GetLastStats().bytesScanned;
+            result.hits = patternHits.size();
+        }));
+        if (image.synthetic) workloads.back().verified = ContainsAll(patternHits, image.signatureAddresses);
+
+        // float-range
+        FloatCondition<float> condition = FloatCondition<float>::Between(image.probeLow, image.probeHigh);
+        std::vector<uintptr_t> floatHits;
+        workloads.push_back(Measure("float-range", [&](Workload& result) {
+            executor.SetOverlap(sizeof(float) - 1);
+            floatHits = executor.Run(image.memory->CollectRanges(writable), image.memory->MakeReadFunction(),
+                [&condition](const uint8_t* data, size_t size, uintptr_t base, std::vector<uintptr_t>& out) {
+                    FindFloat(data, size, condition, base, out);
+                });
+            result.bytes = executor.GetLastStats().bytesScanned;
+            result.hits = floatHits.size();
+        }));
+        if (image.synthetic) workloads.back().verified = ContainsAll(floatHits, image.floatAddresses);
+
+        // pointer-scan: 목표는 심은 목표, 덤프는 첫 스캔의 첫 결과
+        uintptr_t target = image.synthetic ? image.pointerTarget : (store.Empty() ? 0 : store.ToAddresses(1).front());
+        if (target != 0) {
+            std::vector<PointerPath> paths;
+            workloads.push_back(Measure("pointer-scan", [&](Workload& result) {
+                PointerMap map;
+                map.Build(*image.memory);
+                PointerScanner scanner(map, PointerScanner::ModulesFromRegions(image.memory->EnumerateRegions()));
+                PointerScanConfig config;
+                config.maxDepth = 3;
+                config.maxOffset = 0x100;
+                paths = scanner.FindPaths(target, config);
+                result.bytes = map.ScannedBytes();
+                result.hits = paths.size();
+                result.extra = {{"mapSeconds", map.BuildSeconds()},
+                                {"mapEntries", static_cast<double>(map.EntryCount())},
+                                {"mapBytes", static_cast<double>(map.MemoryBytes())},
+                                {"pathSeconds", scanner.GetLastStats().seconds},
+                                {"pathsPerSecond", scanner.GetLastStats().PathsPerSecond()}};
+            }));
+            if (image.synthetic) {
+                size_t resolved = 0;
+                for (const PointerPath& path : paths) {
+                    uintptr_t address = 0;
+                    resolved += PointerScanner::Resolve(*image.memory, path.moduleBase, path, address) && address == target;
+                }
+                workloads.back().verified = paths.size() >= image.plantedChains && resolved == paths.size();
+            }
+        }
+        return workloads;
+    }
+
+    void PrintImageJson(const Image& image, const std::vector<Workload>& workloads, bool first) {
+        printf("%s    {\n      \"name\": %s,\n      \"source\": %s,\n      \"bytes\": %zu,\n      \"regions\": %zu,\n      \"workloads\": [\n",
+               first ? "" : ",\n", JsonString(image.name).c_str(), JsonString(image.source).c_str(), image.totalBytes, image.regionCount);
+        for (size_t w = 0; w < workloads.size(); ++w) {
+            const Workload& workload = workloads[w];
+            printf("        {\"name\": %s, \"seconds\": %.6f, \"bytes\": %zu, \"gbps\": %.3f, \"hits\": %zu, \"peakRssBytes\": %zu, \"verified\": %s",
+                   JsonString(workload.name).c_str(), workload.seconds, workload.bytes,
+                   workload.seconds > 0 ? workload.bytes / 1e9 / workload.seconds : 0.0, workload.hits, workload.peakRss,
+                   workload.verified < 0 ? "null" : (workload.verified ? "true" : "false"));
+            for (const auto& extra : workload.extra) printf(", %s: %.6g", JsonString(extra.first).c_str(), extra.second);
+            printf("}%s\n", w + 1 < workloads.size() ? "," : "");
+        }
+        printf("      ]\n    }");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    std::vector<std::string> dumps(argv + std::min(argc, 2), argv + argc);
+
+    // 이미지는 하나씩 만들고 측정한 뒤 버림 (RSS가 이미지 하나 크기를 넘지 않도록)
+    struct Source {
+        std::string kind;       // 합성 종류, 비어 있으면 덤프
+        std::string path;
+    };
+    std::vector<Source> sources;
+    if (megabytes > 0) {
+        for (const char* kind : {"zeros", "random", "floats"}) sources.push_back({kind, ""});
+    }
+    for (const std::string& path : dumps) sources.push_back({"", path});
+
+    fprintf(stderr, "ScanSuiteBench: %zu synthetic MB per image, %zu dumps, %s, %zu threads, peak RSS %s\n", megabytes,
+            dumps.size(), SimdLevelName(ActiveSimdLevel()), ScanExecutor().ResolveThreadCount(static_cast<size_t>(-1)),
+            ResetPeakRss() ? "per workload" : "process-wide");
+
+    printf("{\n  \"suite\": \"scan-core\",\n  \"version\": 1,\n  \"simd\": %s,\n  \"threads\": %zu,\n  \"repeats\": %d,\n  \"images\": [\n",
+           JsonString(SimdLevelName(ActiveSimdLevel())).c_str(), ScanExecutor().ResolveThreadCount(static_cast<size_t>(-1)), Repeats);
+
+    bool ok = true;
+    bool loaded = true;
+    size_t printed = 0;
+    for (size_t s = 0; s < sources.size(); ++s) {
+        Image image;
+        if (!sources[s].kind.empty()) {
+            image = BuildSyntheticImage(sources[s].kind, megabytes, 1000 + s);
+        } else {
+            image.name = sources[s].path.substr(sources[s].path.find_last_of("/\\") + 1);
+            image.source = sources[s].path;
+            image.memory = OpenDumpMemory(sources[s].path);
+            if (!image.memory) {
+                fprintf(stderr, "ERROR: failed to load dump %s\n", sources[s].path.c_str());
+                loaded = false;
+                continue;
+            }
+        }
+
+        for (const MemoryRegion& region : image.memory->EnumerateRegions()) {
+            image.totalBytes += region.size;
+            ++image.regionCount;
+        }
+
+        std::vector<Workload> workloads = RunWorkloads(image);
+        fprintf(stderr, "[%s] %.1f MB in %zu regions\n", image.name.c_str(), image.totalBytes / 1048576.0, image.regionCount);
+        for (const Workload& workload : workloads) {
+            fprintf(stderr, "  %-12s %8.4f s  %7.2f GB/s  hits=%-8zu peak RSS %6.1f MB%s\n", workload.name.c_str(), workload.seconds,
+                    workload.seconds > 0 ? workload.bytes / 1e9 / workload.seconds : 0.0, workload.hits, workload.peakRss / 1048576.0,
+                    workload.verified == 0 ? "  NOT VERIFIED" : "");
+            ok &= workload.verified != 0;
+        }
+        PrintImageJson(image, workloads, printed++ == 0);
+    }
+    printf("\n  ]\n}\n");
+
+    if (!loaded) return 1;
+    if (!ok) {
+        fprintf(stderr, "ERROR: some workloads did not find the planted data\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * 시그니처 해석 캐시 벤치마크 (첫 연결 대비 재연결)
+ *
+ * PE 헤더, 실행 영역(.text), 데이터 영역으로 된 합성 모듈을 MemoryDump에 만들고 시그니처 N개를 심습니다.
+ * - 첫 연결: 모듈 전체를 SignatureSet으로 스캔하고 결과를 캐시에 저장, 파일로 저장
+ * - 재연결: 파일을 불러와 Lookup만 (읽기 횟수 = 지문 + 항목당 1회)
+ * - 코드 패치: 일부 시그니처 바이트를 바꾸면 그 항목만 무효화되어 다시 스캔
+ * - 새 빌드: TimeDateStamp가 바뀌면 모든 항목이 miss
+ *
+ * 사용법: SignatureCacheBench [코드 크기(MB), 기본 64] [시그니처 수, 기본 100]
+ */
+
+#include "../SignatureCache.h"
+#include "../SignatureSet.h"
+#include "../MemoryDump.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 읽기 호출 수를 세는 래퍼
+    class CountingMemory : public IProcessMemory {
+    public:
+        explicit CountingMemory(IProcessMemory& inner) : inner(inner) {}
+        std::vector<MemoryRegion> EnumerateRegions() override { return inner.EnumerateRegions(); }
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override { return inner.QueryRegion(address, result); }
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            reads.fetch_add(1, std::memory_order_relaxed);
+            return inner.ReadBytes(address, buffer, size, bytesRead);
+        }
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            return inner.WriteBytes(address, data, size, bytesWritten);
+        }
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            return inner.Protect(address, size, protection, oldProtection);
+        }
+        std::atomic<size_t> reads{0};
+
+    private:
+        IProcessMemory& inner;
+    };
+
+    const uintptr_t ModuleBase = 0x7FF600000000;
+    const size_t HeaderSize = 0x1000;
+    const size_t TargetOffset = 3;      // 시그니처 시작 + 3 = 해석된 주소 (RIP 상대 변위 자리 등)
+
+    struct World {
+        MemoryDump dump;
+        size_t codeSize;
+        std::vector<std::vector<uint8_t>> signatures;
+        std::vector<uintptr_t> planted;
+    };
+
+    void MakeModule(World& world, size_t codeSize, size_t count, uint32_t timeDateStamp) {
+        std::mt19937_64 rng(11);
+        std::vector<uint8_t> header(HeaderSize, 0);
+        header[0] = 'M';
+        header[1] = 'Z';
+        uint32_t pe = 0x80;
+        memcpy(&header[0x3C], &pe, 4);
+        memcpy(&header[pe], "PE\0\0", 4);
+        uint16_t sections = 2, optionalSize = 0xF0;
+        memcpy(&header[pe + 4 + 2], &sections, 2);
+        memcpy(&header[pe + 4 + 4], &timeDateStamp, 4);
+        memcpy(&header[pe + 4 + 16], &optionalSize, 2);
+        uint32_t sizeOfImage = static_cast<uint32_t>(HeaderSize + codeSize + 0x10000);
+        memcpy(&header[pe + 24 + 56], &sizeOfImage, 4);
+        uint64_t imageBase = ModuleBase;    // 로드 위치: 지문에 포함되지 않아야 함
+        memcpy(&header[pe + 24 + 24], &imageBase, 8);
+
+        std::vector<uint8_t> code(codeSize);
+        for (size_t i = 0; i < codeSize; i += 8) {
+            uint64_t r = rng();
+            memcpy(&code[i], &r, 8);
+        }
+        world.codeSize = codeSize;
+        world.signatures.assign(count, std::vector<uint8_t>(16));
+        world.planted.clear();
+        for (size_t n = 0; n < count; ++n) {
+            for (uint8_t& byte : world.signatures[n]) byte = static_cast<uint8_t>(rng());
+            size_t at = (n + 1) * (codeSize / (count + 2)) + rng() % 4096;
+            memcpy(&code[at], world.signatures[n].data(), 16);
+            world.planted.push_back(ModuleBase + HeaderSize + at);
+        }
+
+        world.dump.Clear();
+        MemoryRegion region;
+        region.type = MemoryRegionType::Image;
+        region.path = "/games/game.exe";
+        region.base = ModuleBase;
+        region.protection = MemoryRead;
+        world.dump.AddRegion(region, header);
+        region.base = ModuleBase + HeaderSize;
+        region.protection = MemoryRead | MemoryExecute;
+        world.dump.AddRegion(region, code);
+        region.base = ModuleBase + HeaderSize + codeSize;
+        region.protection = MemoryRead | MemoryWrite;
+        world.dump.AddRegion(region, std::vector<uint8_t>(0x10000, 0));
+    }
+
+    // 아직 캐시에 없는 시그니처만 스캔해 저장. 찾은 개수 반환
+    size_t ScanAndStore(World& world, IProcessMemory& memory, const std::vector<ModuleRange>& modules, SignatureCache& cache,
+                        const std::vector<uint32_t>& ids) {
+        SignatureSet set;
+        for (uint32_t id : ids) set.Add(world.signatures[id]);
+        set.Build();
+        std::vector<uint8_t> code(world.codeSize);
+        size_t bytesRead = 0;
+        memory.ReadBytes(ModuleBase + HeaderSize, code.data(), code.size(), bytesRead);
+        std::vector<SignatureMatch> matches;
+        set.FindAll(code.data(), bytesRead, ModuleBase + HeaderSize, matches);
+        size_t found = 0;
+        for (const SignatureMatch& match : matches) {
+            found += cache.Store(memory, modules, "sig" + std::to_string(ids[match.id]), match.address + TargetOffset,
+                                 match.address, world.signatures[ids[match.id]].size());
+        }
+        return found;
+    }
+
+    // 모든 시그니처를 캐시에서 찾고 miss만 다시 스캔. (hit 수, 지문/검증 읽기 수)
+    void Attach(World& world, SignatureCache& cache, const std::string& cachePath, const char* label, size_t expectedHits, bool& ok) {
+        CountingMemory memory(world.dump);
+        auto start = std::chrono::steady_clock::now();
+        cache.Load(cachePath);
+        cache.ResetStats();
+        std::vector<ModuleRange> modules = memory.EnumerateModules();
+
+        std::vector<uint32_t> missing;
+        size_t correct = 0;
+        for (uint32_t id = 0; id < world.signatures.size(); ++id) {
+            uintptr_t address = 0;
+            if (cache.Lookup(memory, modules, "sig" + std::to_string(id), address)) {
+                correct += address == world.planted[id] + TargetOffset;
+            } else {
+                missing.push_back(id);
+            }
+        }
+        size_t lookupReads = memory.reads.load();
+        double lookupSeconds = Seconds(start);
+        SignatureCache::Stats stats = cache.GetStats();
+
+        size_t rescanned = missing.empty() ? 0 : ScanAndStore(world, memory, modules, cache, missing);
+        cache.Save(cachePath);
+        double totalSeconds = Seconds(start);
+
+        printf("%-12s %8.4f s %8.4f s %6zu %6zu %6zu %8zu %8zu\n", label, lookupSeconds, totalSeconds, stats.hits, stats.misses,
+               stats.invalidated, lookupReads, rescanned);
+        ok &= stats.hits == expectedHits && correct == expectedHits && rescanned == missing.size();
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 64;
+    size_t count = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 100;
+    if (megabytes == 0) megabytes = 1;
+    if (count == 0) count = 1;
+
+    printf("SignatureCacheBench: %zu MB code, %zu signatures\n", megabytes, count);
+    const std::string cachePath = "SignatureCacheBench.cache";
+    std::remove(cachePath.c_str());
+
+    World world;
+    MakeModule(world, megabytes * 1024 * 1024, count, 0x5F000000);
+    SignatureCache cache;
+    bool ok = true;
+
+    printf("%-12s %10s %10s %6s %6s %6s %8s %8s\n", "attach", "lookup", "total", "hits", "misses", "inval", "reads", "rescan");
+    Attach(world, cache, cachePath, "cold", 0, ok);
+    Attach(world, cache, cachePath, "warm", count, ok);
+
+    // 코드 패치: 앞의 5개 시그니처 바이트를 바꾸면 그 항목만 무효화되고 다시 스캔 (새 바이트로 저장)
+    size_t patched = std::min<size_t>(5, count);
+    for (size_t n = 0; n < patched; ++n) {
+        world.signatures[n][15] ^= 0xFF;
+        uint8_t byte = world.signatures[n][15];
+        world.dump.WriteValue(world.planted[n] + 15, byte);
+    }
+    Attach(world, cache, cachePath, "patched", count - patched, ok);
+    Attach(world, cache, cachePath, "warm again", count, ok);
+
+    // 새 빌드: 헤더의 TimeDateStamp만 바뀌어도 모두 miss
+    MakeModule(world, megabytes * 1024 * 1024, count, 0x5F000001);
+    Attach(world, cache, cachePath, "new build", 0, ok);
+    Attach(world, cache, cachePath, "warm again", count, ok);
+
+    std::remove(cachePath.c_str());
+    if (!ok) {
+        printf("ERROR: cache hits/invalidations are wrong\n");
+        return 1;
+    }
+    return 0;
+}
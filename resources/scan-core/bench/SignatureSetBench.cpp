@@ -0,0 +1,140 @@
+/*
+ * 다중 시그니처 단일 패스 검색 벤치마크
+ *
+ * x64 코드와 비슷한 합성 버퍼에 무작위 와일드카드 시그니처 10 / 100 / 1000개를 심고 전체를 찾는 시간을 측정합니다.
+ * - 기존 방식: 시그니처마다 버퍼 전체를 다시 검색 (CompiledPattern::FindAll을 시그니처 수만큼)
+ * - SignatureSet: 오토마톤 하나로 한 번만 검색
+ * 두 결과가 같은지, 겹치게 나눈 청크(reportFrom 사용)에서도 중복/누락이 없는지 검증합니다.
+ *
+ * 사용법: SignatureSetBench [버퍼 크기(MB), 기본 128]
+ */
+
+#include "../SignatureSet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool Less(const SignatureMatch& a, const SignatureMatch& b) {
+        return a.address != b.address ? a.address < b.address : a.id < b.id;
+    }
+
+    bool Same(std::vector<SignatureMatch> a, std::vector<SignatureMatch> b) {
+        std::sort(a.begin(), a.end(), Less);
+        std::sort(b.begin(), b.end(), Less);
+        if (a.size() != b.size()) return false;
+        for (size_t n = 0; n < a.size(); ++n) {
+            if (a[n].id != b[n].id || a[n].address != b[n].address) return false;
+        }
+        return true;
+    }
+
+    // 8~24바이트, 흔한 opcode 바이트 위주, 4바이트 변위 자리 등 와일드카드 포함
+    void RandomSignature(std::mt19937_64& rng, std::vector<uint8_t>& bytes, std::vector<bool>& mask) {
+        static const uint8_t common[] = {0x48, 0x8B, 0x89, 0x0F, 0x05, 0x0D, 0x85, 0xC0, 0xE8, 0x83, 0xF3, 0x10, 0x11, 0x74};
+        size_t length = 8 + rng() % 17;
+        bytes.assign(length, 0);
+        mask.assign(length, true);
+        for (size_t j = 0; j < length; ++j) {
+            uint64_t r = rng();
+            bytes[j] = r % 3 == 0 ? static_cast<uint8_t>(r >> 8) : common[(r >> 8) % sizeof(common)];
+        }
+        // 첫 바이트와 마지막 바이트는 고정, 중간에 와일드카드 구간 0~2개
+        for (size_t gaps = rng() % 3; gaps > 0; --gaps) {
+            size_t at = 1 + rng() % (length - 2);
+            for (size_t j = at; j < std::min(length - 1, at + 1 + rng() % 4); ++j) mask[j] = false;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 128;
+    if (megabytes == 0) megabytes = 1;
+
+    printf("SignatureSetBench: %zu MB, detected %s\n", megabytes, SimdLevelName(ActiveSimdLevel()));
+
+    std::mt19937_64 rng(1234);
+    const uint8_t common[] = {0x48, 0x8B, 0x89, 0x0F, 0x01, 0x24, 0x4C, 0x44, 0x8D, 0xE8, 0x85, 0xC0, 0x83, 0xCC, 0xFF, 0x05};
+    std::vector<uint8_t> buffer(megabytes * 1024 * 1024);
+    for (size_t i = 0; i < buffer.size(); i += 8) {
+        uint64_t r = rng();
+        for (size_t k = 0; k < 8 && i + k < buffer.size(); ++k, r >>= 8) {
+            buffer[i + k] = (r & 0x80) ? common[r % sizeof(common)] : static_cast<uint8_t>(r >> 1);
+        }
+    }
+
+    // 1000개를 만들어 두고 앞에서부터 10 / 100 / 1000개 사용. 시그니처마다 4번 심음 (나중 것이 덮어쓸 수 있음)
+    std::vector<std::vector<uint8_t>> signatureBytes(1000);
+    std::vector<std::vector<bool>> signatureMasks(1000);
+    for (size_t n = 0; n < signatureBytes.size(); ++n) {
+        RandomSignature(rng, signatureBytes[n], signatureMasks[n]);
+        for (int copy = 0; copy < 4; ++copy) {
+            size_t at = rng() % (buffer.size() - 32);
+            for (size_t j = 0; j < signatureBytes[n].size(); ++j) {
+                if (signatureMasks[n][j]) buffer[at + j] = signatureBytes[n][j];
+            }
+        }
+    }
+
+    printf("%-6s %12s %12s %10s %9s %10s %s\n", "sigs", "per-sig(s)", "set(s)", "GB/s", "states", "table KB", "matches");
+    bool ok = true;
+    for (size_t count : {10, 100, 1000}) {
+        SignatureSet signatures;
+        std::vector<CompiledPattern> compiled;
+        for (size_t n = 0; n < count; ++n) {
+            signatures.Add(signatureBytes[n], signatureMasks[n]);
+            compiled.emplace_back(signatureBytes[n], signatureMasks[n]);
+        }
+        signatures.Build();
+
+        // 기존 방식: 시그니처마다 한 번씩
+        std::vector<SignatureMatch> expected;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t id = 0; id < compiled.size(); ++id) {
+            std::vector<uintptr_t> hits;
+            compiled[id].FindAll(buffer.data(), buffer.size(), 0, hits);
+            for (uintptr_t address : hits) expected.push_back(SignatureMatch{id, address});
+        }
+        double perSignature = Seconds(start);
+
+        std::vector<SignatureMatch> matches;
+        start = std::chrono::steady_clock::now();
+        signatures.FindAll(buffer.data(), buffer.size(), 0, matches);
+        double single = Seconds(start);
+
+        // 1MB 청크, overlap = 최대 길이 - 1, 앞 청크 끝 주소를 reportFrom으로 넘김
+        std::vector<SignatureMatch> chunked;
+        const size_t chunkSize = 1024 * 1024;
+        const size_t overlap = signatures.MaxLength() - 1;
+        uintptr_t seenEnd = 0;
+        for (size_t offset = 0; offset < buffer.size(); offset += chunkSize) {
+            size_t carry = std::min(offset, overlap);
+            size_t size = std::min(chunkSize, buffer.size() - offset) + carry;
+            signatures.FindAll(buffer.data() + offset - carry, size, offset - carry, chunked, seenEnd);
+            seenEnd = offset - carry + size;
+        }
+
+        bool match = Same(expected, matches) && Same(expected, chunked) && expected.size() >= count;
+        ok &= match;
+        printf("%-6zu %12.3f %12.3f %10.2f %9zu %10zu %zu%s\n", count, perSignature, single, buffer.size() / 1e9 / single,
+               signatures.StateCount(), signatures.TableBytes() / 1024, matches.size(), match ? "" : "  MISMATCH");
+    }
+
+    if (!ok) {
+        printf("ERROR: single-pass results differ from per-signature scans\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * 스냅샷 diff 벤치마크 (값 단위 "변경됨" 필터 대비 페이지 해시 diff)
+ *
+ * 게임 힙을 흉내 낸 합성 이미지(고정 시드)를 "행동 전"으로 만들고, 복사본에 행동 하나를 흉내 낸 변경을 심어 "행동 후"로 씁니다.
+ * - 97번째 객체마다 위치 x += 1.5, 체력 -= 10 (float), 탄약 -= 1 (int)
+ * - 193번째 객체마다 다음 객체 포인터를 다른 객체로 바꿈
+ * - 389번째 객체마다 빈 칸(+32)에 분류할 수 없는 값
+ * 비교하는 방법:
+ * - SnapshotScanner<int> "변경됨": 지금의 값 단위 워크플로 (전체 스냅샷 복사 후 4바이트 슬롯마다 비교)
+ * - SnapshotDiff::Run: 양쪽 페이지 해시 → 바뀐 페이지 → 바뀐 바이트 구간 + 값 분류
+ * 심은 변경이 모두 맞는 종류로, 그 외의 값 없이 분류되었는지 검증하고 8GB 스냅샷 두 개의 예상 시간을 출력합니다.
+ * 마지막으로 같은 두 이미지를 희소 덤프로 저장해 OpenDumpMemory로 열어도 같은 결과인지 확인합니다.
+ *
+ * 사용법: SnapshotDiffBench [이미지 크기(MB), 기본 256]
+ */
+
+#include "../DumpMemory.h"
+#include "../SnapshotDiff.h"
+#include "../SnapshotScanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t HeapBase = 0x200000000;
+    const size_t RegionSize = 8 * 1024 * 1024;
+    const size_t ObjectSize = 64;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double MB(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+    struct Planted {
+        std::map<uintptr_t, ChangeKind> changes;
+    };
+
+    // 짝수 영역: 게임 객체 힙 (위치 float 3개, 체력, 탄약, 플래그, 다음 객체 포인터), 홀수 영역: 대부분 0인 힙
+    MemoryDump MakeImage(size_t regionCount) {
+        MemoryDump dump;
+        std::mt19937_64 rng(22);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        for (size_t r = 0; r < regionCount; ++r) {
+            uintptr_t base = HeapBase + r * (RegionSize + 64 * 1024);
+            std::vector<uint8_t> data(RegionSize, 0);
+            if (r % 2 == 0) {
+                for (size_t offset = 0; offset + ObjectSize <= RegionSize; offset += ObjectSize) {
+                    uint8_t* object = data.data() + offset;
+                    float values[4] = {position(rng), position(rng), position(rng), 100.0f};
+                    int32_t ammo = static_cast<int32_t>(rng() % 120);
+                    uint32_t flags = 0x00010001;
+                    uint64_t next = base + (offset + ObjectSize * (1 + rng() % 8)) % RegionSize;
+                    memcpy(object, values, sizeof(values));
+                    memcpy(object + 16, &ammo, sizeof(ammo));
+                    memcpy(object + 20, &flags, sizeof(flags));
+                    memcpy(object + 24, &next, sizeof(next));
+                }
+            } else {
+                for (size_t block = 0; block < RegionSize; block += 64 * 1024) {
+                    size_t page = block + (rng() % 16) * 4096;
+                    for (size_t i = 0; i < 4096; i += 4) {
+                        uint32_t value = static_cast<uint32_t>(rng() % 1000);
+                        memcpy(data.data() + page + i, &value, sizeof(value));
+                    }
+                }
+            }
+            MemoryRegion region;
+            region.base = base;
+            region.protection = MemoryRead | MemoryWrite;
+            dump.AddRegion(region, std::move(data));
+        }
+        return dump;
+    }
+
+    // 객체 힙에 행동 하나를 흉내 낸 변경을 심고, 심은 주소와 종류를 기록
+    Planted ApplyAction(MemoryDump& dump) {
+        Planted planted;
+        std::mt19937_64 rng(23);
+        size_t index = 0;
+        for (const MemoryRegion& region : dump.EnumerateRegions()) {
+            if ((region.base - HeapBase) / (RegionSize + 64 * 1024) % 2 != 0) continue;
+            for (uintptr_t object = region.base; object + ObjectSize <= region.base + region.size; object += ObjectSize, ++index) {
+                if (index % 97 == 0) {
+                    float x = 0.0f, health = 0.0f;
+                    int32_t ammo = 0;
+                    dump.ReadValue(object, x);
+                    dump.ReadValue(object + 12, health);
+                    dump.ReadValue(object + 16, ammo);
+                    dump.WriteValue(object, x + 1.5f);
+                    dump.WriteValue(object + 12, health - 10.0f);
+                    dump.WriteValue(object + 16, ammo - 1);
+                    planted.changes[object] = ChangeKind::FloatDelta;
+                    planted.changes[object + 12] = ChangeKind::FloatDelta;
+                    planted.changes[object + 16] = ChangeKind::IntIncrement;
+                }
+                if (index % 193 == 0) {
+                    uint64_t next = region.base + (rng() % (region.size / ObjectSize)) * ObjectSize;
+                    uint64_t old = 0;
+                    dump.ReadValue(object + 24, old);
+                    if (next == old) next = region.base + ((next - region.base + ObjectSize) % region.size);
+                    dump.WriteValue(object + 24, next);
+                    planted.changes[object + 24] = ChangeKind::PointerSwap;
+                }
+                if (index % 389 == 0) {
+                    // float 지수 0xFE, 정수로는 2^30 이상 → 어느 쪽으로도 그럴듯하지 않은 값
+                    uint32_t garbage = 0x7F000000u | static_cast<uint32_t>(rng() & 0x00FFFFFF);
+                    dump.WriteValue(object + 32, garbage);
+                    planted.changes[object + 32] = ChangeKind::Other;
+                }
+            }
+        }
+        return planted;
+    }
+
+    // 분류 결과가 심은 변경과 정확히 같으면 0, 아니면 틀린 수
+    size_t CountWrong(const SnapshotDiffResult& result, const Planted& planted) {
+        size_t wrong = 0;
+        for (const ValueChange& change : result.values) {
+            auto it = planted.changes.find(change.address);
+            wrong += it == planted.changes.end() || it->second != change.kind;
+        }
+        if (result.values.size() < planted.changes.size()) wrong += planted.changes.size() - result.values.size();
+        return wrong;
+    }
+
+    void PrintResult(const char* name, const SnapshotDiffResult& result, size_t wrong) {
+        const SnapshotDiffResult::Stats& stats = result.stats;
+        double total = stats.hashSeconds + stats.diffSeconds;
+        printf("  %-18s hash %.3fs (%.2f GB/s)  diff %.3fs  total %.3fs  pages changed %zu/%zu  ranges %zu  bytes %zu\n", name,
+               stats.hashSeconds, stats.bytesHashed / 1e9 / std::max(stats.hashSeconds, 1e-9), stats.diffSeconds, total,
+               stats.pagesChanged, stats.pagesBefore, result.ranges.size(), stats.bytesChanged);
+        printf("  %-18s float delta %zu, int increment %zu, pointer swap %zu, other %zu, wrong=%zu\n", "", stats.ValueCount(ChangeKind::FloatDelta),
+               stats.ValueCount(ChangeKind::IntIncrement), stats.ValueCount(ChangeKind::PointerSwap), stats.ValueCount(ChangeKind::Other), wrong);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    size_t regionCount = std::max<size_t>(2, megabytes * 1024 * 1024 / RegionSize);
+    bool ok = true;
+
+    auto start = std::chrono::steady_clock::now();
+    MemoryDump before = MakeImage(regionCount);
+    MemoryDump after = MakeImage(regionCount);
+    Planted planted = ApplyAction(after);
+    printf("SnapshotDiffBench: 2 x %.0f MB, %zu planted changes (built in %.2fs)\n", MB(before.TotalSize()), planted.changes.size(),
+           Seconds(start));
+    auto writable = [](const MemoryRegion& region) { return region.IsWritable(); };
+
+    // 값 단위: 전체 스냅샷 후 "변경됨" (4바이트 정렬 슬롯)
+    {
+        start = std::chrono::steady_clock::now();
+        SnapshotScanner<int> snapshot;
+        snapshot.Capture(before.CollectRanges(writable), before.MakeReadFunction());
+        double captureSeconds = Seconds(start);
+        start = std::chrono::steady_clock::now();
+        snapshot.Filter(ChangeFilter::Changed, after.MakeReadFunction());
+        double filterSeconds = Seconds(start);
+        printf("  %-18s capture %.3fs  filter %.3fs  total %.3fs  candidates %zu (no ranges, no classification)\n", "snapshot changed",
+               captureSeconds, filterSeconds, captureSeconds + filterSeconds, snapshot.CandidateCount());
+    }
+
+    SnapshotDiff diff;
+    SnapshotDiffResult result = diff.Run(before, after, writable);
+    size_t wrong = CountWrong(result, planted);
+    PrintResult("page-hash diff", result, wrong);
+    ok &= wrong == 0;
+
+    double total = result.stats.hashSeconds + result.stats.diffSeconds;
+    printf("  %-18s about %.1fs for two 8 GB snapshots with %zu threads at this change density\n", "estimate",
+           total * (8.0 * 1024 * 1024 * 1024) / before.TotalSize(), diff.GetExecutor().ResolveThreadCount(static_cast<size_t>(-1)));
+
+    // 희소 덤프 두 개 (오프라인 비교)
+    const char* beforePath = "SnapshotDiffBench.before.scsd";
+    const char* afterPath = "SnapshotDiffBench.after.scsd";
+    ok &= SparseDumpFile::Write(beforePath, before, writable) && SparseDumpFile::Write(afterPath, after, writable);
+    {
+        std::unique_ptr<IProcessMemory> beforeDump = OpenDumpMemory(beforePath);
+        std::unique_ptr<IProcessMemory> afterDump = OpenDumpMemory(afterPath);
+        if (beforeDump && afterDump) {
+            SnapshotDiffResult offline = diff.Run(*beforeDump, *afterDump, writable);
+            size_t offlineWrong = CountWrong(offline, planted);
+            PrintResult("sparse dumps", offline, offlineWrong);
+            ok &= offlineWrong == 0 && offline.ranges.size() == result.ranges.size();
+        } else {
+            ok = false;
+        }
+    }
+    std::remove(beforePath);
+    std::remove(afterPath);
+
+    if (!ok) {
+        printf("ERROR: diff did not classify the planted changes exactly\n");
+        return 1;
+    }
+    return 0;
+}
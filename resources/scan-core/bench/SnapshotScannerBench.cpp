@@ -0,0 +1,134 @@
+/*
+ * 알 수 없는 초기값 스냅샷 스캔 벤치마크
+ *
+ * 절반은 0인 합성 힙을 캡처한 뒤, 일부 int 값을 바꿔 가며 증가/변경 없음/감소/변경 필터를 실행합니다.
+ * 필터별 시간, 남은 페이지/후보 수, 스냅샷 메모리 사용량을 출력하고,
+ * 남은 후보가 슬롯별 전수 비교 결과와 같은지 검증합니다.
+ *
+ * 사용법: SnapshotScannerBench [힙 크기(MB), 기본 128]
+ */
+
+#include "../SnapshotScanner.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t HeapBase = 0x10000000;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    int LoadInt(const std::vector<uint8_t>& heap, size_t offset) {
+        int value;
+        memcpy(&value, heap.data() + offset, sizeof(int));
+        return value;
+    }
+
+    // 슬롯별 전수 비교 (기준 결과)
+    void ReferenceFilter(std::vector<uint8_t>& alive, const std::vector<uint8_t>& before,
+                         const std::vector<uint8_t>& after, ChangeFilter filter) {
+        for (size_t slot = 0; slot < alive.size(); ++slot) {
+            if (alive[slot] && !PassesChangeFilter(filter, LoadInt(after, slot * 4), LoadInt(before, slot * 4))) {
+                alive[slot] = 0;
+            }
+        }
+    }
+
+    bool Verify(const SnapshotScanner<int>& scanner, const std::vector<uint8_t>& alive, const std::vector<uint8_t>& heap) {
+        size_t expected = 0;
+        for (uint8_t flag : alive) expected += flag;
+        if (scanner.CandidateCount() != expected) return false;
+
+        ScanResultStore store = scanner.ToResultStore();
+        size_t slot = 0;
+        for (const ScanResultStore::Entry& entry : store) {
+            while (slot < alive.size() && !alive[slot]) ++slot;
+            if (slot >= alive.size() || entry.address != HeapBase + slot * 4 ||
+                memcmp(entry.value, heap.data() + slot * 4, sizeof(int)) != 0) {
+                return false;
+            }
+            ++slot;
+        }
+        return store.Count() == expected;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 128;
+    if (megabytes == 0) megabytes = 1;
+    printf("SnapshotScannerBench: %zu MB\n", megabytes);
+
+    std::mt19937_64 rng(99);
+    std::vector<uint8_t> heap(megabytes * 1024 * 1024, 0);
+    for (size_t page = 0; page < heap.size(); page += 4096) {
+        if (rng() % 2 == 0) {
+            for (size_t i = 0; i < 4096; ++i) heap[page + i] = static_cast<uint8_t>(rng() % 8);
+        }
+    }
+
+    auto read = [&heap](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+        if (address < HeapBase || address - HeapBase >= heap.size()) return false;
+        bytesRead = std::min(size, heap.size() - (address - HeapBase));
+        memcpy(buffer, heap.data() + (address - HeapBase), bytesRead);
+        return true;
+    };
+
+    SnapshotScanner<int> scanner;
+    std::vector<uint8_t> alive(heap.size() / 4, 1);
+
+    auto start = std::chrono::steady_clock::now();
+    scanner.Capture({{HeapBase, heap.size()}}, read);
+    printf("%-10s %8.3fs  pages=%-8zu candidates=%-10zu snapshot=%8.2f MB\n", "capture", Seconds(start),
+           scanner.PageCount(), scanner.CandidateCount(), scanner.MemoryUsage() / (1024.0 * 1024.0));
+    bool ok = Verify(scanner, alive, heap);
+
+    struct Pass {
+        const char* name;
+        ChangeFilter filter;
+        int delta;          // 바꿀 값에 더할 양 (0이면 메모리 그대로)
+        size_t changes;     // 바꿀 값 개수
+    };
+    const Pass passes[] = {
+        {"increased", ChangeFilter::Increased, 1, heap.size() / 4096},
+        {"unchanged", ChangeFilter::Unchanged, 0, 0},
+        {"decreased", ChangeFilter::Decreased, -1, heap.size() / 4096},
+        {"changed", ChangeFilter::Changed, 5, heap.size() / 64},
+    };
+
+    for (const Pass& pass : passes) {
+        std::vector<uint8_t> before = heap;
+        if (pass.delta != 0) {
+            for (size_t n = 0; n < pass.changes; ++n) {
+                size_t offset = (rng() % (heap.size() / 4)) * 4;
+                int value = LoadInt(heap, offset) + pass.delta;
+                memcpy(heap.data() + offset, &value, sizeof(int));
+            }
+        }
+
+        start = std::chrono::steady_clock::now();
+        scanner.Filter(pass.filter, read);
+        double seconds = Seconds(start);
+
+        ReferenceFilter(alive, before, heap, pass.filter);
+        bool passOk = Verify(scanner, alive, heap);
+        ok &= passOk;
+        printf("%-10s %8.3fs  pages=%-8zu candidates=%-10zu snapshot=%8.2f MB%s\n", pass.name, seconds,
+               scanner.PageCount(), scanner.CandidateCount(), scanner.MemoryUsage() / (1024.0 * 1024.0),
+               passOk ? "" : "  MISMATCH");
+    }
+
+    if (!ok) {
+        printf("ERROR: snapshot candidates differ from reference\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * 희소 압축 덤프 벤치마크 (MemoryDump::Save 원본 덤프 대비 SparseDumpFile)
+ *
+ * 게임 프로세스를 흉내 낸 합성 이미지(고정 시드)를 두 형식으로 저장하고 비교합니다.
+ * - 영역 구성: 모듈 코드(반복이 많은 명령 바이트), 대부분 0인 힙(커밋만 하고 안 쓴 페이지),
+ *              float/정수/포인터가 섞인 게임 객체 힙, 압축되지 않는 무작위 데이터(텍스처 등)
+ * - 파일 크기, 쓰기 시간 (스레드 1개 / 전체), 블록 코덱 처리량
+ * - 첫 읽기까지 시간 (원본: Load 전체, 희소: 매핑 + 색인 검증)과 무작위 주소 읽기 지연
+ * - 모든 영역을 다시 읽어 원본과 바이트 단위로 같은지 검증
+ * Linux는 이 프로세스의 읽을 수 있는 영역도 덤프해 빠진 페이지(읽을 수 없는 [vvar] 등)를 처리하는지 확인합니다.
+ *
+ * 사용법: SparseDumpBench [이미지 크기(MB), 기본 256]
+ */
+
+#include "../MemoryDump.h"
+#include "../SparseDump.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    const size_t RegionSize = 8 * 1024 * 1024;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double MB(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+    // 모듈 코드: 작은 명령 조각 사전에서 골라 이어 붙임
+    std::vector<uint8_t> MakeCode(size_t size, std::mt19937_64& rng) {
+        static const uint8_t pieces[][8] = {
+            {0x48, 0x8B, 0x05, 0x10, 0x20, 0x00, 0x00, 0x90}, {0x48, 0x85, 0xC0, 0x74, 0x08, 0xCC, 0xCC, 0xCC},
+            {0x55, 0x48, 0x89, 0xE5, 0x48, 0x83, 0xEC, 0x20}, {0xE8, 0x00, 0x10, 0x00, 0x00, 0x89, 0xC1, 0xC3},
+            {0xF3, 0x0F, 0x10, 0x05, 0x40, 0x00, 0x00, 0x00}, {0x0F, 0x1F, 0x44, 0x00, 0x00, 0x66, 0x90, 0x90},
+        };
+        std::vector<uint8_t> code(size);
+        for (size_t i = 0; i < size; i += 8) {
+            const uint8_t* piece = pieces[rng() % 6];
+            memcpy(code.data() + i, piece, std::min<size_t>(8, size - i));
+            if (rng() % 4 == 0) code[i + 4 < size ? i + 4 : i] = static_cast<uint8_t>(rng());   // 상대 주소가 조금씩 다름
+        }
+        return code;
+    }
+
+    // 대부분 0인 힙: 64KB마다 한두 페이지만 사용
+    std::vector<uint8_t> MakeSparseHeap(size_t size, std::mt19937_64& rng) {
+        std::vector<uint8_t> heap(size, 0);
+        for (size_t block = 0; block < size; block += 64 * 1024) {
+            size_t page = block + (rng() % 16) * 4096;
+            for (size_t i = 0; i < 4096 && page + i < size; i += 4) {
+                uint32_t value = static_cast<uint32_t>(rng() % 1000);
+                memcpy(heap.data() + page + i, &value, sizeof(value));
+            }
+        }
+        return heap;
+    }
+
+    // 게임 객체 힙: 64바이트 객체 (위치 float 3개, 체력, 탄약, 상태 플래그, 다음 객체 포인터)
+    std::vector<uint8_t> MakeObjectHeap(size_t size, uintptr_t base, std::mt19937_64& rng) {
+        std::vector<uint8_t> heap(size, 0);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        for (size_t offset = 0; offset + 64 <= size; offset += 64) {
+            uint8_t* object = heap.data() + offset;
+            float values[3] = {position(rng), position(rng), position(rng)};
+            float health = 100.0f;
+            int32_t ammo = static_cast<int32_t>(rng() % 120);
+            uint32_t flags = 0x00010001;
+            uint64_t next = base + ((offset + 64 * (1 + rng() % 8)) % size);
+            memcpy(object, values, sizeof(values));
+            memcpy(object + 12, &health, sizeof(health));
+            memcpy(object + 16, &ammo, sizeof(ammo));
+            memcpy(object + 20, &flags, sizeof(flags));
+            memcpy(object + 24, &next, sizeof(next));
+        }
+        return heap;
+    }
+
+    std::vector<uint8_t> MakeRandom(size_t size, std::mt19937_64& rng) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i + 8 <= size; i += 8) {
+            uint64_t value = rng();
+            memcpy(data.data() + i, &value, sizeof(value));
+        }
+        return data;
+    }
+
+    // 영역 구성 비율: 코드 1, 0 힙 4, 객체 힙 2, 무작위 1
+    MemoryDump MakeImage(size_t totalBytes) {
+        MemoryDump dump;
+        std::mt19937_64 rng(20);
+        uintptr_t address = 0x140000000;
+        size_t count = std::max<size_t>(8, totalBytes / RegionSize);
+        for (size_t i = 0; i < count; ++i) {
+            MemoryRegion region;
+            region.base = address;
+            std::vector<uint8_t> data;
+            switch (i % 8) {
+            case 0:
+                region.protection = MemoryRead | MemoryExecute;
+                region.type = MemoryRegionType::Image;
+                region.path = "/opt/game/bin/game.exe";
+                data = MakeCode(RegionSize, rng);
+                break;
+            case 1: case 2: case 3: case 4:
+                region.protection = MemoryRead | MemoryWrite;
+                data = MakeSparseHeap(RegionSize, rng);
+                break;
+            case 5: case 6:
+                region.protection = MemoryRead | MemoryWrite;
+                data = MakeObjectHeap(RegionSize, address, rng);
+                break;
+            default:
+                region.protection = MemoryRead;
+                region.type = MemoryRegionType::Mapped;
+                region.path = "/opt/game/data/textures.pak";
+                data = MakeRandom(RegionSize, rng);
+                break;
+            }
+            dump.AddRegion(region, std::move(data));
+            address += RegionSize + 64 * 1024;      // 영역 사이 빈틈
+        }
+        return dump;
+    }
+
+    // 모든 영역을 통째로 다시 읽어 비교. 다른 바이트가 있는 영역 수
+    size_t CompareAll(MemoryDump& original, MappedSparseDump& sparse) {
+        size_t mismatched = 0;
+        std::vector<uint8_t> buffer;
+        std::vector<MemoryRegion> expected = original.EnumerateRegions();
+        if (expected.size() != sparse.Regions().size()) return std::max(expected.size(), sparse.Regions().size());
+        for (size_t r = 0; r < expected.size(); ++r) {
+            const MemoryRegion& region = expected[r];
+            const MemoryRegion& stored = sparse.Regions()[r];
+            buffer.assign(region.size, 0xAA);
+            size_t bytesRead = 0;
+            bool same = stored.base == region.base && stored.size == region.size && stored.protection == region.protection &&
+                        stored.type == region.type && stored.path == region.path &&
+                        sparse.ReadBytes(region.base, buffer.data(), region.size, bytesRead) && bytesRead == region.size &&
+                        memcmp(buffer.data(), original.RegionData(region.base), region.size) == 0;
+            mismatched += !same;
+        }
+        return mismatched;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    if (megabytes == 0) megabytes = 64;
+    bool ok = true;
+
+    auto start = std::chrono::steady_clock::now();
+    MemoryDump image = MakeImage(megabytes * 1024 * 1024);
+    printf("SparseDumpBench: %zu regions, %.0f MB (built in %.2fs)\n", image.RegionCount(), MB(image.TotalSize()), Seconds(start));
+
+    // 블록 코덱 처리량 (객체 힙 한 영역)
+    {
+        const MemoryRegion region = image.EnumerateRegions()[5];
+        const uint8_t* data = image.RegionData(region.base);
+        std::vector<uint8_t> packed(SparseDumpFile::BlockSize);
+        std::vector<uint8_t> unpacked(SparseDumpFile::BlockSize);
+        size_t packedTotal = 0;
+        bool roundTrip = true;
+        start = std::chrono::steady_clock::now();
+        std::vector<size_t> sizes;
+        for (size_t offset = 0; offset < region.size; offset += SparseDumpFile::BlockSize) {
+            sizes.push_back(BlockCompress(data + offset, SparseDumpFile::BlockSize, packed.data(), packed.size()));
+            packedTotal += sizes.back();
+        }
+        double compressSeconds = Seconds(start);
+        start = std::chrono::steady_clock::now();
+        for (size_t offset = 0, b = 0; offset < region.size; offset += SparseDumpFile::BlockSize, ++b) {
+            BlockCompress(data + offset, SparseDumpFile::BlockSize, packed.data(), packed.size());
+            roundTrip &= BlockDecompress(packed.data(), sizes[b], unpacked.data(), unpacked.size()) &&
+                         memcmp(unpacked.data(), data + offset, unpacked.size()) == 0;
+        }
+        double decompressSeconds = Seconds(start) - compressSeconds;
+        printf("  %-14s compress %.0f MB/s, decompress %.0f MB/s, ratio %.2f, round trip %s\n", "codec",
+               MB(region.size) / compressSeconds, MB(region.size) / std::max(decompressSeconds, 1e-9),
+               static_cast<double>(region.size) / packedTotal, roundTrip ? "ok" : "FAILED");
+        ok &= roundTrip;
+    }
+
+    // 원본 덤프
+    const char* rawPath = "SparseDumpBench.scmd";
+    start = std::chrono::steady_clock::now();
+    ok &= image.Save(rawPath);
+    double rawWrite = Seconds(start);
+    uint64_t rawFile = 0;
+    {
+        MappedFile mapped;
+        if (mapped.Open(rawPath)) rawFile = mapped.Size();
+    }
+    start = std::chrono::steady_clock::now();
+    MemoryDump reloaded;
+    ok &= reloaded.Load(rawPath);
+    double rawOpen = Seconds(start);
+    std::remove(rawPath);
+    printf("  %-14s %8.1f MB  write %.3fs  first read after %.3fs (Load)\n", "raw (SCMD)", MB(rawFile), rawWrite, rawOpen);
+
+    // 희소 덤프: 스레드 1개 / 전체
+    const char* sparsePath = "SparseDumpBench.scsd";
+    size_t hardware = std::max<unsigned>(1, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts = {1};
+    if (hardware > 1) threadCounts.push_back(hardware);
+    for (size_t threads : threadCounts) {
+        SparseDumpConfig config;
+        config.threadCount = threads;
+        SparseDumpStats stats;
+        ok &= SparseDumpFile::Write(sparsePath, image, [](const MemoryRegion&) { return true; }, config, &stats);
+        printf("  %-14s %8.1f MB  write %.3fs  %zu threads  %.1fx smaller, %zu of %zu pages zero\n", "sparse (SCSD)", MB(stats.fileBytes),
+               stats.seconds, threads, static_cast<double>(rawFile) / stats.fileBytes, stats.zeroPages, stats.pages);
+    }
+
+    MappedSparseDump sparse;
+    start = std::chrono::steady_clock::now();
+    bool opened = sparse.Open(sparsePath);
+    double sparseOpen = Seconds(start);
+    ok &= opened;
+
+    // 무작위 주소 읽기: 주소마다 블록 하나만 풀림 (블록이 바뀌는 최악의 경우)
+    std::mt19937_64 rng(21);
+    std::vector<MemoryRegion> regions = image.EnumerateRegions();
+    const size_t fetchCount = 20000;
+    size_t wrongValues = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < fetchCount && opened; ++i) {
+        const MemoryRegion& region = regions[rng() % regions.size()];
+        uintptr_t address = region.base + (rng() % (region.size / 4)) * 4;
+        uint32_t value = 0, expected = 0;
+        wrongValues += !sparse.ReadValue(address, value);
+        image.ReadValue(address, expected);
+        wrongValues += value != expected;
+    }
+    double fetchUs = Seconds(start) * 1e6 / fetchCount;
+    printf("  %-14s first read after %.3fs (map + index), random 4-byte fetch %.1f us, wrong=%zu\n", "sparse read", sparseOpen, fetchUs,
+           wrongValues);
+    ok &= wrongValues == 0;
+
+    start = std::chrono::steady_clock::now();
+    size_t mismatched = opened ? CompareAll(image, sparse) : image.RegionCount();
+    printf("  %-14s all %zu regions read back in %.3fs, mismatched regions=%zu\n", "verify", image.RegionCount(), Seconds(start),
+           mismatched);
+    ok &= mismatched == 0;
+    sparse.Close();
+    std::remove(sparsePath);
+
+#if defined(__linux__)
+    // 실제 프로세스: 읽을 수 있다고 표시된 영역 중 일부는 읽을 수 없음 ([vvar] 등) → 빠진 페이지
+    {
+        LinuxProcessMemory self(getpid());
+        SparseDumpStats stats;
+        bool written = SparseDumpFile::Write(sparsePath, self, [](const MemoryRegion& region) { return region.IsReadable(); },
+                                             SparseDumpConfig(), &stats);
+        MappedSparseDump live;
+        bool reopened = written && live.Open(sparsePath);
+        // 실행 중에 바뀌지 않는 값(이 함수의 코드 바이트)을 덤프에서 다시 읽어 비교
+        uint64_t code = 0, stored = 0;
+        memcpy(&code, reinterpret_cast<const void*>(&CompareAll), sizeof(code));
+        bool same = reopened && live.ReadValue(reinterpret_cast<uintptr_t>(&CompareAll), stored) && stored == code;
+        printf("  %-14s %zu regions, %.1f MB -> %.1f MB in %.3fs, %zu zero pages, %zu missing pages, code check %s\n", "self process",
+               stats.regions, MB(stats.rawBytes), MB(stats.fileBytes), stats.seconds, stats.zeroPages, stats.missingPages,
+               same ? "ok" : "FAILED");
+        ok &= same;
+        live.Close();
+        std::remove(sparsePath);
+    }
+#endif
+
+    if (!ok) {
+        printf("ERROR: sparse dump differs from the original image\n");
+        return 1;
+    }
+    return 0;
+}
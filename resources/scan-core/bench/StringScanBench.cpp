@@ -0,0 +1,192 @@
+/*
+ * 문자열 스캔 벤치마크 (UTF-8 / UTF-16LE, 대소문자 구분/무시)
+ *
+ * 무작위 바이트 사이에 ASCII 텍스트와 UTF-16LE 텍스트 구간이 섞인 합성 덤프에 검색어를 두 인코딩,
+ * 여러 대소문자 조합으로 심고 StringSearcher의 처리량(GB/s)을 측정합니다.
+ * - 기존 방식: 위치마다 바이트 비교 (인코딩마다 한 번, 대소문자 무시는 tolower 비교)
+ * - StringSearcher 커널별 (Scalar / SSE2 / AVX2), 두 인코딩 한 번에
+ * 각 커널의 결과(주소, 인코딩)가 기존 방식과 같은지, 심은 문자열을 모두 찾는지 검증합니다.
+ *
+ * 사용법: StringScanBench [버퍼 크기(MB), 기본 512] [검색어, 기본 PlayerName]
+ */
+
+#include "../StringScan.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScanCore;
+
+namespace {
+
+    const uintptr_t Base = 0x20000000;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 64KB마다 무작위 바이트 / ASCII 단어 / UTF-16LE 단어 구간
+    std::vector<uint8_t> MakeDump(size_t size, std::mt19937_64& rng) {
+        static const char* const words[] = {"player_", "name", "health", "ITEM_", "weapon", "Level", "config", "mana", "Quest", "npc_"};
+        std::vector<uint8_t> data(size);
+        const size_t Region = 64 * 1024;
+        for (size_t start = 0; start < size; start += Region) {
+            size_t end = std::min(size, start + Region);
+            unsigned kind = static_cast<unsigned>(rng() % 3);
+            size_t i = start;
+            while (i < end) {
+                if (kind == 0) {
+                    uint64_t value = rng();
+                    for (size_t n = 0; n < 8 && i < end; ++n, ++i) data[i] = static_cast<uint8_t>(value >> (8 * n));
+                    continue;
+                }
+                const char* word = words[rng() % 10];
+                for (const char* c = word; *c && i < end; ++c) {
+                    data[i++] = static_cast<uint8_t>(*c);
+                    if (kind == 2 && i < end) data[i++] = 0;
+                }
+            }
+        }
+        return data;
+    }
+
+    // 기존 방식: 위치마다 검색어 전체를 비교
+    void NaiveFind(const std::vector<uint8_t>& data, const std::vector<uint8_t>& needle, bool utf16, bool caseInsensitive,
+                   std::vector<StringMatch>& out) {
+        for (size_t i = 0; i + needle.size() <= data.size(); ++i) {
+            size_t j = 0;
+            for (; j < needle.size(); ++j) {
+                uint8_t a = data[i + j];
+                uint8_t b = needle[j];
+                if (caseInsensitive && a < 0x80 && b < 0x80) {
+                    a = static_cast<uint8_t>(std::tolower(a));
+                    b = static_cast<uint8_t>(std::tolower(b));
+                }
+                if (a != b) break;
+            }
+            if (j == needle.size()) out.push_back({Base + i, utf16 ? StringEncoding::Utf16LE : StringEncoding::Utf8});
+        }
+    }
+
+    std::vector<StringMatch> NaiveBoth(const std::vector<uint8_t>& data, const std::string& text, bool caseInsensitive) {
+        std::vector<uint8_t> utf8(text.begin(), text.end());
+        std::u16string units;
+        Utf8ToUtf16(text, units);
+        std::vector<uint8_t> utf16;
+        for (char16_t unit : units) {
+            utf16.push_back(static_cast<uint8_t>(unit & 0xFF));
+            utf16.push_back(static_cast<uint8_t>(unit >> 8));
+        }
+        std::vector<StringMatch> a, b, merged;
+        NaiveFind(data, utf8, false, caseInsensitive, a);
+        NaiveFind(data, utf16, true, caseInsensitive, b);
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged),
+                   [](const StringMatch& x, const StringMatch& y) { return x.address < y.address; });
+        return merged;
+    }
+
+    bool Same(const std::vector<StringMatch>& a, const std::vector<StringMatch>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].address != b[i].address || a[i].encoding != b[i].encoding) return false;
+        }
+        return true;
+    }
+
+    // 대소문자를 무작위로 바꾼 변형
+    std::string RandomCase(const std::string& text, std::mt19937_64& rng) {
+        std::string result = text;
+        for (char& c : result) {
+            if (std::isalpha(static_cast<unsigned char>(c)) && rng() % 2) c = static_cast<char>(c ^ 0x20);
+        }
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 512;
+    std::string text = argc > 2 ? argv[2] : "PlayerName";
+    if (megabytes == 0) megabytes = 1;
+
+    std::mt19937_64 rng(9);
+    std::vector<uint8_t> data = MakeDump(megabytes * 1024 * 1024, rng);
+
+    // 정확한 대소문자 / 무작위 대소문자로 두 인코딩에 심기
+    std::u16string units;
+    if (!Utf8ToUtf16(text, units)) {
+        printf("invalid UTF-8 search text\n");
+        return 1;
+    }
+    const size_t Planted = 100;
+    size_t exactPlanted = 0;
+    for (size_t n = 0; n < Planted; ++n) {
+        std::string variant = n % 2 ? RandomCase(text, rng) : text;
+        exactPlanted += variant == text;
+        size_t offset = (n + 1) * (data.size() / (Planted + 2));
+        if (n % 4 < 2) {
+            memcpy(&data[offset], variant.data(), variant.size());
+        } else {
+            std::u16string variantUnits;
+            Utf8ToUtf16(variant, variantUnits);
+            for (size_t u = 0; u < variantUnits.size(); ++u) {
+                data[offset + 2 * u] = static_cast<uint8_t>(variantUnits[u] & 0xFF);
+                data[offset + 2 * u + 1] = static_cast<uint8_t>(variantUnits[u] >> 8);
+            }
+        }
+    }
+
+    printf("StringScanBench: %zu MB, \"%s\", %zu planted (%zu exact case), detected %s\n", megabytes, text.c_str(), Planted,
+           exactPlanted, SimdLevelName(ActiveSimdLevel()));
+
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+    SimdLevel best = ActiveSimdLevel();
+    if (best == SimdLevel::SSE2 || best == SimdLevel::AVX2) levels.push_back(SimdLevel::SSE2);
+    if (best == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+    bool ok = true;
+    for (bool caseInsensitive : {false, true}) {
+        printf("\n[%s]\n", caseInsensitive ? "case-insensitive" : "case-sensitive");
+        auto start = std::chrono::steady_clock::now();
+        std::vector<StringMatch> reference = NaiveBoth(data, text, caseInsensitive);
+        double naiveSeconds = Seconds(start);
+        printf("  %-8s %8.2f GB/s  matches=%zu\n", "legacy", data.size() / 1e9 / naiveSeconds, reference.size());
+
+        StringSearchOptions options;
+        options.caseInsensitive = caseInsensitive;
+        StringSearcher searcher(text, options);
+        for (SimdLevel level : levels) {
+            std::vector<StringMatch> matches;
+            double bestSeconds = 1e30;
+            for (int it = 0; it < 2; ++it) {
+                matches.clear();
+                start = std::chrono::steady_clock::now();
+                searcher.FindAll(data.data(), data.size(), Base, matches, level);
+                bestSeconds = std::min(bestSeconds, Seconds(start));
+            }
+            size_t utf16 = static_cast<size_t>(std::count_if(matches.begin(), matches.end(),
+                [](const StringMatch& match) { return match.encoding == StringEncoding::Utf16LE; }));
+            bool same = Same(matches, reference);
+            ok &= same;
+            printf("  %-8s %8.2f GB/s  matches=%zu (UTF-8 %zu, UTF-16LE %zu)%s\n", SimdLevelName(level), data.size() / 1e9 / bestSeconds,
+                   matches.size(), matches.size() - utf16, utf16, same ? "" : "  MISMATCH");
+        }
+        size_t expected = caseInsensitive ? Planted : exactPlanted;
+        if (reference.size() < expected) {
+            printf("  ERROR: expected at least %zu planted matches\n", expected);
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        printf("ERROR: string scan results differ from the byte-by-byte loop\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+/*
+ * 일괄 메모리 쓰기 벤치마크 (값마다 보호 변경 + 쓰기 대비 WriteTransaction)
+ *
+ * 힙 페이지에 흩어진 치트 테이블 항목(4바이트 값, 기본 200개)을 틱마다 다시 쓰는 상황을 흉내 냅니다.
+ * - 기존 방식: 항목마다 WriteProtected (보호 변경 → 쓰기 → 보호 복원, 쓰기 하나에 시스템 호출 3번 이상)
+ * - 값마다 WriteValue: 보호를 바꾸지 않는 가장 단순한 경로 (쓰기 하나에 시스템 호출 1번)
+ * - WriteTransaction (OnFailure): 합친 쓰기를 WriteBatch 한 번으로 (Linux는 process_vm_writev iovec 배열)
+ * - WriteTransaction + verify: 쓴 뒤 ReadBatch로 다시 읽어 비교
+ * 초당 쓰기 수(writes/s)와 틱당 백엔드 호출 수를 비교하고, 모든 값이 실제로 쓰였는지 검증합니다.
+ * 마지막으로 읽기 전용 페이지가 섞인 테이블을 Always 모드 + RegionMap으로 써서 값과 보호 복원을 검증합니다.
+ *
+ * Linux는 이 프로세스(LinuxProcessMemory), 그 외에는 MemoryDump를 대상으로 합니다.
+ *
+ * 사용법: WriteTransactionBench [항목 수, 기본 200] [측정 시간(초), 기본 0.5]
+ */
+
+#include "../MemoryDump.h"
+#include "../WriteTransaction.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace ScanCore;
+
+namespace {
+
+    const size_t PageSize = 4096;
+    const size_t HeapPages = 256;
+
+    double Seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 백엔드 호출 수를 세는 래퍼
+    class CountingMemory : public IProcessMemory {
+    public:
+        explicit CountingMemory(IProcessMemory& inner) : inner(inner) {}
+
+        size_t calls = 0;
+
+        std::vector<MemoryRegion> EnumerateRegions() override {
+            ++calls;
+            return inner.EnumerateRegions();
+        }
+        bool QueryRegion(uintptr_t address, MemoryRegion& result) override {
+            ++calls;
+            return inner.QueryRegion(address, result);
+        }
+        bool ReadBytes(uintptr_t address, void* buffer, size_t size, size_t& bytesRead) override {
+            ++calls;
+            return inner.ReadBytes(address, buffer, size, bytesRead);
+        }
+        bool WriteBytes(uintptr_t address, const void* data, size_t size, size_t& bytesWritten) override {
+            ++calls;
+            return inner.WriteBytes(address, data, size, bytesWritten);
+        }
+        bool Protect(uintptr_t address, size_t size, uint32_t protection, uint32_t& oldProtection) override {
+            ++calls;
+            return inner.Protect(address, size, protection, oldProtection);
+        }
+        void ReadBatch(ReadRequest* requests, size_t count) override {
+            ++calls;
+            inner.ReadBatch(requests, count);
+        }
+        void WriteBatch(WriteRequest* requests, size_t count) override {
+            ++calls;
+            inner.WriteBatch(requests, count);
+        }
+
+    private:
+        IProcessMemory& inner;
+    };
+
+    struct Target {
+        std::unique_ptr<IProcessMemory> memory;
+        uintptr_t heap = 0;             // HeapPages 페이지, 읽기-쓰기
+        uintptr_t readOnly = 0;         // 4페이지, 읽기 전용 (Always 모드 검증용)
+#if defined(__linux__)
+        void* block = nullptr;
+
+        ~Target() {
+            if (block) munmap(block, (HeapPages + 5) * PageSize);
+        }
+#endif
+
+        uint32_t Load(uintptr_t address) {
+            uint32_t value = 0;
+            memory->ReadValue(address, value);
+            return value;
+        }
+    };
+
+    std::unique_ptr<Target> MakeTarget() {
+        auto target = std::make_unique<Target>();
+#if defined(__linux__)
+        // 힙, 접근 불가 한 페이지, 읽기 전용 4페이지
+        target->block = mmap(nullptr, (HeapPages + 5) * PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (target->block == MAP_FAILED) return nullptr;
+        uint8_t* base = static_cast<uint8_t*>(target->block);
+        mprotect(base + HeapPages * PageSize, PageSize, PROT_NONE);
+        mprotect(base + (HeapPages + 1) * PageSize, 4 * PageSize, PROT_READ);
+        target->heap = reinterpret_cast<uintptr_t>(base);
+        target->readOnly = target->heap + (HeapPages + 1) * PageSize;
+        target->memory = std::make_unique<LinuxProcessMemory>(getpid());
+#else
+        auto dump = std::make_unique<MemoryDump>();
+        MemoryRegion heap;
+        heap.base = 0x10000000;
+        heap.protection = MemoryRead | MemoryWrite;
+        dump->AddRegion(heap, std::vector<uint8_t>(HeapPages * PageSize));
+        MemoryRegion readOnly;
+        readOnly.base = heap.base + (HeapPages + 1) * PageSize;
+        readOnly.protection = MemoryRead;
+        dump->AddRegion(readOnly, std::vector<uint8_t>(4 * PageSize));
+        target->heap = heap.base;
+        target->readOnly = readOnly.base;
+        target->memory = std::move(dump);
+#endif
+        return target;
+    }
+
+    struct Measured {
+        double writesPerSecond = 0.0;
+        double callsPerTick = 0.0;
+    };
+
+    // seconds 동안 tick(값 기준)을 반복해 초당 쓰기 수와 틱당 백엔드 호출 수를 잼
+    Measured Measure(size_t entries, double seconds, CountingMemory& counting, const std::function<void(uint32_t)>& tick) {
+        size_t ticks = 0;
+        counting.calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            tick(static_cast<uint32_t>(ticks));
+            ++ticks;
+            elapsed = Seconds(start);
+        } while (elapsed < seconds);
+        Measured measured;
+        measured.writesPerSecond = entries * ticks / elapsed;
+        measured.callsPerTick = static_cast<double>(counting.calls) / ticks;
+        return measured;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t entryCount = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 200;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 0.5;
+    if (entryCount == 0) entryCount = 1;
+    if (seconds <= 0.0) seconds = 0.5;
+
+    std::unique_ptr<Target> target = MakeTarget();
+    if (!target) {
+        printf("failed to map target pages\n");
+        return 1;
+    }
+    CountingMemory counting(*target->memory);
+
+    // 4바이트 정렬된 서로 다른 슬롯에 흩어진 항목 (같은 페이지에 여러 항목이 모이기도 함)
+    std::mt19937_64 rng(20);
+    std::vector<uintptr_t> addresses;
+    std::vector<bool> used(HeapPages * PageSize / 4, false);
+    while (addresses.size() < entryCount && addresses.size() < used.size()) {
+        size_t slot = rng() % used.size();
+        if (used[slot]) continue;
+        used[slot] = true;
+        addresses.push_back(target->heap + slot * 4);
+    }
+    entryCount = addresses.size();
+
+    auto valueOf = [](size_t entry, uint32_t tick) { return static_cast<uint32_t>(entry * 2654435761u + tick); };
+    auto check = [&](uint32_t tick) {
+        size_t wrong = 0;
+        for (size_t e = 0; e < entryCount; ++e) wrong += target->Load(addresses[e]) != valueOf(e, tick);
+        return wrong;
+    };
+
+    printf("WriteTransactionBench: %zu entries over %zu pages, %.1f s per mode\n", entryCount, HeapPages, seconds);
+    bool ok = true;
+    uint32_t lastTick = 0;
+
+    Measured legacy = Measure(entryCount, seconds, counting, [&](uint32_t tick) {
+        for (size_t e = 0; e < entryCount; ++e) {
+            uint32_t value = valueOf(e, tick);
+            counting.WriteProtected(addresses[e], &value, sizeof(value));
+        }
+        lastTick = tick;
+    });
+    size_t wrong = check(lastTick);
+    ok &= wrong == 0;
+    printf("  %-22s %12.0f writes/s  %8.1f backend calls/tick%s\n", "legacy WriteProtected", legacy.writesPerSecond, legacy.callsPerTick,
+           wrong ? "  WRONG VALUES" : "");
+
+    Measured single = Measure(entryCount, seconds, counting, [&](uint32_t tick) {
+        for (size_t e = 0; e < entryCount; ++e) counting.WriteValue(addresses[e], valueOf(e, tick));
+        lastTick = tick;
+    });
+    wrong = check(lastTick);
+    ok &= wrong == 0;
+    printf("  %-22s %12.0f writes/s  %8.1f backend calls/tick%s\n", "WriteValue per entry", single.writesPerSecond, single.callsPerTick,
+           wrong ? "  WRONG VALUES" : "");
+
+    for (bool verify : {false, true}) {
+        WriteTransactionConfig config;
+        config.verify = verify;
+        WriteTransaction transaction(counting, config);
+        WriteTransaction::Result result;
+        Measured batched = Measure(entryCount, seconds, counting, [&](uint32_t tick) {
+            transaction.Clear();
+            for (size_t e = 0; e < entryCount; ++e) transaction.Add(addresses[e], valueOf(e, tick));
+            result = transaction.Commit();
+            lastTick = tick;
+        });
+        wrong = check(lastTick);
+        ok &= wrong == 0 && result.Ok();
+        printf("  %-22s %12.0f writes/s  %8.1f backend calls/tick  spans=%zu  %.0fx vs legacy%s\n",
+               verify ? "transaction + verify" : "transaction", batched.writesPerSecond, batched.callsPerTick, result.spans,
+               batched.writesPerSecond / legacy.writesPerSecond, wrong || !result.Ok() ? "  WRONG VALUES" : "");
+    }
+
+    // 읽기 전용 페이지가 섞인 테이블: Always 모드로 페이지 구간마다 보호를 바꾸고 모두 되돌리는지
+    {
+        RegionMap regions(*target->memory);
+        WriteTransactionConfig config;
+        config.protect = ProtectMode::Always;
+        config.verify = true;
+        WriteTransaction transaction(counting, config);
+        std::vector<std::pair<uintptr_t, uint32_t>> expected;
+        for (size_t n = 0; n < 64; ++n) {
+            uintptr_t address = (n % 4 ? target->heap + n * 64 : target->readOnly + (n / 4) * 256);
+            expected.push_back({address, static_cast<uint32_t>(0xC0DE0000 + n)});
+            transaction.Add(address, expected.back().second);
+        }
+        WriteTransaction::Result result = transaction.Commit(&regions);
+        size_t wrongValues = 0;
+        for (const auto& entry : expected) wrongValues += target->Load(entry.first) != entry.second;
+
+        MemoryRegion readOnly;
+        bool restored = target->memory->QueryRegion(target->readOnly, readOnly) &&
+                        (readOnly.protection & (MemoryRead | MemoryWrite | MemoryExecute)) == MemoryRead;
+        MemoryRegion heap;
+        restored &= target->memory->QueryRegion(target->heap, heap) &&
+                    (heap.protection & (MemoryRead | MemoryWrite | MemoryExecute)) == (MemoryRead | MemoryWrite);
+        ok &= result.Ok() && wrongValues == 0 && restored;
+        printf("  %-22s %zu writes in %zu spans, protect calls=%zu, wrong=%zu, protection restored: %s\n", "always + read-only",
+               result.writes, result.spans, result.protectCalls, wrongValues, restored ? "yes" : "NO");
+    }
+
+    if (!ok) {
+        printf("ERROR: batched writes differ from the expected values\n");
+        return 1;
+    }
+    return 0;
+}
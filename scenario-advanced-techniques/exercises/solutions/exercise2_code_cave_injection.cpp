@@ -8,6 +8,8 @@
 #include <codecvt>
 #include <locale>
 
+#include "../../../resources/scan-core/RegionStream.h"
+
 /**
  * Exercise 2: 코드 케이브 인젝션 시스템
  * 
@@ -380,41 +382,54 @@ private:
     static std::vector<CodeCave> ScanMemoryRegionForCaves(HANDLE hProcess, uintptr_t baseAddress, 
                                                           size_t regionSize, size_t minSize) {
         std::vector<CodeCave> caves;
-        std::vector<BYTE> buffer(regionSize);
-        SIZE_T bytesRead;
 
-        if (!ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(baseAddress), 
-                              buffer.data(), regionSize, &bytesRead)) {
-            return caves;
-        }
+        // 영역을 1MB씩 나누어 읽기. 케이브는 청크 경계를 넘어 이어질 수 있으므로 상태를 주소 기준으로 유지
+        ScanCore::RegionStream stream([hProcess](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+            SIZE_T read = 0;
+            BOOL ok = ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(address), buffer, size, &read);
+            bytesRead = read;
+            return ok != FALSE;
+        });
 
         // NULL 바이트 패턴 찾기
-        size_t caveStart = 0;
+        uintptr_t caveStart = 0;
         size_t caveSize = 0;
         bool inCave = false;
+        uintptr_t expectedNext = baseAddress;
+
+        auto closeCave = [&]() {
+            if (inCave && caveSize >= minSize) {
+                CodeCave cave;
+                cave.address = caveStart;
+                cave.size = caveSize;
+                cave.isExecutable = true;
+                cave.sectionName = "Runtime";
+                caves.push_back(cave);
+            }
+            inCave = false;
+            caveSize = 0;
+        };
 
-        for (size_t i = 0; i < bytesRead; ++i) {
-            if (buffer[i] == 0x00 || buffer[i] == 0xCC) { // NULL 또는 INT3
-                if (!inCave) {
-                    caveStart = i;
-                    caveSize = 1;
-                    inCave = true;
+        stream.ForEach(baseAddress, regionSize, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            // 읽지 못한 청크를 건너뛰었으면 케이브가 이어지지 않음
+            if (base != expectedNext) closeCave();
+            expectedNext = base + size;
+
+            for (size_t i = 0; i < size; ++i) {
+                if (data[i] == 0x00 || data[i] == 0xCC) { // NULL 또는 INT3
+                    if (!inCave) {
+                        caveStart = base + i;
+                        caveSize = 1;
+                        inCave = true;
+                    } else {
+                        caveSize++;
+                    }
                 } else {
-                    caveSize++;
-                }
-            } else {
-                if (inCave && caveSize >= minSize) {
-                    CodeCave cave;
-                    cave.address = baseAddress + caveStart;
-                    cave.size = caveSize;
-                    cave.isExecutable = true;
-                    cave.sectionName = "Runtime";
-                    caves.push_back(cave);
+                    closeCave();
                 }
-                inCave = false;
-                caveSize = 0;
             }
-        }
+            return true;
+        });
 
         return caves;
     }
@@ -5,11 +5,15 @@
 #include <string>
 #include <iomanip>
 #include <map>
+#include <algorithm>
 #include <cmath>
 #include <TlHelp32.h>
 #include <codecvt>
 #include <locale>
 
+#include "../../../resources/scan-core/SignatureSet.h"
+#include "../../../resources/scan-core/SparseDump.h"
+
 /**
  * Exercise 4: 패킹된 실행 파일 언패킹 시스템
  * 
@@ -133,11 +137,15 @@ public:
         std::vector<BYTE> fileData(1024); // 처음 1KB만 읽기
         file.read(reinterpret_cast<char*>(fileData.data()), fileData.size());
         
-        for (const auto& sig : packerSignatures) {
-            if (SearchSignature(fileData, sig.signature)) {
-                std::wcout << L"[+] " << StringToWString(sig.name) << L" 패커 탐지 (시그니처)" << std::endl;
-                return sig.type;
-            }
+        // 모든 시그니처를 한 번에 검색. 여러 개가 맞으면 목록에서 앞선 시그니처 우선
+        size_t detected = packerSignatures.size();
+        for (const ScanCore::SignatureMatch& match : SearchSignatures(fileData)) {
+            detected = std::min<size_t>(detected, match.id);
+        }
+        if (detected < packerSignatures.size()) {
+            const auto& sig = packerSignatures[detected];
+            std::wcout << L"[+] " << StringToWString(sig.name) << L" 패커 탐지 (시그니처)" << std::endl;
+            return sig.type;
         }
 
         // 2. 섹션 기반 휴리스틱 탐지
@@ -158,11 +166,14 @@ public:
     }
 
     // 3. 메모리 덤프
-    static bool DumpProcessMemory(DWORD processId, const std::string& outputPath) {
+    // 읽을 수 있는 모든 영역을 희소 압축 덤프(SCSD)로 저장: 0 페이지는 생략하고 64KB 블록마다 압축해
+    // 여러 스레드가 읽으면서 바로 파일에 씀 (프로세스 전체를 메모리에 모으지 않음).
+    // 분석가는 같은 파일을 오프라인으로 다시 열어 스캔할 수 있음. 메인 모듈 범위를 imageBase/imageSize로 돌려줌
+    static bool DumpProcessMemory(DWORD processId, const std::string& outputPath, uintptr_t& imageBase, size_t& imageSize) {
         std::wcout << L"[+] 프로세스 메모리 덤프 중 (PID: " << processId << L")" << std::endl;
         
-        HANDLE hProcess = OpenProcess(PROCESS_ALL_ACCESS, FALSE, processId);
-        if (!hProcess) {
+        ScanCore::Win32ProcessMemory memory(processId);
+        if (!memory.IsOpen()) {
             std::wcout << L"[-] 프로세스 열기 실패: " << GetLastError() << std::endl;
             return false;
         }
@@ -170,43 +181,51 @@ public:
         // 메인 모듈 정보 획득
         HMODULE hModule;
         DWORD cbNeeded;
-        if (!EnumProcessModules(hProcess, &hModule, sizeof(hModule), &cbNeeded)) {
+        if (!EnumProcessModules(memory.GetHandle(), &hModule, sizeof(hModule), &cbNeeded)) {
             std::wcout << L"[-] 모듈 열거 실패" << std::endl;
-            CloseHandle(hProcess);
             return false;
         }
 
         MODULEINFO modInfo;
-        if (!GetModuleInformation(hProcess, hModule, &modInfo, sizeof(modInfo))) {
+        if (!GetModuleInformation(memory.GetHandle(), hModule, &modInfo, sizeof(modInfo))) {
             std::wcout << L"[-] 모듈 정보 획득 실패" << std::endl;
-            CloseHandle(hProcess);
             return false;
         }
+        imageBase = reinterpret_cast<uintptr_t>(modInfo.lpBaseOfDll);
+        imageSize = modInfo.SizeOfImage;
 
-        // 메모리 읽기
-        std::vector<BYTE> memoryData(modInfo.SizeOfImage);
-        SIZE_T bytesRead;
-        if (!ReadProcessMemory(hProcess, modInfo.lpBaseOfDll, 
-                              memoryData.data(), modInfo.SizeOfImage, &bytesRead)) {
-            std::wcout << L"[-] 메모리 읽기 실패: " << GetLastError() << std::endl;
-            CloseHandle(hProcess);
+        // 전체 프로세스를 스트리밍으로 덤프
+        ScanCore::SparseDumpStats stats;
+        if (!ScanCore::SparseDumpFile::Write(outputPath, memory,
+                [](const ScanCore::MemoryRegion& region) { return region.IsReadable(); },
+                ScanCore::SparseDumpConfig(), &stats)) {
+            std::wcout << L"[-] 덤프 파일 쓰기 실패" << std::endl;
             return false;
         }
+        
+        std::wcout << L"[+] 메모리 덤프 완료: " << StringToWString(outputPath) << L" (영역 " << stats.regions
+                   << L"개, " << stats.rawBytes / (1024 * 1024) << L"MB → " << stats.fileBytes / (1024 * 1024)
+                   << L"MB, 0 페이지 " << stats.zeroPages << L"개 생략, " << stats.seconds << L"초)" << std::endl;
+        return true;
+    }
 
-        // 파일로 저장
-        std::ofstream outFile(outputPath, std::ios::binary);
-        if (!outFile.is_open()) {
-            std::wcout << L"[-] 출력 파일 생성 실패" << std::endl;
-            CloseHandle(hProcess);
+    // 덤프에서 메인 모듈 이미지만 꺼냄 (필요한 블록만 풂). 읽지 못한 페이지는 0으로 남김
+    static bool ReadImageFromDump(const std::string& dumpPath, uintptr_t imageBase, size_t imageSize, std::vector<BYTE>& image) {
+        ScanCore::MappedSparseDump dump;
+        if (!dump.Open(dumpPath)) {
+            std::wcout << L"[-] 덤프 파일 열기 실패" << std::endl;
             return false;
         }
-
-        outFile.write(reinterpret_cast<const char*>(memoryData.data()), bytesRead);
-        outFile.close();
-
-        CloseHandle(hProcess);
-        
-        std::wcout << L"[+] 메모리 덤프 완료: " << StringToWString(outputPath) << L" (" << bytesRead << L" 바이트)" << std::endl;
+        image.assign(imageSize, 0);
+        size_t missing = 0;
+        for (size_t offset = 0; offset < imageSize; offset += ScanCore::SparseDumpFile::PageSize) {
+            size_t length = std::min<size_t>(ScanCore::SparseDumpFile::PageSize, imageSize - offset);
+            size_t bytesRead = 0;
+            if (!dump.ReadBytes(imageBase + offset, image.data() + offset, length, bytesRead)) ++missing;
+        }
+        if (missing > 0) {
+            std::wcout << L"[!] 이미지에서 읽지 못한 페이지: " << missing << L"개" << std::endl;
+        }
         return true;
     }
 
@@ -366,20 +385,25 @@ public:
         Sleep(2000); // 언패킹 시간 대기
         SuspendThread(pi.hThread);
 
-        // 4. 메모리 덤프
-        std::string tempDumpPath = outputPath + ".dump";
-        if (!DumpProcessMemory(pi.dwProcessId, tempDumpPath)) {
+        // 4. 메모리 덤프 (전체 프로세스, 오프라인 분석용으로 남겨 둠)
+        std::string dumpPath = outputPath + ".scsd";
+        uintptr_t imageBase = 0;
+        size_t imageSize = 0;
+        if (!DumpProcessMemory(pi.dwProcessId, dumpPath, imageBase, imageSize)) {
             TerminateProcess(pi.hProcess, 0);
             CloseHandle(pi.hProcess);
             CloseHandle(pi.hThread);
             return false;
         }
 
-        // 5. 덤프 파일 읽기
-        std::ifstream dumpFile(tempDumpPath, std::ios::binary);
-        std::vector<BYTE> memoryData((std::istreambuf_iterator<char>(dumpFile)),
-                                    std::istreambuf_iterator<char>());
-        dumpFile.close();
+        // 5. 덤프에서 메인 모듈 이미지 읽기
+        std::vector<BYTE> memoryData;
+        if (!ReadImageFromDump(dumpPath, imageBase, imageSize, memoryData)) {
+            TerminateProcess(pi.hProcess, 0);
+            CloseHandle(pi.hProcess);
+            CloseHandle(pi.hThread);
+            return false;
+        }
 
         // 6. OEP 탐지
         DWORD oep = FindOEP(memoryData, 0x400000); // 기본 ImageBase
@@ -394,7 +418,7 @@ public:
         TerminateProcess(pi.hProcess, 0);
         CloseHandle(pi.hProcess);
         CloseHandle(pi.hThread);
-        DeleteFileA(tempDumpPath.c_str());
+        std::wcout << L"[+] 전체 프로세스 덤프: " << StringToWString(dumpPath) << std::endl;
 
         if (success) {
             std::wcout << L"[+] 언패킹 완료!" << std::endl;
@@ -407,24 +431,17 @@ public:
 
 private:
     // 헬퍼 함수들
-    static bool SearchSignature(const std::vector<BYTE>& data, const std::vector<BYTE>& signature) {
-        if (signature.empty() || data.size() < signature.size()) {
-            return false;
+    // packerSignatures 전체를 한 번의 패스로 검색 (id = packerSignatures 인덱스, 마스크 없음 = 모든 바이트 고정)
+    static std::vector<ScanCore::SignatureMatch> SearchSignatures(const std::vector<BYTE>& data) {
+        ScanCore::SignatureSet signatureSet;
+        for (const auto& sig : packerSignatures) {
+            signatureSet.Add(sig.signature);
         }
+        signatureSet.Build();
 
-        for (size_t i = 0; i <= data.size() - signature.size(); ++i) {
-            bool match = true;
-            for (size_t j = 0; j < signature.size(); ++j) {
-                if (data[i + j] != signature[j]) {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) {
-                return true;
-            }
-        }
-        return false;
+        std::vector<ScanCore::SignatureMatch> matches;
+        signatureSet.FindAll(data.data(), data.size(), 0, matches);
+        return matches;
     }
 
     static std::vector<SectionInfo> AnalyzeSections(std::ifstream& file, const IMAGE_NT_HEADERS& ntHeaders) {
@@ -6,6 +6,8 @@
 #include <cmath>
 #include <psapi.h>
 #include <tlhelp32.h>
+#include "scan-core/RegionStream.h"
+#include "scan-core/CompiledPattern.h"
 
 // Camera pattern definitions
 namespace CameraUtils {
@@ -47,7 +49,7 @@ namespace CameraUtils {
 
 // CameraSystem Implementation
 CameraSystem::CameraSystem() 
-    : processHandle(nullptr), cameraBaseAddress(0), fovAddress(0),
+    : cameraBaseAddress(0), fovAddress(0),
       freeCameraEnabled(false), originalCameraBackup(false),
       safetyMode(true), maxSpeed(100.0f), maxFOV(120.0f), minFOV(30.0f),
       deltaTime(0.0f) {
@@ -95,8 +97,8 @@ bool CameraSystem::Initialize(const std::wstring& targetProcess) {
         return false;
     }
     
-    processHandle = OpenProcess(PROCESS_ALL_ACCESS, FALSE, processId);
-    if (!processHandle) {
+    memory = ScanCore::OpenProcessMemory(processId);
+    if (!memory) {
         std::cout << "Failed to open process. Error: " << GetLastError() << std::endl;
         return false;
     }
@@ -125,7 +127,7 @@ bool CameraSystem::Initialize(const std::wstring& targetProcess) {
 }
 
 void CameraSystem::Shutdown() {
-    if (processHandle) {
+    if (memory) {
         if (freeCameraEnabled) {
             EnableFreeCamera(false);
         }
@@ -133,8 +135,7 @@ void CameraSystem::Shutdown() {
         // Restore original camera state
         RestoreOriginalCamera();
         
-        CloseHandle(processHandle);
-        processHandle = nullptr;
+        memory.reset();
     }
     
     std::cout << "Camera system shut down" << std::endl;
@@ -143,26 +144,47 @@ void CameraSystem::Shutdown() {
 bool CameraSystem::FindCameraBaseAddress() {
     std::cout << "Searching for camera base address..." << std::endl;
     
-    // Try different patterns based on game engine
-    std::vector<std::pair<std::vector<uint8_t>, std::vector<bool>>> patterns = {
-        {CameraUtils::Patterns::UE4_CAMERA_PATTERN, CameraUtils::Patterns::UE4_CAMERA_MASK},
-        {CameraUtils::Patterns::UNITY_CAMERA_PATTERN, CameraUtils::Patterns::UNITY_CAMERA_MASK},
-        {CameraUtils::Patterns::ELDENRING_CAMERA_PATTERN, CameraUtils::Patterns::ELDENRING_CAMERA_MASK}
-    };
+    // Same game build as last time: one read confirms the cached match, no scan needed
+    std::vector<ScanCore::ModuleRange> modules = memory->EnumerateModules();
+    resolutionCache.Load(cachePath);
+    uintptr_t cached = 0;
+    XMFLOAT3 cachedPos;
+    if (resolutionCache.Lookup(*memory, modules, "camera_base", cached) &&
+        ReadMemory(cached, &cachedPos, sizeof(cachedPos)) &&
+        abs(cachedPos.x) < 100000.0f && abs(cachedPos.y) < 100000.0f && abs(cachedPos.z) < 100000.0f) {
+        cameraBaseAddress = cached;
+        std::cout << "Found camera base address (cached): 0x" << std::hex << cached << std::dec << std::endl;
+        return true;
+    }
     
-    for (const auto& pattern : patterns) {
-        auto addresses = ScanMemoryPattern(pattern.first, pattern.second);
-        
-        for (uintptr_t addr : addresses) {
-            // Validate address by checking if it points to reasonable values
-            XMFLOAT3 testPos;
-            if (ReadMemory(addr, &testPos, sizeof(testPos))) {
-                // Check if position values are reasonable (not too extreme)
-                if (abs(testPos.x) < 100000.0f && abs(testPos.y) < 100000.0f && abs(testPos.z) < 100000.0f) {
-                    cameraBaseAddress = addr;
-                    std::cout << "Found camera base address: 0x" << std::hex << addr << std::endl;
-                    return true;
+    // Try different patterns based on game engine, all in a single pass over memory
+    ScanCore::SignatureSet signatures;
+    signatures.Add(CameraUtils::Patterns::UE4_CAMERA_PATTERN, CameraUtils::Patterns::UE4_CAMERA_MASK);
+    signatures.Add(CameraUtils::Patterns::UNITY_CAMERA_PATTERN, CameraUtils::Patterns::UNITY_CAMERA_MASK);
+    signatures.Add(CameraUtils::Patterns::ELDENRING_CAMERA_PATTERN, CameraUtils::Patterns::ELDENRING_CAMERA_MASK);
+    signatures.Build();
+    
+    std::vector<ScanCore::SignatureMatch> matches = ScanMemorySignatures(signatures);
+    
+    // Keep the old priority: every UE4 hit first, then Unity, then Elden Ring
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const ScanCore::SignatureMatch& a, const ScanCore::SignatureMatch& b) { return a.id < b.id; });
+    
+    for (const ScanCore::SignatureMatch& match : matches) {
+        uintptr_t addr = match.address;
+        // Validate address by checking if it points to reasonable values
+        XMFLOAT3 testPos;
+        if (ReadMemory(addr, &testPos, sizeof(testPos))) {
+            // Check if position values are reasonable (not too extreme)
+            if (abs(testPos.x) < 100000.0f && abs(testPos.y) < 100000.0f && abs(testPos.z) < 100000.0f) {
+                cameraBaseAddress = addr;
+                std::cout << "Found camera base address: 0x" << std::hex << addr << std::endl;
+                
+                // Validation bytes = the matched signature itself (only cacheable inside a module image)
+                if (resolutionCache.Store(*memory, modules, "camera_base", addr, addr, signatures.Pattern(match.id).Size())) {
+                    resolutionCache.Save(cachePath);
                 }
+                return true;
             }
         }
     }
@@ -177,38 +199,33 @@ bool CameraSystem::FindFOVAddress() {
     // Common FOV values to scan for
     std::vector<float> commonFOVs = {60.0f, 70.0f, 80.0f, 90.0f, 75.0f, 65.0f};
     
+    std::vector<ScanCore::MemoryRange> ranges = memory->CollectRanges(
+        [](const ScanCore::MemoryRegion& region) { return region.IsWritable(); });
+    
+    // Stream regions in fixed-size chunks instead of allocating a buffer per region
+    ScanCore::RegionStream stream(memory->MakeReadFunction());
+    
     for (float fov : commonFOVs) {
-        MEMORY_BASIC_INFORMATION mbi;
-        uintptr_t address = 0;
-        
-        while (VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi))) {
-            if (mbi.State == MEM_COMMIT && 
-                (mbi.Protect == PAGE_READWRITE || mbi.Protect == PAGE_EXECUTE_READWRITE)) {
-                
-                SIZE_T bytesRead;
-                std::vector<uint8_t> buffer(mbi.RegionSize);
-                
-                if (ReadProcessMemory(processHandle, mbi.BaseAddress, buffer.data(), 
-                                    mbi.RegionSize, &bytesRead)) {
+        bool found = !stream.ForEach(ranges, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            for (size_t i = 0; i + sizeof(float) <= size; i += 4) {
+                float value;
+                memcpy(&value, data + i, sizeof(float));
+                if (abs(value - fov) < 0.1f) {
+                    uintptr_t candidateAddr = base + i;
                     
-                    for (size_t i = 0; i < bytesRead - sizeof(float); i += 4) {
-                        float* floatPtr = reinterpret_cast<float*>(&buffer[i]);
-                        if (abs(*floatPtr - fov) < 0.1f) {
-                            uintptr_t candidateAddr = (uintptr_t)mbi.BaseAddress + i;
-                            
-                            // Validate by checking nearby memory for camera-related data
-                            if (ValidateFOVAddress(candidateAddr)) {
-                                fovAddress = candidateAddr;
-                                std::cout << "Found FOV address: 0x" << std::hex << candidateAddr << std::endl;
-                                return true;
-                            }
-                        }
+                    // Validate by checking nearby memory for camera-related data
+                    if (ValidateFOVAddress(candidateAddr)) {
+                        fovAddress = candidateAddr;
+                        std::cout << "Found FOV address: 0x" << std::hex << candidateAddr << std::endl;
+                        return false;
                     }
                 }
             }
-            
-            address += mbi.RegionSize;
-            if (address == 0) break; // Overflow protection
+            return true;
+        });
+        
+        if (found) {
+            return true;
         }
     }
     
@@ -239,46 +256,55 @@ bool CameraSystem::ValidateFOVAddress(uintptr_t address) {
 std::vector<uintptr_t> CameraSystem::ScanMemoryPattern(const std::vector<uint8_t>& pattern, 
                                                       const std::vector<bool>& mask) {
     std::vector<uintptr_t> results;
+    if (pattern.empty()) return results;
     
-    MEMORY_BASIC_INFORMATION mbi;
-    uintptr_t address = 0;
+    // Compile once: skip between the rarest fixed bytes and only verify candidates
+    ScanCore::CompiledPattern compiled(pattern, mask);
+    if (compiled.Empty()) return results;
     
-    while (VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi))) {
-        if (mbi.State == MEM_COMMIT && 
-            (mbi.Protect == PAGE_EXECUTE_READ || mbi.Protect == PAGE_EXECUTE_READWRITE)) {
-            
-            SIZE_T bytesRead;
-            std::vector<uint8_t> buffer(mbi.RegionSize);
-            
-            if (ReadProcessMemory(processHandle, mbi.BaseAddress, buffer.data(), 
-                                mbi.RegionSize, &bytesRead)) {
-                
-                for (size_t i = 0; i < bytesRead - pattern.size(); ++i) {
-                    bool match = true;
-                    
-                    for (size_t j = 0; j < pattern.size(); ++j) {
-                        if (mask[j] && buffer[i + j] != pattern[j]) {
-                            match = false;
-                            break;
-                        }
-                    }
-                    
-                    if (match) {
-                        results.push_back((uintptr_t)mbi.BaseAddress + i);
-                    }
-                }
-            }
-        }
-        
-        address += mbi.RegionSize;
-        if (address == 0) break; // Overflow protection
-    }
+    std::vector<ScanCore::MemoryRange> ranges = memory->CollectRanges([](const ScanCore::MemoryRegion& region) {
+        return region.IsExecutable() && !(region.protection & ScanCore::MemoryCopyOnWrite);
+    });
+    
+    // Carry pattern.size() - 1 bytes between chunks so matches across chunk boundaries are kept
+    ScanCore::RegionStreamConfig config;
+    config.overlap = pattern.size() - 1;
+    ScanCore::RegionStream stream(memory->MakeReadFunction(), config);
+    
+    stream.ForEach(ranges, [&](const uint8_t* data, size_t size, uintptr_t base) {
+        compiled.FindAll(data, size, base, results);
+        return true;
+    });
+    
+    return results;
+}
+
+std::vector<ScanCore::SignatureMatch> CameraSystem::ScanMemorySignatures(const ScanCore::SignatureSet& signatures) {
+    std::vector<ScanCore::SignatureMatch> results;
+    if (signatures.MaxLength() == 0) return results;
+    
+    std::vector<ScanCore::MemoryRange> ranges = memory->CollectRanges([](const ScanCore::MemoryRegion& region) {
+        return region.IsExecutable() && !(region.protection & ScanCore::MemoryCopyOnWrite);
+    });
+    
+    // Carry the longest signature's size - 1 bytes between chunks; seenEnd drops shorter matches
+    // that were already reported from the previous chunk
+    ScanCore::RegionStreamConfig config;
+    config.overlap = signatures.MaxLength() - 1;
+    ScanCore::RegionStream stream(memory->MakeReadFunction(), config);
+    
+    uintptr_t seenEnd = 0;
+    stream.ForEach(ranges, [&](const uint8_t* data, size_t size, uintptr_t base) {
+        signatures.FindAll(data, size, base, results, seenEnd);
+        seenEnd = base + size;
+        return true;
+    });
     
     return results;
 }
 
 bool CameraSystem::GetCameraState(CameraState& state) {
-    if (!processHandle || cameraBaseAddress == 0) return false;
+    if (!memory || cameraBaseAddress == 0) return false;
     
     // Read position (typically at offset 0x0)
     if (!ReadMemory(cameraBaseAddress, &state.position, sizeof(XMFLOAT3))) {
@@ -299,7 +325,7 @@ bool CameraSystem::GetCameraState(CameraState& state) {
 }
 
 bool CameraSystem::SetCameraState(const CameraState& state) {
-    if (!processHandle || cameraBaseAddress == 0) return false;
+    if (!memory || cameraBaseAddress == 0) return false;
     
     if (safetyMode && !ValidateCameraState(state)) {
         std::cout << "Camera state validation failed" << std::endl;
@@ -572,28 +598,22 @@ void CameraSystem::RestoreOriginalCamera() {
 // Utility template implementations
 template<typename T>
 bool CameraSystem::ReadValue(uintptr_t address, T& value) {
-    SIZE_T bytesRead;
-    return ReadProcessMemory(processHandle, (LPCVOID)address, &value, sizeof(T), &bytesRead) 
-           && bytesRead == sizeof(T);
+    return memory->ReadValue(address, value);
 }
 
 template<typename T>
 bool CameraSystem::WriteValue(uintptr_t address, const T& value) {
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(processHandle, (LPVOID)address, &value, sizeof(T), &bytesWritten) 
-           && bytesWritten == sizeof(T);
+    return memory->WriteValue(address, value);
 }
 
 bool CameraSystem::ReadMemory(uintptr_t address, void* buffer, size_t size) {
-    SIZE_T bytesRead;
-    return ReadProcessMemory(processHandle, (LPCVOID)address, buffer, size, &bytesRead) 
-           && bytesRead == size;
+    size_t bytesRead = 0;
+    return memory->ReadBytes(address, buffer, size, bytesRead) && bytesRead == size;
 }
 
 bool CameraSystem::WriteMemory(uintptr_t address, const void* buffer, size_t size) {
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(processHandle, (LPVOID)address, buffer, size, &bytesWritten) 
-           && bytesWritten == size;
+    size_t bytesWritten = 0;
+    return memory->WriteBytes(address, buffer, size, bytesWritten) && bytesWritten == size;
 }
 
 // Math utility implementations
@@ -6,6 +6,9 @@
 #include <string>
 #include <chrono>
 #include <functional>
+#include "scan-core/ProcessMemory.h"
+#include "scan-core/SignatureSet.h"
+#include "scan-core/SignatureCache.h"
 
 using namespace DirectX;
 
@@ -55,11 +58,15 @@ struct CameraTransition {
 class CameraSystem {
 private:
     // Process and memory management
-    HANDLE processHandle;
+    std::unique_ptr<ScanCore::IProcessMemory> memory;   // Win32 process, or any other backend (dump, test process)
     std::wstring processName;
     uintptr_t cameraBaseAddress;
     uintptr_t fovAddress;
     
+    // Signature results from the last attach, keyed by module build (skips the scan when unchanged)
+    ScanCore::SignatureCache resolutionCache;
+    std::string cachePath = "camera_signatures.cache";
+    
     // Camera state management
     CameraState currentState;
     CameraState originalState;
@@ -95,7 +102,7 @@ public:
     // Initialization and cleanup
     bool Initialize(const std::wstring& targetProcess);
     void Shutdown();
-    bool IsInitialized() const { return processHandle != nullptr; }
+    bool IsInitialized() const { return memory != nullptr; }
     
     // Camera position and rotation
     bool GetCameraState(CameraState& state);
@@ -152,6 +159,7 @@ private:
     bool FindFOVAddress();
     std::vector<uintptr_t> ScanMemoryPattern(const std::vector<uint8_t>& pattern, 
                                             const std::vector<bool>& mask);
+    std::vector<ScanCore::SignatureMatch> ScanMemorySignatures(const ScanCore::SignatureSet& signatures);
     
     // Math utilities
     XMFLOAT3 EulerToDirection(const XMFLOAT3& euler);
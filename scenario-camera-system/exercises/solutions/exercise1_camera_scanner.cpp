@@ -24,6 +24,11 @@
 #include <algorithm>
 #include <cmath> // For std::abs, std::isfinite, std::sqrt
 
+#include "../../../resources/scan-core/RegionStream.h"
+#include "../../../resources/scan-core/FloatScanKernels.h"
+#include "../../../resources/scan-core/SignatureSet.h"
+#include "../../../resources/scan-core/ScanJob.h"
+
 #pragma comment(lib, "psapi.lib")
 
 using namespace DirectX;
@@ -64,6 +69,9 @@ private:
     
     std::vector<ScanPattern> patterns;
     
+    // 백그라운드 작업으로 스캔할 때의 진행률/취소 (StartFullScan 동안만 유효)
+    ScanCore::ScanControl* scanControl = nullptr;
+    
     // 게임 엔진별 패턴
     void InitializePatterns() {
         // Unreal Engine 카메라 패턴
@@ -135,14 +143,26 @@ public:
         return true;
     }
     
-    void StartFullScan() {
+    // control이 있으면 진행률을 기록하고, 취소/시간 초과 시 남은 스캔을 건너뛰고 지금까지의 후보로 분석
+    void StartFullScan(ScanCore::ScanControl* control = nullptr) {
         std::wcout << L"전체 카메라 스캔 시작..." << std::endl;
+        scanControl = control;
+        if (scanControl) {
+            // 영역 전체를 4번 훑음 (값 범위, 패턴, 구조체, 런타임 스냅샷)
+            size_t total = 0;
+            for (const ScanCore::MemoryRange& range : CollectRanges()) total += range.size;
+            scanControl->AddTotal(total * 4);
+        }
         
         // 여러 방법으로 스캔
-        ScanByValueRange();
-        ScanByPatternMatching();
-        ScanByStructureAnalysis();
-        ScanByRuntimeAnalysis();
+        if (!ShouldStop()) ScanByValueRange();
+        if (!ShouldStop()) ScanByPatternMatching();
+        if (!ShouldStop()) ScanByStructureAnalysis();
+        if (!ShouldStop()) ScanByRuntimeAnalysis();
+        if (ShouldStop()) {
+            std::wcout << L"스캔 중단됨. 지금까지 찾은 후보로 분석합니다." << std::endl;
+        }
+        scanControl = nullptr;
         
         // 결과 분석 및 출력
         AnalyzeResults();
@@ -150,6 +170,17 @@ public:
     }
     
 private:
+    bool ShouldStop() const {
+        return scanControl && scanControl->ShouldStop();
+    }
+    
+    // 청크 하나를 끝낼 때마다 호출. false면 스트림 중단
+    bool ContinueScan(size_t chunkBytes) {
+        if (!scanControl) return true;
+        scanControl->AddDone(chunkBytes);
+        return !scanControl->ShouldStop();
+    }
+    
     DWORD FindProcessByName(const std::wstring& processName) {
         HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
         if (hSnapshot == INVALID_HANDLE_VALUE) {
@@ -209,67 +240,71 @@ private:
             XMConvertToRadians(120.0f)
         };
         
-        for (const auto& region : memoryRegions) {
-            std::vector<uint8_t> buffer(region.RegionSize);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, region.BaseAddress, buffer.data(), region.RegionSize, &bytesRead)) {
-                for (size_t i = 0; i <= bytesRead - sizeof(float); i += sizeof(float)) {
-                    float value = *reinterpret_cast<float*>(&buffer[i]);
-                    
-                    for (float fov : fovValues) {
-                        if (std::abs(value - fov) < 0.01f) {
-                            uintptr_t address = reinterpret_cast<uintptr_t>(region.BaseAddress) + i;
-                            ValidateCameraStructure(address);
-                            break;
-                        }
-                    }
-                }
+        // 11개 값을 한 번에 비교 (SIMD). 비정규 수/NaN은 후보에서 제외
+        ScanCore::FloatCondition<float> condition = ScanCore::FloatCondition<float>::AnyOf(fovValues.begin(), fovValues.end(), 0.01f);
+        std::vector<uintptr_t> hits;
+        
+        ScanCore::RegionStream stream(MakeReadFunction());
+        stream.ForEach(CollectRanges(), [&](const uint8_t* data, size_t size, uintptr_t base) {
+            hits.clear();
+            ScanCore::FindFloat(data, size, condition, base, hits);
+            for (uintptr_t address : hits) {
+                ValidateCameraStructure(address);
             }
-        }
+            return ContinueScan(size);
+        });
     }
     
     void ScanByPatternMatching() {
         std::wcout << L"패턴 매칭 스캔 중..." << std::endl;
         
+        // 모든 패턴을 한 번에 검색 (id = patterns 인덱스)
+        ScanCore::SignatureSet signatureSet;
         for (const auto& pattern : patterns) {
-            std::wcout << L"패턴 스캔: " << std::wstring(pattern.name.begin(), pattern.name.end()) << std::endl;
+            signatureSet.Add(pattern.pattern, pattern.mask);
+        }
+        signatureSet.Build();
+        if (signatureSet.MaxLength() == 0) return;
+        std::wcout << L"패턴 " << signatureSet.Count() << L"개 동시 스캔" << std::endl;
+        
+        // 청크 경계에 걸친 패턴을 찾기 위해 가장 긴 패턴 길이 - 1 바이트를 다음 청크로 넘기고,
+        // 앞 청크에서 이미 찾은 짧은 패턴은 seenEnd로 거름
+        ScanCore::RegionStreamConfig config;
+        config.overlap = signatureSet.MaxLength() - 1;
+        ScanCore::RegionStream stream(MakeReadFunction(), config);
+        std::vector<ScanCore::SignatureMatch> matches;
+        uintptr_t seenEnd = 0;
+        stream.ForEach(CollectRanges(), [&](const uint8_t* data, size_t size, uintptr_t base) {
+            matches.clear();
+            signatureSet.FindAll(data, size, base, matches, seenEnd);
+            seenEnd = base + size;
             
-            for (const auto& region : memoryRegions) {
-                std::vector<uint8_t> buffer(region.RegionSize);
-                SIZE_T bytesRead;
-                
-                if (ReadProcessMemory(processHandle, region.BaseAddress, buffer.data(), region.RegionSize, &bytesRead)) {
-                    std::vector<uintptr_t> matches = FindPattern(buffer, pattern.pattern, pattern.mask);
-                    
-                    for (uintptr_t offset : matches) {
-                        uintptr_t address = reinterpret_cast<uintptr_t>(region.BaseAddress) + offset + pattern.offset;
-                        ValidateCameraStructure(address);
-                    }
-                }
+            for (const ScanCore::SignatureMatch& match : matches) {
+                ValidateCameraStructure(match.address + patterns[match.id].offset);
             }
-        }
+            return ContinueScan(size);
+        });
     }
     
     void ScanByStructureAnalysis() {
         std::wcout << L"구조체 분석 스캔 중..." << std::endl;
         
-        for (const auto& region : memoryRegions) {
-            std::vector<uint8_t> buffer(region.RegionSize);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, region.BaseAddress, buffer.data(), region.RegionSize, &bytesRead)) {
-                // 가능한 카메라 구조체 위치 찾기
-                for (size_t i = 0; i <= bytesRead - sizeof(CameraData); i += 16) {
-                    CameraData* data = reinterpret_cast<CameraData*>(&buffer[i]);
-                    
-                    if (IsPotentialCameraData(*data)) {
-                        uintptr_t address = reinterpret_cast<uintptr_t>(region.BaseAddress) + i;
-                        ValidateCameraStructure(address);
-                    }
+        // 구조체가 청크 경계에 걸칠 수 있으므로 sizeof(CameraData) - 1 바이트를 넘기고, 16바이트 정렬 위치만 확인
+        ScanCore::RegionStreamConfig config;
+        config.overlap = sizeof(CameraData) - 1;
+        ScanCore::RegionStream stream(MakeReadFunction(), config);
+        stream.ForEach(CollectRanges(), [&](const uint8_t* data, size_t size, uintptr_t base) {
+            // 가능한 카메라 구조체 위치 찾기
+            for (size_t i = ScanCore::RegionStream::AlignedOffset(base, 16); i + sizeof(CameraData) <= size; i += 16) {
+                CameraData candidate;
+                memcpy(&candidate, data + i, sizeof(CameraData));
+                
+                if (IsPotentialCameraData(candidate)) {
+                    ValidateCameraStructure(base + i);
                 }
             }
-        }
+            return ContinueScan(size);
+        });
     }
     
     void ScanByRuntimeAnalysis() {
@@ -280,21 +315,19 @@ private:
         
         // 첫 번째 스냅샷
         std::map<uintptr_t, float> initialValues;
-        for (const auto& region : memoryRegions) {
-            std::vector<uint8_t> buffer(region.RegionSize);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, region.BaseAddress, buffer.data(), region.RegionSize, &bytesRead)) {
-                for (size_t i = 0; i <= bytesRead - sizeof(float); i += sizeof(float)) {
-                    float value = *reinterpret_cast<float*>(&buffer[i]);
-                    if (IsReasonableValue(value)) {
-                        uintptr_t address = reinterpret_cast<uintptr_t>(region.BaseAddress) + i;
-                        initialValues[address] = value;
-                    }
+        ScanCore::RegionStream stream(MakeReadFunction());
+        stream.ForEach(CollectRanges(), [&](const uint8_t* data, size_t size, uintptr_t base) {
+            for (size_t i = 0; i + sizeof(float) <= size; i += sizeof(float)) {
+                float value;
+                memcpy(&value, data + i, sizeof(float));
+                if (IsReasonableValue(value)) {
+                    initialValues[base + i] = value;
                 }
             }
-        }
+            return ContinueScan(size);
+        });
         
+        if (ShouldStop()) return;
         std::wcout << L"초기 값 수집 완료. 5초 대기 후 변경 사항 확인..." << std::endl;
         std::this_thread::sleep_for(std::chrono::seconds(5));
         
@@ -383,6 +416,7 @@ private:
         result.description = GenerateDescription(data);
         
         scanResults.push_back(result);
+        if (scanControl) scanControl->AddHits(1);
         
         std::wcout << L"카메라 후보 발견: 0x" << std::hex << address 
                   << L" (신뢰도: " << std::fixed << std::setprecision(2) << confidence << L")" << std::endl;
@@ -439,25 +473,25 @@ private:
         return ss.str();
     }
     
-    std::vector<uintptr_t> FindPattern(const std::vector<uint8_t>& buffer, 
-                                      const std::vector<uint8_t>& pattern, 
-                                      const std::vector<bool>& mask) {
-        std::vector<uintptr_t> matches;
-        
-        for (size_t i = 0; i <= buffer.size() - pattern.size(); i++) {
-            bool match = true;
-            for (size_t j = 0; j < pattern.size(); j++) {
-                if (mask[j] && buffer[i + j] != pattern[j]) {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) {
-                matches.push_back(i);
-            }
+    // 스캔할 영역 목록 (RegionStream 입력)
+    std::vector<ScanCore::MemoryRange> CollectRanges() const {
+        std::vector<ScanCore::MemoryRange> ranges;
+        ranges.reserve(memoryRegions.size());
+        for (const auto& region : memoryRegions) {
+            ranges.push_back({reinterpret_cast<uintptr_t>(region.BaseAddress), region.RegionSize});
         }
-        
-        return matches;
+        return ranges;
+    }
+    
+    // 영역을 청크 단위로 읽을 때 사용하는 ReadProcessMemory 래퍼
+    ScanCore::ScanExecutor::ReadFunction MakeReadFunction() const {
+        HANDLE handle = processHandle;
+        return [handle](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+            SIZE_T read = 0;
+            BOOL ok = ReadProcessMemory(handle, reinterpret_cast<LPCVOID>(address), buffer, size, &read);
+            bytesRead = read;
+            return ok != FALSE;
+        };
     }
     
     void AnalyzeResults() {
@@ -552,13 +586,22 @@ int main() {
         return 1;
     }
     
-    std::wcout << L"스캔을 시작하려면 Enter를 누르세요..." << std::endl;
-    std::wcin.ignore(std::numeric_limits<std::streamsize>::max(), L'\n');
-    std::wcin.get();
+    std::wcout << L"최대 스캔 시간(초, 0 = 제한 없음)을 입력하면 스캔을 시작합니다: ";
+    int budgetSeconds = 0;
+    std::wcin >> budgetSeconds;
     
-    scanner.StartFullScan();
+    // 백그라운드에서 스캔하며 진행률 표시. ESC를 누르거나 시간이 다 되면 지금까지의 후보로 분석
+    auto job = ScanCore::StartScanJob([&scanner](ScanCore::ScanControl& control) {
+        scanner.StartFullScan(&control);
+    }, std::chrono::seconds(std::max(0, budgetSeconds)));
+    ScanCore::WaitScanJob(job, std::chrono::milliseconds(500), [](const ScanCore::ScanControl& progress) {
+        std::wcout << L"[진행 " << static_cast<int>(progress.Fraction() * 100) << L"%, 후보 "
+                   << progress.Hits() << L"개 (ESC: 중단)]" << std::endl;
+        return (GetAsyncKeyState(VK_ESCAPE) & 0x8000) == 0;
+    });
     
     std::wcout << L"스캔 완료. 아무 키나 누르면 종료됩니다." << std::endl;
+    std::wcin.ignore(std::numeric_limits<std::streamsize>::max(), L'\n');
     std::wcin.get();
     
     return 0;
@@ -16,6 +16,9 @@
 #include <vector>
 #include <iomanip>
 #include <cmath> // For std::isfinite
+#include <cstring>
+
+#include "../../../resources/scan-core/RegionStream.h"
 
 class FPSReader {
 private:
@@ -167,30 +170,33 @@ private:
                                            const std::vector<float>& targetValues) {
         std::vector<uintptr_t> foundAddresses;
         
-        // 메모리 영역 읽기
-        std::vector<uint8_t> buffer(regionSize);
-        SIZE_T bytesRead;
-        
-        if (!ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(baseAddress), 
-                              buffer.data(), regionSize, &bytesRead)) {
-            return foundAddresses;
-        }
+        // 메모리 영역을 1MB씩 나누어 읽기 (영역 크기만큼 버퍼를 할당하지 않음)
+        ScanCore::RegionStream stream([this](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+            SIZE_T read = 0;
+            BOOL ok = ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address), buffer, size, &read);
+            bytesRead = read;
+            return ok != FALSE;
+        });
         
-        // 4바이트씩 float 값으로 해석하여 스캔
-        for (SIZE_T i = 0; i <= bytesRead - sizeof(float); i += sizeof(float)) {
-            float value = *reinterpret_cast<const float*>(&buffer[i]);
-            
-            // 값이 유효한 범위인지 확인
-            if (value > 0.0f && value < 1000.0f && std::isfinite(value)) {
-                // 목표 값들과 비교
-                for (float targetFPS : targetValues) {
-                    if (abs(value - targetFPS) < 0.1f) {
-                        foundAddresses.push_back(baseAddress + i);
-                        break;
+        stream.ForEach(baseAddress, regionSize, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            // 4바이트씩 float 값으로 해석하여 스캔
+            for (size_t i = 0; i + sizeof(float) <= size; i += sizeof(float)) {
+                float value;
+                memcpy(&value, data + i, sizeof(float));
+                
+                // 값이 유효한 범위인지 확인
+                if (value > 0.0f && value < 1000.0f && std::isfinite(value)) {
+                    // 목표 값들과 비교
+                    for (float targetFPS : targetValues) {
+                        if (abs(value - targetFPS) < 0.1f) {
+                            foundAddresses.push_back(base + i);
+                            break;
+                        }
                     }
                 }
             }
-        }
+            return true;
+        });
         
         return foundAddresses;
     }
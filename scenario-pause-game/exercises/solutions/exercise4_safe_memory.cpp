@@ -15,12 +15,16 @@
 #include <iostream>
 #include <vector>
 #include <memory>
-#include <map>
 #include <string>
 
+#include "../../../resources/scan-core/ProcessMemory.h"
+#include "../../../resources/scan-core/RegionMap.h"
+#include "../../../resources/scan-core/RegionStream.h"
+#include "../../../resources/scan-core/CompiledPattern.h"
+
 class SafeMemoryManager {
 private:
-    HANDLE processHandle;
+    std::unique_ptr<ScanCore::IProcessMemory> memory;
     DWORD processId;
     std::wstring processName;
     
@@ -36,26 +40,21 @@ private:
     
     AccessStats stats;
     
-    // 메모리 영역 캐시
+    // 메모리 영역 정보
     struct MemoryRegion {
         uintptr_t baseAddress;
         size_t size;
-        DWORD protection;
+        uint32_t protection;    // ScanCore::MemoryProtectionFlags
         bool isReadable;
         bool isWritable;
         bool isExecutable;
     };
     
-    std::map<uintptr_t, MemoryRegion> regionCache;
+    // 주소 → 영역 맵 (한 번 열거해 두고 이진 탐색, 2초마다 또는 접근 실패 시 갱신)
+    std::unique_ptr<ScanCore::RegionMap> regionMap;
 
 public:
-    SafeMemoryManager() : processHandle(nullptr), processId(0) {}
-    
-    ~SafeMemoryManager() {
-        if (processHandle) {
-            CloseHandle(processHandle);
-        }
-    }
+    SafeMemoryManager() : processId(0) {}
     
     bool Initialize(const std::wstring& targetProcess) {
         processName = targetProcess;
@@ -65,15 +64,14 @@ public:
             return false;
         }
         
-        // 프로세스 핸들 열기
-        processHandle = OpenProcess(PROCESS_VM_READ | PROCESS_VM_WRITE |
-                                  PROCESS_VM_OPERATION | PROCESS_QUERY_INFORMATION,
-                                  FALSE, processId);
-        if (!processHandle) {
+        // 프로세스 메모리 백엔드 열기
+        memory = ScanCore::OpenProcessMemory(processId);
+        if (!memory) {
             std::wcout << L"프로세스 핸들 열기 실패. 오류: " << GetLastError() << std::endl;
             return false;
         }
         
+        regionMap = std::make_unique<ScanCore::RegionMap>(*memory);
         std::wcout << L"안전한 메모리 관리자 초기화 완료" << std::endl;
         return true;
     }
@@ -99,9 +97,8 @@ public:
             return MemoryAccessResult::InvalidAddress;
         }
         
-        // 메모리 영역 보호 속성 확인
-        auto region = GetMemoryRegion(address);
-        if (!region.isReadable) {
+        // 메모리 영역 보호 속성 확인 (영역 경계에 걸쳐도 모든 영역이 읽기 가능해야 함, 시스템 호출 없음)
+        if (!regionMap->IsReadable(address, size)) {
             stats.protectionViolations++;
             return MemoryAccessResult::ProtectionViolation;
         }
@@ -109,10 +106,8 @@ public:
         MemoryAccessResult result = MemoryAccessResult::UnknownError;
         
         __try {
-            SIZE_T bytesRead = 0;
-            BOOL success = ReadProcessMemory(processHandle,
-                                           reinterpret_cast<LPCVOID>(address),
-                                           buffer, size, &bytesRead);
+            size_t bytesRead = 0;
+            bool success = memory->ReadBytes(address, buffer, size, bytesRead);
             
             if (success && bytesRead == size) {
                 stats.successfulReads++;
@@ -130,6 +125,11 @@ public:
             result = MemoryAccessResult::AccessViolation;
         }
         
+        // 맵과 달리 읽지 못했으면 영역이 해제되었거나 보호 속성이 바뀐 것이므로 실패한 위치의 영역만 다시 확인
+        if (result != MemoryAccessResult::Success) {
+            RefreshAfterFault(address, size);
+        }
+        
         return result;
     }
     
@@ -146,28 +146,25 @@ public:
         
         // 메모리 영역 보호 속성 확인
         auto region = GetMemoryRegion(address);
-        if (!region.isWritable) {
+        if (!regionMap->IsWritable(address, size)) {
             stats.protectionViolations++;
             return MemoryAccessResult::ProtectionViolation;
         }
         
         MemoryAccessResult result = MemoryAccessResult::UnknownError;
-        DWORD oldProtection = 0;
+        uint32_t oldProtection = 0;
         bool protectionChanged = false;
         
         __try {
             // 필요한 경우 메모리 보호 속성 변경
-            if (!(region.protection & (PAGE_READWRITE | PAGE_EXECUTE_READWRITE))) {
-                if (VirtualProtectEx(processHandle, reinterpret_cast<LPVOID>(address),
-                                   size, PAGE_READWRITE, &oldProtection)) {
+            if (!(region.protection & ScanCore::MemoryWrite)) {
+                if (memory->Protect(address, size, ScanCore::MemoryRead | ScanCore::MemoryWrite, oldProtection)) {
                     protectionChanged = true;
                 }
             }
             
-            SIZE_T bytesWritten = 0;
-            BOOL success = WriteProcessMemory(processHandle,
-                                            reinterpret_cast<LPVOID>(address),
-                                            buffer, size, &bytesWritten);
+            size_t bytesWritten = 0;
+            bool success = memory->WriteBytes(address, buffer, size, bytesWritten);
             
             if (success && bytesWritten == size) {
                 stats.successfulWrites++;
@@ -182,9 +179,8 @@ public:
             
             // 메모리 보호 속성 복원
             if (protectionChanged) {
-                DWORD temp;
-                VirtualProtectEx(processHandle, reinterpret_cast<LPVOID>(address),
-                               size, oldProtection, &temp);
+                uint32_t temp;
+                memory->Protect(address, size, oldProtection, temp);
             }
         }
         __except (ExceptionFilter(GetExceptionCode(), address, size, true)) {
@@ -193,12 +189,15 @@ public:
             
             // 예외 발생 시에도 보호 속성 복원
             if (protectionChanged) {
-                DWORD temp;
-                VirtualProtectEx(processHandle, reinterpret_cast<LPVOID>(address),
-                               size, oldProtection, &temp);
+                uint32_t temp;
+                memory->Protect(address, size, oldProtection, temp);
             }
         }
         
+        if (result != MemoryAccessResult::Success) {
+            RefreshAfterFault(address, size);
+        }
+        
         return result;
     }
     
@@ -207,43 +206,13 @@ public:
             return false;
         }
         
-        MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(address),
-                          &mbi, sizeof(mbi)) == 0) {
-            return false;
-        }
-        
-        return mbi.State == MEM_COMMIT;
+        // 영역 맵에서 이진 탐색 (없으면 마지막 열거 후 2초가 지났을 때만 다시 열거)
+        return regionMap->Find(address) != nullptr;
     }
     
     MemoryRegion GetMemoryRegion(uintptr_t address) {
-        // 캐시에서 먼저 확인
-        auto it = regionCache.find(address);
-        if (it != regionCache.end()) {
-            return it->second;
-        }
-        
-        MemoryRegion region = {};
-        MEMORY_BASIC_INFORMATION mbi;
-        
-        if (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(address),
-                          &mbi, sizeof(mbi)) != 0) {
-            region.baseAddress = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
-            region.size = mbi.RegionSize;
-            region.protection = mbi.Protect;
-            
-            // 접근 권한 분석
-            region.isReadable = (mbi.Protect & (PAGE_READONLY | PAGE_READWRITE |
-                                              PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE)) != 0;
-            region.isWritable = (mbi.Protect & (PAGE_READWRITE | PAGE_EXECUTE_READWRITE)) != 0;
-            region.isExecutable = (mbi.Protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ |
-                                                PAGE_EXECUTE_READWRITE)) != 0;
-            
-            // 캐시에 저장
-            regionCache[address] = region;
-        }
-        
-        return region;
+        const ScanCore::MemoryRegion* info = regionMap->Find(address);
+        return info ? ToRegion(*info) : MemoryRegion{};
     }
     
     std::vector<uintptr_t> ScanMemoryPattern(const std::vector<uint8_t>& pattern,
@@ -254,58 +223,39 @@ public:
             return results;
         }
         
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
+        // 패턴은 한 번만 컴파일해서 모든 영역에 사용
+        ScanCore::CompiledPattern compiled(pattern, mask);
         
-        uintptr_t currentAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMinimumApplicationAddress);
-        uintptr_t maxAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMaximumApplicationAddress);
-        
-        while (currentAddress < maxAddress) {
-            MEMORY_BASIC_INFORMATION mbi;
-            if (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(currentAddress), &mbi, sizeof(mbi)) == 0) {
-                break;
-            }
-            
-            if (mbi.State == MEM_COMMIT && mbi.Protect != PAGE_NOACCESS) {
-                auto regionResults = ScanRegionForPattern(currentAddress, mbi.RegionSize,
-                                                        pattern, mask);
+        for (const ScanCore::MemoryRegion& region : memory->EnumerateRegions()) {
+            if (region.protection != ScanCore::MemoryNoAccess) {
+                auto regionResults = ScanRegionForPattern(region.base, region.size, compiled);
                 results.insert(results.end(), regionResults.begin(), regionResults.end());
             }
-            
-            currentAddress += mbi.RegionSize;
         }
         
         return results;
     }
     
     std::vector<uintptr_t> ScanRegionForPattern(uintptr_t baseAddress, size_t regionSize,
-                                              const std::vector<uint8_t>& pattern,
-                                              const std::vector<bool>& mask) {
+                                              const ScanCore::CompiledPattern& pattern) {
         std::vector<uintptr_t> results;
         
-        // 안전한 청크 단위로 읽기 (1MB씩)
-        const size_t chunkSize = 1024 * 1024;
-        std::vector<uint8_t> buffer(chunkSize);
-        
-        auto readResult = SafeRead(baseAddress, buffer.data(), regionSize);
-        if (readResult == MemoryAccessResult::Success ||
-            readResult == MemoryAccessResult::PartialAccess) {
-            
-            // 패턴 검색
-            for (size_t i = 0; i <= regionSize - pattern.size(); ++i) {
-                bool match = true;
-                for (size_t j = 0; j < pattern.size(); ++j) {
-                    if (mask[j] && buffer[i + j] != pattern[j]) {
-                        match = false;
-                        break;
-                    }
-                }
-                
-                if (match) {
-                    results.push_back(baseAddress + i);
-                }
-            }
-        }
+        // 안전한 청크 단위로 읽기 (1MB씩, 버퍼 2개를 번갈아 사용)
+        // 청크 경계에 걸친 패턴을 찾기 위해 패턴 길이 - 1 바이트를 다음 청크로 넘김
+        ScanCore::RegionStreamConfig config;
+        config.chunkSize = 1024 * 1024;
+        config.overlap = pattern.Size() - 1;
+        ScanCore::RegionStream stream([this](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+            // SafeRead는 부분 읽기 크기를 알려주지 않으므로 실패하면 청크 전체를 건너뜀
+            bytesRead = SafeRead(address, buffer, size) == MemoryAccessResult::Success ? size : 0;
+            return bytesRead == size;
+        }, config);
+        
+        stream.ForEach(baseAddress, regionSize, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            // 패턴 검색 (앵커 바이트로 건너뛰고 후보만 마스크 비교)
+            pattern.FindAll(data, size, base, results);
+            return true;
+        });
         
         return results;
     }
@@ -319,6 +269,11 @@ public:
         std::wcout << L"보호 위반: " << stats.protectionViolations << std::endl;
         std::wcout << L"접근 위반: " << stats.accessViolations << std::endl;
         
+        const ScanCore::RegionMap::Stats& mapStats = regionMap->GetStats();
+        std::wcout << L"영역 맵: " << regionMap->Size() << L"개 영역, 조회 " << mapStats.lookups
+                   << L"회 (없음 " << mapStats.misses << L"), 전체 열거 " << mapStats.fullRefreshes
+                   << L"회, 영역 재확인 " << mapStats.regionQueries << L"회" << std::endl;
+        
         size_t totalOperations = stats.successfulReads + stats.failedReads +
                                stats.successfulWrites + stats.failedWrites;
         if (totalOperations > 0) {
@@ -329,8 +284,8 @@ public:
     }
     
     void ClearCache() {
-        regionCache.clear();
-        std::wcout << L"메모리 영역 캐시가 지워졌습니다." << std::endl;
+        regionMap->Invalidate();
+        std::wcout << L"메모리 영역 맵을 다음 접근 때 다시 열거합니다." << std::endl;
     }
     
     std::wstring GetResultDescription(MemoryAccessResult result) {
@@ -412,6 +367,14 @@ private:
         return true;
     }
     
+    // 실패한 구간의 시작과 끝 영역을 다시 확인 (영역 경계에 걸친 접근이면 둘이 다름)
+    void RefreshAfterFault(uintptr_t address, size_t size) {
+        regionMap->RefreshAround(address);
+        if (size > 1) {
+            regionMap->RefreshAround(address + size - 1);
+        }
+    }
+    
     int ExceptionFilter(DWORD exceptionCode, uintptr_t address, size_t size, bool isWrite) {
         std::wcout << L"메모리 접근 예외 발생:" << std::endl;
         std::wcout << L"  주소: 0x" << std::hex << address << std::dec << std::endl;
@@ -440,38 +403,26 @@ private:
     std::vector<MemoryRegion> FindValidMemoryRegions() {
         std::vector<MemoryRegion> regions;
         
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
-        
-        uintptr_t currentAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMinimumApplicationAddress);
-        uintptr_t maxAddress = reinterpret_cast<uintptr_t>(sysInfo.lpMaximumApplicationAddress);
-        
-        while (currentAddress < maxAddress) {
-            MEMORY_BASIC_INFORMATION mbi;
-            if (VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(currentAddress),
-                              &mbi, sizeof(mbi)) == 0) {
-                break;
+        for (const ScanCore::MemoryRegion& info : memory->EnumerateRegions()) {
+            if (info.protection != ScanCore::MemoryNoAccess) {
+                regions.push_back(ToRegion(info));
             }
-            
-            if (mbi.State == MEM_COMMIT && mbi.Protect != PAGE_NOACCESS) {
-                MemoryRegion region;
-                region.baseAddress = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
-                region.size = mbi.RegionSize;
-                region.protection = mbi.Protect;
-                region.isReadable = (mbi.Protect & (PAGE_READONLY | PAGE_READWRITE |
-                                                  PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE)) != 0;
-                region.isWritable = (mbi.Protect & (PAGE_READWRITE | PAGE_EXECUTE_READWRITE)) != 0;
-                region.isExecutable = (mbi.Protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ |
-                                                    PAGE_EXECUTE_READWRITE)) != 0;
-                
-                regions.push_back(region);
-            }
-            
-            currentAddress += mbi.RegionSize;
         }
         
         return regions;
     }
+    
+    // 백엔드 영역 정보를 캐시용 구조로 변환 (쓰기 시 복사 페이지는 쓰기 가능으로 보지 않음)
+    static MemoryRegion ToRegion(const ScanCore::MemoryRegion& info) {
+        MemoryRegion region;
+        region.baseAddress = info.base;
+        region.size = info.size;
+        region.protection = info.protection;
+        region.isReadable = info.IsReadable();
+        region.isWritable = info.IsWritable();
+        region.isExecutable = info.IsExecutable();
+        return region;
+    }
 };
 
 int main() {
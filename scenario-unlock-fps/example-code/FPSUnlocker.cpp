@@ -2,22 +2,25 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <cstring>
+#include "scan-core/ScanExecutor.h"
+#include "scan-core/FloatScanKernels.h"
+#include "scan-core/ProcessMemory.h"
+#include "scan-core/WriteTransaction.h"
 
 // FPS Presets
 const float AdvancedFPSController::FPS_PRESETS[] = {30.0f, 60.0f, 120.0f, 144.0f, 240.0f, 0.0f}; // 0.0f = unlimited
 const int AdvancedFPSController::PRESET_COUNT = sizeof(FPS_PRESETS) / sizeof(float);
 
-FPSUnlocker::FPSUnlocker() : processHandle(nullptr), processId(0), 
-                             fpsAddress(0), originalFPS(60.0f), isUnlocked(false) {
+FPSUnlocker::FPSUnlocker() : processId(0), 
+                             fpsAddress(0), originalFPS(60.0f), isUnlocked(false),
+                             cachePath("fps_unlocker.cache") {
 }
 
 FPSUnlocker::~FPSUnlocker() {
     if (isUnlocked) {
         RestoreFPS();
     }
-    if (processHandle) {
-        CloseHandle(processHandle);
-    }
 }
 
 bool FPSUnlocker::Initialize(const std::wstring& processName) {
@@ -35,8 +38,8 @@ bool FPSUnlocker::Initialize(const std::wstring& processName) {
     }
 
     // Open process with required permissions
-    processHandle = OpenProcess(PROCESS_ALL_ACCESS, FALSE, processId);
-    if (!processHandle) {
+    memory = ScanCore::OpenProcessMemory(processId);
+    if (!memory) {
         std::cout << "Failed to open process. Run as administrator." << std::endl;
         return false;
     }
@@ -45,6 +48,13 @@ bool FPSUnlocker::Initialize(const std::wstring& processName) {
     return true;
 }
 
+bool FPSUnlocker::Initialize(std::unique_ptr<ScanCore::IProcessMemory> source) {
+    // Attach to an already opened backend (memory dump, local test process)
+    memory = std::move(source);
+    processId = 0;
+    return memory != nullptr;
+}
+
 DWORD FPSUnlocker::GetProcessIdByName(const std::wstring& processName) {
     PROCESSENTRY32W pe32;
     pe32.dwSize = sizeof(PROCESSENTRY32W);
@@ -83,40 +93,29 @@ bool FPSUnlocker::IsValidGameProcess(DWORD pid) {
 }
 
 std::vector<uintptr_t> FPSUnlocker::ScanForFloat(float value) {
-    std::vector<uintptr_t> results;
-    
-    MEMORY_BASIC_INFORMATION mbi;
-    uintptr_t address = 0;
-    
-    std::cout << "Scanning for FPS value: " << value << std::endl;
-    
-    while (VirtualQueryEx(processHandle, (LPCVOID)address, &mbi, sizeof(mbi))) {
-        // Only scan committed memory that's readable/writable
-        if (mbi.State == MEM_COMMIT && 
-            (mbi.Protect & PAGE_READWRITE || mbi.Protect & PAGE_EXECUTE_READWRITE)) {
-            
-            std::vector<char> buffer(mbi.RegionSize);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, mbi.BaseAddress, 
-                                buffer.data(), mbi.RegionSize, &bytesRead)) {
-                
-                // Search for float value (allowing small floating point errors)
-                for (size_t i = 0; i <= bytesRead - sizeof(float); i += sizeof(float)) {
-                    float* floatPtr = reinterpret_cast<float*>(&buffer[i]);
-                    if (abs(*floatPtr - value) < 0.001f) {
-                        uintptr_t foundAddress = (uintptr_t)mbi.BaseAddress + i;
-                        results.push_back(foundAddress);
-                        
-                        if (results.size() % 100 == 0) {
-                            std::cout << "Found " << results.size() << " potential addresses..." << std::endl;
-                        }
-                    }
-                }
-            }
-        }
-        address = (uintptr_t)mbi.BaseAddress + mbi.RegionSize;
-    }
+    return ScanForFloats({value});
+}
+
+std::vector<uintptr_t> FPSUnlocker::ScanForFloats(const std::vector<float>& values, float tolerance) {
+    std::cout << "Scanning for " << values.size() << " FPS value(s):";
+    for (float value : values) std::cout << " " << value;
+    std::cout << std::endl;
+    
+    // Only scan committed memory that's readable/writable
+    std::vector<ScanCore::MemoryRange> regions = memory->CollectRanges(
+        [](const ScanCore::MemoryRegion& region) { return region.IsWritable(); });
+    
+    // Match all values (allowing small floating point errors) in one SIMD pass over 4-byte aligned floats.
+    // Up to 16 values fit in one condition; NaN and denormal garbage never match.
+    ScanCore::FloatCondition<float> condition = ScanCore::FloatCondition<float>::AnyOf(values.begin(), values.end(), tolerance);
+    
+    // Regions are split into 1MB work units and scanned on all cores.
+    // Unit boundaries stay 4-byte aligned, so the aligned float walk needs no overlap.
+    ScanCore::ScanExecutor executor;
+    std::vector<uintptr_t> results = executor.Run(regions, memory->MakeReadFunction(),
+        [&condition](const uint8_t* data, size_t size, uintptr_t baseAddress, std::vector<uintptr_t>& out) {
+            ScanCore::FindFloat(data, size, condition, baseAddress, out);
+        });
     
     std::cout << "Total addresses found: " << results.size() << std::endl;
     return results;
@@ -125,15 +124,26 @@ std::vector<uintptr_t> FPSUnlocker::ScanForFloat(float value) {
 bool FPSUnlocker::FindFPSLimit() {
     std::cout << "Searching for FPS limit..." << std::endl;
     
-    // First scan for common FPS values
-    std::vector<float> commonFPS = {60.0f, 30.0f, 120.0f, 144.0f};
-    std::vector<uintptr_t> allAddresses;
-    
-    for (float fps : commonFPS) {
-        auto addresses = ScanForFloat(fps);
-        allAddresses.insert(allAddresses.end(), addresses.begin(), addresses.end());
+    // Instant attach: if the module holding the limit is the same build as last time,
+    // the cached address is confirmed with a single read instead of a full scan
+    std::vector<ScanCore::ModuleRange> modules;
+    if (!cachePath.empty()) {
+        modules = memory->EnumerateModules();
+        resolutionCache.Load(cachePath);
+        uintptr_t cached = 0;
+        if (resolutionCache.Lookup(*memory, modules, "fps_limit", cached) && ValidateAddress(cached)) {
+            fpsAddress = cached;
+            originalFPS = ReadFloat(cached);
+            std::cout << "FPS address found (cached): 0x" << std::hex << cached << std::dec;
+            std::cout << " (Current value: " << originalFPS << ")" << std::endl;
+            return true;
+        }
     }
     
+    // First scan for common FPS values (all of them in a single pass)
+    std::vector<float> commonFPS = {60.0f, 30.0f, 120.0f, 144.0f};
+    std::vector<uintptr_t> allAddresses = ScanForFloats(commonFPS);
+    
     if (allAddresses.empty()) {
         std::cout << "No FPS values found. Game might use different storage method." << std::endl;
         return false;
@@ -148,6 +158,12 @@ bool FPSUnlocker::FindFPSLimit() {
             originalFPS = ReadFloat(addr);
             std::cout << "FPS address found: 0x" << std::hex << addr << std::dec;
             std::cout << " (Current value: " << originalFPS << ")" << std::endl;
+            
+            // Static limits (inside a module image) are cached by module fingerprint only: the limit value
+            // changes with SetFPS and the game's settings, and ValidateAddress confirms the cached address
+            if (!cachePath.empty() && resolutionCache.Store(*memory, modules, "fps_limit", addr, addr, 0)) {
+                resolutionCache.Save(cachePath);
+            }
             return true;
         }
     }
@@ -163,7 +179,8 @@ bool FPSUnlocker::ValidateAddress(uintptr_t address) {
         return false; // Unreasonable FPS value
     }
     
-    // Test write access
+    // Test write access (one candidate at a time, restored right away, so a bogus
+    // candidate is never left modified while the next one is tested)
     float testValue = currentValue + 1.0f;
     if (!WriteFloat(address, testValue)) {
         return false;
@@ -228,14 +245,15 @@ float FPSUnlocker::GetCurrentFPS() {
 
 float FPSUnlocker::ReadFloat(uintptr_t address) {
     float value = 0.0f;
-    SIZE_T bytesRead;
-    ReadProcessMemory(processHandle, (LPCVOID)address, &value, sizeof(float), &bytesRead);
+    memory->ReadValue(address, value);
     return value;
 }
 
 bool FPSUnlocker::WriteFloat(uintptr_t address, float value) {
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(processHandle, (LPVOID)address, &value, sizeof(float), &bytesWritten);
+    // Limits stored in read-only data are made writable for the write and restored afterwards
+    ScanCore::WriteTransaction transaction(*memory);
+    transaction.Add(address, value);
+    return transaction.Commit().Ok();
 }
 
 // Advanced FPS Controller Implementation
@@ -405,50 +423,45 @@ LRESULT CALLBACK AdvancedFPSController::WindowProc(HWND hwnd, UINT uMsg, WPARAM
 
 // FPS Utils Implementation
 namespace FPSUtils {
-    FPSMonitor::FPSMonitor(size_t sampleCount) : maxSamples(sampleCount) {
-        frameTimes.reserve(maxSamples);
+    FPSMonitor::FPSMonitor(size_t sampleCount) : frameStats(sampleCount) {
         lastFrame = std::chrono::steady_clock::now();
     }
     
     void FPSMonitor::RecordFrame() {
         auto now = std::chrono::steady_clock::now();
-        float frameTime = std::chrono::duration<float>(now - lastFrame).count();
+        double frameTime = std::chrono::duration<double, std::milli>(now - lastFrame).count();
         lastFrame = now;
         
-        if (frameTime > 0.0f) {
-            frameTimes.push_back(frameTime);
-            if (frameTimes.size() > maxSamples) {
-                frameTimes.erase(frameTimes.begin());
-            }
-        }
+        // Non-positive frame times are ignored by FrameStats
+        frameStats.Add(frameTime);
     }
     
-    float FPSMonitor::GetAverageFPS() {
-        if (frameTimes.empty()) return 0.0f;
-        
-        float total = 0.0f;
-        for (float time : frameTimes) {
-            total += time;
-        }
-        return frameTimes.size() / total;
+    float FPSMonitor::GetAverageFPS() const {
+        return static_cast<float>(frameStats.AverageFPS());
     }
     
-    float FPSMonitor::GetMinFPS() {
-        if (frameTimes.empty()) return 0.0f;
-        
-        float maxTime = *std::max_element(frameTimes.begin(), frameTimes.end());
-        return 1.0f / maxTime;
+    float FPSMonitor::GetMinFPS() const {
+        return static_cast<float>(frameStats.MinimumFPS());
     }
     
-    float FPSMonitor::GetMaxFPS() {
-        if (frameTimes.empty()) return 0.0f;
-        
-        float minTime = *std::min_element(frameTimes.begin(), frameTimes.end());
-        return 1.0f / minTime;
+    float FPSMonitor::GetMaxFPS() const {
+        return static_cast<float>(frameStats.MaximumFPS());
+    }
+    
+    float FPSMonitor::Get1PercentLowFPS() const {
+        return static_cast<float>(frameStats.LowFPS(0.01));
+    }
+    
+    float FPSMonitor::GetPoint1PercentLowFPS() const {
+        return static_cast<float>(frameStats.LowFPS(0.001));
+    }
+    
+    float FPSMonitor::GetP99FrameTime() const {
+        return static_cast<float>(frameStats.Percentile(0.99));
     }
     
     void FPSMonitor::Reset() {
-        frameTimes.clear();
+        frameStats.Reset();
         lastFrame = std::chrono::steady_clock::now();
     }
     
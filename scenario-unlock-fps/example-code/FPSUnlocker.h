@@ -2,7 +2,11 @@
 #include <Windows.h>
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <TlHelp32.h>
+#include "scan-core/ProcessMemory.h"
+#include "scan-core/SignatureCache.h"
+#include "scan-core/FrameStats.h"
 
 /**
  * FPS Unlocker for Games
@@ -19,11 +23,15 @@
  */
 class FPSUnlocker {
 private:
-    HANDLE processHandle;
+    std::unique_ptr<ScanCore::IProcessMemory> memory;   // Win32 process, or any other backend (dump, test process)
     DWORD processId;
     uintptr_t fpsAddress;
     float originalFPS;
     bool isUnlocked;
+    
+    // Address found on the last attach, keyed by module build (skips the scan when unchanged)
+    ScanCore::SignatureCache resolutionCache;
+    std::string cachePath;
 
 public:
     FPSUnlocker();
@@ -31,19 +39,25 @@ public:
     
     // Main functionality
     bool Initialize(const std::wstring& processName);
+    bool Initialize(std::unique_ptr<ScanCore::IProcessMemory> source);
     bool FindFPSLimit();
     bool SetFPS(float targetFPS);
     bool RestoreFPS();
     float GetCurrentFPS();
     
     // Status
-    bool IsInitialized() const { return processHandle != nullptr; }
+    bool IsInitialized() const { return memory != nullptr; }
     bool IsUnlocked() const { return isUnlocked; }
     uintptr_t GetFPSAddress() const { return fpsAddress; }
+    
+    // Resolution cache (default "fps_unlocker.cache", empty path disables it)
+    void SetCachePath(const std::string& path) { cachePath = path; }
+    const ScanCore::SignatureCache::Stats& GetCacheStats() const { return resolutionCache.GetStats(); }
 
 private:
     // Memory scanning
     std::vector<uintptr_t> ScanForFloat(float value);
+    std::vector<uintptr_t> ScanForFloats(const std::vector<float>& values, float tolerance = 0.001f);
     bool ValidateAddress(uintptr_t address);
     
     // Memory operations
@@ -113,19 +127,24 @@ private:
 namespace FPSUtils {
     /**
      * Calculate actual FPS from frame times
+     * Rolling window over the last sampleCount frames; every query is O(1) or O(log n) (scan-core FrameStats)
      */
     class FPSMonitor {
     private:
-        std::vector<float> frameTimes;
+        ScanCore::FrameStats frameStats;
         std::chrono::steady_clock::time_point lastFrame;
-        size_t maxSamples;
 
     public:
         FPSMonitor(size_t sampleCount = 60);
         void RecordFrame();
-        float GetAverageFPS();
-        float GetMinFPS();
-        float GetMaxFPS();
+        float GetAverageFPS() const;
+        float GetMinFPS() const;
+        float GetMaxFPS() const;
+        // FPS at the slowest 1% / 0.1% of frames in the window
+        float Get1PercentLowFPS() const;
+        float GetPoint1PercentLowFPS() const;
+        // 99th percentile frame time in milliseconds
+        float GetP99FrameTime() const;
         void Reset();
     };
 
@@ -61,6 +61,9 @@ void MonitorFPS(FPSUnlocker& unlocker) {
     std::cout << "  Average: " << monitor.GetAverageFPS() << " FPS" << std::endl;
     std::cout << "  Minimum: " << monitor.GetMinFPS() << " FPS" << std::endl;
     std::cout << "  Maximum: " << monitor.GetMaxFPS() << " FPS" << std::endl;
+    std::cout << "  1% low: " << monitor.Get1PercentLowFPS() << " FPS" << std::endl;
+    std::cout << "  0.1% low: " << monitor.GetPoint1PercentLowFPS() << " FPS" << std::endl;
+    std::cout << "  p99 frame time: " << monitor.GetP99FrameTime() << " ms" << std::endl;
 }
 
 int main() {
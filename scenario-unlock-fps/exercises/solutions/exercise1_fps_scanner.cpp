@@ -19,6 +19,10 @@
 #include <thread>
 #include <chrono>
 #include <cmath> // For std::isfinite
+#include <cstring>
+
+#include "../../../resources/scan-core/RegionStream.h"
+#include "../../../resources/scan-core/ScanJob.h"
 
 class FPSScanner {
 private:
@@ -62,15 +66,27 @@ public:
         return true;
     }
     
-    std::vector<ScanResult> ScanForFPSLimit() {
+    // control이 있으면 진행률(읽은 바이트, 후보 수)을 기록하고, 취소/시간 초과 시 지금까지 찾은 후보만 검증
+    std::vector<ScanResult> ScanForFPSLimit(ScanCore::ScanControl* control = nullptr) {
         std::wcout << L"FPS 제한 값 스캔 시작..." << std::endl;
         
         // 1차 스캔: 일반적인 FPS 값들
         std::vector<float> commonFPS = {30.0f, 60.0f, 75.0f, 90.0f, 120.0f, 144.0f, 165.0f, 240.0f};
         std::vector<ScanResult> candidates;
         
+        std::vector<ScanCore::MemoryRange> ranges = CollectWritableRanges();
+        if (control) {
+            size_t total = 0;
+            for (const ScanCore::MemoryRange& range : ranges) total += range.size;
+            control->AddTotal(total * commonFPS.size());
+        }
+        
         for (float targetFPS : commonFPS) {
-            auto addresses = ScanMemoryForFloat(targetFPS);
+            if (control && control->ShouldStop()) {
+                std::wcout << L"스캔 중단됨. 지금까지 찾은 후보만 검증합니다." << std::endl;
+                break;
+            }
+            auto addresses = ScanMemoryForFloat(ranges, targetFPS, control);
             std::wcout << L"FPS " << targetFPS << L": " << addresses.size() << L"개 주소 발견" << std::endl;
             
             for (uintptr_t addr : addresses) {
@@ -98,8 +114,9 @@ public:
         return validatedResults;
     }
     
-    std::vector<uintptr_t> ScanMemoryForFloat(float targetValue) {
-        std::vector<uintptr_t> foundAddresses;
+    // 쓰기 가능한 메모리 영역만 스캔 (FPS 설정 값이 저장될 가능성이 높음)
+    std::vector<ScanCore::MemoryRange> CollectWritableRanges() {
+        std::vector<ScanCore::MemoryRange> ranges;
         
         SYSTEM_INFO sysInfo;
         GetSystemInfo(&sysInfo);
@@ -113,41 +130,49 @@ public:
                 break;
             }
             
-            // 쓰기 가능한 메모리 영역만 스캔 (FPS 설정 값이 저장될 가능성이 높음)
             if (mbi.State == MEM_COMMIT && 
                 (mbi.Protect == PAGE_READWRITE || mbi.Protect == PAGE_EXECUTE_READWRITE)) {
-                
-                auto addresses = ScanRegionForFloat(currentAddress, mbi.RegionSize, targetValue);
-                foundAddresses.insert(foundAddresses.end(), addresses.begin(), addresses.end());
+                ranges.push_back({currentAddress, mbi.RegionSize});
             }
             
             currentAddress += mbi.RegionSize;
         }
         
-        return foundAddresses;
+        return ranges;
     }
     
-    std::vector<uintptr_t> ScanRegionForFloat(uintptr_t baseAddress, SIZE_T regionSize, float targetValue) {
+    std::vector<uintptr_t> ScanMemoryForFloat(const std::vector<ScanCore::MemoryRange>& ranges, float targetValue,
+                                              ScanCore::ScanControl* control = nullptr) {
         std::vector<uintptr_t> foundAddresses;
         
-        // 메모리 읽기
-        std::vector<uint8_t> buffer(regionSize);
-        SIZE_T bytesRead;
-        
-        if (!ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(baseAddress), 
-                              buffer.data(), regionSize, &bytesRead)) {
-            return foundAddresses;
-        }
+        // 메모리를 1MB씩 나누어 읽기 (다음 청크를 읽는 동안 현재 청크를 비교)
+        ScanCore::RegionStream stream([this](uintptr_t address, uint8_t* buffer, size_t size, size_t& bytesRead) {
+            SIZE_T read = 0;
+            BOOL ok = ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address), buffer, size, &read);
+            bytesRead = read;
+            return ok != FALSE;
+        });
         
-        // 4바이트 정렬된 위치에서 float 값 검색
-        for (SIZE_T i = 0; i <= bytesRead - sizeof(float); i += sizeof(float)) {
-            float value = *reinterpret_cast<const float*>(&buffer[i]);
+        stream.ForEach(ranges, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            size_t before = foundAddresses.size();
             
-            // 목표 값과 비교 (약간의 오차 허용)
-            if (abs(value - targetValue) < 0.01f) {
-                foundAddresses.push_back(baseAddress + i);
+            // 4바이트 정렬된 위치에서 float 값 검색
+            for (size_t i = 0; i + sizeof(float) <= size; i += sizeof(float)) {
+                float value;
+                memcpy(&value, data + i, sizeof(float));
+                
+                // 목표 값과 비교 (약간의 오차 허용)
+                if (abs(value - targetValue) < 0.01f) {
+                    foundAddresses.push_back(base + i);
+                }
             }
-        }
+            
+            // 청크마다 진행률을 올리고, 취소되었으면 스트림 중단
+            if (!control) return true;
+            control->AddDone(size);
+            control->AddHits(foundAddresses.size() - before);
+            return !control->ShouldStop();
+        });
         
         return foundAddresses;
     }
@@ -373,7 +398,16 @@ int main() {
         
         switch (choice) {
             case 1: {
-                scanResults = scanner.ScanForFPSLimit();
+                // 백그라운드에서 스캔하며 진행률 표시. ESC를 누르면 지금까지 찾은 후보만 검증
+                auto job = ScanCore::StartScanJob([&scanner](ScanCore::ScanControl& control) {
+                    return scanner.ScanForFPSLimit(&control);
+                });
+                scanResults = ScanCore::WaitScanJob(job, std::chrono::milliseconds(200), [](const ScanCore::ScanControl& progress) {
+                    std::wcout << L"\r진행 " << static_cast<int>(progress.Fraction() * 100) << L"%, 후보 "
+                               << progress.Hits() << L"개 (ESC: 중단)   " << std::flush;
+                    return (GetAsyncKeyState(VK_ESCAPE) & 0x8000) == 0;
+                });
+                std::wcout << std::endl;
                 
                 if (!scanResults.empty()) {
                     std::wcout << L"\n스캔 결과:" << std::endl;
@@ -20,12 +20,22 @@
 #include <json/json.h>
 #include <algorithm>
 #include <cmath> // For std::isfinite
+#include <sstream>
+#include <memory>
+
+#include "../../../resources/scan-core/ProcessMemory.h"
+#include "../../../resources/scan-core/RegionStream.h"
+#include "../../../resources/scan-core/SignatureSet.h"
+#include "../../../resources/scan-core/PointerScanner.h"
+#include "../../../resources/scan-core/PointerMapFile.h"
+#include "../../../resources/scan-core/SignatureCache.h"
 
 #pragma comment(lib, "jsoncpp.lib")
 
 class DynamicAddressTracker {
 private:
-    HANDLE processHandle;
+    HANDLE processHandle;   // 모듈 정보 조회(PSAPI)용
+    std::unique_ptr<ScanCore::IProcessMemory> memory;   // 메모리 읽기는 백엔드를 통해
     DWORD processId;
     std::wstring processName;
     
@@ -43,6 +53,7 @@ private:
         std::string description;
         bool isValid;
         uintptr_t lastResolvedAddress;
+        uintptr_t finalOffset = 0;     // 마지막 역참조 뒤에 더할 오프셋 (자동 생성 경로)
     };
     
     struct SignaturePattern {
@@ -57,14 +68,18 @@ private:
     std::vector<PointerPath> knownPaths;
     std::vector<SignaturePattern> signatures;
     std::string configFile;
+    std::string signatureCacheFile;     // 모듈 빌드가 같으면 시그니처 스캔 없이 지난 결과 재사용
+    ScanCore::SignatureCache signatureCache;
 
 public:
     DynamicAddressTracker() : processHandle(nullptr), processId(0) {
         configFile = "fps_addresses.json";
+        signatureCacheFile = "fps_signatures.cache";
         LoadKnownPatterns();
     }
     
     ~DynamicAddressTracker() {
+        memory.reset();
         if (processHandle) {
             CloseHandle(processHandle);
         }
@@ -84,6 +99,7 @@ public:
             std::wcout << L"프로세스 핸들 열기 실패. 오류: " << GetLastError() << std::endl;
             return false;
         }
+        memory = std::make_unique<ScanCore::Win32ProcessMemory>(processHandle);
         
         // 모듈 정보 수집
         if (!CollectModules()) {
@@ -181,66 +197,92 @@ public:
     std::vector<uintptr_t> ScanSignatures() {
         std::vector<uintptr_t> results;
         
-        for (const auto& sig : signatures) {
-            std::wcout << L"  패턴 검색: " << std::wstring(sig.name.begin(), sig.name.end()) << std::endl;
-            
-            for (const auto& module : modules) {
-                auto addresses = ScanModuleForSignature(module.second, sig);
-                for (uintptr_t addr : addresses) {
-                    uintptr_t targetAddr = ResolveSignatureAddress(addr, sig);
-                    if (targetAddr != 0 && IsValidFPSAddress(targetAddr)) {
-                        results.push_back(targetAddr);
-                        std::wcout << L"    발견: 0x" << std::hex << targetAddr << std::dec << std::endl;
-                    }
-                }
-            }
+        std::vector<ScanCore::ModuleRange> moduleRanges;
+        for (const auto& module : modules) {
+            moduleRanges.push_back({module.second.name, module.second.baseAddress, module.second.size});
         }
         
-        return results;
-    }
-    
-    std::vector<uintptr_t> ScanModuleForSignature(const ModuleInfo& module, const SignaturePattern& signature) {
-        std::vector<uintptr_t> results;
+        // 캐시 조회: 모듈 지문이 같으면 검증 읽기 한 번으로 끝. 나머지만 스캔
+        signatureCache.Load(signatureCacheFile);
+        signatureCache.ResetStats();
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < signatures.size(); ++i) {
+            uintptr_t cached = 0;
+            if (signatureCache.Lookup(*memory, moduleRanges, signatures[i].name, cached) && IsValidFPSAddress(cached)) {
+                results.push_back(cached);
+                std::wcout << L"    " << std::wstring(signatures[i].name.begin(), signatures[i].name.end())
+                           << L" 캐시: 0x" << std::hex << cached << std::dec << std::endl;
+            } else {
+                pending.push_back(i);
+            }
+        }
         
-        const size_t chunkSize = 1024 * 1024; // 1MB씩 스캔
-        std::vector<uint8_t> buffer(chunkSize);
+        // 캐시에 없는 시그니처만 오토마톤 하나로 합쳐 모듈마다 한 번만 스캔 (id = pending 인덱스)
+        ScanCore::SignatureSet signatureSet;
+        for (size_t i : pending) {
+            signatureSet.Add(signatures[i].bytes, signatures[i].mask);
+        }
+        signatureSet.Build();
+        std::wcout << L"  시그니처 " << signatureSet.Count() << L"개 동시 검색" << std::endl;
         
-        for (size_t offset = 0; offset < module.size; offset += chunkSize) {
-            size_t readSize = std::min(chunkSize, module.size - offset);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(module.baseAddress + offset),
-                                 buffer.data(), readSize, &bytesRead)) {
-                
-                for (size_t i = 0; i <= bytesRead - signature.bytes.size(); ++i) {
-                    if (MatchesSignature(buffer.data() + i, signature)) {
-                        results.push_back(module.baseAddress + offset + i);
+        bool stored = false;
+        for (const auto& module : modules) {
+            if (signatureSet.Count() == 0) break;
+            for (const ScanCore::SignatureMatch& match : ScanModuleForSignatures(module.second, signatureSet)) {
+                const SignaturePattern& sig = signatures[pending[match.id]];
+                uintptr_t targetAddr = ResolveSignatureAddress(match.address, sig);
+                if (targetAddr != 0 && IsValidFPSAddress(targetAddr)) {
+                    results.push_back(targetAddr);
+                    std::wcout << L"    " << std::wstring(sig.name.begin(), sig.name.end())
+                               << L" 발견: 0x" << std::hex << targetAddr << std::dec << std::endl;
+                    
+                    // 시그니처당 첫 결과만 저장. 검증 바이트 = 일치한 명령어 바이트
+                    if (!signatureCache.Contains(sig.name)) {
+                        stored |= signatureCache.Store(*memory, moduleRanges, sig.name, targetAddr, match.address, sig.bytes.size());
                     }
                 }
             }
         }
         
+        const ScanCore::SignatureCache::Stats& stats = signatureCache.GetStats();
+        if (stored || stats.invalidated > 0) {
+            signatureCache.Save(signatureCacheFile);
+        }
+        std::wcout << L"  캐시: 적중 " << stats.hits << L", 실패 " << stats.misses
+                   << L", 무효화 " << stats.invalidated << std::endl;
+        
         return results;
     }
     
-    bool MatchesSignature(const uint8_t* data, const SignaturePattern& signature) {
-        for (size_t i = 0; i < signature.bytes.size(); ++i) {
-            if (signature.mask[i] && data[i] != signature.bytes[i]) {
-                return false;
-            }
+    std::vector<ScanCore::SignatureMatch> ScanModuleForSignatures(const ModuleInfo& module, const ScanCore::SignatureSet& signatureSet) {
+        std::vector<ScanCore::SignatureMatch> results;
+        
+        if (signatureSet.MaxLength() == 0) {
+            return results;
         }
-        return true;
+        
+        // 1MB씩 스캔. 청크 경계에 걸친 시그니처를 놓치지 않도록 가장 긴 시그니처 길이 - 1 바이트를 다음 청크로 넘김
+        // 넘겨받은 구간 안에서 끝나는 짧은 시그니처는 앞 청크에서 이미 찾았으므로 seenEnd로 거름
+        ScanCore::RegionStreamConfig config;
+        config.overlap = signatureSet.MaxLength() - 1;
+        ScanCore::RegionStream stream(memory->MakeReadFunction(), config);
+        
+        uintptr_t seenEnd = 0;
+        stream.ForEach(module.baseAddress, module.size, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            signatureSet.FindAll(data, size, base, results, seenEnd);
+            seenEnd = base + size;
+            return true;
+        });
+        
+        return results;
     }
     
     uintptr_t ResolveSignatureAddress(uintptr_t signatureAddress, const SignaturePattern& signature) {
         if (signature.isRelativeOffset) {
             // RIP 상대 주소 계산
             uint32_t offset;
-            SIZE_T bytesRead;
             
-            if (ReadProcessMemory(processHandle, 
-                                 reinterpret_cast<LPCVOID>(signatureAddress + signature.offsetToTarget),
-                                 &offset, sizeof(offset), &bytesRead) && bytesRead == sizeof(offset)) {
+            if (memory->ReadValue(signatureAddress + signature.offsetToTarget, offset)) {
                 
                 // RIP = 명령어 끝 주소 + 오프셋
                 uintptr_t instructionEnd = signatureAddress + signature.bytes.size();
@@ -269,17 +311,15 @@ public:
             // 포인터 체인 따라가기
             for (size_t i = 0; i < path.offsets.size(); ++i) {
                 uintptr_t nextAddress;
-                SIZE_T bytesRead;
                 
-                if (!ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(currentAddress + path.offsets[i]),
-                                      &nextAddress, sizeof(nextAddress), &bytesRead) || 
-                    bytesRead != sizeof(nextAddress) || nextAddress == 0) {
+                if (!memory->ReadValue(currentAddress + path.offsets[i], nextAddress) || nextAddress == 0) {
                     pathValid = false;
                     break;
                 }
                 
                 currentAddress = nextAddress;
             }
+            currentAddress += path.finalOffset;
             
             if (pathValid && IsValidFPSAddress(currentAddress)) {
                 path.isValid = true;
@@ -294,6 +334,100 @@ public:
         return results;
     }
     
+    // 찾은 FPS 주소에서 거꾸로 역방향 포인터 맵을 탐색해 모듈 기준 포인터 경로를 만들고 knownPaths에 추가
+    size_t GeneratePointerPaths(uintptr_t targetAddress, size_t maxDepth = 5, size_t maxOffset = 0x1000) {
+        std::wcout << L"포인터 맵 생성 중..." << std::endl;
+        ScanCore::PointerMap pointerMap;
+        if (!pointerMap.Build(*memory)) {
+            std::wcout << L"  포인터 맵 생성 실패" << std::endl;
+            return 0;
+        }
+        std::wcout << L"  항목 " << pointerMap.EntryCount() << L"개, " << (pointerMap.MemoryBytes() / 1024 / 1024) << L"MB, "
+                   << pointerMap.BuildSeconds() << L"초" << (pointerMap.IsTruncated() ? L" (상한 도달)" : L"") << std::endl;
+        
+        std::vector<ScanCore::PointerModule> pointerModules;
+        for (const auto& module : modules) {
+            pointerModules.push_back({module.second.name, module.second.baseAddress, module.second.size});
+        }
+        
+        ScanCore::PointerScanner scanner(pointerMap, pointerModules);
+        ScanCore::PointerScanConfig config;
+        config.maxDepth = maxDepth;
+        config.maxOffset = maxOffset;
+        config.maxResults = 1000;
+        std::vector<ScanCore::PointerPath> generated = scanner.FindPaths(targetAddress, config);
+        
+        const auto& stats = scanner.GetLastStats();
+        std::wcout << L"  경로 " << stats.pathsFound << L"개, " << stats.seconds << L"초 ("
+                   << static_cast<uint64_t>(stats.PathsPerSecond()) << L" paths/s)" << std::endl;
+        
+        for (const auto& candidate : generated) {
+            AddGeneratedPath(candidate, "자동 생성 (" + std::to_string(candidate.offsets.size()) + "단계 포인터)");
+        }
+        
+        // 게임을 다시 시작한 뒤 교차 검증할 수 있도록 맵과 경로 목록을 남김
+        std::string stamp = std::to_string(static_cast<int64_t>(time(nullptr)));
+        std::string mapFile = "pointermap_" + stamp + ".scpm";
+        std::string listFile = "pointerpaths_" + stamp + ".txt";
+        if (ScanCore::PointerMapFile::Write(mapFile, pointerMap, pointerModules, targetAddress) &&
+            ScanCore::WritePointerPathList(listFile, generated)) {
+            Json::Value root = ReadConfig();
+            Json::Value session;
+            session["map"] = mapFile;
+            session["paths"] = listFile;
+            root["pointerSessions"].append(session);
+            WriteConfig(root);
+            std::wcout << L"  세션 저장: " << std::wstring(mapFile.begin(), mapFile.end()) << std::endl;
+        }
+        return generated.size();
+    }
+    
+    // 저장된 세션들의 경로 목록 교집합 중 모든 세션의 맵에서 각 세션의 목표로 이어지는 경로만 남김
+    size_t IntersectPointerSessions() {
+        Json::Value root = ReadConfig();
+        const Json::Value& sessions = root["pointerSessions"];
+        if (sessions.size() < 2) {
+            std::wcout << L"교차 검증하려면 게임을 다시 시작하며 포인터 패스를 2번 이상 생성해야 합니다." << std::endl;
+            return 0;
+        }
+        
+        ScanCore::PointerPathIntersector intersector;
+        std::vector<std::string> lists;
+        for (const auto& session : sessions) {
+            if (intersector.AddMap(session["map"].asString())) {
+                lists.push_back(session["paths"].asString());
+            }
+        }
+        
+        const std::string stableFile = "pointerpaths_stable.txt";
+        size_t kept = intersector.Intersect(lists, stableFile);
+        const auto& stats = intersector.GetLastStats();
+        std::wcout << L"세션 " << intersector.MapCount() << L"개: 후보 " << stats.candidates << L"개 중 " << kept
+                   << L"개 유지 (" << static_cast<uint64_t>(stats.PathsPerSecond()) << L" paths/s)" << std::endl;
+        
+        // 남은 경로를 추적 목록과 설정 파일(customPaths)에 추가
+        ScanCore::PointerPathListReader reader(stableFile);
+        std::string line;
+        ScanCore::PointerPath stable;
+        while (reader.Next(line)) {
+            if (!ScanCore::ParsePointerPath(line, stable)) continue;
+            AddGeneratedPath(stable, "교차 검증 (" + std::to_string(intersector.MapCount()) + "개 세션)");
+            
+            const PointerPath& path = knownPaths.back();
+            Json::Value pathJson;
+            pathJson["module"] = path.moduleName;
+            pathJson["baseOffset"] = ToHex(path.baseOffset);
+            pathJson["finalOffset"] = ToHex(path.finalOffset);
+            pathJson["description"] = path.description;
+            for (uintptr_t offset : path.offsets) {
+                pathJson["offsets"].append(ToHex(offset));
+            }
+            root["customPaths"].append(pathJson);
+        }
+        WriteConfig(root);
+        return kept;
+    }
+    
     std::vector<uintptr_t> ValidateSavedAddresses() {
         std::vector<uintptr_t> results;
         
@@ -324,10 +458,8 @@ public:
     
     bool IsValidFPSAddress(uintptr_t address) {
         float value;
-        SIZE_T bytesRead;
         
-        if (!ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address),
-                              &value, sizeof(value), &bytesRead) || bytesRead != sizeof(value)) {
+        if (!memory->ReadValue(address, value)) {
             return false;
         }
         
@@ -336,19 +468,10 @@ public:
     }
     
     void SaveSuccessfulAddress(uintptr_t address, const std::string& method) {
-        Json::Value root;
-        std::ifstream configStream(configFile);
-        
-        if (configStream.is_open()) {
-            configStream >> root;
-            configStream.close();
-        }
+        Json::Value root = ReadConfig();
         
         // 새 주소 추가
-        std::stringstream ss;
-        ss << std::hex << address;
-        
-        root["savedAddresses"].append(ss.str());
+        root["savedAddresses"].append(ToHex(address));
         root["lastMethod"] = method;
         root["timestamp"] = static_cast<int64_t>(time(nullptr));
         
@@ -363,14 +486,7 @@ public:
         }
         
         // 파일에 저장
-        std::ofstream configOut(configFile);
-        if (configOut.is_open()) {
-            Json::StreamWriterBuilder builder;
-            builder["indentation"] = "  ";
-            std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-            writer->write(root, &configOut);
-            configOut.close();
-            
+        if (WriteConfig(root)) {
             std::wcout << L"주소 정보가 저장되었습니다: " << std::wstring(configFile.begin(), configFile.end()) << std::endl;
         }
     }
@@ -414,25 +530,18 @@ public:
     std::vector<uintptr_t> ScanForFloat(const ModuleInfo& module, float targetValue) {
         std::vector<uintptr_t> results;
         
-        const size_t chunkSize = 1024 * 1024;
-        std::vector<uint8_t> buffer(chunkSize);
-        
-        for (size_t offset = 0; offset < module.size; offset += chunkSize) {
-            size_t readSize = std::min(chunkSize, module.size - offset);
-            SIZE_T bytesRead;
-            
-            if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(module.baseAddress + offset),
-                                 buffer.data(), readSize, &bytesRead)) {
+        ScanCore::RegionStream stream(memory->MakeReadFunction());
+        stream.ForEach(module.baseAddress, module.size, [&](const uint8_t* data, size_t size, uintptr_t base) {
+            for (size_t i = 0; i + sizeof(float) <= size; i += sizeof(float)) {
+                float value;
+                memcpy(&value, data + i, sizeof(float));
                 
-                for (size_t i = 0; i <= bytesRead - sizeof(float); i += sizeof(float)) {
-                    float value = *reinterpret_cast<const float*>(&buffer[i]);
-                    
-                    if (abs(value - targetValue) < 0.01f) {
-                        results.push_back(module.baseAddress + offset + i);
-                    }
+                if (abs(value - targetValue) < 0.01f) {
+                    results.push_back(base + i);
                 }
             }
-        }
+            return true;
+        });
         
         return results;
     }
@@ -440,11 +549,10 @@ public:
     void AnalyzeAddressContext(uintptr_t address) {
         // 주소 주변의 코드 패턴 분석
         std::vector<uint8_t> context(32);
-        SIZE_T bytesRead;
+        size_t bytesRead;
         
         // 주소 앞뒤 16바이트씩 읽기
-        if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address - 16),
-                             context.data(), 32, &bytesRead)) {
+        if (memory->ReadBytes(address - 16, context.data(), 32, bytesRead)) {
             
             // 공통 패턴 찾기 (예: mov, cmp, test 명령어)
             for (size_t i = 0; i < bytesRead - 4; ++i) {
@@ -562,6 +670,41 @@ private:
         return "Unknown";
     }
     
+    // 생성된 경로(*p + offset 방식)를 기존 형식으로: offsets마다 *(address + offset), 마지막 오프셋은 finalOffset
+    void AddGeneratedPath(const ScanCore::PointerPath& candidate, const std::string& description) {
+        std::vector<uintptr_t> offsets = {0};
+        offsets.insert(offsets.end(), candidate.offsets.begin(), candidate.offsets.end() - 1);
+        AddPointerPath(candidate.module, candidate.baseOffset, offsets, description);
+        knownPaths.back().finalOffset = candidate.offsets.back();
+    }
+    
+    static std::string ToHex(uintptr_t value) {
+        std::stringstream ss;
+        ss << std::hex << value;
+        return ss.str();
+    }
+    
+    Json::Value ReadConfig() {
+        Json::Value root;
+        std::ifstream configStream(configFile);
+        if (configStream.is_open()) {
+            configStream >> root;
+        }
+        return root;
+    }
+    
+    bool WriteConfig(const Json::Value& root) {
+        std::ofstream configOut(configFile);
+        if (!configOut.is_open()) {
+            return false;
+        }
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "  ";
+        std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+        writer->write(root, &configOut);
+        return true;
+    }
+    
     void LoadConfiguration() {
         std::ifstream configStream(configFile);
         if (!configStream.is_open()) {
@@ -585,6 +728,9 @@ private:
                 for (const auto& offset : pathJson["offsets"]) {
                     path.offsets.push_back(std::stoull(offset.asString(), nullptr, 16));
                 }
+                if (pathJson.isMember("finalOffset")) {
+                    path.finalOffset = std::stoull(pathJson["finalOffset"].asString(), nullptr, 16);
+                }
                 
                 knownPaths.push_back(path);
             }
@@ -618,7 +764,9 @@ int main() {
         std::wcout << L"2. 추적 결과 보기" << std::endl;
         std::wcout << L"3. 주소 패턴 학습" << std::endl;
         std::wcout << L"4. 성공한 주소 저장" << std::endl;
-        std::wcout << L"5. 종료" << std::endl;
+        std::wcout << L"5. 포인터 패스 자동 생성" << std::endl;
+        std::wcout << L"6. 세션 간 포인터 패스 교차 검증" << std::endl;
+        std::wcout << L"7. 종료" << std::endl;
         std::wcout << L"선택: ";
         
         int choice;
@@ -656,7 +804,23 @@ int main() {
                 break;
             }
             
-            case 5:
+            case 5: {
+                std::wcout << L"목표 주소를 입력하세요 (16진수): 0x";
+                uintptr_t address;
+                std::wcin >> std::hex >> address >> std::dec;
+                
+                size_t count = tracker.GeneratePointerPaths(address);
+                std::wcout << count << L"개의 포인터 패스를 추가했습니다. 1번으로 검증할 수 있습니다." << std::endl;
+                break;
+            }
+            
+            case 6: {
+                size_t count = tracker.IntersectPointerSessions();
+                std::wcout << count << L"개의 안정적인 포인터 패스를 저장했습니다." << std::endl;
+                break;
+            }
+            
+            case 7:
                 std::wcout << L"프로그램을 종료합니다." << std::endl;
                 return 0;
                 
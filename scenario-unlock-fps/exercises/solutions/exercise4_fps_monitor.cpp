@@ -23,6 +23,10 @@
 #include <fstream>
 #include <map>
 #include <cmath> // For std::isfinite, std::sqrt
+#include <memory>
+#include <sstream>
+
+#include "../../../resources/scan-core/AddressSampler.h"
 
 class FPSMonitor {
 private:
@@ -40,6 +44,7 @@ private:
     
     struct MonitorConfig {
         int updateInterval; // milliseconds
+        int sampleRate;     // Hz (주소 샘플링, 통계용)
         int historySize;    // number of readings to keep
         bool showGraph;
         bool logToFile;
@@ -65,17 +70,23 @@ private:
     std::deque<FPSReading> readings;
     MonitorConfig config;
     std::vector<uintptr_t> monitorAddresses;
+    // 주소 읽기는 샘플러 스레드가 sampleRate로 일괄 처리, 화면 갱신은 샘플러를 막지 않고 결과만 읽음
+    std::unique_ptr<ScanCore::Win32ProcessMemory> memory;
+    std::unique_ptr<ScanCore::AddressSampler> sampler;
+    size_t activeAddress; // 유효한 값을 준 주소 (sampler 번호)
     bool isMonitoring;
     std::thread monitorThread;
     std::ofstream logFile;
 
 public:
-    FPSMonitor() : processHandle(nullptr), processId(0), isMonitoring(false) {
+    FPSMonitor() : processHandle(nullptr), processId(0), activeAddress(0), isMonitoring(false) {
         InitializeConfig();
     }
     
     ~FPSMonitor() {
         StopMonitoring();
+        sampler.reset();
+        memory.reset();
         if (processHandle) {
             CloseHandle(processHandle);
         }
@@ -86,6 +97,7 @@ public:
     
     void InitializeConfig() {
         config.updateInterval = 100; // 0.1초마다 업데이트
+        config.sampleRate = 1000;    // 1ms마다 샘플 (화면 갱신 사이의 드롭도 통계에 잡힘)
         config.historySize = 600;    // 60초 분량 (0.1초 * 600)
         config.showGraph = true;
         config.logToFile = false;
@@ -108,6 +120,7 @@ public:
             std::wcout << L"프로세스 핸들 열기 실패. 오류: " << GetLastError() << std::endl;
             return false;
         }
+        memory = std::make_unique<ScanCore::Win32ProcessMemory>(processHandle);
         
         std::wcout << L"FPS 모니터 초기화 완료" << std::endl;
         return true;
@@ -131,6 +144,20 @@ public:
         
         isMonitoring = true;
         readings.clear();
+        activeAddress = 0;
+        
+        // 모든 주소를 sampleRate로 한 번에 읽는 샘플러. 통계 창은 히스토리와 같은 시간
+        ScanCore::AddressSamplerConfig samplerConfig;
+        samplerConfig.rateHz = config.sampleRate;
+        samplerConfig.window = static_cast<size_t>(std::max(1, config.sampleRate * config.updateInterval / 1000 * config.historySize));
+        // UpdateReadings와 같은 유효 범위: 0, 음수, 1000 이상(옛 주소의 쓰레기 값)은 통계에서 뺌
+        samplerConfig.minimumValue = 0.0;
+        samplerConfig.maximumValue = 1000.0;
+        sampler = std::make_unique<ScanCore::AddressSampler>(*memory, samplerConfig);
+        for (uintptr_t address : monitorAddresses) {
+            sampler->Watch(address, ScanCore::ValueType::Float);
+        }
+        sampler->Start();
         
         // 로그 파일 설정
         if (config.logToFile) {
@@ -142,7 +169,10 @@ public:
             }
         }
         
-        // 모니터링 스레드 시작
+        // 모니터링 스레드 시작 (ESC로 끝난 이전 스레드 정리)
+        if (monitorThread.joinable()) {
+            monitorThread.join();
+        }
         monitorThread = std::thread(&FPSMonitor::MonitoringLoop, this);
         
         std::wcout << L"FPS 모니터링 시작..." << std::endl;
@@ -160,6 +190,10 @@ public:
             monitorThread.join();
         }
         
+        if (sampler) {
+            sampler->Stop();
+        }
+        
         if (logFile.is_open()) {
             logFile.close();
         }
@@ -188,26 +222,29 @@ public:
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
         
+        sampler->Stop();
         isMonitoring = false;
     }
     
     void UpdateReadings(std::chrono::system_clock::time_point timestamp) {
-        // 모든 주소에서 FPS 값 읽기 (첫 번째 유효한 값 사용)
+        // 샘플러가 읽어 둔 주소별 최신 값 (지금 쓰는 주소를 먼저, 유효하지 않으면 첫 번째 유효한 값 사용)
         float currentFPS = 0.0f;
         bool validReading = false;
+        size_t validAddress = activeAddress;
         
-        for (uintptr_t address : monitorAddresses) {
-            float fps;
-            SIZE_T bytesRead;
+        for (size_t n = 0; n < sampler->Size(); ++n) {
+            size_t i = n == 0 ? activeAddress : (n <= activeAddress ? n - 1 : n);
+            ScanCore::Sample sample;
+            if (!sampler->Latest(i, sample)) {
+                continue;
+            }
             
-            if (ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address),
-                                 &fps, sizeof(fps), &bytesRead) && bytesRead == sizeof(fps)) {
-                
-                if (fps > 0.0f && fps < 1000.0f && std::isfinite(fps)) {
-                    currentFPS = fps;
-                    validReading = true;
-                    break;
-                }
+            float fps = static_cast<float>(sample.value);
+            if (fps > 0.0f && fps < 1000.0f && std::isfinite(fps)) {
+                currentFPS = fps;
+                validAddress = i;
+                validReading = true;
+                break;
             }
         }
         
@@ -215,6 +252,12 @@ public:
             return; // 유효한 읽기 없음
         }
         
+        // 주소가 바뀌면 이전 주소의 히스토리는 버림 (통계가 두 주소의 값을 섞지 않도록)
+        if (validAddress != activeAddress) {
+            activeAddress = validAddress;
+            readings.clear();
+        }
+        
         // FPS 읽기 생성
         FPSReading reading;
         reading.timestamp = timestamp;
@@ -312,47 +355,46 @@ public:
             return stats;
         }
         
-        std::vector<float> fpsValues;
-        std::vector<float> frameTimeValues;
-        
-        for (const auto& reading : readings) {
-            fpsValues.push_back(reading.fps);
-            frameTimeValues.push_back(reading.frameTime);
-        }
-        
-        // 기본 통계
-        stats.minFPS = *std::min_element(fpsValues.begin(), fpsValues.end());
-        stats.maxFPS = *std::max_element(fpsValues.begin(), fpsValues.end());
-        stats.minFrameTime = *std::min_element(frameTimeValues.begin(), frameTimeValues.end());
-        stats.maxFrameTime = *std::max_element(frameTimeValues.begin(), frameTimeValues.end());
-        
-        // 평균
-        float sumFPS = 0, sumFrameTime = 0;
-        for (size_t i = 0; i < fpsValues.size(); ++i) {
-            sumFPS += fpsValues[i];
-            sumFrameTime += frameTimeValues[i];
-        }
-        stats.avgFPS = sumFPS / fpsValues.size();
-        stats.avgFrameTime = sumFrameTime / frameTimeValues.size();
-        
-        // 분산과 표준편차
-        float varianceSum = 0;
-        for (float fps : fpsValues) {
-            float diff = fps - stats.avgFPS;
-            varianceSum += diff * diff;
+        // FPS 최소/최대/평균/분산: 샘플러의 이동 통계 (sampleRate로 모은 히스토리 시간만큼, 복사 없이 바로)
+        // 샘플러는 (0, 1000) 밖의 값을 통계에서 빼므로 readings와 같은 유효한 값만 들어 있음
+        ScanCore::WindowStats window = sampler->GetWindowStats(activeAddress);
+        if (window.count > 0) {
+            stats.minFPS = static_cast<float>(window.minimum);
+            stats.maxFPS = static_cast<float>(window.maximum);
+            stats.avgFPS = static_cast<float>(window.mean);
+            stats.variance = static_cast<float>(window.variance);
+        } else {
+            // 샘플러 통계가 아직 없으면 화면 갱신 간격의 히스토리로
+            stats.minFPS = stats.maxFPS = readings.front().fps;
+            float sumFPS = 0.0f;
+            for (const FPSReading& reading : readings) {
+                stats.minFPS = std::min(stats.minFPS, reading.fps);
+                stats.maxFPS = std::max(stats.maxFPS, reading.fps);
+                sumFPS += reading.fps;
+            }
+            stats.avgFPS = sumFPS / readings.size();
+            for (const FPSReading& reading : readings) stats.variance += (reading.fps - stats.avgFPS) * (reading.fps - stats.avgFPS);
+            stats.variance /= readings.size();
         }
-        stats.variance = varianceSum / fpsValues.size();
         stats.standardDeviation = std::sqrt(stats.variance);
         
-        // 드롭과 스파이크 계산
+        // 프레임 시간 최소/최대는 FPS 최대/최소에서 바로
+        stats.minFrameTime = stats.maxFPS > 0.0f ? 1000.0f / stats.maxFPS : 0.0f;
+        stats.maxFrameTime = stats.minFPS > 0.0f ? 1000.0f / stats.minFPS : 0.0f;
+        
+        // 평균 프레임 시간, 드롭과 스파이크: 화면 갱신 간격의 히스토리를 그대로 훑음
+        float sumFrameTime = 0;
         stats.dropCount = 0;
         stats.spikeCount = 0;
         
-        for (size_t i = 1; i < fpsValues.size(); ++i) {
-            float change = fpsValues[i] - fpsValues[i-1];
+        for (size_t i = 0; i < readings.size(); ++i) {
+            sumFrameTime += readings[i].frameTime;
+            if (i == 0) continue;
+            float change = readings[i].fps - readings[i-1].fps;
             if (change < -10.0f) stats.dropCount++;
             if (change > 15.0f) stats.spikeCount++;
         }
+        stats.avgFrameTime = sumFrameTime / readings.size();
         
         // 안정성 계산 (표준편차 기반)
         float maxAcceptableDeviation = stats.avgFPS * 0.1f; // 10%
@@ -319,9 +319,8 @@ bool ShaderManager::CompileShaderFromSource(const std::string& source, const std
 }
 
 // EffectProfiler Implementation
-std::vector<float> EffectProfiler::frameTimes;
+ScanCore::FrameStats EffectProfiler::frameStats(120); // Keep last 2 seconds at 60 FPS
 std::chrono::high_resolution_clock::time_point EffectProfiler::lastFrame;
-float EffectProfiler::averageFrameTime = 0.0f;
 int EffectProfiler::frameCount = 0;
 
 void EffectProfiler::BeginFrame() {
@@ -330,26 +329,16 @@ void EffectProfiler::BeginFrame() {
 
 void EffectProfiler::EndFrame() {
     auto now = std::chrono::high_resolution_clock::now();
-    float frameTime = std::chrono::duration<float, std::milli>(now - lastFrame).count();
+    double frameTime = std::chrono::duration<double, std::milli>(now - lastFrame).count();
     
-    frameTimes.push_back(frameTime);
-    if (frameTimes.size() > 120) { // Keep last 2 seconds at 60 FPS
-        frameTimes.erase(frameTimes.begin());
-    }
-    
-    // Calculate average
-    float total = 0.0f;
-    for (float time : frameTimes) {
-        total += time;
-    }
-    averageFrameTime = total / frameTimes.size();
+    // Running sums and window min/max are updated incrementally; no rescan per frame
+    frameStats.Add(frameTime);
     
     frameCount++;
 }
 
 void EffectProfiler::Reset() {
-    frameTimes.clear();
-    averageFrameTime = 0.0f;
+    frameStats.Reset();
     frameCount = 0;
 }
 
@@ -7,6 +7,8 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <chrono>
+#include "scan-core/FrameStats.h"
 
 using namespace DirectX;
 
@@ -215,18 +217,21 @@ namespace EffectPresets {
 
 /**
  * Performance monitor for effect system
+ * Rolling window over the last 120 frames (2 seconds at 60 FPS); queries are O(1) or O(log n)
  */
 class EffectProfiler {
 private:
-    static std::vector<float> frameTimes;
+    static ScanCore::FrameStats frameStats;
     static std::chrono::high_resolution_clock::time_point lastFrame;
-    static float averageFrameTime;
     static int frameCount;
 
 public:
     static void BeginFrame();
     static void EndFrame();
-    static float GetAverageFrameTime() { return averageFrameTime; }
-    static float GetCurrentFPS() { return 1000.0f / averageFrameTime; }
+    static float GetAverageFrameTime() { return static_cast<float>(frameStats.Mean()); }
+    static float GetCurrentFPS() { return static_cast<float>(frameStats.AverageFPS()); }
+    // 99th percentile frame time (ms) and FPS at the slowest 1% of frames
+    static float GetP99FrameTime() { return static_cast<float>(frameStats.Percentile(0.99)); }
+    static float Get1PercentLowFPS() { return static_cast<float>(frameStats.LowFPS(0.01)); }
     static void Reset();
 };
\ No newline at end of file
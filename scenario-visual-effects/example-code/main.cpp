@@ -239,6 +239,8 @@ void MonitorPerformance() {
     std::cout << "Performance Results:\n";
     std::cout << "  Average Frame Time: " << EffectProfiler::GetAverageFrameTime() << " ms\n";
     std::cout << "  Average FPS: " << EffectProfiler::GetCurrentFPS() << "\n";
+    std::cout << "  p99 Frame Time: " << EffectProfiler::GetP99FrameTime() << " ms\n";
+    std::cout << "  1% Low FPS: " << EffectProfiler::Get1PercentLowFPS() << "\n";
     std::cout << "  Effects Enabled: " << (VisualEffects::IsEnabled() ? "Yes" : "No") << "\n";
 }
 
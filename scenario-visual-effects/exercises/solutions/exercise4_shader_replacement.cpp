@@ -26,6 +26,8 @@
 #include <codecvt>
 #include <locale>
 
+#include "../../../resources/scan-core/CompiledPattern.h"
+
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "d3dcompiler.lib")
@@ -89,6 +91,7 @@ private:
         std::vector<uint8_t> pattern;
         std::vector<bool> mask;
         std::string replacementShader;
+        ScanCore::CompiledPattern compiled;    // pattern + mask를 미리 분석한 검색기
     };
     
     std::vector<ShaderPattern> shaderPatterns;
@@ -356,6 +359,7 @@ private:
         lightingPattern.pattern = {0x48, 0x8B, 0xC4, 0x48, 0x89, 0x58, 0x08}; // 예시 바이트코드 패턴
         lightingPattern.mask = {true, true, true, true, true, true, true};
         lightingPattern.replacementShader = "toon_shading";
+        lightingPattern.compiled = ScanCore::CompiledPattern(lightingPattern.pattern, lightingPattern.mask);
         shaderPatterns.push_back(lightingPattern);
         
         ShaderPattern postProcessPattern;
@@ -363,6 +367,7 @@ private:
         postProcessPattern.pattern = {0x89, 0x05, 0x00, 0x00, 0x00, 0x00}; // 예시 패턴
         postProcessPattern.mask = {true, true, false, false, false, false};
         postProcessPattern.replacementShader = "sepia";
+        postProcessPattern.compiled = ScanCore::CompiledPattern(postProcessPattern.pattern, postProcessPattern.mask);
         shaderPatterns.push_back(postProcessPattern);
     }
     
@@ -612,20 +617,7 @@ private:
             return false;
         }
         
-        for (size_t i = 0; i <= bytecode.size() - pattern.pattern.size(); ++i) {
-            bool match = true;
-            for (size_t j = 0; j < pattern.pattern.size(); ++j) {
-                if (pattern.mask[j] && bytecode[i + j] != pattern.pattern[j]) {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) {
-                return true;
-            }
-        }
-        
-        return false;
+        return pattern.compiled.Contains(bytecode.data(), bytecode.size());
     }
     
     bool InitializeResources(IDXGISwapChain* pSwapChain) {